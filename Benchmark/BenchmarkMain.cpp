@@ -0,0 +1,56 @@
+/////////////////////////////////////////////////////////////////////////////////////////////
+// Filename:      BenchmarkMain.cpp
+// Description:   an entry point of the standalone benchmarking program;
+//
+//                usage: math_lib_bench [--filter <substring>] [--json <filename>]
+//                  --filter  run only benchmarks which names contain the substring
+//                  --json    write the results into a JSON file (Google Benchmark format)
+//
+// Created:       17.10.26
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "Benchmarks.h"
+
+#include <cstring>
+
+
+int main(int argc, char* argv[])
+{
+	const char* jsonFilename = nullptr;
+	std::string filter;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if ((strcmp(argv[i], "--json") == 0) && (i + 1 < argc))
+		{
+			jsonFilename = argv[++i];
+		}
+		else if ((strcmp(argv[i], "--filter") == 0) && (i + 1 < argc))
+		{
+			filter = argv[++i];
+		}
+		else
+		{
+			std::cout << "usage: " << argv[0] << " [--filter <substring>] [--json <filename>]" << std::endl;
+			return 1;
+		}
+	}
+
+	Log log;
+	Benchmarks bench;
+
+	bench.Set_Filter(filter);
+
+	bench.Bench_Vectors_And_Points();
+	bench.Bench_Matrices();
+	bench.Bench_Quaternions();
+	bench.Bench_Figures();
+	bench.Bench_Coordinate_Systems();
+	bench.Bench_Utils();
+	bench.Bench_Fixed_Point();
+
+	if (jsonFilename && !bench.Write_Json(jsonFilename))
+		return 1;
+
+	return 0;
+}
@@ -0,0 +1,164 @@
+/////////////////////////////////////////////////////////////////////////////////////////////
+// Filename:      Benchmarks.cpp
+// Description:   contains implementation of the common benchmarking functional:
+//                filtering, printing and storing of the results, JSON report
+//
+// Created:       17.10.26
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "Benchmarks.h"
+
+#include <cstdio>
+#include <iomanip>
+#include <thread>
+
+#include "../Utils/Simd.h"
+
+
+volatile float Benchmarks::sink_ = 0.0f;
+volatile int Benchmarks::zeroMask_ = 0;
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                HELPER FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+static std::string Json_Escape(const std::string & str)
+{
+	// escapes the characters which can't be written into a JSON string as is
+
+	std::string result;
+	result.reserve(str.size());
+
+	for (const char c : str)
+	{
+		switch (c)
+		{
+			case '"':  result += "\\\""; break;
+			case '\\': result += "\\\\"; break;
+			case '\n': result += "\\n";  break;
+			case '\t': result += "\\t";  break;
+			default:   result += c;
+		}
+	}
+
+	return result;
+
+} // end Json_Escape
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                PUBLIC FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void Benchmarks::Set_Filter(const std::string & filter)
+{
+	filter_ = filter;
+}
+
+///////////////////////////////////////////////////////////
+
+int Benchmarks::Write_Json(const char* filename) const
+{
+	// this function writes all the results into a JSON file; the format is the same as
+	// the one of Google Benchmark (--benchmark_format=json) so its tools (compare.py, etc.)
+	// can be used for tracking of regressions between releases
+
+	assert((filename != nullptr) && (filename[0] != '\0'));
+
+	FILE* pFile = fopen(filename, "w");
+
+	if (!pFile)
+	{
+		Log::Error(LOG_MACRO, std::string("can't open the file: ") + filename);
+		return 0;
+	}
+
+	char date[32]{ '\0' };
+	const time_t now = time(nullptr);
+	strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", localtime(&now));
+
+#ifdef NDEBUG
+	const char* buildType = "release";
+#else
+	const char* buildType = "debug";
+#endif
+
+	fprintf(pFile, "{\n");
+	fprintf(pFile, "  \"context\": {\n");
+	fprintf(pFile, "    \"date\": \"%s\",\n", date);
+	fprintf(pFile, "    \"num_cpus\": %u,\n", std::thread::hardware_concurrency());
+	fprintf(pFile, "    \"simd_level\": \"%s\",\n", MathLib::SIMD_Level_Name(MathLib::SIMD_Get_Level()));
+	fprintf(pFile, "    \"library_build_type\": \"%s\"\n", buildType);
+	fprintf(pFile, "  },\n");
+	fprintf(pFile, "  \"benchmarks\": [\n");
+
+	for (size_t i = 0; i < results_.size(); i++)
+	{
+		const BENCH_RESULT & result = results_[i];
+		const double nsPerRun = result.nsPerOp * result.numItems;
+
+		fprintf(pFile, "    {\n");
+		fprintf(pFile, "      \"name\": \"%s\",\n", Json_Escape(result.name).c_str());
+		fprintf(pFile, "      \"run_type\": \"iteration\",\n");
+		fprintf(pFile, "      \"iterations\": 1,\n");
+		fprintf(pFile, "      \"real_time\": %.4f,\n", nsPerRun);
+		fprintf(pFile, "      \"cpu_time\": %.4f,\n", nsPerRun);
+		fprintf(pFile, "      \"time_unit\": \"ns\",\n");
+		fprintf(pFile, "      \"items\": %d,\n", result.numItems);
+		fprintf(pFile, "      \"ns_per_item\": %.4f,\n", result.nsPerOp);
+		fprintf(pFile, "      \"items_per_second\": %.6e\n", 1e9 / result.nsPerOp);
+		fprintf(pFile, "    }%s\n", (i + 1 < results_.size()) ? "," : "");
+	}
+
+	fprintf(pFile, "  ]\n");
+	fprintf(pFile, "}\n");
+
+	const bool failed = (ferror(pFile) != 0);
+	fclose(pFile);
+
+	if (failed)
+	{
+		Log::Error(LOG_MACRO, std::string("can't write the file: ") + filename);
+		return 0;
+	}
+
+	return 1;
+
+} // end Write_Json
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                PRIVATE FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+bool Benchmarks::Is_Enabled(const std::string & name) const
+{
+	return filter_.empty() || (name.find(filter_) != std::string::npos);
+}
+
+///////////////////////////////////////////////////////////
+
+void Benchmarks::Print_Result(const std::string & name, const double nsPerOp, const int numItems)
+{
+	// prints a result of a single benchmark and stores it for the JSON report;
+	// results of the batches (numItems > 1) are named as "name/numItems"
+
+	if (!Is_Enabled(name))
+		return;
+
+	const std::string fullName = (numItems > 1) ? name + "/" + std::to_string(numItems) : name;
+
+	std::stringstream ss;
+	ss << std::left << std::setw(48) << fullName << std::fixed << std::setprecision(3) << nsPerOp << " ns/op";
+
+	Log::Print(ss.str().c_str());
+
+	results_.push_back({ fullName, numItems, nsPerOp });
+
+} // end Print_Result
@@ -0,0 +1,187 @@
+/////////////////////////////////////////////////////////////////////
+// Filename:      Benchmarks.h
+// Description:   contains functional for benchmarking the math library
+//
+// Created:       17.10.26
+/////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "../Log/Log.h"
+#include "../Matrix/Matrix.h"
+
+
+// sizes of the data for the benchmarks of single functions (see Bench_Func):
+// 1K elements stay in L1/L2 cache, 1M elements are streamed from the memory
+constexpr int BENCH_SIZE_1K = 1024;
+constexpr int BENCH_SIZE_1M = 1024 * 1024;
+
+constexpr int BENCH_NUM_HOT_CALLS = 10000;
+
+
+// a result of a single benchmark
+typedef struct BENCH_RESULT_TYPE
+{
+	std::string name;       // name of the benchmark (with "/<numItems>" for batches, "/hot" or "/latency" for single calls)
+	int         numItems;   // number of elements which are processed by one run (1 if it isn't a batch)
+	double      nsPerOp;    // the best time per one element in ns
+} BENCH_RESULT, *BENCH_RESULT_PTR;
+
+
+class Benchmarks
+{
+public:
+	void Bench_Matrices();
+	void Bench_Quaternions();
+	void Bench_Vectors_And_Points();
+	void Bench_Figures();
+	void Bench_Utils();
+	void Bench_Coordinate_Systems();
+	void Bench_Fixed_Point();
+
+	// run only benchmarks which names contain the filter (empty filter == all)
+	void Set_Filter(const std::string & filter);
+
+	// writes all the results into a JSON file (in the format of Google Benchmark);
+	// returns 1 if everything is OK or 0 if the file can't be written
+	int Write_Json(const char* filename) const;
+
+
+private:
+	// MATRICEs functional benchmarking
+	void Bench_Matrix_Functions();
+	void Bench_Affine_4X3_vs_4X4();
+
+	// VECTORs and POINTs functional benchmarking
+	void Bench_Vectors_2D();
+	void Bench_Vectors_3D();
+	void Bench_Vectors_4D();
+
+	// QUATERNIONs functional benchmarking
+	void Bench_Quaternion_Functions();
+	void Bench_Quaternion_Interpolation();
+	void Bench_Quaternion_Matrix_Conversion();
+
+	// FIGUREs functional benchmarking
+	void Bench_BVH();
+	void Bench_Segments2D();
+
+	// FIXED-POINT functional benchmarking
+	void Bench_Fixed_Point_vs_Float_Transform();
+
+	// UTILs functional benchmarking
+	void Bench_Utils_Functions();
+	void Bench_SinCos();
+
+	// prints a result of a single benchmark and stores it for the JSON report
+	void Print_Result(const std::string & name, const double nsPerOp, const int numItems = 1);
+
+	bool Is_Enabled(const std::string & name) const;
+
+	///////////////////////////////////////////////////////////
+
+	// runs func(numOps) several times and returns the best time per one operation in ns;
+	// the best time is used since the noise of the system can only make it worse
+	template<typename FUNC>
+	double Measure_Ns_Per_Op(FUNC func, const int numOps, const int numRepeats = 10)
+	{
+		double best = 1e30;
+
+		for (int i = 0; i < numRepeats; i++)
+		{
+			const auto start = std::chrono::high_resolution_clock::now();
+			func(numOps);
+			const auto end = std::chrono::high_resolution_clock::now();
+
+			const double ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
+			if (ns < best)
+				best = ns;
+		}
+
+		return best / numOps;
+	}
+
+	///////////////////////////////////////////////////////////
+
+	// measures op(i) which processes the i-th element of the input data
+	// (the data must have at least BENCH_SIZE_1M elements):
+	//   - "name/hot": a loop of calls on the same (hot) element; the calls are independent
+	//     so the CPU overlaps them, and it is the throughput, not the latency of one call
+	//     (see Bench_Latency for it);
+	//   - a loop over 1K elements (in cache) and over 1M elements (from the memory)
+	template<typename OP>
+	void Bench_Func(const std::string & name, OP op)
+	{
+		if (!Is_Enabled(name))
+			return;
+
+		// it is always 0 but the compiler doesn't know it so it can't hoist the call
+		const int mask = zeroMask_;
+
+		Print_Result(name + "/hot", Measure_Ns_Per_Op([&](const int n)
+		{
+			for (int i = 0; i < n; i++)
+				op(i & mask);
+		}, BENCH_NUM_HOT_CALLS));
+
+		for (const int size : { BENCH_SIZE_1K, BENCH_SIZE_1M })
+		{
+			Print_Result(name, Measure_Ns_Per_Op([&](const int n)
+			{
+				for (int i = 0; i < n; i++)
+					op(i);
+			}, size, (size == BENCH_SIZE_1M) ? 3 : 10), size);
+		}
+	}
+
+	///////////////////////////////////////////////////////////
+
+	// measures the latency of one call as "name/latency": a dependent chain x = step(x)
+	// starting from x0, so each call waits for the result of the previous one and the CPU
+	// can't overlap them; the chain must stay bounded (no overflow, denormals, NaN)
+	template<typename T, typename STEP>
+	void Bench_Latency(const std::string & name, const T & x0, STEP step)
+	{
+		if (!Is_Enabled(name))
+			return;
+
+		T x = x0;
+
+		Print_Result(name + "/latency", Measure_Ns_Per_Op([&](const int n)
+		{
+			for (int i = 0; i < n; i++)
+				x = step(x);
+		}, BENCH_NUM_HOT_CALLS));
+
+		// the compiler can't throw away the chain since its result is used
+		sink_ = sink_ + *reinterpret_cast<const unsigned char*>(&x);
+	}
+
+	///////////////////////////////////////////////////////////
+
+	// measures a batch function func(num) on 1K and 1M elements
+	template<typename FUNC>
+	void Bench_Batch(const std::string & name, FUNC func)
+	{
+		if (!Is_Enabled(name))
+			return;
+
+		for (const int size : { BENCH_SIZE_1K, BENCH_SIZE_1M })
+		{
+			Print_Result(name, Measure_Ns_Per_Op(func, size, (size == BENCH_SIZE_1M) ? 3 : 10), size);
+		}
+	}
+
+private:
+	std::vector<BENCH_RESULT> results_;
+	std::string filter_;
+
+public:
+	// the compiler can't throw away computations which results are written here
+	static volatile float sink_;
+	static volatile int zeroMask_;
+};
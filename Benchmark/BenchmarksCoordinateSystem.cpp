@@ -0,0 +1,139 @@
+/////////////////////////////////////////////////////////////////////////////////////////////
+// Filename:      BenchmarksCoordinateSystem.cpp
+// Description:   contains implementation of benchmarks for conversions between
+//                coordinate systems (polar, cylindrical, spherical)
+//
+// Created:       17.10.26
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "Benchmarks.h"
+
+#include <random>
+
+#include "../CoordinateSystem.h"
+#include "../CoordinateSystemBatch.h"
+#include "../CoordinateSystemScan.h"
+#include "../Utils/Utils.h"
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                PUBLIC FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void Benchmarks::Bench_Coordinate_Systems()
+{
+	// this function measures each function of CoordinateSystem.h, CoordinateSystemBatch.h
+	// and the streaming conversion of sweeps (CoordinateSystemScan.h)
+
+	Log::Print("\n\n");
+	Log::Print("---------------- BENCHMARK: COORDINATE SYSTEMS --------------\n");
+
+	std::vector<MathLib::POLAR2D> polar(BENCH_SIZE_1M, MathLib::POLAR2D(0.0f, 0.0f));
+	std::vector<MathLib::CYLINDRICAL3D> cyl(BENCH_SIZE_1M);
+	std::vector<MathLib::SPHERICAL3D> sph(BENCH_SIZE_1M);
+	std::vector<MathLib::POINT2D> p2(BENCH_SIZE_1M);
+	std::vector<MathLib::POINT3D> p3(BENCH_SIZE_1M);
+	std::vector<float> x(BENCH_SIZE_1M), y(BENCH_SIZE_1M), z(BENCH_SIZE_1M);
+
+	std::mt19937 gen(7);
+	std::uniform_real_distribution<float> dist(1.0f, 100.0f);
+	std::uniform_real_distribution<float> distAngle(-PI, PI);
+
+	for (int i = 0; i < BENCH_SIZE_1M; i++)
+	{
+		polar[i] = MathLib::POLAR2D(dist(gen), distAngle(gen));
+
+		cyl[i].r     = dist(gen);
+		cyl[i].theta = distAngle(gen);
+		cyl[i].z     = dist(gen);
+
+		sph[i].p     = dist(gen);
+		sph[i].theta = distAngle(gen);
+		sph[i].phi   = 0.5f * (distAngle(gen) + PI);
+	}
+
+	//
+	// 2D polar coordinates
+	//
+	Bench_Func("POLAR2D_To_POINT2D",  [&](const int i) { MathLib::POLAR2D_To_POINT2D(&polar[i], &p2[i]); });
+	Bench_Func("POLAR2D_To_RectXY",   [&](const int i) { MathLib::POLAR2D_To_RectXY(&polar[i], &x[i], &y[i]); });
+	Bench_Func("POINT2D_To_POLAR2D",  [&](const int i) { MathLib::POINT2D_To_POLAR2D(&p2[i], &polar[i]); });
+	Bench_Func("POINT2D_To_PolarRTh", [&](const int i) { MathLib::POINT2D_To_PolarRTh(&p2[i], &x[i], &y[i]); });
+
+	//
+	// 3D cylindrical coordinates
+	//
+	Bench_Func("CYLINDRICAL3D_To_POINT3D",   [&](const int i) { MathLib::CYLINDRICAL3D_To_POINT3D(&cyl[i], &p3[i]); });
+	Bench_Func("CYLINDRICAL3D_To_RectXYZ",   [&](const int i) { MathLib::CYLINDRICAL3D_To_RectXYZ(&cyl[i], &x[i], &y[i], &z[i]); });
+	Bench_Func("POINT3D_To_CylindricalRThZ", [&](const int i) { MathLib::POINT3D_To_CylindricalRThZ(&p3[i], &x[i], &y[i], &z[i]); });
+
+	//
+	// 3D spherical coordinates
+	//
+	Bench_Func("SPHERICAL3D_To_POINT3D",    [&](const int i) { MathLib::SPHERICAL3D_To_POINT3D(&sph[i], &p3[i]); });
+	Bench_Func("SPHERICAL3D_To_RectXYZ",    [&](const int i) { MathLib::SPHERICAL3D_To_RectXYZ(&sph[i], &x[i], &y[i], &z[i]); });
+	Bench_Func("POINT3D_To_SPHERICAL3D",    [&](const int i) { MathLib::POINT3D_To_SPHERICAL3D(&p3[i], &sph[i]); });
+	Bench_Func("POINT3D_To_SphericalRThPh", [&](const int i) { MathLib::POINT3D_To_SphericalRThPh(&p3[i], &x[i], &y[i], &z[i]); });
+
+	//
+	// batch conversion (SoA streams)
+	//
+	std::vector<float> a(BENCH_SIZE_1M), b(BENCH_SIZE_1M), c(BENCH_SIZE_1M);
+
+	for (int i = 0; i < BENCH_SIZE_1M; i++)
+	{
+		a[i] = dist(gen);
+		b[i] = distAngle(gen);
+		c[i] = 0.5f * (distAngle(gen) + PI);
+	}
+
+	Bench_Batch("POLAR2D_To_POINT2D_Batch",       [&](const int n) { MathLib::POLAR2D_To_POINT2D_Batch(a.data(), b.data(), x.data(), y.data(), n); });
+	Bench_Batch("POINT2D_To_POLAR2D_Batch",       [&](const int n) { MathLib::POINT2D_To_POLAR2D_Batch(x.data(), y.data(), a.data(), b.data(), n); });
+	Bench_Batch("CYLINDRICAL3D_To_POINT3D_Batch", [&](const int n) { MathLib::CYLINDRICAL3D_To_POINT3D_Batch(a.data(), b.data(), c.data(), x.data(), y.data(), z.data(), n); });
+	Bench_Batch("POINT3D_To_CYLINDRICAL3D_Batch", [&](const int n) { MathLib::POINT3D_To_CYLINDRICAL3D_Batch(x.data(), y.data(), z.data(), a.data(), b.data(), c.data(), n); });
+	Bench_Batch("SPHERICAL3D_To_POINT3D_Batch",   [&](const int n) { MathLib::SPHERICAL3D_To_POINT3D_Batch(a.data(), b.data(), c.data(), x.data(), y.data(), z.data(), n); });
+	Bench_Batch("POINT3D_To_SPHERICAL3D_Batch",   [&](const int n) { MathLib::POINT3D_To_SPHERICAL3D_Batch(x.data(), y.data(), z.data(), a.data(), b.data(), c.data(), n); });
+
+	//
+	// streaming conversion of sweeps: 64 rings x 2048 columns, chunks of 4096 measurements;
+	// compared with conversion of the same measurements by SPHERICAL3D_To_POINT3D
+	//
+	const int numRings = 64;
+	const int numColumns = 2048;
+	const int chunkSize = 4096;
+	float ringPhi[numRings];
+
+	for (int ring = 0; ring < numRings; ring++)
+		ringPhi[ring] = 0.5f * PI - DEG_TO_RAD(-25.0f + 0.5f * ring);
+
+	MathLib::SPHERICAL_SCAN scan;
+	MathLib::Init_Spherical_Scan(&scan, ringPhi, numRings, -PI, 2.0f * PI / numColumns, numColumns);
+
+	Bench_Batch("Spherical_Scan_To_POINT3D", [&](const int n)
+	{
+		MathLib::Reset_Spherical_Scan(&scan);
+
+		for (int start = 0; start < n; start += chunkSize)
+		{
+			const int count = (n - start < chunkSize) ? (n - start) : chunkSize;
+			MathLib::Spherical_Scan_To_POINT3D(&scan, a.data() + start, p3.data() + start, count);
+		}
+	});
+
+	Bench_Batch("scan: SPHERICAL3D_To_POINT3D", [&](const int n)
+	{
+		MathLib::SPHERICAL3D s;
+
+		for (int i = 0; i < n; i++)
+		{
+			s.p = a[i];
+			s.theta = -PI + (float)((i / numRings) % numColumns) * (2.0f * PI / numColumns);
+			s.phi = ringPhi[i % numRings];
+			MathLib::SPHERICAL3D_To_POINT3D(&s, &p3[i]);
+		}
+	});
+
+	sink_ = a[0] + b[0] + c[0] + polar[0].r + cyl[0].r + sph[0].p + p2[0].x + p3[0].x + x[0] + y[0] + z[0];
+
+} // end Bench_Coordinate_Systems
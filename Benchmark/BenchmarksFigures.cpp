@@ -0,0 +1,601 @@
+/////////////////////////////////////////////////////////////////////////////////////////////
+// Filename:      BenchmarksFigures.cpp
+// Description:   contains implementation of benchmarks for figures
+//                (parametric lines, 3D planes, bounding volumes, BVH, frustum culling,
+//                triangles and intersections of 2D segments)
+//
+// Created:       17.10.26
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "Benchmarks.h"
+
+#include <cfloat>
+#include <iomanip>
+#include <random>
+#include <sstream>
+
+#include "../Figures/BoundingVolumes.h"
+#include "../Figures/BVH.h"
+#include "../Figures/Figures.h"
+#include "../Figures/FiguresBatch.h"
+#include "../Figures/Frustum.h"
+#include "../Figures/Segments2D.h"
+#include "../Figures/Triangles.h"
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                PUBLIC FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void Benchmarks::Bench_Figures()
+{
+	// this function measures each function of Figures.h, FiguresBatch.h, BoundingVolumes.h,
+	// Frustum.h and Triangles.h (BVH and Segments2D.h are measured separately);
+	// the second line of the 2D intersection is the next line of the same array
+
+	Log::Print("\n\n");
+	Log::Print("--------------------- BENCHMARK: FIGURES --------------------\n");
+
+	const int last = BENCH_SIZE_1M - 1;
+
+	std::vector<MathLib::POINT2D> p2a(BENCH_SIZE_1M), p2b(BENCH_SIZE_1M), p2r(BENCH_SIZE_1M);
+	std::vector<MathLib::POINT3D> p3a(BENCH_SIZE_1M), p3b(BENCH_SIZE_1M), p3r(BENCH_SIZE_1M);
+	std::vector<MathLib::PARAMLINE2D> lines2D(BENCH_SIZE_1M);
+	std::vector<MathLib::PARAMLINE3D> lines3D(BENCH_SIZE_1M);
+	std::vector<MathLib::PLANE3D> planes(BENCH_SIZE_1M);
+	std::vector<float> t(BENCH_SIZE_1M), t2(BENCH_SIZE_1M), f(BENCH_SIZE_1M);
+	std::vector<int> res(BENCH_SIZE_1M);
+
+	std::mt19937 gen(6);
+	std::uniform_real_distribution<float> dist(-100.0f, 100.0f);
+	std::uniform_real_distribution<float> distT(0.0f, 1.0f);
+
+	for (int i = 0; i < BENCH_SIZE_1M; i++)
+	{
+		MathLib::POINT2D_INIT_XY(p2a[i], dist(gen), dist(gen));
+		MathLib::POINT2D_INIT_XY(p2b[i], dist(gen), dist(gen));
+		MathLib::POINT3D_INIT_XYZ(p3a[i], dist(gen), dist(gen), dist(gen));
+		MathLib::POINT3D_INIT_XYZ(p3b[i], dist(gen), dist(gen), dist(gen));
+
+		MathLib::Init_Param_Line2D(p2a[i], p2b[i], lines2D[i]);
+		MathLib::Init_Param_Line3D(p3a[i], p3b[i], lines3D[i]);
+
+		// planes through the origin with random normals
+		MathLib::VECTOR3D n(dist(gen), dist(gen), dist(gen) + 200.0f);
+		MathLib::PLANE3D_Init(planes[i], MathLib::POINT3D(0, 0, 0), n, 0);
+
+		t[i] = distT(gen);
+	}
+
+	//
+	// parametric lines
+	//
+	Bench_Func("Init_Param_Line2D",     [&](const int i) { MathLib::Init_Param_Line2D(p2a[i], p2b[i], lines2D[i]); });
+	Bench_Func("Compute_Param_Line2D",  [&](const int i) { MathLib::Compute_Param_Line2D(&lines2D[i], t[i], &p2r[i]); });
+
+	Bench_Func("Intersect_Param_Lines2D(t)", [&](const int i)
+	{
+		res[i] = MathLib::Intersect_Param_Lines2D(&lines2D[i], &lines2D[(i + 1) & last], &t[i], &t2[i]);
+	});
+
+	Bench_Func("Intersect_Param_Lines2D(pt)", [&](const int i)
+	{
+		res[i] = MathLib::Intersect_Param_Lines2D(&lines2D[i], &lines2D[(i + 1) & last], &p2r[i]);
+	});
+
+	Bench_Func("Init_Param_Line3D", [&](const int i) { MathLib::Init_Param_Line3D(p3a[i], p3b[i], lines3D[i]); });
+	Bench_Func("Compute_Point_On_Param_Line3D", [&](const int i) { MathLib::Compute_Point_On_Param_Line3D(lines3D[i], t2[i], p3r[i]); });
+
+	//
+	// 3D planes
+	//
+	Bench_Func("PLANE3D_Init",            [&](const int i) { MathLib::PLANE3D_Init(planes[i], p3a[i], planes[i].n, 0); });
+	Bench_Func("PLANE3D_Init(normalize)", [&](const int i) { MathLib::PLANE3D_Init(planes[i], p3a[i], planes[i].n, 1); });
+	Bench_Func("Compute_Point_In_Plane3D",[&](const int i) { f[i] = MathLib::Compute_Point_In_Plane3D(p3b[i], planes[i]); });
+
+	Bench_Func("Intersect_Param_Line3D_Plane3D", [&](const int i)
+	{
+		res[i] = MathLib::Intersect_Param_Line3D_Plane3D(lines3D[i], planes[i], t2[i], p3r[i]);
+	});
+
+	Bench_Func("Distance_Point3D_To_Plane3D", [&](const int i)
+	{
+		f[i] = MathLib::Distance_Point3D_To_Plane3D(p3b[i], planes[i], p3r[i]);
+	});
+
+	Bench_Func("Distance_Point3D_To_Plane3D_Normalized", [&](const int i)
+	{
+		f[i] = MathLib::Distance_Point3D_To_Plane3D_Normalized(p3b[i], planes[i], p3r[i]);
+	});
+
+	//
+	// batch intersection of lines with 6 planes (like the clip planes of a frustum);
+	// the time is per line (for all the planes)
+	//
+	const int numPlanes = 6;
+
+	std::vector<float> p0x(BENCH_SIZE_1M), p0y(BENCH_SIZE_1M), p0z(BENCH_SIZE_1M);
+	std::vector<float> vx(BENCH_SIZE_1M), vy(BENCH_SIZE_1M), vz(BENCH_SIZE_1M);
+	std::vector<float> nx(numPlanes), ny(numPlanes), nz(numPlanes), d(numPlanes);
+	std::vector<float> tBatch(BENCH_SIZE_1M * numPlanes);
+	std::vector<unsigned char> codes(BENCH_SIZE_1M * numPlanes);
+
+	for (int i = 0; i < BENCH_SIZE_1M; i++)
+	{
+		p0x[i] = lines3D[i].p0.x;
+		p0y[i] = lines3D[i].p0.y;
+		p0z[i] = lines3D[i].p0.z;
+		vx[i] = lines3D[i].v.x;
+		vy[i] = lines3D[i].v.y;
+		vz[i] = lines3D[i].v.z;
+	}
+
+	MathLib::PARAMLINE3D_SOA linesSoa;
+	linesSoa.p0x = p0x.data();
+	linesSoa.p0y = p0y.data();
+	linesSoa.p0z = p0z.data();
+	linesSoa.vx = vx.data();
+	linesSoa.vy = vy.data();
+	linesSoa.vz = vz.data();
+
+	MathLib::PLANE3D_SOA planesSoa;
+	planesSoa.nx = nx.data();
+	planesSoa.ny = ny.data();
+	planesSoa.nz = nz.data();
+	planesSoa.d = d.data();
+
+	for (int j = 0; j < numPlanes; j++)
+	{
+		MathLib::PLANE3D_Init(planes[j], p3a[j], planes[j].n, 1);
+		MathLib::PLANE3D_To_SOA(planes[j], nx.data(), ny.data(), nz.data(), d.data(), j);
+	}
+
+	Bench_Batch("x6 planes: Lines3D_Planes3D_Batch", [&](const int n)
+	{
+		MathLib::Intersect_Param_Lines3D_Planes3D_Batch(linesSoa, n, planesSoa, numPlanes, tBatch.data(), codes.data());
+	});
+
+	Bench_Batch("x6 planes: Line3D_Plane3D", [&](const int n)
+	{
+		for (int j = 0; j < numPlanes; j++)
+		{
+			for (int i = 0; i < n; i++)
+				res[i] = MathLib::Intersect_Param_Line3D_Plane3D(lines3D[i], planes[j], t2[i], p3r[i]);
+		}
+	});
+
+	//
+	// frustum culling: a perspective projection (90 degrees, depth range [0, 1], the near
+	// and far planes at 1 and 100) and objects in [-100, 100]^3 (about 1/5 is visible);
+	// the caches of the batch functions are kept between the runs (as between frames)
+	//
+	MathLib::MATRIX4X4 proj =
+	{
+		1, 0, 0,               0,
+		0, 1, 0,               0,
+		0, 0, 100.0f / 99.0f,  1,
+		0, 0, -100.0f / 99.0f, 0
+	};
+
+	MathLib::FRUSTUM frustum;
+	MathLib::FRUSTUM_Init(frustum, proj, MathLib::FRUSTUM_DEPTH_ZERO_TO_ONE);
+
+	std::vector<unsigned char> cullResult(BENCH_SIZE_1M), cache(BENCH_SIZE_1M, 0);
+	std::vector<float> radius(BENCH_SIZE_1M);
+	std::vector<float> boxMaxX(BENCH_SIZE_1M), boxMaxY(BENCH_SIZE_1M), boxMaxZ(BENCH_SIZE_1M);
+
+	// the boxes are from p0 to p0 + (0..10, 0..10, 0..10)
+	for (int i = 0; i < BENCH_SIZE_1M; i++)
+	{
+		radius[i] = 5.0f * distT(gen);
+
+		boxMaxX[i] = p0x[i] + 10.0f * distT(gen);
+		boxMaxY[i] = p0y[i] + 10.0f * distT(gen);
+		boxMaxZ[i] = p0z[i] + 10.0f * distT(gen);
+	}
+
+	Bench_Func("FRUSTUM_Test_Point", [&](const int i)
+	{
+		res[i] = MathLib::FRUSTUM_Test_Point(frustum, p3a[i]);
+	});
+
+	Bench_Func("FRUSTUM_Classify_Sphere", [&](const int i)
+	{
+		res[i] = MathLib::FRUSTUM_Classify_Sphere(frustum, p3a[i], radius[i], cache[i]);
+	});
+
+	Bench_Func("FRUSTUM_Classify_AABB", [&](const int i)
+	{
+		res[i] = MathLib::FRUSTUM_Classify_AABB(frustum, p3a[i], MathLib::POINT3D(boxMaxX[i], boxMaxY[i], boxMaxZ[i]), cache[i]);
+	});
+
+	Bench_Batch("FRUSTUM_Test_Points_Batch", [&](const int n)
+	{
+		MathLib::FRUSTUM_Test_Points_Batch(frustum, p0x.data(), p0y.data(), p0z.data(), cullResult.data(), n);
+	});
+
+	Bench_Batch("FRUSTUM_Classify_Spheres_Batch", [&](const int n)
+	{
+		MathLib::FRUSTUM_Classify_Spheres_Batch(frustum, p0x.data(), p0y.data(), p0z.data(), radius.data(),
+			cullResult.data(), cache.data(), n);
+	});
+
+	Bench_Batch("FRUSTUM_Classify_AABBs_Batch", [&](const int n)
+	{
+		MathLib::FRUSTUM_Classify_AABBs_Batch(frustum, p0x.data(), p0y.data(), p0z.data(),
+			boxMaxX.data(), boxMaxY.data(), boxMaxZ.data(), cullResult.data(), cache.data(), n);
+	});
+
+	//
+	// bounding volumes: the boxes and the spheres of the frustum culling above
+	//
+	MathLib::AABB3D_SOA boxes;
+	boxes.minX = p0x.data();  boxes.minY = p0y.data();  boxes.minZ = p0z.data();
+	boxes.maxX = boxMaxX.data();  boxes.maxY = boxMaxY.data();  boxes.maxZ = boxMaxZ.data();
+
+	MathLib::SPHERE3D_SOA spheres;
+	spheres.cx = p0x.data();  spheres.cy = p0y.data();  spheres.cz = p0z.data();  spheres.radius = radius.data();
+
+	std::vector<float> boxOut[6];
+
+	for (int k = 0; k < 6; k++)
+		boxOut[k].resize(BENCH_SIZE_1M);
+
+	MathLib::AABB3D_SOA_OUT boxesOut;
+	boxesOut.minX = boxOut[0].data();  boxesOut.minY = boxOut[1].data();  boxesOut.minZ = boxOut[2].data();
+	boxesOut.maxX = boxOut[3].data();  boxesOut.maxY = boxOut[4].data();  boxesOut.maxZ = boxOut[5].data();
+
+	MathLib::MATRIX4X4 boxMat =
+	{
+		 0.36f, 0.48f, -0.8f, 0,
+		-0.8f,  0.6f,   0.0f, 0,
+		 0.48f, 0.64f,  0.6f, 0,
+		 5.0f, -3.0f,   2.0f, 1
+	};
+
+	const MathLib::AABB3D queryBox(MathLib::POINT3D(-20, -20, -20), MathLib::POINT3D(20, 20, 20));
+	const MathLib::SPHERE3D querySphere(MathLib::POINT3D(10, -10, 0), 30.0f);
+	MathLib::AABB3D box;
+
+	Bench_Batch("AABB3D_From_POINT3D_Array", [&](const int n)
+	{
+		MathLib::AABB3D_From_POINT3D_Array(box, p3a.data(), n);
+	});
+
+	Bench_Batch("AABB3D_From_Points", [&](const int n)
+	{
+		MathLib::AABB3D_From_Points(box, p0x.data(), p0y.data(), p0z.data(), n);
+	});
+
+	Bench_Func("AABB3D_Transform", [&](const int i)
+	{
+		const MathLib::AABB3D in(p3a[i], MathLib::POINT3D(boxMaxX[i], boxMaxY[i], boxMaxZ[i]));
+		MathLib::AABB3D out;
+
+		MathLib::AABB3D_Transform(in, boxMat, out);
+		boxOut[0][i] = out.pMin.x;
+	});
+
+	Bench_Batch("AABB3D_Transform_Batch", [&](const int n)
+	{
+		MathLib::AABB3D_Transform_Batch(boxes, boxMat, boxesOut, n);
+	});
+
+	Bench_Func("AABB3D_Overlap", [&](const int i)
+	{
+		cullResult[i] = (unsigned char)MathLib::AABB3D_Overlap(queryBox,
+			MathLib::AABB3D(p3a[i], MathLib::POINT3D(boxMaxX[i], boxMaxY[i], boxMaxZ[i])));
+	});
+
+	Bench_Batch("AABB3D_Overlap_Batch", [&](const int n)
+	{
+		MathLib::AABB3D_Overlap_Batch(queryBox, boxes, cullResult.data(), n);
+	});
+
+	Bench_Func("SPHERE3D_Overlap", [&](const int i)
+	{
+		cullResult[i] = (unsigned char)MathLib::SPHERE3D_Overlap(querySphere, MathLib::SPHERE3D(p3a[i], radius[i]));
+	});
+
+	Bench_Batch("SPHERE3D_Overlap_Batch", [&](const int n)
+	{
+		MathLib::SPHERE3D_Overlap_Batch(querySphere, spheres, cullResult.data(), n);
+	});
+
+	Bench_Func("AABB3D_SPHERE3D_Overlap", [&](const int i)
+	{
+		cullResult[i] = (unsigned char)MathLib::AABB3D_SPHERE3D_Overlap(
+			MathLib::AABB3D(p3a[i], MathLib::POINT3D(boxMaxX[i], boxMaxY[i], boxMaxZ[i])), querySphere);
+	});
+
+	Bench_Batch("AABB3D_SPHERE3D_Overlap_Batch", [&](const int n)
+	{
+		MathLib::AABB3D_SPHERE3D_Overlap_Batch(querySphere, boxes, cullResult.data(), n);
+	});
+
+	// the spheres are written into the arrays of the transformed boxes
+	MathLib::SPHERE3D_SOA_OUT spheresOut;
+	spheresOut.cx = boxOut[0].data();  spheresOut.cy = boxOut[1].data();  spheresOut.cz = boxOut[2].data();  spheresOut.radius = boxOut[3].data();
+
+	Bench_Func("SPHERE3D_Transform", [&](const int i)
+	{
+		MathLib::SPHERE3D out;
+
+		MathLib::SPHERE3D_Transform(MathLib::SPHERE3D(p3a[i], radius[i]), boxMat, out);
+		boxOut[0][i] = out.radius;
+	});
+
+	Bench_Batch("SPHERE3D_Transform_Batch", [&](const int n)
+	{
+		MathLib::SPHERE3D_Transform_Batch(spheres, boxMat, spheresOut, n);
+	});
+
+	Bench_Func("SPHERE3D_Merge", [&](const int i)
+	{
+		MathLib::SPHERE3D out;
+
+		MathLib::SPHERE3D_Merge(MathLib::SPHERE3D(p3a[i], radius[i]),
+			MathLib::SPHERE3D(MathLib::POINT3D(boxMaxX[i], boxMaxY[i], boxMaxZ[i]), radius[i]), out);
+		boxOut[0][i] = out.radius;
+	});
+
+	Bench_Batch("SPHERE3D_Merge_Batch", [&](const int n)
+	{
+		MathLib::SPHERE3D_Merge_Batch(spheres, spheresOut, spheresOut, n);
+	});
+
+	// triangles: the single tests are of the line i vs the triangle i;
+	// the batch is one line vs n triangles
+	std::vector<MathLib::TRIANGLE3D> tris(BENCH_SIZE_1M);
+	std::vector<MathLib::TRIANGLE3D_PRECOMP> trisPre(BENCH_SIZE_1M);
+	std::vector<float> triData[9];
+
+	for (int i = 0; i < BENCH_SIZE_1M; i++)
+	{
+		tris[i] = MathLib::TRIANGLE3D(p3a[i], p3b[i], p3a[(i + 1) & last]);
+		MathLib::TRIANGLE3D_Precompute(tris[i], trisPre[i]);
+	}
+
+	for (int k = 0; k < 9; k++)
+		triData[k].resize(BENCH_SIZE_1M);
+
+	MathLib::TRIANGLE3D_SOA_OUT trisSoa;
+	trisSoa.p0x = triData[0].data();  trisSoa.p0y = triData[1].data();  trisSoa.p0z = triData[2].data();
+	trisSoa.e1x = triData[3].data();  trisSoa.e1y = triData[4].data();  trisSoa.e1z = triData[5].data();
+	trisSoa.e2x = triData[6].data();  trisSoa.e2y = triData[7].data();  trisSoa.e2z = triData[8].data();
+
+	MathLib::TRIANGLE3D_To_SOA(tris.data(), BENCH_SIZE_1M, trisSoa);
+
+	MathLib::TRIANGLE3D_HIT triHit;
+
+	Bench_Func("Line3D_Triangle3D", [&](const int i)
+	{
+		res[i] = MathLib::Intersect_Param_Line3D_Triangle3D(lines3D[i], tris[i], FLT_MAX, triHit);
+	});
+
+	Bench_Func("Line3D_Triangle3D_Precomp", [&](const int i)
+	{
+		res[i] = MathLib::Intersect_Param_Line3D_Triangle3D_Precomp(lines3D[i], trisPre[i], FLT_MAX, triHit);
+	});
+
+	Bench_Batch("Line3D_Triangles3D (closest hit)", [&](const int n)
+	{
+		res[0] = MathLib::Intersect_Param_Line3D_Triangles3D(lines3D[0], trisSoa, n, FLT_MAX, triHit);
+	});
+
+	sink_ = p2r[0].x + p3r[0].x + f[0] + t2[0] + (float)res[0] + tBatch[0] + (float)codes[0] + (float)cullResult[0] +
+		box.pMin.x + boxOut[0][0] + triHit.t;
+
+	Bench_BVH();
+	Bench_Segments2D();
+
+} // end Bench_Figures
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                PRIVATE FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void Benchmarks::Bench_BVH()
+{
+	// this function measures the build of BVH (by one thread and by all the cores) and
+	// the queries: coherent rays (a grid of camera rays) which are good for the packets
+	// and incoherent segments between random points; the queries are also printed as rays per second
+
+	const int numBoxes = 1 << 16;
+
+	std::vector<MathLib::AABB3D> boxes(numBoxes);
+	std::mt19937 gen(18);
+	std::uniform_real_distribution<float> dist(-100.0f, 100.0f);
+	std::uniform_real_distribution<float> distSize(0.1f, 4.0f);
+
+	for (int i = 0; i < numBoxes; i++)
+	{
+		const MathLib::POINT3D p(dist(gen), dist(gen), dist(gen));
+		boxes[i] = MathLib::AABB3D(p, MathLib::POINT3D(p.x + distSize(gen), p.y + distSize(gen), p.z + distSize(gen)));
+	}
+
+	MathLib::BVH bvh;
+
+	if (Is_Enabled("BVH_Build"))
+	{
+		Print_Result("BVH_Build (1 thread)", Measure_Ns_Per_Op([&](const int n)
+		{
+			MathLib::BVH_Build(bvh, boxes.data(), n, 1);
+		}, numBoxes, 3), numBoxes);
+
+		Print_Result("BVH_Build (all cores)", Measure_Ns_Per_Op([&](const int n)
+		{
+			MathLib::BVH_Build(bvh, boxes.data(), n, 0);
+		}, numBoxes, 3), numBoxes);
+	}
+
+	MathLib::BVH_Build(bvh, boxes.data(), numBoxes, 0);
+
+	// camera rays: from (0, 0, -150) through a grid of 1024x1024 points on z = -100
+	// (rows of 8 neighbouring rays form the packets); segments: between random points
+	const int gridSize = 1024;
+
+	std::vector<MathLib::PARAMLINE3D> rays(BENCH_SIZE_1M), segments(BENCH_SIZE_1M);
+	std::vector<float> rayData[6], segData[6];
+
+	for (int k = 0; k < 6; k++)
+	{
+		rayData[k].resize(BENCH_SIZE_1M);
+		segData[k].resize(BENCH_SIZE_1M);
+	}
+
+	for (int i = 0; i < BENCH_SIZE_1M; i++)
+	{
+		const float u = ((i % gridSize) + 0.5f) / gridSize * 200.0f - 100.0f;
+		const float v = ((i / gridSize) + 0.5f) / gridSize * 200.0f - 100.0f;
+
+		MathLib::Init_Param_Line3D(MathLib::POINT3D(0, 0, -150), MathLib::POINT3D(u, v, -100), rays[i]);
+		MathLib::Init_Param_Line3D(MathLib::POINT3D(dist(gen), dist(gen), dist(gen)),
+			MathLib::POINT3D(dist(gen), dist(gen), dist(gen)), segments[i]);
+
+		const MathLib::PARAMLINE3D* src[2] = { &rays[i], &segments[i] };
+		std::vector<float>* dst[2] = { rayData, segData };
+
+		for (int j = 0; j < 2; j++)
+		{
+			dst[j][0][i] = src[j]->p0.x;
+			dst[j][1][i] = src[j]->p0.y;
+			dst[j][2][i] = src[j]->p0.z;
+			dst[j][3][i] = src[j]->v.x;
+			dst[j][4][i] = src[j]->v.y;
+			dst[j][5][i] = src[j]->v.z;
+		}
+	}
+
+	MathLib::PARAMLINE3D_SOA raysSoa, segmentsSoa;
+
+	raysSoa.p0x = rayData[0].data();  raysSoa.p0y = rayData[1].data();  raysSoa.p0z = rayData[2].data();
+	raysSoa.vx = rayData[3].data();   raysSoa.vy = rayData[4].data();   raysSoa.vz = rayData[5].data();
+
+	segmentsSoa.p0x = segData[0].data();  segmentsSoa.p0y = segData[1].data();  segmentsSoa.p0z = segData[2].data();
+	segmentsSoa.vx = segData[3].data();   segmentsSoa.vy = segData[4].data();   segmentsSoa.vz = segData[5].data();
+
+	std::vector<int> prim(BENCH_SIZE_1M);
+	std::vector<float> tHit(BENCH_SIZE_1M);
+	std::vector<unsigned char> hits(BENCH_SIZE_1M);
+
+	// measures the query on 1M lines; the rays per second are printed after all the queries
+	std::stringstream raysPerSecond;
+
+	auto benchQuery = [&](const std::string & name, auto query)
+	{
+		if (!Is_Enabled(name))
+			return;
+
+		const double ns = Measure_Ns_Per_Op(query, BENCH_SIZE_1M, 3);
+
+		Print_Result(name, ns, BENCH_SIZE_1M);
+		raysPerSecond << std::left << std::setw(40) << name << std::fixed << std::setprecision(1) << 1e3 / ns << " Mrays/s\n";
+	};
+
+	benchQuery("BVH rays: Intersect_Closest", [&](const int n)
+	{
+		MathLib::BVH_HIT hit;
+
+		for (int i = 0; i < n; i++)
+		{
+			MathLib::BVH_Intersect_Closest(bvh, rays[i], FLT_MAX, hit, nullptr, nullptr);
+			prim[i] = hit.primIndex;
+		}
+	});
+
+	benchQuery("BVH rays: Intersect_Closest_Batch", [&](const int n)
+	{
+		MathLib::BVH_Intersect_Closest_Batch(bvh, raysSoa, n, FLT_MAX, prim.data(), tHit.data(), nullptr, nullptr);
+	});
+
+	benchQuery("BVH rays: Intersect_Any", [&](const int n)
+	{
+		for (int i = 0; i < n; i++)
+			hits[i] = (unsigned char)MathLib::BVH_Intersect_Any(bvh, rays[i], FLT_MAX, nullptr, nullptr);
+	});
+
+	benchQuery("BVH rays: Intersect_Any_Batch", [&](const int n)
+	{
+		MathLib::BVH_Intersect_Any_Batch(bvh, raysSoa, n, FLT_MAX, hits.data(), nullptr, nullptr);
+	});
+
+	benchQuery("BVH segments: Intersect_Closest", [&](const int n)
+	{
+		MathLib::BVH_HIT hit;
+
+		for (int i = 0; i < n; i++)
+		{
+			MathLib::BVH_Intersect_Closest(bvh, segments[i], 1.0f, hit, nullptr, nullptr);
+			prim[i] = hit.primIndex;
+		}
+	});
+
+	benchQuery("BVH segments: Intersect_Closest_Batch", [&](const int n)
+	{
+		MathLib::BVH_Intersect_Closest_Batch(bvh, segmentsSoa, n, 1.0f, prim.data(), tHit.data(), nullptr, nullptr);
+	});
+
+	sink_ = (float)prim[0] + tHit[0] + (float)hits[0] + (float)bvh.nodes.size();
+
+	Log::Print(raysPerSecond.str().c_str());
+
+} // end Bench_BVH
+
+///////////////////////////////////////////////////////////
+
+void Benchmarks::Bench_Segments2D()
+{
+	// this function measures finding all the intersections of a set of short segments
+	// (as roads of a map) by each method; the time is per one segment
+
+	const int numLines = 1 << 14;
+
+	std::vector<MathLib::PARAMLINE2D> lines(numLines);
+	std::vector<MathLib::SEGMENT2D_HIT> hits;
+	std::mt19937 gen(20);
+	std::uniform_real_distribution<float> dist(0.0f, 1000.0f);
+	std::uniform_real_distribution<float> distLength(-10.0f, 10.0f);
+
+	for (int i = 0; i < numLines; i++)
+	{
+		const MathLib::POINT2D p(dist(gen), dist(gen));
+		MathLib::Init_Param_Line2D(p, MathLib::POINT2D(p.x + distLength(gen), p.y + distLength(gen)), lines[i]);
+	}
+
+	if (Is_Enabled("Segments2D_Brute_Force"))
+	{
+		Print_Result("Segments2D_Brute_Force", Measure_Ns_Per_Op([&](const int n)
+		{
+			MathLib::Intersect_Segments2D_Brute_Force(lines.data(), n, hits);
+		}, numLines, 1), numLines);
+	}
+
+	if (Is_Enabled("Segments2D_Sweep"))
+	{
+		Print_Result("Segments2D_Sweep", Measure_Ns_Per_Op([&](const int n)
+		{
+			MathLib::Intersect_Segments2D_Sweep(lines.data(), n, hits);
+		}, numLines, 3), numLines);
+	}
+
+	if (Is_Enabled("Segments2D_Grid"))
+	{
+		Print_Result("Segments2D_Grid (1 thread)", Measure_Ns_Per_Op([&](const int n)
+		{
+			MathLib::Intersect_Segments2D_Grid(lines.data(), n, 0.0f, 1, hits);
+		}, numLines, 3), numLines);
+
+		Print_Result("Segments2D_Grid (all cores)", Measure_Ns_Per_Op([&](const int n)
+		{
+			MathLib::Intersect_Segments2D_Grid(lines.data(), n, 0.0f, 0, hits);
+		}, numLines, 3), numLines);
+	}
+
+	sink_ = (float)hits.size();
+
+} // end Bench_Segments2D
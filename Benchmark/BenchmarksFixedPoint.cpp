@@ -0,0 +1,112 @@
+/////////////////////////////////////////////////////////////////////////////////////////////
+// Filename:      BenchmarksFixedPoint.cpp
+// Description:   contains implementation of benchmarks for fixed-point functional
+//
+// Created:       17.10.26
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "Benchmarks.h"
+
+#include <random>
+
+#include "../FixedPoint/FixedPoint.h"
+#include "../Matrix/MatrixBatch.h"
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                PUBLIC FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void Benchmarks::Bench_Fixed_Point()
+{
+	Log::Print("\n\n");
+	Log::Print("------------------- BENCHMARK: FIXED-POINT ------------------\n");
+
+	Bench_Fixed_Point_vs_Float_Transform();
+
+} // end Bench_Fixed_Point
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                PRIVATE FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void Benchmarks::Bench_Fixed_Point_vs_Float_Transform()
+{
+	// this function compares transformation of points by a 4x4 matrix (per point)
+	// in fixed-point and in float, both for single points and for batches
+
+	const int numPoints = 4096;
+
+	MathLib::MATRIX4X4 m;
+	MathLib::FIXP16_MATRIX4X4 mfp;
+
+	MathLib::Mat_Init_4X4(&m,
+		 0.8f, 0.0f, -0.6f, 0.0f,
+		 0.0f, 1.0f,  0.0f, 0.0f,
+		 0.6f, 0.0f,  0.8f, 0.0f,
+		10.0f, -20.0f, 30.0f, 1.0f);
+
+	MathLib::Mat_4X4_To_FIXP16(&m, &mfp);
+
+	std::vector<float> x(numPoints), y(numPoints), z(numPoints);
+	std::vector<float> xOut(numPoints), yOut(numPoints), zOut(numPoints);
+	std::vector<FIXP16> xfp(numPoints), yfp(numPoints), zfp(numPoints);
+	std::vector<FIXP16> xfpOut(numPoints), yfpOut(numPoints), zfpOut(numPoints);
+
+	std::mt19937 gen(6);
+	std::uniform_real_distribution<float> dist(-1000.0f, 1000.0f);
+
+	for (int i = 0; i < numPoints; i++)
+	{
+		x[i] = dist(gen);
+		y[i] = dist(gen);
+		z[i] = dist(gen);
+
+		xfp[i] = MathLib::Float_To_FIXP16(x[i]);
+		yfp[i] = MathLib::Float_To_FIXP16(y[i]);
+		zfp[i] = MathLib::Float_To_FIXP16(z[i]);
+	}
+
+	Print_Result("points: Mat_Mul_VECTOR3D_4X4", Measure_Ns_Per_Op([&](const int n)
+	{
+		MathLib::VECTOR3D v, vt;
+
+		for (int i = 0; i < n; i++)
+		{
+			MathLib::VECTOR3D_INIT_XYZ(v, x[i], y[i], z[i]);
+			MathLib::Mat_Mul_VECTOR3D_4X4(&v, &m, &vt);
+			xOut[i] = vt.x;  yOut[i] = vt.y;  zOut[i] = vt.z;
+		}
+	}, numPoints));
+
+	Print_Result("points: FIXP16_Mat_Mul_VECTOR3D_4X4", Measure_Ns_Per_Op([&](const int n)
+	{
+		MathLib::FIXP16_VECTOR3D v;
+
+		for (int i = 0; i < n; i++)
+		{
+			MathLib::FIXP16_VECTOR3D_INIT_XYZ(v, xfp[i], yfp[i], zfp[i]);
+			MathLib::FIXP16_Mat_Mul_VECTOR3D_4X4(&v, &mfp, &v);
+			xfpOut[i] = v.x;  yfpOut[i] = v.y;  zfpOut[i] = v.z;
+		}
+	}, numPoints));
+
+	Print_Result("points: Mat_Mul_VECTOR3D_4X4_Batch", Measure_Ns_Per_Op([&](const int n)
+	{
+		MathLib::Mat_Mul_VECTOR3D_4X4_Batch(x.data(), y.data(), z.data(), &m,
+			xOut.data(), yOut.data(), zOut.data(), n);
+	}, numPoints));
+
+	Print_Result("points: FIXP16_Mat_Mul_..._Batch", Measure_Ns_Per_Op([&](const int n)
+	{
+		MathLib::FIXP16_Mat_Mul_VECTOR3D_4X4_Batch(xfp.data(), yfp.data(), zfp.data(), &mfp,
+			xfpOut.data(), yfpOut.data(), zfpOut.data(), n);
+	}, numPoints));
+
+	sink_ = xOut[numPoints - 1] + (float)xfpOut[numPoints - 1];
+
+} // end Bench_Fixed_Point_vs_Float_Transform
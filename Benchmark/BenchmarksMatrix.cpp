@@ -0,0 +1,442 @@
+/////////////////////////////////////////////////////////////////////////////////////////////
+// Filename:      BenchmarksMatrix.cpp
+// Description:   contains implementation of benchmarks for matrices
+//
+// Created:       17.10.26
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "Benchmarks.h"
+
+#include <iomanip>
+#include <random>
+
+#include "../Matrix/MatrixAffine.h"
+#include "../Matrix/MatrixBatch.h"
+#include "../Matrix/MatrixPacked.h"
+#include "../Matrix/MixedPrecision.h"
+#include "../Matrix/VecMat.h"
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                HELPER FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+template<typename MATRIX>
+static void Init_Random_Matrices(std::vector<MATRIX> & mats, const int num, const unsigned int seed)
+{
+	// makes num matrices with random elements; the matrices are unions of float arrays
+	// so we fill them element by element through M[]
+
+	std::mt19937 gen(seed);
+	std::uniform_real_distribution<float> dist(-10.0f, 10.0f);
+
+	constexpr int numElems = sizeof(MATRIX) / sizeof(float);
+
+	mats.resize(num);
+
+	for (MATRIX & m : mats)
+	{
+		float* pElems = reinterpret_cast<float*>(&m);
+
+		for (int i = 0; i < numElems; i++)
+			pElems[i] = dist(gen);
+	}
+
+} // end Init_Random_Matrices
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                PUBLIC FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void Benchmarks::Bench_Matrices()
+{
+	Log::Print("\n\n");
+	Log::Print("-------------------- BENCHMARK: MATRICES --------------------\n");
+
+	Bench_Matrix_Functions();
+	Bench_Affine_4X3_vs_4X4();
+
+} // end Bench_Matrices
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                PRIVATE FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void Benchmarks::Bench_Matrix_Functions()
+{
+	// this function measures each function of Matrix.h (except the printing ones);
+	// the second operand of binary operations is the next matrix of the same array
+
+	const int last = BENCH_SIZE_1M - 1;
+
+	// 2x2 matrices
+	{
+		std::vector<MathLib::MATRIX2X2> a, r;
+		std::vector<MathLib::MATRIX1X2> v, vr;
+		std::vector<MathLib::MATRIX3X2> m32;
+		std::vector<float> f(BENCH_SIZE_1M);
+
+		Init_Random_Matrices(a, BENCH_SIZE_1M, 22);
+		Init_Random_Matrices(r, BENCH_SIZE_1M, 23);
+		Init_Random_Matrices(v, BENCH_SIZE_1M, 12);
+		Init_Random_Matrices(vr, BENCH_SIZE_1M, 13);
+		Init_Random_Matrices(m32, BENCH_SIZE_1M, 32);
+
+		Bench_Func("MAT_IDENTITY_2X2",    [&](const int i) { MathLib::MAT_IDENTITY_2X2(&r[i]); });
+		Bench_Func("MAT_COLUMN_SWAP_2X2", [&](const int i) { MathLib::MAT_COLUMN_SWAP_2X2(&r[i], i & 1, &v[i]); });
+		Bench_Func("Mat_Init_2X2",        [&](const int i) { MathLib::Mat_Init_2X2(&r[i], a[i].M00, a[i].M01, a[i].M10, a[i].M11); });
+		Bench_Func("Mat_Add_2X2",         [&](const int i) { MathLib::Mat_Add_2X2(&a[i], &a[(i + 1) & last], &r[i]); });
+		Bench_Func("Mat_Mul_2X2",         [&](const int i) { MathLib::Mat_Mul_2X2(&a[i], &a[(i + 1) & last], &r[i]); });
+		Bench_Func("Mat_Inverse_2X2",     [&](const int i) { MathLib::Mat_Inverse_2X2(&a[i], &r[i]); });
+		Bench_Func("Mat_Det_2X2",         [&](const int i) { f[i] = MathLib::Mat_Det_2X2(&a[i]); });
+
+		Bench_Func("Mat_Init_3X2", [&](const int i)
+		{
+			MathLib::Mat_Init_3X2(&m32[i], a[i].M00, a[i].M01, a[i].M10, a[i].M11, v[i].M00, v[i].M01);
+		});
+
+		Bench_Func("Mat_Mul_1X2_3X2", [&](const int i) { MathLib::Mat_Mul_1X2_3X2(&v[i], &m32[i], &vr[i]); });
+
+		sink_ = r[0].M00 + vr[0].M00 + f[0];
+	}
+
+	// 3x3 matrices
+	{
+		std::vector<MathLib::MATRIX3X3> a, r;
+		std::vector<MathLib::MATRIX1X3> v, vr;
+		std::vector<MathLib::VECTOR3D> v3(BENCH_SIZE_1M), v3r(BENCH_SIZE_1M);
+		std::vector<float> f(BENCH_SIZE_1M);
+
+		Init_Random_Matrices(a, BENCH_SIZE_1M, 33);
+		Init_Random_Matrices(r, BENCH_SIZE_1M, 34);
+		Init_Random_Matrices(v, BENCH_SIZE_1M, 13);
+		Init_Random_Matrices(vr, BENCH_SIZE_1M, 14);
+
+		for (int i = 0; i < BENCH_SIZE_1M; i++)
+			MathLib::VECTOR3D_INIT_XYZ(v3[i], v[i].M00, v[i].M01, v[i].M02);
+
+		Bench_Func("MAT_IDENTITY_3X3",      [&](const int i) { MathLib::MAT_IDENTITY_3X3(&r[i]); });
+		Bench_Func("MAT_TRANSPOSE_3X3",     [&](const int i) { MathLib::MAT_TRANSPOSE_3X3(&r[i]); });
+		Bench_Func("MAT_TRANSPOSE_3X3(dst)",[&](const int i) { MathLib::MAT_TRANSPOSE_3X3(&a[i], &r[i]); });
+		Bench_Func("MAT_COLUMN_SWAP_3X3",   [&](const int i) { MathLib::MAT_COLUMN_SWAP_3X3(&r[i], i % 3, &v[i]); });
+
+		Bench_Func("Mat_Init_3X3", [&](const int i)
+		{
+			const MathLib::MATRIX3X3 & m = a[i];
+			MathLib::Mat_Init_3X3(&r[i], m.M00, m.M01, m.M02, m.M10, m.M11, m.M12, m.M20, m.M21, m.M22);
+		});
+
+		Bench_Func("Mat_Add_3X3",          [&](const int i) { MathLib::Mat_Add_3X3(&a[i], &a[(i + 1) & last], &r[i]); });
+		Bench_Func("Mat_Mul_3X3",          [&](const int i) { MathLib::Mat_Mul_3X3(&a[i], &a[(i + 1) & last], &r[i]); });
+		Bench_Func("Mat_Mul_VECTOR3D_3X3", [&](const int i) { MathLib::Mat_Mul_VECTOR3D_3X3(&v3[i], &a[i], &v3r[i]); });
+		Bench_Func("Mat_Mul_1X3_3X3",      [&](const int i) { MathLib::Mat_Mul_1X3_3X3(&v[i], &a[i], &vr[i]); });
+		Bench_Func("Mat_Det_3X3",          [&](const int i) { f[i] = MathLib::Mat_Det_3X3(&a[i]); });
+		Bench_Func("Mat_Inverse_3X3",      [&](const int i) { MathLib::Mat_Inverse_3X3(&a[i], &r[i]); });
+
+		sink_ = r[0].M00 + vr[0].M00 + v3r[0].x + f[0];
+	}
+
+	// 4x4 and 4x3 matrices
+	{
+		std::vector<MathLib::MATRIX4X4> a, r;
+		std::vector<MathLib::MATRIX4X3> a43;
+		std::vector<MathLib::MATRIX1X4> v, vr;
+		std::vector<MathLib::VECTOR3D> v3(BENCH_SIZE_1M), v3r(BENCH_SIZE_1M);
+		std::vector<MathLib::VECTOR4D> v4(BENCH_SIZE_1M), v4r(BENCH_SIZE_1M);
+
+		Init_Random_Matrices(a, BENCH_SIZE_1M, 44);
+		Init_Random_Matrices(r, BENCH_SIZE_1M, 45);
+		Init_Random_Matrices(a43, BENCH_SIZE_1M, 43);
+		Init_Random_Matrices(v, BENCH_SIZE_1M, 14);
+		Init_Random_Matrices(vr, BENCH_SIZE_1M, 15);
+
+		for (int i = 0; i < BENCH_SIZE_1M; i++)
+		{
+			MathLib::VECTOR3D_INIT_XYZ(v3[i], v[i].M00, v[i].M01, v[i].M02);
+			MathLib::VECTOR4D_INIT_XYZ(v4[i], v[i].M00, v[i].M01, v[i].M02);
+		}
+
+		Bench_Func("MAT_IDENTITY_4X4",      [&](const int i) { MathLib::MAT_IDENTITY_4X4(&r[i]); });
+		Bench_Func("MAT_IDENTITY_4X3",      [&](const int i) { MathLib::MAT_IDENTITY_4X3(&a43[i]); });
+		Bench_Func("MAT_TRANSPOSE_4X4",     [&](const int i) { MathLib::MAT_TRANSPOSE_4X4(&r[i]); });
+		Bench_Func("MAT_TRANSPOSE_4X4(dst)",[&](const int i) { MathLib::MAT_TRANSPOSE_4X4(&a[i], &r[i]); });
+		Bench_Func("MAT_COLUMN_SWAP_4X4",   [&](const int i) { MathLib::MAT_COLUMN_SWAP_4X4(&r[i], i & 3, &v[i]); });
+
+		Bench_Func("Mat_Init_4X4", [&](const int i)
+		{
+			const MathLib::MATRIX4X4 & m = a[i];
+			MathLib::Mat_Init_4X4(&r[i],
+				m.M00, m.M01, m.M02, m.M03,
+				m.M10, m.M11, m.M12, m.M13,
+				m.M20, m.M21, m.M22, m.M23,
+				m.M30, m.M31, m.M32, m.M33);
+		});
+
+		Bench_Func("Mat_Add_4X4",          [&](const int i) { MathLib::Mat_Add_4X4(&a[i], &a[(i + 1) & last], &r[i]); });
+		Bench_Func("Mat_Mul_4X4",          [&](const int i) { MathLib::Mat_Mul_4X4(&a[i], &a[(i + 1) & last], &r[i]); });
+		Bench_Func("Mat_Mul_VECTOR3D_4X4", [&](const int i) { MathLib::Mat_Mul_VECTOR3D_4X4(&v3[i], &a[i], &v3r[i]); });
+		Bench_Func("Mat_Mul_VECTOR4D_4X4", [&](const int i) { MathLib::Mat_Mul_VECTOR4D_4X4(&v4[i], &a[i], &v4r[i]); });
+		Bench_Func("Mat_Mul_1X4_4X4",      [&](const int i) { MathLib::Mat_Mul_1X4_4X4(&v[i], &a[i], &vr[i]); });
+		Bench_Func("Mat_Inverse_4X4",      [&](const int i) { MathLib::Mat_Inverse_4X4(&a[i], &r[i]); });
+		Bench_Func("Mat_Mul_VECTOR3D_4X3", [&](const int i) { MathLib::Mat_Mul_VECTOR3D_4X3(&v3[i], &a43[i], &v3r[i]); });
+		Bench_Func("Mat_Mul_VECTOR4D_4X3", [&](const int i) { MathLib::Mat_Mul_VECTOR4D_4X3(&v4[i], &a43[i], &v4r[i]); });
+
+		// dependent chains: a rotation keeps the products bounded, and the inverse
+		// of the inverse goes back to the same matrix
+		MathLib::MATRIX4X4 rot;
+		const float cosA = cosf(0.1f);
+		const float sinA = sinf(0.1f);
+
+		MathLib::Mat_Init_4X4(&rot,
+			cosA,  sinA, 0.0f, 0.0f,
+			-sinA, cosA, 0.0f, 0.0f,
+			0.0f,  0.0f, 1.0f, 0.0f,
+			0.0f,  0.0f, 0.0f, 1.0f);
+
+		Bench_Latency("Mat_Mul_4X4", a[0], [&](const MathLib::MATRIX4X4 & m)
+		{
+			MathLib::MATRIX4X4 prod;
+			MathLib::Mat_Mul_4X4(&m, &rot, &prod);
+			return prod;
+		});
+
+		Bench_Latency("Mat_Mul_VECTOR4D_4X4", v4[0], [&](const MathLib::VECTOR4D & vec)
+		{
+			MathLib::VECTOR4D prod;
+			MathLib::Mat_Mul_VECTOR4D_4X4(&vec, &rot, &prod);
+			return prod;
+		});
+
+		Bench_Latency("Mat_Inverse_4X4", rot, [&](const MathLib::MATRIX4X4 & m)
+		{
+			MathLib::MATRIX4X4 mi;
+			MathLib::Mat_Inverse_4X4(&m, &mi);
+			return mi;
+		});
+
+		// the same functions of the generic core (inline, the same layout of the data)
+		std::vector<MathLib::Mat4f> am(BENCH_SIZE_1M), rm(BENCH_SIZE_1M);
+		std::vector<MathLib::Vec4f> v4m(BENCH_SIZE_1M), v4rm(BENCH_SIZE_1M);
+
+		for (int i = 0; i < BENCH_SIZE_1M; i++)
+		{
+			am[i] = MathLib::To_Mat(a[i].M);
+			v4m[i] = MathLib::To_Vec(v4[i]);
+		}
+
+		Bench_Func("Mat4f: Mat_Add",     [&](const int i) { rm[i] = MathLib::Mat_Add(am[i], am[(i + 1) & last]); });
+		Bench_Func("Mat4f: Mat_Mul",     [&](const int i) { rm[i] = MathLib::Mat_Mul(am[i], am[(i + 1) & last]); });
+		Bench_Func("Mat4f: Mat_Mul_Vec", [&](const int i) { v4rm[i] = MathLib::Mat_Mul_Vec(v4m[i], am[i]); });
+
+		// the same transformation of points by the batch kernel (SoA streams)
+		std::vector<float> x(BENCH_SIZE_1M), y(BENCH_SIZE_1M), z(BENCH_SIZE_1M);
+
+		for (int i = 0; i < BENCH_SIZE_1M; i++)
+		{
+			x[i] = v3[i].x;
+			y[i] = v3[i].y;
+			z[i] = v3[i].z;
+		}
+
+		Bench_Batch("Mat_Mul_VECTOR3D_4X4_Batch", [&](const int n)
+		{
+			MathLib::Mat_Mul_VECTOR3D_4X4_Batch(x.data(), y.data(), z.data(), &a[0],
+				x.data(), y.data(), z.data(), n);
+		});
+
+		// float local points by a double world matrix far from the origin: into double
+		// world points, and into float points relative to a camera (the float kernels)
+		const MathLib::Quatd rotation = MathLib::Quat_Normalize(MathLib::Quatd{ 0.9, 0.1, -0.3, 0.2 });
+		const MathLib::Vec3d position = { { 1.0e7, -2.0e6, 5.0e6 } };
+		const MathLib::Vec3d camera = { { 1.0e7 + 10.0, -2.0e6, 5.0e6 - 10.0 } };
+		const MathLib::Mat4d world = MathLib::Mat_World(rotation, 1.0, position);
+
+		std::vector<double> xd(BENCH_SIZE_1M), yd(BENCH_SIZE_1M), zd(BENCH_SIZE_1M);
+		std::vector<float> xr(BENCH_SIZE_1M), yr(BENCH_SIZE_1M), zr(BENCH_SIZE_1M);
+
+		Bench_Batch("Mat_Mul_VECTOR3D_4X4D_Batch", [&](const int n)
+		{
+			MathLib::Mat_Mul_VECTOR3D_4X4D_Batch(x.data(), y.data(), z.data(), world,
+				xd.data(), yd.data(), zd.data(), n);
+		});
+
+		Bench_Batch("Mat_Mul_VECTOR3D_4X4D_Rebased_Batch", [&](const int n)
+		{
+			MathLib::Mat_Mul_VECTOR3D_4X4D_Rebased_Batch(x.data(), y.data(), z.data(), world, camera,
+				xr.data(), yr.data(), zr.data(), n);
+		});
+
+		Bench_Batch("POINT3D_Rebase_Batch", [&](const int n)
+		{
+			MathLib::POINT3D_Rebase_Batch(xd.data(), yd.data(), zd.data(), camera,
+				xr.data(), yr.data(), zr.data(), n);
+		});
+
+		// 4D vectors by a matrix: float vectors (16 bytes) vs packed vectors (8 bytes)
+		std::vector<MathLib::VECTOR4D_F16> v4h(BENCH_SIZE_1M), v4hr(BENCH_SIZE_1M);
+		std::vector<MathLib::VECTOR4D_BF16> v4b(BENCH_SIZE_1M), v4br(BENCH_SIZE_1M);
+
+		MathLib::Pack_Batch(v4.data(), v4h.data(), BENCH_SIZE_1M);
+		MathLib::Pack_Batch(v4.data(), v4b.data(), BENCH_SIZE_1M);
+
+		Bench_Batch("VECTOR4D_4X4 (float loop)", [&](const int n)
+		{
+			for (int i = 0; i < n; i++)
+				MathLib::Mat_Mul_VECTOR4D_4X4(&v4[i], &a[0], &v4r[i]);
+		});
+
+		Bench_Batch("Mat_Mul_VECTOR4D_4X4_F16_Batch", [&](const int n)
+		{
+			MathLib::Mat_Mul_VECTOR4D_4X4_F16_Batch(v4h.data(), &a[0], v4hr.data(), n);
+		});
+
+		Bench_Batch("Mat_Mul_VECTOR4D_4X4_BF16_Batch", [&](const int n)
+		{
+			MathLib::Mat_Mul_VECTOR4D_4X4_BF16_Batch(v4b.data(), &a[0], v4br.data(), n);
+		});
+
+		// packing/unpacking of the streams of vectors (per a vector)
+		Bench_Batch("Pack_Batch: VECTOR4D -> F16", [&](const int n) { MathLib::Pack_Batch(v4.data(), v4hr.data(), n); });
+		Bench_Batch("Unpack_Batch: F16 -> VECTOR4D", [&](const int n) { MathLib::Unpack_Batch(v4h.data(), v4r.data(), n); });
+		Bench_Batch("Pack_Batch: VECTOR4D -> BF16", [&](const int n) { MathLib::Pack_Batch(v4.data(), v4br.data(), n); });
+		Bench_Batch("Unpack_Batch: BF16 -> VECTOR4D", [&](const int n) { MathLib::Unpack_Batch(v4b.data(), v4r.data(), n); });
+
+		sink_ = r[0].M00 + a43[0].M00 + vr[0].M00 + v3r[0].x + v4r[0].x + x[0] + rm[0].M[0][0] + v4rm[0][0] +
+			(float)xd[0] + xr[0] + v4hr[0].M[0] + v4br[0].M[0];
+	}
+
+} // end Bench_Matrix_Functions
+
+///////////////////////////////////////////////////////////
+
+void Benchmarks::Bench_Affine_4X3_vs_4X4()
+{
+	// this function compares the affine 4x3 path with the general 4x4 path:
+	// composition, inverse, and transformation of points
+
+	const int numOps = 100000;
+
+	MathLib::MATRIX4X3 a3, b3, r3;
+	MathLib::MATRIX4X4 a4, b4, r4;
+
+	MathLib::Mat_Init_4X3(&a3,
+		 0.8f, 0.0f, -0.6f,
+		 0.0f, 1.0f,  0.0f,
+		 0.6f, 0.0f,  0.8f,
+		 1.0f, 2.0f,  3.0f);
+
+	MathLib::Mat_Init_4X3(&b3,
+		1.0f, 0.0f, 0.0f,
+		0.0f, 0.8f, 0.6f,
+		0.0f, -0.6f, 0.8f,
+		-4.0f, 5.0f, 6.0f);
+
+	MathLib::Mat_4X3_To_4X4(&a3, &a4);
+	MathLib::Mat_4X3_To_4X4(&b3, &b4);
+
+	//
+	// composition
+	//
+	Print_Result("compose: Mat_Mul_4X3", Measure_Ns_Per_Op([&](const int n)
+	{
+		for (int i = 0; i < n; i++)
+		{
+			MathLib::Mat_Mul_4X3(&a3, &b3, &r3);
+			sink_ = r3.M30;
+		}
+		sink_ = r3.M30;
+	}, numOps));
+
+	Print_Result("compose: Mat_Mul_4X4", Measure_Ns_Per_Op([&](const int n)
+	{
+		for (int i = 0; i < n; i++)
+		{
+			MathLib::Mat_Mul_4X4(&a4, &b4, &r4);
+			sink_ = r4.M30;
+		}
+		sink_ = r4.M30;
+	}, numOps));
+
+	//
+	// inverse
+	//
+	Print_Result("inverse: Mat_Inverse_4X3", Measure_Ns_Per_Op([&](const int n)
+	{
+		for (int i = 0; i < n; i++)
+		{
+			MathLib::Mat_Inverse_4X3(&a3, &r3);
+			sink_ = r3.M30;
+		}
+		sink_ = r3.M30;
+	}, numOps));
+
+	Print_Result("inverse: Mat_Inverse_4X3_Rigid", Measure_Ns_Per_Op([&](const int n)
+	{
+		for (int i = 0; i < n; i++)
+		{
+			MathLib::Mat_Inverse_4X3_Rigid(&a3, &r3);
+			sink_ = r3.M30;
+		}
+		sink_ = r3.M30;
+	}, numOps));
+
+	Print_Result("inverse: Mat_Inverse_4X4", Measure_Ns_Per_Op([&](const int n)
+	{
+		for (int i = 0; i < n; i++)
+		{
+			MathLib::Mat_Inverse_4X4(&a4, &r4);
+			sink_ = r4.M30;
+		}
+		sink_ = r4.M30;
+	}, numOps));
+
+	//
+	// transformation of points (per point)
+	//
+	const int numPoints = 4096;
+	std::vector<float> x(numPoints), y(numPoints), z(numPoints);
+	std::mt19937 gen(1);
+	std::uniform_real_distribution<float> dist(-100.0f, 100.0f);
+
+	for (int i = 0; i < numPoints; i++)
+	{
+		x[i] = dist(gen);
+		y[i] = dist(gen);
+		z[i] = dist(gen);
+	}
+
+	Print_Result("points: Mat_Mul_VECTOR3D_4X3", Measure_Ns_Per_Op([&](const int n)
+	{
+		MathLib::VECTOR3D v, vt;
+		for (int i = 0; i < n; i++)
+		{
+			MathLib::VECTOR3D_INIT_XYZ(v, x[i], y[i], z[i]);
+			MathLib::Mat_Mul_VECTOR3D_4X3(&v, &a3, &vt);
+			x[i] = vt.x;
+		}
+	}, numPoints));
+
+	Print_Result("points: Mat_Mul_VECTOR3D_4X4", Measure_Ns_Per_Op([&](const int n)
+	{
+		MathLib::VECTOR3D v, vt;
+		for (int i = 0; i < n; i++)
+		{
+			MathLib::VECTOR3D_INIT_XYZ(v, x[i], y[i], z[i]);
+			MathLib::Mat_Mul_VECTOR3D_4X4(&v, &a4, &vt);
+			x[i] = vt.x;
+		}
+	}, numPoints));
+
+	Print_Result("points: Mat_Mul_VECTOR3D_4X3_Batch", Measure_Ns_Per_Op([&](const int n)
+	{
+		MathLib::Mat_Mul_VECTOR3D_4X3_Batch(x.data(), y.data(), z.data(), &a3,
+			x.data(), y.data(), z.data(), n);
+	}, numPoints));
+
+} // end Bench_Affine_4X3_vs_4X4
@@ -0,0 +1,342 @@
+/////////////////////////////////////////////////////////////////////////////////////////////
+// Filename:      BenchmarksQuaternion.cpp
+// Description:   contains implementation of benchmarks for quaternions
+//
+// Created:       17.10.26
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "Benchmarks.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <random>
+#include <sstream>
+
+#include "../Quaternion/QuaternionBatch.h"
+#include "../Quaternion/QuaternionMatrix.h"
+#include "../Quaternion/QuaternionPacked.h"
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                PUBLIC FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void Benchmarks::Bench_Quaternions()
+{
+	Log::Print("\n\n");
+	Log::Print("------------------- BENCHMARK: QUATERNIONS ------------------\n");
+
+	Bench_Quaternion_Functions();
+	Bench_Quaternion_Interpolation();
+	Bench_Quaternion_Matrix_Conversion();
+
+} // end Bench_Quaternions
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                PRIVATE FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void Benchmarks::Bench_Quaternion_Functions()
+{
+	// this function measures each function of Quaternion.h and the batch kernels
+	// on 1M unit quaternions
+
+	const int last = BENCH_SIZE_1M - 1;
+
+	std::vector<MathLib::QUAT> a(BENCH_SIZE_1M), r(BENCH_SIZE_1M);
+	std::vector<MathLib::VECTOR3D> v(BENCH_SIZE_1M), vr(BENCH_SIZE_1M);
+	std::vector<float> angles(BENCH_SIZE_1M), t(BENCH_SIZE_1M), f(BENCH_SIZE_1M);
+
+	std::mt19937 gen(5);
+	std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+	std::uniform_real_distribution<float> distT(0.0f, 1.0f);
+
+	for (int i = 0; i < BENCH_SIZE_1M; i++)
+	{
+		MathLib::QUAT_INIT_WXYZ(a[i], dist(gen), dist(gen), dist(gen), dist(gen) + 2.0f);
+		MathLib::QUAT_Normalize(a[i]);
+
+		MathLib::VECTOR3D_INIT_XYZ(v[i], dist(gen), dist(gen), dist(gen) + 2.0f);
+
+		angles[i] = dist(gen) * PI;
+		t[i] = distT(gen);
+	}
+
+	// inline initialization
+	Bench_Func("QUAT_ZERO",          [&](const int i) { MathLib::QUAT_ZERO(r[i]); });
+	Bench_Func("QUAT_INIT_WXYZ",     [&](const int i) { MathLib::QUAT_INIT_WXYZ(r[i], a[i].w, a[i].x, a[i].y, a[i].z); });
+	Bench_Func("QUAT_INIT_VECTOR3D", [&](const int i) { MathLib::QUAT_INIT_VECTOR3D(r[i], v[i]); });
+	Bench_Func("QUAT_INIT",          [&](const int i) { MathLib::QUAT_INIT(r[i], a[i]); });
+	Bench_Func("QUAT_COPY",          [&](const int i) { MathLib::QUAT_COPY(r[i], a[i]); });
+
+	// conversions
+	Bench_Func("VECTOR3D_Theta_To_QUAT", [&](const int i) { MathLib::VECTOR3D_Theta_To_QUAT(r[i], v[i], angles[i]); });
+	Bench_Func("EulerZYX_To_QUAT",       [&](const int i) { MathLib::EulerZYX_To_QUAT(r[i], angles[i], t[i], -angles[i]); });
+	Bench_Func("QUAT_To_VECTOR3D_Theta", [&](const int i) { MathLib::QUAT_To_VECTOR3D_Theta(a[i], vr[i], f[i]); });
+
+	// math operations
+	Bench_Func("QUAT_Add",              [&](const int i) { MathLib::QUAT_Add(a[i], a[(i + 1) & last], r[i]); });
+	Bench_Func("QUAT_Sub",              [&](const int i) { MathLib::QUAT_Sub(a[i], a[(i + 1) & last], r[i]); });
+	Bench_Func("QUAT_Conjugate",        [&](const int i) { MathLib::QUAT_Conjugate(a[i], r[i]); });
+	Bench_Func("QUAT_Scale(dst)",       [&](const int i) { MathLib::QUAT_Scale(a[i], 0.5f, r[i]); });
+	Bench_Func("QUAT_Scale",            [&](const int i) { MathLib::QUAT_Scale(r[i], 1.0f); });
+	Bench_Func("QUAT_Norm",             [&](const int i) { f[i] = MathLib::QUAT_Norm(a[i]); });
+	Bench_Func("QUAT_Norm2",            [&](const int i) { f[i] = MathLib::QUAT_Norm2(a[i]); });
+	Bench_Func("QUAT_Normalize(dst)",   [&](const int i) { MathLib::QUAT_Normalize(a[i], r[i]); });
+	Bench_Func("QUAT_Normalize",        [&](const int i) { MathLib::QUAT_Normalize(r[i]); });
+	Bench_Func("QUAT_Unit_Inverse(dst)",[&](const int i) { MathLib::QUAT_Unit_Inverse(a[i], r[i]); });
+	Bench_Func("QUAT_Unit_Inverse",     [&](const int i) { MathLib::QUAT_Unit_Inverse(r[i]); });
+	Bench_Func("QUAT_Inverse",          [&](const int i) { MathLib::QUAT_Inverse(a[i], r[i]); });
+	Bench_Func("QUAT_Mul",              [&](const int i) { MathLib::QUAT_Mul(a[i], a[(i + 1) & last], r[i]); });
+	Bench_Func("QUAT_Rotate_VECTOR3D",  [&](const int i) { MathLib::QUAT_Rotate_VECTOR3D(a[i], v[i], vr[i]); });
+	Bench_Func("QUAT_Dot",              [&](const int i) { f[i] = MathLib::QUAT_Dot(a[i], a[(i + 1) & last]); });
+
+	// dependent chains (the quaternions are unit ones so the chains stay bounded)
+	Bench_Latency("QUAT_Normalize(dst)", a[0], [&](const MathLib::QUAT & q)
+	{
+		MathLib::QUAT qn;
+		MathLib::QUAT_Normalize(q, qn);
+		return qn;
+	});
+
+	Bench_Latency("QUAT_Mul", a[0], [&](const MathLib::QUAT & q)
+	{
+		MathLib::QUAT prod;
+		MathLib::QUAT_Mul(q, a[1], prod);
+		return prod;
+	});
+
+	Bench_Latency("QUAT_Rotate_VECTOR3D", v[0], [&](const MathLib::VECTOR3D & vec)
+	{
+		MathLib::VECTOR3D rotated;
+		MathLib::QUAT_Rotate_VECTOR3D(a[1], vec, rotated);
+		return rotated;
+	});
+
+	// interpolation
+	Bench_Func("QUAT_Slerp",      [&](const int i) { MathLib::QUAT_Slerp(a[i], a[(i + 1) & last], t[i], r[i]); });
+	Bench_Func("QUAT_Slerp_Fast", [&](const int i) { MathLib::QUAT_Slerp_Fast(a[i], a[(i + 1) & last], t[i], r[i]); });
+	Bench_Func("QUAT_Nlerp",      [&](const int i) { MathLib::QUAT_Nlerp(a[i], a[(i + 1) & last], t[i], r[i]); });
+
+	// batch kernels (SoA streams)
+	std::vector<float> x(BENCH_SIZE_1M), y(BENCH_SIZE_1M), z(BENCH_SIZE_1M);
+	std::vector<float> aw(BENCH_SIZE_1M), ax(BENCH_SIZE_1M), ay(BENCH_SIZE_1M), az(BENCH_SIZE_1M);
+	std::vector<float> bw(BENCH_SIZE_1M), bx(BENCH_SIZE_1M), by(BENCH_SIZE_1M), bz(BENCH_SIZE_1M);
+	std::vector<float> rw(BENCH_SIZE_1M), rx(BENCH_SIZE_1M), ry(BENCH_SIZE_1M), rz(BENCH_SIZE_1M);
+
+	for (int i = 0; i < BENCH_SIZE_1M; i++)
+	{
+		const MathLib::QUAT & qb = a[(i + 1) & last];
+
+		x[i] = v[i].x;  y[i] = v[i].y;  z[i] = v[i].z;
+		aw[i] = a[i].w; ax[i] = a[i].x; ay[i] = a[i].y; az[i] = a[i].z;
+		bw[i] = qb.w;   bx[i] = qb.x;   by[i] = qb.y;   bz[i] = qb.z;
+	}
+
+	MathLib::QUAT_SOA q1, q2;
+	MathLib::QUAT_SOA_OUT qr;
+	q1.w = aw.data();  q1.x = ax.data();  q1.y = ay.data();  q1.z = az.data();
+	q2.w = bw.data();  q2.x = bx.data();  q2.y = by.data();  q2.z = bz.data();
+	qr.w = rw.data();  qr.x = rx.data();  qr.y = ry.data();  qr.z = rz.data();
+
+	Bench_Batch("QUAT_Rotate_VECTOR3D_Batch", [&](const int n)
+	{
+		MathLib::QUAT_Rotate_VECTOR3D_Batch(a[0], x.data(), y.data(), z.data(),
+			x.data(), y.data(), z.data(), n);
+	});
+
+	Bench_Batch("QUAT_Slerp_Batch", [&](const int n)
+	{
+		MathLib::QUAT_Slerp_Batch(q1, q2, t.data(), qr, n);
+	});
+
+	// "smallest three" packing of the SoA streams
+	std::vector<MathLib::QUAT_PACKED32> p32(BENCH_SIZE_1M);
+	std::vector<MathLib::QUAT_PACKED48> p48(BENCH_SIZE_1M);
+	std::vector<MathLib::QUAT_PACKED64> p64(BENCH_SIZE_1M);
+
+	Bench_Batch("QUAT_Pack_Batch (32 bits)",   [&](const int n) { MathLib::QUAT_Pack_Batch(q1, p32.data(), n); });
+	Bench_Batch("QUAT_Pack_Batch (48 bits)",   [&](const int n) { MathLib::QUAT_Pack_Batch(q1, p48.data(), n); });
+	Bench_Batch("QUAT_Pack_Batch (64 bits)",   [&](const int n) { MathLib::QUAT_Pack_Batch(q1, p64.data(), n); });
+	Bench_Batch("QUAT_Unpack_Batch (32 bits)", [&](const int n) { MathLib::QUAT_Unpack_Batch(p32.data(), qr, n); });
+	Bench_Batch("QUAT_Unpack_Batch (48 bits)", [&](const int n) { MathLib::QUAT_Unpack_Batch(p48.data(), qr, n); });
+	Bench_Batch("QUAT_Unpack_Batch (64 bits)", [&](const int n) { MathLib::QUAT_Unpack_Batch(p64.data(), qr, n); });
+
+	sink_ = r[0].w + vr[0].x + f[0] + x[0] + rw[0] + (float)(p32[0].bits + p48[0].M[0] + p64[0].bits);
+
+} // end Bench_Quaternion_Functions
+
+///////////////////////////////////////////////////////////
+
+void Benchmarks::Bench_Quaternion_Interpolation()
+{
+	// this function compares the exact SLERP with its approximations (per one pair of
+	// quaternions) and prints the maximal error of each approximation
+
+	const int numTracks = 4096;
+
+	std::vector<float> aw(numTracks), ax(numTracks), ay(numTracks), az(numTracks);
+	std::vector<float> bw(numTracks), bx(numTracks), by(numTracks), bz(numTracks);
+	std::vector<float> rw(numTracks), rx(numTracks), ry(numTracks), rz(numTracks);
+	std::vector<float> t(numTracks);
+
+	std::mt19937 gen(1);
+	std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+	std::uniform_real_distribution<float> distT(0.0f, 1.0f);
+
+	for (int i = 0; i < numTracks; i++)
+	{
+		MathLib::QUAT qa(dist(gen), dist(gen), dist(gen), dist(gen));
+		MathLib::QUAT qb(dist(gen), dist(gen), dist(gen), dist(gen));
+
+		MathLib::QUAT_Normalize(qa);
+		MathLib::QUAT_Normalize(qb);
+
+		aw[i] = qa.w;  ax[i] = qa.x;  ay[i] = qa.y;  az[i] = qa.z;
+		bw[i] = qb.w;  bx[i] = qb.x;  by[i] = qb.y;  bz[i] = qb.z;
+		t[i] = distT(gen);
+	}
+
+	const MathLib::QUAT_SOA q1 = { aw.data(), ax.data(), ay.data(), az.data() };
+	const MathLib::QUAT_SOA q2 = { bw.data(), bx.data(), by.data(), bz.data() };
+	const MathLib::QUAT_SOA_OUT qr = { rw.data(), rx.data(), ry.data(), rz.data() };
+
+	// helper to run a single-pair interpolation function over all the tracks
+	auto runPerPair = [&](void (*func)(const MathLib::QUAT&, const MathLib::QUAT&, const float, MathLib::QUAT&),
+		const int n)
+	{
+		MathLib::QUAT q;
+
+		for (int i = 0; i < n; i++)
+		{
+			func(MathLib::QUAT(aw[i], ax[i], ay[i], az[i]),
+				 MathLib::QUAT(bw[i], bx[i], by[i], bz[i]),
+				 t[i], q);
+
+			rw[i] = q.w;  rx[i] = q.x;  ry[i] = q.y;  rz[i] = q.z;
+		}
+	};
+
+	//
+	// timing
+	//
+	Print_Result("slerp: QUAT_Slerp", Measure_Ns_Per_Op([&](const int n)
+	{
+		runPerPair(MathLib::QUAT_Slerp, n);
+	}, numTracks));
+
+	Print_Result("slerp: QUAT_Slerp_Fast", Measure_Ns_Per_Op([&](const int n)
+	{
+		runPerPair(MathLib::QUAT_Slerp_Fast, n);
+	}, numTracks));
+
+	Print_Result("slerp: QUAT_Nlerp", Measure_Ns_Per_Op([&](const int n)
+	{
+		runPerPair(MathLib::QUAT_Nlerp, n);
+	}, numTracks));
+
+	Print_Result("slerp: QUAT_Slerp_Batch", Measure_Ns_Per_Op([&](const int n)
+	{
+		MathLib::QUAT_Slerp_Batch(q1, q2, t.data(), qr, n);
+	}, numTracks));
+
+	sink_ = rw[numTracks - 1];
+
+	//
+	// accuracy (the maximal absolute error of a component against the exact SLERP)
+	//
+	std::vector<float> ew(numTracks), ex(numTracks), ey(numTracks), ez(numTracks);
+
+	runPerPair(MathLib::QUAT_Slerp, numTracks);
+	ew = rw;  ex = rx;  ey = ry;  ez = rz;
+
+	auto maxError = [&]()
+	{
+		float err = 0.0f;
+
+		for (int i = 0; i < numTracks; i++)
+		{
+			err = std::max(err, fabsf(rw[i] - ew[i]));
+			err = std::max(err, fabsf(rx[i] - ex[i]));
+			err = std::max(err, fabsf(ry[i] - ey[i]));
+			err = std::max(err, fabsf(rz[i] - ez[i]));
+		}
+
+		return err;
+	};
+
+	std::stringstream ss;
+	ss << std::scientific << std::setprecision(2);
+
+	runPerPair(MathLib::QUAT_Slerp_Fast, numTracks);
+	ss << "max error: QUAT_Slerp_Fast  " << maxError() << "\n";
+
+	runPerPair(MathLib::QUAT_Nlerp, numTracks);
+	ss << "max error: QUAT_Nlerp       " << maxError() << "\n";
+
+	MathLib::QUAT_Slerp_Batch(q1, q2, t.data(), qr, numTracks);
+	ss << "max error: QUAT_Slerp_Batch " << maxError();
+
+	Log::Print(ss.str().c_str());
+
+} // end Bench_Quaternion_Interpolation
+
+///////////////////////////////////////////////////////////
+
+void Benchmarks::Bench_Quaternion_Matrix_Conversion()
+{
+	// this function compares the single and the batch conversions between
+	// quaternions and rotation matrices (per one joint)
+
+	const int numJoints = 4096;
+
+	std::vector<float> qw(numJoints), qx(numJoints), qy(numJoints), qz(numJoints);
+	std::vector<MathLib::MATRIX4X4> mats(numJoints);
+
+	std::mt19937 gen(2);
+	std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+	for (int i = 0; i < numJoints; i++)
+	{
+		MathLib::QUAT q(dist(gen), dist(gen), dist(gen), dist(gen));
+		MathLib::QUAT_Normalize(q);
+
+		qw[i] = q.w;  qx[i] = q.x;  qy[i] = q.y;  qz[i] = q.z;
+	}
+
+	const MathLib::QUAT_SOA_OUT q = { qw.data(), qx.data(), qy.data(), qz.data() };
+
+	Print_Result("quat => mat: QUAT_To_MATRIX4X4", Measure_Ns_Per_Op([&](const int n)
+	{
+		for (int i = 0; i < n; i++)
+			MathLib::QUAT_To_MATRIX4X4(MathLib::QUAT(qw[i], qx[i], qy[i], qz[i]), &mats[i]);
+	}, numJoints));
+
+	Print_Result("quat => mat: QUAT_To_MATRIX4X4_Batch", Measure_Ns_Per_Op([&](const int n)
+	{
+		MathLib::QUAT_To_MATRIX4X4_Batch(q, mats.data(), n);
+	}, numJoints));
+
+	Print_Result("mat => quat: MATRIX4X4_To_QUAT", Measure_Ns_Per_Op([&](const int n)
+	{
+		MathLib::QUAT qr;
+
+		for (int i = 0; i < n; i++)
+		{
+			MathLib::MATRIX4X4_To_QUAT(&mats[i], qr);
+			qw[i] = qr.w;  qx[i] = qr.x;  qy[i] = qr.y;  qz[i] = qr.z;
+		}
+	}, numJoints));
+
+	Print_Result("mat => quat: MATRIX4X4_To_QUAT_Batch", Measure_Ns_Per_Op([&](const int n)
+	{
+		MathLib::MATRIX4X4_To_QUAT_Batch(mats.data(), q, n);
+	}, numJoints));
+
+	sink_ = qw[numJoints - 1] + mats[numJoints - 1].M00;
+
+} // end Bench_Quaternion_Matrix_Conversion
@@ -0,0 +1,236 @@
+/////////////////////////////////////////////////////////////////////////////////////////////
+// Filename:      BenchmarksUtils.cpp
+// Description:   contains implementation of benchmarks for common utils
+//                (trigonometric functions, etc.)
+//
+// Created:       17.10.26
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "Benchmarks.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <random>
+#include <sstream>
+
+#include "../Utils/Atan2.h"
+#include "../Utils/SinCos.h"
+#include "../Utils/TrigTables.h"
+#include "../Utils/Utils.h"
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                PUBLIC FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void Benchmarks::Bench_Utils()
+{
+	Log::Print("\n\n");
+	Log::Print("---------------------- BENCHMARK: UTILS ---------------------\n");
+
+	Bench_Utils_Functions();
+	Bench_SinCos();
+
+} // end Bench_Utils
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                PRIVATE FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void Benchmarks::Bench_Utils_Functions()
+{
+	// this function measures each function of Utils.h, the polynomial sine/cosine and atan2
+
+	std::vector<float> theta(BENCH_SIZE_1M), degrees(BENCH_SIZE_1M);
+	std::vector<float> fx(BENCH_SIZE_1M), fy(BENCH_SIZE_1M), fz(BENCH_SIZE_1M);
+	std::vector<int> ix(BENCH_SIZE_1M), iy(BENCH_SIZE_1M);
+	std::vector<float> s(BENCH_SIZE_1M), c(BENCH_SIZE_1M);
+	std::vector<int> dist2D(BENCH_SIZE_1M);
+
+	std::mt19937 gen(4);
+	std::uniform_real_distribution<float> dist(-100.0f, 100.0f);
+
+	for (int i = 0; i < BENCH_SIZE_1M; i++)
+	{
+		theta[i] = dist(gen);
+		degrees[i] = RAD_TO_ANGLE(theta[i]);
+
+		fx[i] = dist(gen);
+		fy[i] = dist(gen);
+		fz[i] = dist(gen);
+
+		ix[i] = (int)fx[i];
+		iy[i] = (int)fy[i];
+	}
+
+	Bench_Func("Fast_Sin",         [&](const int i) { s[i] = MathLib::Fast_Sin(degrees[i]); });
+	Bench_Func("Fast_Cos",         [&](const int i) { c[i] = MathLib::Fast_Cos(degrees[i]); });
+	Bench_Func("Fast_Distance_2D", [&](const int i) { dist2D[i] = MathLib::Fast_Distance_2D(ix[i], iy[i]); });
+	Bench_Func("Fast_Distance_3D", [&](const int i) { s[i] = MathLib::Fast_Distance_3D(fx[i], fy[i], fz[i]); });
+	Bench_Func("Fast_SinCos",      [&](const int i) { MathLib::Fast_SinCos(theta[i], s[i], c[i]); });
+	Bench_Func("Fast_Atan2",       [&](const int i) { s[i] = MathLib::Fast_Atan2(fy[i], fx[i]); });
+	Bench_Func("atan2f",           [&](const int i) { s[i] = atan2f(fy[i], fx[i]); });
+
+	// dependent chains: sin + cos stays in [-1.5, 1.5], and x = atan2(x, 0.5)
+	// converges to a non-zero fixed point
+	Bench_Latency("Fast_SinCos", theta[0], [](const float x)
+	{
+		float sinX, cosX;
+		MathLib::Fast_SinCos(x, sinX, cosX);
+		return sinX + cosX;
+	});
+
+	Bench_Latency("Fast_Atan2", fy[0], [](const float x) { return MathLib::Fast_Atan2(x, 0.5f); });
+	Bench_Latency("atan2f",     fy[0], [](const float x) { return atan2f(x, 0.5f); });
+
+	Bench_Batch("SinCos_Array", [&](const int n)
+	{
+		MathLib::SinCos_Array(theta.data(), s.data(), c.data(), n, MathLib::SINCOS_PRECISION_HIGH);
+	});
+
+	Bench_Batch("Atan2_Array", [&](const int n)
+	{
+		MathLib::Atan2_Array(fy.data(), fx.data(), s.data(), n);
+	});
+
+	sink_ = s[0] + c[0] + (float)dist2D[0];
+
+} // end Bench_Utils_Functions
+
+///////////////////////////////////////////////////////////
+
+void Benchmarks::Bench_SinCos()
+{
+	// this function compares computing of sine and cosine (of one angle) by libm,
+	// by the lookup tables (Fast_Sin/Fast_Cos), and by the polynomials (Fast_SinCos
+	// and SinCos_Array) for each precision; also it prints the maximal error of each
+
+	const int numAngles = 4096;
+
+	std::vector<float> theta(numAngles);
+	std::vector<float> degrees(numAngles);
+	std::vector<float> s(numAngles), c(numAngles);
+
+	std::mt19937 gen(3);
+	std::uniform_real_distribution<float> dist(-100.0f, 100.0f);
+
+	for (int i = 0; i < numAngles; i++)
+	{
+		theta[i] = dist(gen);
+		degrees[i] = RAD_TO_ANGLE(theta[i]);
+	}
+
+	// the maximal absolute error of the results against double precision
+	auto maxError = [&]()
+	{
+		double err = 0.0;
+
+		for (int i = 0; i < numAngles; i++)
+		{
+			err = std::max(err, fabs(s[i] - sin((double)theta[i])));
+			err = std::max(err, fabs(c[i] - cos((double)theta[i])));
+		}
+
+		return err;
+	};
+
+	const char* precisionNames[3] = { "LOW", "MEDIUM", "HIGH" };
+	std::stringstream errors;
+	errors << std::scientific << std::setprecision(2);
+
+	//
+	// libm
+	//
+	Print_Result("sincos: sinf + cosf", Measure_Ns_Per_Op([&](const int n)
+	{
+		for (int i = 0; i < n; i++)
+		{
+			s[i] = sinf(theta[i]);
+			c[i] = cosf(theta[i]);
+		}
+	}, numAngles));
+
+	errors << std::left << std::setw(40) << "max error: sinf + cosf" << maxError() << "\n";
+
+	//
+	// lookup tables (angles in degrees)
+	//
+	Print_Result("sincos: Fast_Sin + Fast_Cos (LUT)", Measure_Ns_Per_Op([&](const int n)
+	{
+		for (int i = 0; i < n; i++)
+		{
+			s[i] = MathLib::Fast_Sin(degrees[i]);
+			c[i] = MathLib::Fast_Cos(degrees[i]);
+		}
+	}, numAngles));
+
+	errors << std::left << std::setw(40) << "max error: Fast_Sin + Fast_Cos (LUT)" << maxError() << "\n";
+
+	//
+	// lookup tables of different resolutions (angles in radians)
+	//
+	Print_Result("sincos: Fast_Sin/Cos_LUT <360>", Measure_Ns_Per_Op([&](const int n)
+	{
+		for (int i = 0; i < n; i++)
+		{
+			s[i] = MathLib::Fast_Sin_LUT<360>(theta[i]);
+			c[i] = MathLib::Fast_Cos_LUT<360>(theta[i]);
+		}
+	}, numAngles));
+
+	errors << std::left << std::setw(40) << "max error: Fast_Sin/Cos_LUT <360>" << maxError() << "\n";
+
+	Print_Result("sincos: Fast_Sin/Cos_LUT <1024>", Measure_Ns_Per_Op([&](const int n)
+	{
+		for (int i = 0; i < n; i++)
+		{
+			s[i] = MathLib::Fast_Sin_LUT<1024>(theta[i]);
+			c[i] = MathLib::Fast_Cos_LUT<1024>(theta[i]);
+		}
+	}, numAngles));
+
+	errors << std::left << std::setw(40) << "max error: Fast_Sin/Cos_LUT <1024>" << maxError() << "\n";
+
+	Print_Result("sincos: Fast_Sin/Cos_LUT <4096>", Measure_Ns_Per_Op([&](const int n)
+	{
+		for (int i = 0; i < n; i++)
+		{
+			s[i] = MathLib::Fast_Sin_LUT<4096>(theta[i]);
+			c[i] = MathLib::Fast_Cos_LUT<4096>(theta[i]);
+		}
+	}, numAngles));
+
+	errors << std::left << std::setw(40) << "max error: Fast_Sin/Cos_LUT <4096>" << maxError() << "\n";
+
+	//
+	// polynomials
+	//
+	for (int p = MathLib::SINCOS_PRECISION_LOW; p <= MathLib::SINCOS_PRECISION_HIGH; p++)
+	{
+		const MathLib::SINCOS_PRECISION precision = (MathLib::SINCOS_PRECISION)p;
+		const std::string nameSingle = std::string("sincos: Fast_SinCos ") + precisionNames[p];
+		const std::string nameArray = std::string("sincos: SinCos_Array ") + precisionNames[p];
+
+		Print_Result(nameSingle.c_str(), Measure_Ns_Per_Op([&](const int n)
+		{
+			for (int i = 0; i < n; i++)
+				MathLib::Fast_SinCos(theta[i], s[i], c[i], precision);
+		}, numAngles));
+
+		Print_Result(nameArray.c_str(), Measure_Ns_Per_Op([&](const int n)
+		{
+			MathLib::SinCos_Array(theta.data(), s.data(), c.data(), n, precision);
+		}, numAngles));
+
+		errors << std::left << std::setw(40) << ("max error: Fast_SinCos " + std::string(precisionNames[p])) << maxError() << "\n";
+	}
+
+	sink_ = s[numAngles - 1] + c[numAngles - 1];
+
+	Log::Print(errors.str().c_str());
+
+} // end Bench_SinCos
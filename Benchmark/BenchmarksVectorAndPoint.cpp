@@ -0,0 +1,259 @@
+/////////////////////////////////////////////////////////////////////////////////////////////
+// Filename:      BenchmarksVectorAndPoint.cpp
+// Description:   contains implementation of benchmarks for 2D/3D/4D vectors and points
+//                (each function of PointVector{2,3,4}D.h except the printing ones)
+//
+// Created:       17.10.26
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "Benchmarks.h"
+
+#include <random>
+
+#include "../Matrix/VecExpr.h"
+#include "../VectorAndPoint/VectorAndPoint.h"
+#include "../VectorAndPoint/VectorPacked.h"
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                HELPER FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+static void Init_Random_Floats(std::vector<float> & arr, const unsigned int seed)
+{
+	// fills the array with BENCH_SIZE_1M random values; zero values are excluded
+	// so the vectors can be normalized
+
+	std::mt19937 gen(seed);
+	std::uniform_real_distribution<float> dist(1.0f, 100.0f);
+
+	arr.resize(BENCH_SIZE_1M * 4);
+
+	for (float & value : arr)
+		value = (gen() & 1) ? dist(gen) : -dist(gen);
+
+} // end Init_Random_Floats
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                PUBLIC FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void Benchmarks::Bench_Vectors_And_Points()
+{
+	Log::Print("\n\n");
+	Log::Print("---------------- BENCHMARK: VECTORS AND POINTS --------------\n");
+
+	Bench_Vectors_2D();
+	Bench_Vectors_3D();
+	Bench_Vectors_4D();
+
+} // end Bench_Vectors_And_Points
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                PRIVATE FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void Benchmarks::Bench_Vectors_2D()
+{
+	// this function measures each function for work with 2D vectors and points
+
+	std::vector<float> values;
+	Init_Random_Floats(values, 21);
+
+	std::vector<MathLib::VECTOR2D> a(BENCH_SIZE_1M), b(BENCH_SIZE_1M), r(BENCH_SIZE_1M);
+	std::vector<float> f(BENCH_SIZE_1M);
+
+	for (int i = 0; i < BENCH_SIZE_1M; i++)
+	{
+		MathLib::VECTOR2D_INIT_XY(a[i], values[4*i + 0], values[4*i + 1]);
+		MathLib::VECTOR2D_INIT_XY(b[i], values[4*i + 2], values[4*i + 3]);
+	}
+
+	// inline initialization
+	Bench_Func("VECTOR2D_ZERO",    [&](const int i) { MathLib::VECTOR2D_ZERO(r[i]); });
+	Bench_Func("VECTOR2D_INIT_XY", [&](const int i) { MathLib::VECTOR2D_INIT_XY(r[i], a[i].x, b[i].y); });
+	Bench_Func("VECTOR2D_INIT",    [&](const int i) { MathLib::VECTOR2D_INIT(r[i], a[i]); });
+	Bench_Func("VECTOR2D_COPY",    [&](const int i) { MathLib::VECTOR2D_COPY(r[i], a[i]); });
+	Bench_Func("POINT2D_ZERO",     [&](const int i) { MathLib::POINT2D_ZERO(r[i]); });
+	Bench_Func("POINT2D_INIT_XY",  [&](const int i) { MathLib::POINT2D_INIT_XY(r[i], a[i].x, b[i].y); });
+	Bench_Func("POINT2D_INIT",     [&](const int i) { MathLib::POINT2D_INIT(r[i], a[i]); });
+	Bench_Func("POINT2D_COPY",     [&](const int i) { MathLib::POINT2D_COPY(r[i], a[i]); });
+
+	// math operations
+	Bench_Func("VECTOR2D_Add",        [&](const int i) { MathLib::VECTOR2D_Add(a[i], b[i], r[i]); });
+	Bench_Func("VECTOR2D_Add(ret)",   [&](const int i) { r[i] = MathLib::VECTOR2D_Add(a[i], b[i]); });
+	Bench_Func("VECTOR2D_Sub",        [&](const int i) { MathLib::VECTOR2D_Sub(a[i], b[i], r[i]); });
+	Bench_Func("VECTOR2D_Sub(ret)",   [&](const int i) { r[i] = MathLib::VECTOR2D_Sub(a[i], b[i]); });
+	Bench_Func("VECTOR2D_Scale",      [&](const int i) { MathLib::VECTOR2D_Scale(1.0f, r[i]); });
+	Bench_Func("VECTOR2D_Scale(dst)", [&](const int i) { MathLib::VECTOR2D_Scale(0.5f, a[i], r[i]); });
+	Bench_Func("VECTOR2D_Dot",        [&](const int i) { f[i] = MathLib::VECTOR2D_Dot(a[i], b[i]); });
+	Bench_Func("VECTOR2D_Length",     [&](const int i) { f[i] = MathLib::VECTOR2D_Length(a[i]); });
+	Bench_Func("VECTOR2D_Length_Fast",[&](const int i) { f[i] = MathLib::VECTOR2D_Length_Fast(a[i]); });
+	Bench_Func("VECTOR2D_Normalize",  [&](const int i) { MathLib::VECTOR2D_Normalize(a[i], r[i]); });
+	Bench_Func("VECTOR2D_Normalize(in-place)", [&](const int i) { MathLib::VECTOR2D_Normalize(r[i]); });
+	Bench_Func("VECTOR2D_Build",      [&](const int i) { MathLib::VECTOR2D_Build(a[i], b[i], r[i]); });
+	Bench_Func("VECTOR2D_CosTh",      [&](const int i) { f[i] = MathLib::VECTOR2D_CosTh(a[i], b[i]); });
+
+	sink_ = r[0].x + f[0];
+
+} // end Bench_Vectors_2D
+
+///////////////////////////////////////////////////////////
+
+void Benchmarks::Bench_Vectors_3D()
+{
+	// this function measures each function for work with 3D vectors and points
+
+	std::vector<float> values;
+	Init_Random_Floats(values, 31);
+
+	std::vector<MathLib::VECTOR3D> a(BENCH_SIZE_1M), b(BENCH_SIZE_1M), r(BENCH_SIZE_1M);
+	std::vector<float> f(BENCH_SIZE_1M);
+
+	for (int i = 0; i < BENCH_SIZE_1M; i++)
+	{
+		MathLib::VECTOR3D_INIT_XYZ(a[i], values[4*i + 0], values[4*i + 1], values[4*i + 2]);
+		MathLib::VECTOR3D_INIT_XYZ(b[i], values[4*i + 3], values[4*i + 0], values[4*i + 1]);
+	}
+
+	// inline initialization
+	Bench_Func("VECTOR3D_ZERO",     [&](const int i) { MathLib::VECTOR3D_ZERO(r[i]); });
+	Bench_Func("VECTOR3D_INIT_XYZ", [&](const int i) { MathLib::VECTOR3D_INIT_XYZ(r[i], a[i].x, a[i].y, b[i].z); });
+	Bench_Func("VECTOR3D_INIT",     [&](const int i) { MathLib::VECTOR3D_INIT(r[i], a[i]); });
+	Bench_Func("VECTOR3D_COPY",     [&](const int i) { MathLib::VECTOR3D_COPY(r[i], a[i]); });
+	Bench_Func("POINT3D_INIT_XYZ",  [&](const int i) { MathLib::POINT3D_INIT_XYZ(r[i], a[i].x, a[i].y, b[i].z); });
+	Bench_Func("POINT3D_INIT",      [&](const int i) { MathLib::POINT3D_INIT(r[i], a[i]); });
+	Bench_Func("POINT3D_COPY",      [&](const int i) { MathLib::POINT3D_COPY(r[i], a[i]); });
+
+	// math operations
+	Bench_Func("VECTOR3D_Add",        [&](const int i) { MathLib::VECTOR3D_Add(a[i], b[i], r[i]); });
+	Bench_Func("VECTOR3D_Add(ret)",   [&](const int i) { r[i] = MathLib::VECTOR3D_Add(a[i], b[i]); });
+	Bench_Func("VECTOR3D_Sub",        [&](const int i) { MathLib::VECTOR3D_Sub(a[i], b[i], r[i]); });
+	Bench_Func("VECTOR3D_Sub(ret)",   [&](const int i) { r[i] = MathLib::VECTOR3D_Sub(a[i], b[i]); });
+	Bench_Func("VECTOR3D_Scale",      [&](const int i) { MathLib::VECTOR3D_Scale(1.0f, r[i]); });
+	Bench_Func("VECTOR3D_Scale(dst)", [&](const int i) { MathLib::VECTOR3D_Scale(0.5f, a[i], r[i]); });
+	Bench_Func("VECTOR3D_Dot",        [&](const int i) { f[i] = MathLib::VECTOR3D_Dot(a[i], b[i]); });
+	Bench_Func("VECTOR3D_Cross",      [&](const int i) { MathLib::VECTOR3D_Cross(a[i], b[i], r[i]); });
+	Bench_Func("VECTOR3D_Cross(ret)", [&](const int i) { r[i] = MathLib::VECTOR3D_Cross(a[i], b[i]); });
+	Bench_Func("VECTOR3D_Length",     [&](const int i) { f[i] = MathLib::VECTOR3D_Length(a[i]); });
+	Bench_Func("VECTOR3D_Length_Fast",[&](const int i) { f[i] = MathLib::VECTOR3D_Length_Fast(a[i]); });
+	Bench_Func("VECTOR3D_Normalize",  [&](const int i) { MathLib::VECTOR3D_Normalize(a[i], r[i]); });
+	Bench_Func("VECTOR3D_Normalize(in-place)", [&](const int i) { MathLib::VECTOR3D_Normalize(r[i]); });
+	Bench_Func("VECTOR3D_Build",      [&](const int i) { MathLib::VECTOR3D_Build(a[i], b[i], r[i]); });
+	Bench_Func("VECTOR3D_CosTh",      [&](const int i) { f[i] = MathLib::VECTOR3D_CosTh(a[i], b[i]); });
+
+	// the same functions of the generic core (inline, the same layout of the data)
+	std::vector<MathLib::Vec3f> av(BENCH_SIZE_1M), bv(BENCH_SIZE_1M), rv(BENCH_SIZE_1M);
+
+	for (int i = 0; i < BENCH_SIZE_1M; i++)
+	{
+		av[i] = MathLib::To_Vec(a[i]);
+		bv[i] = MathLib::To_Vec(b[i]);
+	}
+
+	Bench_Func("Vec3f: Vec_Add",       [&](const int i) { rv[i] = MathLib::Vec_Add(av[i], bv[i]); });
+	Bench_Func("Vec3f: Vec_Scale",     [&](const int i) { rv[i] = MathLib::Vec_Scale(0.5f, av[i]); });
+	Bench_Func("Vec3f: Vec_Dot",       [&](const int i) { f[i] = MathLib::Vec_Dot(av[i], bv[i]); });
+	Bench_Func("Vec3f: Vec_Cross",     [&](const int i) { rv[i] = MathLib::Vec_Cross(av[i], bv[i]); });
+	Bench_Func("Vec3f: Vec_Normalize", [&](const int i) { rv[i] = MathLib::Vec_Normalize(av[i]); });
+
+	// a chain a + b*k - c: by the functions (a temporary for each step) and
+	// by the expression templates (one pass per element)
+	std::vector<MathLib::VECTOR3D> c(BENCH_SIZE_1M, MathLib::VECTOR3D(0.5f, -0.25f, 2.0f));
+	const float k = 0.75f;
+
+	Bench_Batch("VECTOR3D a+b*k-c (functions)", [&](const int n)
+	{
+		MathLib::VECTOR3D scaled;
+
+		for (int i = 0; i < n; i++)
+		{
+			MathLib::VECTOR3D_Scale(k, b[i], scaled);
+			r[i] = MathLib::VECTOR3D_Sub(MathLib::VECTOR3D_Add(a[i], scaled), c[i]);
+		}
+	});
+
+	Bench_Batch("VECTOR3D a+b*k-c (expression)", [&](const int n)
+	{
+		MathLib::Expr_Array(r.data(), n) = MathLib::Expr_Array(a.data(), n) + MathLib::Expr_Array(b.data(), n)*k -
+			MathLib::Expr_Array(c.data(), n);
+	});
+
+	// octahedral packing of unit vectors (SoA streams)
+	std::vector<float> nx(BENCH_SIZE_1M), ny(BENCH_SIZE_1M), nz(BENCH_SIZE_1M);
+	std::vector<MathLib::VECTOR3D_OCT16> oct16(BENCH_SIZE_1M);
+	std::vector<MathLib::VECTOR3D_OCT32> oct32(BENCH_SIZE_1M);
+
+	for (int i = 0; i < BENCH_SIZE_1M; i++)
+	{
+		MathLib::VECTOR3D n;
+
+		MathLib::VECTOR3D_Normalize(a[i], n);
+		nx[i] = n.x;  ny[i] = n.y;  nz[i] = n.z;
+	}
+
+	Bench_Func("VECTOR3D_Pack_Oct (16 bits)",   [&](const int i) { MathLib::VECTOR3D_Pack_Oct(a[i], oct16[i]); });
+	Bench_Func("VECTOR3D_Unpack_Oct (16 bits)", [&](const int i) { MathLib::VECTOR3D_Unpack_Oct(oct16[i], r[i]); });
+
+	Bench_Batch("VECTOR3D_Pack_Oct_Batch (16)",   [&](const int n) { MathLib::VECTOR3D_Pack_Oct_Batch(nx.data(), ny.data(), nz.data(), oct16.data(), n); });
+	Bench_Batch("VECTOR3D_Pack_Oct_Batch (32)",   [&](const int n) { MathLib::VECTOR3D_Pack_Oct_Batch(nx.data(), ny.data(), nz.data(), oct32.data(), n); });
+	Bench_Batch("VECTOR3D_Unpack_Oct_Batch (16)", [&](const int n) { MathLib::VECTOR3D_Unpack_Oct_Batch(oct16.data(), nx.data(), ny.data(), nz.data(), n); });
+	Bench_Batch("VECTOR3D_Unpack_Oct_Batch (32)", [&](const int n) { MathLib::VECTOR3D_Unpack_Oct_Batch(oct32.data(), nx.data(), ny.data(), nz.data(), n); });
+
+	sink_ = r[0].x + f[0] + rv[0][0] + nx[0] + (float)(oct16[0].M[0] + oct32[0].M[0]);
+
+} // end Bench_Vectors_3D
+
+///////////////////////////////////////////////////////////
+
+void Benchmarks::Bench_Vectors_4D()
+{
+	// this function measures each function for work with 4D vectors and points
+
+	std::vector<float> values;
+	Init_Random_Floats(values, 41);
+
+	std::vector<MathLib::VECTOR4D> a(BENCH_SIZE_1M), b(BENCH_SIZE_1M), r(BENCH_SIZE_1M);
+	std::vector<float> f(BENCH_SIZE_1M);
+
+	for (int i = 0; i < BENCH_SIZE_1M; i++)
+	{
+		MathLib::VECTOR4D_INIT_XYZ(a[i], values[4*i + 0], values[4*i + 1], values[4*i + 2]);
+		MathLib::VECTOR4D_INIT_XYZ(b[i], values[4*i + 3], values[4*i + 0], values[4*i + 1]);
+	}
+
+	// inline initialization
+	Bench_Func("VECTOR4D_ZERO",     [&](const int i) { MathLib::VECTOR4D_ZERO(r[i]); });
+	Bench_Func("VECTOR4D_INIT_XYZ", [&](const int i) { MathLib::VECTOR4D_INIT_XYZ(r[i], a[i].x, a[i].y, b[i].z); });
+	Bench_Func("VECTOR4D_INIT",     [&](const int i) { MathLib::VECTOR4D_INIT(r[i], a[i]); });
+	Bench_Func("VECTOR4D_COPY",     [&](const int i) { MathLib::VECTOR4D_COPY(r[i], a[i]); });
+	Bench_Func("POINT4D_INIT",      [&](const int i) { MathLib::POINT4D_INIT(r[i], a[i]); });
+	Bench_Func("POINT4D_COPY",      [&](const int i) { MathLib::POINT4D_COPY(r[i], a[i]); });
+
+	// math operations
+	Bench_Func("VECTOR4D_Add",        [&](const int i) { MathLib::VECTOR4D_Add(a[i], b[i], r[i]); });
+	Bench_Func("VECTOR4D_Add(ret)",   [&](const int i) { r[i] = MathLib::VECTOR4D_Add(a[i], b[i]); });
+	Bench_Func("VECTOR4D_Sub",        [&](const int i) { MathLib::VECTOR4D_Sub(a[i], b[i], r[i]); });
+	Bench_Func("VECTOR4D_Sub(ret)",   [&](const int i) { r[i] = MathLib::VECTOR4D_Sub(a[i], b[i]); });
+	Bench_Func("VECTOR4D_Scale",      [&](const int i) { MathLib::VECTOR4D_Scale(1.0f, r[i]); });
+	Bench_Func("VECTOR4D_Scale(dst)", [&](const int i) { MathLib::VECTOR4D_Scale(0.5f, a[i], r[i]); });
+	Bench_Func("VECTOR4D_Dot",        [&](const int i) { f[i] = MathLib::VECTOR4D_Dot(a[i], b[i]); });
+	Bench_Func("VECTOR4D_Cross",      [&](const int i) { MathLib::VECTOR4D_Cross(a[i], b[i], r[i]); });
+	Bench_Func("VECTOR4D_Cross(ret)", [&](const int i) { r[i] = MathLib::VECTOR4D_Cross(a[i], b[i]); });
+	Bench_Func("VECTOR4D_Length",     [&](const int i) { f[i] = MathLib::VECTOR4D_Length(a[i]); });
+	Bench_Func("VECTOR4D_Length_Fast",[&](const int i) { f[i] = MathLib::VECTOR4D_Length_Fast(a[i]); });
+	Bench_Func("VECTOR4D_Normalize",  [&](const int i) { MathLib::VECTOR4D_Normalize(a[i], r[i]); });
+	Bench_Func("VECTOR4D_Normalize(in-place)", [&](const int i) { MathLib::VECTOR4D_Normalize(r[i]); });
+	Bench_Func("VECTOR4D_Build",      [&](const int i) { MathLib::VECTOR4D_Build(a[i], b[i], r[i]); });
+	Bench_Func("VECTOR4D_CosTh",      [&](const int i) { f[i] = MathLib::VECTOR4D_CosTh(a[i], b[i]); });
+
+	sink_ = r[0].x + f[0];
+
+} // end Bench_Vectors_4D
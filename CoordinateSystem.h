@@ -53,18 +53,18 @@ typedef struct CYLINDRICAL3D_TYPE
 // 3D spherical coordinates;
 // point p(p, phi, theta) is defined by a distance and two angles (in radians):
 //    p     - polar radius; distance from the coordinates beginning (pole) to the p point;
-//    theta - latitude; it is an angle (in radians) between positive direction of
+//    phi   - it is an angle (in radians) between positive direction of
 //            Z-axis and the line segment which goes from the pole to the p point;
 //            is located in the interval [0, PI].
-//    phi   - longitude; it is an angle (in radians) between projection onto the xy plane 
+//    theta - longitude; it is an angle (in radians) between projection onto the xy plane 
 //            of a line segment which goes from the pole to the p point AND between positive
-//            direction of X-axis;
+//            direction of X-axis; is located in the interval [-PI, PI]
 //            (is analogue of a standard polar angle in the 2D polar coodrinates)
 typedef struct SPHERICAL3D_TYPE
 {
 	float p = 0.0f;          // polar radius
-	float theta = 0.0f;      // latitude
-	float phi = 0.0f;        // longitude
+	float theta = 0.0f;      // longitude (azimuth)
+	float phi = 0.0f;        // angle from the positive direction of Z-axis
 } SPHERICAL3D, *SPHERICAL3D_PTR;
 
 
@@ -75,7 +75,7 @@ typedef struct SPHERICAL3D_TYPE
 //                  FUNCTIONS TO WORK WITH COODRINATE SYSTEMS
 ////////////////////////////////////////////////////////////////////////////////////////////
 
-void POLAR2D_To_POINT2D(const POLAR2D* pPolar, POINT2D* pRect)
+inline void POLAR2D_To_POINT2D(const POLAR2D* pPolar, POINT2D* pRect)
 {
 	// convert 2D polar coordinates to decart (rectangular) coordinates
 	pRect->x = pPolar->r * cosf(pPolar->theta);
@@ -85,7 +85,7 @@ void POLAR2D_To_POINT2D(const POLAR2D* pPolar, POINT2D* pRect)
 
 /////////////////////////////////////////////////////////////
 
-void POLAR2D_To_RectXY(const POLAR2D* pPolar, 
+inline void POLAR2D_To_RectXY(const POLAR2D* pPolar, 
 	float* x, 
 	float* y)
 {
@@ -98,27 +98,27 @@ void POLAR2D_To_RectXY(const POLAR2D* pPolar,
 /////////////////////////////////////////////////////////////
 
 
-void POINT2D_To_POLAR2D(const POINT2D* pRect, POLAR2D* pPolar)
+inline void POINT2D_To_POLAR2D(const POINT2D* pRect, POLAR2D* pPolar)
 {
 	// convert rectangular (decart) coordinates to polar
 	pPolar->r = sqrtf((pRect->x * pRect->x) + (pRect->y * pRect->y));
-	pPolar->theta = atanf(pRect->y / pRect->x);
+	pPolar->theta = atan2f(pRect->y, pRect->x);
 
 } // end POINT2D_To_POLAR2D
 
-void POINT2D_To_PolarRTh(const POINT2D* pRect, 
+inline void POINT2D_To_PolarRTh(const POINT2D* pRect, 
 	float* r, 
 	float* theta)
 {
 	// convert rectangular (decart) coordinates to polar
 	*r = sqrtf((pRect->x * pRect->x) + (pRect->y * pRect->y));
-	*theta = atanf(pRect->y / pRect->x);
+	*theta = atan2f(pRect->y, pRect->x);
 
 } // end POINT2D_To_PolarRTh
 
 /////////////////////////////////////////////////////////////
 
-void CYLINDRICAL3D_To_POINT3D(const CYLINDRICAL3D* pCyl, POINT3D* pRect)
+inline void CYLINDRICAL3D_To_POINT3D(const CYLINDRICAL3D* pCyl, POINT3D* pRect)
 {
 	// convertation of cylindrical coordinates into rectangle (decart) coordinates
 	pRect->x = pCyl->r * cosf(pCyl->theta);
@@ -129,7 +129,7 @@ void CYLINDRICAL3D_To_POINT3D(const CYLINDRICAL3D* pCyl, POINT3D* pRect)
 
 /////////////////////////////////////////////////////////////
 
-void CYLINDRICAL3D_To_RectXYZ(const CYLINDRICAL3D* pCyl, 
+inline void CYLINDRICAL3D_To_RectXYZ(const CYLINDRICAL3D* pCyl, 
 	float* x, 
 	float* y, 
 	float* z)
@@ -142,21 +142,21 @@ void CYLINDRICAL3D_To_RectXYZ(const CYLINDRICAL3D* pCyl,
 
 /////////////////////////////////////////////////////////////
 
-void POINT3D_To_CylindricalRThZ(const POINT3D* pRect, 
+inline void POINT3D_To_CylindricalRThZ(const POINT3D* pRect, 
 	float* r, 
 	float* theta, 
 	float* z)
 {
 	// convert rectangular to cylindrical
 	*r     = sqrtf((pRect->x * pRect->x) + (pRect->y * pRect->y));
-	*theta = atanf(pRect->y / pRect->x);
+	*theta = atan2f(pRect->y, pRect->x);
 	*z     = pRect->z;
 
 } // end POINT3D_To_CylindricalRThZ
 
 /////////////////////////////////////////////////////////////
 
-void SPHERICAL3D_To_POINT3D(const SPHERICAL3D* pSph, POINT3D* pRect)
+inline void SPHERICAL3D_To_POINT3D(const SPHERICAL3D* pSph, POINT3D* pRect)
 {
 	// convert spherical coordinates to rectanglular (decart);
 
@@ -170,7 +170,7 @@ void SPHERICAL3D_To_POINT3D(const SPHERICAL3D* pSph, POINT3D* pRect)
 
 /////////////////////////////////////////////////////////////
 
-void SPHERICAL3D_To_RectXYZ(const SPHERICAL3D* pSph, 
+inline void SPHERICAL3D_To_RectXYZ(const SPHERICAL3D* pSph, 
 	float* x,
 	float* y, 
 	float* z)
@@ -188,7 +188,7 @@ void SPHERICAL3D_To_RectXYZ(const SPHERICAL3D* pSph,
 
 /////////////////////////////////////////////////////////////
 
-void POINT3D_To_SPHERICAL3D(const POINT3D* pRect, SPHERICAL3D* pSph)
+inline void POINT3D_To_SPHERICAL3D(const POINT3D* pRect, SPHERICAL3D* pSph)
 {
 	// convert rectangular coordinates to spherical
 
@@ -196,14 +196,14 @@ void POINT3D_To_SPHERICAL3D(const POINT3D* pRect, SPHERICAL3D* pSph)
 	float r = sqrtf((pRect->x * pRect->x) + (pRect->y * pRect->y));
 
 	pSph->p     = sqrtf((r * r) + (pRect->z * pRect->z));
-	pSph->phi   = atanf(r / pRect->z);
-	pSph->theta = atanf(pRect->y / pRect->x);
+	pSph->phi   = atan2f(r, pRect->z);
+	pSph->theta = atan2f(pRect->y, pRect->x);
 
 } // end POINT3D_To_SPHERICAL3D
 
 /////////////////////////////////////////////////////////////
 
-void POINT3D_To_SphericalRThPh(const POINT3D* pRect, 
+inline void POINT3D_To_SphericalRThPh(const POINT3D* pRect, 
 	float* p, 
 	float* theta, 
 	float* phi)
@@ -214,8 +214,8 @@ void POINT3D_To_SphericalRThPh(const POINT3D* pRect,
 	float r = sqrtf((pRect->x * pRect->x) + (pRect->y * pRect->y));
 
 	*p     = sqrtf((r * r) + (pRect->z * pRect->z));
-	*phi   = atanf(r / pRect->z);
-	*theta = atanf(pRect->y / pRect->x);
+	*phi   = atan2f(r, pRect->z);
+	*theta = atan2f(pRect->y, pRect->x);
 
 } // end POINT3D_To_SphericalRThPh
 
@@ -0,0 +1,254 @@
+////////////////////////////////////////////////////////////////////////////////////////////
+// Filename:      CoordinateSystemBatch.cpp
+// Description:   contains implementation of batch conversion between coordinate systems
+//
+// Created:       17.10.26
+////////////////////////////////////////////////////////////////////////////////////////////
+#include "CoordinateSystemBatch.h"
+
+#include <cassert>
+
+#include "Utils/Atan2.h"
+#include "Utils/SinCos.h"
+
+
+namespace MathLib
+{
+
+//
+// NOTE: each function processes the streams by blocks of COORD_BATCH_BLOCK_SIZE elements:
+//       first the trigonometric functions of the whole block are computed by the array
+//       kernels (SSE/AVX2 by the CPU), and then a plain loop combines them with the
+//       radii; in the loop all the inputs of an element are read before its outputs
+//       are written so the conversion can be done in-place
+//
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                              2D POLAR COORDINATES
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void POLAR2D_To_POINT2D_Batch(const float* r, const float* theta,
+	float* x, float* y,
+	const int num)
+{
+	// converts num 2D polar coordinates into rectangular ones
+
+	assert(r && theta);
+	assert(x && y);
+	assert(num >= 0);
+
+	float s[COORD_BATCH_BLOCK_SIZE];
+	float c[COORD_BATCH_BLOCK_SIZE];
+
+	for (int start = 0; start < num; start += COORD_BATCH_BLOCK_SIZE)
+	{
+		const int count = (num - start < COORD_BATCH_BLOCK_SIZE) ? (num - start) : COORD_BATCH_BLOCK_SIZE;
+
+		SinCos_Array(theta + start, s, c, count, SINCOS_PRECISION_HIGH);
+
+		for (int i = 0; i < count; i++)
+		{
+			const float ri = r[start + i];
+
+			x[start + i] = ri * c[i];
+			y[start + i] = ri * s[i];
+		}
+	}
+
+} // end POLAR2D_To_POINT2D_Batch
+
+///////////////////////////////////////////////////////////
+
+void POINT2D_To_POLAR2D_Batch(const float* x, const float* y,
+	float* r, float* theta,
+	const int num)
+{
+	// converts num 2D rectangular coordinates into polar ones (theta is in [-PI, PI])
+
+	assert(x && y);
+	assert(r && theta);
+	assert(num >= 0);
+
+	float angle[COORD_BATCH_BLOCK_SIZE];
+
+	for (int start = 0; start < num; start += COORD_BATCH_BLOCK_SIZE)
+	{
+		const int count = (num - start < COORD_BATCH_BLOCK_SIZE) ? (num - start) : COORD_BATCH_BLOCK_SIZE;
+
+		Atan2_Array(y + start, x + start, angle, count);
+
+		for (int i = 0; i < count; i++)
+		{
+			const float xi = x[start + i];
+			const float yi = y[start + i];
+
+			r[start + i] = sqrtf((xi * xi) + (yi * yi));
+			theta[start + i] = angle[i];
+		}
+	}
+
+} // end POINT2D_To_POLAR2D_Batch
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                            3D CYLINDRICAL COORDINATES
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void CYLINDRICAL3D_To_POINT3D_Batch(const float* r, const float* theta, const float* zIn,
+	float* x, float* y, float* z,
+	const int num)
+{
+	// converts num cylindrical coordinates into rectangular ones
+
+	assert(r && theta && zIn);
+	assert(x && y && z);
+	assert(num >= 0);
+
+	float s[COORD_BATCH_BLOCK_SIZE];
+	float c[COORD_BATCH_BLOCK_SIZE];
+
+	for (int start = 0; start < num; start += COORD_BATCH_BLOCK_SIZE)
+	{
+		const int count = (num - start < COORD_BATCH_BLOCK_SIZE) ? (num - start) : COORD_BATCH_BLOCK_SIZE;
+
+		SinCos_Array(theta + start, s, c, count, SINCOS_PRECISION_HIGH);
+
+		for (int i = 0; i < count; i++)
+		{
+			const float ri = r[start + i];
+			const float zi = zIn[start + i];
+
+			x[start + i] = ri * c[i];
+			y[start + i] = ri * s[i];
+			z[start + i] = zi;
+		}
+	}
+
+} // end CYLINDRICAL3D_To_POINT3D_Batch
+
+///////////////////////////////////////////////////////////
+
+void POINT3D_To_CYLINDRICAL3D_Batch(const float* x, const float* y, const float* zIn,
+	float* r, float* theta, float* z,
+	const int num)
+{
+	// converts num rectangular coordinates into cylindrical ones (theta is in [-PI, PI])
+
+	assert(x && y && zIn);
+	assert(r && theta && z);
+	assert(num >= 0);
+
+	float angle[COORD_BATCH_BLOCK_SIZE];
+
+	for (int start = 0; start < num; start += COORD_BATCH_BLOCK_SIZE)
+	{
+		const int count = (num - start < COORD_BATCH_BLOCK_SIZE) ? (num - start) : COORD_BATCH_BLOCK_SIZE;
+
+		Atan2_Array(y + start, x + start, angle, count);
+
+		for (int i = 0; i < count; i++)
+		{
+			const float xi = x[start + i];
+			const float yi = y[start + i];
+			const float zi = zIn[start + i];
+
+			r[start + i] = sqrtf((xi * xi) + (yi * yi));
+			theta[start + i] = angle[i];
+			z[start + i] = zi;
+		}
+	}
+
+} // end POINT3D_To_CYLINDRICAL3D_Batch
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                             3D SPHERICAL COORDINATES
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void SPHERICAL3D_To_POINT3D_Batch(const float* p, const float* theta, const float* phi,
+	float* x, float* y, float* z,
+	const int num)
+{
+	// converts num spherical coordinates into rectangular ones
+
+	assert(p && theta && phi);
+	assert(x && y && z);
+	assert(num >= 0);
+
+	float sinTheta[COORD_BATCH_BLOCK_SIZE];
+	float cosTheta[COORD_BATCH_BLOCK_SIZE];
+	float sinPhi[COORD_BATCH_BLOCK_SIZE];
+	float cosPhi[COORD_BATCH_BLOCK_SIZE];
+
+	for (int start = 0; start < num; start += COORD_BATCH_BLOCK_SIZE)
+	{
+		const int count = (num - start < COORD_BATCH_BLOCK_SIZE) ? (num - start) : COORD_BATCH_BLOCK_SIZE;
+
+		SinCos_Array(theta + start, sinTheta, cosTheta, count, SINCOS_PRECISION_HIGH);
+		SinCos_Array(phi + start, sinPhi, cosPhi, count, SINCOS_PRECISION_HIGH);
+
+		for (int i = 0; i < count; i++)
+		{
+			const float pi = p[start + i];
+
+			// pre-compute r (the projection onto XY-plane) to simplify computation of x,y
+			const float r = pi * sinPhi[i];
+
+			x[start + i] = r * cosTheta[i];
+			y[start + i] = r * sinTheta[i];
+			z[start + i] = pi * cosPhi[i];
+		}
+	}
+
+} // end SPHERICAL3D_To_POINT3D_Batch
+
+///////////////////////////////////////////////////////////
+
+void POINT3D_To_SPHERICAL3D_Batch(const float* x, const float* y, const float* z,
+	float* p, float* theta, float* phi,
+	const int num)
+{
+	// converts num rectangular coordinates into spherical ones
+	// (theta is in [-PI, PI], phi is in [0, PI])
+
+	assert(x && y && z);
+	assert(p && theta && phi);
+	assert(num >= 0);
+
+	float r[COORD_BATCH_BLOCK_SIZE];
+	float angleTheta[COORD_BATCH_BLOCK_SIZE];
+	float anglePhi[COORD_BATCH_BLOCK_SIZE];
+
+	for (int start = 0; start < num; start += COORD_BATCH_BLOCK_SIZE)
+	{
+		const int count = (num - start < COORD_BATCH_BLOCK_SIZE) ? (num - start) : COORD_BATCH_BLOCK_SIZE;
+
+		// the projection onto XY-plane
+		for (int i = 0; i < count; i++)
+		{
+			const float xi = x[start + i];
+			const float yi = y[start + i];
+
+			r[i] = sqrtf((xi * xi) + (yi * yi));
+		}
+
+		Atan2_Array(y + start, x + start, angleTheta, count);
+		Atan2_Array(r, z + start, anglePhi, count);
+
+		for (int i = 0; i < count; i++)
+		{
+			const float zi = z[start + i];
+
+			p[start + i] = sqrtf((r[i] * r[i]) + (zi * zi));
+			theta[start + i] = angleTheta[i];
+			phi[start + i] = anglePhi[i];
+		}
+	}
+
+} // end POINT3D_To_SPHERICAL3D_Batch
+
+} // end namespace MathLib
@@ -0,0 +1,68 @@
+////////////////////////////////////////////////////////////////////////////////////////////
+// Filename:      CoordinateSystemBatch.h
+// Description:   contains functional for batch conversion between coordinate systems
+//                (polar, cylindrical, spherical <-> rectangular); coordinates are stored
+//                in SoA form (separate streams), so whole scans are converted by one call
+//
+// Created:       17.10.26
+////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "CoordinateSystem.h"
+
+
+namespace MathLib
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                   CONSTANTS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+// the number of elements which are converted at once: sine/cosine/atan2 of a block
+// are computed by the array kernels into temporary buffers which stay in L1 cache
+constexpr int COORD_BATCH_BLOCK_SIZE = 256;
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                            FUNCTIONS PROTOTYPES
+////////////////////////////////////////////////////////////////////////////////////////////
+
+//
+// the angles are computed by Fast_SinCos (SINCOS_PRECISION_HIGH) and Fast_Atan2,
+// and the results don't depend on the SIMD level of the CPU (see SinCos_Array and
+// Atan2_Array); the meaning of the coordinates is the same as in CoordinateSystem.h;
+//
+// output streams may be the same as the input streams (in-place conversion),
+// but they must not partially overlap
+//
+
+// 2D polar (r, theta) <-> rectangular (x, y)
+void POLAR2D_To_POINT2D_Batch(const float* r, const float* theta,
+	float* x, float* y,
+	const int num);
+
+void POINT2D_To_POLAR2D_Batch(const float* x, const float* y,
+	float* r, float* theta,
+	const int num);
+
+// 3D cylindrical (r, theta, z) <-> rectangular (x, y, z)
+void CYLINDRICAL3D_To_POINT3D_Batch(const float* r, const float* theta, const float* zIn,
+	float* x, float* y, float* z,
+	const int num);
+
+void POINT3D_To_CYLINDRICAL3D_Batch(const float* x, const float* y, const float* zIn,
+	float* r, float* theta, float* z,
+	const int num);
+
+// 3D spherical (p, theta, phi) <-> rectangular (x, y, z)
+void SPHERICAL3D_To_POINT3D_Batch(const float* p, const float* theta, const float* phi,
+	float* x, float* y, float* z,
+	const int num);
+
+void POINT3D_To_SPHERICAL3D_Batch(const float* x, const float* y, const float* z,
+	float* p, float* theta, float* phi,
+	const int num);
+
+} // end namespace MathLib
@@ -0,0 +1,126 @@
+////////////////////////////////////////////////////////////////////////////////////////////
+// Filename:      CoordinateSystemScan.cpp
+// Description:   contains implementation of streaming conversion of sensor sweeps
+//                from spherical to rectangular coordinates
+//
+// Created:       17.10.26
+////////////////////////////////////////////////////////////////////////////////////////////
+#include "CoordinateSystemScan.h"
+
+#include <cassert>
+
+
+namespace MathLib
+{
+
+int Init_Spherical_Scan(SPHERICAL_SCAN* pScan,
+	const float* phi,
+	const int numRings,
+	const float thetaStart,
+	const float thetaStep,
+	const int numColumns)
+{
+	// this function computes sine/cosine of the angles of rings and columns;
+	// they are computed by sinf/cosf so the points are the same as by SPHERICAL3D_To_POINT3D
+
+	assert(pScan != nullptr);
+	assert(phi != nullptr);
+
+	if ((numRings <= 0) || (numColumns <= 0))
+		return 0;
+
+	pScan->sinPhi.resize(numRings);
+	pScan->cosPhi.resize(numRings);
+	pScan->sinTheta.resize(numColumns);
+	pScan->cosTheta.resize(numColumns);
+
+	for (int ring = 0; ring < numRings; ring++)
+	{
+		pScan->sinPhi[ring] = sinf(phi[ring]);
+		pScan->cosPhi[ring] = cosf(phi[ring]);
+	}
+
+	for (int column = 0; column < numColumns; column++)
+	{
+		const float theta = thetaStart + (float)column * thetaStep;
+
+		pScan->sinTheta[column] = sinf(theta);
+		pScan->cosTheta[column] = cosf(theta);
+	}
+
+	pScan->numRings = numRings;
+	pScan->numColumns = numColumns;
+	pScan->pos = 0;
+
+	return 1;
+
+} // end Init_Spherical_Scan
+
+///////////////////////////////////////////////////////////
+
+void Reset_Spherical_Scan(SPHERICAL_SCAN* pScan)
+{
+	assert(pScan != nullptr);
+	pScan->pos = 0;
+
+} // end Reset_Spherical_Scan
+
+///////////////////////////////////////////////////////////
+
+void Spherical_Scan_To_POINT3D(SPHERICAL_SCAN* pScan,
+	const float* ranges,
+	POINT3D* points,
+	const int num)
+{
+	// this function converts the next num measurements of the stream;
+	// the chunk is processed by runs of measurements of the same column
+	// so the inner loop only reads the ring tables
+
+	assert(pScan != nullptr);
+	assert(ranges && points);
+	assert(num >= 0);
+	assert(pScan->numRings > 0);
+
+	const int numRings = pScan->numRings;
+	const float* sinPhi = pScan->sinPhi.data();
+	const float* cosPhi = pScan->cosPhi.data();
+
+	int column = pScan->pos / numRings;
+	int ring = pScan->pos % numRings;
+	int i = 0;
+
+	while (i < num)
+	{
+		const float sinTheta = pScan->sinTheta[column];
+		const float cosTheta = pScan->cosTheta[column];
+
+		const int count = (num - i < numRings - ring) ? (num - i) : (numRings - ring);
+
+		for (int k = 0; k < count; k++)
+		{
+			const float p = ranges[i + k];
+
+			// r is the projection onto XY-plane (as in SPHERICAL3D_To_POINT3D)
+			const float r = p * sinPhi[ring + k];
+
+			points[i + k].x = r * cosTheta;
+			points[i + k].y = r * sinTheta;
+			points[i + k].z = p * cosPhi[ring + k];
+		}
+
+		i += count;
+		ring += count;
+
+		// go to the next column (and to the next sweep after the last column)
+		if (ring == numRings)
+		{
+			ring = 0;
+			column = (column + 1 == pScan->numColumns) ? 0 : column + 1;
+		}
+	}
+
+	pScan->pos = column * numRings + ring;
+
+} // end Spherical_Scan_To_POINT3D
+
+} // end namespace MathLib
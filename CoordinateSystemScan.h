@@ -0,0 +1,75 @@
+////////////////////////////////////////////////////////////////////////////////////////////
+// Filename:      CoordinateSystemScan.h
+// Description:   contains functional for streaming conversion of sensor sweeps
+//                (LiDAR-style range images) from spherical to rectangular coordinates;
+//                a sweep has a fixed set of rings (polar angles) and evenly spaced
+//                columns (azimuths), so sine/cosine of all the angles are computed
+//                only once and each point costs just a few multiplications
+//
+// Created:       17.10.26
+////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <vector>
+
+#include "CoordinateSystem.h"
+
+
+namespace MathLib
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                 DATA STRUCTURES
+////////////////////////////////////////////////////////////////////////////////////////////
+
+// geometry of a sweep and the current position of the stream in it;
+//
+// the measurements (ranges) go column by column, inside a column ring by ring
+// (as a spinning sensor fires them), so the measurement i of a sweep is:
+//    ring   = i % numRings,
+//    column = i / numRings;
+//
+// the point of a measurement is the same as of SPHERICAL3D(p: range, theta: azimuth of
+// the column, phi: polar angle of the ring); for an elevation angle e (from XY-plane)
+// of a ring its polar angle is phi = PI/2 - e
+typedef struct SPHERICAL_SCAN_TYPE
+{
+	std::vector<float> sinPhi;     // per ring
+	std::vector<float> cosPhi;
+	std::vector<float> sinTheta;   // per column
+	std::vector<float> cosTheta;
+
+	int numRings = 0;
+	int numColumns = 0;
+	int pos = 0;                   // index of the next measurement in the sweep
+} SPHERICAL_SCAN, *SPHERICAL_SCAN_PTR;
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                            FUNCTIONS PROTOTYPES
+////////////////////////////////////////////////////////////////////////////////////////////
+
+// computes the tables for numRings polar angles phi[] and numColumns azimuths
+// theta = thetaStart + column * thetaStep, and resets the stream;
+// returns 1 if the scan is initialized, and 0 if the sizes are invalid
+int Init_Spherical_Scan(SPHERICAL_SCAN* pScan,
+	const float* phi,
+	const int numRings,
+	const float thetaStart,
+	const float thetaStep,
+	const int numColumns);
+
+// the next measurement is the first one of a sweep
+void Reset_Spherical_Scan(SPHERICAL_SCAN* pScan);
+
+// converts the next num measurements of the stream into points[0..num-1];
+// a chunk can have any size and can cross the end of a sweep (then the next sweep
+// starts from the first column), so a sweep never has to be stored fully
+void Spherical_Scan_To_POINT3D(SPHERICAL_SCAN* pScan,
+	const float* ranges,
+	POINT3D* points,
+	const int num);
+
+} // end namespace MathLib
@@ -0,0 +1,1174 @@
+////////////////////////////////////////////////////////////////////////////////////////////
+// Filename:      BVH.cpp
+// Description:   contains implementation of functional for the bounding volume
+//                hierarchy (the build, single queries and packet traversal kernels)
+//
+// Created:       17.10.26
+////////////////////////////////////////////////////////////////////////////////////////////
+#include "BVH.h"
+#include "../Utils/Simd.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cfloat>
+#include <thread>
+
+
+namespace MathLib
+{
+
+// a subtree with fewer primitives is built by the same thread (a new thread isn't worth it)
+constexpr int BVH_PARALLEL_MIN_PRIMS = 4096;
+
+// the traversal stack: each level of the tree adds at most one entry
+constexpr int BVH_STACK_SIZE = BVH_MAX_DEPTH + 4;
+
+
+//
+// NOTE: min/max are computed as (a < b) ? a : b and (a > b) ? a : b, exactly as
+//       _mm_min_ps/_mm_max_ps do, so the packet kernels cull the same nodes as the single queries
+//
+
+static inline float Min_Float(const float a, const float b) { return (a < b) ? a : b; }
+static inline float Max_Float(const float a, const float b) { return (a > b) ? a : b; }
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                      BUILD
+////////////////////////////////////////////////////////////////////////////////////////////
+
+// a primitive during the build: its box, doubled centroid (min + max) and index; the
+// references are partitioned together with the nodes, so each node reads its primitives
+// in a row (instead of random access to the input boxes)
+typedef struct BVH_PRIM_REF_TYPE
+{
+	float bMin[3];
+	float bMax[3];
+	float c[3];
+	int   index;
+} BVH_PRIM_REF;
+
+
+// data which is shared by all the threads of the build; each thread works with its own
+// range of the references and its own nodes, so only the node counter is atomic
+typedef struct BVH_BUILD_CONTEXT_TYPE
+{
+	BVH_NODE*                 nodes = nullptr;
+	std::vector<BVH_PRIM_REF> refs;
+	std::atomic<int>          numNodes{ 0 };
+} BVH_BUILD_CONTEXT;
+
+
+// bounds and number of primitives (of a bin of the SAH or of a part of a split);
+// it isn't initialized by default since only the used bins must be reset (see Reset_Bounds)
+typedef struct BVH_BOUNDS_TYPE
+{
+	float bMin[3];
+	float bMax[3];
+	int   count;
+} BVH_BOUNDS;
+
+///////////////////////////////////////////////////////////
+
+static inline void Reset_Bounds(BVH_BOUNDS & bounds)
+{
+	for (int k = 0; k < 3; k++)
+	{
+		bounds.bMin[k] = FLT_MAX;
+		bounds.bMax[k] = -FLT_MAX;
+	}
+
+	bounds.count = 0;
+}
+
+///////////////////////////////////////////////////////////
+
+static inline void Grow_Bounds(BVH_BOUNDS & bounds, const float bMin[3], const float bMax[3], const int count)
+{
+	for (int k = 0; k < 3; k++)
+	{
+		bounds.bMin[k] = Min_Float(bMin[k], bounds.bMin[k]);
+		bounds.bMax[k] = Max_Float(bMax[k], bounds.bMax[k]);
+	}
+
+	bounds.count += count;
+}
+
+///////////////////////////////////////////////////////////
+
+static inline float Half_Area(const BVH_BOUNDS & bounds)
+{
+	// half of the surface area (0 for empty bounds)
+	if (bounds.count == 0)
+		return 0.0f;
+
+	const float dx = bounds.bMax[0] - bounds.bMin[0];
+	const float dy = bounds.bMax[1] - bounds.bMin[1];
+	const float dz = bounds.bMax[2] - bounds.bMin[2];
+
+	return (dx * dy) + (dy * dz) + (dz * dx);
+}
+
+///////////////////////////////////////////////////////////
+
+static inline int Bin_Index(const float c, const float cMin, const float scale, const int numBins)
+{
+	const int bin = (int)((c - cMin) * scale);
+	return (bin < numBins - 1) ? bin : numBins - 1;
+}
+
+///////////////////////////////////////////////////////////
+
+static void Build_Node(BVH_BUILD_CONTEXT & ctx,
+	const int nodeIndex,
+	const int first,
+	const int count,
+	const int depth,
+	const int numThreads)
+{
+	// this function computes the box of the node, chooses the split of its primitives
+	// by the binned SAH and builds the children (in a separate thread if it is allowed)
+
+	BVH_PRIM_REF* refs = ctx.refs.data() + first;
+
+	// the box of the node and the box of the centroids
+	BVH_BOUNDS box;
+	BVH_BOUNDS cBox;
+
+	Reset_Bounds(box);
+	Reset_Bounds(cBox);
+
+	for (int i = 0; i < count; i++)
+	{
+		Grow_Bounds(box, refs[i].bMin, refs[i].bMax, 1);
+		Grow_Bounds(cBox, refs[i].c, refs[i].c, 1);
+	}
+
+	BVH_NODE & node = ctx.nodes[nodeIndex];
+
+	node.minX = box.bMin[0];
+	node.minY = box.bMin[1];
+	node.minZ = box.bMin[2];
+	node.maxX = box.bMax[0];
+	node.maxY = box.bMax[1];
+	node.maxZ = box.bMax[2];
+
+	node.leftOrFirst = first;
+	node.count = count;
+
+	if ((count <= 1) || (depth >= BVH_MAX_DEPTH))
+		return;
+
+	// fill the bins of all the axes by one pass over the primitives (an axis is skipped
+	// if all the centroids are in one plane); small nodes need fewer bins (most of the
+	// nodes are small, so it is the main part of the time of the build)
+	const int numBins = (count < BVH_NUM_BINS) ? count : BVH_NUM_BINS;
+	BVH_BOUNDS bins[3][BVH_NUM_BINS];
+	float scale[3];
+
+	for (int axis = 0; axis < 3; axis++)
+	{
+		const float extent = cBox.bMax[axis] - cBox.bMin[axis];
+		scale[axis] = (extent > 0.0f) ? numBins / extent : 0.0f;
+
+		for (int b = 0; b < numBins; b++)
+			Reset_Bounds(bins[axis][b]);
+	}
+
+	for (int i = 0; i < count; i++)
+	{
+		for (int axis = 0; axis < 3; axis++)
+		{
+			if (scale[axis] > 0.0f)
+			{
+				const int b = Bin_Index(refs[i].c[axis], cBox.bMin[axis], scale[axis], numBins);
+				Grow_Bounds(bins[axis][b], refs[i].bMin, refs[i].bMax, 1);
+			}
+		}
+	}
+
+	// find the best split: the cost of a split is the sum of (area * number of primitives)
+	// of both parts (the cost of the leaf is area * count)
+	float bestCost = FLT_MAX;
+	int bestAxis = -1;
+	int bestSplit = 0;
+
+	for (int axis = 0; axis < 3; axis++)
+	{
+		if (scale[axis] <= 0.0f)
+			continue;
+
+		// sweep from the right to get the costs of the right parts of each split
+		float rightCost[BVH_NUM_BINS];
+		BVH_BOUNDS right;
+		Reset_Bounds(right);
+
+		for (int b = numBins - 1; b > 0; b--)
+		{
+			Grow_Bounds(right, bins[axis][b].bMin, bins[axis][b].bMax, bins[axis][b].count);
+			rightCost[b] = right.count * Half_Area(right);
+		}
+
+		// the split b puts the bins [0, b) into the left part
+		BVH_BOUNDS left;
+		Reset_Bounds(left);
+
+		for (int b = 1; b < numBins; b++)
+		{
+			Grow_Bounds(left, bins[axis][b - 1].bMin, bins[axis][b - 1].bMax, bins[axis][b - 1].count);
+
+			if ((left.count == 0) || (left.count == count))
+				continue;
+
+			const float cost = left.count * Half_Area(left) + rightCost[b];
+
+			if (cost < bestCost)
+			{
+				bestCost = cost;
+				bestAxis = axis;
+				bestSplit = b;
+			}
+		}
+	}
+
+	int leftCount = 0;
+
+	if (bestAxis >= 0)
+	{
+		// a small node stays a leaf if it is cheaper than the split
+		// (the traversal of a node costs as much as a test of a primitive)
+		const float leafCost = count * Half_Area(box);
+
+		if ((count <= BVH_MAX_LEAF_SIZE) && (Half_Area(box) + bestCost >= leafCost))
+			return;
+
+		BVH_PRIM_REF* mid = std::partition(refs, refs + count, [&](const BVH_PRIM_REF & ref)
+		{
+			return Bin_Index(ref.c[bestAxis], cBox.bMin[bestAxis], scale[bestAxis], numBins) < bestSplit;
+		});
+
+		leftCount = (int)(mid - refs);
+
+		// the bins of the split aren't empty so it can't happen, but the tree must stay valid
+		if ((leftCount == 0) || (leftCount == count))
+			leftCount = count / 2;
+	}
+	else
+	{
+		// all the centroids are the same: any split is as good as the leaf,
+		// so only large nodes are split (in halves)
+		if (count <= BVH_MAX_LEAF_SIZE)
+			return;
+
+		leftCount = count / 2;
+	}
+
+	// the children are adjacent
+	const int left = ctx.numNodes.fetch_add(2);
+
+	node.leftOrFirst = left;
+	node.count = 0;
+
+	if ((numThreads > 1) && (count >= BVH_PARALLEL_MIN_PRIMS))
+	{
+		const int leftThreads = numThreads / 2;
+
+		std::thread leftThread(Build_Node, std::ref(ctx), left, first, leftCount, depth + 1, leftThreads);
+		Build_Node(ctx, left + 1, first + leftCount, count - leftCount, depth + 1, numThreads - leftThreads);
+
+		leftThread.join();
+	}
+	else
+	{
+		Build_Node(ctx, left, first, leftCount, depth + 1, 1);
+		Build_Node(ctx, left + 1, first + leftCount, count - leftCount, depth + 1, 1);
+	}
+
+} // end Build_Node
+
+///////////////////////////////////////////////////////////
+
+static void Renumber_Node(const BVH_NODE* src, const int srcIndex, BVH_NODE* dst, const int dstIndex, int & numNodes)
+{
+	// this function copies the subtree of src[srcIndex] into dst[dstIndex] numbering the
+	// nodes in the same order as the build by one thread does: the children of a node
+	// get the next two slots, then the left subtree is numbered, then the right one
+
+	const BVH_NODE & node = src[srcIndex];
+
+	dst[dstIndex] = node;
+
+	if (node.count > 0)
+		return;
+
+	const int left = numNodes;
+	numNodes += 2;
+
+	dst[dstIndex].leftOrFirst = left;
+
+	Renumber_Node(src, node.leftOrFirst, dst, left, numNodes);
+	Renumber_Node(src, node.leftOrFirst + 1, dst, left + 1, numNodes);
+
+} // end Renumber_Node
+
+///////////////////////////////////////////////////////////
+
+int BVH_Build(BVH & bvh, const AABB3D* boxes, const int num, const int numThreads)
+{
+	// this function builds BVH of num boxes: the nodes are split top-down by the binned
+	// SAH; the subtrees of large nodes are built in parallel
+
+	assert(num >= 0);
+	assert(numThreads >= 0);
+
+	bvh.nodes.clear();
+	bvh.primIndices.clear();
+	bvh.primBoxes.clear();
+
+	if (num == 0)
+		return 0;
+
+	assert(boxes != nullptr);
+
+	BVH_BUILD_CONTEXT ctx;
+	ctx.refs.resize(num);
+
+	for (int i = 0; i < num; i++)
+	{
+		BVH_PRIM_REF & ref = ctx.refs[i];
+
+		ref.bMin[0] = boxes[i].pMin.x;
+		ref.bMin[1] = boxes[i].pMin.y;
+		ref.bMin[2] = boxes[i].pMin.z;
+		ref.bMax[0] = boxes[i].pMax.x;
+		ref.bMax[1] = boxes[i].pMax.y;
+		ref.bMax[2] = boxes[i].pMax.z;
+
+		for (int k = 0; k < 3; k++)
+			ref.c[k] = ref.bMin[k] + ref.bMax[k];
+
+		ref.index = i;
+	}
+
+	// a binary tree of num leaves has at most 2*num - 1 nodes
+	bvh.nodes.resize(2 * num - 1);
+	ctx.nodes = bvh.nodes.data();
+
+	const int threads = (numThreads > 0) ? numThreads : std::max(1, (int)std::thread::hardware_concurrency());
+
+	ctx.numNodes = 1;
+	Build_Node(ctx, 0, 0, num, 0, threads);
+
+	bvh.nodes.resize(ctx.numNodes);
+
+	// the threads take the slots of the nodes in the order of their scheduling, so the
+	// nodes are renumbered to get the same layout (and traversal locality) in any run
+	if (threads > 1)
+	{
+		std::vector<BVH_NODE> nodes(bvh.nodes.size());
+		int numNodes = 1;
+
+		Renumber_Node(bvh.nodes.data(), 0, nodes.data(), 0, numNodes);
+		assert(numNodes == (int)nodes.size());
+
+		bvh.nodes.swap(nodes);
+	}
+
+	// the primitives in the order of the leaves (the leaves read their boxes in a row)
+	bvh.primIndices.resize(num);
+	bvh.primBoxes.resize(num);
+
+	for (int i = 0; i < num; i++)
+	{
+		bvh.primIndices[i] = ctx.refs[i].index;
+		bvh.primBoxes[i] = boxes[ctx.refs[i].index];
+	}
+
+	return 1;
+
+} // end BVH_Build
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                    TRAVERSAL
+////////////////////////////////////////////////////////////////////////////////////////////
+
+static inline int Intersect_Slabs(const float minX, const float minY, const float minZ,
+	const float maxX, const float maxY, const float maxZ,
+	const POINT3D & p0,
+	const float invD[3],
+	const float tMax,
+	float & tNear)
+{
+	// this function intersects the line with the box by the slabs method: the line is in
+	// the box between the greatest entry and the least exit of the three slabs;
+	// the operations are the same as in the packet kernels (see Intersect_Node_SSE/_AVX2)
+
+	const float t0x = (minX - p0.x) * invD[0];
+	const float t1x = (maxX - p0.x) * invD[0];
+	const float t0y = (minY - p0.y) * invD[1];
+	const float t1y = (maxY - p0.y) * invD[1];
+	const float t0z = (minZ - p0.z) * invD[2];
+	const float t1z = (maxZ - p0.z) * invD[2];
+
+	const float tEntry = Max_Float(Min_Float(t0x, t1x), Max_Float(Min_Float(t0y, t1y), Max_Float(Min_Float(t0z, t1z), 0.0f)));
+	const float tExit  = Min_Float(Max_Float(t0x, t1x), Min_Float(Max_Float(t0y, t1y), Min_Float(Max_Float(t0z, t1z), tMax)));
+
+	tNear = tEntry;
+
+	return tEntry <= tExit;
+
+} // end Intersect_Slabs
+
+///////////////////////////////////////////////////////////
+
+static inline int Intersect_Node(const BVH_NODE & node, const POINT3D & p0, const float invD[3], const float tMax, float & tNear)
+{
+	return Intersect_Slabs(node.minX, node.minY, node.minZ, node.maxX, node.maxY, node.maxZ, p0, invD, tMax, tNear);
+}
+
+///////////////////////////////////////////////////////////
+
+static int Intersect_Leaf(const BVH & bvh,
+	const BVH_NODE & leaf,
+	const PARAMLINE3D & line,
+	const float invD[3],
+	const int anyHit,
+	const BVH_PRIMITIVE_TEST test,
+	const void* userData,
+	float & tBest,
+	int & bestPrim)
+{
+	// this function tests the primitives of the leaf and updates the closest hit;
+	// returns 1 if the closest hit was updated (for any-hit: if there is a hit)
+
+	int found = 0;
+
+	for (int i = leaf.leftOrFirst; i < leaf.leftOrFirst + leaf.count; i++)
+	{
+		const int prim = bvh.primIndices[i];
+		float t = 0.0f;
+		int hit = 0;
+
+		if (test)
+		{
+			hit = test(line, prim, tBest, t, userData);
+		}
+		else
+		{
+			const AABB3D & box = bvh.primBoxes[i];
+			hit = Intersect_Slabs(box.pMin.x, box.pMin.y, box.pMin.z, box.pMax.x, box.pMax.y, box.pMax.z, line.p0, invD, tBest, t);
+		}
+
+		// t <= tBest here; of equal hits the least index is taken
+		if (hit && ((t < tBest) || (bestPrim < 0) || (prim < bestPrim)))
+		{
+			tBest = t;
+			bestPrim = prim;
+			found = 1;
+
+			if (anyHit)
+				return 1;
+		}
+	}
+
+	return found;
+
+} // end Intersect_Leaf
+
+///////////////////////////////////////////////////////////
+
+static int Traverse_Single(const BVH & bvh,
+	const PARAMLINE3D & line,
+	const float invD[3],
+	const int anyHit,
+	const BVH_PRIMITIVE_TEST test,
+	const void* userData,
+	float & tBest,
+	int & bestPrim)
+{
+	// this function traverses the tree by one line: both children of a node are tested
+	// and the nearest one is visited first; a node is skipped if a closer hit was found
+	// after it was put into the stack
+
+	if (bvh.nodes.empty())
+		return 0;
+
+	int   stackNode[BVH_STACK_SIZE];
+	float stackNear[BVH_STACK_SIZE];
+	int   sp = 0;
+	float tRoot = 0.0f;
+
+	if (!Intersect_Node(bvh.nodes[0], line.p0, invD, tBest, tRoot))
+		return 0;
+
+	stackNode[sp] = 0;
+	stackNear[sp++] = tRoot;
+
+	while (sp > 0)
+	{
+		sp--;
+
+		if (stackNear[sp] > tBest)
+			continue;
+
+		const BVH_NODE & node = bvh.nodes[stackNode[sp]];
+
+		if (node.count > 0)
+		{
+			if (Intersect_Leaf(bvh, node, line, invD, anyHit, test, userData, tBest, bestPrim) && anyHit)
+				return 1;
+
+			continue;
+		}
+
+		const int left = node.leftOrFirst;
+		float tLeft = 0.0f;
+		float tRight = 0.0f;
+
+		const int hitLeft = Intersect_Node(bvh.nodes[left], line.p0, invD, tBest, tLeft);
+		const int hitRight = Intersect_Node(bvh.nodes[left + 1], line.p0, invD, tBest, tRight);
+
+		assert(sp + 2 <= BVH_STACK_SIZE);
+
+		// the far child is put first so the near one is visited first
+		if (hitLeft && hitRight)
+		{
+			const int nearFirst = (tLeft <= tRight);
+
+			stackNode[sp] = nearFirst ? left + 1 : left;
+			stackNear[sp++] = nearFirst ? tRight : tLeft;
+			stackNode[sp] = nearFirst ? left : left + 1;
+			stackNear[sp++] = nearFirst ? tLeft : tRight;
+		}
+		else if (hitLeft)
+		{
+			stackNode[sp] = left;
+			stackNear[sp++] = tLeft;
+		}
+		else if (hitRight)
+		{
+			stackNode[sp] = left + 1;
+			stackNear[sp++] = tRight;
+		}
+	}
+
+	return bestPrim >= 0;
+
+} // end Traverse_Single
+
+///////////////////////////////////////////////////////////
+
+static inline void Init_Inv_Dir(const VECTOR3D & v, float invD[3])
+{
+	// a zero component gives an infinite inverse, so the slab of this axis is
+	// either the whole line or nothing
+	invD[0] = 1.0f / v.x;
+	invD[1] = 1.0f / v.y;
+	invD[2] = 1.0f / v.z;
+}
+
+///////////////////////////////////////////////////////////
+
+static inline void Load_Line(const PARAMLINE3D_SOA & lines, const int i, PARAMLINE3D & line)
+{
+	POINT3D_INIT_XYZ(line.p0, lines.p0x[i], lines.p0y[i], lines.p0z[i]);
+	VECTOR3D_INIT_XYZ(line.v, lines.vx[i], lines.vy[i], lines.vz[i]);
+	POINT3D_INIT_XYZ(line.p1, line.p0.x + line.v.x, line.p0.y + line.v.y, line.p0.z + line.v.z);
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                 SINGLE QUERIES
+////////////////////////////////////////////////////////////////////////////////////////////
+
+int BVH_Intersect_Closest(const BVH & bvh,
+	const PARAMLINE3D & line,
+	const float tMax,
+	BVH_HIT & hit,
+	const BVH_PRIMITIVE_TEST test,
+	const void* userData)
+{
+	float invD[3];
+	Init_Inv_Dir(line.v, invD);
+
+	hit.t = tMax;
+	hit.primIndex = -1;
+
+	return Traverse_Single(bvh, line, invD, 0, test, userData, hit.t, hit.primIndex);
+
+} // end BVH_Intersect_Closest
+
+///////////////////////////////////////////////////////////
+
+int BVH_Intersect_Any(const BVH & bvh,
+	const PARAMLINE3D & line,
+	const float tMax,
+	const BVH_PRIMITIVE_TEST test,
+	const void* userData)
+{
+	float invD[3];
+	Init_Inv_Dir(line.v, invD);
+
+	float tBest = tMax;
+	int bestPrim = -1;
+
+	return Traverse_Single(bvh, line, invD, 1, test, userData, tBest, bestPrim);
+
+} // end BVH_Intersect_Any
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                  SCALAR KERNELS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void BVH_Intersect_Closest_Batch_Scalar(const BVH & bvh, const PARAMLINE3D_SOA & lines, const int num, const float tMax,
+	int* primIndex, float* t, const BVH_PRIMITIVE_TEST test, const void* userData)
+{
+	assert(primIndex && t);
+
+	PARAMLINE3D line;
+	BVH_HIT hit;
+
+	for (int i = 0; i < num; i++)
+	{
+		Load_Line(lines, i, line);
+		BVH_Intersect_Closest(bvh, line, tMax, hit, test, userData);
+
+		primIndex[i] = hit.primIndex;
+		t[i] = hit.t;
+	}
+
+} // end BVH_Intersect_Closest_Batch_Scalar
+
+///////////////////////////////////////////////////////////
+
+void BVH_Intersect_Any_Batch_Scalar(const BVH & bvh, const PARAMLINE3D_SOA & lines, const int num, const float tMax,
+	unsigned char* hits, const BVH_PRIMITIVE_TEST test, const void* userData)
+{
+	assert(hits != nullptr);
+
+	PARAMLINE3D line;
+
+	for (int i = 0; i < num; i++)
+	{
+		Load_Line(lines, i, line);
+		hits[i] = (unsigned char)BVH_Intersect_Any(bvh, line, tMax, test, userData);
+	}
+
+} // end BVH_Intersect_Any_Batch_Scalar
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                   SIMD KERNELS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+#if MATHLIB_SIMD_X86
+
+//
+// a packet of lines traverses the tree together (if the directions of the lines have the
+// same signs, else each line traverses it alone): a node is popped from the stack, tested
+// against all the lines of the packet (only the lines which can still get a closer hit),
+// and if some of them hit it, a leaf is tested by each of these lines and the children of
+// an interior node are put into the stack (the near one for the first of these lines is
+// visited first); the leaves are tested by the scalar code, so the hits are the same as
+// of the single queries
+//
+
+MATHLIB_TARGET_SSE41
+static inline int Intersect_Node_SSE(const BVH_NODE & node,
+	const __m128 ox, const __m128 oy, const __m128 oz,
+	const __m128 idx, const __m128 idy, const __m128 idz,
+	const __m128 tMax)
+{
+	// returns the mask of the lines which hit the node (the same operations as Intersect_Slabs)
+
+	const __m128 t0x = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.minX), ox), idx);
+	const __m128 t1x = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.maxX), ox), idx);
+	const __m128 t0y = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.minY), oy), idy);
+	const __m128 t1y = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.maxY), oy), idy);
+	const __m128 t0z = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.minZ), oz), idz);
+	const __m128 t1z = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.maxZ), oz), idz);
+
+	const __m128 tEntry = _mm_max_ps(_mm_min_ps(t0x, t1x), _mm_max_ps(_mm_min_ps(t0y, t1y), _mm_max_ps(_mm_min_ps(t0z, t1z), _mm_setzero_ps())));
+	const __m128 tExit  = _mm_min_ps(_mm_max_ps(t0x, t1x), _mm_min_ps(_mm_max_ps(t0y, t1y), _mm_min_ps(_mm_max_ps(t0z, t1z), tMax)));
+
+	return _mm_movemask_ps(_mm_cmple_ps(tEntry, tExit));
+}
+
+MATHLIB_TARGET_AVX2
+static inline int Intersect_Node_AVX2(const BVH_NODE & node,
+	const __m256 ox, const __m256 oy, const __m256 oz,
+	const __m256 idx, const __m256 idy, const __m256 idz,
+	const __m256 tMax)
+{
+	const __m256 t0x = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(node.minX), ox), idx);
+	const __m256 t1x = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(node.maxX), ox), idx);
+	const __m256 t0y = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(node.minY), oy), idy);
+	const __m256 t1y = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(node.maxY), oy), idy);
+	const __m256 t0z = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(node.minZ), oz), idz);
+	const __m256 t1z = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(node.maxZ), oz), idz);
+
+	const __m256 tEntry = _mm256_max_ps(_mm256_min_ps(t0x, t1x), _mm256_max_ps(_mm256_min_ps(t0y, t1y), _mm256_max_ps(_mm256_min_ps(t0z, t1z), _mm256_setzero_ps())));
+	const __m256 tExit  = _mm256_min_ps(_mm256_max_ps(t0x, t1x), _mm256_min_ps(_mm256_max_ps(t0y, t1y), _mm256_min_ps(_mm256_max_ps(t0z, t1z), tMax)));
+
+	return _mm256_movemask_ps(_mm256_cmp_ps(tEntry, tExit, _CMP_LE_OQ));
+}
+
+///////////////////////////////////////////////////////////
+
+static inline int Is_Coherent(const int signsX, const int signsY, const int signsZ, const int allLanes)
+{
+	// the lines of a packet are coherent if the signs of their directions are the same
+	// (signsX/Y/Z are the masks of the sign bits of the inverse directions)
+	return ((signsX == 0) || (signsX == allLanes)) &&
+	       ((signsY == 0) || (signsY == allLanes)) &&
+	       ((signsZ == 0) || (signsZ == allLanes));
+}
+
+///////////////////////////////////////////////////////////
+
+static inline void Push_Children(const BVH & bvh, const BVH_NODE & node, const VECTOR3D & v, int* stack, int & sp)
+{
+	// puts the children of the node into the stack: the one which is nearer
+	// along the direction v is put last (so it is visited first)
+
+	const int left = node.leftOrFirst;
+	const BVH_NODE & l = bvh.nodes[left];
+	const BVH_NODE & r = bvh.nodes[left + 1];
+
+	const float dot =
+		(((r.minX + r.maxX) - (l.minX + l.maxX)) * v.x) +
+		(((r.minY + r.maxY) - (l.minY + l.maxY)) * v.y) +
+		(((r.minZ + r.maxZ) - (l.minZ + l.maxZ)) * v.z);
+
+	assert(sp + 2 <= BVH_STACK_SIZE);
+
+	if (dot >= 0.0f)
+	{
+		stack[sp++] = left + 1;
+		stack[sp++] = left;
+	}
+	else
+	{
+		stack[sp++] = left;
+		stack[sp++] = left + 1;
+	}
+}
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_SSE41
+static void Traverse_Packet_SSE(const BVH & bvh,
+	const PARAMLINE3D_SOA & lines,
+	const int first,
+	const int anyHit,
+	const BVH_PRIMITIVE_TEST test,
+	const void* userData,
+	float* tBest,
+	int* bestPrim)
+{
+	// traverses the tree by the lines [first, first+4); tBest must be initialized with
+	// tMax and bestPrim with -1; for any-hit a line stops as soon as it gets a hit
+
+	PARAMLINE3D line[4];
+	float invD[4][3];
+
+	for (int k = 0; k < 4; k++)
+	{
+		Load_Line(lines, first + k, line[k]);
+		Init_Inv_Dir(line[k].v, invD[k]);
+	}
+
+	const __m128 ox = _mm_loadu_ps(lines.p0x + first);
+	const __m128 oy = _mm_loadu_ps(lines.p0y + first);
+	const __m128 oz = _mm_loadu_ps(lines.p0z + first);
+
+	const __m128 idx = _mm_setr_ps(invD[0][0], invD[1][0], invD[2][0], invD[3][0]);
+	const __m128 idy = _mm_setr_ps(invD[0][1], invD[1][1], invD[2][1], invD[3][1]);
+	const __m128 idz = _mm_setr_ps(invD[0][2], invD[1][2], invD[2][2], invD[3][2]);
+
+	// the lines go in different directions, so they would visit the union of their
+	// nodes together: it is cheaper to traverse the tree by each line alone
+	if (!Is_Coherent(_mm_movemask_ps(idx), _mm_movemask_ps(idy), _mm_movemask_ps(idz), 0xF))
+	{
+		for (int k = 0; k < 4; k++)
+			Traverse_Single(bvh, line[k], invD[k], anyHit, test, userData, tBest[k], bestPrim[k]);
+
+		return;
+	}
+
+	int active = 0xF;
+	int stack[BVH_STACK_SIZE];
+	int sp = 0;
+
+	stack[sp++] = 0;
+
+	while (sp > 0)
+	{
+		const BVH_NODE & node = bvh.nodes[stack[--sp]];
+		const int mask = Intersect_Node_SSE(node, ox, oy, oz, idx, idy, idz, _mm_loadu_ps(tBest)) & active;
+
+		if (mask == 0)
+			continue;
+
+		if (node.count == 0)
+		{
+			int k = 0;
+			while (!(mask & (1 << k)))
+				k++;
+
+			Push_Children(bvh, node, line[k].v, stack, sp);
+			continue;
+		}
+
+		for (int k = 0; k < 4; k++)
+		{
+			if ((mask & (1 << k)) &&
+				Intersect_Leaf(bvh, node, line[k], invD[k], anyHit, test, userData, tBest[k], bestPrim[k]) &&
+				anyHit)
+			{
+				active &= ~(1 << k);
+			}
+		}
+
+		if (active == 0)
+			break;
+	}
+
+} // end Traverse_Packet_SSE
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_AVX2
+static void Traverse_Packet_AVX2(const BVH & bvh,
+	const PARAMLINE3D_SOA & lines,
+	const int first,
+	const int anyHit,
+	const BVH_PRIMITIVE_TEST test,
+	const void* userData,
+	float* tBest,
+	int* bestPrim)
+{
+	// the same as Traverse_Packet_SSE for the lines [first, first+8)
+
+	PARAMLINE3D line[8];
+	alignas(32) float invD[3][8];
+
+	for (int k = 0; k < 8; k++)
+	{
+		float inv[3];
+
+		Load_Line(lines, first + k, line[k]);
+		Init_Inv_Dir(line[k].v, inv);
+
+		invD[0][k] = inv[0];
+		invD[1][k] = inv[1];
+		invD[2][k] = inv[2];
+	}
+
+	const __m256 ox = _mm256_loadu_ps(lines.p0x + first);
+	const __m256 oy = _mm256_loadu_ps(lines.p0y + first);
+	const __m256 oz = _mm256_loadu_ps(lines.p0z + first);
+
+	const __m256 idx = _mm256_load_ps(invD[0]);
+	const __m256 idy = _mm256_load_ps(invD[1]);
+	const __m256 idz = _mm256_load_ps(invD[2]);
+
+	if (!Is_Coherent(_mm256_movemask_ps(idx), _mm256_movemask_ps(idy), _mm256_movemask_ps(idz), 0xFF))
+	{
+		for (int k = 0; k < 8; k++)
+		{
+			const float inv[3] = { invD[0][k], invD[1][k], invD[2][k] };
+			Traverse_Single(bvh, line[k], inv, anyHit, test, userData, tBest[k], bestPrim[k]);
+		}
+
+		return;
+	}
+
+	int active = 0xFF;
+	int stack[BVH_STACK_SIZE];
+	int sp = 0;
+
+	stack[sp++] = 0;
+
+	while (sp > 0)
+	{
+		const BVH_NODE & node = bvh.nodes[stack[--sp]];
+		const int mask = Intersect_Node_AVX2(node, ox, oy, oz, idx, idy, idz, _mm256_loadu_ps(tBest)) & active;
+
+		if (mask == 0)
+			continue;
+
+		if (node.count == 0)
+		{
+			int k = 0;
+			while (!(mask & (1 << k)))
+				k++;
+
+			Push_Children(bvh, node, line[k].v, stack, sp);
+			continue;
+		}
+
+		for (int k = 0; k < 8; k++)
+		{
+			const float inv[3] = { invD[0][k], invD[1][k], invD[2][k] };
+
+			if ((mask & (1 << k)) &&
+				Intersect_Leaf(bvh, node, line[k], inv, anyHit, test, userData, tBest[k], bestPrim[k]) &&
+				anyHit)
+			{
+				active &= ~(1 << k);
+			}
+		}
+
+		if (active == 0)
+			break;
+	}
+
+} // end Traverse_Packet_AVX2
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_SSE41
+void BVH_Intersect_Closest_Batch_SSE(const BVH & bvh, const PARAMLINE3D_SOA & lines, const int num, const float tMax,
+	int* primIndex, float* t, const BVH_PRIMITIVE_TEST test, const void* userData)
+{
+	// processes the lines by packets of 4; the tail (num % 4 lines) is processed by the scalar kernel
+
+	assert(primIndex && t);
+
+	int i = 0;
+
+	if (!bvh.nodes.empty())
+	{
+		for (; i + 4 <= num; i += 4)
+		{
+			for (int k = 0; k < 4; k++)
+			{
+				t[i + k] = tMax;
+				primIndex[i + k] = -1;
+			}
+
+			Traverse_Packet_SSE(bvh, lines, i, 0, test, userData, t + i, primIndex + i);
+		}
+	}
+
+	PARAMLINE3D_SOA rest = lines;
+
+	rest.p0x += i; rest.p0y += i; rest.p0z += i;
+	rest.vx += i;  rest.vy += i;  rest.vz += i;
+
+	BVH_Intersect_Closest_Batch_Scalar(bvh, rest, num - i, tMax, primIndex + i, t + i, test, userData);
+
+} // end BVH_Intersect_Closest_Batch_SSE
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_AVX2
+void BVH_Intersect_Closest_Batch_AVX2(const BVH & bvh, const PARAMLINE3D_SOA & lines, const int num, const float tMax,
+	int* primIndex, float* t, const BVH_PRIMITIVE_TEST test, const void* userData)
+{
+	// processes the lines by packets of 8; the tail (num % 8 lines) is processed by the SSE kernel
+
+	assert(primIndex && t);
+
+	int i = 0;
+
+	if (!bvh.nodes.empty())
+	{
+		for (; i + 8 <= num; i += 8)
+		{
+			for (int k = 0; k < 8; k++)
+			{
+				t[i + k] = tMax;
+				primIndex[i + k] = -1;
+			}
+
+			Traverse_Packet_AVX2(bvh, lines, i, 0, test, userData, t + i, primIndex + i);
+		}
+	}
+
+	PARAMLINE3D_SOA rest = lines;
+
+	rest.p0x += i; rest.p0y += i; rest.p0z += i;
+	rest.vx += i;  rest.vy += i;  rest.vz += i;
+
+	BVH_Intersect_Closest_Batch_SSE(bvh, rest, num - i, tMax, primIndex + i, t + i, test, userData);
+
+} // end BVH_Intersect_Closest_Batch_AVX2
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_SSE41
+void BVH_Intersect_Any_Batch_SSE(const BVH & bvh, const PARAMLINE3D_SOA & lines, const int num, const float tMax,
+	unsigned char* hits, const BVH_PRIMITIVE_TEST test, const void* userData)
+{
+	// processes the lines by packets of 4; the tail (num % 4 lines) is processed by the scalar kernel
+
+	assert(hits != nullptr);
+
+	int i = 0;
+
+	if (!bvh.nodes.empty())
+	{
+		for (; i + 4 <= num; i += 4)
+		{
+			float tBest[4] = { tMax, tMax, tMax, tMax };
+			int bestPrim[4] = { -1, -1, -1, -1 };
+
+			Traverse_Packet_SSE(bvh, lines, i, 1, test, userData, tBest, bestPrim);
+
+			for (int k = 0; k < 4; k++)
+				hits[i + k] = (unsigned char)(bestPrim[k] >= 0);
+		}
+	}
+
+	PARAMLINE3D_SOA rest = lines;
+
+	rest.p0x += i; rest.p0y += i; rest.p0z += i;
+	rest.vx += i;  rest.vy += i;  rest.vz += i;
+
+	BVH_Intersect_Any_Batch_Scalar(bvh, rest, num - i, tMax, hits + i, test, userData);
+
+} // end BVH_Intersect_Any_Batch_SSE
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_AVX2
+void BVH_Intersect_Any_Batch_AVX2(const BVH & bvh, const PARAMLINE3D_SOA & lines, const int num, const float tMax,
+	unsigned char* hits, const BVH_PRIMITIVE_TEST test, const void* userData)
+{
+	// processes the lines by packets of 8; the tail (num % 8 lines) is processed by the SSE kernel
+
+	assert(hits != nullptr);
+
+	int i = 0;
+
+	if (!bvh.nodes.empty())
+	{
+		for (; i + 8 <= num; i += 8)
+		{
+			float tBest[8] = { tMax, tMax, tMax, tMax, tMax, tMax, tMax, tMax };
+			int bestPrim[8] = { -1, -1, -1, -1, -1, -1, -1, -1 };
+
+			Traverse_Packet_AVX2(bvh, lines, i, 1, test, userData, tBest, bestPrim);
+
+			for (int k = 0; k < 8; k++)
+				hits[i + k] = (unsigned char)(bestPrim[k] >= 0);
+		}
+	}
+
+	PARAMLINE3D_SOA rest = lines;
+
+	rest.p0x += i; rest.p0y += i; rest.p0z += i;
+	rest.vx += i;  rest.vy += i;  rest.vz += i;
+
+	BVH_Intersect_Any_Batch_SSE(bvh, rest, num - i, tMax, hits + i, test, userData);
+
+} // end BVH_Intersect_Any_Batch_AVX2
+
+#else
+
+// there is no SIMD support for this platform so use the reference kernels
+
+void BVH_Intersect_Closest_Batch_SSE(const BVH & bvh, const PARAMLINE3D_SOA & lines, const int num, const float tMax,
+	int* primIndex, float* t, const BVH_PRIMITIVE_TEST test, const void* userData)
+{
+	BVH_Intersect_Closest_Batch_Scalar(bvh, lines, num, tMax, primIndex, t, test, userData);
+}
+
+void BVH_Intersect_Closest_Batch_AVX2(const BVH & bvh, const PARAMLINE3D_SOA & lines, const int num, const float tMax,
+	int* primIndex, float* t, const BVH_PRIMITIVE_TEST test, const void* userData)
+{
+	BVH_Intersect_Closest_Batch_Scalar(bvh, lines, num, tMax, primIndex, t, test, userData);
+}
+
+void BVH_Intersect_Any_Batch_SSE(const BVH & bvh, const PARAMLINE3D_SOA & lines, const int num, const float tMax,
+	unsigned char* hits, const BVH_PRIMITIVE_TEST test, const void* userData)
+{
+	BVH_Intersect_Any_Batch_Scalar(bvh, lines, num, tMax, hits, test, userData);
+}
+
+void BVH_Intersect_Any_Batch_AVX2(const BVH & bvh, const PARAMLINE3D_SOA & lines, const int num, const float tMax,
+	unsigned char* hits, const BVH_PRIMITIVE_TEST test, const void* userData)
+{
+	BVH_Intersect_Any_Batch_Scalar(bvh, lines, num, tMax, hits, test, userData);
+}
+
+#endif // MATHLIB_SIMD_X86
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                    DISPATCHING
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void BVH_Intersect_Closest_Batch(const BVH & bvh,
+	const PARAMLINE3D_SOA & lines,
+	const int num,
+	const float tMax,
+	int* primIndex,
+	float* t,
+	const BVH_PRIMITIVE_TEST test,
+	const void* userData)
+{
+	// finds the closest hits using the best kernel for the current CPU
+
+	switch (SIMD_Get_Level())
+	{
+		case SIMD_LEVEL_AVX2:
+			BVH_Intersect_Closest_Batch_AVX2(bvh, lines, num, tMax, primIndex, t, test, userData);
+			break;
+
+		case SIMD_LEVEL_AVX:
+		case SIMD_LEVEL_SSE:
+			BVH_Intersect_Closest_Batch_SSE(bvh, lines, num, tMax, primIndex, t, test, userData);
+			break;
+
+		default:
+			BVH_Intersect_Closest_Batch_Scalar(bvh, lines, num, tMax, primIndex, t, test, userData);
+	}
+
+} // end BVH_Intersect_Closest_Batch
+
+///////////////////////////////////////////////////////////
+
+void BVH_Intersect_Any_Batch(const BVH & bvh,
+	const PARAMLINE3D_SOA & lines,
+	const int num,
+	const float tMax,
+	unsigned char* hits,
+	const BVH_PRIMITIVE_TEST test,
+	const void* userData)
+{
+	// finds any hits using the best kernel for the current CPU
+
+	switch (SIMD_Get_Level())
+	{
+		case SIMD_LEVEL_AVX2:
+			BVH_Intersect_Any_Batch_AVX2(bvh, lines, num, tMax, hits, test, userData);
+			break;
+
+		case SIMD_LEVEL_AVX:
+		case SIMD_LEVEL_SSE:
+			BVH_Intersect_Any_Batch_SSE(bvh, lines, num, tMax, hits, test, userData);
+			break;
+
+		default:
+			BVH_Intersect_Any_Batch_Scalar(bvh, lines, num, tMax, hits, test, userData);
+	}
+
+} // end BVH_Intersect_Any_Batch
+
+} // end namespace MathLib
@@ -0,0 +1,166 @@
+////////////////////////////////////////////////////////////////////////////////////////////
+// Filename:      BVH.h
+// Description:   contains functional for a bounding volume hierarchy (BVH) over
+//                axis-aligned boxes: a binned SAH build (multithreaded) into a flat
+//                array of nodes, and closest-hit / any-hit queries of parametric lines
+//                (single and batch versions with 4/8-wide packet traversal)
+//
+// Created:       17.10.26
+////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <vector>
+
+#include "BoundingVolumes.h"
+#include "FiguresBatch.h"
+
+
+namespace MathLib
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                   CONSTANTS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+constexpr int BVH_NUM_BINS      = 16;   // number of bins along an axis for the SAH
+constexpr int BVH_MAX_LEAF_SIZE = 8;    // a node with more primitives is always split (if it is possible)
+constexpr int BVH_MAX_DEPTH     = 60;   // a node at this depth is a leaf (limits the traversal stack)
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                 DATA STRUCTURES
+////////////////////////////////////////////////////////////////////////////////////////////
+
+// a node of BVH (32 bytes); for an interior node count == 0 and leftOrFirst is the index
+// of the left child (the right child is next to it), for a leaf leftOrFirst is the index
+// of the first primitive in BVH::primIndices and count is the number of the primitives
+typedef struct alignas(32) BVH_NODE_TYPE
+{
+	float minX;
+	float minY;
+	float minZ;
+	int   leftOrFirst;
+	float maxX;
+	float maxY;
+	float maxZ;
+	int   count;
+} BVH_NODE, *BVH_NODE_PTR;
+
+
+// bounding volume hierarchy; nodes[0] is the root (the tree is empty if there are no nodes)
+typedef struct BVH_TYPE
+{
+	std::vector<BVH_NODE> nodes;
+	std::vector<int>      primIndices;   // indices of the primitives in the order of the leaves
+	std::vector<AABB3D>   primBoxes;     // boxes of the primitives in the same order
+} BVH, *BVH_PTR;
+
+
+// a result of a closest-hit query
+typedef struct BVH_HIT_TYPE
+{
+	int   primIndex = -1;   // index of the primitive or -1 if there is no hit
+	float t = 0.0f;         // parameter of the hit point on the line (tMax if there is no hit)
+} BVH_HIT, *BVH_HIT_PTR;
+
+
+// a test of a primitive (e.g. a triangle): returns 1 and the parameter t of the hit
+// if the line hits the primitive primIndex with 0 <= t <= tMax, or 0 if not;
+// userData is passed from the query as it is
+typedef int (*BVH_PRIMITIVE_TEST)(const PARAMLINE3D & line,
+	const int primIndex,
+	const float tMax,
+	float & t,
+	const void* userData);
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                            FUNCTIONS PROTOTYPES
+////////////////////////////////////////////////////////////////////////////////////////////
+
+// builds BVH of num primitives by their boxes; numThreads is the maximal number of threads
+// for the build (0 == the number of the CPU cores); the tree (its nodes in the same order)
+// is the same for any numThreads and any run;
+// returns 1 if the tree is built, or 0 if there are no primitives (the tree is empty)
+int BVH_Build(BVH & bvh, const AABB3D* boxes, const int num, const int numThreads);
+
+///////////////////////////////////////////////////////////////
+
+//
+// queries: the line is p0 + t*v with 0 <= t <= tMax (tMax == 1 is the segment p0->p1,
+// a large tMax (e.g. FLT_MAX) is a ray); if test is nullptr the primitives are their boxes
+// (t of the hit is the entry point into the box, 0 if p0 is inside it);
+//
+// the closest hit is the hit with the least t (of the least primIndex if there are
+// several of them), so the result doesn't depend on the order of the traversal
+//
+
+// returns 1 if the line hits some primitive (hit is the closest one), or 0 if not
+int BVH_Intersect_Closest(const BVH & bvh,
+	const PARAMLINE3D & line,
+	const float tMax,
+	BVH_HIT & hit,
+	const BVH_PRIMITIVE_TEST test,
+	const void* userData);
+
+// returns 1 if the line hits any primitive (stops at the first found hit), or 0 if not
+int BVH_Intersect_Any(const BVH & bvh,
+	const PARAMLINE3D & line,
+	const float tMax,
+	const BVH_PRIMITIVE_TEST test,
+	const void* userData);
+
+///////////////////////////////////////////////////////////////
+
+//
+// batch queries of num lines in SoA form: the results of the line i are the same as of
+// the single queries: primIndex[i]/t[i] as BVH_HIT, hits[i] is 1/0;
+//
+// the SIMD kernels traverse the tree by packets of 4 (SSE) or 8 (AVX2) lines: a node is
+// tested against all the lines of the packet at once and it is visited if any of them
+// hits it; so the lines of a packet should be coherent (e.g. neighbouring camera rays);
+// the lines of a packet which directions have different signs are traversed one by one
+//
+
+// chooses the best kernel for the current CPU (see SIMD_Get_Level)
+void BVH_Intersect_Closest_Batch(const BVH & bvh,
+	const PARAMLINE3D_SOA & lines,
+	const int num,
+	const float tMax,
+	int* primIndex,
+	float* t,
+	const BVH_PRIMITIVE_TEST test,
+	const void* userData);
+
+void BVH_Intersect_Any_Batch(const BVH & bvh,
+	const PARAMLINE3D_SOA & lines,
+	const int num,
+	const float tMax,
+	unsigned char* hits,
+	const BVH_PRIMITIVE_TEST test,
+	const void* userData);
+
+// separate kernels (SSE/AVX2 kernels must be called only if the CPU supports them)
+void BVH_Intersect_Closest_Batch_Scalar(const BVH & bvh, const PARAMLINE3D_SOA & lines, const int num, const float tMax,
+	int* primIndex, float* t, const BVH_PRIMITIVE_TEST test, const void* userData);
+
+void BVH_Intersect_Closest_Batch_SSE(const BVH & bvh, const PARAMLINE3D_SOA & lines, const int num, const float tMax,
+	int* primIndex, float* t, const BVH_PRIMITIVE_TEST test, const void* userData);
+
+void BVH_Intersect_Closest_Batch_AVX2(const BVH & bvh, const PARAMLINE3D_SOA & lines, const int num, const float tMax,
+	int* primIndex, float* t, const BVH_PRIMITIVE_TEST test, const void* userData);
+
+void BVH_Intersect_Any_Batch_Scalar(const BVH & bvh, const PARAMLINE3D_SOA & lines, const int num, const float tMax,
+	unsigned char* hits, const BVH_PRIMITIVE_TEST test, const void* userData);
+
+void BVH_Intersect_Any_Batch_SSE(const BVH & bvh, const PARAMLINE3D_SOA & lines, const int num, const float tMax,
+	unsigned char* hits, const BVH_PRIMITIVE_TEST test, const void* userData);
+
+void BVH_Intersect_Any_Batch_AVX2(const BVH & bvh, const PARAMLINE3D_SOA & lines, const int num, const float tMax,
+	unsigned char* hits, const BVH_PRIMITIVE_TEST test, const void* userData);
+
+} // end namespace MathLib
@@ -0,0 +1,1622 @@
+////////////////////////////////////////////////////////////////////////////////////////////
+// Filename:      BoundingVolumes.cpp
+// Description:   contains implementation of functional for bounding volumes
+//                (scalar, SSE and AVX2 kernels + runtime dispatching)
+//
+// Created:       17.10.26
+////////////////////////////////////////////////////////////////////////////////////////////
+#include "BoundingVolumes.h"
+#include "../Utils/Simd.h"
+
+#include <cassert>
+#include <cfloat>
+#include <cstring>
+
+
+namespace MathLib
+{
+
+//
+// NOTE: min/max are computed as (a < b) ? a : b and (a > b) ? a : b, exactly as
+//       _mm_min_ps/_mm_max_ps do, so the SIMD kernels give the same results as the scalar code
+//
+
+static inline float Min_Float(const float a, const float b) { return (a < b) ? a : b; }
+static inline float Max_Float(const float a, const float b) { return (a > b) ? a : b; }
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                          FUNCTIONS FOR SINGLE VOLUMES
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void AABB3D_Init_Empty(AABB3D & box)
+{
+	POINT3D_INIT_XYZ(box.pMin, FLT_MAX, FLT_MAX, FLT_MAX);
+	POINT3D_INIT_XYZ(box.pMax, -FLT_MAX, -FLT_MAX, -FLT_MAX);
+
+} // end AABB3D_Init_Empty
+
+///////////////////////////////////////////////////////////
+
+void AABB3D_From_POINT3D_Array(AABB3D & box, const POINT3D* points, const int num)
+{
+	// this function computes the box of the array of points
+
+	assert(points != nullptr);
+	assert(num >= 0);
+
+	AABB3D_Init_Empty(box);
+
+	for (int i = 0; i < num; i++)
+	{
+		box.pMin.x = Min_Float(points[i].x, box.pMin.x);
+		box.pMin.y = Min_Float(points[i].y, box.pMin.y);
+		box.pMin.z = Min_Float(points[i].z, box.pMin.z);
+
+		box.pMax.x = Max_Float(points[i].x, box.pMax.x);
+		box.pMax.y = Max_Float(points[i].y, box.pMax.y);
+		box.pMax.z = Max_Float(points[i].z, box.pMax.z);
+	}
+
+} // end AABB3D_From_POINT3D_Array
+
+///////////////////////////////////////////////////////////
+
+void SPHERE3D_From_Points(SPHERE3D & sphere, const float* x, const float* y, const float* z, const int num)
+{
+	// this function computes the bounding sphere in two passes: the box of the points
+	// gives the center, and the farthest point from the center gives the radius
+
+	assert(x && y && z);
+	assert(num >= 0);
+
+	if (num == 0)
+	{
+		POINT3D_INIT_XYZ(sphere.center, 0, 0, 0);
+		sphere.radius = 0.0f;
+		return;
+	}
+
+	AABB3D box;
+	AABB3D_From_Points(box, x, y, z, num);
+
+	POINT3D_INIT_XYZ(sphere.center,
+		(box.pMin.x + box.pMax.x) * 0.5f,
+		(box.pMin.y + box.pMax.y) * 0.5f,
+		(box.pMin.z + box.pMax.z) * 0.5f);
+
+	sphere.radius = sqrtf(Max_Dist2_To_Point(x, y, z, num, sphere.center));
+
+} // end SPHERE3D_From_Points
+
+///////////////////////////////////////////////////////////
+
+void AABB3D_Merge(const AABB3D & a, const AABB3D & b, AABB3D & merged)
+{
+	// this function computes the box which contains both boxes
+
+	merged.pMin.x = Min_Float(a.pMin.x, b.pMin.x);
+	merged.pMin.y = Min_Float(a.pMin.y, b.pMin.y);
+	merged.pMin.z = Min_Float(a.pMin.z, b.pMin.z);
+
+	merged.pMax.x = Max_Float(a.pMax.x, b.pMax.x);
+	merged.pMax.y = Max_Float(a.pMax.y, b.pMax.y);
+	merged.pMax.z = Max_Float(a.pMax.z, b.pMax.z);
+
+} // end AABB3D_Merge
+
+///////////////////////////////////////////////////////////
+
+void SPHERE3D_Merge(const SPHERE3D & a, const SPHERE3D & b, SPHERE3D & merged)
+{
+	// this function computes the smallest sphere which contains both spheres
+
+	const VECTOR3D ab(a.center, b.center);
+	const float dist = VECTOR3D_Length(ab);
+
+	// one sphere is inside the other one
+	if (dist + b.radius <= a.radius)
+	{
+		merged = a;
+		return;
+	}
+
+	if (dist + a.radius <= b.radius)
+	{
+		merged = b;
+		return;
+	}
+
+	// the new sphere touches both spheres on the line of the centers
+	// (dist > 0 here because else one of the spheres contains the other)
+	const float radius = (dist + a.radius + b.radius) * 0.5f;
+	const float k = (radius - a.radius) / dist;
+
+	POINT3D_INIT_XYZ(merged.center,
+		a.center.x + ab.x * k,
+		a.center.y + ab.y * k,
+		a.center.z + ab.z * k);
+
+	merged.radius = radius;
+
+} // end SPHERE3D_Merge
+
+///////////////////////////////////////////////////////////
+
+void AABB3D_Transform(const AABB3D & box, const MATRIX4X4 & m, AABB3D & boxOut)
+{
+	// this function transforms the box by Arvo's method: each coordinate j of the result
+	// is the sum of m[i][j] * p[i] (+ the translation), so its minimum is the sum of the
+	// minimums of each term: min(m[i][j] * pMin[i], m[i][j] * pMax[i])
+
+	const float bMin[3] = { box.pMin.x, box.pMin.y, box.pMin.z };
+	const float bMax[3] = { box.pMax.x, box.pMax.y, box.pMax.z };
+	float rMin[3];
+	float rMax[3];
+
+	for (int j = 0; j < 3; j++)
+	{
+		rMin[j] = m.M[3][j];
+		rMax[j] = m.M[3][j];
+
+		for (int i = 0; i < 3; i++)
+		{
+			const float a = m.M[i][j] * bMin[i];
+			const float b = m.M[i][j] * bMax[i];
+
+			rMin[j] += Min_Float(a, b);
+			rMax[j] += Max_Float(a, b);
+		}
+	}
+
+	POINT3D_INIT_XYZ(boxOut.pMin, rMin[0], rMin[1], rMin[2]);
+	POINT3D_INIT_XYZ(boxOut.pMax, rMax[0], rMax[1], rMax[2]);
+
+} // end AABB3D_Transform
+
+///////////////////////////////////////////////////////////
+
+static float Sphere_Radius_Scale(const MATRIX4X4 & m)
+{
+	// the rows 0..2 of the matrix are the images of the axes,
+	// so the longest of them is the maximal scale of the radius
+
+	const float scale2 = Max_Float(
+		Max_Float((m.M00 * m.M00) + (m.M01 * m.M01) + (m.M02 * m.M02),
+		          (m.M10 * m.M10) + (m.M11 * m.M11) + (m.M12 * m.M12)),
+		          (m.M20 * m.M20) + (m.M21 * m.M21) + (m.M22 * m.M22));
+
+	return sqrtf(scale2);
+}
+
+///////////////////////////////////////////////////////////
+
+void SPHERE3D_Transform(const SPHERE3D & sphere, const MATRIX4X4 & m, SPHERE3D & sphereOut)
+{
+	// this function transforms the center of the sphere and scales
+	// the radius by the maximal scale of the matrix
+
+	const POINT3D & c = sphere.center;
+	const float scale = Sphere_Radius_Scale(m);
+
+	POINT3D_INIT_XYZ(sphereOut.center,
+		(c.x * m.M00) + (c.y * m.M10) + (c.z * m.M20) + m.M30,
+		(c.x * m.M01) + (c.y * m.M11) + (c.z * m.M21) + m.M31,
+		(c.x * m.M02) + (c.y * m.M12) + (c.z * m.M22) + m.M32);
+
+	sphereOut.radius = sphere.radius * scale;
+
+} // end SPHERE3D_Transform
+
+///////////////////////////////////////////////////////////
+
+int AABB3D_Overlap(const AABB3D & a, const AABB3D & b)
+{
+	// boxes overlap if their projections overlap on each axis
+	return (a.pMin.x <= b.pMax.x) && (b.pMin.x <= a.pMax.x) &&
+	       (a.pMin.y <= b.pMax.y) && (b.pMin.y <= a.pMax.y) &&
+	       (a.pMin.z <= b.pMax.z) && (b.pMin.z <= a.pMax.z);
+
+} // end AABB3D_Overlap
+
+///////////////////////////////////////////////////////////
+
+int SPHERE3D_Overlap(const SPHERE3D & a, const SPHERE3D & b)
+{
+	// spheres overlap if the distance between the centers isn't greater
+	// than the sum of the radii (the squares are compared)
+
+	const float dx = b.center.x - a.center.x;
+	const float dy = b.center.y - a.center.y;
+	const float dz = b.center.z - a.center.z;
+	const float sumRadii = a.radius + b.radius;
+
+	return (((dx * dx) + (dy * dy)) + (dz * dz)) <= (sumRadii * sumRadii);
+
+} // end SPHERE3D_Overlap
+
+///////////////////////////////////////////////////////////
+
+int AABB3D_SPHERE3D_Overlap(const AABB3D & box, const SPHERE3D & sphere)
+{
+	// this function computes the squared distance from the center of the sphere
+	// to the closest point of the box and compares it with the squared radius
+
+	const float c[3] = { sphere.center.x, sphere.center.y, sphere.center.z };
+	const float bMin[3] = { box.pMin.x, box.pMin.y, box.pMin.z };
+	const float bMax[3] = { box.pMax.x, box.pMax.y, box.pMax.z };
+
+	float dist2 = 0.0f;
+
+	for (int i = 0; i < 3; i++)
+	{
+		if (c[i] < bMin[i])
+			dist2 += (bMin[i] - c[i]) * (bMin[i] - c[i]);
+
+		else if (c[i] > bMax[i])
+			dist2 += (c[i] - bMax[i]) * (c[i] - bMax[i]);
+	}
+
+	return dist2 <= (sphere.radius * sphere.radius);
+
+} // end AABB3D_SPHERE3D_Overlap
+
+///////////////////////////////////////////////////////////
+
+int AABB3D_Contains_Point(const AABB3D & box, const POINT3D & pt)
+{
+	return (pt.x >= box.pMin.x) && (pt.x <= box.pMax.x) &&
+	       (pt.y >= box.pMin.y) && (pt.y <= box.pMax.y) &&
+	       (pt.z >= box.pMin.z) && (pt.z <= box.pMax.z);
+
+} // end AABB3D_Contains_Point
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                  SCALAR KERNELS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void AABB3D_From_Points_Scalar(AABB3D & box, const float* x, const float* y, const float* z, const int num)
+{
+	// computes the box of num points using plain C++ code (reference kernel)
+
+	assert(x && y && z);
+	assert(num >= 0);
+
+	AABB3D_Init_Empty(box);
+
+	for (int i = 0; i < num; i++)
+	{
+		box.pMin.x = Min_Float(x[i], box.pMin.x);
+		box.pMin.y = Min_Float(y[i], box.pMin.y);
+		box.pMin.z = Min_Float(z[i], box.pMin.z);
+
+		box.pMax.x = Max_Float(x[i], box.pMax.x);
+		box.pMax.y = Max_Float(y[i], box.pMax.y);
+		box.pMax.z = Max_Float(z[i], box.pMax.z);
+	}
+
+} // end AABB3D_From_Points_Scalar
+
+///////////////////////////////////////////////////////////
+
+float Max_Dist2_To_Point_Scalar(const float* x, const float* y, const float* z, const int num, const POINT3D & center)
+{
+	// computes the maximal squared distance using plain C++ code (reference kernel)
+
+	assert(x && y && z);
+	assert(num >= 0);
+
+	float maxDist2 = 0.0f;
+
+	for (int i = 0; i < num; i++)
+	{
+		const float dx = x[i] - center.x;
+		const float dy = y[i] - center.y;
+		const float dz = z[i] - center.z;
+
+		maxDist2 = Max_Float(((dx * dx) + (dy * dy)) + (dz * dz), maxDist2);
+	}
+
+	return maxDist2;
+
+} // end Max_Dist2_To_Point_Scalar
+
+///////////////////////////////////////////////////////////
+
+void AABB3D_Transform_Batch_Scalar(const AABB3D_SOA & boxesIn, const MATRIX4X4 & m, const AABB3D_SOA_OUT & boxesOut, const int num)
+{
+	// transforms num boxes using plain C++ code (reference kernel)
+
+	assert(boxesIn.minX && boxesIn.minY && boxesIn.minZ && boxesIn.maxX && boxesIn.maxY && boxesIn.maxZ);
+	assert(boxesOut.minX && boxesOut.minY && boxesOut.minZ && boxesOut.maxX && boxesOut.maxY && boxesOut.maxZ);
+	assert(num >= 0);
+
+	for (int i = 0; i < num; i++)
+	{
+		AABB3D box(POINT3D(boxesIn.minX[i], boxesIn.minY[i], boxesIn.minZ[i]),
+		           POINT3D(boxesIn.maxX[i], boxesIn.maxY[i], boxesIn.maxZ[i]));
+
+		AABB3D_Transform(box, m, box);
+
+		boxesOut.minX[i] = box.pMin.x;
+		boxesOut.minY[i] = box.pMin.y;
+		boxesOut.minZ[i] = box.pMin.z;
+		boxesOut.maxX[i] = box.pMax.x;
+		boxesOut.maxY[i] = box.pMax.y;
+		boxesOut.maxZ[i] = box.pMax.z;
+	}
+
+} // end AABB3D_Transform_Batch_Scalar
+
+///////////////////////////////////////////////////////////
+
+void AABB3D_Overlap_Batch_Scalar(const AABB3D & query, const AABB3D_SOA & boxes, unsigned char* overlap, const int num)
+{
+	// tests num boxes using plain C++ code (reference kernel)
+
+	assert(boxes.minX && boxes.minY && boxes.minZ && boxes.maxX && boxes.maxY && boxes.maxZ);
+	assert(overlap != nullptr);
+	assert(num >= 0);
+
+	for (int i = 0; i < num; i++)
+	{
+		overlap[i] = (unsigned char)
+			((query.pMin.x <= boxes.maxX[i]) && (boxes.minX[i] <= query.pMax.x) &&
+			 (query.pMin.y <= boxes.maxY[i]) && (boxes.minY[i] <= query.pMax.y) &&
+			 (query.pMin.z <= boxes.maxZ[i]) && (boxes.minZ[i] <= query.pMax.z));
+	}
+
+} // end AABB3D_Overlap_Batch_Scalar
+
+///////////////////////////////////////////////////////////
+
+void SPHERE3D_Overlap_Batch_Scalar(const SPHERE3D & query, const SPHERE3D_SOA & spheres, unsigned char* overlap, const int num)
+{
+	// tests num spheres using plain C++ code (reference kernel)
+
+	assert(spheres.cx && spheres.cy && spheres.cz && spheres.radius);
+	assert(overlap != nullptr);
+	assert(num >= 0);
+
+	for (int i = 0; i < num; i++)
+	{
+		const SPHERE3D sphere(POINT3D(spheres.cx[i], spheres.cy[i], spheres.cz[i]), spheres.radius[i]);
+
+		overlap[i] = (unsigned char)SPHERE3D_Overlap(query, sphere);
+	}
+
+} // end SPHERE3D_Overlap_Batch_Scalar
+
+///////////////////////////////////////////////////////////
+
+void AABB3D_SPHERE3D_Overlap_Batch_Scalar(const SPHERE3D & query, const AABB3D_SOA & boxes, unsigned char* overlap, const int num)
+{
+	// tests num boxes against the sphere using plain C++ code (reference kernel)
+
+	assert(boxes.minX && boxes.minY && boxes.minZ && boxes.maxX && boxes.maxY && boxes.maxZ);
+	assert(overlap != nullptr);
+	assert(num >= 0);
+
+	for (int i = 0; i < num; i++)
+	{
+		const AABB3D box(POINT3D(boxes.minX[i], boxes.minY[i], boxes.minZ[i]),
+		                 POINT3D(boxes.maxX[i], boxes.maxY[i], boxes.maxZ[i]));
+
+		overlap[i] = (unsigned char)AABB3D_SPHERE3D_Overlap(box, query);
+	}
+
+} // end AABB3D_SPHERE3D_Overlap_Batch_Scalar
+
+///////////////////////////////////////////////////////////
+
+void SPHERE3D_Transform_Batch_Scalar(const SPHERE3D_SOA & spheresIn, const MATRIX4X4 & m, const SPHERE3D_SOA_OUT & spheresOut, const int num)
+{
+	// transforms num spheres using plain C++ code (reference kernel)
+
+	assert(spheresIn.cx && spheresIn.cy && spheresIn.cz && spheresIn.radius);
+	assert(spheresOut.cx && spheresOut.cy && spheresOut.cz && spheresOut.radius);
+	assert(num >= 0);
+
+	for (int i = 0; i < num; i++)
+	{
+		SPHERE3D sphere(POINT3D(spheresIn.cx[i], spheresIn.cy[i], spheresIn.cz[i]), spheresIn.radius[i]);
+
+		SPHERE3D_Transform(sphere, m, sphere);
+
+		spheresOut.cx[i] = sphere.center.x;
+		spheresOut.cy[i] = sphere.center.y;
+		spheresOut.cz[i] = sphere.center.z;
+		spheresOut.radius[i] = sphere.radius;
+	}
+
+} // end SPHERE3D_Transform_Batch_Scalar
+
+///////////////////////////////////////////////////////////
+
+void SPHERE3D_Merge_Batch_Scalar(const SPHERE3D_SOA & a, const SPHERE3D_SOA & b, const SPHERE3D_SOA_OUT & merged, const int num)
+{
+	// merges num pairs of spheres using plain C++ code (reference kernel)
+
+	assert(a.cx && a.cy && a.cz && a.radius);
+	assert(b.cx && b.cy && b.cz && b.radius);
+	assert(merged.cx && merged.cy && merged.cz && merged.radius);
+	assert(num >= 0);
+
+	for (int i = 0; i < num; i++)
+	{
+		const SPHERE3D sa(POINT3D(a.cx[i], a.cy[i], a.cz[i]), a.radius[i]);
+		const SPHERE3D sb(POINT3D(b.cx[i], b.cy[i], b.cz[i]), b.radius[i]);
+		SPHERE3D sm;
+
+		SPHERE3D_Merge(sa, sb, sm);
+
+		merged.cx[i] = sm.center.x;
+		merged.cy[i] = sm.center.y;
+		merged.cz[i] = sm.center.z;
+		merged.radius[i] = sm.radius;
+	}
+
+} // end SPHERE3D_Merge_Batch_Scalar
+
+///////////////////////////////////////////////////////////
+
+void AABB3D_Merge_Batch(const AABB3D_SOA & a, const AABB3D_SOA & b, const AABB3D_SOA_OUT & merged, const int num)
+{
+	// merges num pairs of boxes; there are no dependencies between the iterations
+	// so the compiler vectorizes the loop itself (minps/maxps)
+
+	assert(a.minX && a.minY && a.minZ && a.maxX && a.maxY && a.maxZ);
+	assert(b.minX && b.minY && b.minZ && b.maxX && b.maxY && b.maxZ);
+	assert(merged.minX && merged.minY && merged.minZ && merged.maxX && merged.maxY && merged.maxZ);
+	assert(num >= 0);
+
+	for (int i = 0; i < num; i++)
+	{
+		merged.minX[i] = Min_Float(a.minX[i], b.minX[i]);
+		merged.minY[i] = Min_Float(a.minY[i], b.minY[i]);
+		merged.minZ[i] = Min_Float(a.minZ[i], b.minZ[i]);
+
+		merged.maxX[i] = Max_Float(a.maxX[i], b.maxX[i]);
+		merged.maxY[i] = Max_Float(a.maxY[i], b.maxY[i]);
+		merged.maxZ[i] = Max_Float(a.maxZ[i], b.maxZ[i]);
+	}
+
+} // end AABB3D_Merge_Batch
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                   SIMD KERNELS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+#if MATHLIB_SIMD_X86
+
+MATHLIB_TARGET_SSE41
+static inline float Horizontal_Min_SSE(__m128 v)
+{
+	v = _mm_min_ps(v, _mm_movehl_ps(v, v));
+	v = _mm_min_ss(v, _mm_shuffle_ps(v, v, 1));
+	return _mm_cvtss_f32(v);
+}
+
+MATHLIB_TARGET_SSE41
+static inline float Horizontal_Max_SSE(__m128 v)
+{
+	v = _mm_max_ps(v, _mm_movehl_ps(v, v));
+	v = _mm_max_ss(v, _mm_shuffle_ps(v, v, 1));
+	return _mm_cvtss_f32(v);
+}
+
+MATHLIB_TARGET_SSE41
+static inline void Store_Bytes_SSE(unsigned char* dst, const __m128 mask)
+{
+	// stores 4 masks as 4 bytes (1 or 0)
+	const __m128i v = _mm_and_si128(_mm_castps_si128(mask), _mm_set1_epi32(1));
+	const __m128i v16 = _mm_packs_epi32(v, v);
+	const int v8 = _mm_cvtsi128_si32(_mm_packus_epi16(v16, v16));
+
+	memcpy(dst, &v8, 4);
+}
+
+MATHLIB_TARGET_AVX2
+static inline void Store_Bytes_AVX2(unsigned char* dst, const __m256 mask)
+{
+	// stores 8 masks as 8 bytes (1 or 0)
+	const __m256i v = _mm256_and_si256(_mm256_castps_si256(mask), _mm256_set1_epi32(1));
+	const __m128i v16 = _mm_packs_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+
+	_mm_storel_epi64((__m128i*)dst, _mm_packus_epi16(v16, v16));
+}
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_SSE41
+void AABB3D_From_Points_SSE(AABB3D & box, const float* x, const float* y, const float* z, const int num)
+{
+	// computes the box of num points; processes 4 points per iteration;
+	// the tail (num % 4 points) is processed by the scalar kernel
+
+	assert(x && y && z);
+	assert(num >= 0);
+
+	__m128 minX = _mm_set1_ps(FLT_MAX);
+	__m128 minY = minX;
+	__m128 minZ = minX;
+	__m128 maxX = _mm_set1_ps(-FLT_MAX);
+	__m128 maxY = maxX;
+	__m128 maxZ = maxX;
+
+	int i = 0;
+
+	for (; i + 4 <= num; i += 4)
+	{
+		const __m128 px = _mm_loadu_ps(x + i);
+		const __m128 py = _mm_loadu_ps(y + i);
+		const __m128 pz = _mm_loadu_ps(z + i);
+
+		minX = _mm_min_ps(px, minX);
+		minY = _mm_min_ps(py, minY);
+		minZ = _mm_min_ps(pz, minZ);
+		maxX = _mm_max_ps(px, maxX);
+		maxY = _mm_max_ps(py, maxY);
+		maxZ = _mm_max_ps(pz, maxZ);
+	}
+
+	// process the rest of points and merge it with the lanes
+	AABB3D_From_Points_Scalar(box, x + i, y + i, z + i, num - i);
+
+	box.pMin.x = Min_Float(Horizontal_Min_SSE(minX), box.pMin.x);
+	box.pMin.y = Min_Float(Horizontal_Min_SSE(minY), box.pMin.y);
+	box.pMin.z = Min_Float(Horizontal_Min_SSE(minZ), box.pMin.z);
+	box.pMax.x = Max_Float(Horizontal_Max_SSE(maxX), box.pMax.x);
+	box.pMax.y = Max_Float(Horizontal_Max_SSE(maxY), box.pMax.y);
+	box.pMax.z = Max_Float(Horizontal_Max_SSE(maxZ), box.pMax.z);
+
+} // end AABB3D_From_Points_SSE
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_AVX2
+void AABB3D_From_Points_AVX2(AABB3D & box, const float* x, const float* y, const float* z, const int num)
+{
+	// computes the box of num points; processes 8 points per iteration;
+	// the tail (num % 8 points) is processed by the SSE kernel
+
+	assert(x && y && z);
+	assert(num >= 0);
+
+	__m256 minX = _mm256_set1_ps(FLT_MAX);
+	__m256 minY = minX;
+	__m256 minZ = minX;
+	__m256 maxX = _mm256_set1_ps(-FLT_MAX);
+	__m256 maxY = maxX;
+	__m256 maxZ = maxX;
+
+	int i = 0;
+
+	for (; i + 8 <= num; i += 8)
+	{
+		const __m256 px = _mm256_loadu_ps(x + i);
+		const __m256 py = _mm256_loadu_ps(y + i);
+		const __m256 pz = _mm256_loadu_ps(z + i);
+
+		minX = _mm256_min_ps(px, minX);
+		minY = _mm256_min_ps(py, minY);
+		minZ = _mm256_min_ps(pz, minZ);
+		maxX = _mm256_max_ps(px, maxX);
+		maxY = _mm256_max_ps(py, maxY);
+		maxZ = _mm256_max_ps(pz, maxZ);
+	}
+
+	// process the rest of points and merge it with the lanes
+	AABB3D_From_Points_SSE(box, x + i, y + i, z + i, num - i);
+
+	box.pMin.x = Min_Float(Horizontal_Min_SSE(_mm_min_ps(_mm256_castps256_ps128(minX), _mm256_extractf128_ps(minX, 1))), box.pMin.x);
+	box.pMin.y = Min_Float(Horizontal_Min_SSE(_mm_min_ps(_mm256_castps256_ps128(minY), _mm256_extractf128_ps(minY, 1))), box.pMin.y);
+	box.pMin.z = Min_Float(Horizontal_Min_SSE(_mm_min_ps(_mm256_castps256_ps128(minZ), _mm256_extractf128_ps(minZ, 1))), box.pMin.z);
+	box.pMax.x = Max_Float(Horizontal_Max_SSE(_mm_max_ps(_mm256_castps256_ps128(maxX), _mm256_extractf128_ps(maxX, 1))), box.pMax.x);
+	box.pMax.y = Max_Float(Horizontal_Max_SSE(_mm_max_ps(_mm256_castps256_ps128(maxY), _mm256_extractf128_ps(maxY, 1))), box.pMax.y);
+	box.pMax.z = Max_Float(Horizontal_Max_SSE(_mm_max_ps(_mm256_castps256_ps128(maxZ), _mm256_extractf128_ps(maxZ, 1))), box.pMax.z);
+
+} // end AABB3D_From_Points_AVX2
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_SSE41
+float Max_Dist2_To_Point_SSE(const float* x, const float* y, const float* z, const int num, const POINT3D & center)
+{
+	// computes the maximal squared distance; processes 4 points per iteration;
+	// the tail (num % 4 points) is processed by the scalar kernel
+
+	assert(x && y && z);
+	assert(num >= 0);
+
+	const __m128 cx = _mm_set1_ps(center.x);
+	const __m128 cy = _mm_set1_ps(center.y);
+	const __m128 cz = _mm_set1_ps(center.z);
+
+	__m128 maxDist2 = _mm_setzero_ps();
+	int i = 0;
+
+	for (; i + 4 <= num; i += 4)
+	{
+		const __m128 dx = _mm_sub_ps(_mm_loadu_ps(x + i), cx);
+		const __m128 dy = _mm_sub_ps(_mm_loadu_ps(y + i), cy);
+		const __m128 dz = _mm_sub_ps(_mm_loadu_ps(z + i), cz);
+
+		const __m128 dist2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+
+		maxDist2 = _mm_max_ps(dist2, maxDist2);
+	}
+
+	// process the rest of points
+	return Max_Float(Horizontal_Max_SSE(maxDist2), Max_Dist2_To_Point_Scalar(x + i, y + i, z + i, num - i, center));
+
+} // end Max_Dist2_To_Point_SSE
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_AVX2
+float Max_Dist2_To_Point_AVX2(const float* x, const float* y, const float* z, const int num, const POINT3D & center)
+{
+	// computes the maximal squared distance; processes 8 points per iteration;
+	// the tail (num % 8 points) is processed by the SSE kernel
+
+	assert(x && y && z);
+	assert(num >= 0);
+
+	const __m256 cx = _mm256_set1_ps(center.x);
+	const __m256 cy = _mm256_set1_ps(center.y);
+	const __m256 cz = _mm256_set1_ps(center.z);
+
+	__m256 maxDist2 = _mm256_setzero_ps();
+	int i = 0;
+
+	for (; i + 8 <= num; i += 8)
+	{
+		const __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(x + i), cx);
+		const __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(y + i), cy);
+		const __m256 dz = _mm256_sub_ps(_mm256_loadu_ps(z + i), cz);
+
+		const __m256 dist2 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)), _mm256_mul_ps(dz, dz));
+
+		maxDist2 = _mm256_max_ps(dist2, maxDist2);
+	}
+
+	const float lanes = Horizontal_Max_SSE(_mm_max_ps(_mm256_castps256_ps128(maxDist2), _mm256_extractf128_ps(maxDist2, 1)));
+
+	// process the rest of points
+	return Max_Float(lanes, Max_Dist2_To_Point_SSE(x + i, y + i, z + i, num - i, center));
+
+} // end Max_Dist2_To_Point_AVX2
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_SSE41
+void AABB3D_Transform_Batch_SSE(const AABB3D_SOA & boxesIn, const MATRIX4X4 & m, const AABB3D_SOA_OUT & boxesOut, const int num)
+{
+	// transforms num boxes; processes 4 boxes per iteration;
+	// the tail (num % 4 boxes) is processed by the scalar kernel
+
+	assert(boxesIn.minX && boxesIn.minY && boxesIn.minZ && boxesIn.maxX && boxesIn.maxY && boxesIn.maxZ);
+	assert(boxesOut.minX && boxesOut.minY && boxesOut.minZ && boxesOut.maxX && boxesOut.maxY && boxesOut.maxZ);
+	assert(num >= 0);
+
+	__m128 mat[4][3];
+
+	for (int r = 0; r < 4; r++)
+		for (int c = 0; c < 3; c++)
+			mat[r][c] = _mm_set1_ps(m.M[r][c]);
+
+	int i = 0;
+
+	for (; i + 4 <= num; i += 4)
+	{
+		const __m128 bMin[3] = { _mm_loadu_ps(boxesIn.minX + i), _mm_loadu_ps(boxesIn.minY + i), _mm_loadu_ps(boxesIn.minZ + i) };
+		const __m128 bMax[3] = { _mm_loadu_ps(boxesIn.maxX + i), _mm_loadu_ps(boxesIn.maxY + i), _mm_loadu_ps(boxesIn.maxZ + i) };
+		__m128 rMin[3];
+		__m128 rMax[3];
+
+		for (int j = 0; j < 3; j++)
+		{
+			rMin[j] = mat[3][j];
+			rMax[j] = mat[3][j];
+
+			for (int k = 0; k < 3; k++)
+			{
+				const __m128 a = _mm_mul_ps(mat[k][j], bMin[k]);
+				const __m128 b = _mm_mul_ps(mat[k][j], bMax[k]);
+
+				rMin[j] = _mm_add_ps(rMin[j], _mm_min_ps(a, b));
+				rMax[j] = _mm_add_ps(rMax[j], _mm_max_ps(a, b));
+			}
+		}
+
+		_mm_storeu_ps(boxesOut.minX + i, rMin[0]);
+		_mm_storeu_ps(boxesOut.minY + i, rMin[1]);
+		_mm_storeu_ps(boxesOut.minZ + i, rMin[2]);
+		_mm_storeu_ps(boxesOut.maxX + i, rMax[0]);
+		_mm_storeu_ps(boxesOut.maxY + i, rMax[1]);
+		_mm_storeu_ps(boxesOut.maxZ + i, rMax[2]);
+	}
+
+	// process the rest of boxes
+	AABB3D_SOA restIn = boxesIn;
+	AABB3D_SOA_OUT restOut = boxesOut;
+
+	restIn.minX += i;  restIn.minY += i;  restIn.minZ += i;
+	restIn.maxX += i;  restIn.maxY += i;  restIn.maxZ += i;
+	restOut.minX += i; restOut.minY += i; restOut.minZ += i;
+	restOut.maxX += i; restOut.maxY += i; restOut.maxZ += i;
+
+	AABB3D_Transform_Batch_Scalar(restIn, m, restOut, num - i);
+
+} // end AABB3D_Transform_Batch_SSE
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_AVX2
+void AABB3D_Transform_Batch_AVX2(const AABB3D_SOA & boxesIn, const MATRIX4X4 & m, const AABB3D_SOA_OUT & boxesOut, const int num)
+{
+	// transforms num boxes; processes 8 boxes per iteration;
+	// the tail (num % 8 boxes) is processed by the SSE kernel
+	//
+	// NOTE: FMA isn't used here on purpose (see the note in Simd.h)
+
+	assert(boxesIn.minX && boxesIn.minY && boxesIn.minZ && boxesIn.maxX && boxesIn.maxY && boxesIn.maxZ);
+	assert(boxesOut.minX && boxesOut.minY && boxesOut.minZ && boxesOut.maxX && boxesOut.maxY && boxesOut.maxZ);
+	assert(num >= 0);
+
+	__m256 mat[4][3];
+
+	for (int r = 0; r < 4; r++)
+		for (int c = 0; c < 3; c++)
+			mat[r][c] = _mm256_set1_ps(m.M[r][c]);
+
+	int i = 0;
+
+	for (; i + 8 <= num; i += 8)
+	{
+		const __m256 bMin[3] = { _mm256_loadu_ps(boxesIn.minX + i), _mm256_loadu_ps(boxesIn.minY + i), _mm256_loadu_ps(boxesIn.minZ + i) };
+		const __m256 bMax[3] = { _mm256_loadu_ps(boxesIn.maxX + i), _mm256_loadu_ps(boxesIn.maxY + i), _mm256_loadu_ps(boxesIn.maxZ + i) };
+		__m256 rMin[3];
+		__m256 rMax[3];
+
+		for (int j = 0; j < 3; j++)
+		{
+			rMin[j] = mat[3][j];
+			rMax[j] = mat[3][j];
+
+			for (int k = 0; k < 3; k++)
+			{
+				const __m256 a = _mm256_mul_ps(mat[k][j], bMin[k]);
+				const __m256 b = _mm256_mul_ps(mat[k][j], bMax[k]);
+
+				rMin[j] = _mm256_add_ps(rMin[j], _mm256_min_ps(a, b));
+				rMax[j] = _mm256_add_ps(rMax[j], _mm256_max_ps(a, b));
+			}
+		}
+
+		_mm256_storeu_ps(boxesOut.minX + i, rMin[0]);
+		_mm256_storeu_ps(boxesOut.minY + i, rMin[1]);
+		_mm256_storeu_ps(boxesOut.minZ + i, rMin[2]);
+		_mm256_storeu_ps(boxesOut.maxX + i, rMax[0]);
+		_mm256_storeu_ps(boxesOut.maxY + i, rMax[1]);
+		_mm256_storeu_ps(boxesOut.maxZ + i, rMax[2]);
+	}
+
+	// process the rest of boxes
+	AABB3D_SOA restIn = boxesIn;
+	AABB3D_SOA_OUT restOut = boxesOut;
+
+	restIn.minX += i;  restIn.minY += i;  restIn.minZ += i;
+	restIn.maxX += i;  restIn.maxY += i;  restIn.maxZ += i;
+	restOut.minX += i; restOut.minY += i; restOut.minZ += i;
+	restOut.maxX += i; restOut.maxY += i; restOut.maxZ += i;
+
+	AABB3D_Transform_Batch_SSE(restIn, m, restOut, num - i);
+
+} // end AABB3D_Transform_Batch_AVX2
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_SSE41
+void AABB3D_Overlap_Batch_SSE(const AABB3D & query, const AABB3D_SOA & boxes, unsigned char* overlap, const int num)
+{
+	// tests num boxes; processes 4 boxes per iteration;
+	// the tail (num % 4 boxes) is processed by the scalar kernel
+
+	assert(boxes.minX && boxes.minY && boxes.minZ && boxes.maxX && boxes.maxY && boxes.maxZ);
+	assert(overlap != nullptr);
+	assert(num >= 0);
+
+	const __m128 qMinX = _mm_set1_ps(query.pMin.x);
+	const __m128 qMinY = _mm_set1_ps(query.pMin.y);
+	const __m128 qMinZ = _mm_set1_ps(query.pMin.z);
+	const __m128 qMaxX = _mm_set1_ps(query.pMax.x);
+	const __m128 qMaxY = _mm_set1_ps(query.pMax.y);
+	const __m128 qMaxZ = _mm_set1_ps(query.pMax.z);
+
+	int i = 0;
+
+	for (; i + 4 <= num; i += 4)
+	{
+		const __m128 ox = _mm_and_ps(_mm_cmple_ps(qMinX, _mm_loadu_ps(boxes.maxX + i)), _mm_cmple_ps(_mm_loadu_ps(boxes.minX + i), qMaxX));
+		const __m128 oy = _mm_and_ps(_mm_cmple_ps(qMinY, _mm_loadu_ps(boxes.maxY + i)), _mm_cmple_ps(_mm_loadu_ps(boxes.minY + i), qMaxY));
+		const __m128 oz = _mm_and_ps(_mm_cmple_ps(qMinZ, _mm_loadu_ps(boxes.maxZ + i)), _mm_cmple_ps(_mm_loadu_ps(boxes.minZ + i), qMaxZ));
+
+		Store_Bytes_SSE(overlap + i, _mm_and_ps(_mm_and_ps(ox, oy), oz));
+	}
+
+	// process the rest of boxes
+	AABB3D_SOA rest = boxes;
+
+	rest.minX += i; rest.minY += i; rest.minZ += i;
+	rest.maxX += i; rest.maxY += i; rest.maxZ += i;
+
+	AABB3D_Overlap_Batch_Scalar(query, rest, overlap + i, num - i);
+
+} // end AABB3D_Overlap_Batch_SSE
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_AVX2
+void AABB3D_Overlap_Batch_AVX2(const AABB3D & query, const AABB3D_SOA & boxes, unsigned char* overlap, const int num)
+{
+	// tests num boxes; processes 8 boxes per iteration;
+	// the tail (num % 8 boxes) is processed by the SSE kernel
+
+	assert(boxes.minX && boxes.minY && boxes.minZ && boxes.maxX && boxes.maxY && boxes.maxZ);
+	assert(overlap != nullptr);
+	assert(num >= 0);
+
+	const __m256 qMinX = _mm256_set1_ps(query.pMin.x);
+	const __m256 qMinY = _mm256_set1_ps(query.pMin.y);
+	const __m256 qMinZ = _mm256_set1_ps(query.pMin.z);
+	const __m256 qMaxX = _mm256_set1_ps(query.pMax.x);
+	const __m256 qMaxY = _mm256_set1_ps(query.pMax.y);
+	const __m256 qMaxZ = _mm256_set1_ps(query.pMax.z);
+
+	int i = 0;
+
+	for (; i + 8 <= num; i += 8)
+	{
+		const __m256 ox = _mm256_and_ps(_mm256_cmp_ps(qMinX, _mm256_loadu_ps(boxes.maxX + i), _CMP_LE_OQ),
+		                                _mm256_cmp_ps(_mm256_loadu_ps(boxes.minX + i), qMaxX, _CMP_LE_OQ));
+		const __m256 oy = _mm256_and_ps(_mm256_cmp_ps(qMinY, _mm256_loadu_ps(boxes.maxY + i), _CMP_LE_OQ),
+		                                _mm256_cmp_ps(_mm256_loadu_ps(boxes.minY + i), qMaxY, _CMP_LE_OQ));
+		const __m256 oz = _mm256_and_ps(_mm256_cmp_ps(qMinZ, _mm256_loadu_ps(boxes.maxZ + i), _CMP_LE_OQ),
+		                                _mm256_cmp_ps(_mm256_loadu_ps(boxes.minZ + i), qMaxZ, _CMP_LE_OQ));
+
+		Store_Bytes_AVX2(overlap + i, _mm256_and_ps(_mm256_and_ps(ox, oy), oz));
+	}
+
+	// process the rest of boxes
+	AABB3D_SOA rest = boxes;
+
+	rest.minX += i; rest.minY += i; rest.minZ += i;
+	rest.maxX += i; rest.maxY += i; rest.maxZ += i;
+
+	AABB3D_Overlap_Batch_SSE(query, rest, overlap + i, num - i);
+
+} // end AABB3D_Overlap_Batch_AVX2
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_SSE41
+void SPHERE3D_Overlap_Batch_SSE(const SPHERE3D & query, const SPHERE3D_SOA & spheres, unsigned char* overlap, const int num)
+{
+	// tests num spheres; processes 4 spheres per iteration;
+	// the tail (num % 4 spheres) is processed by the scalar kernel
+
+	assert(spheres.cx && spheres.cy && spheres.cz && spheres.radius);
+	assert(overlap != nullptr);
+	assert(num >= 0);
+
+	const __m128 qx = _mm_set1_ps(query.center.x);
+	const __m128 qy = _mm_set1_ps(query.center.y);
+	const __m128 qz = _mm_set1_ps(query.center.z);
+	const __m128 qr = _mm_set1_ps(query.radius);
+
+	int i = 0;
+
+	for (; i + 4 <= num; i += 4)
+	{
+		const __m128 dx = _mm_sub_ps(_mm_loadu_ps(spheres.cx + i), qx);
+		const __m128 dy = _mm_sub_ps(_mm_loadu_ps(spheres.cy + i), qy);
+		const __m128 dz = _mm_sub_ps(_mm_loadu_ps(spheres.cz + i), qz);
+		const __m128 sumRadii = _mm_add_ps(qr, _mm_loadu_ps(spheres.radius + i));
+
+		const __m128 dist2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+
+		Store_Bytes_SSE(overlap + i, _mm_cmple_ps(dist2, _mm_mul_ps(sumRadii, sumRadii)));
+	}
+
+	// process the rest of spheres
+	SPHERE3D_SOA rest = spheres;
+
+	rest.cx += i; rest.cy += i; rest.cz += i; rest.radius += i;
+
+	SPHERE3D_Overlap_Batch_Scalar(query, rest, overlap + i, num - i);
+
+} // end SPHERE3D_Overlap_Batch_SSE
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_AVX2
+void SPHERE3D_Overlap_Batch_AVX2(const SPHERE3D & query, const SPHERE3D_SOA & spheres, unsigned char* overlap, const int num)
+{
+	// tests num spheres; processes 8 spheres per iteration;
+	// the tail (num % 8 spheres) is processed by the SSE kernel
+	//
+	// NOTE: FMA isn't used here on purpose (see the note in Simd.h)
+
+	assert(spheres.cx && spheres.cy && spheres.cz && spheres.radius);
+	assert(overlap != nullptr);
+	assert(num >= 0);
+
+	const __m256 qx = _mm256_set1_ps(query.center.x);
+	const __m256 qy = _mm256_set1_ps(query.center.y);
+	const __m256 qz = _mm256_set1_ps(query.center.z);
+	const __m256 qr = _mm256_set1_ps(query.radius);
+
+	int i = 0;
+
+	for (; i + 8 <= num; i += 8)
+	{
+		const __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(spheres.cx + i), qx);
+		const __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(spheres.cy + i), qy);
+		const __m256 dz = _mm256_sub_ps(_mm256_loadu_ps(spheres.cz + i), qz);
+		const __m256 sumRadii = _mm256_add_ps(qr, _mm256_loadu_ps(spheres.radius + i));
+
+		const __m256 dist2 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)), _mm256_mul_ps(dz, dz));
+
+		Store_Bytes_AVX2(overlap + i, _mm256_cmp_ps(dist2, _mm256_mul_ps(sumRadii, sumRadii), _CMP_LE_OQ));
+	}
+
+	// process the rest of spheres
+	SPHERE3D_SOA rest = spheres;
+
+	rest.cx += i; rest.cy += i; rest.cz += i; rest.radius += i;
+
+	SPHERE3D_Overlap_Batch_SSE(query, rest, overlap + i, num - i);
+
+} // end SPHERE3D_Overlap_Batch_AVX2
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_SSE41
+void AABB3D_SPHERE3D_Overlap_Batch_SSE(const SPHERE3D & query, const AABB3D_SOA & boxes, unsigned char* overlap, const int num)
+{
+	// tests num boxes against the sphere; processes 4 boxes per iteration;
+	// the tail (num % 4 boxes) is processed by the scalar kernel
+	//
+	// the branches of AABB3D_SPHERE3D_Overlap are replaced by blends: the squared distance
+	// along an axis is 0 if the center is between the planes of the box
+
+	assert(boxes.minX && boxes.minY && boxes.minZ && boxes.maxX && boxes.maxY && boxes.maxZ);
+	assert(overlap != nullptr);
+	assert(num >= 0);
+
+	const __m128 c[3] = { _mm_set1_ps(query.center.x), _mm_set1_ps(query.center.y), _mm_set1_ps(query.center.z) };
+	const __m128 r2 = _mm_set1_ps(query.radius * query.radius);
+	const __m128 zero = _mm_setzero_ps();
+
+	const float* minArr[3] = { boxes.minX, boxes.minY, boxes.minZ };
+	const float* maxArr[3] = { boxes.maxX, boxes.maxY, boxes.maxZ };
+
+	int i = 0;
+
+	for (; i + 4 <= num; i += 4)
+	{
+		__m128 dist2 = zero;
+
+		for (int k = 0; k < 3; k++)
+		{
+			const __m128 bMin = _mm_loadu_ps(minArr[k] + i);
+			const __m128 bMax = _mm_loadu_ps(maxArr[k] + i);
+
+			const __m128 dMin = _mm_sub_ps(bMin, c[k]);
+			const __m128 dMax = _mm_sub_ps(c[k], bMax);
+
+			__m128 d2 = _mm_blendv_ps(zero, _mm_mul_ps(dMax, dMax), _mm_cmpgt_ps(c[k], bMax));
+			d2 = _mm_blendv_ps(d2, _mm_mul_ps(dMin, dMin), _mm_cmplt_ps(c[k], bMin));
+
+			dist2 = _mm_add_ps(dist2, d2);
+		}
+
+		Store_Bytes_SSE(overlap + i, _mm_cmple_ps(dist2, r2));
+	}
+
+	// process the rest of boxes
+	AABB3D_SOA rest = boxes;
+
+	rest.minX += i; rest.minY += i; rest.minZ += i;
+	rest.maxX += i; rest.maxY += i; rest.maxZ += i;
+
+	AABB3D_SPHERE3D_Overlap_Batch_Scalar(query, rest, overlap + i, num - i);
+
+} // end AABB3D_SPHERE3D_Overlap_Batch_SSE
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_AVX2
+void AABB3D_SPHERE3D_Overlap_Batch_AVX2(const SPHERE3D & query, const AABB3D_SOA & boxes, unsigned char* overlap, const int num)
+{
+	// tests num boxes against the sphere; processes 8 boxes per iteration;
+	// the tail (num % 8 boxes) is processed by the SSE kernel
+
+	assert(boxes.minX && boxes.minY && boxes.minZ && boxes.maxX && boxes.maxY && boxes.maxZ);
+	assert(overlap != nullptr);
+	assert(num >= 0);
+
+	const __m256 c[3] = { _mm256_set1_ps(query.center.x), _mm256_set1_ps(query.center.y), _mm256_set1_ps(query.center.z) };
+	const __m256 r2 = _mm256_set1_ps(query.radius * query.radius);
+	const __m256 zero = _mm256_setzero_ps();
+
+	const float* minArr[3] = { boxes.minX, boxes.minY, boxes.minZ };
+	const float* maxArr[3] = { boxes.maxX, boxes.maxY, boxes.maxZ };
+
+	int i = 0;
+
+	for (; i + 8 <= num; i += 8)
+	{
+		__m256 dist2 = zero;
+
+		for (int k = 0; k < 3; k++)
+		{
+			const __m256 bMin = _mm256_loadu_ps(minArr[k] + i);
+			const __m256 bMax = _mm256_loadu_ps(maxArr[k] + i);
+
+			const __m256 dMin = _mm256_sub_ps(bMin, c[k]);
+			const __m256 dMax = _mm256_sub_ps(c[k], bMax);
+
+			__m256 d2 = _mm256_blendv_ps(zero, _mm256_mul_ps(dMax, dMax), _mm256_cmp_ps(c[k], bMax, _CMP_GT_OQ));
+			d2 = _mm256_blendv_ps(d2, _mm256_mul_ps(dMin, dMin), _mm256_cmp_ps(c[k], bMin, _CMP_LT_OQ));
+
+			dist2 = _mm256_add_ps(dist2, d2);
+		}
+
+		Store_Bytes_AVX2(overlap + i, _mm256_cmp_ps(dist2, r2, _CMP_LE_OQ));
+	}
+
+	// process the rest of boxes
+	AABB3D_SOA rest = boxes;
+
+	rest.minX += i; rest.minY += i; rest.minZ += i;
+	rest.maxX += i; rest.maxY += i; rest.maxZ += i;
+
+	AABB3D_SPHERE3D_Overlap_Batch_SSE(query, rest, overlap + i, num - i);
+
+} // end AABB3D_SPHERE3D_Overlap_Batch_AVX2
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_SSE41
+void SPHERE3D_Transform_Batch_SSE(const SPHERE3D_SOA & spheresIn, const MATRIX4X4 & m, const SPHERE3D_SOA_OUT & spheresOut, const int num)
+{
+	// transforms num spheres; processes 4 spheres per iteration;
+	// the tail (num % 4 spheres) is processed by the scalar kernel
+
+	assert(spheresIn.cx && spheresIn.cy && spheresIn.cz && spheresIn.radius);
+	assert(spheresOut.cx && spheresOut.cy && spheresOut.cz && spheresOut.radius);
+	assert(num >= 0);
+
+	__m128 mat[4][3];
+
+	for (int r = 0; r < 4; r++)
+		for (int c = 0; c < 3; c++)
+			mat[r][c] = _mm_set1_ps(m.M[r][c]);
+
+	// the scale of the radius is the same for all the spheres
+	const __m128 scale = _mm_set1_ps(Sphere_Radius_Scale(m));
+
+	int i = 0;
+
+	for (; i + 4 <= num; i += 4)
+	{
+		const __m128 cx = _mm_loadu_ps(spheresIn.cx + i);
+		const __m128 cy = _mm_loadu_ps(spheresIn.cy + i);
+		const __m128 cz = _mm_loadu_ps(spheresIn.cz + i);
+		const __m128 r = _mm_loadu_ps(spheresIn.radius + i);
+
+		__m128 res[3];
+
+		for (int j = 0; j < 3; j++)
+		{
+			res[j] = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(cx, mat[0][j]), _mm_mul_ps(cy, mat[1][j])),
+				_mm_mul_ps(cz, mat[2][j])), mat[3][j]);
+		}
+
+		_mm_storeu_ps(spheresOut.cx + i, res[0]);
+		_mm_storeu_ps(spheresOut.cy + i, res[1]);
+		_mm_storeu_ps(spheresOut.cz + i, res[2]);
+		_mm_storeu_ps(spheresOut.radius + i, _mm_mul_ps(r, scale));
+	}
+
+	// process the rest of spheres
+	SPHERE3D_SOA restIn = spheresIn;
+	SPHERE3D_SOA_OUT restOut = spheresOut;
+
+	restIn.cx += i;  restIn.cy += i;  restIn.cz += i;  restIn.radius += i;
+	restOut.cx += i; restOut.cy += i; restOut.cz += i; restOut.radius += i;
+
+	SPHERE3D_Transform_Batch_Scalar(restIn, m, restOut, num - i);
+
+} // end SPHERE3D_Transform_Batch_SSE
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_AVX2
+void SPHERE3D_Transform_Batch_AVX2(const SPHERE3D_SOA & spheresIn, const MATRIX4X4 & m, const SPHERE3D_SOA_OUT & spheresOut, const int num)
+{
+	// transforms num spheres; processes 8 spheres per iteration;
+	// the tail (num % 8 spheres) is processed by the SSE kernel
+	//
+	// NOTE: FMA isn't used here on purpose (see the note in Simd.h)
+
+	assert(spheresIn.cx && spheresIn.cy && spheresIn.cz && spheresIn.radius);
+	assert(spheresOut.cx && spheresOut.cy && spheresOut.cz && spheresOut.radius);
+	assert(num >= 0);
+
+	__m256 mat[4][3];
+
+	for (int r = 0; r < 4; r++)
+		for (int c = 0; c < 3; c++)
+			mat[r][c] = _mm256_set1_ps(m.M[r][c]);
+
+	// the scale of the radius is the same for all the spheres
+	const __m256 scale = _mm256_set1_ps(Sphere_Radius_Scale(m));
+
+	int i = 0;
+
+	for (; i + 8 <= num; i += 8)
+	{
+		const __m256 cx = _mm256_loadu_ps(spheresIn.cx + i);
+		const __m256 cy = _mm256_loadu_ps(spheresIn.cy + i);
+		const __m256 cz = _mm256_loadu_ps(spheresIn.cz + i);
+		const __m256 r = _mm256_loadu_ps(spheresIn.radius + i);
+
+		__m256 res[3];
+
+		for (int j = 0; j < 3; j++)
+		{
+			res[j] = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(cx, mat[0][j]), _mm256_mul_ps(cy, mat[1][j])),
+				_mm256_mul_ps(cz, mat[2][j])), mat[3][j]);
+		}
+
+		_mm256_storeu_ps(spheresOut.cx + i, res[0]);
+		_mm256_storeu_ps(spheresOut.cy + i, res[1]);
+		_mm256_storeu_ps(spheresOut.cz + i, res[2]);
+		_mm256_storeu_ps(spheresOut.radius + i, _mm256_mul_ps(r, scale));
+	}
+
+	// process the rest of spheres
+	SPHERE3D_SOA restIn = spheresIn;
+	SPHERE3D_SOA_OUT restOut = spheresOut;
+
+	restIn.cx += i;  restIn.cy += i;  restIn.cz += i;  restIn.radius += i;
+	restOut.cx += i; restOut.cy += i; restOut.cz += i; restOut.radius += i;
+
+	SPHERE3D_Transform_Batch_SSE(restIn, m, restOut, num - i);
+
+} // end SPHERE3D_Transform_Batch_AVX2
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_SSE41
+void SPHERE3D_Merge_Batch_SSE(const SPHERE3D_SOA & a, const SPHERE3D_SOA & b, const SPHERE3D_SOA_OUT & merged, const int num)
+{
+	// merges num pairs of spheres; processes 4 pairs per iteration;
+	// the tail (num % 4 pairs) is processed by the scalar kernel
+	//
+	// the branches of SPHERE3D_Merge are replaced by blends: the touching sphere is
+	// computed for each pair (it is NaN if the centers are the same, but then one
+	// of the spheres contains the other one and the NaN is blended away)
+
+	assert(a.cx && a.cy && a.cz && a.radius);
+	assert(b.cx && b.cy && b.cz && b.radius);
+	assert(merged.cx && merged.cy && merged.cz && merged.radius);
+	assert(num >= 0);
+
+	const __m128 half = _mm_set1_ps(0.5f);
+
+	int i = 0;
+
+	for (; i + 4 <= num; i += 4)
+	{
+		const __m128 ax = _mm_loadu_ps(a.cx + i);
+		const __m128 ay = _mm_loadu_ps(a.cy + i);
+		const __m128 az = _mm_loadu_ps(a.cz + i);
+		const __m128 ar = _mm_loadu_ps(a.radius + i);
+		const __m128 bx = _mm_loadu_ps(b.cx + i);
+		const __m128 by = _mm_loadu_ps(b.cy + i);
+		const __m128 bz = _mm_loadu_ps(b.cz + i);
+		const __m128 br = _mm_loadu_ps(b.radius + i);
+
+		const __m128 abx = _mm_sub_ps(bx, ax);
+		const __m128 aby = _mm_sub_ps(by, ay);
+		const __m128 abz = _mm_sub_ps(bz, az);
+		const __m128 dist = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(abx, abx), _mm_mul_ps(aby, aby)), _mm_mul_ps(abz, abz)));
+
+		const __m128 aContainsB = _mm_cmple_ps(_mm_add_ps(dist, br), ar);
+		const __m128 bContainsA = _mm_cmple_ps(_mm_add_ps(dist, ar), br);
+
+		const __m128 radius = _mm_mul_ps(_mm_add_ps(_mm_add_ps(dist, ar), br), half);
+		const __m128 k = _mm_div_ps(_mm_sub_ps(radius, ar), dist);
+
+		__m128 mx = _mm_add_ps(ax, _mm_mul_ps(abx, k));
+		__m128 my = _mm_add_ps(ay, _mm_mul_ps(aby, k));
+		__m128 mz = _mm_add_ps(az, _mm_mul_ps(abz, k));
+		__m128 mr = radius;
+
+		mx = _mm_blendv_ps(_mm_blendv_ps(mx, bx, bContainsA), ax, aContainsB);
+		my = _mm_blendv_ps(_mm_blendv_ps(my, by, bContainsA), ay, aContainsB);
+		mz = _mm_blendv_ps(_mm_blendv_ps(mz, bz, bContainsA), az, aContainsB);
+		mr = _mm_blendv_ps(_mm_blendv_ps(mr, br, bContainsA), ar, aContainsB);
+
+		_mm_storeu_ps(merged.cx + i, mx);
+		_mm_storeu_ps(merged.cy + i, my);
+		_mm_storeu_ps(merged.cz + i, mz);
+		_mm_storeu_ps(merged.radius + i, mr);
+	}
+
+	// process the rest of pairs
+	SPHERE3D_SOA restA = a;
+	SPHERE3D_SOA restB = b;
+	SPHERE3D_SOA_OUT restMerged = merged;
+
+	restA.cx += i;      restA.cy += i;      restA.cz += i;      restA.radius += i;
+	restB.cx += i;      restB.cy += i;      restB.cz += i;      restB.radius += i;
+	restMerged.cx += i; restMerged.cy += i; restMerged.cz += i; restMerged.radius += i;
+
+	SPHERE3D_Merge_Batch_Scalar(restA, restB, restMerged, num - i);
+
+} // end SPHERE3D_Merge_Batch_SSE
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_AVX2
+void SPHERE3D_Merge_Batch_AVX2(const SPHERE3D_SOA & a, const SPHERE3D_SOA & b, const SPHERE3D_SOA_OUT & merged, const int num)
+{
+	// merges num pairs of spheres; processes 8 pairs per iteration;
+	// the tail (num % 8 pairs) is processed by the SSE kernel
+
+	assert(a.cx && a.cy && a.cz && a.radius);
+	assert(b.cx && b.cy && b.cz && b.radius);
+	assert(merged.cx && merged.cy && merged.cz && merged.radius);
+	assert(num >= 0);
+
+	const __m256 half = _mm256_set1_ps(0.5f);
+
+	int i = 0;
+
+	for (; i + 8 <= num; i += 8)
+	{
+		const __m256 ax = _mm256_loadu_ps(a.cx + i);
+		const __m256 ay = _mm256_loadu_ps(a.cy + i);
+		const __m256 az = _mm256_loadu_ps(a.cz + i);
+		const __m256 ar = _mm256_loadu_ps(a.radius + i);
+		const __m256 bx = _mm256_loadu_ps(b.cx + i);
+		const __m256 by = _mm256_loadu_ps(b.cy + i);
+		const __m256 bz = _mm256_loadu_ps(b.cz + i);
+		const __m256 br = _mm256_loadu_ps(b.radius + i);
+
+		const __m256 abx = _mm256_sub_ps(bx, ax);
+		const __m256 aby = _mm256_sub_ps(by, ay);
+		const __m256 abz = _mm256_sub_ps(bz, az);
+		const __m256 dist = _mm256_sqrt_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(abx, abx), _mm256_mul_ps(aby, aby)), _mm256_mul_ps(abz, abz)));
+
+		const __m256 aContainsB = _mm256_cmp_ps(_mm256_add_ps(dist, br), ar, _CMP_LE_OQ);
+		const __m256 bContainsA = _mm256_cmp_ps(_mm256_add_ps(dist, ar), br, _CMP_LE_OQ);
+
+		const __m256 radius = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(dist, ar), br), half);
+		const __m256 k = _mm256_div_ps(_mm256_sub_ps(radius, ar), dist);
+
+		__m256 mx = _mm256_add_ps(ax, _mm256_mul_ps(abx, k));
+		__m256 my = _mm256_add_ps(ay, _mm256_mul_ps(aby, k));
+		__m256 mz = _mm256_add_ps(az, _mm256_mul_ps(abz, k));
+		__m256 mr = radius;
+
+		mx = _mm256_blendv_ps(_mm256_blendv_ps(mx, bx, bContainsA), ax, aContainsB);
+		my = _mm256_blendv_ps(_mm256_blendv_ps(my, by, bContainsA), ay, aContainsB);
+		mz = _mm256_blendv_ps(_mm256_blendv_ps(mz, bz, bContainsA), az, aContainsB);
+		mr = _mm256_blendv_ps(_mm256_blendv_ps(mr, br, bContainsA), ar, aContainsB);
+
+		_mm256_storeu_ps(merged.cx + i, mx);
+		_mm256_storeu_ps(merged.cy + i, my);
+		_mm256_storeu_ps(merged.cz + i, mz);
+		_mm256_storeu_ps(merged.radius + i, mr);
+	}
+
+	// process the rest of pairs
+	SPHERE3D_SOA restA = a;
+	SPHERE3D_SOA restB = b;
+	SPHERE3D_SOA_OUT restMerged = merged;
+
+	restA.cx += i;      restA.cy += i;      restA.cz += i;      restA.radius += i;
+	restB.cx += i;      restB.cy += i;      restB.cz += i;      restB.radius += i;
+	restMerged.cx += i; restMerged.cy += i; restMerged.cz += i; restMerged.radius += i;
+
+	SPHERE3D_Merge_Batch_SSE(restA, restB, restMerged, num - i);
+
+} // end SPHERE3D_Merge_Batch_AVX2
+
+#else
+
+// there is no SIMD support for this platform so use the reference kernels
+
+void AABB3D_From_Points_SSE(AABB3D & box, const float* x, const float* y, const float* z, const int num)
+{
+	AABB3D_From_Points_Scalar(box, x, y, z, num);
+}
+
+void AABB3D_From_Points_AVX2(AABB3D & box, const float* x, const float* y, const float* z, const int num)
+{
+	AABB3D_From_Points_Scalar(box, x, y, z, num);
+}
+
+float Max_Dist2_To_Point_SSE(const float* x, const float* y, const float* z, const int num, const POINT3D & center)
+{
+	return Max_Dist2_To_Point_Scalar(x, y, z, num, center);
+}
+
+float Max_Dist2_To_Point_AVX2(const float* x, const float* y, const float* z, const int num, const POINT3D & center)
+{
+	return Max_Dist2_To_Point_Scalar(x, y, z, num, center);
+}
+
+void AABB3D_Transform_Batch_SSE(const AABB3D_SOA & boxesIn, const MATRIX4X4 & m, const AABB3D_SOA_OUT & boxesOut, const int num)
+{
+	AABB3D_Transform_Batch_Scalar(boxesIn, m, boxesOut, num);
+}
+
+void AABB3D_Transform_Batch_AVX2(const AABB3D_SOA & boxesIn, const MATRIX4X4 & m, const AABB3D_SOA_OUT & boxesOut, const int num)
+{
+	AABB3D_Transform_Batch_Scalar(boxesIn, m, boxesOut, num);
+}
+
+void AABB3D_Overlap_Batch_SSE(const AABB3D & query, const AABB3D_SOA & boxes, unsigned char* overlap, const int num)
+{
+	AABB3D_Overlap_Batch_Scalar(query, boxes, overlap, num);
+}
+
+void AABB3D_Overlap_Batch_AVX2(const AABB3D & query, const AABB3D_SOA & boxes, unsigned char* overlap, const int num)
+{
+	AABB3D_Overlap_Batch_Scalar(query, boxes, overlap, num);
+}
+
+void SPHERE3D_Overlap_Batch_SSE(const SPHERE3D & query, const SPHERE3D_SOA & spheres, unsigned char* overlap, const int num)
+{
+	SPHERE3D_Overlap_Batch_Scalar(query, spheres, overlap, num);
+}
+
+void SPHERE3D_Overlap_Batch_AVX2(const SPHERE3D & query, const SPHERE3D_SOA & spheres, unsigned char* overlap, const int num)
+{
+	SPHERE3D_Overlap_Batch_Scalar(query, spheres, overlap, num);
+}
+
+void AABB3D_SPHERE3D_Overlap_Batch_SSE(const SPHERE3D & query, const AABB3D_SOA & boxes, unsigned char* overlap, const int num)
+{
+	AABB3D_SPHERE3D_Overlap_Batch_Scalar(query, boxes, overlap, num);
+}
+
+void AABB3D_SPHERE3D_Overlap_Batch_AVX2(const SPHERE3D & query, const AABB3D_SOA & boxes, unsigned char* overlap, const int num)
+{
+	AABB3D_SPHERE3D_Overlap_Batch_Scalar(query, boxes, overlap, num);
+}
+
+void SPHERE3D_Transform_Batch_SSE(const SPHERE3D_SOA & spheresIn, const MATRIX4X4 & m, const SPHERE3D_SOA_OUT & spheresOut, const int num)
+{
+	SPHERE3D_Transform_Batch_Scalar(spheresIn, m, spheresOut, num);
+}
+
+void SPHERE3D_Transform_Batch_AVX2(const SPHERE3D_SOA & spheresIn, const MATRIX4X4 & m, const SPHERE3D_SOA_OUT & spheresOut, const int num)
+{
+	SPHERE3D_Transform_Batch_Scalar(spheresIn, m, spheresOut, num);
+}
+
+void SPHERE3D_Merge_Batch_SSE(const SPHERE3D_SOA & a, const SPHERE3D_SOA & b, const SPHERE3D_SOA_OUT & merged, const int num)
+{
+	SPHERE3D_Merge_Batch_Scalar(a, b, merged, num);
+}
+
+void SPHERE3D_Merge_Batch_AVX2(const SPHERE3D_SOA & a, const SPHERE3D_SOA & b, const SPHERE3D_SOA_OUT & merged, const int num)
+{
+	SPHERE3D_Merge_Batch_Scalar(a, b, merged, num);
+}
+
+#endif // MATHLIB_SIMD_X86
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                    DISPATCHING
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void AABB3D_From_Points(AABB3D & box, const float* x, const float* y, const float* z, const int num)
+{
+	// computes the box of num points using the best kernel for the current CPU
+
+	switch (SIMD_Get_Level())
+	{
+		case SIMD_LEVEL_AVX2:
+			AABB3D_From_Points_AVX2(box, x, y, z, num);
+			break;
+
+		case SIMD_LEVEL_AVX:
+		case SIMD_LEVEL_SSE:
+			AABB3D_From_Points_SSE(box, x, y, z, num);
+			break;
+
+		default:
+			AABB3D_From_Points_Scalar(box, x, y, z, num);
+	}
+
+} // end AABB3D_From_Points
+
+///////////////////////////////////////////////////////////
+
+float Max_Dist2_To_Point(const float* x, const float* y, const float* z, const int num, const POINT3D & center)
+{
+	// computes the maximal squared distance using the best kernel for the current CPU
+
+	switch (SIMD_Get_Level())
+	{
+		case SIMD_LEVEL_AVX2:
+			return Max_Dist2_To_Point_AVX2(x, y, z, num, center);
+
+		case SIMD_LEVEL_AVX:
+		case SIMD_LEVEL_SSE:
+			return Max_Dist2_To_Point_SSE(x, y, z, num, center);
+
+		default:
+			return Max_Dist2_To_Point_Scalar(x, y, z, num, center);
+	}
+
+} // end Max_Dist2_To_Point
+
+///////////////////////////////////////////////////////////
+
+void AABB3D_Transform_Batch(const AABB3D_SOA & boxesIn, const MATRIX4X4 & m, const AABB3D_SOA_OUT & boxesOut, const int num)
+{
+	// transforms num boxes using the best kernel for the current CPU
+
+	switch (SIMD_Get_Level())
+	{
+		case SIMD_LEVEL_AVX2:
+			AABB3D_Transform_Batch_AVX2(boxesIn, m, boxesOut, num);
+			break;
+
+		case SIMD_LEVEL_AVX:
+		case SIMD_LEVEL_SSE:
+			AABB3D_Transform_Batch_SSE(boxesIn, m, boxesOut, num);
+			break;
+
+		default:
+			AABB3D_Transform_Batch_Scalar(boxesIn, m, boxesOut, num);
+	}
+
+} // end AABB3D_Transform_Batch
+
+///////////////////////////////////////////////////////////
+
+void AABB3D_Overlap_Batch(const AABB3D & query, const AABB3D_SOA & boxes, unsigned char* overlap, const int num)
+{
+	// tests num boxes using the best kernel for the current CPU
+
+	switch (SIMD_Get_Level())
+	{
+		case SIMD_LEVEL_AVX2:
+			AABB3D_Overlap_Batch_AVX2(query, boxes, overlap, num);
+			break;
+
+		case SIMD_LEVEL_AVX:
+		case SIMD_LEVEL_SSE:
+			AABB3D_Overlap_Batch_SSE(query, boxes, overlap, num);
+			break;
+
+		default:
+			AABB3D_Overlap_Batch_Scalar(query, boxes, overlap, num);
+	}
+
+} // end AABB3D_Overlap_Batch
+
+///////////////////////////////////////////////////////////
+
+void SPHERE3D_Overlap_Batch(const SPHERE3D & query, const SPHERE3D_SOA & spheres, unsigned char* overlap, const int num)
+{
+	// tests num spheres using the best kernel for the current CPU
+
+	switch (SIMD_Get_Level())
+	{
+		case SIMD_LEVEL_AVX2:
+			SPHERE3D_Overlap_Batch_AVX2(query, spheres, overlap, num);
+			break;
+
+		case SIMD_LEVEL_AVX:
+		case SIMD_LEVEL_SSE:
+			SPHERE3D_Overlap_Batch_SSE(query, spheres, overlap, num);
+			break;
+
+		default:
+			SPHERE3D_Overlap_Batch_Scalar(query, spheres, overlap, num);
+	}
+
+} // end SPHERE3D_Overlap_Batch
+
+///////////////////////////////////////////////////////////
+
+void AABB3D_SPHERE3D_Overlap_Batch(const SPHERE3D & query, const AABB3D_SOA & boxes, unsigned char* overlap, const int num)
+{
+	// tests num boxes against the sphere using the best kernel for the current CPU
+
+	switch (SIMD_Get_Level())
+	{
+		case SIMD_LEVEL_AVX2:
+			AABB3D_SPHERE3D_Overlap_Batch_AVX2(query, boxes, overlap, num);
+			break;
+
+		case SIMD_LEVEL_AVX:
+		case SIMD_LEVEL_SSE:
+			AABB3D_SPHERE3D_Overlap_Batch_SSE(query, boxes, overlap, num);
+			break;
+
+		default:
+			AABB3D_SPHERE3D_Overlap_Batch_Scalar(query, boxes, overlap, num);
+	}
+
+} // end AABB3D_SPHERE3D_Overlap_Batch
+
+///////////////////////////////////////////////////////////
+
+void SPHERE3D_Transform_Batch(const SPHERE3D_SOA & spheresIn, const MATRIX4X4 & m, const SPHERE3D_SOA_OUT & spheresOut, const int num)
+{
+	// transforms num spheres using the best kernel for the current CPU
+
+	switch (SIMD_Get_Level())
+	{
+		case SIMD_LEVEL_AVX2:
+			SPHERE3D_Transform_Batch_AVX2(spheresIn, m, spheresOut, num);
+			break;
+
+		case SIMD_LEVEL_AVX:
+		case SIMD_LEVEL_SSE:
+			SPHERE3D_Transform_Batch_SSE(spheresIn, m, spheresOut, num);
+			break;
+
+		default:
+			SPHERE3D_Transform_Batch_Scalar(spheresIn, m, spheresOut, num);
+	}
+
+} // end SPHERE3D_Transform_Batch
+
+///////////////////////////////////////////////////////////
+
+void SPHERE3D_Merge_Batch(const SPHERE3D_SOA & a, const SPHERE3D_SOA & b, const SPHERE3D_SOA_OUT & merged, const int num)
+{
+	// merges num pairs of spheres using the best kernel for the current CPU
+
+	switch (SIMD_Get_Level())
+	{
+		case SIMD_LEVEL_AVX2:
+			SPHERE3D_Merge_Batch_AVX2(a, b, merged, num);
+			break;
+
+		case SIMD_LEVEL_AVX:
+		case SIMD_LEVEL_SSE:
+			SPHERE3D_Merge_Batch_SSE(a, b, merged, num);
+			break;
+
+		default:
+			SPHERE3D_Merge_Batch_Scalar(a, b, merged, num);
+	}
+
+} // end SPHERE3D_Merge_Batch
+
+} // end namespace MathLib
@@ -0,0 +1,221 @@
+////////////////////////////////////////////////////////////////////////////////////////////
+// Filename:      BoundingVolumes.h
+// Description:   contains functional for bounding volumes: axis-aligned bounding
+//                boxes (AABB3D) and bounding spheres (SPHERE3D): building from points,
+//                merging, transformation and overlap tests; also there are batch
+//                versions over SoA arrays (scalar, SSE and AVX2 kernels)
+//
+// Created:       17.10.26
+////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "Figures.h"
+
+
+namespace MathLib
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                 DATA STRUCTURES
+////////////////////////////////////////////////////////////////////////////////////////////
+
+// 3D axis-aligned bounding box;
+// an empty box has pMin = +FLT_MAX and pMax = -FLT_MAX (see AABB3D_Init_Empty),
+// so merging with it doesn't change another box
+typedef struct AABB3D_TYPE
+{
+	AABB3D_TYPE()
+	{
+	}
+
+	AABB3D_TYPE(const POINT3D & boxMin, const POINT3D & boxMax) :
+		pMin(boxMin),
+		pMax(boxMax)
+	{
+	}
+
+	POINT3D pMin;   // minimal coordinates
+	POINT3D pMax;   // maximal coordinates
+} AABB3D, *AABB3D_PTR;
+
+
+// 3D bounding sphere
+typedef struct SPHERE3D_TYPE
+{
+	SPHERE3D_TYPE()
+	{
+	}
+
+	SPHERE3D_TYPE(const POINT3D & c, const float r) :
+		center(c),
+		radius(r)
+	{
+	}
+
+	POINT3D center;
+	float radius = 0.0f;
+} SPHERE3D, *SPHERE3D_PTR;
+
+
+// arrays of boxes/spheres in SoA form (input views)
+typedef struct AABB3D_SOA_TYPE
+{
+	const float* minX = nullptr;
+	const float* minY = nullptr;
+	const float* minZ = nullptr;
+	const float* maxX = nullptr;
+	const float* maxY = nullptr;
+	const float* maxZ = nullptr;
+} AABB3D_SOA, *AABB3D_SOA_PTR;
+
+typedef struct SPHERE3D_SOA_TYPE
+{
+	const float* cx = nullptr;
+	const float* cy = nullptr;
+	const float* cz = nullptr;
+	const float* radius = nullptr;
+} SPHERE3D_SOA, *SPHERE3D_SOA_PTR;
+
+// the same arrays as output views (for the results of the batch functions);
+// they convert to the input views
+typedef struct AABB3D_SOA_OUT_TYPE
+{
+	float* minX = nullptr;
+	float* minY = nullptr;
+	float* minZ = nullptr;
+	float* maxX = nullptr;
+	float* maxY = nullptr;
+	float* maxZ = nullptr;
+
+	operator AABB3D_SOA() const
+	{
+		AABB3D_SOA soa;
+
+		soa.minX = minX;  soa.minY = minY;  soa.minZ = minZ;
+		soa.maxX = maxX;  soa.maxY = maxY;  soa.maxZ = maxZ;
+
+		return soa;
+	}
+} AABB3D_SOA_OUT, *AABB3D_SOA_OUT_PTR;
+
+typedef struct SPHERE3D_SOA_OUT_TYPE
+{
+	float* cx = nullptr;
+	float* cy = nullptr;
+	float* cz = nullptr;
+	float* radius = nullptr;
+
+	operator SPHERE3D_SOA() const
+	{
+		SPHERE3D_SOA soa;
+
+		soa.cx = cx;  soa.cy = cy;  soa.cz = cz;  soa.radius = radius;
+
+		return soa;
+	}
+} SPHERE3D_SOA_OUT, *SPHERE3D_SOA_OUT_PTR;
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                          FUNCTIONS FOR SINGLE VOLUMES
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void AABB3D_Init_Empty(AABB3D & box);
+
+// build the smallest box of num points (SoA or an array of points); the SoA version
+// is computed by a SIMD min/max reduction (see the kernels below); the box of 0 points is empty
+void AABB3D_From_Points(AABB3D & box, const float* x, const float* y, const float* z, const int num);
+void AABB3D_From_POINT3D_Array(AABB3D & box, const POINT3D* points, const int num);
+
+// the center of the box of the points and the distance to the farthest point
+// (isn't the minimal sphere but it is computed in two SIMD passes)
+void SPHERE3D_From_Points(SPHERE3D & sphere, const float* x, const float* y, const float* z, const int num);
+
+void AABB3D_Merge(const AABB3D & a, const AABB3D & b, AABB3D & merged);
+void SPHERE3D_Merge(const SPHERE3D & a, const SPHERE3D & b, SPHERE3D & merged);
+
+// transform the box by the matrix (the row-vector convention, w = 1) and compute the
+// box of the result by Arvo's method (the box isn't larger than needed for the 8 corners)
+void AABB3D_Transform(const AABB3D & box, const MATRIX4X4 & m, AABB3D & boxOut);
+
+// transform the center; the radius is scaled by the maximal scale of the matrix rows
+void SPHERE3D_Transform(const SPHERE3D & sphere, const MATRIX4X4 & m, SPHERE3D & sphereOut);
+
+// overlap tests (touching volumes overlap): return 1 if the volumes overlap, and 0 if not
+int AABB3D_Overlap(const AABB3D & a, const AABB3D & b);
+int SPHERE3D_Overlap(const SPHERE3D & a, const SPHERE3D & b);
+int AABB3D_SPHERE3D_Overlap(const AABB3D & box, const SPHERE3D & sphere);
+
+int AABB3D_Contains_Point(const AABB3D & box, const POINT3D & pt);
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                 BATCH FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+//
+// the results are the same for each kernel (min/max and the sums are computed in
+// the same order as in the single functions); the coordinates must not be NaN;
+// output arrays may be the same as the input arrays (in-place computation)
+//
+// the functions without a suffix choose the best kernel for the current CPU (see SIMD_Get_Level)
+//
+
+// the maximal squared distance from num points to the center (0 for 0 points)
+float Max_Dist2_To_Point(const float* x, const float* y, const float* z, const int num, const POINT3D & center);
+
+// boxesOut[i] = transformed boxesIn[i] (Arvo's method)
+void AABB3D_Transform_Batch(const AABB3D_SOA & boxesIn, const MATRIX4X4 & m, const AABB3D_SOA_OUT & boxesOut, const int num);
+
+// spheresOut[i] = transformed spheresIn[i] (see SPHERE3D_Transform)
+void SPHERE3D_Transform_Batch(const SPHERE3D_SOA & spheresIn, const MATRIX4X4 & m, const SPHERE3D_SOA_OUT & spheresOut, const int num);
+
+// merged[i] = merge of a[i] and b[i] (a plain loop which is vectorized by the compiler)
+void AABB3D_Merge_Batch(const AABB3D_SOA & a, const AABB3D_SOA & b, const AABB3D_SOA_OUT & merged, const int num);
+
+// merged[i] = merge of a[i] and b[i] (see SPHERE3D_Merge)
+void SPHERE3D_Merge_Batch(const SPHERE3D_SOA & a, const SPHERE3D_SOA & b, const SPHERE3D_SOA_OUT & merged, const int num);
+
+// overlap[i] = 1 if the query volume overlaps the volume i, or 0 in another case
+void AABB3D_Overlap_Batch(const AABB3D & query, const AABB3D_SOA & boxes, unsigned char* overlap, const int num);
+void SPHERE3D_Overlap_Batch(const SPHERE3D & query, const SPHERE3D_SOA & spheres, unsigned char* overlap, const int num);
+void AABB3D_SPHERE3D_Overlap_Batch(const SPHERE3D & query, const AABB3D_SOA & boxes, unsigned char* overlap, const int num);
+
+// separate kernels (SSE/AVX2 kernels must be called only if the CPU supports them)
+void AABB3D_From_Points_Scalar(AABB3D & box, const float* x, const float* y, const float* z, const int num);
+void AABB3D_From_Points_SSE   (AABB3D & box, const float* x, const float* y, const float* z, const int num);
+void AABB3D_From_Points_AVX2  (AABB3D & box, const float* x, const float* y, const float* z, const int num);
+
+float Max_Dist2_To_Point_Scalar(const float* x, const float* y, const float* z, const int num, const POINT3D & center);
+float Max_Dist2_To_Point_SSE   (const float* x, const float* y, const float* z, const int num, const POINT3D & center);
+float Max_Dist2_To_Point_AVX2  (const float* x, const float* y, const float* z, const int num, const POINT3D & center);
+
+void AABB3D_Transform_Batch_Scalar(const AABB3D_SOA & boxesIn, const MATRIX4X4 & m, const AABB3D_SOA_OUT & boxesOut, const int num);
+void AABB3D_Transform_Batch_SSE   (const AABB3D_SOA & boxesIn, const MATRIX4X4 & m, const AABB3D_SOA_OUT & boxesOut, const int num);
+void AABB3D_Transform_Batch_AVX2  (const AABB3D_SOA & boxesIn, const MATRIX4X4 & m, const AABB3D_SOA_OUT & boxesOut, const int num);
+
+void AABB3D_Overlap_Batch_Scalar(const AABB3D & query, const AABB3D_SOA & boxes, unsigned char* overlap, const int num);
+void AABB3D_Overlap_Batch_SSE   (const AABB3D & query, const AABB3D_SOA & boxes, unsigned char* overlap, const int num);
+void AABB3D_Overlap_Batch_AVX2  (const AABB3D & query, const AABB3D_SOA & boxes, unsigned char* overlap, const int num);
+
+void SPHERE3D_Overlap_Batch_Scalar(const SPHERE3D & query, const SPHERE3D_SOA & spheres, unsigned char* overlap, const int num);
+void SPHERE3D_Overlap_Batch_SSE   (const SPHERE3D & query, const SPHERE3D_SOA & spheres, unsigned char* overlap, const int num);
+void SPHERE3D_Overlap_Batch_AVX2  (const SPHERE3D & query, const SPHERE3D_SOA & spheres, unsigned char* overlap, const int num);
+
+void SPHERE3D_Transform_Batch_Scalar(const SPHERE3D_SOA & spheresIn, const MATRIX4X4 & m, const SPHERE3D_SOA_OUT & spheresOut, const int num);
+void SPHERE3D_Transform_Batch_SSE   (const SPHERE3D_SOA & spheresIn, const MATRIX4X4 & m, const SPHERE3D_SOA_OUT & spheresOut, const int num);
+void SPHERE3D_Transform_Batch_AVX2  (const SPHERE3D_SOA & spheresIn, const MATRIX4X4 & m, const SPHERE3D_SOA_OUT & spheresOut, const int num);
+
+void SPHERE3D_Merge_Batch_Scalar(const SPHERE3D_SOA & a, const SPHERE3D_SOA & b, const SPHERE3D_SOA_OUT & merged, const int num);
+void SPHERE3D_Merge_Batch_SSE   (const SPHERE3D_SOA & a, const SPHERE3D_SOA & b, const SPHERE3D_SOA_OUT & merged, const int num);
+void SPHERE3D_Merge_Batch_AVX2  (const SPHERE3D_SOA & a, const SPHERE3D_SOA & b, const SPHERE3D_SOA_OUT & merged, const int num);
+
+void AABB3D_SPHERE3D_Overlap_Batch_Scalar(const SPHERE3D & query, const AABB3D_SOA & boxes, unsigned char* overlap, const int num);
+void AABB3D_SPHERE3D_Overlap_Batch_SSE   (const SPHERE3D & query, const AABB3D_SOA & boxes, unsigned char* overlap, const int num);
+void AABB3D_SPHERE3D_Overlap_Batch_AVX2  (const SPHERE3D & query, const AABB3D_SOA & boxes, unsigned char* overlap, const int num);
+
+} // end namespace MathLib
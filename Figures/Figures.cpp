@@ -182,15 +182,15 @@ void PLANE3D_Init(PLANE3D & plane,
 {
 	// this function initializes a plane using a 3D point and a normal vector.
 	// Additionally the function normalizes the normal vector if it is necessary;
-	// for that set a normalize parameter to TRUE. Such normalization is needed 
+	// for that set a normalize parameter to 1. Such normalization is needed 
 	// during a work with some algorithms
 
 	// copy the point and initialize the normal vector
 	POINT3D_COPY(plane.p0, p0);
 	VECTOR3D_INIT(plane.n, normal);
 
-	// if normalize is TRUE then the normal is made into a unit vector
-	if (normalize == TRUE)
+	// if normalize is 1 then the normal is made into a unit vector
+	if (normalize == 1)
 	{
 		VECTOR3D_Normalize(plane.n);
 	}
@@ -1,7 +1,7 @@
 ////////////////////////////////////////////////////////////////////////////////////////////
 // Filename:      Figures.h
 // Description:   contains definitions for geometric figures:
-//                parametric lines, 3D planes, etc.
+//                parametric lines, 3D planes, 3D triangles, etc.
 //
 // Created:       13.09.23
 ////////////////////////////////////////////////////////////////////////////////////////////
@@ -91,6 +91,33 @@ typedef struct PLANE3D_TYPE
 
 
 
+////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                  3D TRIANGLES
+//
+////////////////////////////////////////////////////////////////////////////////////////////
+
+// 3D triangle (the functions for triangles are in Triangles.h)
+typedef struct TRIANGLE3D_TYPE
+{
+	TRIANGLE3D_TYPE()
+	{
+	}
+
+	TRIANGLE3D_TYPE(const POINT3D & v0, const POINT3D & v1, const POINT3D & v2) :
+		p0(v0),
+		p1(v1),
+		p2(v2)
+	{
+	}
+
+	POINT3D p0;   // vertices
+	POINT3D p1;
+	POINT3D p2;
+} TRIANGLE3D, *TRIANGLE3D_PTR;
+
+
+
 
 
 
@@ -0,0 +1,353 @@
+////////////////////////////////////////////////////////////////////////////////////////////
+// Filename:      FiguresBatch.cpp
+// Description:   contains implementation of batch intersection of 3D parametric lines
+//                with 3D planes (scalar, SSE and AVX2 kernels + runtime dispatching)
+//
+// Created:       17.10.26
+////////////////////////////////////////////////////////////////////////////////////////////
+#include "FiguresBatch.h"
+#include "../Utils/Simd.h"
+
+#include <cassert>
+#include <cstring>
+
+
+namespace MathLib
+{
+
+//
+// NOTE: all the kernels use the same order of operations for line i and plane (n, d):
+//
+//   dot  = ((n.x * v.x) + (n.y * v.y)) + (n.z * v.z)
+//   dist = (((n.x * p0.x) + (n.y * p0.y)) + (n.z * p0.z)) + d
+//
+//   if |dot| <= EPSILON_E5:  the line is parallel to the plane: t = 0,
+//                            code = (|dist| <= EPSILON_E5) ? EVERYWHERE : NO_INTERSECT
+//   else:                    t = -dist / dot,
+//                            code = (0 <= t <= 1) ? IN_SEGMENT : OUT_SEGMENT
+//
+// the kernels process lines of one plane per pass so the plane stays in registers;
+// a pass over a plane is done by a helper with the same tail handling as other
+// batch kernels (AVX2 -> SSE -> scalar)
+//
+
+void PLANE3D_To_SOA(const PLANE3D & plane, float* nx, float* ny, float* nz, float* d, const int index)
+{
+	// this function stores the plane in the form of (n * p) + d = 0
+
+	assert(nx && ny && nz && d);
+	assert(index >= 0);
+
+	nx[index] = plane.n.x;
+	ny[index] = plane.n.y;
+	nz[index] = plane.n.z;
+	d[index] = -(((plane.n.x * plane.p0.x) + (plane.n.y * plane.p0.y)) + (plane.n.z * plane.p0.z));
+
+} // end PLANE3D_To_SOA
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                        ONE PLANE PASS (HELPERS OF THE KERNELS)
+////////////////////////////////////////////////////////////////////////////////////////////
+
+static void Intersect_Lines_Plane_Scalar(const PARAMLINE3D_SOA & lines,
+	const int start,
+	const int end,
+	const float nx, const float ny, const float nz, const float d,
+	float* t,
+	unsigned char* codes)
+{
+	// intersects lines [start, end) with the plane using plain C++ code (reference)
+
+	for (int i = start; i < end; i++)
+	{
+		const float dot = ((nx * lines.vx[i]) + (ny * lines.vy[i])) + (nz * lines.vz[i]);
+		const float dist = (((nx * lines.p0x[i]) + (ny * lines.p0y[i])) + (nz * lines.p0z[i])) + d;
+
+		if (fabsf(dot) <= EPSILON_E5)
+		{
+			// the line is parallel to the plane. Does it coincide with this plane?
+			t[i] = 0.0f;
+			codes[i] = (fabsf(dist) <= EPSILON_E5) ? PARAM_LINE_INTERSECT_EVERYWHERE : PARAM_LINE_NO_INTERSECT;
+		}
+		else
+		{
+			const float ti = -dist / dot;
+
+			t[i] = ti;
+			codes[i] = ((ti >= 0.0f) && (ti <= 1.0f)) ? PARAM_LINE_INTERSECT_IN_SEGMENT : PARAM_LINE_INTERSECT_OUT_SEGMENT;
+		}
+	}
+
+} // end Intersect_Lines_Plane_Scalar
+
+///////////////////////////////////////////////////////////
+
+#if MATHLIB_SIMD_X86
+
+MATHLIB_TARGET_SSE41
+static void Intersect_Lines_Plane_SSE(const PARAMLINE3D_SOA & lines,
+	const int start,
+	const int end,
+	const float planeNx, const float planeNy, const float planeNz, const float planeD,
+	float* t,
+	unsigned char* codes)
+{
+	// intersects lines [start, end) with the plane; processes 4 lines per iteration;
+	// the tail is processed by the scalar helper
+
+	const __m128 signMask = _mm_set1_ps(-0.0f);
+	const __m128 eps = _mm_set1_ps(EPSILON_E5);
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128i codeOutSegment = _mm_set1_epi32(PARAM_LINE_INTERSECT_OUT_SEGMENT);
+	const __m128i codeEverywhere = _mm_set1_epi32(PARAM_LINE_INTERSECT_EVERYWHERE);
+	const __m128i codeDiff = _mm_set1_epi32(PARAM_LINE_INTERSECT_OUT_SEGMENT - PARAM_LINE_INTERSECT_IN_SEGMENT);
+
+	const __m128 nx = _mm_set1_ps(planeNx);
+	const __m128 ny = _mm_set1_ps(planeNy);
+	const __m128 nz = _mm_set1_ps(planeNz);
+	const __m128 d = _mm_set1_ps(planeD);
+
+	int i = start;
+
+	for (; i + 4 <= end; i += 4)
+	{
+		const __m128 dot = _mm_add_ps(_mm_add_ps(
+			_mm_mul_ps(nx, _mm_loadu_ps(lines.vx + i)),
+			_mm_mul_ps(ny, _mm_loadu_ps(lines.vy + i))),
+			_mm_mul_ps(nz, _mm_loadu_ps(lines.vz + i)));
+
+		const __m128 dist = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+			_mm_mul_ps(nx, _mm_loadu_ps(lines.p0x + i)),
+			_mm_mul_ps(ny, _mm_loadu_ps(lines.p0y + i))),
+			_mm_mul_ps(nz, _mm_loadu_ps(lines.p0z + i))),
+			d);
+
+		const __m128 parallel = _mm_cmple_ps(_mm_andnot_ps(signMask, dot), eps);
+		const __m128 coincide = _mm_cmple_ps(_mm_andnot_ps(signMask, dist), eps);
+
+		// t = -dist / dot (the division of parallel lines is discarded by the mask)
+		const __m128 ti = _mm_div_ps(_mm_xor_ps(dist, signMask), dot);
+		const __m128 inSegment = _mm_and_ps(_mm_cmpge_ps(ti, zero), _mm_cmple_ps(ti, one));
+
+		// the codes: OUT_SEGMENT - 1 (if in segment) or EVERYWHERE/NO_INTERSECT for parallel lines
+		const __m128i codeLine = _mm_sub_epi32(codeOutSegment, _mm_and_si128(_mm_castps_si128(inSegment), codeDiff));
+		const __m128i codeParallel = _mm_and_si128(_mm_castps_si128(coincide), codeEverywhere);
+		const __m128i code = _mm_castps_si128(_mm_blendv_ps(_mm_castsi128_ps(codeLine), _mm_castsi128_ps(codeParallel), parallel));
+
+		_mm_storeu_ps(t + i, _mm_andnot_ps(parallel, ti));
+
+		// pack 4 codes into 4 bytes
+		const __m128i code16 = _mm_packs_epi32(code, code);
+		const int code8 = _mm_cvtsi128_si32(_mm_packus_epi16(code16, code16));
+		memcpy(codes + i, &code8, 4);
+	}
+
+	// process the rest of lines
+	Intersect_Lines_Plane_Scalar(lines, i, end, planeNx, planeNy, planeNz, planeD, t, codes);
+
+} // end Intersect_Lines_Plane_SSE
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_AVX2
+static void Intersect_Lines_Plane_AVX2(const PARAMLINE3D_SOA & lines,
+	const int start,
+	const int end,
+	const float planeNx, const float planeNy, const float planeNz, const float planeD,
+	float* t,
+	unsigned char* codes)
+{
+	// intersects lines [start, end) with the plane; processes 8 lines per iteration;
+	// the tail is processed by the SSE helper
+	//
+	// NOTE: FMA isn't used here on purpose (see the note in Simd.h)
+
+	const __m256 signMask = _mm256_set1_ps(-0.0f);
+	const __m256 eps = _mm256_set1_ps(EPSILON_E5);
+	const __m256 zero = _mm256_setzero_ps();
+	const __m256 one = _mm256_set1_ps(1.0f);
+	const __m256i codeOutSegment = _mm256_set1_epi32(PARAM_LINE_INTERSECT_OUT_SEGMENT);
+	const __m256i codeEverywhere = _mm256_set1_epi32(PARAM_LINE_INTERSECT_EVERYWHERE);
+	const __m256i codeDiff = _mm256_set1_epi32(PARAM_LINE_INTERSECT_OUT_SEGMENT - PARAM_LINE_INTERSECT_IN_SEGMENT);
+
+	const __m256 nx = _mm256_set1_ps(planeNx);
+	const __m256 ny = _mm256_set1_ps(planeNy);
+	const __m256 nz = _mm256_set1_ps(planeNz);
+	const __m256 d = _mm256_set1_ps(planeD);
+
+	int i = start;
+
+	for (; i + 8 <= end; i += 8)
+	{
+		const __m256 dot = _mm256_add_ps(_mm256_add_ps(
+			_mm256_mul_ps(nx, _mm256_loadu_ps(lines.vx + i)),
+			_mm256_mul_ps(ny, _mm256_loadu_ps(lines.vy + i))),
+			_mm256_mul_ps(nz, _mm256_loadu_ps(lines.vz + i)));
+
+		const __m256 dist = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(
+			_mm256_mul_ps(nx, _mm256_loadu_ps(lines.p0x + i)),
+			_mm256_mul_ps(ny, _mm256_loadu_ps(lines.p0y + i))),
+			_mm256_mul_ps(nz, _mm256_loadu_ps(lines.p0z + i))),
+			d);
+
+		const __m256 parallel = _mm256_cmp_ps(_mm256_andnot_ps(signMask, dot), eps, _CMP_LE_OQ);
+		const __m256 coincide = _mm256_cmp_ps(_mm256_andnot_ps(signMask, dist), eps, _CMP_LE_OQ);
+
+		// t = -dist / dot (the division of parallel lines is discarded by the mask)
+		const __m256 ti = _mm256_div_ps(_mm256_xor_ps(dist, signMask), dot);
+		const __m256 inSegment = _mm256_and_ps(_mm256_cmp_ps(ti, zero, _CMP_GE_OQ), _mm256_cmp_ps(ti, one, _CMP_LE_OQ));
+
+		// the codes: OUT_SEGMENT - 1 (if in segment) or EVERYWHERE/NO_INTERSECT for parallel lines
+		const __m256i codeLine = _mm256_sub_epi32(codeOutSegment, _mm256_and_si256(_mm256_castps_si256(inSegment), codeDiff));
+		const __m256i codeParallel = _mm256_and_si256(_mm256_castps_si256(coincide), codeEverywhere);
+		const __m256i code = _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(codeLine), _mm256_castsi256_ps(codeParallel), parallel));
+
+		_mm256_storeu_ps(t + i, _mm256_andnot_ps(parallel, ti));
+
+		// pack 8 codes into 8 bytes
+		const __m128i code16 = _mm_packs_epi32(_mm256_castsi256_si128(code), _mm256_extracti128_si256(code, 1));
+		_mm_storel_epi64((__m128i*)(codes + i), _mm_packus_epi16(code16, code16));
+	}
+
+	// process the rest of lines
+	Intersect_Lines_Plane_SSE(lines, i, end, planeNx, planeNy, planeNz, planeD, t, codes);
+
+} // end Intersect_Lines_Plane_AVX2
+
+#endif // MATHLIB_SIMD_X86
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                       BATCH INTERSECTION OF LINES AND PLANES
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void Intersect_Param_Lines3D_Planes3D_Batch_Scalar(const PARAMLINE3D_SOA & lines, const int numLines,
+	const PLANE3D_SOA & planes, const int numPlanes,
+	float* t,
+	unsigned char* codes)
+{
+	// intersects each line with each plane using plain C++ code (reference kernel)
+
+	assert(lines.p0x && lines.p0y && lines.p0z && lines.vx && lines.vy && lines.vz);
+	assert(planes.nx && planes.ny && planes.nz && planes.d);
+	assert(t && codes);
+	assert((numLines >= 0) && (numPlanes >= 0));
+
+	for (int j = 0; j < numPlanes; j++)
+	{
+		const int row = j * numLines;
+
+		Intersect_Lines_Plane_Scalar(lines, 0, numLines,
+			planes.nx[j], planes.ny[j], planes.nz[j], planes.d[j],
+			t + row, codes + row);
+	}
+
+} // end Intersect_Param_Lines3D_Planes3D_Batch_Scalar
+
+///////////////////////////////////////////////////////////
+
+#if MATHLIB_SIMD_X86
+
+void Intersect_Param_Lines3D_Planes3D_Batch_SSE(const PARAMLINE3D_SOA & lines, const int numLines,
+	const PLANE3D_SOA & planes, const int numPlanes,
+	float* t,
+	unsigned char* codes)
+{
+	// intersects each line with each plane; processes 4 lines of a plane per iteration
+
+	assert(lines.p0x && lines.p0y && lines.p0z && lines.vx && lines.vy && lines.vz);
+	assert(planes.nx && planes.ny && planes.nz && planes.d);
+	assert(t && codes);
+	assert((numLines >= 0) && (numPlanes >= 0));
+
+	for (int j = 0; j < numPlanes; j++)
+	{
+		const int row = j * numLines;
+
+		Intersect_Lines_Plane_SSE(lines, 0, numLines,
+			planes.nx[j], planes.ny[j], planes.nz[j], planes.d[j],
+			t + row, codes + row);
+	}
+
+} // end Intersect_Param_Lines3D_Planes3D_Batch_SSE
+
+///////////////////////////////////////////////////////////
+
+void Intersect_Param_Lines3D_Planes3D_Batch_AVX2(const PARAMLINE3D_SOA & lines, const int numLines,
+	const PLANE3D_SOA & planes, const int numPlanes,
+	float* t,
+	unsigned char* codes)
+{
+	// intersects each line with each plane; processes 8 lines of a plane per iteration
+
+	assert(lines.p0x && lines.p0y && lines.p0z && lines.vx && lines.vy && lines.vz);
+	assert(planes.nx && planes.ny && planes.nz && planes.d);
+	assert(t && codes);
+	assert((numLines >= 0) && (numPlanes >= 0));
+
+	for (int j = 0; j < numPlanes; j++)
+	{
+		const int row = j * numLines;
+
+		Intersect_Lines_Plane_AVX2(lines, 0, numLines,
+			planes.nx[j], planes.ny[j], planes.nz[j], planes.d[j],
+			t + row, codes + row);
+	}
+
+} // end Intersect_Param_Lines3D_Planes3D_Batch_AVX2
+
+#else
+
+// there is no SIMD support for this platform so use the reference kernel
+
+void Intersect_Param_Lines3D_Planes3D_Batch_SSE(const PARAMLINE3D_SOA & lines, const int numLines,
+	const PLANE3D_SOA & planes, const int numPlanes,
+	float* t,
+	unsigned char* codes)
+{
+	Intersect_Param_Lines3D_Planes3D_Batch_Scalar(lines, numLines, planes, numPlanes, t, codes);
+}
+
+void Intersect_Param_Lines3D_Planes3D_Batch_AVX2(const PARAMLINE3D_SOA & lines, const int numLines,
+	const PLANE3D_SOA & planes, const int numPlanes,
+	float* t,
+	unsigned char* codes)
+{
+	Intersect_Param_Lines3D_Planes3D_Batch_Scalar(lines, numLines, planes, numPlanes, t, codes);
+}
+
+#endif // MATHLIB_SIMD_X86
+
+///////////////////////////////////////////////////////////
+
+void Intersect_Param_Lines3D_Planes3D_Batch(const PARAMLINE3D_SOA & lines, const int numLines,
+	const PLANE3D_SOA & planes, const int numPlanes,
+	float* t,
+	unsigned char* codes)
+{
+	// intersects each line with each plane using the best kernel for the current CPU
+
+	switch (SIMD_Get_Level())
+	{
+		case SIMD_LEVEL_AVX2:
+			Intersect_Param_Lines3D_Planes3D_Batch_AVX2(lines, numLines, planes, numPlanes, t, codes);
+			break;
+
+		case SIMD_LEVEL_AVX:
+		case SIMD_LEVEL_SSE:
+			Intersect_Param_Lines3D_Planes3D_Batch_SSE(lines, numLines, planes, numPlanes, t, codes);
+			break;
+
+		default:
+			Intersect_Param_Lines3D_Planes3D_Batch_Scalar(lines, numLines, planes, numPlanes, t, codes);
+	}
+
+} // end Intersect_Param_Lines3D_Planes3D_Batch
+
+} // end namespace MathLib
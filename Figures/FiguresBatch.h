@@ -0,0 +1,88 @@
+////////////////////////////////////////////////////////////////////////////////////////////
+// Filename:      FiguresBatch.h
+// Description:   contains functional for batch intersection of 3D parametric lines
+//                with sets of 3D planes (portal culling, clip-plane sweeps, etc.);
+//                lines and planes are stored in SoA form so they can be processed
+//                by SIMD kernels
+//
+// Created:       17.10.26
+////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "Figures.h"
+
+
+namespace MathLib
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                 DATA STRUCTURES
+////////////////////////////////////////////////////////////////////////////////////////////
+
+// array of 3D parametric lines in SoA form: start points (p0) and direction vectors (v)
+// as in PARAMLINE3D (the end point p1 isn't needed: p1 = p0 + v)
+typedef struct PARAMLINE3D_SOA_TYPE
+{
+	const float* p0x = nullptr;
+	const float* p0y = nullptr;
+	const float* p0z = nullptr;
+	const float* vx = nullptr;
+	const float* vy = nullptr;
+	const float* vz = nullptr;
+} PARAMLINE3D_SOA, *PARAMLINE3D_SOA_PTR;
+
+// array of 3D planes in SoA form: the plane equation is (n * p) + d = 0;
+// n is usually a unit vector (see PLANE3D_Init), then (n * p) + d is the signed distance
+typedef struct PLANE3D_SOA_TYPE
+{
+	const float* nx = nullptr;
+	const float* ny = nullptr;
+	const float* nz = nullptr;
+	const float* d = nullptr;
+} PLANE3D_SOA, *PLANE3D_SOA_PTR;
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                       BATCH INTERSECTION OF LINES AND PLANES
+////////////////////////////////////////////////////////////////////////////////////////////
+
+// stores the plane into the index-th entries of the arrays of PLANE3D_SOA:
+// n is copied as it is and d = -(n * p0)
+void PLANE3D_To_SOA(const PLANE3D & plane, float* nx, float* ny, float* nz, float* d, const int index);
+
+//
+// each function intersects each of numLines lines with each of numPlanes planes;
+// the results of line i and plane j are stored into t[j*numLines + i] and
+// codes[j*numLines + i] (the lines of one plane go in a row);
+//
+// codes are the same as of Intersect_Param_Line3D_Plane3D (PARAM_LINE_NO_INTERSECT,
+// PARAM_LINE_INTERSECT_IN_SEGMENT (a hit of the segment p0->p1), ..._OUT_SEGMENT,
+// ..._EVERYWHERE) with the same EPSILON_E5 thresholds; t is 0 if the line is parallel
+// to the plane; the results are bit-compatible with the scalar kernel for each kernel
+//
+
+// chooses the best kernel for the current CPU (see SIMD_Get_Level)
+void Intersect_Param_Lines3D_Planes3D_Batch(const PARAMLINE3D_SOA & lines, const int numLines,
+	const PLANE3D_SOA & planes, const int numPlanes,
+	float* t,
+	unsigned char* codes);
+
+// separate kernels (SSE/AVX2 kernels must be called only if the CPU supports them)
+void Intersect_Param_Lines3D_Planes3D_Batch_Scalar(const PARAMLINE3D_SOA & lines, const int numLines,
+	const PLANE3D_SOA & planes, const int numPlanes,
+	float* t,
+	unsigned char* codes);
+
+void Intersect_Param_Lines3D_Planes3D_Batch_SSE(const PARAMLINE3D_SOA & lines, const int numLines,
+	const PLANE3D_SOA & planes, const int numPlanes,
+	float* t,
+	unsigned char* codes);
+
+void Intersect_Param_Lines3D_Planes3D_Batch_AVX2(const PARAMLINE3D_SOA & lines, const int numLines,
+	const PLANE3D_SOA & planes, const int numPlanes,
+	float* t,
+	unsigned char* codes);
+
+} // end namespace MathLib
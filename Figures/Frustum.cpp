@@ -0,0 +1,904 @@
+////////////////////////////////////////////////////////////////////////////////////////////
+// Filename:      Frustum.cpp
+// Description:   contains implementation of view-frustum culling
+//                (scalar, SSE and AVX2 kernels + runtime dispatching)
+//
+// Created:       17.10.26
+////////////////////////////////////////////////////////////////////////////////////////////
+#include "Frustum.h"
+#include "../Utils/Simd.h"
+
+#include <cassert>
+#include <cstring>
+
+
+namespace MathLib
+{
+
+//
+// NOTE: all the kernels use the same order of operations for an object and plane k:
+//
+//   dist = (((nx[k] * cx) + (ny[k] * cy)) + (nz[k] * cz)) + d[k]
+//   r    = radius (a sphere), or
+//          ((|nx[k]| * ex) + (|ny[k]| * ey)) + (|nz[k]| * ez)   (a box: the center c = (min + max) * 0.5,
+//                                                                the half extents e = (max - min) * 0.5)
+//
+//   the object is outside of the plane if dist < -r, and crosses it if dist < r;
+//   a point is outside of the plane if dist < 0
+//
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                  INITIALIZATION
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void FRUSTUM_Init(FRUSTUM & frustum, const MATRIX4X4 & viewProj, const int depthRange)
+{
+	// this function extracts the planes from the matrix (Gribb/Hartmann method):
+	// with the row-vector convention the clip coordinates are the dot products of
+	// [x y z 1] with the columns of the matrix, so each plane is a sum or a difference
+	// of the column 3 (w) and one of the columns 0..2:
+	//
+	//   left: w + x >= 0,  right: w - x >= 0,  bottom: w + y >= 0,  top: w - y >= 0,
+	//   near: w + z >= 0 (or z >= 0 for the depth range [0, 1]),  far: w - z >= 0
+
+	assert((depthRange == FRUSTUM_DEPTH_MINUS_ONE_TO_ONE) || (depthRange == FRUSTUM_DEPTH_ZERO_TO_ONE));
+
+	// the plane coefficients (a, b, c, d) for each plane
+	float eq[FRUSTUM_NUM_PLANES][4];
+
+	for (int i = 0; i < 4; i++)
+	{
+		const float x = viewProj.M[i][0];
+		const float y = viewProj.M[i][1];
+		const float z = viewProj.M[i][2];
+		const float w = viewProj.M[i][3];
+
+		eq[FRUSTUM_PLANE_LEFT][i]   = w + x;
+		eq[FRUSTUM_PLANE_RIGHT][i]  = w - x;
+		eq[FRUSTUM_PLANE_BOTTOM][i] = w + y;
+		eq[FRUSTUM_PLANE_TOP][i]    = w - y;
+		eq[FRUSTUM_PLANE_NEAR][i]   = (depthRange == FRUSTUM_DEPTH_ZERO_TO_ONE) ? z : (w + z);
+		eq[FRUSTUM_PLANE_FAR][i]    = w - z;
+	}
+
+	memset(frustum.nx, 0, sizeof(frustum.nx));
+	memset(frustum.ny, 0, sizeof(frustum.ny));
+	memset(frustum.nz, 0, sizeof(frustum.nz));
+	memset(frustum.d, 0, sizeof(frustum.d));
+	memset(frustum.absNx, 0, sizeof(frustum.absNx));
+	memset(frustum.absNy, 0, sizeof(frustum.absNy));
+	memset(frustum.absNz, 0, sizeof(frustum.absNz));
+
+	// normalize the planes so dist is the real distance
+	for (int k = 0; k < FRUSTUM_NUM_PLANES; k++)
+	{
+		const float len = sqrtf((eq[k][0] * eq[k][0]) + (eq[k][1] * eq[k][1]) + (eq[k][2] * eq[k][2]));
+		const float invLen = (len > EPSILON_E5) ? (1.0f / len) : 0.0f;
+
+		frustum.nx[k] = eq[k][0] * invLen;
+		frustum.ny[k] = eq[k][1] * invLen;
+		frustum.nz[k] = eq[k][2] * invLen;
+		frustum.d[k]  = eq[k][3] * invLen;
+
+		frustum.absNx[k] = fabsf(frustum.nx[k]);
+		frustum.absNy[k] = fabsf(frustum.ny[k]);
+		frustum.absNz[k] = fabsf(frustum.nz[k]);
+
+		// the point of the plane which is the closest to the origin: p0 = -d * n
+		VECTOR3D_INIT_XYZ(frustum.planes[k].n, frustum.nx[k], frustum.ny[k], frustum.nz[k]);
+		POINT3D_INIT_XYZ(frustum.planes[k].p0,
+			-frustum.d[k] * frustum.nx[k],
+			-frustum.d[k] * frustum.ny[k],
+			-frustum.d[k] * frustum.nz[k]);
+	}
+
+} // end FRUSTUM_Init
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                  SINGLE TESTS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+static inline float Frustum_Plane_Dist(const FRUSTUM & f, const int k,
+	const float cx, const float cy, const float cz)
+{
+	return (((f.nx[k] * cx) + (f.ny[k] * cy)) + (f.nz[k] * cz)) + f.d[k];
+}
+
+static inline float Frustum_Box_Radius(const FRUSTUM & f, const int k,
+	const float ex, const float ey, const float ez)
+{
+	return ((f.absNx[k] * ex) + (f.absNy[k] * ey)) + (f.absNz[k] * ez);
+}
+
+///////////////////////////////////////////////////////////
+
+int FRUSTUM_Test_Point(const FRUSTUM & frustum, const POINT3D & pt)
+{
+	// this function checks if the point is inside of each plane
+
+	for (int k = 0; k < FRUSTUM_NUM_PLANES; k++)
+	{
+		if (Frustum_Plane_Dist(frustum, k, pt.x, pt.y, pt.z) < 0.0f)
+			return 0;
+	}
+
+	return 1;
+
+} // end FRUSTUM_Test_Point
+
+///////////////////////////////////////////////////////////
+
+int FRUSTUM_Classify_Sphere(const FRUSTUM & frustum,
+	const POINT3D & center,
+	const float radius,
+	unsigned char & lastPlane)
+{
+	// this function classifies the sphere; the cached plane is tested first
+
+	assert(lastPlane < FRUSTUM_NUM_PLANES);
+
+	if (Frustum_Plane_Dist(frustum, lastPlane, center.x, center.y, center.z) < -radius)
+		return FRUSTUM_OUTSIDE;
+
+	int result = FRUSTUM_INSIDE;
+
+	for (int k = 0; k < FRUSTUM_NUM_PLANES; k++)
+	{
+		const float dist = Frustum_Plane_Dist(frustum, k, center.x, center.y, center.z);
+
+		if (dist < -radius)
+		{
+			lastPlane = (unsigned char)k;
+			return FRUSTUM_OUTSIDE;
+		}
+
+		if (dist < radius)
+			result = FRUSTUM_INTERSECT;
+	}
+
+	return result;
+
+} // end FRUSTUM_Classify_Sphere
+
+///////////////////////////////////////////////////////////
+
+int FRUSTUM_Classify_AABB(const FRUSTUM & frustum,
+	const POINT3D & boxMin,
+	const POINT3D & boxMax,
+	unsigned char & lastPlane)
+{
+	// this function classifies the box by its center and half extents: the projection
+	// of the box onto the normal of a plane is [dist - r, dist + r]; the cached plane
+	// is tested first
+
+	assert(lastPlane < FRUSTUM_NUM_PLANES);
+
+	const float cx = (boxMin.x + boxMax.x) * 0.5f;
+	const float cy = (boxMin.y + boxMax.y) * 0.5f;
+	const float cz = (boxMin.z + boxMax.z) * 0.5f;
+	const float ex = (boxMax.x - boxMin.x) * 0.5f;
+	const float ey = (boxMax.y - boxMin.y) * 0.5f;
+	const float ez = (boxMax.z - boxMin.z) * 0.5f;
+
+	if (Frustum_Plane_Dist(frustum, lastPlane, cx, cy, cz) < -Frustum_Box_Radius(frustum, lastPlane, ex, ey, ez))
+		return FRUSTUM_OUTSIDE;
+
+	int result = FRUSTUM_INSIDE;
+
+	for (int k = 0; k < FRUSTUM_NUM_PLANES; k++)
+	{
+		const float dist = Frustum_Plane_Dist(frustum, k, cx, cy, cz);
+		const float r = Frustum_Box_Radius(frustum, k, ex, ey, ez);
+
+		if (dist < -r)
+		{
+			lastPlane = (unsigned char)k;
+			return FRUSTUM_OUTSIDE;
+		}
+
+		if (dist < r)
+			result = FRUSTUM_INTERSECT;
+	}
+
+	return result;
+
+} // end FRUSTUM_Classify_AABB
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                  SCALAR KERNELS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void FRUSTUM_Test_Points_Batch_Scalar(const FRUSTUM & frustum,
+	const float* x, const float* y, const float* z,
+	unsigned char* visible,
+	const int num)
+{
+	// tests num points using plain C++ code (reference kernel)
+
+	assert(x && y && z);
+	assert(visible != nullptr);
+	assert(num >= 0);
+
+	for (int i = 0; i < num; i++)
+	{
+		visible[i] = (unsigned char)FRUSTUM_Test_Point(frustum, POINT3D(x[i], y[i], z[i]));
+	}
+
+} // end FRUSTUM_Test_Points_Batch_Scalar
+
+///////////////////////////////////////////////////////////
+
+void FRUSTUM_Classify_Spheres_Batch_Scalar(const FRUSTUM & frustum,
+	const float* cx, const float* cy, const float* cz, const float* radius,
+	unsigned char* result,
+	unsigned char* lastPlane,
+	const int num)
+{
+	// classifies num spheres using plain C++ code (reference kernel)
+
+	assert(cx && cy && cz && radius);
+	assert(result && lastPlane);
+	assert(num >= 0);
+
+	for (int i = 0; i < num; i++)
+	{
+		result[i] = (unsigned char)FRUSTUM_Classify_Sphere(frustum, POINT3D(cx[i], cy[i], cz[i]), radius[i], lastPlane[i]);
+	}
+
+} // end FRUSTUM_Classify_Spheres_Batch_Scalar
+
+///////////////////////////////////////////////////////////
+
+void FRUSTUM_Classify_AABBs_Batch_Scalar(const FRUSTUM & frustum,
+	const float* minX, const float* minY, const float* minZ,
+	const float* maxX, const float* maxY, const float* maxZ,
+	unsigned char* result,
+	unsigned char* lastPlane,
+	const int num)
+{
+	// classifies num boxes using plain C++ code (reference kernel)
+
+	assert(minX && minY && minZ);
+	assert(maxX && maxY && maxZ);
+	assert(result && lastPlane);
+	assert(num >= 0);
+
+	for (int i = 0; i < num; i++)
+	{
+		result[i] = (unsigned char)FRUSTUM_Classify_AABB(frustum,
+			POINT3D(minX[i], minY[i], minZ[i]),
+			POINT3D(maxX[i], maxY[i], maxZ[i]),
+			lastPlane[i]);
+	}
+
+} // end FRUSTUM_Classify_AABBs_Batch_Scalar
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                   SIMD KERNELS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+#if MATHLIB_SIMD_X86
+
+//
+// NOTE: the sphere and box kernels are the same except of computation of r, so they
+//       are implemented by one template for each ISA: BOX == false means that
+//       (ex, ey, ez) are (radius, unused, unused)
+//
+
+MATHLIB_TARGET_SSE41
+static inline void Store_Bytes_SSE(unsigned char* dst, const __m128i v)
+{
+	// stores 4 int32 values (0..255) as 4 bytes
+	const __m128i v16 = _mm_packs_epi32(v, v);
+	const int v8 = _mm_cvtsi128_si32(_mm_packus_epi16(v16, v16));
+
+	memcpy(dst, &v8, 4);
+}
+
+MATHLIB_TARGET_AVX2
+static inline void Store_Bytes_AVX2(unsigned char* dst, const __m256i v)
+{
+	// stores 8 int32 values (0..255) as 8 bytes
+	const __m128i v16 = _mm_packs_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+
+	_mm_storel_epi64((__m128i*)dst, _mm_packus_epi16(v16, v16));
+}
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_SSE41
+void FRUSTUM_Test_Points_Batch_SSE(const FRUSTUM & frustum,
+	const float* x, const float* y, const float* z,
+	unsigned char* visible,
+	const int num)
+{
+	// tests num points; processes 4 points per iteration;
+	// the tail (num % 4 points) is processed by the scalar kernel
+
+	assert(x && y && z);
+	assert(visible != nullptr);
+	assert(num >= 0);
+
+	const __m128 zero = _mm_setzero_ps();
+	const __m128i one = _mm_set1_epi32(1);
+
+	int i = 0;
+
+	for (; i + 4 <= num; i += 4)
+	{
+		const __m128 px = _mm_loadu_ps(x + i);
+		const __m128 py = _mm_loadu_ps(y + i);
+		const __m128 pz = _mm_loadu_ps(z + i);
+
+		__m128 out = _mm_setzero_ps();
+
+		for (int k = 0; k < FRUSTUM_NUM_PLANES; k++)
+		{
+			const __m128 dist = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+				_mm_mul_ps(_mm_set1_ps(frustum.nx[k]), px),
+				_mm_mul_ps(_mm_set1_ps(frustum.ny[k]), py)),
+				_mm_mul_ps(_mm_set1_ps(frustum.nz[k]), pz)),
+				_mm_set1_ps(frustum.d[k]));
+
+			out = _mm_or_ps(out, _mm_cmplt_ps(dist, zero));
+
+			// all the points are rejected
+			if (_mm_movemask_ps(out) == 0xF)
+				break;
+		}
+
+		Store_Bytes_SSE(visible + i, _mm_andnot_si128(_mm_castps_si128(out), one));
+	}
+
+	// process the rest of points
+	FRUSTUM_Test_Points_Batch_Scalar(frustum, x + i, y + i, z + i, visible + i, num - i);
+
+} // end FRUSTUM_Test_Points_Batch_SSE
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_AVX2
+void FRUSTUM_Test_Points_Batch_AVX2(const FRUSTUM & frustum,
+	const float* x, const float* y, const float* z,
+	unsigned char* visible,
+	const int num)
+{
+	// tests num points; processes 8 points per iteration;
+	// the tail (num % 8 points) is processed by the SSE kernel
+	//
+	// NOTE: FMA isn't used here on purpose (see the note in Simd.h)
+
+	assert(x && y && z);
+	assert(visible != nullptr);
+	assert(num >= 0);
+
+	const __m256 zero = _mm256_setzero_ps();
+	const __m256i one = _mm256_set1_epi32(1);
+
+	int i = 0;
+
+	for (; i + 8 <= num; i += 8)
+	{
+		const __m256 px = _mm256_loadu_ps(x + i);
+		const __m256 py = _mm256_loadu_ps(y + i);
+		const __m256 pz = _mm256_loadu_ps(z + i);
+
+		__m256 out = _mm256_setzero_ps();
+
+		for (int k = 0; k < FRUSTUM_NUM_PLANES; k++)
+		{
+			const __m256 dist = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(
+				_mm256_mul_ps(_mm256_set1_ps(frustum.nx[k]), px),
+				_mm256_mul_ps(_mm256_set1_ps(frustum.ny[k]), py)),
+				_mm256_mul_ps(_mm256_set1_ps(frustum.nz[k]), pz)),
+				_mm256_set1_ps(frustum.d[k]));
+
+			out = _mm256_or_ps(out, _mm256_cmp_ps(dist, zero, _CMP_LT_OQ));
+
+			// all the points are rejected
+			if (_mm256_movemask_ps(out) == 0xFF)
+				break;
+		}
+
+		Store_Bytes_AVX2(visible + i, _mm256_andnot_si256(_mm256_castps_si256(out), one));
+	}
+
+	// process the rest of points
+	FRUSTUM_Test_Points_Batch_SSE(frustum, x + i, y + i, z + i, visible + i, num - i);
+
+} // end FRUSTUM_Test_Points_Batch_AVX2
+
+///////////////////////////////////////////////////////////
+
+template <bool BOX>
+MATHLIB_TARGET_SSE41
+static void Frustum_Classify_Volumes_SSE(const FRUSTUM & frustum,
+	const float* cxIn, const float* cyIn, const float* czIn,
+	const float* exIn, const float* eyIn, const float* ezIn,
+	unsigned char* result,
+	unsigned char* lastPlane,
+	const int num)
+{
+	// classifies 4 volumes per iteration; returns after the last group of 4 volumes
+	// (the caller processes the tail)
+
+	const __m128 signMask = _mm_set1_ps(-0.0f);
+	const __m128 half = _mm_set1_ps(0.5f);
+	const __m128i inside = _mm_set1_epi32(FRUSTUM_INSIDE);
+	const __m128i straddleCode = _mm_set1_epi32(FRUSTUM_INSIDE - FRUSTUM_INTERSECT);
+
+	for (int i = 0; i + 4 <= num; i += 4)
+	{
+		__m128 cx, cy, cz, ex, ey, ez;
+
+		if (BOX)
+		{
+			const __m128 bMinX = _mm_loadu_ps(cxIn + i);
+			const __m128 bMinY = _mm_loadu_ps(cyIn + i);
+			const __m128 bMinZ = _mm_loadu_ps(czIn + i);
+			const __m128 bMaxX = _mm_loadu_ps(exIn + i);
+			const __m128 bMaxY = _mm_loadu_ps(eyIn + i);
+			const __m128 bMaxZ = _mm_loadu_ps(ezIn + i);
+
+			cx = _mm_mul_ps(_mm_add_ps(bMinX, bMaxX), half);
+			cy = _mm_mul_ps(_mm_add_ps(bMinY, bMaxY), half);
+			cz = _mm_mul_ps(_mm_add_ps(bMinZ, bMaxZ), half);
+			ex = _mm_mul_ps(_mm_sub_ps(bMaxX, bMinX), half);
+			ey = _mm_mul_ps(_mm_sub_ps(bMaxY, bMinY), half);
+			ez = _mm_mul_ps(_mm_sub_ps(bMaxZ, bMinZ), half);
+		}
+		else
+		{
+			cx = _mm_loadu_ps(cxIn + i);
+			cy = _mm_loadu_ps(cyIn + i);
+			cz = _mm_loadu_ps(czIn + i);
+			ex = _mm_loadu_ps(exIn + i);
+			ey = ez = ex;
+		}
+
+		// the cached planes (gathered by the indices)
+		const int p0 = lastPlane[i + 0];
+		const int p1 = lastPlane[i + 1];
+		const int p2 = lastPlane[i + 2];
+		const int p3 = lastPlane[i + 3];
+
+		assert((p0 < FRUSTUM_NUM_PLANES) && (p1 < FRUSTUM_NUM_PLANES) && (p2 < FRUSTUM_NUM_PLANES) && (p3 < FRUSTUM_NUM_PLANES));
+
+		const __m128 dist = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+			_mm_mul_ps(_mm_setr_ps(frustum.nx[p0], frustum.nx[p1], frustum.nx[p2], frustum.nx[p3]), cx),
+			_mm_mul_ps(_mm_setr_ps(frustum.ny[p0], frustum.ny[p1], frustum.ny[p2], frustum.ny[p3]), cy)),
+			_mm_mul_ps(_mm_setr_ps(frustum.nz[p0], frustum.nz[p1], frustum.nz[p2], frustum.nz[p3]), cz)),
+			_mm_setr_ps(frustum.d[p0], frustum.d[p1], frustum.d[p2], frustum.d[p3]));
+
+		const __m128 r = (!BOX) ? ex : _mm_add_ps(_mm_add_ps(
+			_mm_mul_ps(_mm_setr_ps(frustum.absNx[p0], frustum.absNx[p1], frustum.absNx[p2], frustum.absNx[p3]), ex),
+			_mm_mul_ps(_mm_setr_ps(frustum.absNy[p0], frustum.absNy[p1], frustum.absNy[p2], frustum.absNy[p3]), ey)),
+			_mm_mul_ps(_mm_setr_ps(frustum.absNz[p0], frustum.absNz[p1], frustum.absNz[p2], frustum.absNz[p3]), ez));
+
+		__m128 out = _mm_cmplt_ps(dist, _mm_xor_ps(r, signMask));
+
+		// all the volumes are rejected by their cached planes
+		if (_mm_movemask_ps(out) == 0xF)
+		{
+			memset(result + i, FRUSTUM_OUTSIDE, 4);
+			continue;
+		}
+
+		__m128 straddle = _mm_setzero_ps();
+		__m128i plane = _mm_setr_epi32(p0, p1, p2, p3);
+
+		for (int k = 0; k < FRUSTUM_NUM_PLANES; k++)
+		{
+			const __m128 distK = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+				_mm_mul_ps(_mm_set1_ps(frustum.nx[k]), cx),
+				_mm_mul_ps(_mm_set1_ps(frustum.ny[k]), cy)),
+				_mm_mul_ps(_mm_set1_ps(frustum.nz[k]), cz)),
+				_mm_set1_ps(frustum.d[k]));
+
+			const __m128 rK = (!BOX) ? ex : _mm_add_ps(_mm_add_ps(
+				_mm_mul_ps(_mm_set1_ps(frustum.absNx[k]), ex),
+				_mm_mul_ps(_mm_set1_ps(frustum.absNy[k]), ey)),
+				_mm_mul_ps(_mm_set1_ps(frustum.absNz[k]), ez));
+
+			// remember the plane for the volumes which are rejected by it first
+			const __m128 outK = _mm_andnot_ps(out, _mm_cmplt_ps(distK, _mm_xor_ps(rK, signMask)));
+
+			plane = _mm_castps_si128(_mm_blendv_ps(_mm_castsi128_ps(plane), _mm_castsi128_ps(_mm_set1_epi32(k)), outK));
+			out = _mm_or_ps(out, outK);
+			straddle = _mm_or_ps(straddle, _mm_cmplt_ps(distK, rK));
+
+			// all the volumes are rejected
+			if (_mm_movemask_ps(out) == 0xF)
+				break;
+		}
+
+		// INSIDE, INTERSECT (if crosses a plane) or OUTSIDE
+		const __m128i code = _mm_andnot_si128(_mm_castps_si128(out),
+			_mm_sub_epi32(inside, _mm_and_si128(_mm_castps_si128(straddle), straddleCode)));
+
+		Store_Bytes_SSE(result + i, code);
+		Store_Bytes_SSE(lastPlane + i, plane);
+	}
+
+} // end Frustum_Classify_Volumes_SSE
+
+///////////////////////////////////////////////////////////
+
+template <bool BOX>
+MATHLIB_TARGET_AVX2
+static void Frustum_Classify_Volumes_AVX2(const FRUSTUM & frustum,
+	const float* cxIn, const float* cyIn, const float* czIn,
+	const float* exIn, const float* eyIn, const float* ezIn,
+	unsigned char* result,
+	unsigned char* lastPlane,
+	const int num)
+{
+	// classifies 8 volumes per iteration; returns after the last group of 8 volumes
+	// (the caller processes the tail); all the planes are kept in registers, so the
+	// cached planes are gathered by permutation
+	//
+	// NOTE: FMA isn't used here on purpose (see the note in Simd.h)
+
+	const __m256 signMask = _mm256_set1_ps(-0.0f);
+	const __m256 half = _mm256_set1_ps(0.5f);
+	const __m256i inside = _mm256_set1_epi32(FRUSTUM_INSIDE);
+	const __m256i straddleCode = _mm256_set1_epi32(FRUSTUM_INSIDE - FRUSTUM_INTERSECT);
+
+	const __m256 planesNx = _mm256_loadu_ps(frustum.nx);
+	const __m256 planesNy = _mm256_loadu_ps(frustum.ny);
+	const __m256 planesNz = _mm256_loadu_ps(frustum.nz);
+	const __m256 planesD = _mm256_loadu_ps(frustum.d);
+	const __m256 planesAbsNx = _mm256_loadu_ps(frustum.absNx);
+	const __m256 planesAbsNy = _mm256_loadu_ps(frustum.absNy);
+	const __m256 planesAbsNz = _mm256_loadu_ps(frustum.absNz);
+
+	for (int i = 0; i + 8 <= num; i += 8)
+	{
+		__m256 cx, cy, cz, ex, ey, ez;
+
+		if (BOX)
+		{
+			const __m256 bMinX = _mm256_loadu_ps(cxIn + i);
+			const __m256 bMinY = _mm256_loadu_ps(cyIn + i);
+			const __m256 bMinZ = _mm256_loadu_ps(czIn + i);
+			const __m256 bMaxX = _mm256_loadu_ps(exIn + i);
+			const __m256 bMaxY = _mm256_loadu_ps(eyIn + i);
+			const __m256 bMaxZ = _mm256_loadu_ps(ezIn + i);
+
+			cx = _mm256_mul_ps(_mm256_add_ps(bMinX, bMaxX), half);
+			cy = _mm256_mul_ps(_mm256_add_ps(bMinY, bMaxY), half);
+			cz = _mm256_mul_ps(_mm256_add_ps(bMinZ, bMaxZ), half);
+			ex = _mm256_mul_ps(_mm256_sub_ps(bMaxX, bMinX), half);
+			ey = _mm256_mul_ps(_mm256_sub_ps(bMaxY, bMinY), half);
+			ez = _mm256_mul_ps(_mm256_sub_ps(bMaxZ, bMinZ), half);
+		}
+		else
+		{
+			cx = _mm256_loadu_ps(cxIn + i);
+			cy = _mm256_loadu_ps(cyIn + i);
+			cz = _mm256_loadu_ps(czIn + i);
+			ex = _mm256_loadu_ps(exIn + i);
+			ey = ez = ex;
+		}
+
+		// the cached planes (the indices are < FRUSTUM_NUM_PLANES, so they are in the padded arrays)
+		const __m256i cached = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(lastPlane + i)));
+
+		const __m256 dist = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(
+			_mm256_mul_ps(_mm256_permutevar8x32_ps(planesNx, cached), cx),
+			_mm256_mul_ps(_mm256_permutevar8x32_ps(planesNy, cached), cy)),
+			_mm256_mul_ps(_mm256_permutevar8x32_ps(planesNz, cached), cz)),
+			_mm256_permutevar8x32_ps(planesD, cached));
+
+		const __m256 r = (!BOX) ? ex : _mm256_add_ps(_mm256_add_ps(
+			_mm256_mul_ps(_mm256_permutevar8x32_ps(planesAbsNx, cached), ex),
+			_mm256_mul_ps(_mm256_permutevar8x32_ps(planesAbsNy, cached), ey)),
+			_mm256_mul_ps(_mm256_permutevar8x32_ps(planesAbsNz, cached), ez));
+
+		__m256 out = _mm256_cmp_ps(dist, _mm256_xor_ps(r, signMask), _CMP_LT_OQ);
+
+		// all the volumes are rejected by their cached planes
+		if (_mm256_movemask_ps(out) == 0xFF)
+		{
+			memset(result + i, FRUSTUM_OUTSIDE, 8);
+			continue;
+		}
+
+		__m256 straddle = _mm256_setzero_ps();
+		__m256i plane = cached;
+
+		for (int k = 0; k < FRUSTUM_NUM_PLANES; k++)
+		{
+			const __m256 distK = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(
+				_mm256_mul_ps(_mm256_set1_ps(frustum.nx[k]), cx),
+				_mm256_mul_ps(_mm256_set1_ps(frustum.ny[k]), cy)),
+				_mm256_mul_ps(_mm256_set1_ps(frustum.nz[k]), cz)),
+				_mm256_set1_ps(frustum.d[k]));
+
+			const __m256 rK = (!BOX) ? ex : _mm256_add_ps(_mm256_add_ps(
+				_mm256_mul_ps(_mm256_set1_ps(frustum.absNx[k]), ex),
+				_mm256_mul_ps(_mm256_set1_ps(frustum.absNy[k]), ey)),
+				_mm256_mul_ps(_mm256_set1_ps(frustum.absNz[k]), ez));
+
+			// remember the plane for the volumes which are rejected by it first
+			const __m256 outK = _mm256_andnot_ps(out, _mm256_cmp_ps(distK, _mm256_xor_ps(rK, signMask), _CMP_LT_OQ));
+
+			plane = _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(plane), _mm256_castsi256_ps(_mm256_set1_epi32(k)), outK));
+			out = _mm256_or_ps(out, outK);
+			straddle = _mm256_or_ps(straddle, _mm256_cmp_ps(distK, rK, _CMP_LT_OQ));
+
+			// all the volumes are rejected
+			if (_mm256_movemask_ps(out) == 0xFF)
+				break;
+		}
+
+		// INSIDE, INTERSECT (if crosses a plane) or OUTSIDE
+		const __m256i code = _mm256_andnot_si256(_mm256_castps_si256(out),
+			_mm256_sub_epi32(inside, _mm256_and_si256(_mm256_castps_si256(straddle), straddleCode)));
+
+		Store_Bytes_AVX2(result + i, code);
+		Store_Bytes_AVX2(lastPlane + i, plane);
+	}
+
+} // end Frustum_Classify_Volumes_AVX2
+
+///////////////////////////////////////////////////////////
+
+void FRUSTUM_Classify_Spheres_Batch_SSE(const FRUSTUM & frustum,
+	const float* cx, const float* cy, const float* cz, const float* radius,
+	unsigned char* result,
+	unsigned char* lastPlane,
+	const int num)
+{
+	// classifies num spheres; processes 4 spheres per iteration;
+	// the tail (num % 4 spheres) is processed by the scalar kernel
+
+	assert(cx && cy && cz && radius);
+	assert(result && lastPlane);
+	assert(num >= 0);
+
+	const int i = num & ~3;
+
+	Frustum_Classify_Volumes_SSE<false>(frustum, cx, cy, cz, radius, radius, radius, result, lastPlane, i);
+
+	// process the rest of spheres
+	FRUSTUM_Classify_Spheres_Batch_Scalar(frustum, cx + i, cy + i, cz + i, radius + i,
+		result + i, lastPlane + i, num - i);
+
+} // end FRUSTUM_Classify_Spheres_Batch_SSE
+
+///////////////////////////////////////////////////////////
+
+void FRUSTUM_Classify_Spheres_Batch_AVX2(const FRUSTUM & frustum,
+	const float* cx, const float* cy, const float* cz, const float* radius,
+	unsigned char* result,
+	unsigned char* lastPlane,
+	const int num)
+{
+	// classifies num spheres; processes 8 spheres per iteration;
+	// the tail (num % 8 spheres) is processed by the SSE kernel
+
+	assert(cx && cy && cz && radius);
+	assert(result && lastPlane);
+	assert(num >= 0);
+
+	const int i = num & ~7;
+
+	Frustum_Classify_Volumes_AVX2<false>(frustum, cx, cy, cz, radius, radius, radius, result, lastPlane, i);
+
+	// process the rest of spheres
+	FRUSTUM_Classify_Spheres_Batch_SSE(frustum, cx + i, cy + i, cz + i, radius + i,
+		result + i, lastPlane + i, num - i);
+
+} // end FRUSTUM_Classify_Spheres_Batch_AVX2
+
+///////////////////////////////////////////////////////////
+
+void FRUSTUM_Classify_AABBs_Batch_SSE(const FRUSTUM & frustum,
+	const float* minX, const float* minY, const float* minZ,
+	const float* maxX, const float* maxY, const float* maxZ,
+	unsigned char* result,
+	unsigned char* lastPlane,
+	const int num)
+{
+	// classifies num boxes; processes 4 boxes per iteration;
+	// the tail (num % 4 boxes) is processed by the scalar kernel
+
+	assert(minX && minY && minZ);
+	assert(maxX && maxY && maxZ);
+	assert(result && lastPlane);
+	assert(num >= 0);
+
+	const int i = num & ~3;
+
+	Frustum_Classify_Volumes_SSE<true>(frustum, minX, minY, minZ, maxX, maxY, maxZ, result, lastPlane, i);
+
+	// process the rest of boxes
+	FRUSTUM_Classify_AABBs_Batch_Scalar(frustum, minX + i, minY + i, minZ + i, maxX + i, maxY + i, maxZ + i,
+		result + i, lastPlane + i, num - i);
+
+} // end FRUSTUM_Classify_AABBs_Batch_SSE
+
+///////////////////////////////////////////////////////////
+
+void FRUSTUM_Classify_AABBs_Batch_AVX2(const FRUSTUM & frustum,
+	const float* minX, const float* minY, const float* minZ,
+	const float* maxX, const float* maxY, const float* maxZ,
+	unsigned char* result,
+	unsigned char* lastPlane,
+	const int num)
+{
+	// classifies num boxes; processes 8 boxes per iteration;
+	// the tail (num % 8 boxes) is processed by the SSE kernel
+
+	assert(minX && minY && minZ);
+	assert(maxX && maxY && maxZ);
+	assert(result && lastPlane);
+	assert(num >= 0);
+
+	const int i = num & ~7;
+
+	Frustum_Classify_Volumes_AVX2<true>(frustum, minX, minY, minZ, maxX, maxY, maxZ, result, lastPlane, i);
+
+	// process the rest of boxes
+	FRUSTUM_Classify_AABBs_Batch_SSE(frustum, minX + i, minY + i, minZ + i, maxX + i, maxY + i, maxZ + i,
+		result + i, lastPlane + i, num - i);
+
+} // end FRUSTUM_Classify_AABBs_Batch_AVX2
+
+#else
+
+// there is no SIMD support for this platform so use the reference kernels
+
+void FRUSTUM_Test_Points_Batch_SSE(const FRUSTUM & frustum,
+	const float* x, const float* y, const float* z,
+	unsigned char* visible,
+	const int num)
+{
+	FRUSTUM_Test_Points_Batch_Scalar(frustum, x, y, z, visible, num);
+}
+
+void FRUSTUM_Test_Points_Batch_AVX2(const FRUSTUM & frustum,
+	const float* x, const float* y, const float* z,
+	unsigned char* visible,
+	const int num)
+{
+	FRUSTUM_Test_Points_Batch_Scalar(frustum, x, y, z, visible, num);
+}
+
+void FRUSTUM_Classify_Spheres_Batch_SSE(const FRUSTUM & frustum,
+	const float* cx, const float* cy, const float* cz, const float* radius,
+	unsigned char* result,
+	unsigned char* lastPlane,
+	const int num)
+{
+	FRUSTUM_Classify_Spheres_Batch_Scalar(frustum, cx, cy, cz, radius, result, lastPlane, num);
+}
+
+void FRUSTUM_Classify_Spheres_Batch_AVX2(const FRUSTUM & frustum,
+	const float* cx, const float* cy, const float* cz, const float* radius,
+	unsigned char* result,
+	unsigned char* lastPlane,
+	const int num)
+{
+	FRUSTUM_Classify_Spheres_Batch_Scalar(frustum, cx, cy, cz, radius, result, lastPlane, num);
+}
+
+void FRUSTUM_Classify_AABBs_Batch_SSE(const FRUSTUM & frustum,
+	const float* minX, const float* minY, const float* minZ,
+	const float* maxX, const float* maxY, const float* maxZ,
+	unsigned char* result,
+	unsigned char* lastPlane,
+	const int num)
+{
+	FRUSTUM_Classify_AABBs_Batch_Scalar(frustum, minX, minY, minZ, maxX, maxY, maxZ, result, lastPlane, num);
+}
+
+void FRUSTUM_Classify_AABBs_Batch_AVX2(const FRUSTUM & frustum,
+	const float* minX, const float* minY, const float* minZ,
+	const float* maxX, const float* maxY, const float* maxZ,
+	unsigned char* result,
+	unsigned char* lastPlane,
+	const int num)
+{
+	FRUSTUM_Classify_AABBs_Batch_Scalar(frustum, minX, minY, minZ, maxX, maxY, maxZ, result, lastPlane, num);
+}
+
+#endif // MATHLIB_SIMD_X86
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                    DISPATCHING
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void FRUSTUM_Test_Points_Batch(const FRUSTUM & frustum,
+	const float* x, const float* y, const float* z,
+	unsigned char* visible,
+	const int num)
+{
+	// tests num points using the best kernel for the current CPU
+
+	switch (SIMD_Get_Level())
+	{
+		case SIMD_LEVEL_AVX2:
+			FRUSTUM_Test_Points_Batch_AVX2(frustum, x, y, z, visible, num);
+			break;
+
+		case SIMD_LEVEL_AVX:
+		case SIMD_LEVEL_SSE:
+			FRUSTUM_Test_Points_Batch_SSE(frustum, x, y, z, visible, num);
+			break;
+
+		default:
+			FRUSTUM_Test_Points_Batch_Scalar(frustum, x, y, z, visible, num);
+	}
+
+} // end FRUSTUM_Test_Points_Batch
+
+///////////////////////////////////////////////////////////
+
+void FRUSTUM_Classify_Spheres_Batch(const FRUSTUM & frustum,
+	const float* cx, const float* cy, const float* cz, const float* radius,
+	unsigned char* result,
+	unsigned char* lastPlane,
+	const int num)
+{
+	// classifies num spheres using the best kernel for the current CPU
+
+	switch (SIMD_Get_Level())
+	{
+		case SIMD_LEVEL_AVX2:
+			FRUSTUM_Classify_Spheres_Batch_AVX2(frustum, cx, cy, cz, radius, result, lastPlane, num);
+			break;
+
+		case SIMD_LEVEL_AVX:
+		case SIMD_LEVEL_SSE:
+			FRUSTUM_Classify_Spheres_Batch_SSE(frustum, cx, cy, cz, radius, result, lastPlane, num);
+			break;
+
+		default:
+			FRUSTUM_Classify_Spheres_Batch_Scalar(frustum, cx, cy, cz, radius, result, lastPlane, num);
+	}
+
+} // end FRUSTUM_Classify_Spheres_Batch
+
+///////////////////////////////////////////////////////////
+
+void FRUSTUM_Classify_AABBs_Batch(const FRUSTUM & frustum,
+	const float* minX, const float* minY, const float* minZ,
+	const float* maxX, const float* maxY, const float* maxZ,
+	unsigned char* result,
+	unsigned char* lastPlane,
+	const int num)
+{
+	// classifies num boxes using the best kernel for the current CPU
+
+	switch (SIMD_Get_Level())
+	{
+		case SIMD_LEVEL_AVX2:
+			FRUSTUM_Classify_AABBs_Batch_AVX2(frustum, minX, minY, minZ, maxX, maxY, maxZ, result, lastPlane, num);
+			break;
+
+		case SIMD_LEVEL_AVX:
+		case SIMD_LEVEL_SSE:
+			FRUSTUM_Classify_AABBs_Batch_SSE(frustum, minX, minY, minZ, maxX, maxY, maxZ, result, lastPlane, num);
+			break;
+
+		default:
+			FRUSTUM_Classify_AABBs_Batch_Scalar(frustum, minX, minY, minZ, maxX, maxY, maxZ, result, lastPlane, num);
+	}
+
+} // end FRUSTUM_Classify_AABBs_Batch
+
+} // end namespace MathLib
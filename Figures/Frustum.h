@@ -0,0 +1,198 @@
+////////////////////////////////////////////////////////////////////////////////////////////
+// Filename:      Frustum.h
+// Description:   contains functional for view-frustum culling: a frustum of 6 planes
+//                is extracted from a view-projection matrix, and points, spheres and
+//                axis-aligned boxes are tested against it (single and batch versions
+//                with SSE/AVX2 kernels)
+//
+// Created:       17.10.26
+////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "Figures.h"
+
+
+namespace MathLib
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                   CONSTANTS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+// indices of the planes of a frustum
+enum FRUSTUM_PLANE_ID
+{
+	FRUSTUM_PLANE_LEFT = 0,
+	FRUSTUM_PLANE_RIGHT,
+	FRUSTUM_PLANE_BOTTOM,
+	FRUSTUM_PLANE_TOP,
+	FRUSTUM_PLANE_NEAR,
+	FRUSTUM_PLANE_FAR,
+	FRUSTUM_NUM_PLANES
+};
+
+// size of the arrays of the plane components in FRUSTUM (an AVX2 register holds them all)
+constexpr int FRUSTUM_NUM_PLANES_PADDED = 8;
+
+static_assert(FRUSTUM_NUM_PLANES <= FRUSTUM_NUM_PLANES_PADDED, "the planes must fit into the padded arrays");
+
+// results of classification of a volume (sphere, box) relative to a frustum
+constexpr int FRUSTUM_OUTSIDE   = 0;   // the volume is culled
+constexpr int FRUSTUM_INTERSECT = 1;   // the volume crosses some planes of the frustum
+constexpr int FRUSTUM_INSIDE    = 2;   // the volume is fully inside (its children needn't be tested)
+
+// depth range of the clip space of the projection matrix
+constexpr int FRUSTUM_DEPTH_MINUS_ONE_TO_ONE = 0;   // -w <= z <= w (OpenGL)
+constexpr int FRUSTUM_DEPTH_ZERO_TO_ONE      = 1;   //  0 <= z <= w (Direct3D, Vulkan)
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                 DATA STRUCTURES
+////////////////////////////////////////////////////////////////////////////////////////////
+
+// view frustum: 6 planes with unit normals pointing inside, so a point p is inside
+// the frustum if (n * p) + d >= 0 for each plane;
+//
+// the planes are stored as PLANE3D (to be used with the functions of Figures.h)
+// and as the separate components of the plane equations for the batch kernels
+// (the arrays are padded to FRUSTUM_NUM_PLANES_PADDED entries)
+typedef struct alignas(32) FRUSTUM_TYPE
+{
+	PLANE3D planes[FRUSTUM_NUM_PLANES];
+
+	float nx[FRUSTUM_NUM_PLANES_PADDED];
+	float ny[FRUSTUM_NUM_PLANES_PADDED];
+	float nz[FRUSTUM_NUM_PLANES_PADDED];
+	float d[FRUSTUM_NUM_PLANES_PADDED];
+
+	// absolute values of the normals (for boxes)
+	float absNx[FRUSTUM_NUM_PLANES_PADDED];
+	float absNy[FRUSTUM_NUM_PLANES_PADDED];
+	float absNz[FRUSTUM_NUM_PLANES_PADDED];
+} FRUSTUM, *FRUSTUM_PTR;
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                            FUNCTIONS PROTOTYPES
+////////////////////////////////////////////////////////////////////////////////////////////
+
+// extracts the planes from the view-projection matrix (the row-vector convention:
+// clip = [x y z 1] * viewProj, as Mat_Mul_VECTOR3D_4X4); depthRange is
+// FRUSTUM_DEPTH_MINUS_ONE_TO_ONE or FRUSTUM_DEPTH_ZERO_TO_ONE
+void FRUSTUM_Init(FRUSTUM & frustum, const MATRIX4X4 & viewProj, const int depthRange);
+
+///////////////////////////////////////////////////////////////
+
+//
+// single tests:
+//
+// lastPlane is the plane coherency cache of an object: the index of the plane which
+// rejected the object last time (any valid index at the beginning, e.g. 0); the object
+// is tested against this plane first because usually the same plane rejects it in the
+// next frame too; when another plane rejects the object its index is stored into lastPlane
+//
+
+// returns 1 if the point is inside the frustum, and 0 if it is outside
+int FRUSTUM_Test_Point(const FRUSTUM & frustum, const POINT3D & pt);
+
+// return FRUSTUM_OUTSIDE, FRUSTUM_INTERSECT or FRUSTUM_INSIDE
+int FRUSTUM_Classify_Sphere(const FRUSTUM & frustum,
+	const POINT3D & center,
+	const float radius,
+	unsigned char & lastPlane);
+
+int FRUSTUM_Classify_AABB(const FRUSTUM & frustum,
+	const POINT3D & boxMin,
+	const POINT3D & boxMax,
+	unsigned char & lastPlane);
+
+///////////////////////////////////////////////////////////////
+
+//
+// batch tests of num objects in SoA form; the results are the same as of the single
+// tests (visible[i] is 1/0, result[i] is FRUSTUM_OUTSIDE/_INTERSECT/_INSIDE, lastPlane[i]
+// is the cache of the object i); the results are bit-compatible for each kernel;
+//
+// the SIMD kernels skip a group of objects as soon as their cached planes reject all of
+// them, and stop testing the planes as soon as all the objects of the group are rejected
+//
+
+// chooses the best kernel for the current CPU (see SIMD_Get_Level)
+void FRUSTUM_Test_Points_Batch(const FRUSTUM & frustum,
+	const float* x, const float* y, const float* z,
+	unsigned char* visible,
+	const int num);
+
+void FRUSTUM_Classify_Spheres_Batch(const FRUSTUM & frustum,
+	const float* cx, const float* cy, const float* cz, const float* radius,
+	unsigned char* result,
+	unsigned char* lastPlane,
+	const int num);
+
+void FRUSTUM_Classify_AABBs_Batch(const FRUSTUM & frustum,
+	const float* minX, const float* minY, const float* minZ,
+	const float* maxX, const float* maxY, const float* maxZ,
+	unsigned char* result,
+	unsigned char* lastPlane,
+	const int num);
+
+// separate kernels (SSE/AVX2 kernels must be called only if the CPU supports them)
+void FRUSTUM_Test_Points_Batch_Scalar(const FRUSTUM & frustum,
+	const float* x, const float* y, const float* z,
+	unsigned char* visible,
+	const int num);
+
+void FRUSTUM_Test_Points_Batch_SSE(const FRUSTUM & frustum,
+	const float* x, const float* y, const float* z,
+	unsigned char* visible,
+	const int num);
+
+void FRUSTUM_Test_Points_Batch_AVX2(const FRUSTUM & frustum,
+	const float* x, const float* y, const float* z,
+	unsigned char* visible,
+	const int num);
+
+void FRUSTUM_Classify_Spheres_Batch_Scalar(const FRUSTUM & frustum,
+	const float* cx, const float* cy, const float* cz, const float* radius,
+	unsigned char* result,
+	unsigned char* lastPlane,
+	const int num);
+
+void FRUSTUM_Classify_Spheres_Batch_SSE(const FRUSTUM & frustum,
+	const float* cx, const float* cy, const float* cz, const float* radius,
+	unsigned char* result,
+	unsigned char* lastPlane,
+	const int num);
+
+void FRUSTUM_Classify_Spheres_Batch_AVX2(const FRUSTUM & frustum,
+	const float* cx, const float* cy, const float* cz, const float* radius,
+	unsigned char* result,
+	unsigned char* lastPlane,
+	const int num);
+
+void FRUSTUM_Classify_AABBs_Batch_Scalar(const FRUSTUM & frustum,
+	const float* minX, const float* minY, const float* minZ,
+	const float* maxX, const float* maxY, const float* maxZ,
+	unsigned char* result,
+	unsigned char* lastPlane,
+	const int num);
+
+void FRUSTUM_Classify_AABBs_Batch_SSE(const FRUSTUM & frustum,
+	const float* minX, const float* minY, const float* minZ,
+	const float* maxX, const float* maxY, const float* maxZ,
+	unsigned char* result,
+	unsigned char* lastPlane,
+	const int num);
+
+void FRUSTUM_Classify_AABBs_Batch_AVX2(const FRUSTUM & frustum,
+	const float* minX, const float* minY, const float* minZ,
+	const float* maxX, const float* maxY, const float* maxZ,
+	unsigned char* result,
+	unsigned char* lastPlane,
+	const int num);
+
+} // end namespace MathLib
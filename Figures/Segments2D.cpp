@@ -0,0 +1,433 @@
+////////////////////////////////////////////////////////////////////////////////////////////
+// Filename:      Segments2D.cpp
+// Description:   contains implementation of functional for finding all the
+//                intersections in a set of 2D segments
+//
+// Created:       17.10.26
+////////////////////////////////////////////////////////////////////////////////////////////
+#include "Segments2D.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <thread>
+
+
+namespace MathLib
+{
+
+// the cells of the grid are taken by the threads in chunks of so many cells
+constexpr int SEGMENTS2D_GRID_CHUNK = 64;
+
+
+// the segments prepared for the tests: boxes and the lines in SoA form
+typedef struct SEGMENTS2D_DATA_TYPE
+{
+	std::vector<float> minX;
+	std::vector<float> minY;
+	std::vector<float> maxX;
+	std::vector<float> maxY;
+	std::vector<float> p0x;
+	std::vector<float> p0y;
+	std::vector<float> vx;
+	std::vector<float> vy;
+} SEGMENTS2D_DATA, *SEGMENTS2D_DATA_PTR;
+
+
+// a uniform grid of the segments: the segments of the cell c are
+// segIndices[cellStart[c] .. cellStart[c+1])
+typedef struct SEGMENTS2D_GRID_TYPE
+{
+	float minX;
+	float minY;
+	float invCellSize;
+	int   numX;
+	int   numY;
+	std::vector<int> cellStart;
+	std::vector<int> segIndices;
+} SEGMENTS2D_GRID, *SEGMENTS2D_GRID_PTR;
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                PRIVATE FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+static void Prepare_Segments(const PARAMLINE2D* lines, const int num, SEGMENTS2D_DATA & data)
+{
+	// computes the boxes of the segments and copies the lines into SoA
+
+	data.minX.resize(num);  data.minY.resize(num);
+	data.maxX.resize(num);  data.maxY.resize(num);
+	data.p0x.resize(num);   data.p0y.resize(num);
+	data.vx.resize(num);    data.vy.resize(num);
+
+	for (int i = 0; i < num; i++)
+	{
+		const PARAMLINE2D & line = lines[i];
+
+		data.minX[i] = std::min(line.p0.x, line.p1.x);
+		data.minY[i] = std::min(line.p0.y, line.p1.y);
+		data.maxX[i] = std::max(line.p0.x, line.p1.x);
+		data.maxY[i] = std::max(line.p0.y, line.p1.y);
+
+		data.p0x[i] = line.p0.x;
+		data.p0y[i] = line.p0.y;
+		data.vx[i] = line.v.x;
+		data.vy[i] = line.v.y;
+	}
+}
+
+///////////////////////////////////////////////////////////
+
+static inline int Boxes_Overlap(const SEGMENTS2D_DATA & data, const int i, const int j)
+{
+	return (data.minX[i] <= data.maxX[j]) && (data.minX[j] <= data.maxX[i]) &&
+	       (data.minY[i] <= data.maxY[j]) && (data.minY[j] <= data.maxY[i]);
+}
+
+///////////////////////////////////////////////////////////
+
+static inline void Test_Pair(const SEGMENTS2D_DATA & data, const int i, const int j, std::vector<SEGMENT2D_HIT> & hits)
+{
+	// tests the segments i < j and adds the hit if they intersect; it is a solution
+	// of p0[i] + t1*v[i] == p0[j] + t2*v[j] by Cramer's rule
+
+	const float det = data.vx[i] * data.vy[j] - data.vy[i] * data.vx[j];
+
+	// the segments are parallel or collinear
+	if (fabs(det) <= EPSILON_E5)
+		return;
+
+	const float invDet = 1.0f / det;
+	const float dx = data.p0x[i] - data.p0x[j];
+	const float dy = data.p0y[i] - data.p0y[j];
+
+	const float t1 = (data.vx[j] * dy - data.vy[j] * dx) * invDet;
+	const float t2 = (data.vx[i] * dy - data.vy[i] * dx) * invDet;
+
+	if ((t1 >= 0.0f) && (t1 <= 1.0f) && (t2 >= 0.0f) && (t2 <= 1.0f))
+		hits.push_back({ i, j, t1, t2 });
+}
+
+///////////////////////////////////////////////////////////
+
+static int Sort_Hits(std::vector<SEGMENT2D_HIT> & hits)
+{
+	std::sort(hits.begin(), hits.end(), [](const SEGMENT2D_HIT & a, const SEGMENT2D_HIT & b)
+	{
+		return (a.i < b.i) || ((a.i == b.i) && (a.j < b.j));
+	});
+
+	return (int)hits.size();
+}
+
+///////////////////////////////////////////////////////////
+
+static inline int Grid_Coord(const float x, const float gridMin, const float invCellSize, const int numCells)
+{
+	// the cell of the coordinate (it is monotonic in x, so the cell of a point
+	// of a box is always between the cells of the box corners)
+
+	const int c = (int)((x - gridMin) * invCellSize);
+	return std::min(std::max(c, 0), numCells - 1);
+}
+
+///////////////////////////////////////////////////////////
+
+static void Build_Grid(const SEGMENTS2D_DATA & data, const int num, float cellSize, SEGMENTS2D_GRID & grid)
+{
+	// computes the bounds and the size of the grid, and puts each segment into
+	// the cells of its box (by counting sort, so the segments of a cell go in a row)
+
+	float maxX = data.maxX[0];
+	float maxY = data.maxY[0];
+	double sumSize = 0.0;
+
+	grid.minX = data.minX[0];
+	grid.minY = data.minY[0];
+
+	for (int i = 0; i < num; i++)
+	{
+		grid.minX = std::min(grid.minX, data.minX[i]);
+		grid.minY = std::min(grid.minY, data.minY[i]);
+		maxX = std::max(maxX, data.maxX[i]);
+		maxY = std::max(maxY, data.maxY[i]);
+
+		sumSize += std::max(data.maxX[i] - data.minX[i], data.maxY[i] - data.minY[i]);
+	}
+
+	const double width = (double)maxX - grid.minX;
+	const double height = (double)maxY - grid.minY;
+
+	if (cellSize <= 0.0f)
+		cellSize = (float)(sumSize / num);
+
+	// all the segments are points (or the size is too small): one cell
+	if (!(cellSize > 0.0f))
+		cellSize = std::max(1.0f, (float)std::max(width, height));
+
+	// limit the number of cells
+	const double maxCells = (double)SEGMENTS2D_GRID_MAX_CELLS_PER_SEGMENT * num;
+	const double numCells = (width / cellSize + 1.0) * (height / cellSize + 1.0);
+
+	if (numCells > maxCells)
+		cellSize = (float)(cellSize * sqrt(numCells / maxCells));
+
+	grid.invCellSize = 1.0f / cellSize;
+	grid.numX = (int)std::min(width / cellSize + 1.0, maxCells);
+	grid.numY = (int)std::min(height / cellSize + 1.0, maxCells);
+
+	// count the segments of each cell
+	const int totalCells = grid.numX * grid.numY;
+
+	grid.cellStart.assign(totalCells + 1, 0);
+
+	for (int pass = 0; pass < 2; pass++)
+	{
+		if (pass == 1)
+		{
+			// the counts -> the starts
+			for (int c = 0; c < totalCells; c++)
+				grid.cellStart[c + 1] += grid.cellStart[c];
+
+			grid.segIndices.resize(grid.cellStart[totalCells]);
+		}
+
+		for (int i = 0; i < num; i++)
+		{
+			const int x0 = Grid_Coord(data.minX[i], grid.minX, grid.invCellSize, grid.numX);
+			const int x1 = Grid_Coord(data.maxX[i], grid.minX, grid.invCellSize, grid.numX);
+			const int y0 = Grid_Coord(data.minY[i], grid.minY, grid.invCellSize, grid.numY);
+			const int y1 = Grid_Coord(data.maxY[i], grid.minY, grid.invCellSize, grid.numY);
+
+			for (int y = y0; y <= y1; y++)
+			{
+				for (int x = x0; x <= x1; x++)
+				{
+					const int c = y * grid.numX + x;
+
+					if (pass == 0)
+						grid.cellStart[c + 1]++;
+					else
+						grid.segIndices[grid.cellStart[c]++] = i;
+				}
+			}
+		}
+	}
+
+	// the filling has moved each start to the next cell
+	for (int c = totalCells; c > 0; c--)
+		grid.cellStart[c] = grid.cellStart[c - 1];
+
+	grid.cellStart[0] = 0;
+}
+
+///////////////////////////////////////////////////////////
+
+static void Test_Grid_Cells(const SEGMENTS2D_DATA & data,
+	const SEGMENTS2D_GRID & grid,
+	std::atomic<int> & nextCell,
+	std::vector<SEGMENT2D_HIT> & hits)
+{
+	// tests the pairs of the cells which are taken chunk by chunk; a pair of segments
+	// can be in several cells, so it is tested only in the cell of the minimal corner
+	// of the overlap of their boxes (this corner is in both boxes, so both segments
+	// are in its cell)
+
+	const int totalCells = grid.numX * grid.numY;
+
+	for (;;)
+	{
+		const int first = nextCell.fetch_add(SEGMENTS2D_GRID_CHUNK);
+
+		if (first >= totalCells)
+			break;
+
+		const int last = std::min(first + SEGMENTS2D_GRID_CHUNK, totalCells);
+
+		for (int c = first; c < last; c++)
+		{
+			const int* segs = grid.segIndices.data() + grid.cellStart[c];
+			const int count = grid.cellStart[c + 1] - grid.cellStart[c];
+
+			for (int a = 0; a < count; a++)
+			{
+				for (int b = a + 1; b < count; b++)
+				{
+					const int i = std::min(segs[a], segs[b]);
+					const int j = std::max(segs[a], segs[b]);
+
+					if (!Boxes_Overlap(data, i, j))
+						continue;
+
+					const int x = Grid_Coord(std::max(data.minX[i], data.minX[j]), grid.minX, grid.invCellSize, grid.numX);
+					const int y = Grid_Coord(std::max(data.minY[i], data.minY[j]), grid.minY, grid.invCellSize, grid.numY);
+
+					if (y * grid.numX + x == c)
+						Test_Pair(data, i, j, hits);
+				}
+			}
+		}
+	}
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                 PUBLIC FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+int Intersect_Segments2D_Brute_Force(const PARAMLINE2D* lines,
+	const int num,
+	std::vector<SEGMENT2D_HIT> & hits)
+{
+	// this function tests each pair of the segments
+
+	assert(num >= 0);
+	assert((num == 0) || (lines != nullptr));
+
+	hits.clear();
+
+	SEGMENTS2D_DATA data;
+	Prepare_Segments(lines, num, data);
+
+	for (int i = 0; i < num; i++)
+	{
+		for (int j = i + 1; j < num; j++)
+		{
+			if (Boxes_Overlap(data, i, j))
+				Test_Pair(data, i, j, hits);
+		}
+	}
+
+	return (int)hits.size();
+
+} // end Intersect_Segments2D_Brute_Force
+
+///////////////////////////////////////////////////////////
+
+int Intersect_Segments2D_Sweep(const PARAMLINE2D* lines,
+	const int num,
+	std::vector<SEGMENT2D_HIT> & hits)
+{
+	// this function sorts the segments by the left side of their boxes and sweeps
+	// a vertical line from left to right; the active segments are the segments which
+	// are crossed by the sweep line; a new segment is tested only against the active ones
+
+	assert(num >= 0);
+	assert((num == 0) || (lines != nullptr));
+
+	hits.clear();
+
+	SEGMENTS2D_DATA data;
+	Prepare_Segments(lines, num, data);
+
+	std::vector<int> order(num);
+
+	for (int i = 0; i < num; i++)
+		order[i] = i;
+
+	std::sort(order.begin(), order.end(), [&data](const int a, const int b)
+	{
+		return (data.minX[a] < data.minX[b]) || ((data.minX[a] == data.minX[b]) && (a < b));
+	});
+
+	std::vector<int> active;
+
+	for (const int s : order)
+	{
+		const float x = data.minX[s];
+
+		for (size_t k = 0; k < active.size(); )
+		{
+			const int a = active[k];
+
+			// the sweep line has passed the segment
+			if (data.maxX[a] < x)
+			{
+				active[k] = active.back();
+				active.pop_back();
+				continue;
+			}
+
+			// the boxes overlap along x, so only y is checked
+			if ((data.minY[a] <= data.maxY[s]) && (data.minY[s] <= data.maxY[a]))
+				Test_Pair(data, std::min(a, s), std::max(a, s), hits);
+
+			k++;
+		}
+
+		active.push_back(s);
+	}
+
+	return Sort_Hits(hits);
+
+} // end Intersect_Segments2D_Sweep
+
+///////////////////////////////////////////////////////////
+
+int Intersect_Segments2D_Grid(const PARAMLINE2D* lines,
+	const int num,
+	const float cellSize,
+	const int numThreads,
+	std::vector<SEGMENT2D_HIT> & hits)
+{
+	// this function builds the grid and tests the pairs of its cells by several threads;
+	// each thread collects its own hits, and they are merged and sorted at the end
+
+	assert(num >= 0);
+	assert((num == 0) || (lines != nullptr));
+
+	hits.clear();
+
+	if (num < 2)
+		return 0;
+
+	SEGMENTS2D_DATA data;
+	SEGMENTS2D_GRID grid;
+
+	Prepare_Segments(lines, num, data);
+	Build_Grid(data, num, cellSize, grid);
+
+	const int threads = (numThreads > 0) ? numThreads : std::max(1, (int)std::thread::hardware_concurrency());
+	const int numChunks = (grid.numX * grid.numY + SEGMENTS2D_GRID_CHUNK - 1) / SEGMENTS2D_GRID_CHUNK;
+	const int numWorkers = std::max(1, std::min(threads, numChunks));
+
+	std::atomic<int> nextCell(0);
+
+	if (numWorkers == 1)
+	{
+		Test_Grid_Cells(data, grid, nextCell, hits);
+		return Sort_Hits(hits);
+	}
+
+	std::vector<std::vector<SEGMENT2D_HIT>> threadHits(numWorkers);
+	std::vector<std::thread> workers;
+
+	for (int k = 1; k < numWorkers; k++)
+		workers.emplace_back(Test_Grid_Cells, std::cref(data), std::cref(grid), std::ref(nextCell), std::ref(threadHits[k]));
+
+	Test_Grid_Cells(data, grid, nextCell, threadHits[0]);
+
+	for (std::thread & worker : workers)
+		worker.join();
+
+	size_t total = 0;
+
+	for (const std::vector<SEGMENT2D_HIT> & h : threadHits)
+		total += h.size();
+
+	hits.reserve(total);
+
+	for (const std::vector<SEGMENT2D_HIT> & h : threadHits)
+		hits.insert(hits.end(), h.begin(), h.end());
+
+	return Sort_Hits(hits);
+
+} // end Intersect_Segments2D_Grid
+
+} // end namespace MathLib
@@ -0,0 +1,82 @@
+////////////////////////////////////////////////////////////////////////////////////////////
+// Filename:      Segments2D.h
+// Description:   contains functional for finding all the intersections in a set of
+//                2D segments (PARAMLINE2D): a brute force over all the pairs, a sweep
+//                along the x axis, and a uniform grid (multithreaded)
+//
+// Created:       17.10.26
+////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <vector>
+
+#include "Figures.h"
+
+
+namespace MathLib
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                   CONSTANTS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+// the grid of the automatic cell size has at most so many cells per segment
+constexpr int SEGMENTS2D_GRID_MAX_CELLS_PER_SEGMENT = 4;
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                 DATA STRUCTURES
+////////////////////////////////////////////////////////////////////////////////////////////
+
+// an intersection of the segments i and j (i < j): the point is
+// lines[i].p0 + t1 * lines[i].v == lines[j].p0 + t2 * lines[j].v
+typedef struct SEGMENT2D_HIT_TYPE
+{
+	int   i;
+	int   j;
+	float t1;   // parameter on the segment i, [0, 1]
+	float t2;   // parameter on the segment j, [0, 1]
+} SEGMENT2D_HIT, *SEGMENT2D_HIT_PTR;
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                            FUNCTIONS PROTOTYPES
+////////////////////////////////////////////////////////////////////////////////////////////
+
+//
+// each function finds all the pairs of num segments p0->p1 which intersect each other;
+// hits are sorted by (i, j); the return value is the number of hits
+//
+// a pair is tested only if the bounding boxes of the segments overlap (it is the same
+// for all the functions) and then by the same computations, so all of them give exactly
+// the same hits; parallel and collinear segments (|det| <= EPSILON_E5, as for
+// Intersect_Param_Lines2D) don't intersect
+//
+
+// tests each pair: O(num^2), it is good for small sets and as the reference
+int Intersect_Segments2D_Brute_Force(const PARAMLINE2D* lines,
+	const int num,
+	std::vector<SEGMENT2D_HIT> & hits);
+
+// sweeps a line along the x axis and tests each segment only against the segments
+// which are crossed by the sweep line at the same time: O(num*log(num) + the number
+// of such pairs), it is good for sets of short segments along the x axis
+int Intersect_Segments2D_Sweep(const PARAMLINE2D* lines,
+	const int num,
+	std::vector<SEGMENT2D_HIT> & hits);
+
+// puts the segments into a uniform grid (a segment is in each cell of its box) and
+// tests the pairs of each cell; the cells are processed by numThreads threads
+// (0 == the number of the CPU cores); cellSize <= 0 means the automatic size
+// (the average size of the segments' boxes)
+int Intersect_Segments2D_Grid(const PARAMLINE2D* lines,
+	const int num,
+	const float cellSize,
+	const int numThreads,
+	std::vector<SEGMENT2D_HIT> & hits);
+
+} // end namespace MathLib
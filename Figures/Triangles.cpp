@@ -0,0 +1,577 @@
+////////////////////////////////////////////////////////////////////////////////////////////
+// Filename:      Triangles.cpp
+// Description:   contains implementation of functional for 3D triangles
+//                (scalar, SSE and AVX2 kernels + runtime dispatching)
+//
+// Created:       17.10.26
+////////////////////////////////////////////////////////////////////////////////////////////
+#include "Triangles.h"
+#include "../Utils/Simd.h"
+
+#include <cassert>
+#include <cmath>
+
+
+namespace MathLib
+{
+
+//
+// NOTE: every kernel computes the Moller-Trumbore test with the same operations in the
+//       same order as Intersect_Triangle() below does, so the SIMD kernels give
+//       the same results as the scalar code:
+//
+//         P = v x e2,  det = e1.P,  S = p0(line) - p0(tri),  Q = S x e1
+//         u = (S.P)/det,  v = (v.Q)/det,  t = (e2.Q)/det   (x/det == x * (1/det))
+//
+//       the hit is accepted if u >= 0, v >= 0, u + v <= 1 and 0 <= t <= tMax
+//
+
+static inline float Min_Float(const float a, const float b) { return (a < b) ? a : b; }
+static inline float Max_Float(const float a, const float b) { return (a > b) ? a : b; }
+
+static inline int Intersect_Triangle(const PARAMLINE3D & line,
+	const float p0x, const float p0y, const float p0z,
+	const float e1x, const float e1y, const float e1z,
+	const float e2x, const float e2y, const float e2z,
+	const float tMax,
+	float & t, float & u, float & v)
+{
+	const float px = line.v.y * e2z - line.v.z * e2y;
+	const float py = line.v.z * e2x - line.v.x * e2z;
+	const float pz = line.v.x * e2y - line.v.y * e2x;
+
+	const float det = e1x * px + e1y * py + e1z * pz;
+
+	// the line is parallel to the plane of the triangle
+	if (det == 0.0f)
+		return 0;
+
+	const float invDet = 1.0f / det;
+
+	const float sx = line.p0.x - p0x;
+	const float sy = line.p0.y - p0y;
+	const float sz = line.p0.z - p0z;
+
+	u = (sx * px + sy * py + sz * pz) * invDet;
+
+	const float qx = sy * e1z - sz * e1y;
+	const float qy = sz * e1x - sx * e1z;
+	const float qz = sx * e1y - sy * e1x;
+
+	v = (line.v.x * qx + line.v.y * qy + line.v.z * qz) * invDet;
+	t = (e2x * qx + e2y * qy + e2z * qz) * invDet;
+
+	return (u >= 0.0f) && (v >= 0.0f) && (u + v <= 1.0f) && (t >= 0.0f) && (t <= tMax);
+}
+
+///////////////////////////////////////////////////////////
+
+static inline void Closer_Hit(TRIANGLE3D_HIT & best, const int index, const float t, const float u, const float v)
+{
+	// replaces the best hit if the hit (index, t) is closer; if the distances
+	// are equal the hit of the least index wins
+
+	if ((index < 0) || (t > best.t))
+		return;
+
+	if ((best.triIndex < 0) || (t < best.t) || (index < best.triIndex))
+	{
+		best.triIndex = index;
+		best.t = t;
+		best.u = u;
+		best.v = v;
+	}
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                         FUNCTIONS FOR SINGLE TRIANGLES
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void TRIANGLE3D_Precompute(const TRIANGLE3D & tri, TRIANGLE3D_PRECOMP & pre)
+{
+	pre.p0 = tri.p0;
+
+	pre.e1.x = tri.p1.x - tri.p0.x;
+	pre.e1.y = tri.p1.y - tri.p0.y;
+	pre.e1.z = tri.p1.z - tri.p0.z;
+
+	pre.e2.x = tri.p2.x - tri.p0.x;
+	pre.e2.y = tri.p2.y - tri.p0.y;
+	pre.e2.z = tri.p2.z - tri.p0.z;
+
+} // end TRIANGLE3D_Precompute
+
+///////////////////////////////////////////////////////////
+
+void TRIANGLE3D_To_SOA(const TRIANGLE3D* tris, const int num, const TRIANGLE3D_SOA_OUT & soa)
+{
+	// this function stores num triangles into the SoA arrays
+
+	assert(tris != nullptr);
+	assert(soa.p0x && soa.p0y && soa.p0z && soa.e1x && soa.e1y && soa.e1z && soa.e2x && soa.e2y && soa.e2z);
+	assert(num >= 0);
+
+	for (int i = 0; i < num; i++)
+	{
+		TRIANGLE3D_PRECOMP pre;
+		TRIANGLE3D_Precompute(tris[i], pre);
+
+		soa.p0x[i] = pre.p0.x;
+		soa.p0y[i] = pre.p0.y;
+		soa.p0z[i] = pre.p0.z;
+
+		soa.e1x[i] = pre.e1.x;
+		soa.e1y[i] = pre.e1.y;
+		soa.e1z[i] = pre.e1.z;
+
+		soa.e2x[i] = pre.e2.x;
+		soa.e2y[i] = pre.e2.y;
+		soa.e2z[i] = pre.e2.z;
+	}
+
+} // end TRIANGLE3D_To_SOA
+
+///////////////////////////////////////////////////////////
+
+void TRIANGLE3D_Compute_AABB3D(const TRIANGLE3D & tri, AABB3D & box)
+{
+	box.pMin.x = Min_Float(Min_Float(tri.p0.x, tri.p1.x), tri.p2.x);
+	box.pMin.y = Min_Float(Min_Float(tri.p0.y, tri.p1.y), tri.p2.y);
+	box.pMin.z = Min_Float(Min_Float(tri.p0.z, tri.p1.z), tri.p2.z);
+
+	box.pMax.x = Max_Float(Max_Float(tri.p0.x, tri.p1.x), tri.p2.x);
+	box.pMax.y = Max_Float(Max_Float(tri.p0.y, tri.p1.y), tri.p2.y);
+	box.pMax.z = Max_Float(Max_Float(tri.p0.z, tri.p1.z), tri.p2.z);
+
+} // end TRIANGLE3D_Compute_AABB3D
+
+///////////////////////////////////////////////////////////
+
+int Intersect_Param_Line3D_Triangle3D(const PARAMLINE3D & line,
+	const TRIANGLE3D & tri,
+	const float tMax,
+	TRIANGLE3D_HIT & hit)
+{
+	// this function computes the edges of the triangle and tests it;
+	// returns 1 if the line hits the triangle, or 0 if not
+
+	TRIANGLE3D_PRECOMP pre;
+	TRIANGLE3D_Precompute(tri, pre);
+
+	return Intersect_Param_Line3D_Triangle3D_Precomp(line, pre, tMax, hit);
+
+} // end Intersect_Param_Line3D_Triangle3D
+
+///////////////////////////////////////////////////////////
+
+int Intersect_Param_Line3D_Triangle3D_Precomp(const PARAMLINE3D & line,
+	const TRIANGLE3D_PRECOMP & tri,
+	const float tMax,
+	TRIANGLE3D_HIT & hit)
+{
+	// returns 1 if the line hits the triangle (and the hit), or 0 if not
+
+	float t, u, v;
+
+	if (!Intersect_Triangle(line,
+		tri.p0.x, tri.p0.y, tri.p0.z,
+		tri.e1.x, tri.e1.y, tri.e1.z,
+		tri.e2.x, tri.e2.y, tri.e2.z,
+		tMax, t, u, v))
+	{
+		return 0;
+	}
+
+	hit.t = t;
+	hit.u = u;
+	hit.v = v;
+
+	return 1;
+
+} // end Intersect_Param_Line3D_Triangle3D_Precomp
+
+///////////////////////////////////////////////////////////
+
+int BVH_Test_Triangle3D(const PARAMLINE3D & line,
+	const int primIndex,
+	const float tMax,
+	float & t,
+	const void* userData)
+{
+	// tests the triangle primIndex of the array of precomputed triangles (userData)
+
+	assert(userData != nullptr);
+
+	const TRIANGLE3D_PRECOMP & tri = static_cast<const TRIANGLE3D_PRECOMP*>(userData)[primIndex];
+	TRIANGLE3D_HIT hit;
+
+	if (!Intersect_Param_Line3D_Triangle3D_Precomp(line, tri, tMax, hit))
+		return 0;
+
+	t = hit.t;
+	return 1;
+
+} // end BVH_Test_Triangle3D
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                 SCALAR KERNELS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+int Intersect_Param_Line3D_Triangles3D_Scalar(const PARAMLINE3D & line,
+	const TRIANGLE3D_SOA & tris,
+	const int num,
+	const float tMax,
+	TRIANGLE3D_HIT & hit)
+{
+	// this function tests num triangles one by one and keeps the closest hit
+
+	assert(num >= 0);
+	assert((num == 0) || (tris.p0x && tris.p0y && tris.p0z && tris.e1x && tris.e1y && tris.e1z && tris.e2x && tris.e2y && tris.e2z));
+
+	TRIANGLE3D_HIT best;
+	best.t = INFINITY;
+
+	for (int i = 0; i < num; i++)
+	{
+		float t, u, v;
+
+		if (Intersect_Triangle(line,
+			tris.p0x[i], tris.p0y[i], tris.p0z[i],
+			tris.e1x[i], tris.e1y[i], tris.e1z[i],
+			tris.e2x[i], tris.e2y[i], tris.e2z[i],
+			tMax, t, u, v) && (t < best.t))
+		{
+			best.triIndex = i;
+			best.t = t;
+			best.u = u;
+			best.v = v;
+		}
+	}
+
+	if (best.triIndex < 0)
+	{
+		hit = TRIANGLE3D_HIT();
+		return 0;
+	}
+
+	hit = best;
+	return 1;
+
+} // end Intersect_Param_Line3D_Triangles3D_Scalar
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                   SIMD KERNELS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+#if MATHLIB_SIMD_X86
+
+static TRIANGLE3D_SOA Offset_SOA(const TRIANGLE3D_SOA & tris, const int offset)
+{
+	// returns the SoA arrays from the triangle offset
+
+	TRIANGLE3D_SOA rest = tris;
+
+	if (offset == 0)
+		return rest;
+
+	rest.p0x += offset; rest.p0y += offset; rest.p0z += offset;
+	rest.e1x += offset; rest.e1y += offset; rest.e1z += offset;
+	rest.e2x += offset; rest.e2y += offset; rest.e2z += offset;
+
+	return rest;
+}
+
+///////////////////////////////////////////////////////////
+
+static int Finish_Hit(TRIANGLE3D_HIT & best,
+	const int* laneIndex, const float* laneT, const float* laneU, const float* laneV, const int numLanes,
+	const TRIANGLE3D_HIT & restHit, const int restOffset,
+	TRIANGLE3D_HIT & hit)
+{
+	// reduces the best hits of the SIMD lanes and the hit of the rest of the triangles
+	// (which are tested by a narrower kernel) into the closest hit
+
+	for (int lane = 0; lane < numLanes; lane++)
+		Closer_Hit(best, laneIndex[lane], laneT[lane], laneU[lane], laneV[lane]);
+
+	if (restHit.triIndex >= 0)
+		Closer_Hit(best, restHit.triIndex + restOffset, restHit.t, restHit.u, restHit.v);
+
+	if (best.triIndex < 0)
+	{
+		hit = TRIANGLE3D_HIT();
+		return 0;
+	}
+
+	hit = best;
+	return 1;
+}
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_SSE41
+int Intersect_Param_Line3D_Triangles3D_SSE(const PARAMLINE3D & line,
+	const TRIANGLE3D_SOA & tris,
+	const int num,
+	const float tMax,
+	TRIANGLE3D_HIT & hit)
+{
+	// tests num triangles; processes 4 triangles per iteration (each lane keeps its
+	// own closest hit); the tail (num % 4 triangles) is processed by the scalar kernel
+
+	assert(num >= 0);
+	assert((num == 0) || (tris.p0x && tris.p0y && tris.p0z && tris.e1x && tris.e1y && tris.e1z && tris.e2x && tris.e2y && tris.e2z));
+
+	const __m128 ox = _mm_set1_ps(line.p0.x);
+	const __m128 oy = _mm_set1_ps(line.p0.y);
+	const __m128 oz = _mm_set1_ps(line.p0.z);
+	const __m128 dx = _mm_set1_ps(line.v.x);
+	const __m128 dy = _mm_set1_ps(line.v.y);
+	const __m128 dz = _mm_set1_ps(line.v.z);
+
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 tMax4 = _mm_set1_ps(tMax);
+
+	__m128  bestT = _mm_set1_ps(INFINITY);
+	__m128  bestU = zero;
+	__m128  bestV = zero;
+	__m128i bestIndex = _mm_set1_epi32(-1);
+	__m128i index = _mm_setr_epi32(0, 1, 2, 3);
+
+	int i = 0;
+
+	for (; i + 4 <= num; i += 4)
+	{
+		const __m128 e1x = _mm_loadu_ps(tris.e1x + i);
+		const __m128 e1y = _mm_loadu_ps(tris.e1y + i);
+		const __m128 e1z = _mm_loadu_ps(tris.e1z + i);
+		const __m128 e2x = _mm_loadu_ps(tris.e2x + i);
+		const __m128 e2y = _mm_loadu_ps(tris.e2y + i);
+		const __m128 e2z = _mm_loadu_ps(tris.e2z + i);
+
+		// P = v x e2, det = e1.P
+		const __m128 px = _mm_sub_ps(_mm_mul_ps(dy, e2z), _mm_mul_ps(dz, e2y));
+		const __m128 py = _mm_sub_ps(_mm_mul_ps(dz, e2x), _mm_mul_ps(dx, e2z));
+		const __m128 pz = _mm_sub_ps(_mm_mul_ps(dx, e2y), _mm_mul_ps(dy, e2x));
+
+		const __m128 det = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1x, px), _mm_mul_ps(e1y, py)), _mm_mul_ps(e1z, pz));
+		const __m128 invDet = _mm_div_ps(one, det);
+
+		// S = p0(line) - p0(tri), u = (S.P)/det
+		const __m128 sx = _mm_sub_ps(ox, _mm_loadu_ps(tris.p0x + i));
+		const __m128 sy = _mm_sub_ps(oy, _mm_loadu_ps(tris.p0y + i));
+		const __m128 sz = _mm_sub_ps(oz, _mm_loadu_ps(tris.p0z + i));
+
+		const __m128 u = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(sx, px), _mm_mul_ps(sy, py)), _mm_mul_ps(sz, pz)), invDet);
+
+		// Q = S x e1, v = (v.Q)/det, t = (e2.Q)/det
+		const __m128 qx = _mm_sub_ps(_mm_mul_ps(sy, e1z), _mm_mul_ps(sz, e1y));
+		const __m128 qy = _mm_sub_ps(_mm_mul_ps(sz, e1x), _mm_mul_ps(sx, e1z));
+		const __m128 qz = _mm_sub_ps(_mm_mul_ps(sx, e1y), _mm_mul_ps(sy, e1x));
+
+		const __m128 v = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, qx), _mm_mul_ps(dy, qy)), _mm_mul_ps(dz, qz)), invDet);
+		const __m128 t = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy)), _mm_mul_ps(e2z, qz)), invDet);
+
+		__m128 mask = _mm_cmpneq_ps(det, zero);
+		mask = _mm_and_ps(mask, _mm_cmpge_ps(u, zero));
+		mask = _mm_and_ps(mask, _mm_cmpge_ps(v, zero));
+		mask = _mm_and_ps(mask, _mm_cmple_ps(_mm_add_ps(u, v), one));
+		mask = _mm_and_ps(mask, _mm_cmpge_ps(t, zero));
+		mask = _mm_and_ps(mask, _mm_cmple_ps(t, tMax4));
+		mask = _mm_and_ps(mask, _mm_cmplt_ps(t, bestT));
+
+		if (_mm_movemask_ps(mask))
+		{
+			bestT = _mm_blendv_ps(bestT, t, mask);
+			bestU = _mm_blendv_ps(bestU, u, mask);
+			bestV = _mm_blendv_ps(bestV, v, mask);
+			bestIndex = _mm_castps_si128(_mm_blendv_ps(_mm_castsi128_ps(bestIndex), _mm_castsi128_ps(index), mask));
+		}
+
+		index = _mm_add_epi32(index, _mm_set1_epi32(4));
+	}
+
+	alignas(16) int   laneIndex[4];
+	alignas(16) float laneT[4];
+	alignas(16) float laneU[4];
+	alignas(16) float laneV[4];
+
+	_mm_store_si128((__m128i*)laneIndex, bestIndex);
+	_mm_store_ps(laneT, bestT);
+	_mm_store_ps(laneU, bestU);
+	_mm_store_ps(laneV, bestV);
+
+	// process the rest of triangles
+	TRIANGLE3D_HIT best;
+	TRIANGLE3D_HIT restHit;
+
+	best.t = INFINITY;
+	Intersect_Param_Line3D_Triangles3D_Scalar(line, Offset_SOA(tris, i), num - i, tMax, restHit);
+
+	return Finish_Hit(best, laneIndex, laneT, laneU, laneV, 4, restHit, i, hit);
+
+} // end Intersect_Param_Line3D_Triangles3D_SSE
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_AVX2
+int Intersect_Param_Line3D_Triangles3D_AVX2(const PARAMLINE3D & line,
+	const TRIANGLE3D_SOA & tris,
+	const int num,
+	const float tMax,
+	TRIANGLE3D_HIT & hit)
+{
+	// tests num triangles; processes 8 triangles per iteration (each lane keeps its
+	// own closest hit); the tail (num % 8 triangles) is processed by the SSE kernel
+
+	assert(num >= 0);
+	assert((num == 0) || (tris.p0x && tris.p0y && tris.p0z && tris.e1x && tris.e1y && tris.e1z && tris.e2x && tris.e2y && tris.e2z));
+
+	const __m256 ox = _mm256_set1_ps(line.p0.x);
+	const __m256 oy = _mm256_set1_ps(line.p0.y);
+	const __m256 oz = _mm256_set1_ps(line.p0.z);
+	const __m256 dx = _mm256_set1_ps(line.v.x);
+	const __m256 dy = _mm256_set1_ps(line.v.y);
+	const __m256 dz = _mm256_set1_ps(line.v.z);
+
+	const __m256 zero = _mm256_setzero_ps();
+	const __m256 one = _mm256_set1_ps(1.0f);
+	const __m256 tMax8 = _mm256_set1_ps(tMax);
+
+	__m256  bestT = _mm256_set1_ps(INFINITY);
+	__m256  bestU = zero;
+	__m256  bestV = zero;
+	__m256i bestIndex = _mm256_set1_epi32(-1);
+	__m256i index = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+
+	int i = 0;
+
+	for (; i + 8 <= num; i += 8)
+	{
+		const __m256 e1x = _mm256_loadu_ps(tris.e1x + i);
+		const __m256 e1y = _mm256_loadu_ps(tris.e1y + i);
+		const __m256 e1z = _mm256_loadu_ps(tris.e1z + i);
+		const __m256 e2x = _mm256_loadu_ps(tris.e2x + i);
+		const __m256 e2y = _mm256_loadu_ps(tris.e2y + i);
+		const __m256 e2z = _mm256_loadu_ps(tris.e2z + i);
+
+		// P = v x e2, det = e1.P
+		const __m256 px = _mm256_sub_ps(_mm256_mul_ps(dy, e2z), _mm256_mul_ps(dz, e2y));
+		const __m256 py = _mm256_sub_ps(_mm256_mul_ps(dz, e2x), _mm256_mul_ps(dx, e2z));
+		const __m256 pz = _mm256_sub_ps(_mm256_mul_ps(dx, e2y), _mm256_mul_ps(dy, e2x));
+
+		const __m256 det = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(e1x, px), _mm256_mul_ps(e1y, py)), _mm256_mul_ps(e1z, pz));
+		const __m256 invDet = _mm256_div_ps(one, det);
+
+		// S = p0(line) - p0(tri), u = (S.P)/det
+		const __m256 sx = _mm256_sub_ps(ox, _mm256_loadu_ps(tris.p0x + i));
+		const __m256 sy = _mm256_sub_ps(oy, _mm256_loadu_ps(tris.p0y + i));
+		const __m256 sz = _mm256_sub_ps(oz, _mm256_loadu_ps(tris.p0z + i));
+
+		const __m256 u = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(sx, px), _mm256_mul_ps(sy, py)), _mm256_mul_ps(sz, pz)), invDet);
+
+		// Q = S x e1, v = (v.Q)/det, t = (e2.Q)/det
+		const __m256 qx = _mm256_sub_ps(_mm256_mul_ps(sy, e1z), _mm256_mul_ps(sz, e1y));
+		const __m256 qy = _mm256_sub_ps(_mm256_mul_ps(sz, e1x), _mm256_mul_ps(sx, e1z));
+		const __m256 qz = _mm256_sub_ps(_mm256_mul_ps(sx, e1y), _mm256_mul_ps(sy, e1x));
+
+		const __m256 v = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, qx), _mm256_mul_ps(dy, qy)), _mm256_mul_ps(dz, qz)), invDet);
+		const __m256 t = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(e2x, qx), _mm256_mul_ps(e2y, qy)), _mm256_mul_ps(e2z, qz)), invDet);
+
+		__m256 mask = _mm256_cmp_ps(det, zero, _CMP_NEQ_UQ);
+		mask = _mm256_and_ps(mask, _mm256_cmp_ps(u, zero, _CMP_GE_OQ));
+		mask = _mm256_and_ps(mask, _mm256_cmp_ps(v, zero, _CMP_GE_OQ));
+		mask = _mm256_and_ps(mask, _mm256_cmp_ps(_mm256_add_ps(u, v), one, _CMP_LE_OQ));
+		mask = _mm256_and_ps(mask, _mm256_cmp_ps(t, zero, _CMP_GE_OQ));
+		mask = _mm256_and_ps(mask, _mm256_cmp_ps(t, tMax8, _CMP_LE_OQ));
+		mask = _mm256_and_ps(mask, _mm256_cmp_ps(t, bestT, _CMP_LT_OQ));
+
+		if (_mm256_movemask_ps(mask))
+		{
+			bestT = _mm256_blendv_ps(bestT, t, mask);
+			bestU = _mm256_blendv_ps(bestU, u, mask);
+			bestV = _mm256_blendv_ps(bestV, v, mask);
+			bestIndex = _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(bestIndex), _mm256_castsi256_ps(index), mask));
+		}
+
+		index = _mm256_add_epi32(index, _mm256_set1_epi32(8));
+	}
+
+	alignas(32) int   laneIndex[8];
+	alignas(32) float laneT[8];
+	alignas(32) float laneU[8];
+	alignas(32) float laneV[8];
+
+	_mm256_store_si256((__m256i*)laneIndex, bestIndex);
+	_mm256_store_ps(laneT, bestT);
+	_mm256_store_ps(laneU, bestU);
+	_mm256_store_ps(laneV, bestV);
+
+	// process the rest of triangles
+	TRIANGLE3D_HIT best;
+	TRIANGLE3D_HIT restHit;
+
+	best.t = INFINITY;
+	Intersect_Param_Line3D_Triangles3D_SSE(line, Offset_SOA(tris, i), num - i, tMax, restHit);
+
+	return Finish_Hit(best, laneIndex, laneT, laneU, laneV, 8, restHit, i, hit);
+
+} // end Intersect_Param_Line3D_Triangles3D_AVX2
+
+#else
+
+// there is no SIMD support for this platform so use the reference kernels
+
+int Intersect_Param_Line3D_Triangles3D_SSE(const PARAMLINE3D & line, const TRIANGLE3D_SOA & tris, const int num,
+	const float tMax, TRIANGLE3D_HIT & hit)
+{
+	return Intersect_Param_Line3D_Triangles3D_Scalar(line, tris, num, tMax, hit);
+}
+
+int Intersect_Param_Line3D_Triangles3D_AVX2(const PARAMLINE3D & line, const TRIANGLE3D_SOA & tris, const int num,
+	const float tMax, TRIANGLE3D_HIT & hit)
+{
+	return Intersect_Param_Line3D_Triangles3D_Scalar(line, tris, num, tMax, hit);
+}
+
+#endif // MATHLIB_SIMD_X86
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                    DISPATCHING
+////////////////////////////////////////////////////////////////////////////////////////////
+
+int Intersect_Param_Line3D_Triangles3D(const PARAMLINE3D & line,
+	const TRIANGLE3D_SOA & tris,
+	const int num,
+	const float tMax,
+	TRIANGLE3D_HIT & hit)
+{
+	// finds the closest hit using the best kernel for the current CPU
+
+	switch (SIMD_Get_Level())
+	{
+		case SIMD_LEVEL_AVX2:
+			return Intersect_Param_Line3D_Triangles3D_AVX2(line, tris, num, tMax, hit);
+
+		case SIMD_LEVEL_AVX:
+		case SIMD_LEVEL_SSE:
+			return Intersect_Param_Line3D_Triangles3D_SSE(line, tris, num, tMax, hit);
+
+		default:
+			return Intersect_Param_Line3D_Triangles3D_Scalar(line, tris, num, tMax, hit);
+	}
+
+} // end Intersect_Param_Line3D_Triangles3D
+
+} // end namespace MathLib
@@ -0,0 +1,156 @@
+////////////////////////////////////////////////////////////////////////////////////////////
+// Filename:      Triangles.h
+// Description:   contains functional for 3D triangles: intersection of parametric
+//                lines with triangles (the Moller-Trumbore algorithm) for single
+//                triangles, triangles with precomputed edges and batches of triangles
+//                in SoA form (one line vs 4/8 triangles per SSE/AVX2 iteration)
+//
+// Created:       17.10.26
+////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "Figures.h"
+#include "BoundingVolumes.h"
+
+
+namespace MathLib
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                 DATA STRUCTURES
+////////////////////////////////////////////////////////////////////////////////////////////
+
+// a triangle with precomputed edges: it is the data which the intersection test
+// actually needs, so a mesh which is tested many times should be stored in this form
+typedef struct TRIANGLE3D_PRECOMP_TYPE
+{
+	POINT3D  p0;   // the first vertex
+	VECTOR3D e1;   // p0 -> p1
+	VECTOR3D e2;   // p0 -> p2
+} TRIANGLE3D_PRECOMP, *TRIANGLE3D_PRECOMP_PTR;
+
+
+// arrays of triangles with precomputed edges in SoA form (an input view)
+typedef struct TRIANGLE3D_SOA_TYPE
+{
+	const float* p0x = nullptr;
+	const float* p0y = nullptr;
+	const float* p0z = nullptr;
+	const float* e1x = nullptr;
+	const float* e1y = nullptr;
+	const float* e1z = nullptr;
+	const float* e2x = nullptr;
+	const float* e2y = nullptr;
+	const float* e2z = nullptr;
+} TRIANGLE3D_SOA, *TRIANGLE3D_SOA_PTR;
+
+// the same arrays as an output view (see TRIANGLE3D_To_SOA); it converts to the input view
+typedef struct TRIANGLE3D_SOA_OUT_TYPE
+{
+	float* p0x = nullptr;
+	float* p0y = nullptr;
+	float* p0z = nullptr;
+	float* e1x = nullptr;
+	float* e1y = nullptr;
+	float* e1z = nullptr;
+	float* e2x = nullptr;
+	float* e2y = nullptr;
+	float* e2z = nullptr;
+
+	operator TRIANGLE3D_SOA() const
+	{
+		TRIANGLE3D_SOA soa;
+
+		soa.p0x = p0x;  soa.p0y = p0y;  soa.p0z = p0z;
+		soa.e1x = e1x;  soa.e1y = e1y;  soa.e1z = e1z;
+		soa.e2x = e2x;  soa.e2y = e2y;  soa.e2z = e2z;
+
+		return soa;
+	}
+} TRIANGLE3D_SOA_OUT, *TRIANGLE3D_SOA_OUT_PTR;
+
+
+// a result of an intersection of a line with a triangle
+typedef struct TRIANGLE3D_HIT_TYPE
+{
+	int   triIndex = -1;   // index of the triangle or -1 if there is no hit (only for batches)
+	float t = 0.0f;        // parameter of the hit point on the line
+	float u = 0.0f;        // barycentric coordinates of the hit point:
+	float v = 0.0f;        // pt = (1-u-v)*p0 + u*p1 + v*p2
+} TRIANGLE3D_HIT, *TRIANGLE3D_HIT_PTR;
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                         FUNCTIONS FOR SINGLE TRIANGLES
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void TRIANGLE3D_Precompute(const TRIANGLE3D & tri, TRIANGLE3D_PRECOMP & pre);
+
+// stores num triangles into SoA arrays (with precomputed edges)
+void TRIANGLE3D_To_SOA(const TRIANGLE3D* tris, const int num, const TRIANGLE3D_SOA_OUT & soa);
+
+void TRIANGLE3D_Compute_AABB3D(const TRIANGLE3D & tri, AABB3D & box);
+
+//
+// intersection tests: the line is p0 + t*v with 0 <= t <= tMax (tMax == 1 is the segment
+// p0->p1, a large tMax (e.g. FLT_MAX) is a ray); both sides of a triangle are hit;
+// a line which is parallel to the plane of the triangle doesn't hit it (det == 0);
+// return 1 and the hit (t, u, v) if the line hits the triangle, or 0 if not
+//
+// both versions give exactly the same results (the edges are computed in the same way)
+//
+
+int Intersect_Param_Line3D_Triangle3D(const PARAMLINE3D & line,
+	const TRIANGLE3D & tri,
+	const float tMax,
+	TRIANGLE3D_HIT & hit);
+
+int Intersect_Param_Line3D_Triangle3D_Precomp(const PARAMLINE3D & line,
+	const TRIANGLE3D_PRECOMP & tri,
+	const float tMax,
+	TRIANGLE3D_HIT & hit);
+
+// a primitive test for BVH queries (see BVH_PRIMITIVE_TEST in BVH.h):
+// userData must point to an array of TRIANGLE3D_PRECOMP which is indexed by primIndex
+int BVH_Test_Triangle3D(const PARAMLINE3D & line,
+	const int primIndex,
+	const float tMax,
+	float & t,
+	const void* userData);
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                 BATCH FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+//
+// the line is tested against num triangles in SoA form; each kernel computes every
+// triangle exactly as Intersect_Param_Line3D_Triangle3D_Precomp does, so the results
+// are the same for each kernel
+//
+// the functions without a suffix choose the best kernel for the current CPU (see SIMD_Get_Level)
+//
+
+// finds the closest hit (the least t; of the least index if there are several of them);
+// returns 1 if the line hits some triangle, or 0 if not (hit.triIndex == -1)
+int Intersect_Param_Line3D_Triangles3D(const PARAMLINE3D & line,
+	const TRIANGLE3D_SOA & tris,
+	const int num,
+	const float tMax,
+	TRIANGLE3D_HIT & hit);
+
+// separate kernels (SSE/AVX2 kernels must be called only if the CPU supports them)
+int Intersect_Param_Line3D_Triangles3D_Scalar(const PARAMLINE3D & line, const TRIANGLE3D_SOA & tris, const int num,
+	const float tMax, TRIANGLE3D_HIT & hit);
+
+int Intersect_Param_Line3D_Triangles3D_SSE(const PARAMLINE3D & line, const TRIANGLE3D_SOA & tris, const int num,
+	const float tMax, TRIANGLE3D_HIT & hit);
+
+int Intersect_Param_Line3D_Triangles3D_AVX2(const PARAMLINE3D & line, const TRIANGLE3D_SOA & tris, const int num,
+	const float tMax, TRIANGLE3D_HIT & hit);
+
+} // end namespace MathLib
@@ -0,0 +1,315 @@
+////////////////////////////////////////////////////////////////////////////////////////////
+// Filename:      FixedPoint.cpp
+// Description:   contains implementation of functional for work with fixed-point
+//                matrices (scalar, SSE and AVX2 kernels + runtime dispatching)
+//
+// Created:       17.10.26
+////////////////////////////////////////////////////////////////////////////////////////////
+#include "FixedPoint.h"
+#include "../Utils/Simd.h"
+
+
+namespace MathLib
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                              MATRIX OPERATIONS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void FIXP16_Mat_Mul_4X4(const FIXP16_MATRIX4X4* pMatA, const FIXP16_MATRIX4X4* pMatB, FIXP16_MATRIX4X4* pMProd)
+{
+	// this function multiplies two fixed-point 4x4 matrices;
+	// each element is a sum of 4 products (32.32 numbers) which is computed
+	// in 64 bits and rounded back to 16.16 only once
+
+	assert(pMatA != nullptr);
+	assert(pMatB != nullptr);
+	assert(pMProd != nullptr);
+
+	// compute into a temporary matrix since pMProd can be one of the inputs
+	FIXP16_MATRIX4X4 prod;
+
+	for (int row = 0; row < 4; row++)
+	{
+		for (int col = 0; col < 4; col++)
+		{
+			int64_t sum = FIXP16_ROUND_UP;
+
+			for (int k = 0; k < 4; k++)
+			{
+				sum += (int64_t)pMatA->M[row][k] * pMatB->M[k][col];
+			}
+
+			prod.M[row][col] = (FIXP16)(sum >> FIXP16_SHIFT);
+		}
+	}
+
+	*pMProd = prod;
+
+} // end FIXP16_Mat_Mul_4X4
+
+///////////////////////////////////////////////////////////
+
+void FIXP16_Mat_Mul_VECTOR3D_4X4(const FIXP16_VECTOR3D* pV, const FIXP16_MATRIX4X4* pM, FIXP16_VECTOR3D* pVecProd)
+{
+	// this function multiplies a fixed-point 3D vector by a 4x4 matrix (w = 1 is assumed);
+	// the products are summed in 64 bits and rounded once, and then the translation
+	// is added (it is exact); pVecProd can be the same as pV
+
+	assert(pV != nullptr);
+	assert(pM != nullptr);
+	assert(pVecProd != nullptr);
+
+	const int64_t x = pV->x;
+	const int64_t y = pV->y;
+	const int64_t z = pV->z;
+
+	for (int col = 0; col < 3; col++)
+	{
+		const int64_t sum = (x * pM->M[0][col]) + (y * pM->M[1][col]) + (z * pM->M[2][col]) + FIXP16_ROUND_UP;
+
+		pVecProd->M[col] = (FIXP16)(sum >> FIXP16_SHIFT) + pM->M[3][col];
+	}
+
+} // end FIXP16_Mat_Mul_VECTOR3D_4X4
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                              BATCH TRANSFORMATION
+////////////////////////////////////////////////////////////////////////////////////////////
+
+//
+// NOTE: there is no 64-bit arithmetic shift in SSE/AVX2, but we need only the bits 16..47
+//       of the 64-bit sums, and they are the same after the logical shift
+//
+
+void FIXP16_Mat_Mul_VECTOR3D_4X4_Batch_Scalar(const FIXP16* xIn, const FIXP16* yIn, const FIXP16* zIn,
+	const FIXP16_MATRIX4X4* pM,
+	FIXP16* xOut, FIXP16* yOut, FIXP16* zOut,
+	const int num)
+{
+	// transforms num points by the matrix using plain C++ code (reference kernel)
+
+	assert(xIn && yIn && zIn);
+	assert(xOut && yOut && zOut);
+	assert(pM != nullptr);
+	assert(num >= 0);
+
+	FIXP16_VECTOR3D v;
+
+	for (int i = 0; i < num; i++)
+	{
+		FIXP16_VECTOR3D_INIT_XYZ(v, xIn[i], yIn[i], zIn[i]);
+
+		FIXP16_Mat_Mul_VECTOR3D_4X4(&v, pM, &v);
+
+		xOut[i] = v.x;
+		yOut[i] = v.y;
+		zOut[i] = v.z;
+	}
+
+} // end FIXP16_Mat_Mul_VECTOR3D_4X4_Batch_Scalar
+
+///////////////////////////////////////////////////////////
+
+#if MATHLIB_SIMD_X86
+
+MATHLIB_TARGET_SSE41
+static inline __m128i FIXP16_Dot3_SSE(const __m128i x, const __m128i y, const __m128i z,
+	const __m128i m0, const __m128i m1, const __m128i m2,
+	const __m128i round)
+{
+	// computes round((x*m0 + y*m1 + z*m2) >> 16) for 4 lanes (m0..m2 are broadcasted);
+	// _mm_mul_epi32 multiplies only even lanes so odd lanes are shifted to even positions
+
+	const __m128i xOdd = _mm_srli_epi64(x, 32);
+	const __m128i yOdd = _mm_srli_epi64(y, 32);
+	const __m128i zOdd = _mm_srli_epi64(z, 32);
+
+	__m128i sumEven = _mm_add_epi64(_mm_mul_epi32(x, m0), _mm_mul_epi32(y, m1));
+	sumEven = _mm_add_epi64(sumEven, _mm_mul_epi32(z, m2));
+	sumEven = _mm_add_epi64(sumEven, round);
+
+	__m128i sumOdd = _mm_add_epi64(_mm_mul_epi32(xOdd, m0), _mm_mul_epi32(yOdd, m1));
+	sumOdd = _mm_add_epi64(sumOdd, _mm_mul_epi32(zOdd, m2));
+	sumOdd = _mm_add_epi64(sumOdd, round);
+
+	// even results => low halves of 64-bit lanes, odd results => high halves
+	const __m128i resEven = _mm_srli_epi64(sumEven, FIXP16_SHIFT);
+	const __m128i resOdd = _mm_slli_epi64(sumOdd, 32 - FIXP16_SHIFT);
+
+	return _mm_blend_epi16(resEven, resOdd, 0xCC);
+
+} // end FIXP16_Dot3_SSE
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_SSE41
+void FIXP16_Mat_Mul_VECTOR3D_4X4_Batch_SSE(const FIXP16* xIn, const FIXP16* yIn, const FIXP16* zIn,
+	const FIXP16_MATRIX4X4* pM,
+	FIXP16* xOut, FIXP16* yOut, FIXP16* zOut,
+	const int num)
+{
+	// transforms num points by the matrix; processes 4 points per iteration;
+	// the tail (num % 4 points) is processed by the scalar kernel
+
+	assert(xIn && yIn && zIn);
+	assert(xOut && yOut && zOut);
+	assert(pM != nullptr);
+	assert(num >= 0);
+
+	const __m128i round = _mm_set1_epi64x(FIXP16_ROUND_UP);
+
+	const __m128i m00 = _mm_set1_epi32(pM->M00), m01 = _mm_set1_epi32(pM->M01), m02 = _mm_set1_epi32(pM->M02);
+	const __m128i m10 = _mm_set1_epi32(pM->M10), m11 = _mm_set1_epi32(pM->M11), m12 = _mm_set1_epi32(pM->M12);
+	const __m128i m20 = _mm_set1_epi32(pM->M20), m21 = _mm_set1_epi32(pM->M21), m22 = _mm_set1_epi32(pM->M22);
+	const __m128i m30 = _mm_set1_epi32(pM->M30), m31 = _mm_set1_epi32(pM->M31), m32 = _mm_set1_epi32(pM->M32);
+
+	int i = 0;
+
+	for (; i + 4 <= num; i += 4)
+	{
+		const __m128i x = _mm_loadu_si128((const __m128i*)(xIn + i));
+		const __m128i y = _mm_loadu_si128((const __m128i*)(yIn + i));
+		const __m128i z = _mm_loadu_si128((const __m128i*)(zIn + i));
+
+		const __m128i rx = _mm_add_epi32(FIXP16_Dot3_SSE(x, y, z, m00, m10, m20, round), m30);
+		const __m128i ry = _mm_add_epi32(FIXP16_Dot3_SSE(x, y, z, m01, m11, m21, round), m31);
+		const __m128i rz = _mm_add_epi32(FIXP16_Dot3_SSE(x, y, z, m02, m12, m22, round), m32);
+
+		_mm_storeu_si128((__m128i*)(xOut + i), rx);
+		_mm_storeu_si128((__m128i*)(yOut + i), ry);
+		_mm_storeu_si128((__m128i*)(zOut + i), rz);
+	}
+
+	// process the rest of points
+	FIXP16_Mat_Mul_VECTOR3D_4X4_Batch_Scalar(xIn + i, yIn + i, zIn + i, pM,
+		xOut + i, yOut + i, zOut + i, num - i);
+
+} // end FIXP16_Mat_Mul_VECTOR3D_4X4_Batch_SSE
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_AVX2
+static inline __m256i FIXP16_Dot3_AVX2(const __m256i x, const __m256i y, const __m256i z,
+	const __m256i m0, const __m256i m1, const __m256i m2,
+	const __m256i round)
+{
+	// computes round((x*m0 + y*m1 + z*m2) >> 16) for 8 lanes (see FIXP16_Dot3_SSE)
+
+	const __m256i xOdd = _mm256_srli_epi64(x, 32);
+	const __m256i yOdd = _mm256_srli_epi64(y, 32);
+	const __m256i zOdd = _mm256_srli_epi64(z, 32);
+
+	__m256i sumEven = _mm256_add_epi64(_mm256_mul_epi32(x, m0), _mm256_mul_epi32(y, m1));
+	sumEven = _mm256_add_epi64(sumEven, _mm256_mul_epi32(z, m2));
+	sumEven = _mm256_add_epi64(sumEven, round);
+
+	__m256i sumOdd = _mm256_add_epi64(_mm256_mul_epi32(xOdd, m0), _mm256_mul_epi32(yOdd, m1));
+	sumOdd = _mm256_add_epi64(sumOdd, _mm256_mul_epi32(zOdd, m2));
+	sumOdd = _mm256_add_epi64(sumOdd, round);
+
+	const __m256i resEven = _mm256_srli_epi64(sumEven, FIXP16_SHIFT);
+	const __m256i resOdd = _mm256_slli_epi64(sumOdd, 32 - FIXP16_SHIFT);
+
+	return _mm256_blend_epi32(resEven, resOdd, 0xAA);
+
+} // end FIXP16_Dot3_AVX2
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_AVX2
+void FIXP16_Mat_Mul_VECTOR3D_4X4_Batch_AVX2(const FIXP16* xIn, const FIXP16* yIn, const FIXP16* zIn,
+	const FIXP16_MATRIX4X4* pM,
+	FIXP16* xOut, FIXP16* yOut, FIXP16* zOut,
+	const int num)
+{
+	// transforms num points by the matrix; processes 8 points per iteration;
+	// the tail (num % 8 points) is processed by the SSE kernel
+
+	assert(xIn && yIn && zIn);
+	assert(xOut && yOut && zOut);
+	assert(pM != nullptr);
+	assert(num >= 0);
+
+	const __m256i round = _mm256_set1_epi64x(FIXP16_ROUND_UP);
+
+	const __m256i m00 = _mm256_set1_epi32(pM->M00), m01 = _mm256_set1_epi32(pM->M01), m02 = _mm256_set1_epi32(pM->M02);
+	const __m256i m10 = _mm256_set1_epi32(pM->M10), m11 = _mm256_set1_epi32(pM->M11), m12 = _mm256_set1_epi32(pM->M12);
+	const __m256i m20 = _mm256_set1_epi32(pM->M20), m21 = _mm256_set1_epi32(pM->M21), m22 = _mm256_set1_epi32(pM->M22);
+	const __m256i m30 = _mm256_set1_epi32(pM->M30), m31 = _mm256_set1_epi32(pM->M31), m32 = _mm256_set1_epi32(pM->M32);
+
+	int i = 0;
+
+	for (; i + 8 <= num; i += 8)
+	{
+		const __m256i x = _mm256_loadu_si256((const __m256i*)(xIn + i));
+		const __m256i y = _mm256_loadu_si256((const __m256i*)(yIn + i));
+		const __m256i z = _mm256_loadu_si256((const __m256i*)(zIn + i));
+
+		const __m256i rx = _mm256_add_epi32(FIXP16_Dot3_AVX2(x, y, z, m00, m10, m20, round), m30);
+		const __m256i ry = _mm256_add_epi32(FIXP16_Dot3_AVX2(x, y, z, m01, m11, m21, round), m31);
+		const __m256i rz = _mm256_add_epi32(FIXP16_Dot3_AVX2(x, y, z, m02, m12, m22, round), m32);
+
+		_mm256_storeu_si256((__m256i*)(xOut + i), rx);
+		_mm256_storeu_si256((__m256i*)(yOut + i), ry);
+		_mm256_storeu_si256((__m256i*)(zOut + i), rz);
+	}
+
+	// process the rest of points
+	FIXP16_Mat_Mul_VECTOR3D_4X4_Batch_SSE(xIn + i, yIn + i, zIn + i, pM,
+		xOut + i, yOut + i, zOut + i, num - i);
+
+} // end FIXP16_Mat_Mul_VECTOR3D_4X4_Batch_AVX2
+
+#else
+
+// there is no SIMD support for this platform so use the reference kernel
+
+void FIXP16_Mat_Mul_VECTOR3D_4X4_Batch_SSE(const FIXP16* xIn, const FIXP16* yIn, const FIXP16* zIn,
+	const FIXP16_MATRIX4X4* pM,
+	FIXP16* xOut, FIXP16* yOut, FIXP16* zOut,
+	const int num)
+{
+	FIXP16_Mat_Mul_VECTOR3D_4X4_Batch_Scalar(xIn, yIn, zIn, pM, xOut, yOut, zOut, num);
+}
+
+void FIXP16_Mat_Mul_VECTOR3D_4X4_Batch_AVX2(const FIXP16* xIn, const FIXP16* yIn, const FIXP16* zIn,
+	const FIXP16_MATRIX4X4* pM,
+	FIXP16* xOut, FIXP16* yOut, FIXP16* zOut,
+	const int num)
+{
+	FIXP16_Mat_Mul_VECTOR3D_4X4_Batch_Scalar(xIn, yIn, zIn, pM, xOut, yOut, zOut, num);
+}
+
+#endif // MATHLIB_SIMD_X86
+
+///////////////////////////////////////////////////////////
+
+void FIXP16_Mat_Mul_VECTOR3D_4X4_Batch(const FIXP16* xIn, const FIXP16* yIn, const FIXP16* zIn,
+	const FIXP16_MATRIX4X4* pM,
+	FIXP16* xOut, FIXP16* yOut, FIXP16* zOut,
+	const int num)
+{
+	// transforms num points by the matrix using the best kernel for the current CPU
+
+	switch (SIMD_Get_Level())
+	{
+		case SIMD_LEVEL_AVX2:
+			FIXP16_Mat_Mul_VECTOR3D_4X4_Batch_AVX2(xIn, yIn, zIn, pM, xOut, yOut, zOut, num);
+			break;
+
+		case SIMD_LEVEL_AVX:
+		case SIMD_LEVEL_SSE:
+			FIXP16_Mat_Mul_VECTOR3D_4X4_Batch_SSE(xIn, yIn, zIn, pM, xOut, yOut, zOut, num);
+			break;
+
+		default:
+			FIXP16_Mat_Mul_VECTOR3D_4X4_Batch_Scalar(xIn, yIn, zIn, pM, xOut, yOut, zOut, num);
+	}
+
+} // end FIXP16_Mat_Mul_VECTOR3D_4X4_Batch
+
+} // end namespace MathLib
@@ -0,0 +1,273 @@
+////////////////////////////////////////////////////////////////////////////////////////////
+// Filename:      FixedPoint.h
+// Description:   contains functional for work with fixed-point numbers in format 16.16
+//                (see FIXP16 in MathConstant.h): multiplication/division with 64-bit
+//                intermediates, fixed-point 2D/3D vectors and 4x4 matrices, and
+//                batch transformation of points (scalar, SSE and AVX2 kernels)
+//
+// Created:       17.10.26
+////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <cstdint>
+#include <cassert>
+#include <cmath>
+
+#include "../MathConstant.h"
+#include "../VectorAndPoint/VectorAndPoint.h"
+#include "../Matrix/Matrix.h"
+
+
+namespace MathLib
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                 DATA STRUCTURES
+////////////////////////////////////////////////////////////////////////////////////////////
+
+// 2D vector or point with fixed-point components
+typedef struct FIXP16_VECTOR2D_TYPE
+{
+	union
+	{
+		FIXP16 M[2];
+
+		struct
+		{
+			FIXP16 x;
+			FIXP16 y;
+		};
+	};
+} FIXP16_VECTOR2D, FIXP16_POINT2D, *FIXP16_VECTOR2D_PTR, *FIXP16_POINT2D_PTR;
+
+
+// 3D vector or point with fixed-point components (without w)
+typedef struct FIXP16_VECTOR3D_TYPE
+{
+	union
+	{
+		FIXP16 M[3];
+
+		struct
+		{
+			FIXP16 x;
+			FIXP16 y;
+			FIXP16 z;
+		};
+	};
+} FIXP16_VECTOR3D, FIXP16_POINT3D, *FIXP16_VECTOR3D_PTR, *FIXP16_POINT3D_PTR;
+
+
+// 4x4 matrix with fixed-point elements (used with row vectors as MATRIX4X4)
+typedef struct FIXP16_MATRIX4X4_TYPE
+{
+	union
+	{
+		FIXP16 M[4][4];
+
+		struct
+		{
+			FIXP16 M00, M01, M02, M03;
+			FIXP16 M10, M11, M12, M13;
+			FIXP16 M20, M21, M22, M23;
+			FIXP16 M30, M31, M32, M33;
+		};
+	};
+} FIXP16_MATRIX4X4, *FIXP16_MATRIX4X4_PTR;
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                               INLINE OPERATIONS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+//
+// conversion (with rounding to the nearest, unlike the FLOAT_TO_FIXP16 macro
+// which is correct only for positive numbers)
+//
+inline FIXP16 Float_To_FIXP16(const float f)
+{
+	return (FIXP16)floorf((f * (float)FIXP16_MAG) + 0.5f);
+}
+
+inline float FIXP16_To_Float(const FIXP16 fp)
+{
+	return (float)fp * (1.0f / FIXP16_MAG);
+}
+
+///////////////////////////////////////////////////////////////
+
+//
+// arithmetic; the product of two 16.16 numbers is a 32.32 number so it is computed
+// in 64 bits and rounded back to 16.16 (the sum and difference are just integer ones)
+//
+inline FIXP16 FIXP16_Mul(const FIXP16 a, const FIXP16 b)
+{
+	return (FIXP16)(((int64_t)a * b + FIXP16_ROUND_UP) >> FIXP16_SHIFT);
+}
+
+inline FIXP16 FIXP16_Div(const FIXP16 a, const FIXP16 b)
+{
+	// the dividend is scaled to 32.32 so the quotient is 16.16 (truncated toward zero)
+	assert(b != 0);
+	return (FIXP16)(((int64_t)a * FIXP16_MAG) / b);
+}
+
+///////////////////////////////////////////////////////////////
+
+//
+// 2D vectors
+//
+inline void FIXP16_VECTOR2D_INIT_XY(FIXP16_VECTOR2D & v, const FIXP16 x, const FIXP16 y)
+{
+	v.x = x;
+	v.y = y;
+}
+
+inline void FIXP16_VECTOR2D_Add(const FIXP16_VECTOR2D & va, const FIXP16_VECTOR2D & vb, FIXP16_VECTOR2D & vsum)
+{
+	vsum.x = va.x + vb.x;
+	vsum.y = va.y + vb.y;
+}
+
+inline void FIXP16_VECTOR2D_Sub(const FIXP16_VECTOR2D & va, const FIXP16_VECTOR2D & vb, FIXP16_VECTOR2D & vdiff)
+{
+	vdiff.x = va.x - vb.x;
+	vdiff.y = va.y - vb.y;
+}
+
+inline void FIXP16_VECTOR2D_Scale(const FIXP16 k, FIXP16_VECTOR2D & v)
+{
+	v.x = FIXP16_Mul(k, v.x);
+	v.y = FIXP16_Mul(k, v.y);
+}
+
+inline FIXP16 FIXP16_VECTOR2D_Dot(const FIXP16_VECTOR2D & va, const FIXP16_VECTOR2D & vb)
+{
+	// the products are summed in 64 bits and rounded once
+	return (FIXP16)(((int64_t)va.x * vb.x + (int64_t)va.y * vb.y + FIXP16_ROUND_UP) >> FIXP16_SHIFT);
+}
+
+///////////////////////////////////////////////////////////////
+
+//
+// 3D vectors
+//
+inline void FIXP16_VECTOR3D_INIT_XYZ(FIXP16_VECTOR3D & v, const FIXP16 x, const FIXP16 y, const FIXP16 z)
+{
+	v.x = x;
+	v.y = y;
+	v.z = z;
+}
+
+inline void FIXP16_VECTOR3D_Add(const FIXP16_VECTOR3D & va, const FIXP16_VECTOR3D & vb, FIXP16_VECTOR3D & vsum)
+{
+	vsum.x = va.x + vb.x;
+	vsum.y = va.y + vb.y;
+	vsum.z = va.z + vb.z;
+}
+
+inline void FIXP16_VECTOR3D_Sub(const FIXP16_VECTOR3D & va, const FIXP16_VECTOR3D & vb, FIXP16_VECTOR3D & vdiff)
+{
+	vdiff.x = va.x - vb.x;
+	vdiff.y = va.y - vb.y;
+	vdiff.z = va.z - vb.z;
+}
+
+inline void FIXP16_VECTOR3D_Scale(const FIXP16 k, FIXP16_VECTOR3D & v)
+{
+	v.x = FIXP16_Mul(k, v.x);
+	v.y = FIXP16_Mul(k, v.y);
+	v.z = FIXP16_Mul(k, v.z);
+}
+
+inline FIXP16 FIXP16_VECTOR3D_Dot(const FIXP16_VECTOR3D & va, const FIXP16_VECTOR3D & vb)
+{
+	// the products are summed in 64 bits and rounded once
+	return (FIXP16)(((int64_t)va.x * vb.x + (int64_t)va.y * vb.y + (int64_t)va.z * vb.z + FIXP16_ROUND_UP) >> FIXP16_SHIFT);
+}
+
+inline void FIXP16_VECTOR3D_Cross(const FIXP16_VECTOR3D & va, const FIXP16_VECTOR3D & vb, FIXP16_VECTOR3D & vn)
+{
+	// vn can't be the same as va or vb
+	vn.x = (FIXP16)(((int64_t)va.y * vb.z - (int64_t)va.z * vb.y + FIXP16_ROUND_UP) >> FIXP16_SHIFT);
+	vn.y = (FIXP16)(((int64_t)va.z * vb.x - (int64_t)va.x * vb.z + FIXP16_ROUND_UP) >> FIXP16_SHIFT);
+	vn.z = (FIXP16)(((int64_t)va.x * vb.y - (int64_t)va.y * vb.x + FIXP16_ROUND_UP) >> FIXP16_SHIFT);
+}
+
+///////////////////////////////////////////////////////////////
+
+//
+// conversion between float and fixed-point vectors/matrices
+//
+inline void VECTOR3D_To_FIXP16(const VECTOR3D & v, FIXP16_VECTOR3D & vfp)
+{
+	vfp.x = Float_To_FIXP16(v.x);
+	vfp.y = Float_To_FIXP16(v.y);
+	vfp.z = Float_To_FIXP16(v.z);
+}
+
+inline void FIXP16_To_VECTOR3D(const FIXP16_VECTOR3D & vfp, VECTOR3D & v)
+{
+	v.x = FIXP16_To_Float(vfp.x);
+	v.y = FIXP16_To_Float(vfp.y);
+	v.z = FIXP16_To_Float(vfp.z);
+}
+
+inline void Mat_4X4_To_FIXP16(const MATRIX4X4* pMat, FIXP16_MATRIX4X4* pMatFp)
+{
+	assert(pMat != nullptr);
+	assert(pMatFp != nullptr);
+
+	for (int row = 0; row < 4; row++)
+		for (int col = 0; col < 4; col++)
+			pMatFp->M[row][col] = Float_To_FIXP16(pMat->M[row][col]);
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                            FUNCTIONS PROTOTYPES
+////////////////////////////////////////////////////////////////////////////////////////////
+
+// pMProd = pMatA * pMatB; pMProd can be one of the inputs
+void FIXP16_Mat_Mul_4X4(const FIXP16_MATRIX4X4* pMatA, const FIXP16_MATRIX4X4* pMatB, FIXP16_MATRIX4X4* pMProd);
+
+// pVecProd = pV * pM (w = 1 is assumed as in Mat_Mul_VECTOR3D_4X4)
+void FIXP16_Mat_Mul_VECTOR3D_4X4(const FIXP16_VECTOR3D* pV, const FIXP16_MATRIX4X4* pM, FIXP16_VECTOR3D* pVecProd);
+
+///////////////////////////////////////////////////////////////
+
+//
+// batch transformation of fixed-point points which are stored in SoA form;
+// the results are bit-compatible with FIXP16_Mat_Mul_VECTOR3D_4X4 for each kernel;
+//
+// output streams may be the same as the input streams (in-place transformation),
+// but they must not partially overlap
+//
+
+// chooses the best kernel for the current CPU (see SIMD_Get_Level)
+void FIXP16_Mat_Mul_VECTOR3D_4X4_Batch(const FIXP16* xIn, const FIXP16* yIn, const FIXP16* zIn,
+	const FIXP16_MATRIX4X4* pM,
+	FIXP16* xOut, FIXP16* yOut, FIXP16* zOut,
+	const int num);
+
+// separate kernels (SSE/AVX2 kernels must be called only if the CPU supports them)
+void FIXP16_Mat_Mul_VECTOR3D_4X4_Batch_Scalar(const FIXP16* xIn, const FIXP16* yIn, const FIXP16* zIn,
+	const FIXP16_MATRIX4X4* pM,
+	FIXP16* xOut, FIXP16* yOut, FIXP16* zOut,
+	const int num);
+
+void FIXP16_Mat_Mul_VECTOR3D_4X4_Batch_SSE(const FIXP16* xIn, const FIXP16* yIn, const FIXP16* zIn,
+	const FIXP16_MATRIX4X4* pM,
+	FIXP16* xOut, FIXP16* yOut, FIXP16* zOut,
+	const int num);
+
+void FIXP16_Mat_Mul_VECTOR3D_4X4_Batch_AVX2(const FIXP16* xIn, const FIXP16* yIn, const FIXP16* zIn,
+	const FIXP16_MATRIX4X4* pM,
+	FIXP16* xOut, FIXP16* yOut, FIXP16* zOut,
+	const int num);
+
+} // end namespace MathLib
@@ -6,13 +6,93 @@
 ////////////////////////////////////////////////////////////////////////////////////////////
 #include "Log.h"
 
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+
+#ifdef _WIN32
+	#include <io.h>
+	#include <sys/stat.h>
+#else
+	#include <unistd.h>
+#endif
+
 
 // initialize static members of the Log class
-Log* Log::pInstance_ = nullptr;
-//FILE* Log::pFile_ = nullptr;
-HANDLE Log::handle_ = GetStdHandle(STD_OUTPUT_HANDLE);
-std::ofstream Log::fout_;
-//std::stringstream Log::ss_;
+std::atomic<Log*> Log::pInstance_{ nullptr };
+std::atomic<int>  Log::numUsers_{ 0 };
+
+
+//////////////////////////////////
+//          CONSTANTS
+//////////////////////////////////
+
+// ANSI escape sequences for changing the text colour in the console
+// (they are supported by Linux terminals and by Windows Terminal / Windows 10+ console)
+#define LOG_COLOR_GREEN  "\x1b[32m"
+#define LOG_COLOR_RED    "\x1b[31m"
+#define LOG_COLOR_RESET  "\x1b[0m"
+
+static const int LOG_CONSOLE_FD = 1;             // stdout
+static const int LOG_MAX_BATCH_MESSAGES = 256;   // max number of messages per one write() call
+static const int LOG_MAX_IDLE_SPINS = 64;        // the writer thread yields so many times before sleeping
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                HELPER FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+static int64_t Get_Time_Ms()
+{
+	// returns the wall-clock time in ms since the epoch
+	using namespace std::chrono;
+	return duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
+}
+
+/////////////////////////////////////////////////////////////
+
+static void Time_To_Str(const int64_t timeMs, const char* format, char* buffer, const size_t size)
+{
+	// converts the time into a string of local time using the strftime() format
+
+	const time_t t = (time_t)(timeMs / 1000);
+	tm localTime{};
+
+#ifdef _WIN32
+	localtime_s(&localTime, &t);
+#else
+	localtime_r(&t, &localTime);
+#endif
+
+	strftime(buffer, size, format, &localTime);
+}
+
+/////////////////////////////////////////////////////////////
+
+static void Write_All(const int fd, const char* data, size_t size)
+{
+	// writes the whole data into the file descriptor (write() can write only a part of it)
+
+	while (size > 0)
+	{
+#ifdef _WIN32
+		const int written = _write(fd, data, (unsigned int)size);
+#else
+		const ssize_t written = write(fd, data, size);
+#endif
+
+		if (written <= 0)
+			return;
+
+		data += written;
+		size -= (size_t)written;
+	}
+}
+
 
 
 
@@ -22,18 +102,23 @@ std::ofstream Log::fout_;
 
 Log::Log()
 {
-	if (!pInstance_)   // we can have only one instance of logger
+	if (!pInstance_.load(std::memory_order_acquire))   // we can have only one instance of logger
 	{
-		pInstance_ = this;
+		startTimeMs_ = Get_Time_Ms();
 		Init_Helper();
-		
+
+		// start the writer thread and only after that make the instance visible
+		running_.store(true, std::memory_order_release);
+		writer_ = std::thread(&Log::Writer_Thread, this);
+		pInstance_.store(this, std::memory_order_release);
 
 		Log::Print(__FUNCTION__, __LINE__, "a log system is initialized successfully");
 	}
 	else
 	{
-		std::string errorMsg{ "Log::Log(): can't create an instance of the Log class" };
-		std::cout << errorMsg << std::endl;
+		const std::string errorMsg{ "Log::Log(): can't create an instance of the Log class" };
+		const std::string message = errorMsg + "\n";
+		Write_All(LOG_CONSOLE_FD, message.c_str(), message.size());
 		throw std::runtime_error(errorMsg);
 	}
 }
@@ -42,13 +127,30 @@ Log::Log()
 
 Log::~Log()
 {
-	if (fout_.is_open())
+	// the next messages will be written at once; the threads which got the instance
+	// before are waited for (their messages are still put into the queue, and the writer
+	// thread is running so a full queue is drained), and then the writer thread writes
+	// all the messages from the queue before its exit
+	pInstance_.store(nullptr, std::memory_order_seq_cst);
+
+	while (numUsers_.load(std::memory_order_seq_cst) > 0)
+	{
+		std::this_thread::yield();
+	}
+
+	running_.store(false, std::memory_order_release);
+	Wake_Writer();
+
+	if (writer_.joinable())
+		writer_.join();
+
+	if (fileDesc_ >= 0)
 	{
 		Close_Helper();
 	}
 
-	std::string message{ "Log::~Log(): the log system is destroyed" };
-	std::cout << message << std::endl;
+	const std::string message{ "Log::~Log(): the log system is destroyed\n" };
+	Write_All(LOG_CONSOLE_FD, message.c_str(), message.size());
 }
 
 /////////////////////////////////////////////////////////////
@@ -56,7 +158,7 @@ Log::~Log()
 Log* Log::Get()
 {
 	// returns a pointe to the instance of the Log class
-	return Log::pInstance_;
+	return Log::pInstance_.load(std::memory_order_acquire);
 }
 
 /////////////////////////////////////////////////////////////
@@ -67,14 +169,7 @@ void Log::Print(const char* message)
 
 	assert((message != nullptr) && (message[0] != '\0'));
 
-	SetConsoleTextAttribute(Log::handle_, 0x000A); // set console text color to green
-
-	std::stringstream ss;
-	ss << message;
-	Print_Helper("", ss.str().c_str());
-
-	SetConsoleTextAttribute(Log::handle_, 0x0007); // set console text color back to white
-
+	Push_Message(LOG_LEVEL_PRINT, nullptr, 0, message, strlen(message));
 
 } // end Print
 
@@ -87,13 +182,7 @@ void Log::Print(const char* funcName, const int codeLine, const std::string & me
 	assert(funcName != nullptr);
 	assert(!message.empty());
 
-	SetConsoleTextAttribute(Log::handle_, 0x000A); // set console text color to green
-
-	std::stringstream ss;
-	ss << funcName << "() (line: " << codeLine << "): " << message;
-	Print_Helper("", ss.str().c_str());
-
-	SetConsoleTextAttribute(Log::handle_, 0x0007); // set console text color back to white
+	Push_Message(LOG_LEVEL_PRINT, funcName, codeLine, message.c_str(), message.size());
 	
 } // end Print
 
@@ -106,7 +195,7 @@ void Log::Print(const char* funcName, const int codeLine, const char* message)
 	assert(funcName != nullptr);
 	assert((message != nullptr) && (message[0] != '\0'));
 	
-	Log::Print(funcName, codeLine, (std::string)message);
+	Push_Message(LOG_LEVEL_PRINT, funcName, codeLine, message, strlen(message));
 
 } // end Print
 
@@ -121,9 +210,7 @@ void Log::Debug(const char* funcName, const int codeLine, const std::string & me
 	assert(funcName != nullptr);
 	assert(!message.empty());
 
-	std::stringstream ss;
-	ss << funcName << "() (line: " << codeLine << "): " << message;
-	Print_Helper("DEBUG: ", ss.str().c_str());
+	Push_Message(LOG_LEVEL_DEBUG, funcName, codeLine, message.c_str(), message.size());
 
 #endif
 
@@ -140,7 +227,7 @@ void Log::Debug(const char* funcName, const int codeLine, const char* message)
 	assert(funcName != nullptr);
 	assert((message != nullptr) && (message[0] != '\0'));
 
-	Log::Debug(funcName, codeLine, (std::string)message);
+	Push_Message(LOG_LEVEL_DEBUG, funcName, codeLine, message, strlen(message));
 	
 #endif
 
@@ -155,13 +242,7 @@ void Log::Error(const char* funcName, const int codeLine, const std::string & me
 	assert(funcName != nullptr);
 	assert(!message.empty());
 
-	SetConsoleTextAttribute(Log::handle_, 0x0004);   // set console text color to red
-
-	std::stringstream ss;
-	ss << funcName << "() (line: " << codeLine << "): " << message;
-	Print_Helper("ERROR: ", ss.str().c_str());
-
-	SetConsoleTextAttribute(Log::handle_, 0x0007);   // set console text color back to white
+	Push_Message(LOG_LEVEL_ERROR, funcName, codeLine, message.c_str(), message.size());
 
 } // end Error
 
@@ -174,10 +255,33 @@ void Log::Error(const char* funcName, const int codeLine, const char* message)
 	assert(funcName != nullptr);
 	assert((message != nullptr) && (message[0] != '\0'));
 	
-	Log::Error(funcName, codeLine, (std::string)message);
+	Push_Message(LOG_LEVEL_ERROR, funcName, codeLine, message, strlen(message));
 
 } // end Error
 
+/////////////////////////////////////////////////////////////
+
+void Log::Flush()
+{
+	// this function waits until the writer thread writes all the messages
+	// which were put into the queue before this call
+
+	Log* pLog = Acquire_Instance();
+
+	if (!pLog)
+		return;
+
+	const size_t numPushed = pLog->queue_.Num_Pushed();
+
+	while (pLog->numWritten_.load(std::memory_order_acquire) < numPushed)
+	{
+		std::this_thread::yield();
+	}
+
+	Release_Instance();
+
+} // end Flush
+
 
 
 
@@ -187,76 +291,287 @@ void Log::Error(const char* funcName, const int codeLine, const char* message)
 //                                PRIVATE FUNCTIONS
 ////////////////////////////////////////////////////////////////////////////////////////////
 
-void Log::Init_Helper()
+Log* Log::Acquire_Instance()
 {
-	// create, open a logger text file, and print a message about it
+	// the counter is increased before the pointer is read, and ~Log clears the pointer
+	// before it reads the counter; both are seq_cst so at least one of the threads sees
+	// the other: either we get nullptr or ~Log waits for our Release_Instance()
+
+	numUsers_.fetch_add(1, std::memory_order_seq_cst);
+
+	Log* pLog = pInstance_.load(std::memory_order_seq_cst);
+
+	if (!pLog)
+		numUsers_.fetch_sub(1, std::memory_order_release);
+
+	return pLog;
+
+} // end Acquire_Instance
+
+/////////////////////////////////////////////////////////////
+
+void Log::Release_Instance()
+{
+	numUsers_.fetch_sub(1, std::memory_order_release);
+}
 
-	try
+/////////////////////////////////////////////////////////////
+
+void Log::Push_Message(const LOG_LEVEL level,
+	const char* funcName,
+	const int codeLine,
+	const char* text,
+	const size_t length)
+{
+	// puts a message into the queue; only the strings are copied here, and all the formatting
+	// is done by the writer thread; if the queue is full we wait for free space
+	// so no messages are lost
+
+	Log* pLog = Acquire_Instance();
+
+	if (!pLog)
 	{
-		fout_.open(this->logFilename_, std::ofstream::out);
+		// there is no log system (or it is being destroyed) so write the message into the console at once
+		LOG_MESSAGE msg;
+		std::string consoleText, fileText;
+
+		Log_Fill_Message(msg, level, funcName, codeLine, Get_Time_Ms(), text, length);
+		Format_Message(msg, msg.timeMs, consoleText, fileText);
+		Write_All(LOG_CONSOLE_FD, consoleText.c_str(), consoleText.size());
+		return;
+	}
 
-		if (fout_.is_open())
-		{
-			std::cout << "Log::InitHelper(): the log file is created successfully" << std::endl;
+	const int64_t timeMs = Get_Time_Ms();
 
-			char time[9]{ '\0' };
-			char date[9]{ '\0' };
+	while (!pLog->queue_.Try_Push(level, funcName, codeLine, timeMs, text, length))
+	{
+		std::this_thread::yield();
+	}
 
-			_strtime_s(time, 9);
-			_strdate_s(date, 9);
+	// the writer thread announces its sleep and then checks the queue once again, and
+	// we check the announcement after the push; the fences guarantee that at least
+	// one of them sees the other's store, so the message can't be left unnoticed
+	std::atomic_thread_fence(std::memory_order_seq_cst);
 
-			fout_ << time << ":" << date << ":\t the log file is created\n";
-			fout_ << "--------------------------------------------\n\n";
-		}
+	if (pLog->writerSleeping_.load(std::memory_order_relaxed))
+		pLog->Wake_Writer();
+
+	Release_Instance();
+
+} // end Push_Message
+
+/////////////////////////////////////////////////////////////
+
+void Log::Format_Message(const LOG_MESSAGE & msg,
+	const int64_t startTimeMs,
+	std::string & consoleText,
+	std::string & fileText)
+{
+	// makes the final text of the message and appends it to the output texts:
+	//
+	//   time::ms|\t[DEBUG: |ERROR: ][funcName() (line: N): ]message
+	//
+	// (ms is the number of milliseconds since the log system start)
+
+	static const char* levelText[] = { "", "DEBUG: ", "ERROR: " };
+	static const char* levelColor[] = { LOG_COLOR_GREEN, "", LOG_COLOR_RED };
+
+	char time[9]{ '\0' };
+	char prefix[512]{ '\0' };
+
+	Time_To_Str(msg.timeMs, "%H:%M:%S", time, sizeof(time));
+
+	int prefixLen = 0;
+
+	if (msg.funcName[0] != '\0')
+	{
+		prefixLen = snprintf(prefix, sizeof(prefix), "%s::%lld|\t%s%s() (line: %d): ",
+			time, (long long)(msg.timeMs - startTimeMs), levelText[msg.level], msg.funcName, msg.codeLine);
 	}
-	catch (std::ofstream::failure & e)
+	else
 	{
-		std::cout << "Exception: " << e.what() << std::endl;
-		std::cout << "Log::InitHelper(): can't open/write the log file" << std::endl;
+		prefixLen = snprintf(prefix, sizeof(prefix), "%s::%lld|\t%s",
+			time, (long long)(msg.timeMs - startTimeMs), levelText[msg.level]);
 	}
 
-} // end Init_Helper
+	// snprintf returns the length of the whole text even if it is truncated
+	if (prefixLen >= (int)sizeof(prefix))
+		prefixLen = (int)sizeof(prefix) - 1;
 
-  /////////////////////////////////////////////////////////////
+	const bool colored = (levelColor[msg.level][0] != '\0');
 
-void Log::Close_Helper()
+	if (colored)
+		consoleText.append(levelColor[msg.level]);
+
+	consoleText.append(prefix, prefixLen);
+	consoleText.append(msg.text, msg.length);
+
+	if (colored)
+		consoleText.append(LOG_COLOR_RESET);
+
+	consoleText.push_back('\n');
+
+	fileText.append(prefix, prefixLen);
+	fileText.append(msg.text, msg.length);
+	fileText.push_back('\n');
+
+} // end Format_Message
+
+/////////////////////////////////////////////////////////////
+
+void Log::Writer_Thread()
 {
-	// print message about closing of the logger file
+	// takes messages from the queue, formats them and writes them by batches:
+	// one write() call per batch for the console and one for the log file
+
+	std::string consoleText;
+	std::string fileText;
+	int numIdleLoops = 0;
+
+	consoleText.reserve(64 * 1024);
+	fileText.reserve(64 * 1024);
 
-	try
+	for (;;)
 	{
-		char time[9]{ '\0' };
-		char date[9]{ '\0' };
+		int numMessages = 0;
 
-		_strtime_s(time, 9);
-		_strdate_s(date, 9);
+		while (numMessages < LOG_MAX_BATCH_MESSAGES)
+		{
+			const LOG_MESSAGE* pMsg = queue_.Front();
+
+			if (!pMsg)
+				break;
 
-		fout_ << "\n\n--------------------------------------------\n";
-		fout_ << time << ":" << date << ":\t the end of the log file\n";
-		fout_ << std::endl;
+			Format_Message(*pMsg, startTimeMs_, consoleText, fileText);
+			queue_.Pop();
+			numMessages++;
+		}
+
+		if (numMessages > 0)
+		{
+			Write_All(LOG_CONSOLE_FD, consoleText.c_str(), consoleText.size());
 
-		// close the log file
-		fout_.close();
+			if (fileDesc_ >= 0)
+				Write_All(fileDesc_, fileText.c_str(), fileText.size());
+
+			consoleText.clear();
+			fileText.clear();
+
+			numWritten_.fetch_add(numMessages, std::memory_order_release);
+			numIdleLoops = 0;
+			continue;
+		}
+
+		// the queue is empty: exit if the log system is destroyed
+		// (the queue is checked once again since a message could come just now)
+		if (!running_.load(std::memory_order_acquire))
+		{
+			if (queue_.Front() == nullptr)
+				break;
+
+			continue;
+		}
+
+		// wait for messages: spin for a while (a fast path for bursts of messages)
+		if (++numIdleLoops < LOG_MAX_IDLE_SPINS)
+		{
+			std::this_thread::yield();
+			continue;
+		}
+
+		// and then sleep until a producer (or the destructor) wakes us up
+		std::unique_lock<std::mutex> lock(wakeMutex_);
+
+		writerSleeping_.store(true, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		if ((queue_.Front() == nullptr) && running_.load(std::memory_order_acquire))
+		{
+			wakeCond_.wait(lock, [this] { return !writerSleeping_.load(std::memory_order_relaxed); });
+		}
+
+		writerSleeping_.store(false, std::memory_order_relaxed);
+		numIdleLoops = 0;
 	}
-	catch (std::ofstream::failure & e)
+
+} // end Writer_Thread
+
+/////////////////////////////////////////////////////////////
+
+void Log::Wake_Writer()
+{
+	// wakes the writer thread if it is sleeping; the flag is changed under
+	// the mutex so the notification can't come between its check and its wait
+
 	{
-		std::cout << "Exception: " << e.what() << std::endl;
-		std::cout << "Log::InitHelper(): can't write/close the log file" << std::endl;
+		std::lock_guard<std::mutex> lock(wakeMutex_);
+		writerSleeping_.store(false, std::memory_order_relaxed);
 	}
 
-} // end Close_Helper
+	wakeCond_.notify_one();
+
+} // end Wake_Writer
 
 /////////////////////////////////////////////////////////////
 
-void Log::Print_Helper(const char* levtext, const char* text)
+void Log::Init_Helper()
 {
-	// prints a message into the command prompt and into the log file
-	clock_t cl = clock();
+	// create, open a logger text file, and print a message about it
+
+#ifdef _WIN32
+	fileDesc_ = _open(this->logFilename_, _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+	fileDesc_ = open(this->logFilename_, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+#endif
+
+	if (fileDesc_ < 0)
+	{
+		const std::string message{ "Log::InitHelper(): can't open/write the log file\n" };
+		Write_All(LOG_CONSOLE_FD, message.c_str(), message.size());
+		return;
+	}
+
+	const std::string message{ "Log::InitHelper(): the log file is created successfully\n" };
+	Write_All(LOG_CONSOLE_FD, message.c_str(), message.size());
+
+	char time[9]{ '\0' };
+	char date[9]{ '\0' };
+
+	Time_To_Str(startTimeMs_, "%H:%M:%S", time, sizeof(time));
+	Time_To_Str(startTimeMs_, "%m/%d/%y", date, sizeof(date));
+
+	std::string header = std::string(time) + ":" + date + ":\t the log file is created\n";
+	header += "--------------------------------------------\n\n";
+
+	Write_All(fileDesc_, header.c_str(), header.size());
+
+} // end Init_Helper
+
+  /////////////////////////////////////////////////////////////
+
+void Log::Close_Helper()
+{
+	// print message about closing of the logger file, and close it
+
 	char time[9]{ '\0' };
+	char date[9]{ '\0' };
+	const int64_t timeMs = Get_Time_Ms();
+
+	Time_To_Str(timeMs, "%H:%M:%S", time, sizeof(time));
+	Time_To_Str(timeMs, "%m/%d/%y", date, sizeof(date));
 
-	_strtime_s(time, 9);
-	std::cout << time << "::" << cl << "|\t" << levtext << text << std::endl;
-	fout_ << time << "::" << cl << "|\t" << levtext << text << std::endl;
-	fout_.flush();
+	std::string footer = "\n\n--------------------------------------------\n";
+	footer += std::string(time) + ":" + date + ":\t the end of the log file\n\n";
 
-} // end Print_Helper
\ No newline at end of file
+	Write_All(fileDesc_, footer.c_str(), footer.size());
+
+	// close the log file
+#ifdef _WIN32
+	_close(fileDesc_);
+#else
+	close(fileDesc_);
+#endif
+
+	fileDesc_ = -1;
+
+} // end Close_Helper
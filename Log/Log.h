@@ -1,6 +1,10 @@
 ////////////////////////////////////////////////////////////////////////////////////////////
 // Filename:    Log.h
-// Description: there is a log system header
+// Description: there is a log system header;
+//
+//              messages are put into a lock-free queue (see LogQueue.h) and the
+//              background writer thread formats them and writes them into the console
+//              and into the log file by batches, so the calling thread doesn't wait for I/O
 //
 // Created:     19.09.23
 ////////////////////////////////////////////////////////////////////////////////////////////
@@ -16,15 +20,19 @@
 //////////////////////////////////
 //          INCLUDES
 //////////////////////////////////
-#define WIN32_LEAN_AND_MEAN
-#include <windows.h>
-
 #include <iostream>    // for using I/O streams
 #include <ctime>
 #include <cassert>
 #include <string>
 #include <fstream>
 #include <sstream>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "LogQueue.h"
+
 
 class Log
 {
@@ -34,7 +42,7 @@ public:
 
 	static Log* Get();    // to get a static pointer to this class instance
 
-	// print messages of different kinds
+	// print messages of different kinds (funcName and message are copied, so they may be temporary)
 	static void Print(const char* message);
 	static void Print(const char* funcName, const int codeLine, const std::string & message);
 	static void Print(const char* funcName, const int codeLine, const char* message);
@@ -43,19 +51,54 @@ public:
 	static void Error(const char* funcName, const int codeLine, const std::string & message);
 	static void Error(const char* funcName, const int codeLine, const char* message);
 
+	// waits until all the messages which are printed before are written
+	static void Flush();
+
 
 private:
-	static void Print_Helper(const char* levtext, const char* text); // prints a message(text) into the command prompt and into the log file
-	void Init_Helper();   // create, open a logger text file, and print a message about it
-	void Close_Helper();  // close the logger file, and print a message about it
+	// registers the calling thread as a user of the instance and returns it (or nullptr if
+	// there is no log system); each non-null result must be followed by Release_Instance()
+	static Log* Acquire_Instance();
+	static void Release_Instance();
+
+	// puts a message into the queue (or writes it at once if there is no log system yet)
+	static void Push_Message(const LOG_LEVEL level,
+		const char* funcName,
+		const int codeLine,
+		const char* text,
+		const size_t length);
+
+	// makes the final text of the message for the console (with colors) and for the file
+	static void Format_Message(const LOG_MESSAGE & msg,
+		const int64_t startTimeMs,
+		std::string & consoleText,
+		std::string & fileText);
+
+	void Writer_Thread();  // takes messages from the queue and writes them by batches
+	void Wake_Writer();    // wakes the writer thread if it is sleeping (after a push or at the exit)
+	void Init_Helper();    // create, open a logger text file, and print a message about it
+	void Close_Helper();   // close the logger file, and print a message about it
 
 private:
-	static HANDLE handle_;   // we need it for changing the text colour in the command prompt
-	static Log* pInstance_;  // a pointer to the instance of this class
-	static std::ofstream fout_;
+	static std::atomic<Log*> pInstance_;     // a pointer to the instance of this class
+	static std::atomic<int>  numUsers_;      // the number of threads which use the instance now
+
+	static constexpr size_t QUEUE_CAPACITY = 4096;  // max number of messages waiting for writing
+
+	LogQueue           queue_{ QUEUE_CAPACITY };
+	std::thread        writer_;
+	std::atomic<bool>  running_{ false };
+	std::atomic<size_t> numWritten_{ 0 };   // the number of messages which are written
+
+	// the idle writer thread sleeps on the condition variable until a producer wakes it
+	std::mutex              wakeMutex_;
+	std::condition_variable wakeCond_;
+	std::atomic<bool>       writerSleeping_{ false };
+
+	int fileDesc_ = -1;    // a descriptor of the log file
+	int64_t startTimeMs_ = 0;
+
 private:
 	const char* logFilename_{ "log_math_lib.txt" };
 	
 };
-
-
@@ -0,0 +1,186 @@
+////////////////////////////////////////////////////////////////////////////////////////////
+// Filename:    LogQueue.h
+// Description: there is a lock-free bounded queue of log messages for many producers
+//              (any threads which print messages) and a single consumer (the writer
+//              thread of the log system); it is a ring buffer where each slot has
+//              a sequence number (D. Vyukov's bounded queue)
+//
+// Created:     17.10.26
+////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <cassert>
+#include <memory>
+
+
+//////////////////////////////////
+//          CONSTANTS
+//////////////////////////////////
+constexpr int LOG_MESSAGE_MAX_LEN   = 1024;   // longer messages are truncated
+constexpr int LOG_FUNC_NAME_MAX_LEN = 128;    // longer function names are truncated
+
+
+//////////////////////////////////
+//       DATA STRUCTURES
+//////////////////////////////////
+enum LOG_LEVEL
+{
+	LOG_LEVEL_PRINT = 0,
+	LOG_LEVEL_DEBUG = 1,
+	LOG_LEVEL_ERROR = 2,
+};
+
+// a message is stored unformatted: the writer thread makes the final text;
+// the function name and the text are copied so the caller's strings may be temporary
+struct LOG_MESSAGE
+{
+	LOG_LEVEL   level;
+	char        funcName[LOG_FUNC_NAME_MAX_LEN];   // empty for messages without a function name and a line
+	int         codeLine;
+	int64_t     timeMs;       // wall-clock time in ms since the epoch
+	int         length;
+	char        text[LOG_MESSAGE_MAX_LEN];
+};
+
+
+//////////////////////////////////
+//          FUNCTIONS
+//////////////////////////////////
+
+// fills the message (funcName may be nullptr; the text isn't null-terminated)
+inline void Log_Fill_Message(LOG_MESSAGE & msg,
+	const LOG_LEVEL level,
+	const char* funcName,
+	const int codeLine,
+	const int64_t timeMs,
+	const char* text,
+	const size_t length)
+{
+	const size_t len = (length < LOG_MESSAGE_MAX_LEN) ? length : LOG_MESSAGE_MAX_LEN;
+
+	msg.level = level;
+	msg.codeLine = codeLine;
+	msg.timeMs = timeMs;
+	msg.length = (int)len;
+	memcpy(msg.text, text, len);
+
+	if (funcName)
+	{
+		strncpy(msg.funcName, funcName, LOG_FUNC_NAME_MAX_LEN - 1);
+		msg.funcName[LOG_FUNC_NAME_MAX_LEN - 1] = '\0';
+	}
+	else
+	{
+		msg.funcName[0] = '\0';
+	}
+}
+
+
+class LogQueue
+{
+public:
+	explicit LogQueue(const size_t capacity) :
+		capacity_(capacity),
+		mask_(capacity - 1),
+		slots_(new SLOT[capacity])
+	{
+		// the capacity must be a power of 2 so the index is computed by masking
+		assert((capacity >= 2) && ((capacity & (capacity - 1)) == 0));
+
+		for (size_t i = 0; i < capacity_; i++)
+			slots_[i].sequence.store(i, std::memory_order_relaxed);
+	}
+
+	LogQueue(const LogQueue&) = delete;
+	LogQueue& operator=(const LogQueue&) = delete;
+
+	///////////////////////////////////////////////////////////
+
+	// (any thread) puts a message into the queue;
+	// returns false if the queue is full
+	bool Try_Push(const LOG_LEVEL level,
+		const char* funcName,
+		const int codeLine,
+		const int64_t timeMs,
+		const char* text,
+		const size_t length)
+	{
+		SLOT* pSlot = nullptr;
+		size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+
+		for (;;)
+		{
+			pSlot = &slots_[pos & mask_];
+			const size_t seq = pSlot->sequence.load(std::memory_order_acquire);
+			const intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+
+			if (diff == 0)
+			{
+				// the slot is free: try to take it
+				if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					break;
+			}
+			else if (diff < 0)
+			{
+				// the slot still has a message which isn't written yet
+				return false;
+			}
+			else
+			{
+				// another producer has taken this slot
+				pos = enqueuePos_.load(std::memory_order_relaxed);
+			}
+		}
+
+		Log_Fill_Message(pSlot->msg, level, funcName, codeLine, timeMs, text, length);
+
+		// publish the message to the consumer
+		pSlot->sequence.store(pos + 1, std::memory_order_release);
+
+		return true;
+	}
+
+	///////////////////////////////////////////////////////////
+
+	// (consumer only) returns the oldest message or nullptr if the queue is empty;
+	// the message stays in the queue until Pop() is called
+	const LOG_MESSAGE* Front() const
+	{
+		const SLOT & slot = slots_[dequeuePos_ & mask_];
+
+		if (slot.sequence.load(std::memory_order_acquire) != dequeuePos_ + 1)
+			return nullptr;
+
+		return &slot.msg;
+	}
+
+	// (consumer only) releases the slot of the oldest message
+	void Pop()
+	{
+		SLOT & slot = slots_[dequeuePos_ & mask_];
+
+		slot.sequence.store(dequeuePos_ + capacity_, std::memory_order_release);
+		dequeuePos_++;
+	}
+
+	// the number of messages which were pushed (for waiting until all of them are written)
+	size_t Num_Pushed() const { return enqueuePos_.load(std::memory_order_acquire); }
+
+private:
+	struct SLOT
+	{
+		std::atomic<size_t> sequence;
+		LOG_MESSAGE msg;
+	};
+
+	const size_t capacity_;
+	const size_t mask_;
+	std::unique_ptr<SLOT[]> slots_;
+
+	// the producers' and the consumer's positions are in different cache lines
+	alignas(64) std::atomic<size_t> enqueuePos_{ 0 };
+	alignas(64) size_t dequeuePos_ = 0;
+};
@@ -31,14 +31,14 @@ typedef int* FIXP16_PTR;
 
 // extracting of integer and fractional part of the fixed-point number in format 16.16
 #define FIXP16_WP(fp) ((fp) >> FIXP16_SHIFT)
-#define FIXP16_DP(fp) ((fp) && FIXP16_DP_MASK)
+#define FIXP16_DP(fp) ((fp) & FIXP16_DP_MASK)
 
 // conversion of integer number and float number into fixed-point numbers in format 16.16
-#define INT_TO_FIXP16(i) ((i) << FIXP16_SHIFT)
-#define FLOAT_TO_FIXP16(f) (((float)(f) * (float)FIXP16_MAG + 0.5f))
+#define INT_TO_FIXP16(i) ((FIXP16)(i) * FIXP16_MAG)     // (a shift of a negative value is undefined)
+#define FLOAT_TO_FIXP16(f) ((FIXP16)((float)(f) * (float)FIXP16_MAG + 0.5f))
 
 // conversion of fixed-point number into a float number
-#define FIXP16_TO_FLOAT(fp) ( ((float)fp) / FIXP16_MAG )
+#define FIXP16_TO_FLOAT(fp) ( ((float)(fp)) / FIXP16_MAG )
 
 
 
@@ -167,7 +167,7 @@ typedef struct MATRIX1X2_TYPE
 ////////////////////////////////////////////////////////////////////////////////////////////////
 
 // identity matrix 4x4
-_declspec(selectany) MATRIX4X4 IMAT_4X4 =
+inline MATRIX4X4 IMAT_4X4 =
 {
 	1, 0, 0, 0,
 	0, 1, 0, 0,
@@ -179,7 +179,7 @@ _declspec(selectany) MATRIX4X4 IMAT_4X4 =
 // identity matrix 4x3
 // (used under the assumption that the fourth 
 // column is always equal to [0 0 0 1])
-_declspec(selectany) MATRIX4X3 IMAT_4X3 =
+inline MATRIX4X3 IMAT_4X3 =
 {
 	1, 0, 0,
 	0, 1, 0,
@@ -189,7 +189,7 @@ _declspec(selectany) MATRIX4X3 IMAT_4X3 =
 
 
 // identity matrix 3x3
-_declspec(selectany) MATRIX3X3 IMAT_3X3 =
+inline MATRIX3X3 IMAT_3X3 =
 {
 	1, 0, 0,
 	0, 1, 0,
@@ -198,7 +198,7 @@ _declspec(selectany) MATRIX3X3 IMAT_3X3 =
 
 
 // identity matrix 2x2
-_declspec(selectany) MATRIX2X2 IMAT_2X2 =
+inline MATRIX2X2 IMAT_2X2 =
 {
 	1, 0,
 	0, 1
@@ -287,7 +287,7 @@ inline void MAT_TRANSPOSE_4X4(MATRIX4X4* pMat)
 	mt.M20 = pMat->M02;  mt.M21 = pMat->M12;
 	mt.M22 = pMat->M22;  mt.M23 = pMat->M32;
 	mt.M30 = pMat->M03;  mt.M31 = pMat->M13;
-	mt.M32 = pMat->M22;  mt.M33 = pMat->M33;
+	mt.M32 = pMat->M23;  mt.M33 = pMat->M33;
 	memcpy((void*)pMat, (void*)&mt, sizeof(MATRIX4X4));
 }
 
@@ -317,7 +317,7 @@ inline void MAT_TRANSPOSE_4X4(const MATRIX4X4* pMatSrc, MATRIX4X4* pMatDst)
 	pMatDst->M20 = pMatSrc->M02;  pMatDst->M21 = pMatSrc->M12;
 	pMatDst->M22 = pMatSrc->M22;  pMatDst->M23 = pMatSrc->M32;
 	pMatDst->M30 = pMatSrc->M03;  pMatDst->M31 = pMatSrc->M13;
-	pMatDst->M32 = pMatSrc->M22;  pMatDst->M33 = pMatSrc->M33;
+	pMatDst->M32 = pMatSrc->M23;  pMatDst->M33 = pMatSrc->M33;
 }
 
 ///////////////////////////////////////////////////////////////
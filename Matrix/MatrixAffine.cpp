@@ -0,0 +1,306 @@
+////////////////////////////////////////////////////////////////////////////////////////////
+// Filename:      MatrixAffine.cpp
+// Description:   contains implementation of functional for work with affine
+//                transformations which are stored in MATRIX4X3
+//
+// Created:       17.10.26
+////////////////////////////////////////////////////////////////////////////////////////////
+#include "MatrixAffine.h"
+#include "MatrixBatch.h"
+
+
+namespace MathLib
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                         INITIALIZATION AND CONVERSION
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void Mat_Init_4X3(MATRIX4X3* pMat,
+	const float m00, const float m01, const float m02,
+	const float m10, const float m11, const float m12,
+	const float m20, const float m21, const float m22,
+	const float m30, const float m31, const float m32)
+{
+	// this function initializes the matrix pMat with passed elements
+
+	assert(pMat != nullptr);
+
+	pMat->M00 = m00; pMat->M01 = m01; pMat->M02 = m02;
+	pMat->M10 = m10; pMat->M11 = m11; pMat->M12 = m12;
+	pMat->M20 = m20; pMat->M21 = m21; pMat->M22 = m22;
+	pMat->M30 = m30; pMat->M31 = m31; pMat->M32 = m32;
+
+} // end Mat_Init_4X3
+
+///////////////////////////////////////////////////////////
+
+void Mat_4X4_To_4X3(const MATRIX4X4* pMat, MATRIX4X3* pMat4x3)
+{
+	// this function copies the first three columns of 4x4 matrix into 4x3 matrix;
+	// the last column of pMat is supposed to be [0 0 0 1]t
+
+	assert(pMat != nullptr);
+	assert(pMat4x3 != nullptr);
+
+	for (int row = 0; row < 4; row++)
+	{
+		pMat4x3->M[row][0] = pMat->M[row][0];
+		pMat4x3->M[row][1] = pMat->M[row][1];
+		pMat4x3->M[row][2] = pMat->M[row][2];
+	}
+
+} // end Mat_4X4_To_4X3
+
+///////////////////////////////////////////////////////////
+
+void Mat_4X3_To_4X4(const MATRIX4X3* pMat, MATRIX4X4* pMat4x4)
+{
+	// this function makes a 4x4 matrix from 4x3 matrix with the last column [0 0 0 1]t
+
+	assert(pMat != nullptr);
+	assert(pMat4x4 != nullptr);
+
+	for (int row = 0; row < 4; row++)
+	{
+		pMat4x4->M[row][0] = pMat->M[row][0];
+		pMat4x4->M[row][1] = pMat->M[row][1];
+		pMat4x4->M[row][2] = pMat->M[row][2];
+		pMat4x4->M[row][3] = 0.0f;
+	}
+
+	pMat4x4->M33 = 1.0f;
+
+} // end Mat_4X3_To_4X4
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                          COMPOSITION AND INVERSE
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void Mat_Mul_4X3(const MATRIX4X3* pMatA, const MATRIX4X3* pMatB, MATRIX4X3* pMProd)
+{
+	// this function multiplies two affine 4x3 matrices as if they were 4x4 matrices
+	// with the last column [0 0 0 1]t, so the product has the same form:
+	//
+	//    rows 0..2:  prod[i][j] = sum_k(a[i][k] * b[k][j])            (k = 0..2)
+	//    row 3:      prod[3][j] = sum_k(a[3][k] * b[k][j]) + b[3][j]
+	//
+	// it takes 36 mul + 30 add instead of 64 mul + 48 add of Mat_Mul_4X4
+
+	assert(pMatA != nullptr);
+	assert(pMatB != nullptr);
+	assert(pMProd != nullptr);
+
+	// compute into a temporary matrix since pMProd can be one of the inputs
+	MATRIX4X3 prod;
+
+	for (int i = 0; i < 4; i++)
+	{
+		for (int j = 0; j < 3; j++)
+		{
+			float sum = 0.0f;
+
+			for (int k = 0; k < 3; k++)
+			{
+				sum += pMatA->M[i][k] * pMatB->M[k][j];
+			}
+
+			prod.M[i][j] = sum;
+		}
+	}
+
+	// add the translation of pMatB
+	prod.M30 += pMatB->M30;
+	prod.M31 += pMatB->M31;
+	prod.M32 += pMatB->M32;
+
+	MAT_COPY_4X3(&prod, pMProd);
+
+} // end Mat_Mul_4X3
+
+///////////////////////////////////////////////////////////
+
+int Mat_Inverse_4X3(const MATRIX4X3* pM, MATRIX4X3* pMi)
+{
+	// this function computes an inverse of an affine 4x3 matrix:
+	// the 3x3 part is inverted using m-1 = adjoint(m) / det(m), and
+	// the translation is -t * inverse(3x3);
+	//
+	// if the inverse matrix exists the function returns 1;
+	// in another case it returns 0, and the matrix pMi is a zero matrix;
+
+	assert(pM != nullptr);
+	assert(pMi != nullptr);
+
+	float det = ( pM->M00 * (pM->M11 * pM->M22 - pM->M21 * pM->M12) -
+	              pM->M01 * (pM->M10 * pM->M22 - pM->M20 * pM->M12) +
+	              pM->M02 * (pM->M10 * pM->M21 - pM->M20 * pM->M11) );
+
+	// test determinate to see if it it 0
+	if (fabs(det) < EPSILON_E5)
+	{
+		MATRIX_ZERO_4X3(pMi);
+		return 0;
+	}
+
+	float det_inv = 1.0f / det;
+
+	// compute into a temporary matrix since pMi can be the same as pM
+	MATRIX4X3 mi;
+
+	mi.M00 =  det_inv * (pM->M11*pM->M22 - pM->M12*pM->M21);
+	mi.M01 = -det_inv * (pM->M01*pM->M22 - pM->M02*pM->M21);
+	mi.M02 =  det_inv * (pM->M01*pM->M12 - pM->M02*pM->M11);
+
+	mi.M10 = -det_inv * (pM->M10*pM->M22 - pM->M12*pM->M20);
+	mi.M11 =  det_inv * (pM->M00*pM->M22 - pM->M02*pM->M20);
+	mi.M12 = -det_inv * (pM->M00*pM->M12 - pM->M02*pM->M10);
+
+	mi.M20 =  det_inv * (pM->M10*pM->M21 - pM->M11*pM->M20);
+	mi.M21 = -det_inv * (pM->M00*pM->M21 - pM->M01*pM->M20);
+	mi.M22 =  det_inv * (pM->M00*pM->M11 - pM->M01*pM->M10);
+
+	mi.M30 = -( pM->M30 * mi.M00 + pM->M31 * mi.M10 + pM->M32 * mi.M20 );
+	mi.M31 = -( pM->M30 * mi.M01 + pM->M31 * mi.M11 + pM->M32 * mi.M21 );
+	mi.M32 = -( pM->M30 * mi.M02 + pM->M31 * mi.M12 + pM->M32 * mi.M22 );
+
+	MAT_COPY_4X3(&mi, pMi);
+
+	return 1;
+
+} // end Mat_Inverse_4X3
+
+///////////////////////////////////////////////////////////
+
+void Mat_Inverse_4X3_Rigid(const MATRIX4X3* pM, MATRIX4X3* pMi)
+{
+	// this function computes an inverse of a rigid transformation (rotation + translation);
+	// the inverse of an orthonormal 3x3 part is just its transpose, so there is
+	// no determinant and no division here
+
+	assert(pM != nullptr);
+	assert(pMi != nullptr);
+
+	// compute into a temporary matrix since pMi can be the same as pM
+	MATRIX4X3 mi;
+
+	mi.M00 = pM->M00;  mi.M01 = pM->M10;  mi.M02 = pM->M20;
+	mi.M10 = pM->M01;  mi.M11 = pM->M11;  mi.M12 = pM->M21;
+	mi.M20 = pM->M02;  mi.M21 = pM->M12;  mi.M22 = pM->M22;
+
+	mi.M30 = -( pM->M30 * mi.M00 + pM->M31 * mi.M10 + pM->M32 * mi.M20 );
+	mi.M31 = -( pM->M30 * mi.M01 + pM->M31 * mi.M11 + pM->M32 * mi.M21 );
+	mi.M32 = -( pM->M30 * mi.M02 + pM->M31 * mi.M12 + pM->M32 * mi.M22 );
+
+	MAT_COPY_4X3(&mi, pMi);
+
+} // end Mat_Inverse_4X3_Rigid
+
+///////////////////////////////////////////////////////////
+
+int Mat_Normal_Matrix_4X3(const MATRIX4X3* pM, MATRIX3X3* pMatNormal)
+{
+	// this function computes a matrix for transformation of normals:
+	// the inverse transpose of the 3x3 part of pM
+
+	assert(pM != nullptr);
+	assert(pMatNormal != nullptr);
+
+	MATRIX3X3 m3x3;
+	MATRIX3X3 mi;
+
+	Mat_Init_3X3(&m3x3,
+		pM->M00, pM->M01, pM->M02,
+		pM->M10, pM->M11, pM->M12,
+		pM->M20, pM->M21, pM->M22);
+
+	if (!Mat_Inverse_3X3(&m3x3, &mi))
+		return 0;
+
+	MAT_TRANSPOSE_3X3(&mi, pMatNormal);
+
+	return 1;
+
+} // end Mat_Normal_Matrix_4X3
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                              BATCH TRANSFORMATION
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void Mat_Mul_VECTOR3D_4X3_Batch(const float* xIn, const float* yIn, const float* zIn,
+	const MATRIX4X3* pM,
+	float* xOut, float* yOut, float* zOut,
+	const int num)
+{
+	// transforms num points by the affine matrix;
+	//
+	// the batch kernels of 4x4 matrices never read the last column so we just
+	// expand the matrix once per batch and reuse them (it costs nothing per point)
+
+	assert(pM != nullptr);
+
+	MATRIX4X4 m;
+	Mat_4X3_To_4X4(pM, &m);
+
+	Mat_Mul_VECTOR3D_4X4_Batch(xIn, yIn, zIn, &m, xOut, yOut, zOut, num);
+
+} // end Mat_Mul_VECTOR3D_4X3_Batch
+
+///////////////////////////////////////////////////////////
+
+int Mat_Mul_Normal3D_4X3_Batch(const float* xIn, const float* yIn, const float* zIn,
+	const MATRIX4X3* pM,
+	float* xOut, float* yOut, float* zOut,
+	const int num,
+	const int normalize)
+{
+	// transforms num normals by the inverse transpose of the 3x3 part of the matrix
+	// and normalizes them if it is necessary
+
+	assert(pM != nullptr);
+	assert(xOut && yOut && zOut);
+
+	MATRIX3X3 mn;
+
+	if (!Mat_Normal_Matrix_4X3(pM, &mn))
+		return 0;
+
+	// make a 4x4 matrix without translation for the batch kernels
+	MATRIX4X4 m;
+	Mat_Init_4X4(&m,
+		mn.M00, mn.M01, mn.M02, 0.0f,
+		mn.M10, mn.M11, mn.M12, 0.0f,
+		mn.M20, mn.M21, mn.M22, 0.0f,
+		0.0f,   0.0f,   0.0f,   1.0f);
+
+	Mat_Mul_VECTOR3D_4X4_Batch(xIn, yIn, zIn, &m, xOut, yOut, zOut, num);
+
+	if (normalize)
+	{
+		for (int i = 0; i < num; i++)
+		{
+			const float len2 = (xOut[i] * xOut[i]) + (yOut[i] * yOut[i]) + (zOut[i] * zOut[i]);
+
+			// zero length normals are left as is
+			if (len2 < EPSILON_E6 * EPSILON_E6)
+				continue;
+
+			const float len_inv = 1.0f / sqrtf(len2);
+
+			xOut[i] *= len_inv;
+			yOut[i] *= len_inv;
+			zOut[i] *= len_inv;
+		}
+	}
+
+	return 1;
+
+} // end Mat_Mul_Normal3D_4X3_Batch
+
+} // end namespace MathLib
@@ -0,0 +1,71 @@
+////////////////////////////////////////////////////////////////////////////////////////////
+// Filename:      MatrixAffine.h
+// Description:   contains functional for work with affine transformations which are
+//                stored in MATRIX4X3 (the fourth column is implicitly [0 0 0 1]t):
+//                composition, inverse, conversion to/from MATRIX4X4, and
+//                batch transformation of points and normals
+//
+// Created:       17.10.26
+////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "Matrix.h"
+
+
+namespace MathLib
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                             FUNCTIONS PROTOTYPES
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void Mat_Init_4X3(MATRIX4X3* pMat,
+	const float m00, const float m01, const float m02,
+	const float m10, const float m11, const float m12,
+	const float m20, const float m21, const float m22,
+	const float m30, const float m31, const float m32);
+
+// conversion between 4x3 and 4x4 matrices (the last column of 4x4 is dropped / set to [0 0 0 1]t)
+void Mat_4X4_To_4X3(const MATRIX4X4* pMat, MATRIX4X3* pMat4x3);
+void Mat_4X3_To_4X4(const MATRIX4X3* pMat, MATRIX4X4* pMat4x4);
+
+// composition of affine transformations: pMProd = pMatA * pMatB
+// (first pMatA is applied, and then pMatB); pMProd can be one of the inputs
+void Mat_Mul_4X3(const MATRIX4X3* pMatA, const MATRIX4X3* pMatB, MATRIX4X3* pMProd);
+
+// inverse of any affine transformation; returns 1 if the inverse exists,
+// in another case returns 0 and pMi is a zero matrix
+int Mat_Inverse_4X3(const MATRIX4X3* pM, MATRIX4X3* pMi);
+
+// inverse of a rigid transformation (rotation + translation only);
+// the 3x3 part must be orthonormal (it isn't checked)
+void Mat_Inverse_4X3_Rigid(const MATRIX4X3* pM, MATRIX4X3* pMi);
+
+// matrix for transformation of normals: inverse transpose of the 3x3 part
+// (the translation of the input matrix is ignored); returns 0 if the 3x3 part is degenerate
+int Mat_Normal_Matrix_4X3(const MATRIX4X3* pM, MATRIX3X3* pMatNormal);
+
+///////////////////////////////////////////////////////////////
+
+//
+// batch transformation of points/normals which are stored in SoA form
+// (see MatrixBatch.h for the requirements to the streams)
+//
+
+// points (w = 1); bit-compatible with Mat_Mul_VECTOR3D_4X3
+void Mat_Mul_VECTOR3D_4X3_Batch(const float* xIn, const float* yIn, const float* zIn,
+	const MATRIX4X3* pM,
+	float* xOut, float* yOut, float* zOut,
+	const int num);
+
+// normals: the translation is ignored and the inverse transpose of the 3x3 part is used
+// so the normals stay perpendicular to the transformed surfaces even with non-uniform
+// scaling; if normalize == 1 the result normals are normalized;
+// returns 0 if the 3x3 part is degenerate (the output isn't changed then)
+int Mat_Mul_Normal3D_4X3_Batch(const float* xIn, const float* yIn, const float* zIn,
+	const MATRIX4X3* pM,
+	float* xOut, float* yOut, float* zOut,
+	const int num,
+	const int normalize);
+
+} // end namespace MathLib
@@ -0,0 +1,228 @@
+////////////////////////////////////////////////////////////////////////////////////////////
+// Filename:      MatrixBatch.cpp
+// Description:   contains implementation of batch transformation of points/vectors
+//                by matrices (scalar, SSE and AVX2 kernels + runtime dispatching)
+//
+// Created:       17.10.26
+////////////////////////////////////////////////////////////////////////////////////////////
+#include "MatrixBatch.h"
+#include "../Utils/Simd.h"
+
+
+namespace MathLib
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                     BATCH TRANSFORMATION OF 3D POINTS BY 4X4 MATRIX
+////////////////////////////////////////////////////////////////////////////////////////////
+
+//
+// NOTE: all the kernels compute each component in the same order as Mat_Mul_VECTOR3D_4X4:
+//
+//           out = (((0 + x*M[0][c]) + y*M[1][c]) + z*M[2][c]) + M[3][c]
+//
+//       the starting "0 +" isn't dropped because it turns -0.0f into +0.0f exactly
+//       as the reference function does; this is what makes the results bit-compatible
+//
+
+void Mat_Mul_VECTOR3D_4X4_Batch_Scalar(const float* xIn, const float* yIn, const float* zIn,
+	const MATRIX4X4* pM,
+	float* xOut, float* yOut, float* zOut,
+	const int num)
+{
+	// transforms num points by the matrix using plain C++ code (reference kernel)
+
+	assert(xIn && yIn && zIn);
+	assert(xOut && yOut && zOut);
+	assert(pM != nullptr);
+	assert(num >= 0);
+
+	for (int i = 0; i < num; i++)
+	{
+		// store the input values since the output can be the same as the input
+		const float x = xIn[i];
+		const float y = yIn[i];
+		const float z = zIn[i];
+
+		float res[3];
+
+		for (int col = 0; col < 3; col++)
+		{
+			float sum = 0.0f;
+
+			sum += x * pM->M[0][col];
+			sum += y * pM->M[1][col];
+			sum += z * pM->M[2][col];
+			sum += pM->M[3][col];
+
+			res[col] = sum;
+		}
+
+		xOut[i] = res[0];
+		yOut[i] = res[1];
+		zOut[i] = res[2];
+	}
+
+} // end Mat_Mul_VECTOR3D_4X4_Batch_Scalar
+
+///////////////////////////////////////////////////////////
+
+#if MATHLIB_SIMD_X86
+
+MATHLIB_TARGET_SSE41
+void Mat_Mul_VECTOR3D_4X4_Batch_SSE(const float* xIn, const float* yIn, const float* zIn,
+	const MATRIX4X4* pM,
+	float* xOut, float* yOut, float* zOut,
+	const int num)
+{
+	// transforms num points by the matrix; processes 4 points per iteration;
+	// the tail (num % 4 points) is processed by the scalar kernel
+
+	assert(xIn && yIn && zIn);
+	assert(xOut && yOut && zOut);
+	assert(pM != nullptr);
+	assert(num >= 0);
+
+	const __m128 zero = _mm_setzero_ps();
+
+	// broadcast each used matrix element into its own register
+	__m128 m[4][3];
+
+	for (int row = 0; row < 4; row++)
+		for (int col = 0; col < 3; col++)
+			m[row][col] = _mm_set1_ps(pM->M[row][col]);
+
+	int i = 0;
+
+	for (; i + 4 <= num; i += 4)
+	{
+		const __m128 x = _mm_loadu_ps(xIn + i);
+		const __m128 y = _mm_loadu_ps(yIn + i);
+		const __m128 z = _mm_loadu_ps(zIn + i);
+
+		__m128 res[3];
+
+		for (int col = 0; col < 3; col++)
+		{
+			__m128 sum = _mm_add_ps(zero, _mm_mul_ps(x, m[0][col]));
+			sum = _mm_add_ps(sum, _mm_mul_ps(y, m[1][col]));
+			sum = _mm_add_ps(sum, _mm_mul_ps(z, m[2][col]));
+			res[col] = _mm_add_ps(sum, m[3][col]);
+		}
+
+		_mm_storeu_ps(xOut + i, res[0]);
+		_mm_storeu_ps(yOut + i, res[1]);
+		_mm_storeu_ps(zOut + i, res[2]);
+	}
+
+	// process the rest of points
+	Mat_Mul_VECTOR3D_4X4_Batch_Scalar(xIn + i, yIn + i, zIn + i, pM,
+		xOut + i, yOut + i, zOut + i, num - i);
+
+} // end Mat_Mul_VECTOR3D_4X4_Batch_SSE
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_AVX2
+void Mat_Mul_VECTOR3D_4X4_Batch_AVX2(const float* xIn, const float* yIn, const float* zIn,
+	const MATRIX4X4* pM,
+	float* xOut, float* yOut, float* zOut,
+	const int num)
+{
+	// transforms num points by the matrix; processes 8 points per iteration;
+	// the tail (num % 8 points) is processed by the SSE kernel
+	//
+	// NOTE: FMA isn't used here on purpose (see the note in Simd.h)
+
+	assert(xIn && yIn && zIn);
+	assert(xOut && yOut && zOut);
+	assert(pM != nullptr);
+	assert(num >= 0);
+
+	const __m256 zero = _mm256_setzero_ps();
+
+	// broadcast each used matrix element into its own register
+	__m256 m[4][3];
+
+	for (int row = 0; row < 4; row++)
+		for (int col = 0; col < 3; col++)
+			m[row][col] = _mm256_set1_ps(pM->M[row][col]);
+
+	int i = 0;
+
+	for (; i + 8 <= num; i += 8)
+	{
+		const __m256 x = _mm256_loadu_ps(xIn + i);
+		const __m256 y = _mm256_loadu_ps(yIn + i);
+		const __m256 z = _mm256_loadu_ps(zIn + i);
+
+		__m256 res[3];
+
+		for (int col = 0; col < 3; col++)
+		{
+			__m256 sum = _mm256_add_ps(zero, _mm256_mul_ps(x, m[0][col]));
+			sum = _mm256_add_ps(sum, _mm256_mul_ps(y, m[1][col]));
+			sum = _mm256_add_ps(sum, _mm256_mul_ps(z, m[2][col]));
+			res[col] = _mm256_add_ps(sum, m[3][col]);
+		}
+
+		_mm256_storeu_ps(xOut + i, res[0]);
+		_mm256_storeu_ps(yOut + i, res[1]);
+		_mm256_storeu_ps(zOut + i, res[2]);
+	}
+
+	// process the rest of points
+	Mat_Mul_VECTOR3D_4X4_Batch_SSE(xIn + i, yIn + i, zIn + i, pM,
+		xOut + i, yOut + i, zOut + i, num - i);
+
+} // end Mat_Mul_VECTOR3D_4X4_Batch_AVX2
+
+#else
+
+// there is no SIMD support for this platform so use the reference kernel
+
+void Mat_Mul_VECTOR3D_4X4_Batch_SSE(const float* xIn, const float* yIn, const float* zIn,
+	const MATRIX4X4* pM,
+	float* xOut, float* yOut, float* zOut,
+	const int num)
+{
+	Mat_Mul_VECTOR3D_4X4_Batch_Scalar(xIn, yIn, zIn, pM, xOut, yOut, zOut, num);
+}
+
+void Mat_Mul_VECTOR3D_4X4_Batch_AVX2(const float* xIn, const float* yIn, const float* zIn,
+	const MATRIX4X4* pM,
+	float* xOut, float* yOut, float* zOut,
+	const int num)
+{
+	Mat_Mul_VECTOR3D_4X4_Batch_Scalar(xIn, yIn, zIn, pM, xOut, yOut, zOut, num);
+}
+
+#endif // MATHLIB_SIMD_X86
+
+///////////////////////////////////////////////////////////
+
+void Mat_Mul_VECTOR3D_4X4_Batch(const float* xIn, const float* yIn, const float* zIn,
+	const MATRIX4X4* pM,
+	float* xOut, float* yOut, float* zOut,
+	const int num)
+{
+	// transforms num points by the matrix using the best kernel for the current CPU
+
+	switch (SIMD_Get_Level())
+	{
+		case SIMD_LEVEL_AVX2:
+			Mat_Mul_VECTOR3D_4X4_Batch_AVX2(xIn, yIn, zIn, pM, xOut, yOut, zOut, num);
+			break;
+
+		case SIMD_LEVEL_AVX:
+		case SIMD_LEVEL_SSE:
+			Mat_Mul_VECTOR3D_4X4_Batch_SSE(xIn, yIn, zIn, pM, xOut, yOut, zOut, num);
+			break;
+
+		default:
+			Mat_Mul_VECTOR3D_4X4_Batch_Scalar(xIn, yIn, zIn, pM, xOut, yOut, zOut, num);
+	}
+
+} // end Mat_Mul_VECTOR3D_4X4_Batch
+
+} // end namespace MathLib
@@ -0,0 +1,52 @@
+////////////////////////////////////////////////////////////////////////////////////////////
+// Filename:      MatrixBatch.h
+// Description:   contains functional for batch transformation of points/vectors
+//                by matrices; the data is stored in SoA form (separate streams
+//                of x[], y[], z[] components) so it can be processed by SIMD kernels
+//
+// Created:       17.10.26
+////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "Matrix.h"
+
+
+namespace MathLib
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                         BATCH TRANSFORMATION OF 3D POINTS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+//
+// each function transforms num points (x[i], y[i], z[i]) by the 4x4 matrix using the same
+// row-vector convention as Mat_Mul_VECTOR3D_4X4 (w = 1, the last column isn't used);
+// the results are bit-compatible with Mat_Mul_VECTOR3D_4X4 for each kernel;
+//
+// output streams may be the same as the input streams (in-place transformation),
+// but they must not partially overlap
+//
+
+// chooses the best kernel for the current CPU (see SIMD_Get_Level)
+void Mat_Mul_VECTOR3D_4X4_Batch(const float* xIn, const float* yIn, const float* zIn,
+	const MATRIX4X4* pM,
+	float* xOut, float* yOut, float* zOut,
+	const int num);
+
+// separate kernels (SSE/AVX2 kernels must be called only if the CPU supports them)
+void Mat_Mul_VECTOR3D_4X4_Batch_Scalar(const float* xIn, const float* yIn, const float* zIn,
+	const MATRIX4X4* pM,
+	float* xOut, float* yOut, float* zOut,
+	const int num);
+
+void Mat_Mul_VECTOR3D_4X4_Batch_SSE(const float* xIn, const float* yIn, const float* zIn,
+	const MATRIX4X4* pM,
+	float* xOut, float* yOut, float* zOut,
+	const int num);
+
+void Mat_Mul_VECTOR3D_4X4_Batch_AVX2(const float* xIn, const float* yIn, const float* zIn,
+	const MATRIX4X4* pM,
+	float* xOut, float* yOut, float* zOut,
+	const int num);
+
+} // end namespace MathLib
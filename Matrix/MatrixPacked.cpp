@@ -0,0 +1,783 @@
+////////////////////////////////////////////////////////////////////////////////////////////
+// Filename:      MatrixPacked.cpp
+// Description:   contains implementation of packed (fp16/bf16) storage: bulk conversions
+//                of streams and transformation of packed vectors by matrices (scalar,
+//                SSE and AVX2 kernels + runtime dispatching)
+//
+// Created:       17.10.26
+////////////////////////////////////////////////////////////////////////////////////////////
+#include "MatrixPacked.h"
+#include "../Utils/Simd.h"
+
+
+namespace MathLib
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                          CONVERSIONS IN SIMD REGISTERS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+//
+// NOTE: the SSE conversions are the branchless forms of the scalar conversions
+//       (Float_To_Half, Half_To_Float, ...): the same integer operations and the same
+//       float additions, so they give the same bits; the AVX2 kernels use F16C for
+//       fp16 which gives the same bits too (checked by the tests); the packed values
+//       are in the low 16 bits of 32-bit lanes
+//
+
+#if MATHLIB_SIMD_X86
+
+MATHLIB_TARGET_SSE41
+static inline __m128i Float4_To_Half_SSE(const __m128 f)
+{
+	const __m128i signMask   = _mm_set1_epi32((int)0x80000000);
+	const __m128i f16Max     = _mm_set1_epi32((127 + 16) << 23);
+	const __m128i minNormal  = _mm_set1_epi32((127 - 14) << 23);
+	const __m128i subMagic   = _mm_set1_epi32(126 << 23);
+	const __m128i normalBias = _mm_set1_epi32((int)(0xfff - ((127u - 15u) << 23)));
+	const __m128i one        = _mm_set1_epi32(1);
+
+	const __m128i bits    = _mm_castps_si128(f);
+	const __m128i sign    = _mm_and_si128(bits, signMask);
+	const __m128i absBits = _mm_xor_si128(bits, sign);
+
+	// infinities and NaNs
+	const __m128i isNan   = _mm_cmpgt_epi32(absBits, _mm_set1_epi32(0x7f800000));
+	const __m128i nan     = _mm_or_si128(_mm_set1_epi32(0x7e00), _mm_and_si128(_mm_srli_epi32(absBits, 13), _mm_set1_epi32(0x3ff)));
+	const __m128i special = _mm_blendv_epi8(_mm_set1_epi32(0x7c00), nan, isNan);
+
+	// denormal halves: the float addition rounds the mantissa
+	const __m128  sub1 = _mm_add_ps(_mm_castsi128_ps(absBits), _mm_castsi128_ps(subMagic));
+	const __m128i sub  = _mm_sub_epi32(_mm_castps_si128(sub1), subMagic);
+
+	// normal halves: rebias the exponent and round the mantissa (to even)
+	const __m128i mantOdd = _mm_and_si128(_mm_srli_epi32(absBits, 13), one);
+	const __m128i normal  = _mm_srli_epi32(_mm_add_epi32(_mm_add_epi32(absBits, normalBias), mantOdd), 13);
+
+	const __m128i isSub     = _mm_cmpgt_epi32(minNormal, absBits);
+	const __m128i isRegular = _mm_cmpgt_epi32(f16Max, absBits);
+
+	__m128i res = _mm_blendv_epi8(normal, sub, isSub);
+	res = _mm_blendv_epi8(special, res, isRegular);
+
+	return _mm_or_si128(res, _mm_srli_epi32(sign, 16));
+}
+
+MATHLIB_TARGET_SSE41
+static inline __m128 Half4_To_Float_SSE(const __m128i h)
+{
+	const __m128i shiftedExp = _mm_set1_epi32(0x7c00 << 13);
+	const __m128i expAdjust  = _mm_set1_epi32((127 - 15) << 23);
+	const __m128i zero       = _mm_setzero_si128();
+
+	__m128i bits = _mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(0x7fff)), 13);
+	const __m128i exp = _mm_and_si128(bits, shiftedExp);
+
+	bits = _mm_add_epi32(bits, expAdjust);
+
+	// infinities and NaNs (NaNs become quiet)
+	const __m128i isInfNan = _mm_cmpeq_epi32(exp, shiftedExp);
+	const __m128i isNan    = _mm_and_si128(isInfNan, _mm_cmpgt_epi32(_mm_and_si128(h, _mm_set1_epi32(0x3ff)), zero));
+
+	bits = _mm_add_epi32(bits, _mm_and_si128(isInfNan, expAdjust));
+	bits = _mm_or_si128(bits, _mm_and_si128(isNan, _mm_set1_epi32(0x00400000)));
+
+	// zeros and denormals: renormalize by the float subtraction
+	const __m128i isDenorm = _mm_cmpeq_epi32(exp, zero);
+	const __m128  denorm   = _mm_sub_ps(_mm_castsi128_ps(_mm_add_epi32(bits, _mm_set1_epi32(1 << 23))), _mm_set1_ps(6.103515625e-05f));
+
+	bits = _mm_blendv_epi8(bits, _mm_castps_si128(denorm), isDenorm);
+	bits = _mm_or_si128(bits, _mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(0x8000)), 16));
+
+	return _mm_castsi128_ps(bits);
+}
+
+MATHLIB_TARGET_SSE41
+static inline __m128i Float4_To_BF16_SSE(const __m128 f)
+{
+	const __m128i bits  = _mm_castps_si128(f);
+	const __m128i high  = _mm_srli_epi32(bits, 16);
+	const __m128i isNan = _mm_cmpgt_epi32(_mm_and_si128(bits, _mm_set1_epi32(0x7fffffff)), _mm_set1_epi32(0x7f800000));
+
+	const __m128i lsb     = _mm_and_si128(high, _mm_set1_epi32(1));
+	const __m128i rounded = _mm_srli_epi32(_mm_add_epi32(_mm_add_epi32(bits, _mm_set1_epi32(0x7fff)), lsb), 16);
+	const __m128i nan     = _mm_or_si128(high, _mm_set1_epi32(0x40));
+
+	return _mm_blendv_epi8(rounded, nan, isNan);
+}
+
+MATHLIB_TARGET_SSE41
+static inline __m128 BF16_4_To_Float_SSE(const __m128i b)
+{
+	return _mm_castsi128_ps(_mm_slli_epi32(b, 16));
+}
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_AVX2
+static inline __m256i Float8_To_BF16_AVX2(const __m256 f)
+{
+	const __m256i bits  = _mm256_castps_si256(f);
+	const __m256i high  = _mm256_srli_epi32(bits, 16);
+	const __m256i isNan = _mm256_cmpgt_epi32(_mm256_and_si256(bits, _mm256_set1_epi32(0x7fffffff)), _mm256_set1_epi32(0x7f800000));
+
+	const __m256i lsb     = _mm256_and_si256(high, _mm256_set1_epi32(1));
+	const __m256i rounded = _mm256_srli_epi32(_mm256_add_epi32(_mm256_add_epi32(bits, _mm256_set1_epi32(0x7fff)), lsb), 16);
+	const __m256i nan     = _mm256_or_si256(high, _mm256_set1_epi32(0x40));
+
+	return _mm256_blendv_epi8(rounded, nan, isNan);
+}
+
+MATHLIB_TARGET_AVX2
+static inline __m256 BF16_8_To_Float_AVX2(const __m256i b)
+{
+	return _mm256_castsi256_ps(_mm256_slli_epi32(b, 16));
+}
+
+///////////////////////////////////////////////////////////
+
+// loads/stores of 4 and 8 packed values (from/to 32-bit lanes)
+
+MATHLIB_TARGET_SSE41
+static inline __m128i Load4_U16_SSE(const uint16_t* p)
+{
+	return _mm_cvtepu16_epi32(_mm_loadl_epi64((const __m128i*)p));
+}
+
+MATHLIB_TARGET_SSE41
+static inline void Store8_U16_SSE(uint16_t* p, const __m128i lo, const __m128i hi)
+{
+	_mm_storeu_si128((__m128i*)p, _mm_packus_epi32(lo, hi));
+}
+
+MATHLIB_TARGET_AVX2
+static inline __m256i Load8_U16_AVX2(const uint16_t* p)
+{
+	return _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)p));
+}
+
+MATHLIB_TARGET_AVX2
+static inline void Store8_U16_AVX2(uint16_t* p, const __m256i v)
+{
+	// pack in each 128-bit lane and then join the low halves of the lanes
+	const __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(v, v), 0x08);
+	_mm_storeu_si128((__m128i*)p, _mm256_castsi256_si128(packed));
+}
+
+#endif // MATHLIB_SIMD_X86
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                          BULK CONVERSIONS OF STREAMS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void Float_To_Half_Batch_Scalar(const float* in, uint16_t* out, const int num)
+{
+	assert(in && out);
+	assert(num >= 0);
+
+	for (int i = 0; i < num; i++)
+		out[i] = Float_To_Half(in[i]);
+}
+
+void Half_To_Float_Batch_Scalar(const uint16_t* in, float* out, const int num)
+{
+	assert(in && out);
+	assert(num >= 0);
+
+	for (int i = 0; i < num; i++)
+		out[i] = Half_To_Float(in[i]);
+}
+
+void Float_To_BF16_Batch_Scalar(const float* in, uint16_t* out, const int num)
+{
+	assert(in && out);
+	assert(num >= 0);
+
+	for (int i = 0; i < num; i++)
+		out[i] = Float_To_BF16(in[i]);
+}
+
+void BF16_To_Float_Batch_Scalar(const uint16_t* in, float* out, const int num)
+{
+	assert(in && out);
+	assert(num >= 0);
+
+	for (int i = 0; i < num; i++)
+		out[i] = BF16_To_Float(in[i]);
+}
+
+///////////////////////////////////////////////////////////
+
+#if MATHLIB_SIMD_X86
+
+//
+// SSE kernels process 8 values per iteration, AVX2 kernels process 16 values;
+// the tails are processed by the previous kernels (AVX2 -> SSE -> scalar)
+//
+
+MATHLIB_TARGET_SSE41
+void Float_To_Half_Batch_SSE(const float* in, uint16_t* out, const int num)
+{
+	assert(in && out);
+	assert(num >= 0);
+
+	int i = 0;
+
+	for (; i + 8 <= num; i += 8)
+	{
+		const __m128i lo = Float4_To_Half_SSE(_mm_loadu_ps(in + i));
+		const __m128i hi = Float4_To_Half_SSE(_mm_loadu_ps(in + i + 4));
+
+		Store8_U16_SSE(out + i, lo, hi);
+	}
+
+	Float_To_Half_Batch_Scalar(in + i, out + i, num - i);
+
+} // end Float_To_Half_Batch_SSE
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_SSE41
+void Half_To_Float_Batch_SSE(const uint16_t* in, float* out, const int num)
+{
+	assert(in && out);
+	assert(num >= 0);
+
+	int i = 0;
+
+	for (; i + 8 <= num; i += 8)
+	{
+		_mm_storeu_ps(out + i,     Half4_To_Float_SSE(Load4_U16_SSE(in + i)));
+		_mm_storeu_ps(out + i + 4, Half4_To_Float_SSE(Load4_U16_SSE(in + i + 4)));
+	}
+
+	Half_To_Float_Batch_Scalar(in + i, out + i, num - i);
+
+} // end Half_To_Float_Batch_SSE
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_SSE41
+void Float_To_BF16_Batch_SSE(const float* in, uint16_t* out, const int num)
+{
+	assert(in && out);
+	assert(num >= 0);
+
+	int i = 0;
+
+	for (; i + 8 <= num; i += 8)
+	{
+		const __m128i lo = Float4_To_BF16_SSE(_mm_loadu_ps(in + i));
+		const __m128i hi = Float4_To_BF16_SSE(_mm_loadu_ps(in + i + 4));
+
+		Store8_U16_SSE(out + i, lo, hi);
+	}
+
+	Float_To_BF16_Batch_Scalar(in + i, out + i, num - i);
+
+} // end Float_To_BF16_Batch_SSE
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_SSE41
+void BF16_To_Float_Batch_SSE(const uint16_t* in, float* out, const int num)
+{
+	assert(in && out);
+	assert(num >= 0);
+
+	int i = 0;
+
+	for (; i + 8 <= num; i += 8)
+	{
+		_mm_storeu_ps(out + i,     BF16_4_To_Float_SSE(Load4_U16_SSE(in + i)));
+		_mm_storeu_ps(out + i + 4, BF16_4_To_Float_SSE(Load4_U16_SSE(in + i + 4)));
+	}
+
+	BF16_To_Float_Batch_Scalar(in + i, out + i, num - i);
+
+} // end BF16_To_Float_Batch_SSE
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_AVX2_F16C
+void Float_To_Half_Batch_AVX2(const float* in, uint16_t* out, const int num)
+{
+	assert(in && out);
+	assert(num >= 0);
+
+	int i = 0;
+
+	for (; i + 16 <= num; i += 16)
+	{
+		const __m128i lo = _mm256_cvtps_ph(_mm256_loadu_ps(in + i),     _MM_FROUND_TO_NEAREST_INT);
+		const __m128i hi = _mm256_cvtps_ph(_mm256_loadu_ps(in + i + 8), _MM_FROUND_TO_NEAREST_INT);
+
+		_mm_storeu_si128((__m128i*)(out + i),     lo);
+		_mm_storeu_si128((__m128i*)(out + i + 8), hi);
+	}
+
+	Float_To_Half_Batch_SSE(in + i, out + i, num - i);
+
+} // end Float_To_Half_Batch_AVX2
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_AVX2_F16C
+void Half_To_Float_Batch_AVX2(const uint16_t* in, float* out, const int num)
+{
+	assert(in && out);
+	assert(num >= 0);
+
+	int i = 0;
+
+	for (; i + 16 <= num; i += 16)
+	{
+		_mm256_storeu_ps(out + i,     _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)(in + i))));
+		_mm256_storeu_ps(out + i + 8, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)(in + i + 8))));
+	}
+
+	Half_To_Float_Batch_SSE(in + i, out + i, num - i);
+
+} // end Half_To_Float_Batch_AVX2
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_AVX2
+void Float_To_BF16_Batch_AVX2(const float* in, uint16_t* out, const int num)
+{
+	assert(in && out);
+	assert(num >= 0);
+
+	int i = 0;
+
+	for (; i + 16 <= num; i += 16)
+	{
+		Store8_U16_AVX2(out + i,     Float8_To_BF16_AVX2(_mm256_loadu_ps(in + i)));
+		Store8_U16_AVX2(out + i + 8, Float8_To_BF16_AVX2(_mm256_loadu_ps(in + i + 8)));
+	}
+
+	Float_To_BF16_Batch_SSE(in + i, out + i, num - i);
+
+} // end Float_To_BF16_Batch_AVX2
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_AVX2
+void BF16_To_Float_Batch_AVX2(const uint16_t* in, float* out, const int num)
+{
+	assert(in && out);
+	assert(num >= 0);
+
+	int i = 0;
+
+	for (; i + 16 <= num; i += 16)
+	{
+		_mm256_storeu_ps(out + i,     BF16_8_To_Float_AVX2(Load8_U16_AVX2(in + i)));
+		_mm256_storeu_ps(out + i + 8, BF16_8_To_Float_AVX2(Load8_U16_AVX2(in + i + 8)));
+	}
+
+	BF16_To_Float_Batch_SSE(in + i, out + i, num - i);
+
+} // end BF16_To_Float_Batch_AVX2
+
+#else
+
+// there is no SIMD support for this platform so use the reference kernels
+
+void Float_To_Half_Batch_SSE(const float* in, uint16_t* out, const int num)     { Float_To_Half_Batch_Scalar(in, out, num); }
+void Half_To_Float_Batch_SSE(const uint16_t* in, float* out, const int num)     { Half_To_Float_Batch_Scalar(in, out, num); }
+void Float_To_BF16_Batch_SSE(const float* in, uint16_t* out, const int num)     { Float_To_BF16_Batch_Scalar(in, out, num); }
+void BF16_To_Float_Batch_SSE(const uint16_t* in, float* out, const int num)     { BF16_To_Float_Batch_Scalar(in, out, num); }
+
+void Float_To_Half_Batch_AVX2(const float* in, uint16_t* out, const int num)    { Float_To_Half_Batch_Scalar(in, out, num); }
+void Half_To_Float_Batch_AVX2(const uint16_t* in, float* out, const int num)    { Half_To_Float_Batch_Scalar(in, out, num); }
+void Float_To_BF16_Batch_AVX2(const float* in, uint16_t* out, const int num)    { Float_To_BF16_Batch_Scalar(in, out, num); }
+void BF16_To_Float_Batch_AVX2(const uint16_t* in, float* out, const int num)    { BF16_To_Float_Batch_Scalar(in, out, num); }
+
+#endif // MATHLIB_SIMD_X86
+
+///////////////////////////////////////////////////////////
+
+// the fp16 AVX2 kernels also need F16C (it is on each known CPU with AVX2,
+// but it is a separate feature)
+static bool Use_F16C_Kernels()
+{
+	return (SIMD_Get_Level() == SIMD_LEVEL_AVX2) && CPU_Get_Features().f16c;
+}
+
+void Float_To_Half_Batch(const float* in, uint16_t* out, const int num)
+{
+	// converts num floats into fp16 using the best kernel for the current CPU
+
+	if (Use_F16C_Kernels())
+		Float_To_Half_Batch_AVX2(in, out, num);
+	else if (SIMD_Get_Level() >= SIMD_LEVEL_SSE)
+		Float_To_Half_Batch_SSE(in, out, num);
+	else
+		Float_To_Half_Batch_Scalar(in, out, num);
+
+} // end Float_To_Half_Batch
+
+///////////////////////////////////////////////////////////
+
+void Half_To_Float_Batch(const uint16_t* in, float* out, const int num)
+{
+	// converts num fp16 values into floats using the best kernel for the current CPU
+
+	if (Use_F16C_Kernels())
+		Half_To_Float_Batch_AVX2(in, out, num);
+	else if (SIMD_Get_Level() >= SIMD_LEVEL_SSE)
+		Half_To_Float_Batch_SSE(in, out, num);
+	else
+		Half_To_Float_Batch_Scalar(in, out, num);
+
+} // end Half_To_Float_Batch
+
+///////////////////////////////////////////////////////////
+
+void Float_To_BF16_Batch(const float* in, uint16_t* out, const int num)
+{
+	// converts num floats into bf16 using the best kernel for the current CPU
+
+	switch (SIMD_Get_Level())
+	{
+		case SIMD_LEVEL_AVX2:
+			Float_To_BF16_Batch_AVX2(in, out, num);
+			break;
+
+		case SIMD_LEVEL_AVX:
+		case SIMD_LEVEL_SSE:
+			Float_To_BF16_Batch_SSE(in, out, num);
+			break;
+
+		default:
+			Float_To_BF16_Batch_Scalar(in, out, num);
+	}
+
+} // end Float_To_BF16_Batch
+
+///////////////////////////////////////////////////////////
+
+void BF16_To_Float_Batch(const uint16_t* in, float* out, const int num)
+{
+	// converts num bf16 values into floats using the best kernel for the current CPU
+
+	switch (SIMD_Get_Level())
+	{
+		case SIMD_LEVEL_AVX2:
+			BF16_To_Float_Batch_AVX2(in, out, num);
+			break;
+
+		case SIMD_LEVEL_AVX:
+		case SIMD_LEVEL_SSE:
+			BF16_To_Float_Batch_SSE(in, out, num);
+			break;
+
+		default:
+			BF16_To_Float_Batch_Scalar(in, out, num);
+	}
+
+} // end BF16_To_Float_Batch
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                    TRANSFORMATION OF PACKED VECTORS BY MATRICES
+////////////////////////////////////////////////////////////////////////////////////////////
+
+//
+// NOTE: all the kernels compute each component in the same order as Mat_Mul_VECTOR4D_4X4:
+//
+//           out = (((0 + x*M[0][c]) + y*M[1][c]) + z*M[2][c]) + w*M[3][c]
+//
+//       a vector is held in one SSE register (or a half of an AVX register),
+//       so the components are broadcast inside the register
+//
+
+void Mat_Mul_VECTOR4D_4X4_F16_Batch_Scalar(const VECTOR4D_F16* in, const MATRIX4X4* pM, VECTOR4D_F16* out, const int num)
+{
+	// transforms num packed vectors using plain C++ code (reference kernel)
+
+	assert(in && out);
+	assert(pM != nullptr);
+	assert(num >= 0);
+
+	for (int i = 0; i < num; i++)
+	{
+		float v[4];
+
+		for (int k = 0; k < 4; k++)
+			v[k] = Half_To_Float(in[i].M[k]);
+
+		for (int col = 0; col < 4; col++)
+		{
+			float sum = 0.0f;
+
+			for (int row = 0; row < 4; row++)
+				sum += v[row] * pM->M[row][col];
+
+			out[i].M[col] = Float_To_Half(sum);
+		}
+	}
+
+} // end Mat_Mul_VECTOR4D_4X4_F16_Batch_Scalar
+
+///////////////////////////////////////////////////////////
+
+void Mat_Mul_VECTOR4D_4X4_BF16_Batch_Scalar(const VECTOR4D_BF16* in, const MATRIX4X4* pM, VECTOR4D_BF16* out, const int num)
+{
+	// transforms num packed vectors using plain C++ code (reference kernel)
+
+	assert(in && out);
+	assert(pM != nullptr);
+	assert(num >= 0);
+
+	for (int i = 0; i < num; i++)
+	{
+		float v[4];
+
+		for (int k = 0; k < 4; k++)
+			v[k] = BF16_To_Float(in[i].M[k]);
+
+		for (int col = 0; col < 4; col++)
+		{
+			float sum = 0.0f;
+
+			for (int row = 0; row < 4; row++)
+				sum += v[row] * pM->M[row][col];
+
+			out[i].M[col] = Float_To_BF16(sum);
+		}
+	}
+
+} // end Mat_Mul_VECTOR4D_4X4_BF16_Batch_Scalar
+
+///////////////////////////////////////////////////////////
+
+#if MATHLIB_SIMD_X86
+
+MATHLIB_TARGET_SSE41
+static inline __m128 Mul_VECTOR4D_SSE(const __m128 v, const __m128 m[4])
+{
+	__m128 sum = _mm_add_ps(_mm_setzero_ps(), _mm_mul_ps(_mm_shuffle_ps(v, v, 0x00), m[0]));
+	sum = _mm_add_ps(sum, _mm_mul_ps(_mm_shuffle_ps(v, v, 0x55), m[1]));
+	sum = _mm_add_ps(sum, _mm_mul_ps(_mm_shuffle_ps(v, v, 0xAA), m[2]));
+
+	return _mm_add_ps(sum, _mm_mul_ps(_mm_shuffle_ps(v, v, 0xFF), m[3]));
+}
+
+MATHLIB_TARGET_AVX2
+static inline __m256 Mul_VECTOR4D_AVX2(const __m256 v, const __m256 m[4])
+{
+	// two vectors (one in each 128-bit lane)
+	__m256 sum = _mm256_add_ps(_mm256_setzero_ps(), _mm256_mul_ps(_mm256_shuffle_ps(v, v, 0x00), m[0]));
+	sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_shuffle_ps(v, v, 0x55), m[1]));
+	sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_shuffle_ps(v, v, 0xAA), m[2]));
+
+	return _mm256_add_ps(sum, _mm256_mul_ps(_mm256_shuffle_ps(v, v, 0xFF), m[3]));
+}
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_SSE41
+void Mat_Mul_VECTOR4D_4X4_F16_Batch_SSE(const VECTOR4D_F16* in, const MATRIX4X4* pM, VECTOR4D_F16* out, const int num)
+{
+	// transforms num packed vectors; processes 2 vectors per iteration;
+	// the tail is processed by the scalar kernel
+
+	assert(in && out);
+	assert(pM != nullptr);
+	assert(num >= 0);
+
+	__m128 m[4];
+
+	for (int row = 0; row < 4; row++)
+		m[row] = _mm_loadu_ps(pM->M[row]);
+
+	int i = 0;
+
+	for (; i + 2 <= num; i += 2)
+	{
+		const __m128 v0 = Half4_To_Float_SSE(Load4_U16_SSE(in[i].M));
+		const __m128 v1 = Half4_To_Float_SSE(Load4_U16_SSE(in[i + 1].M));
+
+		Store8_U16_SSE(out[i].M, Float4_To_Half_SSE(Mul_VECTOR4D_SSE(v0, m)), Float4_To_Half_SSE(Mul_VECTOR4D_SSE(v1, m)));
+	}
+
+	Mat_Mul_VECTOR4D_4X4_F16_Batch_Scalar(in + i, pM, out + i, num - i);
+
+} // end Mat_Mul_VECTOR4D_4X4_F16_Batch_SSE
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_SSE41
+void Mat_Mul_VECTOR4D_4X4_BF16_Batch_SSE(const VECTOR4D_BF16* in, const MATRIX4X4* pM, VECTOR4D_BF16* out, const int num)
+{
+	// transforms num packed vectors; processes 2 vectors per iteration;
+	// the tail is processed by the scalar kernel
+
+	assert(in && out);
+	assert(pM != nullptr);
+	assert(num >= 0);
+
+	__m128 m[4];
+
+	for (int row = 0; row < 4; row++)
+		m[row] = _mm_loadu_ps(pM->M[row]);
+
+	int i = 0;
+
+	for (; i + 2 <= num; i += 2)
+	{
+		const __m128 v0 = BF16_4_To_Float_SSE(Load4_U16_SSE(in[i].M));
+		const __m128 v1 = BF16_4_To_Float_SSE(Load4_U16_SSE(in[i + 1].M));
+
+		Store8_U16_SSE(out[i].M, Float4_To_BF16_SSE(Mul_VECTOR4D_SSE(v0, m)), Float4_To_BF16_SSE(Mul_VECTOR4D_SSE(v1, m)));
+	}
+
+	Mat_Mul_VECTOR4D_4X4_BF16_Batch_Scalar(in + i, pM, out + i, num - i);
+
+} // end Mat_Mul_VECTOR4D_4X4_BF16_Batch_SSE
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_AVX2_F16C
+void Mat_Mul_VECTOR4D_4X4_F16_Batch_AVX2(const VECTOR4D_F16* in, const MATRIX4X4* pM, VECTOR4D_F16* out, const int num)
+{
+	// transforms num packed vectors; processes 4 vectors per iteration (F16C conversions);
+	// the tail is processed by the SSE kernel
+	//
+	// NOTE: FMA isn't used here on purpose (see the note in Simd.h)
+
+	assert(in && out);
+	assert(pM != nullptr);
+	assert(num >= 0);
+
+	// each row is broadcast into both lanes
+	__m256 m[4];
+
+	for (int row = 0; row < 4; row++)
+		m[row] = _mm256_broadcast_ps((const __m128*)pM->M[row]);
+
+	int i = 0;
+
+	for (; i + 4 <= num; i += 4)
+	{
+		const __m256 v01 = _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)in[i].M));
+		const __m256 v23 = _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)in[i + 2].M));
+
+		const __m128i r01 = _mm256_cvtps_ph(Mul_VECTOR4D_AVX2(v01, m), _MM_FROUND_TO_NEAREST_INT);
+		const __m128i r23 = _mm256_cvtps_ph(Mul_VECTOR4D_AVX2(v23, m), _MM_FROUND_TO_NEAREST_INT);
+
+		_mm_storeu_si128((__m128i*)out[i].M, r01);
+		_mm_storeu_si128((__m128i*)out[i + 2].M, r23);
+	}
+
+	Mat_Mul_VECTOR4D_4X4_F16_Batch_SSE(in + i, pM, out + i, num - i);
+
+} // end Mat_Mul_VECTOR4D_4X4_F16_Batch_AVX2
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_AVX2
+void Mat_Mul_VECTOR4D_4X4_BF16_Batch_AVX2(const VECTOR4D_BF16* in, const MATRIX4X4* pM, VECTOR4D_BF16* out, const int num)
+{
+	// transforms num packed vectors; processes 4 vectors per iteration;
+	// the tail is processed by the SSE kernel
+	//
+	// NOTE: FMA isn't used here on purpose (see the note in Simd.h)
+
+	assert(in && out);
+	assert(pM != nullptr);
+	assert(num >= 0);
+
+	// each row is broadcast into both lanes
+	__m256 m[4];
+
+	for (int row = 0; row < 4; row++)
+		m[row] = _mm256_broadcast_ps((const __m128*)pM->M[row]);
+
+	int i = 0;
+
+	for (; i + 4 <= num; i += 4)
+	{
+		const __m256 v01 = BF16_8_To_Float_AVX2(Load8_U16_AVX2(in[i].M));
+		const __m256 v23 = BF16_8_To_Float_AVX2(Load8_U16_AVX2(in[i + 2].M));
+
+		Store8_U16_AVX2(out[i].M,     Float8_To_BF16_AVX2(Mul_VECTOR4D_AVX2(v01, m)));
+		Store8_U16_AVX2(out[i + 2].M, Float8_To_BF16_AVX2(Mul_VECTOR4D_AVX2(v23, m)));
+	}
+
+	Mat_Mul_VECTOR4D_4X4_BF16_Batch_SSE(in + i, pM, out + i, num - i);
+
+} // end Mat_Mul_VECTOR4D_4X4_BF16_Batch_AVX2
+
+#else
+
+// there is no SIMD support for this platform so use the reference kernels
+
+void Mat_Mul_VECTOR4D_4X4_F16_Batch_SSE(const VECTOR4D_F16* in, const MATRIX4X4* pM, VECTOR4D_F16* out, const int num)
+{
+	Mat_Mul_VECTOR4D_4X4_F16_Batch_Scalar(in, pM, out, num);
+}
+
+void Mat_Mul_VECTOR4D_4X4_F16_Batch_AVX2(const VECTOR4D_F16* in, const MATRIX4X4* pM, VECTOR4D_F16* out, const int num)
+{
+	Mat_Mul_VECTOR4D_4X4_F16_Batch_Scalar(in, pM, out, num);
+}
+
+void Mat_Mul_VECTOR4D_4X4_BF16_Batch_SSE(const VECTOR4D_BF16* in, const MATRIX4X4* pM, VECTOR4D_BF16* out, const int num)
+{
+	Mat_Mul_VECTOR4D_4X4_BF16_Batch_Scalar(in, pM, out, num);
+}
+
+void Mat_Mul_VECTOR4D_4X4_BF16_Batch_AVX2(const VECTOR4D_BF16* in, const MATRIX4X4* pM, VECTOR4D_BF16* out, const int num)
+{
+	Mat_Mul_VECTOR4D_4X4_BF16_Batch_Scalar(in, pM, out, num);
+}
+
+#endif // MATHLIB_SIMD_X86
+
+///////////////////////////////////////////////////////////
+
+void Mat_Mul_VECTOR4D_4X4_F16_Batch(const VECTOR4D_F16* in, const MATRIX4X4* pM, VECTOR4D_F16* out, const int num)
+{
+	// transforms num packed vectors using the best kernel for the current CPU
+
+	if (Use_F16C_Kernels())
+		Mat_Mul_VECTOR4D_4X4_F16_Batch_AVX2(in, pM, out, num);
+	else if (SIMD_Get_Level() >= SIMD_LEVEL_SSE)
+		Mat_Mul_VECTOR4D_4X4_F16_Batch_SSE(in, pM, out, num);
+	else
+		Mat_Mul_VECTOR4D_4X4_F16_Batch_Scalar(in, pM, out, num);
+
+} // end Mat_Mul_VECTOR4D_4X4_F16_Batch
+
+///////////////////////////////////////////////////////////
+
+void Mat_Mul_VECTOR4D_4X4_BF16_Batch(const VECTOR4D_BF16* in, const MATRIX4X4* pM, VECTOR4D_BF16* out, const int num)
+{
+	// transforms num packed vectors using the best kernel for the current CPU
+
+	switch (SIMD_Get_Level())
+	{
+		case SIMD_LEVEL_AVX2:
+			Mat_Mul_VECTOR4D_4X4_BF16_Batch_AVX2(in, pM, out, num);
+			break;
+
+		case SIMD_LEVEL_AVX:
+		case SIMD_LEVEL_SSE:
+			Mat_Mul_VECTOR4D_4X4_BF16_Batch_SSE(in, pM, out, num);
+			break;
+
+		default:
+			Mat_Mul_VECTOR4D_4X4_BF16_Batch_Scalar(in, pM, out, num);
+	}
+
+} // end Mat_Mul_VECTOR4D_4X4_BF16_Batch
+
+} // end namespace MathLib
@@ -0,0 +1,252 @@
+////////////////////////////////////////////////////////////////////////////////////////////
+// Filename:      MatrixPacked.h
+// Description:   contains functional for packed (16-bit) storage of vectors and
+//                quaternions: IEEE half precision (fp16) and bfloat16 (bf16) formats,
+//                bulk pack/unpack of float streams and transformation of packed
+//                vectors by matrices (decode, transform and encode in registers),
+//                which halves the memory traffic of vertex streams
+//
+//                fp16: 1 sign, 5 exponent, 10 mantissa bits; range +-65504, relative
+//                      precision 2^-11 (~3 decimal digits); smaller values are denormals
+//                bf16: the upper half of a float: the same range as float, relative
+//                      precision 2^-8 (~2 decimal digits)
+//
+// Created:       17.10.26
+////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#include "Matrix.h"
+#include "../Quaternion/Quaternion.h"
+
+
+namespace MathLib
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                 DATA STRUCTURES
+////////////////////////////////////////////////////////////////////////////////////////////
+
+// packed vectors and quaternions (the components are in the same order
+// as in VECTOR3D, VECTOR4D and QUAT)
+typedef struct VECTOR3D_F16_TYPE  { uint16_t M[3]; } VECTOR3D_F16,  *VECTOR3D_F16_PTR;
+typedef struct VECTOR4D_F16_TYPE  { uint16_t M[4]; } VECTOR4D_F16,  *VECTOR4D_F16_PTR;
+typedef struct QUAT_F16_TYPE      { uint16_t M[4]; } QUAT_F16,      *QUAT_F16_PTR;
+
+typedef struct VECTOR3D_BF16_TYPE { uint16_t M[3]; } VECTOR3D_BF16, *VECTOR3D_BF16_PTR;
+typedef struct VECTOR4D_BF16_TYPE { uint16_t M[4]; } VECTOR4D_BF16, *VECTOR4D_BF16_PTR;
+typedef struct QUAT_BF16_TYPE     { uint16_t M[4]; } QUAT_BF16,     *QUAT_BF16_PTR;
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                              SCALAR CONVERSIONS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+//
+// all the conversions round to nearest even, keep the sign of zeros, infinities and
+// NaNs (NaNs become quiet, the upper bits of the payload are kept); the results are
+// exactly the same as the ones of the F16C instructions, so each batch kernel gives
+// the same bits; fp16: the values >= 65520 become infinities, the values < 2^-25
+// become zeros
+//
+
+inline uint16_t Float_To_Half(const float f)
+{
+	const float subnormMagic = 0.5f;   // ((127 - 15) + (23 - 10) + 1) << 23
+
+	uint32_t bits;
+	memcpy(&bits, &f, sizeof(bits));
+
+	const uint32_t sign = (bits >> 16) & 0x8000;
+	uint32_t absBits = bits & 0x7fffffff;
+	uint32_t res;
+
+	if (absBits >= ((127 + 16) << 23))
+	{
+		// infinity or NaN (or too large value)
+		res = (absBits > 0x7f800000) ? (0x7e00 | ((absBits >> 13) & 0x3ff)) : 0x7c00;
+	}
+	else if (absBits < ((127 - 14) << 23))
+	{
+		// a denormal half (or zero): the float addition rounds the mantissa
+		float absF;
+		memcpy(&absF, &absBits, sizeof(absF));
+		absF += subnormMagic;
+
+		memcpy(&res, &absF, sizeof(res));
+		res -= (126 << 23);
+	}
+	else
+	{
+		// a normal half: rebias the exponent and round the mantissa (to even)
+		const uint32_t mantOdd = (absBits >> 13) & 1;
+
+		absBits = absBits - ((127u - 15u) << 23) + 0xfff;
+		absBits += mantOdd;
+		res = absBits >> 13;
+	}
+
+	return (uint16_t)(res | sign);
+
+} // end Float_To_Half
+
+///////////////////////////////////////////////////////////
+
+inline float Half_To_Float(const uint16_t h)
+{
+	const uint32_t shiftedExp = 0x7c00 << 13;
+	const float denormMagic = 6.103515625e-05f;   // 113 << 23 (2^-14)
+
+	uint32_t bits = (uint32_t)(h & 0x7fff) << 13;
+	const uint32_t exp = bits & shiftedExp;
+
+	bits += (127 - 15) << 23;
+
+	if (exp == shiftedExp)
+	{
+		// infinity or NaN (NaNs become quiet)
+		bits += (128 - 16) << 23;
+
+		if (h & 0x3ff)
+			bits |= 0x00400000;
+	}
+	else if (exp == 0)
+	{
+		// zero or denormal: renormalize by the float subtraction (exact)
+		bits += 1 << 23;
+
+		float f;
+		memcpy(&f, &bits, sizeof(f));
+		f -= denormMagic;
+		memcpy(&bits, &f, sizeof(bits));
+	}
+
+	bits |= (uint32_t)(h & 0x8000) << 16;
+
+	float f;
+	memcpy(&f, &bits, sizeof(f));
+
+	return f;
+
+} // end Half_To_Float
+
+///////////////////////////////////////////////////////////
+
+inline uint16_t Float_To_BF16(const float f)
+{
+	uint32_t bits;
+	memcpy(&bits, &f, sizeof(bits));
+
+	// NaN: keep the upper bits of the payload and make it quiet
+	if ((bits & 0x7fffffff) > 0x7f800000)
+		return (uint16_t)((bits >> 16) | 0x40);
+
+	// round to nearest even (an overflow gives the infinity)
+	return (uint16_t)((bits + 0x7fff + ((bits >> 16) & 1)) >> 16);
+
+} // end Float_To_BF16
+
+///////////////////////////////////////////////////////////
+
+inline float BF16_To_Float(const uint16_t b)
+{
+	const uint32_t bits = (uint32_t)b << 16;
+
+	float f;
+	memcpy(&f, &bits, sizeof(f));
+
+	return f;
+
+} // end BF16_To_Float
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                          BULK CONVERSIONS OF STREAMS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+//
+// each function converts num values; the functions without a suffix choose the best
+// kernel for the current CPU (see SIMD_Get_Level; fp16 AVX2 kernels also need F16C);
+// all the kernels give exactly the same results as the scalar conversions
+//
+
+void Float_To_Half_Batch(const float* in, uint16_t* out, const int num);
+void Half_To_Float_Batch(const uint16_t* in, float* out, const int num);
+void Float_To_BF16_Batch(const float* in, uint16_t* out, const int num);
+void BF16_To_Float_Batch(const uint16_t* in, float* out, const int num);
+
+// separate kernels (SSE/AVX2 kernels must be called only if the CPU supports them)
+void Float_To_Half_Batch_Scalar(const float* in, uint16_t* out, const int num);
+void Float_To_Half_Batch_SSE   (const float* in, uint16_t* out, const int num);
+void Float_To_Half_Batch_AVX2  (const float* in, uint16_t* out, const int num);
+
+void Half_To_Float_Batch_Scalar(const uint16_t* in, float* out, const int num);
+void Half_To_Float_Batch_SSE   (const uint16_t* in, float* out, const int num);
+void Half_To_Float_Batch_AVX2  (const uint16_t* in, float* out, const int num);
+
+void Float_To_BF16_Batch_Scalar(const float* in, uint16_t* out, const int num);
+void Float_To_BF16_Batch_SSE   (const float* in, uint16_t* out, const int num);
+void Float_To_BF16_Batch_AVX2  (const float* in, uint16_t* out, const int num);
+
+void BF16_To_Float_Batch_Scalar(const uint16_t* in, float* out, const int num);
+void BF16_To_Float_Batch_SSE   (const uint16_t* in, float* out, const int num);
+void BF16_To_Float_Batch_AVX2  (const uint16_t* in, float* out, const int num);
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                     PACKING OF ARRAYS OF VECTORS AND QUATERNIONS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+// (the arrays are continuous streams of the components)
+
+inline void Pack_Batch(const VECTOR3D* in, VECTOR3D_F16* out, const int num)    { Float_To_Half_Batch(in->M, out->M, 3 * num); }
+inline void Pack_Batch(const VECTOR4D* in, VECTOR4D_F16* out, const int num)    { Float_To_Half_Batch(in->M, out->M, 4 * num); }
+inline void Pack_Batch(const QUAT* in, QUAT_F16* out, const int num)            { Float_To_Half_Batch(in->M, out->M, 4 * num); }
+
+inline void Pack_Batch(const VECTOR3D* in, VECTOR3D_BF16* out, const int num)   { Float_To_BF16_Batch(in->M, out->M, 3 * num); }
+inline void Pack_Batch(const VECTOR4D* in, VECTOR4D_BF16* out, const int num)   { Float_To_BF16_Batch(in->M, out->M, 4 * num); }
+inline void Pack_Batch(const QUAT* in, QUAT_BF16* out, const int num)           { Float_To_BF16_Batch(in->M, out->M, 4 * num); }
+
+inline void Unpack_Batch(const VECTOR3D_F16* in, VECTOR3D* out, const int num)  { Half_To_Float_Batch(in->M, out->M, 3 * num); }
+inline void Unpack_Batch(const VECTOR4D_F16* in, VECTOR4D* out, const int num)  { Half_To_Float_Batch(in->M, out->M, 4 * num); }
+inline void Unpack_Batch(const QUAT_F16* in, QUAT* out, const int num)          { Half_To_Float_Batch(in->M, out->M, 4 * num); }
+
+inline void Unpack_Batch(const VECTOR3D_BF16* in, VECTOR3D* out, const int num) { BF16_To_Float_Batch(in->M, out->M, 3 * num); }
+inline void Unpack_Batch(const VECTOR4D_BF16* in, VECTOR4D* out, const int num) { BF16_To_Float_Batch(in->M, out->M, 4 * num); }
+inline void Unpack_Batch(const QUAT_BF16* in, QUAT* out, const int num)         { BF16_To_Float_Batch(in->M, out->M, 4 * num); }
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                    TRANSFORMATION OF PACKED VECTORS BY MATRICES
+////////////////////////////////////////////////////////////////////////////////////////////
+
+//
+// each function transforms num packed vectors by the 4x4 matrix: a vector is unpacked,
+// multiplied exactly as by Mat_Mul_VECTOR4D_4X4 and packed again, so the result
+// is the same as packing of the result of Mat_Mul_VECTOR4D_4X4 for each kernel;
+// the output may be the same array as the input
+//
+
+void Mat_Mul_VECTOR4D_4X4_F16_Batch(const VECTOR4D_F16* in, const MATRIX4X4* pM, VECTOR4D_F16* out, const int num);
+void Mat_Mul_VECTOR4D_4X4_BF16_Batch(const VECTOR4D_BF16* in, const MATRIX4X4* pM, VECTOR4D_BF16* out, const int num);
+
+// separate kernels (SSE/AVX2 kernels must be called only if the CPU supports them)
+void Mat_Mul_VECTOR4D_4X4_F16_Batch_Scalar(const VECTOR4D_F16* in, const MATRIX4X4* pM, VECTOR4D_F16* out, const int num);
+void Mat_Mul_VECTOR4D_4X4_F16_Batch_SSE   (const VECTOR4D_F16* in, const MATRIX4X4* pM, VECTOR4D_F16* out, const int num);
+void Mat_Mul_VECTOR4D_4X4_F16_Batch_AVX2  (const VECTOR4D_F16* in, const MATRIX4X4* pM, VECTOR4D_F16* out, const int num);
+
+void Mat_Mul_VECTOR4D_4X4_BF16_Batch_Scalar(const VECTOR4D_BF16* in, const MATRIX4X4* pM, VECTOR4D_BF16* out, const int num);
+void Mat_Mul_VECTOR4D_4X4_BF16_Batch_SSE   (const VECTOR4D_BF16* in, const MATRIX4X4* pM, VECTOR4D_BF16* out, const int num);
+void Mat_Mul_VECTOR4D_4X4_BF16_Batch_AVX2  (const VECTOR4D_BF16* in, const MATRIX4X4* pM, VECTOR4D_BF16* out, const int num);
+
+} // end namespace MathLib
@@ -0,0 +1,520 @@
+////////////////////////////////////////////////////////////////////////////////////////////
+// Filename:      MatrixSimd.cpp
+// Description:   contains implementation of SIMD kernels for 4x4 matrices
+//                and their runtime dispatching
+//
+// Created:       17.10.26
+////////////////////////////////////////////////////////////////////////////////////////////
+#include "MatrixSimd.h"
+#include "../Utils/Simd.h"
+
+
+namespace MathLib
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                SCALAR REFERENCE
+////////////////////////////////////////////////////////////////////////////////////////////
+
+int Mat_Inverse_4X4_General(const MATRIX4X4* pM, MATRIX4X4* pMi)
+{
+	// this function computes an inverse of any 4x4 matrix (not only affine) using
+	// m-1 = adjoint(m) / det(m); the cofactors are computed through 2x2 minors
+	// of the top and the bottom pairs of rows;
+	//
+	// if the inverse matrix exists the function returns 1;
+	// in another case it returns 0, and the matrix pMi is a zero matrix;
+
+	assert(pM != nullptr);
+	assert(pMi != nullptr);
+
+	const float(*m)[4] = pM->M;
+
+	// 2x2 minors of the rows 0 and 1
+	const float s0 = m[0][0] * m[1][1] - m[1][0] * m[0][1];
+	const float s1 = m[0][0] * m[1][2] - m[1][0] * m[0][2];
+	const float s2 = m[0][0] * m[1][3] - m[1][0] * m[0][3];
+	const float s3 = m[0][1] * m[1][2] - m[1][1] * m[0][2];
+	const float s4 = m[0][1] * m[1][3] - m[1][1] * m[0][3];
+	const float s5 = m[0][2] * m[1][3] - m[1][2] * m[0][3];
+
+	// 2x2 minors of the rows 2 and 3
+	const float c5 = m[2][2] * m[3][3] - m[3][2] * m[2][3];
+	const float c4 = m[2][1] * m[3][3] - m[3][1] * m[2][3];
+	const float c3 = m[2][1] * m[3][2] - m[3][1] * m[2][2];
+	const float c2 = m[2][0] * m[3][3] - m[3][0] * m[2][3];
+	const float c1 = m[2][0] * m[3][2] - m[3][0] * m[2][2];
+	const float c0 = m[2][0] * m[3][1] - m[3][0] * m[2][1];
+
+	const float det = s0*c5 - s1*c4 + s2*c3 + s3*c2 - s4*c1 + s5*c0;
+
+	// test determinate to see if it it 0
+	if (fabs(det) < EPSILON_E5)
+	{
+		MATRIX_ZERO_4X4(pMi);
+		return 0;
+	}
+
+	const float det_inv = 1.0f / det;
+
+	// compute into a temporary matrix since pMi can be the same as pM
+	MATRIX4X4 mi;
+
+	mi.M00 = ( m[1][1]*c5 - m[1][2]*c4 + m[1][3]*c3) * det_inv;
+	mi.M01 = (-m[0][1]*c5 + m[0][2]*c4 - m[0][3]*c3) * det_inv;
+	mi.M02 = ( m[3][1]*s5 - m[3][2]*s4 + m[3][3]*s3) * det_inv;
+	mi.M03 = (-m[2][1]*s5 + m[2][2]*s4 - m[2][3]*s3) * det_inv;
+
+	mi.M10 = (-m[1][0]*c5 + m[1][2]*c2 - m[1][3]*c1) * det_inv;
+	mi.M11 = ( m[0][0]*c5 - m[0][2]*c2 + m[0][3]*c1) * det_inv;
+	mi.M12 = (-m[3][0]*s5 + m[3][2]*s2 - m[3][3]*s1) * det_inv;
+	mi.M13 = ( m[2][0]*s5 - m[2][2]*s2 + m[2][3]*s1) * det_inv;
+
+	mi.M20 = ( m[1][0]*c4 - m[1][1]*c2 + m[1][3]*c0) * det_inv;
+	mi.M21 = (-m[0][0]*c4 + m[0][1]*c2 - m[0][3]*c0) * det_inv;
+	mi.M22 = ( m[3][0]*s4 - m[3][1]*s2 + m[3][3]*s0) * det_inv;
+	mi.M23 = (-m[2][0]*s4 + m[2][1]*s2 - m[2][3]*s0) * det_inv;
+
+	mi.M30 = (-m[1][0]*c3 + m[1][1]*c1 - m[1][2]*c0) * det_inv;
+	mi.M31 = ( m[0][0]*c3 - m[0][1]*c1 + m[0][2]*c0) * det_inv;
+	mi.M32 = (-m[3][0]*s3 + m[3][1]*s1 - m[3][2]*s0) * det_inv;
+	mi.M33 = ( m[2][0]*s3 - m[2][1]*s1 + m[2][2]*s0) * det_inv;
+
+	MAT_COPY_4X4(&mi, pMi);
+
+	return 1;
+
+} // end Mat_Inverse_4X4_General
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                  SIMD KERNELS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+#if MATHLIB_SIMD_X86
+
+// shuffle mask for _mm_shuffle_ps / _mm_shuffle_epi32 in the natural (x, y, z, w) order
+#define MATHLIB_SHUFFLE_MASK(x, y, z, w)  ((x) | ((y) << 2) | ((z) << 4) | ((w) << 6))
+
+// vec = (vec[x], vec[y], vec[z], vec[w])
+#define MATHLIB_SWIZZLE(vec, x, y, z, w) \
+	_mm_castsi128_ps(_mm_shuffle_epi32(_mm_castps_si128(vec), MATHLIB_SHUFFLE_MASK(x, y, z, w)))
+
+// (a[x], a[y], b[z], b[w])
+#define MATHLIB_SHUFFLE(a, b, x, y, z, w)  _mm_shuffle_ps(a, b, MATHLIB_SHUFFLE_MASK(x, y, z, w))
+
+
+//
+// helpers for the block inverse; a 2x2 matrix is stored in a register
+// in row major form: (m00, m01, m10, m11); A# means the adjugate of A
+//
+
+MATHLIB_TARGET_SSE41
+static inline __m128 Mat2_Mul(const __m128 a, const __m128 b)
+{
+	// A * B
+	return _mm_add_ps(_mm_mul_ps(a, MATHLIB_SWIZZLE(b, 0, 3, 0, 3)),
+	                  _mm_mul_ps(MATHLIB_SWIZZLE(a, 1, 0, 3, 2), MATHLIB_SWIZZLE(b, 2, 1, 2, 1)));
+}
+
+MATHLIB_TARGET_SSE41
+static inline __m128 Mat2_Adj_Mul(const __m128 a, const __m128 b)
+{
+	// A# * B
+	return _mm_sub_ps(_mm_mul_ps(MATHLIB_SWIZZLE(a, 3, 3, 0, 0), b),
+	                  _mm_mul_ps(MATHLIB_SWIZZLE(a, 1, 1, 2, 2), MATHLIB_SWIZZLE(b, 2, 3, 0, 1)));
+}
+
+MATHLIB_TARGET_SSE41
+static inline __m128 Mat2_Mul_Adj(const __m128 a, const __m128 b)
+{
+	// A * B#
+	return _mm_sub_ps(_mm_mul_ps(a, MATHLIB_SWIZZLE(b, 3, 0, 3, 0)),
+	                  _mm_mul_ps(MATHLIB_SWIZZLE(a, 1, 0, 3, 2), MATHLIB_SWIZZLE(b, 2, 1, 2, 1)));
+}
+
+MATHLIB_TARGET_SSE41
+static inline __m128 Cross3(const __m128 a, const __m128 b)
+{
+	// cross product of xyz parts of a and b (w of the result is 0 if a.w and b.w are finite)
+	const __m128 aYZX = MATHLIB_SWIZZLE(a, 1, 2, 0, 3);
+	const __m128 bYZX = MATHLIB_SWIZZLE(b, 1, 2, 0, 3);
+	const __m128 c = _mm_sub_ps(_mm_mul_ps(a, bYZX), _mm_mul_ps(aYZX, b));
+
+	return MATHLIB_SWIZZLE(c, 1, 2, 0, 3);
+}
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_SSE41
+void Mat_Mul_4X4_SSE(const MATRIX4X4* pMatA, const MATRIX4X4* pMatB, MATRIX4X4* pMProd)
+{
+	// this function multiplies two 4x4 matrices; each row of the product is
+	// a linear combination of rows of pMatB: prod[i] = sum_k(a[i][k] * b[k]);
+	// the summation order is the same as in Mat_Mul_4X4
+
+	assert(pMatA != nullptr);
+	assert(pMatB != nullptr);
+	assert(pMProd != nullptr);
+
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 b0 = _mm_loadu_ps(pMatB->M[0]);
+	const __m128 b1 = _mm_loadu_ps(pMatB->M[1]);
+	const __m128 b2 = _mm_loadu_ps(pMatB->M[2]);
+	const __m128 b3 = _mm_loadu_ps(pMatB->M[3]);
+
+	// compute all the rows before storing since pMProd can be the same as pMatA
+	__m128 rows[4];
+
+	for (int i = 0; i < 4; i++)
+	{
+		const __m128 a = _mm_loadu_ps(pMatA->M[i]);
+
+		__m128 sum = _mm_add_ps(zero, _mm_mul_ps(MATHLIB_SWIZZLE(a, 0, 0, 0, 0), b0));
+		sum = _mm_add_ps(sum, _mm_mul_ps(MATHLIB_SWIZZLE(a, 1, 1, 1, 1), b1));
+		sum = _mm_add_ps(sum, _mm_mul_ps(MATHLIB_SWIZZLE(a, 2, 2, 2, 2), b2));
+		rows[i] = _mm_add_ps(sum, _mm_mul_ps(MATHLIB_SWIZZLE(a, 3, 3, 3, 3), b3));
+	}
+
+	for (int i = 0; i < 4; i++)
+		_mm_storeu_ps(pMProd->M[i], rows[i]);
+
+} // end Mat_Mul_4X4_SSE
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_AVX
+void Mat_Mul_4X4_AVX(const MATRIX4X4* pMatA, const MATRIX4X4* pMatB, MATRIX4X4* pMProd)
+{
+	// this function multiplies two 4x4 matrices; it is the same as the SSE kernel
+	// but computes two rows of the product at once (one per 128-bit lane)
+
+	assert(pMatA != nullptr);
+	assert(pMatB != nullptr);
+	assert(pMProd != nullptr);
+
+	const __m256 zero = _mm256_setzero_ps();
+
+	// each row of pMatB is duplicated into both lanes
+	const __m256 b0 = _mm256_broadcast_ps((const __m128*)pMatB->M[0]);
+	const __m256 b1 = _mm256_broadcast_ps((const __m128*)pMatB->M[1]);
+	const __m256 b2 = _mm256_broadcast_ps((const __m128*)pMatB->M[2]);
+	const __m256 b3 = _mm256_broadcast_ps((const __m128*)pMatB->M[3]);
+
+	// rows 0|1 and 2|3 of pMatA
+	const __m256 a01 = _mm256_loadu_ps(pMatA->M[0]);
+	const __m256 a23 = _mm256_loadu_ps(pMatA->M[2]);
+
+	__m256 p01 = _mm256_add_ps(zero, _mm256_mul_ps(_mm256_shuffle_ps(a01, a01, 0x00), b0));
+	__m256 p23 = _mm256_add_ps(zero, _mm256_mul_ps(_mm256_shuffle_ps(a23, a23, 0x00), b0));
+
+	p01 = _mm256_add_ps(p01, _mm256_mul_ps(_mm256_shuffle_ps(a01, a01, 0x55), b1));
+	p23 = _mm256_add_ps(p23, _mm256_mul_ps(_mm256_shuffle_ps(a23, a23, 0x55), b1));
+
+	p01 = _mm256_add_ps(p01, _mm256_mul_ps(_mm256_shuffle_ps(a01, a01, 0xAA), b2));
+	p23 = _mm256_add_ps(p23, _mm256_mul_ps(_mm256_shuffle_ps(a23, a23, 0xAA), b2));
+
+	p01 = _mm256_add_ps(p01, _mm256_mul_ps(_mm256_shuffle_ps(a01, a01, 0xFF), b3));
+	p23 = _mm256_add_ps(p23, _mm256_mul_ps(_mm256_shuffle_ps(a23, a23, 0xFF), b3));
+
+	_mm256_storeu_ps(pMProd->M[0], p01);
+	_mm256_storeu_ps(pMProd->M[2], p23);
+
+} // end Mat_Mul_4X4_AVX
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_SSE41
+void Mat_Transpose_4X4_SSE(const MATRIX4X4* pMatSrc, MATRIX4X4* pMatDst)
+{
+	// this function transposes a 4x4 matrix (pMatDst can be the same as pMatSrc)
+
+	assert(pMatSrc != nullptr);
+	assert(pMatDst != nullptr);
+
+	__m128 r0 = _mm_loadu_ps(pMatSrc->M[0]);
+	__m128 r1 = _mm_loadu_ps(pMatSrc->M[1]);
+	__m128 r2 = _mm_loadu_ps(pMatSrc->M[2]);
+	__m128 r3 = _mm_loadu_ps(pMatSrc->M[3]);
+
+	_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+	_mm_storeu_ps(pMatDst->M[0], r0);
+	_mm_storeu_ps(pMatDst->M[1], r1);
+	_mm_storeu_ps(pMatDst->M[2], r2);
+	_mm_storeu_ps(pMatDst->M[3], r3);
+
+} // end Mat_Transpose_4X4_SSE
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_SSE41
+int Mat_Inverse_4X4_SSE(const MATRIX4X4* pM, MATRIX4X4* pMi)
+{
+	// this function computes an inverse of any 4x4 matrix using block matrices:
+	//
+	//        | A  B |                  1    | X  Y |
+	//    M = |      |    =>   M-1 = ------- |      |
+	//        | C  D |                |M|    | Z  W |
+	//
+	// where A, B, C, D are 2x2 blocks, and X#, Y#, Z#, W# are computed through
+	// adjugates of the blocks (so we have no divisions except the 1/|M|);
+	//
+	// if the inverse matrix exists the function returns 1;
+	// in another case it returns 0, and the matrix pMi is a zero matrix;
+
+	assert(pM != nullptr);
+	assert(pMi != nullptr);
+
+	const __m128 r0 = _mm_loadu_ps(pM->M[0]);
+	const __m128 r1 = _mm_loadu_ps(pM->M[1]);
+	const __m128 r2 = _mm_loadu_ps(pM->M[2]);
+	const __m128 r3 = _mm_loadu_ps(pM->M[3]);
+
+	// 2x2 blocks
+	const __m128 A = _mm_movelh_ps(r0, r1);
+	const __m128 B = _mm_movehl_ps(r1, r0);
+	const __m128 C = _mm_movelh_ps(r2, r3);
+	const __m128 D = _mm_movehl_ps(r3, r2);
+
+	// determinants of the blocks: (|A|, |B|, |C|, |D|)
+	const __m128 detSub = _mm_sub_ps(
+		_mm_mul_ps(MATHLIB_SHUFFLE(r0, r2, 0, 2, 0, 2), MATHLIB_SHUFFLE(r1, r3, 1, 3, 1, 3)),
+		_mm_mul_ps(MATHLIB_SHUFFLE(r0, r2, 1, 3, 1, 3), MATHLIB_SHUFFLE(r1, r3, 0, 2, 0, 2)));
+
+	const __m128 detA = MATHLIB_SWIZZLE(detSub, 0, 0, 0, 0);
+	const __m128 detB = MATHLIB_SWIZZLE(detSub, 1, 1, 1, 1);
+	const __m128 detC = MATHLIB_SWIZZLE(detSub, 2, 2, 2, 2);
+	const __m128 detD = MATHLIB_SWIZZLE(detSub, 3, 3, 3, 3);
+
+	const __m128 D_C = Mat2_Adj_Mul(D, C);     // D#C
+	const __m128 A_B = Mat2_Adj_Mul(A, B);     // A#B
+
+	__m128 X_ = _mm_sub_ps(_mm_mul_ps(detD, A), Mat2_Mul(B, D_C));      // X# = |D|A - B(D#C)
+	__m128 W_ = _mm_sub_ps(_mm_mul_ps(detA, D), Mat2_Mul(C, A_B));      // W# = |A|D - C(A#B)
+	__m128 Y_ = _mm_sub_ps(_mm_mul_ps(detB, C), Mat2_Mul_Adj(D, A_B));  // Y# = |B|C - D(A#B)#
+	__m128 Z_ = _mm_sub_ps(_mm_mul_ps(detC, B), Mat2_Mul_Adj(A, D_C));  // Z# = |C|B - A(D#C)#
+
+	// |M| = |A|*|D| + |B|*|C| - tr((A#B)(D#C))
+	__m128 tr = _mm_mul_ps(A_B, MATHLIB_SWIZZLE(D_C, 0, 2, 1, 3));
+	tr = _mm_hadd_ps(tr, tr);
+	tr = _mm_hadd_ps(tr, tr);
+
+	const __m128 detM = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC)), tr);
+
+	// test determinate to see if it it 0
+	if (fabs(_mm_cvtss_f32(detM)) < EPSILON_E5)
+	{
+		MATRIX_ZERO_4X4(pMi);
+		return 0;
+	}
+
+	// (1/|M|, -1/|M|, -1/|M|, 1/|M|) applies the signs of the adjugate
+	const __m128 rDetM = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), detM);
+
+	X_ = _mm_mul_ps(X_, rDetM);
+	Y_ = _mm_mul_ps(Y_, rDetM);
+	Z_ = _mm_mul_ps(Z_, rDetM);
+	W_ = _mm_mul_ps(W_, rDetM);
+
+	// the final shuffles take the adjugates of the blocks and put them in place
+	_mm_storeu_ps(pMi->M[0], MATHLIB_SHUFFLE(X_, Y_, 3, 1, 3, 1));
+	_mm_storeu_ps(pMi->M[1], MATHLIB_SHUFFLE(X_, Y_, 2, 0, 2, 0));
+	_mm_storeu_ps(pMi->M[2], MATHLIB_SHUFFLE(Z_, W_, 3, 1, 3, 1));
+	_mm_storeu_ps(pMi->M[3], MATHLIB_SHUFFLE(Z_, W_, 2, 0, 2, 0));
+
+	return 1;
+
+} // end Mat_Inverse_4X4_SSE
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_SSE41
+int Mat_Inverse_4X4_Affine_SSE(const MATRIX4X4* pM, MATRIX4X4* pMi)
+{
+	// this function computes an inverse of 4x4 matrix where the last
+	// column is [0 0 0 1]t (transpose);
+	//
+	// columns of the inverse 3x3 part are cross products of the rows:
+	// (r1 x r2, r2 x r0, r0 x r1) / det, where det = r0 . (r1 x r2);
+	// the translation is -t * inverse(3x3)
+	//
+	// if the inverse matrix exists the function returns 1;
+	// in another case it returns 0, and the matrix pMi is a zero matrix;
+
+	assert(pM != nullptr);
+	assert(pMi != nullptr);
+
+	// rows of the 3x3 part (w is set to 0 so it can't break the cross products)
+	const __m128 maskXYZ = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+
+	const __m128 r0 = _mm_and_ps(_mm_loadu_ps(pM->M[0]), maskXYZ);
+	const __m128 r1 = _mm_and_ps(_mm_loadu_ps(pM->M[1]), maskXYZ);
+	const __m128 r2 = _mm_and_ps(_mm_loadu_ps(pM->M[2]), maskXYZ);
+	const __m128 t  = _mm_loadu_ps(pM->M[3]);
+
+	__m128 c0 = Cross3(r1, r2);
+	__m128 c1 = Cross3(r2, r0);
+	__m128 c2 = Cross3(r0, r1);
+
+	const float det = _mm_cvtss_f32(_mm_dp_ps(r0, c0, 0x71));
+
+	// test determinate to see if it it 0
+	if (fabs(det) < EPSILON_E5)
+	{
+		MATRIX_ZERO_4X4(pMi);
+		return 0;
+	}
+
+	const __m128 det_inv = _mm_set1_ps(1.0f / det);
+
+	c0 = _mm_mul_ps(c0, det_inv);
+	c1 = _mm_mul_ps(c1, det_inv);
+	c2 = _mm_mul_ps(c2, det_inv);
+
+	// the columns become rows; the 4th column is [0 0 0]
+	__m128 c3 = _mm_setzero_ps();
+	_MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+	// translation: -(tx*row0 + ty*row1 + tz*row2), and w = 1
+	__m128 tr = _mm_mul_ps(MATHLIB_SWIZZLE(t, 0, 0, 0, 0), c0);
+	tr = _mm_add_ps(tr, _mm_mul_ps(MATHLIB_SWIZZLE(t, 1, 1, 1, 1), c1));
+	tr = _mm_add_ps(tr, _mm_mul_ps(MATHLIB_SWIZZLE(t, 2, 2, 2, 2), c2));
+	tr = _mm_sub_ps(_mm_setzero_ps(), tr);
+	tr = _mm_blend_ps(tr, _mm_set1_ps(1.0f), 0x8);
+
+	_mm_storeu_ps(pMi->M[0], c0);
+	_mm_storeu_ps(pMi->M[1], c1);
+	_mm_storeu_ps(pMi->M[2], c2);
+	_mm_storeu_ps(pMi->M[3], tr);
+
+	return 1;
+
+} // end Mat_Inverse_4X4_Affine_SSE
+
+#undef MATHLIB_SHUFFLE
+#undef MATHLIB_SWIZZLE
+#undef MATHLIB_SHUFFLE_MASK
+
+#else
+
+// there is no SIMD support for this platform so use the reference functions
+
+void Mat_Mul_4X4_SSE(const MATRIX4X4* pMatA, const MATRIX4X4* pMatB, MATRIX4X4* pMProd)
+{
+	MATRIX4X4 prod;
+	Mat_Mul_4X4(pMatA, pMatB, &prod);
+	MAT_COPY_4X4(&prod, pMProd);
+}
+
+void Mat_Mul_4X4_AVX(const MATRIX4X4* pMatA, const MATRIX4X4* pMatB, MATRIX4X4* pMProd)
+{
+	Mat_Mul_4X4_SSE(pMatA, pMatB, pMProd);
+}
+
+void Mat_Transpose_4X4_SSE(const MATRIX4X4* pMatSrc, MATRIX4X4* pMatDst)
+{
+	MATRIX4X4 mt;
+	MAT_TRANSPOSE_4X4(pMatSrc, &mt);
+	MAT_COPY_4X4(&mt, pMatDst);
+}
+
+int Mat_Inverse_4X4_SSE(const MATRIX4X4* pM, MATRIX4X4* pMi)
+{
+	return Mat_Inverse_4X4_General(pM, pMi);
+}
+
+int Mat_Inverse_4X4_Affine_SSE(const MATRIX4X4* pM, MATRIX4X4* pMi)
+{
+	MATRIX4X4 mi;
+	const int result = Mat_Inverse_4X4(pM, &mi);
+	MAT_COPY_4X4(&mi, pMi);
+	return result;
+}
+
+#endif // MATHLIB_SIMD_X86
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                   DISPATCHERS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void Mat_Mul_4X4_SIMD(const MATRIX4X4* pMatA, const MATRIX4X4* pMatB, MATRIX4X4* pMProd)
+{
+	// multiplies two 4x4 matrices using the best kernel for the current CPU
+
+	const SIMD_LEVEL level = SIMD_Get_Level();
+
+	if (level >= SIMD_LEVEL_AVX)
+	{
+		Mat_Mul_4X4_AVX(pMatA, pMatB, pMProd);
+	}
+	else if (level == SIMD_LEVEL_SSE)
+	{
+		Mat_Mul_4X4_SSE(pMatA, pMatB, pMProd);
+	}
+	else
+	{
+		// the reference function doesn't allow the output to be one of inputs
+		MATRIX4X4 prod;
+		Mat_Mul_4X4(pMatA, pMatB, &prod);
+		MAT_COPY_4X4(&prod, pMProd);
+	}
+
+} // end Mat_Mul_4X4_SIMD
+
+///////////////////////////////////////////////////////////
+
+void Mat_Transpose_4X4_SIMD(const MATRIX4X4* pMatSrc, MATRIX4X4* pMatDst)
+{
+	// transposes a 4x4 matrix using the best kernel for the current CPU
+
+	if (SIMD_Get_Level() >= SIMD_LEVEL_SSE)
+	{
+		Mat_Transpose_4X4_SSE(pMatSrc, pMatDst);
+	}
+	else
+	{
+		MATRIX4X4 mt;
+		MAT_TRANSPOSE_4X4(pMatSrc, &mt);
+		MAT_COPY_4X4(&mt, pMatDst);
+	}
+
+} // end Mat_Transpose_4X4_SIMD
+
+///////////////////////////////////////////////////////////
+
+int Mat_Inverse_4X4_SIMD(const MATRIX4X4* pM, MATRIX4X4* pMi)
+{
+	// computes an inverse of any 4x4 matrix using the best kernel for the current CPU
+
+	if (SIMD_Get_Level() >= SIMD_LEVEL_SSE)
+		return Mat_Inverse_4X4_SSE(pM, pMi);
+
+	return Mat_Inverse_4X4_General(pM, pMi);
+
+} // end Mat_Inverse_4X4_SIMD
+
+///////////////////////////////////////////////////////////
+
+int Mat_Inverse_4X4_Affine_SIMD(const MATRIX4X4* pM, MATRIX4X4* pMi)
+{
+	// computes an inverse of an affine 4x4 matrix using the best kernel for the current CPU
+
+	if (SIMD_Get_Level() >= SIMD_LEVEL_SSE)
+		return Mat_Inverse_4X4_Affine_SSE(pM, pMi);
+
+	// the reference function doesn't allow the output to be the input
+	MATRIX4X4 mi;
+	const int result = Mat_Inverse_4X4(pM, &mi);
+	MAT_COPY_4X4(&mi, pMi);
+
+	return result;
+
+} // end Mat_Inverse_4X4_Affine_SIMD
+
+} // end namespace MathLib
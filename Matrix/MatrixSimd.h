@@ -0,0 +1,75 @@
+////////////////////////////////////////////////////////////////////////////////////////////
+// Filename:      MatrixSimd.h
+// Description:   contains a 16-byte aligned 4x4 matrix type and SIMD kernels
+//                (multiplication, transpose, general/affine inverse) for 4x4 matrices
+//                with runtime dispatching;
+//
+//                the scalar functions from Matrix.h are the reference path
+//
+// Created:       17.10.26
+////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "Matrix.h"
+
+
+namespace MathLib
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                  DATA STRUCTURES
+////////////////////////////////////////////////////////////////////////////////////////////
+
+// 16-byte aligned matrix 4x4; it has the same layout as MATRIX4X4 so a pointer to it
+// can be passed into any function which takes MATRIX4X4* (rows are never split
+// between cache lines and can be loaded with aligned SIMD loads)
+typedef struct alignas(16) MATRIX4X4A_TYPE : public MATRIX4X4_TYPE
+{
+} MATRIX4X4A, *MATRIX4X4A_PTR;
+
+static_assert(sizeof(MATRIX4X4A) == sizeof(MATRIX4X4), "MATRIX4X4A must have the layout of MATRIX4X4");
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                             FUNCTIONS PROTOTYPES
+////////////////////////////////////////////////////////////////////////////////////////////
+
+//
+// dispatchers: choose the best kernel for the current CPU (see SIMD_Get_Level);
+// output may be the same matrix as one of the inputs
+//
+
+// pMProd = pMatA * pMatB (bit-compatible with Mat_Mul_4X4)
+void Mat_Mul_4X4_SIMD(const MATRIX4X4* pMatA, const MATRIX4X4* pMatB, MATRIX4X4* pMProd);
+
+// pMatDst = transpose(pMatSrc)
+void Mat_Transpose_4X4_SIMD(const MATRIX4X4* pMatSrc, MATRIX4X4* pMatDst);
+
+// inverse of any invertible 4x4 matrix (reference: Mat_Inverse_4X4_General);
+// returns 1 if the inverse exists; in another case returns 0 and pMi is a zero matrix
+int Mat_Inverse_4X4_SIMD(const MATRIX4X4* pM, MATRIX4X4* pMi);
+
+// inverse of a matrix with the last column [0 0 0 1]t (reference: Mat_Inverse_4X4)
+int Mat_Inverse_4X4_Affine_SIMD(const MATRIX4X4* pM, MATRIX4X4* pMi);
+
+///////////////////////////////////////////////////////////////
+
+// scalar reference of the general inverse (the cofactor expansion)
+int Mat_Inverse_4X4_General(const MATRIX4X4* pM, MATRIX4X4* pMi);
+
+///////////////////////////////////////////////////////////////
+
+//
+// separate kernels (must be called only if the CPU supports them)
+//
+void Mat_Mul_4X4_SSE(const MATRIX4X4* pMatA, const MATRIX4X4* pMatB, MATRIX4X4* pMProd);
+void Mat_Mul_4X4_AVX(const MATRIX4X4* pMatA, const MATRIX4X4* pMatB, MATRIX4X4* pMProd);
+
+void Mat_Transpose_4X4_SSE(const MATRIX4X4* pMatSrc, MATRIX4X4* pMatDst);
+
+int Mat_Inverse_4X4_SSE(const MATRIX4X4* pM, MATRIX4X4* pMi);
+int Mat_Inverse_4X4_Affine_SSE(const MATRIX4X4* pM, MATRIX4X4* pMi);
+
+} // end namespace MathLib
@@ -0,0 +1,292 @@
+////////////////////////////////////////////////////////////////////////////////////////////
+// Filename:      MixedPrecision.cpp
+// Description:   contains implementation of the mixed precision functional: rebasing
+//                of double world data relative to a camera and transformation of float
+//                local points by double world matrices (scalar, SSE and AVX2 kernels +
+//                runtime dispatching)
+//
+// Created:       17.10.26
+////////////////////////////////////////////////////////////////////////////////////////////
+#include "MixedPrecision.h"
+#include "MatrixBatch.h"
+#include "../Utils/Simd.h"
+
+
+namespace MathLib
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                   REBASING
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void Mat_Rebase_4X4(const Mat4d & world, const Vec3d & origin, MATRIX4X4* pLocal)
+{
+	// this function converts the double world matrix into the float matrix which
+	// gives the coordinates relative to the origin; the rotation/scale part is only
+	// rounded to float, the translation is reduced by the origin before the rounding,
+	// so it is small (and precise) for the objects near the origin
+
+	assert(pLocal != nullptr);
+
+	for (int row = 0; row < 3; row++)
+		for (int col = 0; col < 4; col++)
+			pLocal->M[row][col] = (float)world.M[row][col];
+
+	pLocal->M[3][0] = (float)(world.M[3][0] - origin.M[0]);
+	pLocal->M[3][1] = (float)(world.M[3][1] - origin.M[1]);
+	pLocal->M[3][2] = (float)(world.M[3][2] - origin.M[2]);
+	pLocal->M[3][3] = (float)world.M[3][3];
+
+} // end Mat_Rebase_4X4
+
+///////////////////////////////////////////////////////////
+
+void POINT3D_Rebase_Batch(const double* xIn, const double* yIn, const double* zIn,
+	const Vec3d & origin,
+	float* xOut, float* yOut, float* zOut,
+	const int num)
+{
+	// this function converts num double world points into float points relative to
+	// the origin; the loop is simple enough to be vectorized by the compiler
+
+	assert(xIn && yIn && zIn);
+	assert(xOut && yOut && zOut);
+	assert(num >= 0);
+
+	const double ox = origin.M[0];
+	const double oy = origin.M[1];
+	const double oz = origin.M[2];
+
+	for (int i = 0; i < num; i++)
+	{
+		xOut[i] = (float)(xIn[i] - ox);
+		yOut[i] = (float)(yIn[i] - oy);
+		zOut[i] = (float)(zIn[i] - oz);
+	}
+
+} // end POINT3D_Rebase_Batch
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//               TRANSFORMATION OF FLOAT POINTS BY DOUBLE WORLD MATRICES
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void Mat_Mul_VECTOR3D_4X4D_Batch_Scalar(const float* xIn, const float* yIn, const float* zIn,
+	const Mat4d & world,
+	double* xOut, double* yOut, double* zOut,
+	const int num)
+{
+	// transforms num float points by the double matrix using plain C++ code (reference kernel)
+
+	assert(xIn && yIn && zIn);
+	assert(xOut && yOut && zOut);
+	assert(num >= 0);
+
+	for (int i = 0; i < num; i++)
+	{
+		const double x = xIn[i];
+		const double y = yIn[i];
+		const double z = zIn[i];
+
+		double res[3];
+
+		for (int col = 0; col < 3; col++)
+		{
+			double sum = 0.0;
+
+			sum += x * world.M[0][col];
+			sum += y * world.M[1][col];
+			sum += z * world.M[2][col];
+			sum += world.M[3][col];
+
+			res[col] = sum;
+		}
+
+		xOut[i] = res[0];
+		yOut[i] = res[1];
+		zOut[i] = res[2];
+	}
+
+} // end Mat_Mul_VECTOR3D_4X4D_Batch_Scalar
+
+///////////////////////////////////////////////////////////
+
+#if MATHLIB_SIMD_X86
+
+MATHLIB_TARGET_SSE41
+void Mat_Mul_VECTOR3D_4X4D_Batch_SSE(const float* xIn, const float* yIn, const float* zIn,
+	const Mat4d & world,
+	double* xOut, double* yOut, double* zOut,
+	const int num)
+{
+	// transforms num float points by the double matrix; processes 2 points per iteration
+	// (2 doubles per register); the tail (num % 2 points) is processed by the scalar kernel
+
+	assert(xIn && yIn && zIn);
+	assert(xOut && yOut && zOut);
+	assert(num >= 0);
+
+	const __m128d zero = _mm_setzero_pd();
+
+	// broadcast each used matrix element into its own register
+	__m128d m[4][3];
+
+	for (int row = 0; row < 4; row++)
+		for (int col = 0; col < 3; col++)
+			m[row][col] = _mm_set1_pd(world.M[row][col]);
+
+	int i = 0;
+
+	for (; i + 2 <= num; i += 2)
+	{
+		// load 2 floats (64 bits) of each stream and convert them into doubles
+		const __m128d x = _mm_cvtps_pd(_mm_castsi128_ps(_mm_loadl_epi64((const __m128i*)(xIn + i))));
+		const __m128d y = _mm_cvtps_pd(_mm_castsi128_ps(_mm_loadl_epi64((const __m128i*)(yIn + i))));
+		const __m128d z = _mm_cvtps_pd(_mm_castsi128_ps(_mm_loadl_epi64((const __m128i*)(zIn + i))));
+
+		__m128d res[3];
+
+		for (int col = 0; col < 3; col++)
+		{
+			__m128d sum = _mm_add_pd(zero, _mm_mul_pd(x, m[0][col]));
+			sum = _mm_add_pd(sum, _mm_mul_pd(y, m[1][col]));
+			sum = _mm_add_pd(sum, _mm_mul_pd(z, m[2][col]));
+			res[col] = _mm_add_pd(sum, m[3][col]);
+		}
+
+		_mm_storeu_pd(xOut + i, res[0]);
+		_mm_storeu_pd(yOut + i, res[1]);
+		_mm_storeu_pd(zOut + i, res[2]);
+	}
+
+	// process the rest of points
+	Mat_Mul_VECTOR3D_4X4D_Batch_Scalar(xIn + i, yIn + i, zIn + i, world,
+		xOut + i, yOut + i, zOut + i, num - i);
+
+} // end Mat_Mul_VECTOR3D_4X4D_Batch_SSE
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_AVX2
+void Mat_Mul_VECTOR3D_4X4D_Batch_AVX2(const float* xIn, const float* yIn, const float* zIn,
+	const Mat4d & world,
+	double* xOut, double* yOut, double* zOut,
+	const int num)
+{
+	// transforms num float points by the double matrix; processes 4 points per iteration
+	// (4 doubles per register); the tail (num % 4 points) is processed by the SSE kernel
+	//
+	// NOTE: FMA isn't used here on purpose (see the note in Simd.h)
+
+	assert(xIn && yIn && zIn);
+	assert(xOut && yOut && zOut);
+	assert(num >= 0);
+
+	const __m256d zero = _mm256_setzero_pd();
+
+	// broadcast each used matrix element into its own register
+	__m256d m[4][3];
+
+	for (int row = 0; row < 4; row++)
+		for (int col = 0; col < 3; col++)
+			m[row][col] = _mm256_set1_pd(world.M[row][col]);
+
+	int i = 0;
+
+	for (; i + 4 <= num; i += 4)
+	{
+		const __m256d x = _mm256_cvtps_pd(_mm_loadu_ps(xIn + i));
+		const __m256d y = _mm256_cvtps_pd(_mm_loadu_ps(yIn + i));
+		const __m256d z = _mm256_cvtps_pd(_mm_loadu_ps(zIn + i));
+
+		__m256d res[3];
+
+		for (int col = 0; col < 3; col++)
+		{
+			__m256d sum = _mm256_add_pd(zero, _mm256_mul_pd(x, m[0][col]));
+			sum = _mm256_add_pd(sum, _mm256_mul_pd(y, m[1][col]));
+			sum = _mm256_add_pd(sum, _mm256_mul_pd(z, m[2][col]));
+			res[col] = _mm256_add_pd(sum, m[3][col]);
+		}
+
+		_mm256_storeu_pd(xOut + i, res[0]);
+		_mm256_storeu_pd(yOut + i, res[1]);
+		_mm256_storeu_pd(zOut + i, res[2]);
+	}
+
+	// process the rest of points
+	Mat_Mul_VECTOR3D_4X4D_Batch_SSE(xIn + i, yIn + i, zIn + i, world,
+		xOut + i, yOut + i, zOut + i, num - i);
+
+} // end Mat_Mul_VECTOR3D_4X4D_Batch_AVX2
+
+#else
+
+// there is no SIMD support for this platform so use the reference kernel
+
+void Mat_Mul_VECTOR3D_4X4D_Batch_SSE(const float* xIn, const float* yIn, const float* zIn,
+	const Mat4d & world,
+	double* xOut, double* yOut, double* zOut,
+	const int num)
+{
+	Mat_Mul_VECTOR3D_4X4D_Batch_Scalar(xIn, yIn, zIn, world, xOut, yOut, zOut, num);
+}
+
+void Mat_Mul_VECTOR3D_4X4D_Batch_AVX2(const float* xIn, const float* yIn, const float* zIn,
+	const Mat4d & world,
+	double* xOut, double* yOut, double* zOut,
+	const int num)
+{
+	Mat_Mul_VECTOR3D_4X4D_Batch_Scalar(xIn, yIn, zIn, world, xOut, yOut, zOut, num);
+}
+
+#endif // MATHLIB_SIMD_X86
+
+///////////////////////////////////////////////////////////
+
+void Mat_Mul_VECTOR3D_4X4D_Batch(const float* xIn, const float* yIn, const float* zIn,
+	const Mat4d & world,
+	double* xOut, double* yOut, double* zOut,
+	const int num)
+{
+	// transforms num float points by the double matrix using the best kernel for the current CPU
+
+	switch (SIMD_Get_Level())
+	{
+		case SIMD_LEVEL_AVX2:
+			Mat_Mul_VECTOR3D_4X4D_Batch_AVX2(xIn, yIn, zIn, world, xOut, yOut, zOut, num);
+			break;
+
+		case SIMD_LEVEL_AVX:
+		case SIMD_LEVEL_SSE:
+			Mat_Mul_VECTOR3D_4X4D_Batch_SSE(xIn, yIn, zIn, world, xOut, yOut, zOut, num);
+			break;
+
+		default:
+			Mat_Mul_VECTOR3D_4X4D_Batch_Scalar(xIn, yIn, zIn, world, xOut, yOut, zOut, num);
+	}
+
+} // end Mat_Mul_VECTOR3D_4X4D_Batch
+
+///////////////////////////////////////////////////////////
+
+void Mat_Mul_VECTOR3D_4X4D_Rebased_Batch(const float* xIn, const float* yIn, const float* zIn,
+	const Mat4d & world,
+	const Vec3d & origin,
+	float* xOut, float* yOut, float* zOut,
+	const int num)
+{
+	// transforms num float local points by the double world matrix into float points
+	// relative to the origin: only the matrix is computed in double (once), the points
+	// go through the float SIMD kernels
+
+	MATRIX4X4 local;
+
+	Mat_Rebase_4X4(world, origin, &local);
+	Mat_Mul_VECTOR3D_4X4_Batch(xIn, yIn, zIn, &local, xOut, yOut, zOut, num);
+
+} // end Mat_Mul_VECTOR3D_4X4D_Rebased_Batch
+
+} // end namespace MathLib
@@ -0,0 +1,345 @@
+////////////////////////////////////////////////////////////////////////////////////////////
+// Filename:      MixedPrecision.h
+// Description:   contains double precision primitives and mixed precision functional
+//                for large worlds: quaternions and planes of any precision (together
+//                with Vec/Mat of VecMat.h), conversions between the precisions, and
+//                transformations of float local geometry by double world matrices
+//                (into double world coordinates or into float coordinates relative
+//                to a camera, so the float SIMD paths keep working far from the origin)
+//
+// Created:       17.10.26
+////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "VecMat.h"
+#include "../Quaternion/Quaternion.h"
+#include "../Figures/Figures.h"
+
+
+namespace MathLib
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                 DATA STRUCTURES
+////////////////////////////////////////////////////////////////////////////////////////////
+
+// quaternion q = w + x*i + y*j + z*k (the float type has the same layout as QUAT)
+template<typename T>
+struct Quat
+{
+	T w;   // real part
+	T x;   // imaginary part
+	T y;
+	T z;
+};
+
+
+// 3D plane: a point on the plane and a normal vector (not necessary a unit vector)
+template<typename T>
+struct Plane
+{
+	Vec<3, T> p0;
+	Vec<3, T> n;
+};
+
+
+typedef Quat<float>  Quatf;   typedef Quat<double>  Quatd;
+typedef Plane<float> Planef;  typedef Plane<double> Planed;
+
+static_assert(sizeof(Quatf) == sizeof(QUAT), "Quatf must have the layout of QUAT");
+static_assert(sizeof(Planef) == sizeof(PLANE3D), "Planef must have the layout of PLANE3D");
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                           CONVERSIONS OF THE PRECISION
+////////////////////////////////////////////////////////////////////////////////////////////
+
+template<typename U, int N, typename T>
+constexpr Vec<N, U> Vec_Cast(const Vec<N, T> & v)
+{
+	Vec<N, U> res = {};
+
+	for (int i = 0; i < N; i++)
+		res.M[i] = static_cast<U>(v.M[i]);
+
+	return res;
+}
+
+template<typename U, int R, int C, typename T>
+constexpr Mat<R, C, U> Mat_Cast(const Mat<R, C, T> & m)
+{
+	Mat<R, C, U> res = {};
+
+	for (int i = 0; i < R; i++)
+		for (int j = 0; j < C; j++)
+			res.M[i][j] = static_cast<U>(m.M[i][j]);
+
+	return res;
+}
+
+template<typename U, typename T>
+constexpr Quat<U> Quat_Cast(const Quat<T> & q)
+{
+	return Quat<U>{ static_cast<U>(q.w), static_cast<U>(q.x), static_cast<U>(q.y), static_cast<U>(q.z) };
+}
+
+template<typename U, typename T>
+constexpr Plane<U> Plane_Cast(const Plane<T> & plane)
+{
+	return Plane<U>{ Vec_Cast<U>(plane.p0), Vec_Cast<U>(plane.n) };
+}
+
+///////////////////////////////////////////////////////////
+
+// from/to the legacy types
+inline Quatf To_Quat(const QUAT & q)      { return Quatf{ q.w, q.x, q.y, q.z }; }
+inline QUAT  To_QUAT(const Quatf & q)     { return QUAT(q.w, q.x, q.y, q.z); }
+
+inline Planef  To_Plane(const PLANE3D & plane) { return Planef{ To_Vec(plane.p0), To_Vec(plane.n) }; }
+inline PLANE3D To_PLANE3D(const Planef & plane) { return PLANE3D(To_VECTOR3D(plane.p0), To_VECTOR3D(plane.n)); }
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                            FUNCTIONS FOR QUATERNIONS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+//
+// the formulas are the same as in Quaternion.cpp and QuaternionMatrix.cpp,
+// so the float versions give exactly the same results as the legacy functions
+//
+
+template<typename T>
+constexpr Quat<T> Quat_Conjugate(const Quat<T> & q)
+{
+	return Quat<T>{ q.w, -q.x, -q.y, -q.z };
+}
+
+///////////////////////////////////////////////////////////
+
+template<typename T>
+constexpr Quat<T> Quat_Mul(const Quat<T> & q1, const Quat<T> & q2)
+{
+	// q1*q2 with the common factors (as QUAT_Mul)
+
+	const T prd_0 = (q1.z - q1.y) * (q2.y - q2.z);
+	const T prd_1 = (q1.w + q1.x) * (q2.w + q2.x);
+	const T prd_2 = (q1.w - q1.x) * (q2.y + q2.z);
+	const T prd_3 = (q1.y + q1.z) * (q2.w - q2.x);
+	const T prd_4 = (q1.z - q1.x) * (q2.x - q2.y);
+	const T prd_5 = (q1.z + q1.x) * (q2.x + q2.y);
+	const T prd_6 = (q1.w + q1.y) * (q2.w - q2.z);
+	const T prd_7 = (q1.w - q1.y) * (q2.w + q2.z);
+	const T prd_8 = prd_5 + prd_6 + prd_7;
+	const T prd_9 = T(0.5) * (prd_4 + prd_8);
+
+	return Quat<T>{ prd_0 + prd_9 - prd_5, prd_1 + prd_9 - prd_8, prd_2 + prd_9 - prd_7, prd_3 + prd_9 - prd_6 };
+}
+
+///////////////////////////////////////////////////////////
+
+template<typename T>
+inline Quat<T> Quat_Normalize(const Quat<T> & q)
+{
+	const T lenInv = T(1) / std::sqrt((q.w*q.w) + (q.x*q.x) + (q.y*q.y) + (q.z*q.z));
+
+	return Quat<T>{ q.w * lenInv, q.x * lenInv, q.y * lenInv, q.z * lenInv };
+}
+
+///////////////////////////////////////////////////////////
+
+template<typename T>
+constexpr Vec<3, T> Quat_Rotate(const Quat<T> & q, const Vec<3, T> & v)
+{
+	// rotates v by the unit quaternion: q * v * q^-1 (the cross-product form
+	// of QUAT_Rotate_VECTOR3D)
+
+	const T qx2 = T(2) * q.x;
+	const T qy2 = T(2) * q.y;
+	const T qz2 = T(2) * q.z;
+
+	const T tx = (qy2 * v.M[2]) - (qz2 * v.M[1]);
+	const T ty = (qz2 * v.M[0]) - (qx2 * v.M[2]);
+	const T tz = (qx2 * v.M[1]) - (qy2 * v.M[0]);
+
+	return Vec<3, T>{ {
+		v.M[0] + (q.w * tx) + ((q.y * tz) - (q.z * ty)),
+		v.M[1] + (q.w * ty) + ((q.z * tx) - (q.x * tz)),
+		v.M[2] + (q.w * tz) + ((q.x * ty) - (q.y * tx)) } };
+}
+
+///////////////////////////////////////////////////////////
+
+template<typename T>
+constexpr Mat<3, 3, T> Quat_To_Mat3(const Quat<T> & q)
+{
+	// the rotation matrix of the unit quaternion for row vectors (as QUAT_To_MATRIX3X3)
+
+	const T x2 = q.x + q.x;
+	const T y2 = q.y + q.y;
+	const T z2 = q.z + q.z;
+
+	const T xx = q.x * x2;
+	const T yy = q.y * y2;
+	const T zz = q.z * z2;
+	const T xy = q.x * y2;
+	const T xz = q.x * z2;
+	const T yz = q.y * z2;
+	const T wx = q.w * x2;
+	const T wy = q.w * y2;
+	const T wz = q.w * z2;
+
+	return Mat<3, 3, T>{ {
+		{ T(1) - (yy + zz), xy + wz,           xz - wy },
+		{ xy - wz,          T(1) - (xx + zz),  yz + wx },
+		{ xz + wy,          yz - wx,           T(1) - (xx + yy) } } };
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                        FUNCTIONS FOR PLANES AND MATRICES
+////////////////////////////////////////////////////////////////////////////////////////////
+
+// the signed distance of a point to the plane (multiplied by the length of the normal);
+// the same formula as in Compute_Point_In_Plane3D
+template<typename T>
+constexpr T Plane_Point_Location(const Plane<T> & plane, const Vec<3, T> & pt)
+{
+	return (plane.n.M[0] * (pt.M[0] - plane.p0.M[0])) +
+	       (plane.n.M[1] * (pt.M[1] - plane.p0.M[1])) +
+	       (plane.n.M[2] * (pt.M[2] - plane.p0.M[2]));
+}
+
+///////////////////////////////////////////////////////////
+
+// a world matrix (row vectors: the rows 0..2 are the rotation and scale, the row 3
+// is the translation) from the rotation, the uniform scale and the position
+template<typename T>
+constexpr Mat<4, 4, T> Mat_World(const Quat<T> & rotation, const T scale, const Vec<3, T> & position)
+{
+	const Mat<3, 3, T> r = Quat_To_Mat3(rotation);
+
+	Mat<4, 4, T> m = {};
+
+	for (int row = 0; row < 3; row++)
+		for (int col = 0; col < 3; col++)
+			m.M[row][col] = r.M[row][col] * scale;
+
+	m.M[3][0] = position.M[0];
+	m.M[3][1] = position.M[1];
+	m.M[3][2] = position.M[2];
+	m.M[3][3] = T(1);
+
+	return m;
+}
+
+///////////////////////////////////////////////////////////
+
+// the inverse of an affine matrix (the last column is (0, 0, 0, 1)): returns 1 and the
+// inverse, or 0 and the zero matrix if the 3x3 part is singular (see Mat_Inverse)
+template<typename T>
+constexpr int Mat_Inverse_Affine(const Mat<4, 4, T> & m, Mat<4, 4, T> & mi)
+{
+	Mat<3, 3, T> r = {};
+	Mat<3, 3, T> ri = {};
+
+	for (int row = 0; row < 3; row++)
+		for (int col = 0; col < 3; col++)
+			r.M[row][col] = m.M[row][col];
+
+	mi = Mat<4, 4, T>{};
+
+	if (!Mat_Inverse(r, ri))
+		return 0;
+
+	// [R 0; t 1]^-1 == [R^-1 0; -t*R^-1 1]
+	const Vec<3, T> t = { { m.M[3][0], m.M[3][1], m.M[3][2] } };
+	const Vec<3, T> ti = Mat_Mul_Vec(t, ri);
+
+	for (int row = 0; row < 3; row++)
+		for (int col = 0; col < 3; col++)
+			mi.M[row][col] = ri.M[row][col];
+
+	mi.M[3][0] = -ti.M[0];
+	mi.M[3][1] = -ti.M[1];
+	mi.M[3][2] = -ti.M[2];
+	mi.M[3][3] = T(1);
+
+	return 1;
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                           MIXED PRECISION FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+//
+// a float has only 24 bits of mantissa: at 10 km from the origin its step is ~1 mm,
+// at 10000 km it is ~1 m; so the world positions and matrices are stored in double,
+// the local geometry (meshes) in float, and the float data which goes to the float
+// SIMD kernels is computed relative to a camera (the origin): the coordinates near
+// the camera are small, so they have the full float precision
+//
+
+// converts the double world matrix into the float matrix which transforms local
+// points into coordinates relative to the origin (the translation is reduced by
+// the origin in double before the conversion)
+void Mat_Rebase_4X4(const Mat4d & world, const Vec3d & origin, MATRIX4X4* pLocal);
+
+// converts num double world points into float points relative to the origin
+// (SoA streams)
+void POINT3D_Rebase_Batch(const double* xIn, const double* yIn, const double* zIn,
+	const Vec3d & origin,
+	float* xOut, float* yOut, float* zOut,
+	const int num);
+
+///////////////////////////////////////////////////////////
+
+//
+// transforms num float local points by the double world matrix into double world
+// points: each component is computed in double in the order of Mat_Mul_VECTOR3D_4X4,
+//   out = (((0 + x*M[0][c]) + y*M[1][c]) + z*M[2][c]) + M[3][c]
+// so the results are the same for each kernel
+//
+
+// chooses the best kernel for the current CPU (see SIMD_Get_Level)
+void Mat_Mul_VECTOR3D_4X4D_Batch(const float* xIn, const float* yIn, const float* zIn,
+	const Mat4d & world,
+	double* xOut, double* yOut, double* zOut,
+	const int num);
+
+// separate kernels (SSE/AVX2 kernels must be called only if the CPU supports them)
+void Mat_Mul_VECTOR3D_4X4D_Batch_Scalar(const float* xIn, const float* yIn, const float* zIn,
+	const Mat4d & world,
+	double* xOut, double* yOut, double* zOut,
+	const int num);
+
+void Mat_Mul_VECTOR3D_4X4D_Batch_SSE(const float* xIn, const float* yIn, const float* zIn,
+	const Mat4d & world,
+	double* xOut, double* yOut, double* zOut,
+	const int num);
+
+void Mat_Mul_VECTOR3D_4X4D_Batch_AVX2(const float* xIn, const float* yIn, const float* zIn,
+	const Mat4d & world,
+	double* xOut, double* yOut, double* zOut,
+	const int num);
+
+///////////////////////////////////////////////////////////
+
+// transforms num float local points by the double world matrix into float points
+// relative to the origin: the matrix is rebased (see Mat_Rebase_4X4) and the points
+// are transformed by Mat_Mul_VECTOR3D_4X4_Batch (the float SIMD kernels)
+void Mat_Mul_VECTOR3D_4X4D_Rebased_Batch(const float* xIn, const float* yIn, const float* zIn,
+	const Mat4d & world,
+	const Vec3d & origin,
+	float* xOut, float* yOut, float* zOut,
+	const int num);
+
+} // end namespace MathLib
@@ -0,0 +1,453 @@
+////////////////////////////////////////////////////////////////////////////////////////////
+// Filename:      VecExpr.h
+// Description:   contains header-only expression templates for vectors and matrices:
+//                the operators +, -, * don't compute anything but build an expression,
+//                which is evaluated only when it is assigned, in one pass per element
+//                and without temporaries, e.g.
+//
+//                  VECTOR3D r = a + b*k - c;
+//                  Expr_Array(r, num) = Expr_Array(a, num) + Expr_Array(b, num)*k - center;
+//
+//                the operands are Vec/Mat (see VecMat.h), VECTOR2D/VECTOR3D and arrays
+//                of them (see Expr_Array); a single value in an array expression is used
+//                for each element
+//
+// Created:       17.10.26
+////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <cassert>
+#include <type_traits>
+#include <utility>
+
+#include "VecMat.h"
+
+
+namespace MathLib
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                             TYPES OF THE OPERANDS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+//
+// VEXPR_STORAGE describes a type which is stored in the memory: VALUE is the type
+// which is computed by the expressions (Vec or Mat), Load/Store convert between them;
+// only the types with VEXPR_STORAGE can be the operands
+//
+// VECTOR4D isn't here: the legacy functions for it have the special meaning of w
+//
+
+template<typename STORAGE> struct VEXPR_STORAGE;
+
+template<int N, typename T> struct VEXPR_STORAGE<Vec<N, T>>
+{
+	typedef Vec<N, T> VALUE;
+	static constexpr const VALUE & Load(const VALUE & v) { return v; }
+	static void Store(const VALUE & v, VALUE & dst)      { dst = v; }
+};
+
+template<int R, int C, typename T> struct VEXPR_STORAGE<Mat<R, C, T>>
+{
+	typedef Mat<R, C, T> VALUE;
+	static constexpr const VALUE & Load(const VALUE & m) { return m; }
+	static void Store(const VALUE & m, VALUE & dst)      { dst = m; }
+};
+
+template<> struct VEXPR_STORAGE<VECTOR2D>
+{
+	typedef Vec2f VALUE;
+	static VALUE Load(const VECTOR2D & v) { return To_Vec(v); }
+	static void Store(const VALUE & v, VECTOR2D & dst) { dst.x = v.M[0]; dst.y = v.M[1]; }
+};
+
+template<> struct VEXPR_STORAGE<VECTOR3D>
+{
+	typedef Vec3f VALUE;
+	static VALUE Load(const VECTOR3D & v) { return To_Vec(v); }
+	static void Store(const VALUE & v, VECTOR3D & dst) { dst.x = v.M[0]; dst.y = v.M[1]; dst.z = v.M[2]; }
+};
+
+///////////////////////////////////////////////////////////
+
+// the type of the elements of a value
+template<typename VALUE> struct VEXPR_SCALAR;
+
+template<int N, typename T>        struct VEXPR_SCALAR<Vec<N, T>>    { typedef T TYPE; };
+template<int R, int C, typename T> struct VEXPR_SCALAR<Mat<R, C, T>> { typedef T TYPE; };
+
+// the legacy type into which an expression of the value can be assigned
+template<typename VALUE> struct VEXPR_LEGACY
+{
+	struct NONE {};
+	typedef NONE TYPE;
+};
+
+template<> struct VEXPR_LEGACY<Vec2f> { typedef VECTOR2D TYPE; };
+template<> struct VEXPR_LEGACY<Vec3f> { typedef VECTOR3D TYPE; };
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                          OPERATIONS OVER THE VALUES
+////////////////////////////////////////////////////////////////////////////////////////////
+
+//
+// each operation is the function of VecMat.h, so an expression gives exactly the same
+// result as the chain of the functions (and of the legacy functions for VECTOR2D/3D)
+//
+
+template<int N, typename T>
+constexpr Vec<N, T> VExpr_Add(const Vec<N, T> & a, const Vec<N, T> & b)  { return Vec_Add(a, b); }
+
+template<int R, int C, typename T>
+constexpr Mat<R, C, T> VExpr_Add(const Mat<R, C, T> & a, const Mat<R, C, T> & b)  { return Mat_Add(a, b); }
+
+template<int N, typename T>
+constexpr Vec<N, T> VExpr_Sub(const Vec<N, T> & a, const Vec<N, T> & b)  { return Vec_Sub(a, b); }
+
+template<int R, int C, typename T>
+constexpr Mat<R, C, T> VExpr_Sub(const Mat<R, C, T> & a, const Mat<R, C, T> & b)  { return Mat_Sub(a, b); }
+
+template<int N, typename T>
+constexpr Vec<N, T> VExpr_Scale(const T k, const Vec<N, T> & a)  { return Vec_Scale(k, a); }
+
+template<int R, int C, typename T>
+constexpr Mat<R, C, T> VExpr_Scale(const T k, const Mat<R, C, T> & a)  { return Mat_Scale(k, a); }
+
+// the row vector by the matrix (v * M) and the matrix by the matrix
+template<int R, int C, typename T>
+constexpr Vec<C, T> VExpr_Mul(const Vec<R, T> & v, const Mat<R, C, T> & m)  { return Mat_Mul_Vec(v, m); }
+
+template<int R, int K, int C, typename T>
+constexpr Mat<R, C, T> VExpr_Mul(const Mat<R, K, T> & a, const Mat<K, C, T> & b)  { return Mat_Mul(a, b); }
+
+///////////////////////////////////////////////////////////
+
+// the number of elements of an expression of two operands
+// (-1 is a single value which is used for each element)
+inline int VExpr_Size(const int sizeA, const int sizeB)
+{
+	assert((sizeA < 0) || (sizeB < 0) || (sizeA == sizeB));
+
+	return (sizeA < 0) ? sizeB : sizeA;
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                            NODES OF THE EXPRESSIONS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+//
+// each node has VALUE, Size() (the number of elements or -1 for a single value)
+// and Eval(i) (the value of the i-th element); the nodes keep their operands by value
+// (they are small), so an expression must be evaluated in the same statement:
+// don't store it into an auto variable which outlives its operands
+//
+
+struct VEXPR_TAG {};
+
+template<typename NODE, typename VALUE>
+struct VEXPR_BASE : public VEXPR_TAG
+{
+	// evaluation of a single value expression
+	operator VALUE() const
+	{
+		const NODE & node = static_cast<const NODE &>(*this);
+		assert(node.Size() <= 1);
+
+		return node.Eval(0);
+	}
+
+	operator typename VEXPR_LEGACY<VALUE>::TYPE() const
+	{
+		typedef typename VEXPR_LEGACY<VALUE>::TYPE LEGACY;
+
+		const NODE & node = static_cast<const NODE &>(*this);
+		assert(node.Size() <= 1);
+
+		LEGACY dst;
+		VEXPR_STORAGE<LEGACY>::Store(node.Eval(0), dst);
+
+		return dst;
+	}
+};
+
+///////////////////////////////////////////////////////////
+
+// a single value
+template<typename VALUE_TYPE>
+struct VEXPR_VALUE : public VEXPR_BASE<VEXPR_VALUE<VALUE_TYPE>, VALUE_TYPE>
+{
+	typedef VALUE_TYPE VALUE;
+
+	explicit VEXPR_VALUE(const VALUE & v) : value(v) {}
+
+	int Size() const                   { return -1; }
+	const VALUE & Eval(const int) const { return value; }
+
+	VALUE value;
+};
+
+///////////////////////////////////////////////////////////
+
+// an array of num values (read only)
+template<typename STORAGE>
+struct VEXPR_ARRAY : public VEXPR_BASE<VEXPR_ARRAY<STORAGE>, typename VEXPR_STORAGE<STORAGE>::VALUE>
+{
+	typedef typename VEXPR_STORAGE<STORAGE>::VALUE VALUE;
+
+	VEXPR_ARRAY(const STORAGE* d, const int n) : data(d), num(n)
+	{
+		assert((d != nullptr) || (n == 0));
+		assert(n >= 0);
+	}
+
+	int Size() const             { return num; }
+	VALUE Eval(const int i) const { return VEXPR_STORAGE<STORAGE>::Load(data[i]); }
+
+	const STORAGE* data;
+	int num;
+};
+
+///////////////////////////////////////////////////////////
+
+template<typename L, typename R>
+struct VEXPR_ADD : public VEXPR_BASE<VEXPR_ADD<L, R>, typename L::VALUE>
+{
+	typedef typename L::VALUE VALUE;
+	static_assert(std::is_same<VALUE, typename R::VALUE>::value, "VEXPR_ADD: the operands must have the same type");
+
+	VEXPR_ADD(const L & l, const R & r) : left(l), right(r) {}
+
+	int Size() const             { return VExpr_Size(left.Size(), right.Size()); }
+	VALUE Eval(const int i) const { return VExpr_Add(left.Eval(i), right.Eval(i)); }
+
+	L left;
+	R right;
+};
+
+///////////////////////////////////////////////////////////
+
+template<typename L, typename R>
+struct VEXPR_SUB : public VEXPR_BASE<VEXPR_SUB<L, R>, typename L::VALUE>
+{
+	typedef typename L::VALUE VALUE;
+	static_assert(std::is_same<VALUE, typename R::VALUE>::value, "VEXPR_SUB: the operands must have the same type");
+
+	VEXPR_SUB(const L & l, const R & r) : left(l), right(r) {}
+
+	int Size() const             { return VExpr_Size(left.Size(), right.Size()); }
+	VALUE Eval(const int i) const { return VExpr_Sub(left.Eval(i), right.Eval(i)); }
+
+	L left;
+	R right;
+};
+
+///////////////////////////////////////////////////////////
+
+// multiplication by a scalar (the negation is the multiplication by -1)
+template<typename E>
+struct VEXPR_SCALE : public VEXPR_BASE<VEXPR_SCALE<E>, typename E::VALUE>
+{
+	typedef typename E::VALUE VALUE;
+	typedef typename VEXPR_SCALAR<VALUE>::TYPE SCALAR;
+
+	VEXPR_SCALE(const SCALAR scale, const E & e) : k(scale), expr(e) {}
+
+	int Size() const             { return expr.Size(); }
+	VALUE Eval(const int i) const { return VExpr_Scale(k, expr.Eval(i)); }
+
+	SCALAR k;
+	E expr;
+};
+
+///////////////////////////////////////////////////////////
+
+// multiplication by a matrix: Vec * Mat or Mat * Mat
+template<typename L, typename R>
+struct VEXPR_MUL : public VEXPR_BASE<VEXPR_MUL<L, R>,
+	decltype(VExpr_Mul(std::declval<typename L::VALUE>(), std::declval<typename R::VALUE>()))>
+{
+	typedef decltype(VExpr_Mul(std::declval<typename L::VALUE>(), std::declval<typename R::VALUE>())) VALUE;
+
+	VEXPR_MUL(const L & l, const R & r) : left(l), right(r) {}
+
+	int Size() const             { return VExpr_Size(left.Size(), right.Size()); }
+	VALUE Eval(const int i) const { return VExpr_Mul(left.Eval(i), right.Eval(i)); }
+
+	L left;
+	R right;
+};
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                           OPERANDS OF THE EXPRESSIONS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+// VEXPR_OPERAND<X>::NODE is the node of an operand of the type X (X is a node itself
+// or a stored type); other types have no NODE, so the operators ignore them
+template<typename X, typename = void>
+struct VEXPR_OPERAND {};
+
+template<typename X>
+struct VEXPR_OPERAND<X, typename std::enable_if<std::is_base_of<VEXPR_TAG, X>::value>::type>
+{
+	typedef X NODE;
+	static const NODE & Make(const X & x) { return x; }
+};
+
+template<typename X>
+struct VEXPR_OPERAND<X, std::void_t<typename VEXPR_STORAGE<X>::VALUE>>
+{
+	typedef VEXPR_VALUE<typename VEXPR_STORAGE<X>::VALUE> NODE;
+	static NODE Make(const X & x) { return NODE(VEXPR_STORAGE<X>::Load(x)); }
+};
+
+///////////////////////////////////////////////////////////
+
+// an array of num values which can be assigned by an expression: the expression is
+// evaluated for each element (in one pass) and stored; the i-th element of the result
+// depends only on the i-th elements of the operands, so the array can be an operand
+// of its own expression: Expr_Array(a, num) = Expr_Array(a, num) * k + b
+template<typename STORAGE>
+struct VEXPR_ARRAY_REF : public VEXPR_ARRAY<STORAGE>
+{
+	typedef typename VEXPR_STORAGE<STORAGE>::VALUE VALUE;
+
+	VEXPR_ARRAY_REF(STORAGE* d, const int n) : VEXPR_ARRAY<STORAGE>(d, n), out(d) {}
+	VEXPR_ARRAY_REF(const VEXPR_ARRAY_REF &) = default;
+
+	template<typename E>
+	VEXPR_ARRAY_REF & operator=(const E & expr)
+	{
+		typedef typename VEXPR_OPERAND<E>::NODE NODE;
+		static_assert(std::is_same<typename NODE::VALUE, VALUE>::value, "VEXPR_ARRAY_REF: the expression must have the type of the array");
+
+		const NODE & node = VEXPR_OPERAND<E>::Make(expr);
+		assert((node.Size() < 0) || (node.Size() == this->num));
+
+		for (int i = 0; i < this->num; i++)
+			VEXPR_STORAGE<STORAGE>::Store(node.Eval(i), out[i]);
+
+		return *this;
+	}
+
+	// it copies the elements (not the reference)
+	VEXPR_ARRAY_REF & operator=(const VEXPR_ARRAY_REF & src)
+	{
+		return operator=<VEXPR_ARRAY<STORAGE>>(src);
+	}
+
+	template<typename E>
+	VEXPR_ARRAY_REF & operator+=(const E & expr) { return operator=(*this + expr); }
+
+	template<typename E>
+	VEXPR_ARRAY_REF & operator-=(const E & expr) { return operator=(*this - expr); }
+
+	STORAGE* out;
+};
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                   OPERATORS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+template<typename A, typename B>
+inline VEXPR_ADD<typename VEXPR_OPERAND<A>::NODE, typename VEXPR_OPERAND<B>::NODE>
+operator+(const A & a, const B & b)
+{
+	return { VEXPR_OPERAND<A>::Make(a), VEXPR_OPERAND<B>::Make(b) };
+}
+
+///////////////////////////////////////////////////////////
+
+template<typename A, typename B>
+inline VEXPR_SUB<typename VEXPR_OPERAND<A>::NODE, typename VEXPR_OPERAND<B>::NODE>
+operator-(const A & a, const B & b)
+{
+	return { VEXPR_OPERAND<A>::Make(a), VEXPR_OPERAND<B>::Make(b) };
+}
+
+///////////////////////////////////////////////////////////
+
+template<typename A>
+inline VEXPR_SCALE<typename VEXPR_OPERAND<A>::NODE>
+operator-(const A & a)
+{
+	typedef typename VEXPR_OPERAND<A>::NODE NODE;
+	typedef typename VEXPR_SCALAR<typename NODE::VALUE>::TYPE SCALAR;
+
+	return { SCALAR(-1), VEXPR_OPERAND<A>::Make(a) };
+}
+
+///////////////////////////////////////////////////////////
+
+// multiplication by a scalar (on both sides)
+template<typename A>
+inline VEXPR_SCALE<typename VEXPR_OPERAND<A>::NODE>
+operator*(const A & a, const typename VEXPR_SCALAR<typename VEXPR_OPERAND<A>::NODE::VALUE>::TYPE k)
+{
+	return { k, VEXPR_OPERAND<A>::Make(a) };
+}
+
+template<typename A>
+inline VEXPR_SCALE<typename VEXPR_OPERAND<A>::NODE>
+operator*(const typename VEXPR_SCALAR<typename VEXPR_OPERAND<A>::NODE::VALUE>::TYPE k, const A & a)
+{
+	return { k, VEXPR_OPERAND<A>::Make(a) };
+}
+
+///////////////////////////////////////////////////////////
+
+// multiplication by a matrix: v * M (a row vector) or A * B
+template<typename A, typename B,
+	typename = decltype(VExpr_Mul(std::declval<typename VEXPR_OPERAND<A>::NODE::VALUE>(),
+	                              std::declval<typename VEXPR_OPERAND<B>::NODE::VALUE>()))>
+inline VEXPR_MUL<typename VEXPR_OPERAND<A>::NODE, typename VEXPR_OPERAND<B>::NODE>
+operator*(const A & a, const B & b)
+{
+	return { VEXPR_OPERAND<A>::Make(a), VEXPR_OPERAND<B>::Make(b) };
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                   FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+// an array of num elements as an operand (read only for const data)
+template<typename STORAGE>
+inline VEXPR_ARRAY<STORAGE> Expr_Array(const STORAGE* data, const int num)
+{
+	return VEXPR_ARRAY<STORAGE>(data, num);
+}
+
+// an array of num elements as an operand or the destination of an expression
+template<typename STORAGE>
+inline VEXPR_ARRAY_REF<STORAGE> Expr_Array(STORAGE* data, const int num)
+{
+	return VEXPR_ARRAY_REF<STORAGE>(data, num);
+}
+
+///////////////////////////////////////////////////////////
+
+// the value of a single value expression (for auto variables)
+template<typename E>
+inline typename VEXPR_OPERAND<E>::NODE::VALUE Expr_Eval(const E & expr)
+{
+	const typename VEXPR_OPERAND<E>::NODE & node = VEXPR_OPERAND<E>::Make(expr);
+	assert(node.Size() <= 1);
+
+	return node.Eval(0);
+}
+
+} // end namespace MathLib
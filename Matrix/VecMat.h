@@ -0,0 +1,454 @@
+////////////////////////////////////////////////////////////////////////////////////////////
+// Filename:      VecMat.h
+// Description:   contains a header-only generic core for vectors and matrices:
+//                Vec<N, T> and Mat<R, C, T> (T is float, double or int) with constexpr
+//                inline functions, so the compiler can fold and vectorize them across
+//                the calls; the float types have the same layout as VECTOR2D/3D/4D and
+//                MATRIXmXn, and the functions compute the same results as the functions
+//                of PointVector*.h and Matrix.h
+//
+// Created:       17.10.26
+////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <cmath>
+#include <type_traits>
+
+#include "../MathConstant.h"
+#include "Matrix.h"
+
+
+namespace MathLib
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                 DATA STRUCTURES
+////////////////////////////////////////////////////////////////////////////////////////////
+
+// N-dimensional vector (or point); as the legacy types it is the row vector
+// for the multiplication by a matrix: v * M
+template<int N, typename T>
+struct Vec
+{
+	static_assert((N >= 1) && (N <= 4), "Vec: N must be in [1, 4]");
+
+	T M[N];   // array for storing
+
+	constexpr T & operator[](const int i)             { return M[i]; }
+	constexpr const T & operator[](const int i) const { return M[i]; }
+};
+
+
+// R x C matrix in the row major form (as MATRIXmXn)
+template<int R, int C, typename T>
+struct Mat
+{
+	static_assert((R >= 1) && (R <= 4) && (C >= 1) && (C <= 4), "Mat: R and C must be in [1, 4]");
+
+	T M[R][C];   // array for storing data
+};
+
+
+// the properties of the element types
+// (REAL is the type of lengths; Epsilon is the threshold of zero lengths and determinants)
+template<typename T> struct VECMAT_TRAITS;
+
+template<> struct VECMAT_TRAITS<float>
+{
+	typedef float REAL;
+	static constexpr float Epsilon() { return EPSILON_E5; }   // as in the legacy functions
+};
+
+template<> struct VECMAT_TRAITS<double>
+{
+	typedef double REAL;
+	static constexpr double Epsilon() { return 1E-12; }
+};
+
+template<> struct VECMAT_TRAITS<int>
+{
+	typedef float REAL;
+	static constexpr float Epsilon() { return EPSILON_E5; }
+};
+
+
+// the short names
+typedef Vec<2, float>  Vec2f;    typedef Vec<2, double>  Vec2d;    typedef Vec<2, int> Vec2i;
+typedef Vec<3, float>  Vec3f;    typedef Vec<3, double>  Vec3d;    typedef Vec<3, int> Vec3i;
+typedef Vec<4, float>  Vec4f;    typedef Vec<4, double>  Vec4d;    typedef Vec<4, int> Vec4i;
+
+typedef Mat<2, 2, float> Mat2f;  typedef Mat<2, 2, double> Mat2d;  typedef Mat<2, 2, int> Mat2i;
+typedef Mat<3, 3, float> Mat3f;  typedef Mat<3, 3, double> Mat3d;  typedef Mat<3, 3, int> Mat3i;
+typedef Mat<4, 4, float> Mat4f;  typedef Mat<4, 4, double> Mat4d;  typedef Mat<4, 4, int> Mat4i;
+typedef Mat<4, 3, float> Mat43f; typedef Mat<4, 3, double> Mat43d;
+
+
+// the float types can be used instead of the legacy types (see To_Vec/To_Mat)
+static_assert(sizeof(Vec2f) == sizeof(VECTOR2D),  "Vec2f must have the layout of VECTOR2D");
+static_assert(sizeof(Vec3f) == sizeof(VECTOR3D),  "Vec3f must have the layout of VECTOR3D");
+static_assert(sizeof(Vec4f) == sizeof(VECTOR4D),  "Vec4f must have the layout of VECTOR4D");
+static_assert(sizeof(Mat2f) == sizeof(MATRIX2X2), "Mat2f must have the layout of MATRIX2X2");
+static_assert(sizeof(Mat3f) == sizeof(MATRIX3X3), "Mat3f must have the layout of MATRIX3X3");
+static_assert(sizeof(Mat4f) == sizeof(MATRIX4X4), "Mat4f must have the layout of MATRIX4X4");
+static_assert(sizeof(Mat43f) == sizeof(MATRIX4X3), "Mat43f must have the layout of MATRIX4X3");
+static_assert(sizeof(Mat<3, 2, float>) == sizeof(MATRIX3X2), "Mat<3, 2> must have the layout of MATRIX3X2");
+static_assert(std::is_trivially_copyable<Vec4d>::value && std::is_trivially_copyable<Mat4d>::value,
+	"Vec/Mat must be trivially copyable");
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                              FUNCTIONS FOR VECTORS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+template<int N, typename T>
+constexpr Vec<N, T> Vec_Zero()
+{
+	Vec<N, T> v = {};
+	return v;
+}
+
+///////////////////////////////////////////////////////////
+
+template<int N, typename T>
+constexpr Vec<N, T> Vec_Add(const Vec<N, T> & a, const Vec<N, T> & b)
+{
+	Vec<N, T> sum = {};
+
+	for (int i = 0; i < N; i++)
+		sum.M[i] = a.M[i] + b.M[i];
+
+	return sum;
+}
+
+///////////////////////////////////////////////////////////
+
+template<int N, typename T>
+constexpr Vec<N, T> Vec_Sub(const Vec<N, T> & a, const Vec<N, T> & b)
+{
+	Vec<N, T> diff = {};
+
+	for (int i = 0; i < N; i++)
+		diff.M[i] = a.M[i] - b.M[i];
+
+	return diff;
+}
+
+///////////////////////////////////////////////////////////
+
+template<int N, typename T>
+constexpr Vec<N, T> Vec_Scale(const T k, const Vec<N, T> & a)
+{
+	Vec<N, T> scaled = {};
+
+	for (int i = 0; i < N; i++)
+		scaled.M[i] = a.M[i] * k;
+
+	return scaled;
+}
+
+///////////////////////////////////////////////////////////
+
+template<int N, typename T>
+constexpr T Vec_Dot(const Vec<N, T> & a, const Vec<N, T> & b)
+{
+	// the products are summed from the first one as in VECTORnD_Dot
+
+	T sum = a.M[0] * b.M[0];
+
+	for (int i = 1; i < N; i++)
+		sum += a.M[i] * b.M[i];
+
+	return sum;
+}
+
+///////////////////////////////////////////////////////////
+
+template<typename T>
+constexpr Vec<3, T> Vec_Cross(const Vec<3, T> & a, const Vec<3, T> & b)
+{
+	Vec<3, T> n = {};
+
+	n.M[0] = (a.M[1] * b.M[2]) - (a.M[2] * b.M[1]);
+	n.M[1] = (a.M[2] * b.M[0]) - (a.M[0] * b.M[2]);
+	n.M[2] = (a.M[0] * b.M[1]) - (a.M[1] * b.M[0]);
+
+	return n;
+}
+
+///////////////////////////////////////////////////////////
+
+template<int N, typename T>
+inline typename VECMAT_TRAITS<T>::REAL Vec_Length(const Vec<N, T> & v)
+{
+	typedef typename VECMAT_TRAITS<T>::REAL REAL;
+
+	return std::sqrt((REAL)Vec_Dot(v, v));
+}
+
+///////////////////////////////////////////////////////////
+
+template<int N, typename T>
+inline Vec<N, T> Vec_Normalize(const Vec<N, T> & v)
+{
+	// returns the unit vector, or the zero vector if the length is too small
+	// (as VECTOR3D_Normalize does)
+
+	static_assert(std::is_floating_point<T>::value, "Vec_Normalize: T must be a floating point type");
+
+	const T length = Vec_Length(v);
+
+	if (length < VECMAT_TRAITS<T>::Epsilon())
+		return Vec_Zero<N, T>();
+
+	return Vec_Scale(T(1) / length, v);
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                              FUNCTIONS FOR MATRICES
+////////////////////////////////////////////////////////////////////////////////////////////
+
+template<int N, typename T>
+constexpr Mat<N, N, T> Mat_Identity()
+{
+	Mat<N, N, T> m = {};
+
+	for (int i = 0; i < N; i++)
+		m.M[i][i] = T(1);
+
+	return m;
+}
+
+///////////////////////////////////////////////////////////
+
+template<int R, int C, typename T>
+constexpr Mat<R, C, T> Mat_Add(const Mat<R, C, T> & a, const Mat<R, C, T> & b)
+{
+	Mat<R, C, T> sum = {};
+
+	for (int i = 0; i < R; i++)
+		for (int j = 0; j < C; j++)
+			sum.M[i][j] = a.M[i][j] + b.M[i][j];
+
+	return sum;
+}
+
+///////////////////////////////////////////////////////////
+
+template<int R, int C, typename T>
+constexpr Mat<R, C, T> Mat_Sub(const Mat<R, C, T> & a, const Mat<R, C, T> & b)
+{
+	Mat<R, C, T> diff = {};
+
+	for (int i = 0; i < R; i++)
+		for (int j = 0; j < C; j++)
+			diff.M[i][j] = a.M[i][j] - b.M[i][j];
+
+	return diff;
+}
+
+///////////////////////////////////////////////////////////
+
+template<int R, int C, typename T>
+constexpr Mat<R, C, T> Mat_Scale(const T k, const Mat<R, C, T> & a)
+{
+	Mat<R, C, T> scaled = {};
+
+	for (int i = 0; i < R; i++)
+		for (int j = 0; j < C; j++)
+			scaled.M[i][j] = a.M[i][j] * k;
+
+	return scaled;
+}
+
+///////////////////////////////////////////////////////////
+
+template<int R, int K, int C, typename T>
+constexpr Mat<R, C, T> Mat_Mul(const Mat<R, K, T> & a, const Mat<K, C, T> & b)
+{
+	// the sums are computed in the same order as in Mat_Mul_4X4
+
+	Mat<R, C, T> prod = {};
+
+	for (int i = 0; i < R; i++)
+	{
+		for (int j = 0; j < C; j++)
+		{
+			T sum = T(0);
+
+			for (int k = 0; k < K; k++)
+				sum += a.M[i][k] * b.M[k][j];
+
+			prod.M[i][j] = sum;
+		}
+	}
+
+	return prod;
+}
+
+///////////////////////////////////////////////////////////
+
+template<int R, int C, typename T>
+constexpr Vec<C, T> Mat_Mul_Vec(const Vec<R, T> & v, const Mat<R, C, T> & m)
+{
+	// the row vector by the matrix: v * M (as Mat_Mul_VECTOR4D_4X4)
+
+	Vec<C, T> prod = {};
+
+	for (int col = 0; col < C; col++)
+	{
+		T sum = T(0);
+
+		for (int row = 0; row < R; row++)
+			sum += v.M[row] * m.M[row][col];
+
+		prod.M[col] = sum;
+	}
+
+	return prod;
+}
+
+///////////////////////////////////////////////////////////
+
+template<int R, int C, typename T>
+constexpr Mat<C, R, T> Mat_Transpose(const Mat<R, C, T> & m)
+{
+	Mat<C, R, T> mt = {};
+
+	for (int i = 0; i < R; i++)
+		for (int j = 0; j < C; j++)
+			mt.M[j][i] = m.M[i][j];
+
+	return mt;
+}
+
+///////////////////////////////////////////////////////////
+
+template<typename T>
+constexpr T Mat_Det(const Mat<2, 2, T> & m)
+{
+	return (m.M[0][0] * m.M[1][1]) - (m.M[0][1] * m.M[1][0]);
+}
+
+template<typename T>
+constexpr T Mat_Det(const Mat<3, 3, T> & m)
+{
+	// the same expansion as in Mat_Det_3X3
+
+	return m.M[0][0] * ((m.M[1][1] * m.M[2][2]) - (m.M[2][1] * m.M[1][2])) -
+	       m.M[0][1] * ((m.M[1][0] * m.M[2][2]) - (m.M[2][0] * m.M[1][2])) +
+	       m.M[0][2] * ((m.M[1][0] * m.M[2][1]) - (m.M[2][0] * m.M[1][1]));
+}
+
+///////////////////////////////////////////////////////////
+
+//
+// inverse matrices (only of floating point types): return 1 and the inverse, or 0 and
+// the zero matrix if |det| < VECMAT_TRAITS<T>::Epsilon(); the formulas are the same
+// as in Mat_Inverse_2X2/3X3
+//
+
+template<typename T>
+constexpr int Mat_Inverse(const Mat<2, 2, T> & m, Mat<2, 2, T> & mi)
+{
+	static_assert(std::is_floating_point<T>::value, "Mat_Inverse: T must be a floating point type");
+
+	const T det = Mat_Det(m);
+
+	if (((det < T(0)) ? -det : det) < VECMAT_TRAITS<T>::Epsilon())
+	{
+		mi = Mat<2, 2, T>{};
+		return 0;
+	}
+
+	const T detInv = T(1) / det;
+
+	mi.M[0][0] =  m.M[1][1] * detInv;
+	mi.M[0][1] = -m.M[0][1] * detInv;
+	mi.M[1][0] = -m.M[1][0] * detInv;
+	mi.M[1][1] =  m.M[0][0] * detInv;
+
+	return 1;
+}
+
+///////////////////////////////////////////////////////////
+
+template<typename T>
+constexpr int Mat_Inverse(const Mat<3, 3, T> & m, Mat<3, 3, T> & mi)
+{
+	static_assert(std::is_floating_point<T>::value, "Mat_Inverse: T must be a floating point type");
+
+	const T det = Mat_Det(m);
+
+	if (((det < T(0)) ? -det : det) < VECMAT_TRAITS<T>::Epsilon())
+	{
+		mi = Mat<3, 3, T>{};
+		return 0;
+	}
+
+	const T detInv = T(1) / det;
+
+	// m-1 = adjoint(m) / det(m)
+	mi.M[0][0] =  detInv * (m.M[1][1] * m.M[2][2] - m.M[1][2] * m.M[2][1]);
+	mi.M[0][1] = -detInv * (m.M[0][1] * m.M[2][2] - m.M[0][2] * m.M[2][1]);
+	mi.M[0][2] =  detInv * (m.M[0][1] * m.M[1][2] - m.M[0][2] * m.M[1][1]);
+
+	mi.M[1][0] = -detInv * (m.M[1][0] * m.M[2][2] - m.M[1][2] * m.M[2][0]);
+	mi.M[1][1] =  detInv * (m.M[0][0] * m.M[2][2] - m.M[0][2] * m.M[2][0]);
+	mi.M[1][2] = -detInv * (m.M[0][0] * m.M[1][2] - m.M[0][2] * m.M[1][0]);
+
+	mi.M[2][0] =  detInv * (m.M[1][0] * m.M[2][1] - m.M[1][1] * m.M[2][0]);
+	mi.M[2][1] = -detInv * (m.M[0][0] * m.M[2][1] - m.M[0][1] * m.M[2][0]);
+	mi.M[2][2] =  detInv * (m.M[0][0] * m.M[1][1] - m.M[0][1] * m.M[1][0]);
+
+	return 1;
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                      CONVERSIONS FROM/TO THE LEGACY TYPES
+////////////////////////////////////////////////////////////////////////////////////////////
+
+//
+// the types have the same layout, so the copies are compiled into plain moves
+// (or disappear at all when the functions are inlined)
+//
+
+inline Vec2f To_Vec(const VECTOR2D & v) { return Vec2f{ { v.x, v.y } }; }
+inline Vec3f To_Vec(const VECTOR3D & v) { return Vec3f{ { v.x, v.y, v.z } }; }
+inline Vec4f To_Vec(const VECTOR4D & v) { return Vec4f{ { v.x, v.y, v.z, v.w } }; }
+
+inline VECTOR2D To_VECTOR2D(const Vec2f & v) { return VECTOR2D(v.M[0], v.M[1]); }
+inline VECTOR3D To_VECTOR3D(const Vec3f & v) { return VECTOR3D(v.M[0], v.M[1], v.M[2]); }
+inline VECTOR4D To_VECTOR4D(const Vec4f & v) { return VECTOR4D(v.M[0], v.M[1], v.M[2], v.M[3]); }
+
+///////////////////////////////////////////////////////////
+
+// a matrix from/to the data of a legacy matrix: To_Mat(m4x4.M), To_Array(mat, m4x4.M)
+template<int R, int C>
+inline Mat<R, C, float> To_Mat(const float (&m)[R][C])
+{
+	Mat<R, C, float> mat = {};
+
+	for (int i = 0; i < R; i++)
+		for (int j = 0; j < C; j++)
+			mat.M[i][j] = m[i][j];
+
+	return mat;
+}
+
+template<int R, int C>
+inline void To_Array(const Mat<R, C, float> & mat, float (&m)[R][C])
+{
+	for (int i = 0; i < R; i++)
+		for (int j = 0; j < C; j++)
+			m[i][j] = mat.M[i][j];
+}
+
+} // end namespace MathLib
@@ -288,4 +288,154 @@ void QUAT_Mul(const QUAT & q1, const QUAT & q2, QUAT & qprod)
 
 } // end QUAT_Mul
 
+///////////////////////////////////////////////////////////
+
+void QUAT_Rotate_VECTOR3D(const QUAT & q, const VECTOR3D & v, VECTOR3D & vr)
+{
+	// this function rotates the vector v by the unit quaternion q: vr = q * v * q^-1;
+	//
+	// instead of two full QUAT_Mul calls the optimized cross-product form is used:
+	//   t  = 2 * (qv x v)
+	//   vr = v + w*t + (qv x t)
+	// it takes 15 multiplications instead of 32; vr can be the same as v
+
+	// 2 * qv (multiplication by 2 is exact so t == 2 * (qv x v))
+	const float qx2 = 2.0f * q.x;
+	const float qy2 = 2.0f * q.y;
+	const float qz2 = 2.0f * q.z;
+
+	const float tx = (qy2 * v.z) - (qz2 * v.y);
+	const float ty = (qz2 * v.x) - (qx2 * v.z);
+	const float tz = (qx2 * v.y) - (qy2 * v.x);
+
+	const float x = v.x + (q.w * tx) + ((q.y * tz) - (q.z * ty));
+	const float y = v.y + (q.w * ty) + ((q.z * tx) - (q.x * tz));
+	const float z = v.z + (q.w * tz) + ((q.x * ty) - (q.y * tx));
+
+	vr.x = x;
+	vr.y = y;
+	vr.z = z;
+
+} // end QUAT_Rotate_VECTOR3D
+
+///////////////////////////////////////////////////////////
+
+float QUAT_Dot(const QUAT & q1, const QUAT & q2)
+{
+	// this function returns a dot product of two quaternions;
+	// for unit quaternions it is the cosine of the half of the angle between rotations
+
+	return (q1.w*q2.w) + (q1.x*q2.x) + (q1.y*q2.y) + (q1.z*q2.z);
+
+} // end QUAT_Dot
+
+///////////////////////////////////////////////////////////
+
+void QUAT_Slerp(const QUAT & q1, const QUAT & q2, const float t, QUAT & qr)
+{
+	// this function computes a spherical linear interpolation between two
+	// unit quaternions: qr = (sin((1-t)*omega)*q1 + sin(t*omega)*q2) / sin(omega);
+	//
+	// q and -q are the same rotation, so if the dot product is negative
+	// we use -q2 to interpolate along the shortest arc
+
+	float cos_omega = QUAT_Dot(q1, q2);
+	float sign = 1.0f;
+
+	if (cos_omega < 0.0f)
+	{
+		cos_omega = -cos_omega;
+		sign = -1.0f;
+	}
+
+	float k1 = 1.0f - t;
+	float k2 = t;
+
+	// for very close quaternions sin(omega) is about 0, but the linear
+	// interpolation is precise enough there
+	if (cos_omega < (1.0f - EPSILON_E5))
+	{
+		const float omega = acosf(cos_omega);
+		const float sin_omega_inv = 1.0f / sinf(omega);
+
+		k1 = sinf(k1 * omega) * sin_omega_inv;
+		k2 = sinf(k2 * omega) * sin_omega_inv;
+	}
+
+	k2 *= sign;
+
+	qr.w = (k1 * q1.w) + (k2 * q2.w);
+	qr.x = (k1 * q1.x) + (k2 * q2.x);
+	qr.y = (k1 * q1.y) + (k2 * q2.y);
+	qr.z = (k1 * q1.z) + (k2 * q2.z);
+
+} // end QUAT_Slerp
+
+///////////////////////////////////////////////////////////
+
+void QUAT_Slerp_Fast(const QUAT & q1, const QUAT & q2, const float t, QUAT & qr)
+{
+	// this function computes an approximation of the spherical linear interpolation
+	// without any trigonometric functions and branches (D. Eberly, "A Fast and Accurate
+	// Algorithm for Computing SLERP"); the coefficients sin(t*omega)/sin(omega) are
+	// computed as polynomials of t and cos(omega):
+	//
+	//   c(t) = t * (1 + b0*(1 + b1*(1 + ... (1 + b7)))),
+	//   b_i  = (u_i * t^2 - v_i) * (cos(omega) - 1)
+	//
+	// the error is about 1e-7 and grows up to 3e-5 only for rotations which differ
+	// by almost 180 degrees; the batch kernels use the same computation
+	// (see QUAT_Slerp_Batch)
+
+	float x = QUAT_Dot(q1, q2);
+
+	// use the shortest arc
+	const float sign = (x < 0.0f) ? -1.0f : 1.0f;
+	x = fabsf(x);
+
+	const float xm1 = x - 1.0f;
+	const float d = 1.0f - t;
+	const float sqrT = t * t;
+	const float sqrD = d * d;
+
+	float fT = 1.0f;
+	float fD = 1.0f;
+
+	for (int i = 7; i >= 0; i--)
+	{
+		fT = 1.0f + (((QUAT_SLERP_U[i] * sqrT) - QUAT_SLERP_V[i]) * xm1) * fT;
+		fD = 1.0f + (((QUAT_SLERP_U[i] * sqrD) - QUAT_SLERP_V[i]) * xm1) * fD;
+	}
+
+	const float k1 = fD * d;
+	const float k2 = fT * (sign * t);
+
+	qr.w = (k1 * q1.w) + (k2 * q2.w);
+	qr.x = (k1 * q1.x) + (k2 * q2.x);
+	qr.y = (k1 * q1.y) + (k2 * q2.y);
+	qr.z = (k1 * q1.z) + (k2 * q2.z);
+
+} // end QUAT_Slerp_Fast
+
+///////////////////////////////////////////////////////////
+
+void QUAT_Nlerp(const QUAT & q1, const QUAT & q2, const float t, QUAT & qr)
+{
+	// this function computes a normalized linear interpolation between two unit
+	// quaternions; it is the cheapest way to interpolate rotations, but the angular
+	// velocity isn't constant (the error is noticeable only for big angles)
+
+	// use the shortest arc
+	const float k1 = 1.0f - t;
+	const float k2 = (QUAT_Dot(q1, q2) < 0.0f) ? -t : t;
+
+	qr.w = (k1 * q1.w) + (k2 * q2.w);
+	qr.x = (k1 * q1.x) + (k2 * q2.x);
+	qr.y = (k1 * q1.y) + (k2 * q2.y);
+	qr.z = (k1 * q1.z) + (k2 * q2.z);
+
+	QUAT_Normalize(qr);
+
+} // end QUAT_Nlerp
+
 } // end namespace MathLib
@@ -33,7 +33,7 @@ typedef struct QUAT_TYPE
 		struct               // q = q0 + qv
 		{
 			float q0;        // real part
-			VECTOR3D qv;     // imaginary part (vector representation)
+			float qv[3];     // imaginary part (vector representation)
 		};
 
 		struct               // q = q0 + <q1, q2, q1>
@@ -49,6 +49,28 @@ typedef struct QUAT_TYPE
 
 
 
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                   CONSTANTS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+// coefficients of the polynomial approximation of SLERP (see QUAT_Slerp_Fast):
+// u_i = 1 / (i*(2i+1)), v_i = i / (2i+1) for i = 1..8; the last pair is multiplied
+// by the correction factor mu = 1.85298109 which minimizes the maximal error
+constexpr float QUAT_SLERP_U[8] =
+{
+	1.0f / (1 * 3), 1.0f / (2 * 5), 1.0f / (3 * 7),  1.0f / (4 * 9),
+	1.0f / (5 * 11), 1.0f / (6 * 13), 1.0f / (7 * 15), 1.85298109240830f / (8 * 17)
+};
+
+constexpr float QUAT_SLERP_V[8] =
+{
+	1.0f / 3, 2.0f / 5, 3.0f / 7, 4.0f / 9,
+	5.0f / 11, 6.0f / 13, 7.0f / 15, 1.85298109240830f * 8 / 17
+};
+
+
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////
 //                               INLINE OPERATIONS
 ////////////////////////////////////////////////////////////////////////////////////////////
@@ -128,4 +150,13 @@ void QUAT_Inverse(const QUAT & q, QUAT & qi);
 
 void QUAT_Mul(const QUAT & q1, const QUAT & q2, QUAT & qprod);
 
+void QUAT_Rotate_VECTOR3D(const QUAT & q, const VECTOR3D & v, VECTOR3D & vr);
+
+float QUAT_Dot(const QUAT & q1, const QUAT & q2);
+
+// interpolation between unit quaternions (t is in [0, 1]); the shortest arc is used
+void QUAT_Slerp(const QUAT & q1, const QUAT & q2, const float t, QUAT & qr);       // exact (acosf/sinf)
+void QUAT_Slerp_Fast(const QUAT & q1, const QUAT & q2, const float t, QUAT & qr);  // polynomial approximation
+void QUAT_Nlerp(const QUAT & q1, const QUAT & q2, const float t, QUAT & qr);       // normalized lerp
+
 } // end namespace MathLib
\ No newline at end of file
@@ -0,0 +1,472 @@
+////////////////////////////////////////////////////////////////////////////////////////////
+// Filename:      QuaternionBatch.cpp
+// Description:   contains implementation of batch rotation of points by quaternions
+//                (scalar, SSE and AVX2 kernels + runtime dispatching)
+//
+// Created:       17.10.26
+////////////////////////////////////////////////////////////////////////////////////////////
+#include "QuaternionBatch.h"
+#include "../Utils/Simd.h"
+
+
+namespace MathLib
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                      BATCH ROTATION OF 3D POINTS BY QUATERNION
+////////////////////////////////////////////////////////////////////////////////////////////
+
+//
+// NOTE: all the kernels use the same cross-product form and the same order
+//       of operations as QUAT_Rotate_VECTOR3D:
+//
+//           t  = 2 * (qv x v)
+//           vr = (v + w*t) + (qv x t)
+//
+
+void QUAT_Rotate_VECTOR3D_Batch_Scalar(const QUAT & q,
+	const float* xIn, const float* yIn, const float* zIn,
+	float* xOut, float* yOut, float* zOut,
+	const int num)
+{
+	// rotates num points by the quaternion using plain C++ code (reference kernel)
+
+	assert(xIn && yIn && zIn);
+	assert(xOut && yOut && zOut);
+	assert(num >= 0);
+
+	for (int i = 0; i < num; i++)
+	{
+		VECTOR3D v(xIn[i], yIn[i], zIn[i]);
+
+		QUAT_Rotate_VECTOR3D(q, v, v);
+
+		xOut[i] = v.x;
+		yOut[i] = v.y;
+		zOut[i] = v.z;
+	}
+
+} // end QUAT_Rotate_VECTOR3D_Batch_Scalar
+
+///////////////////////////////////////////////////////////
+
+#if MATHLIB_SIMD_X86
+
+MATHLIB_TARGET_SSE41
+void QUAT_Rotate_VECTOR3D_Batch_SSE(const QUAT & q,
+	const float* xIn, const float* yIn, const float* zIn,
+	float* xOut, float* yOut, float* zOut,
+	const int num)
+{
+	// rotates num points by the quaternion; processes 4 points per iteration;
+	// the tail (num % 4 points) is processed by the scalar kernel
+
+	assert(xIn && yIn && zIn);
+	assert(xOut && yOut && zOut);
+	assert(num >= 0);
+
+	const __m128 qw  = _mm_set1_ps(q.w);
+	const __m128 qx  = _mm_set1_ps(q.x);
+	const __m128 qy  = _mm_set1_ps(q.y);
+	const __m128 qz  = _mm_set1_ps(q.z);
+	const __m128 qx2 = _mm_set1_ps(2.0f * q.x);
+	const __m128 qy2 = _mm_set1_ps(2.0f * q.y);
+	const __m128 qz2 = _mm_set1_ps(2.0f * q.z);
+
+	int i = 0;
+
+	for (; i + 4 <= num; i += 4)
+	{
+		const __m128 vx = _mm_loadu_ps(xIn + i);
+		const __m128 vy = _mm_loadu_ps(yIn + i);
+		const __m128 vz = _mm_loadu_ps(zIn + i);
+
+		// t = 2 * (qv x v)
+		const __m128 tx = _mm_sub_ps(_mm_mul_ps(qy2, vz), _mm_mul_ps(qz2, vy));
+		const __m128 ty = _mm_sub_ps(_mm_mul_ps(qz2, vx), _mm_mul_ps(qx2, vz));
+		const __m128 tz = _mm_sub_ps(_mm_mul_ps(qx2, vy), _mm_mul_ps(qy2, vx));
+
+		// vr = (v + w*t) + (qv x t)
+		const __m128 x = _mm_add_ps(_mm_add_ps(vx, _mm_mul_ps(qw, tx)),
+		                            _mm_sub_ps(_mm_mul_ps(qy, tz), _mm_mul_ps(qz, ty)));
+		const __m128 y = _mm_add_ps(_mm_add_ps(vy, _mm_mul_ps(qw, ty)),
+		                            _mm_sub_ps(_mm_mul_ps(qz, tx), _mm_mul_ps(qx, tz)));
+		const __m128 z = _mm_add_ps(_mm_add_ps(vz, _mm_mul_ps(qw, tz)),
+		                            _mm_sub_ps(_mm_mul_ps(qx, ty), _mm_mul_ps(qy, tx)));
+
+		_mm_storeu_ps(xOut + i, x);
+		_mm_storeu_ps(yOut + i, y);
+		_mm_storeu_ps(zOut + i, z);
+	}
+
+	// process the rest of points
+	QUAT_Rotate_VECTOR3D_Batch_Scalar(q, xIn + i, yIn + i, zIn + i,
+		xOut + i, yOut + i, zOut + i, num - i);
+
+} // end QUAT_Rotate_VECTOR3D_Batch_SSE
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_AVX2
+void QUAT_Rotate_VECTOR3D_Batch_AVX2(const QUAT & q,
+	const float* xIn, const float* yIn, const float* zIn,
+	float* xOut, float* yOut, float* zOut,
+	const int num)
+{
+	// rotates num points by the quaternion; processes 8 points per iteration;
+	// the tail (num % 8 points) is processed by the SSE kernel
+	//
+	// NOTE: FMA isn't used here on purpose (see the note in Simd.h)
+
+	assert(xIn && yIn && zIn);
+	assert(xOut && yOut && zOut);
+	assert(num >= 0);
+
+	const __m256 qw  = _mm256_set1_ps(q.w);
+	const __m256 qx  = _mm256_set1_ps(q.x);
+	const __m256 qy  = _mm256_set1_ps(q.y);
+	const __m256 qz  = _mm256_set1_ps(q.z);
+	const __m256 qx2 = _mm256_set1_ps(2.0f * q.x);
+	const __m256 qy2 = _mm256_set1_ps(2.0f * q.y);
+	const __m256 qz2 = _mm256_set1_ps(2.0f * q.z);
+
+	int i = 0;
+
+	for (; i + 8 <= num; i += 8)
+	{
+		const __m256 vx = _mm256_loadu_ps(xIn + i);
+		const __m256 vy = _mm256_loadu_ps(yIn + i);
+		const __m256 vz = _mm256_loadu_ps(zIn + i);
+
+		// t = 2 * (qv x v)
+		const __m256 tx = _mm256_sub_ps(_mm256_mul_ps(qy2, vz), _mm256_mul_ps(qz2, vy));
+		const __m256 ty = _mm256_sub_ps(_mm256_mul_ps(qz2, vx), _mm256_mul_ps(qx2, vz));
+		const __m256 tz = _mm256_sub_ps(_mm256_mul_ps(qx2, vy), _mm256_mul_ps(qy2, vx));
+
+		// vr = (v + w*t) + (qv x t)
+		const __m256 x = _mm256_add_ps(_mm256_add_ps(vx, _mm256_mul_ps(qw, tx)),
+		                               _mm256_sub_ps(_mm256_mul_ps(qy, tz), _mm256_mul_ps(qz, ty)));
+		const __m256 y = _mm256_add_ps(_mm256_add_ps(vy, _mm256_mul_ps(qw, ty)),
+		                               _mm256_sub_ps(_mm256_mul_ps(qz, tx), _mm256_mul_ps(qx, tz)));
+		const __m256 z = _mm256_add_ps(_mm256_add_ps(vz, _mm256_mul_ps(qw, tz)),
+		                               _mm256_sub_ps(_mm256_mul_ps(qx, ty), _mm256_mul_ps(qy, tx)));
+
+		_mm256_storeu_ps(xOut + i, x);
+		_mm256_storeu_ps(yOut + i, y);
+		_mm256_storeu_ps(zOut + i, z);
+	}
+
+	// process the rest of points
+	QUAT_Rotate_VECTOR3D_Batch_SSE(q, xIn + i, yIn + i, zIn + i,
+		xOut + i, yOut + i, zOut + i, num - i);
+
+} // end QUAT_Rotate_VECTOR3D_Batch_AVX2
+
+#else
+
+// there is no SIMD support for this platform so use the reference kernel
+
+void QUAT_Rotate_VECTOR3D_Batch_SSE(const QUAT & q,
+	const float* xIn, const float* yIn, const float* zIn,
+	float* xOut, float* yOut, float* zOut,
+	const int num)
+{
+	QUAT_Rotate_VECTOR3D_Batch_Scalar(q, xIn, yIn, zIn, xOut, yOut, zOut, num);
+}
+
+void QUAT_Rotate_VECTOR3D_Batch_AVX2(const QUAT & q,
+	const float* xIn, const float* yIn, const float* zIn,
+	float* xOut, float* yOut, float* zOut,
+	const int num)
+{
+	QUAT_Rotate_VECTOR3D_Batch_Scalar(q, xIn, yIn, zIn, xOut, yOut, zOut, num);
+}
+
+#endif // MATHLIB_SIMD_X86
+
+///////////////////////////////////////////////////////////
+
+void QUAT_Rotate_VECTOR3D_Batch(const QUAT & q,
+	const float* xIn, const float* yIn, const float* zIn,
+	float* xOut, float* yOut, float* zOut,
+	const int num)
+{
+	// rotates num points by the quaternion using the best kernel for the current CPU
+
+	switch (SIMD_Get_Level())
+	{
+		case SIMD_LEVEL_AVX2:
+			QUAT_Rotate_VECTOR3D_Batch_AVX2(q, xIn, yIn, zIn, xOut, yOut, zOut, num);
+			break;
+
+		case SIMD_LEVEL_AVX:
+		case SIMD_LEVEL_SSE:
+			QUAT_Rotate_VECTOR3D_Batch_SSE(q, xIn, yIn, zIn, xOut, yOut, zOut, num);
+			break;
+
+		default:
+			QUAT_Rotate_VECTOR3D_Batch_Scalar(q, xIn, yIn, zIn, xOut, yOut, zOut, num);
+	}
+
+} // end QUAT_Rotate_VECTOR3D_Batch
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                        BATCH INTERPOLATION OF QUATERNIONS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+//
+// NOTE: all the kernels use the polynomial approximation and the same order
+//       of operations as QUAT_Slerp_Fast
+//
+
+void QUAT_Slerp_Batch_Scalar(const QUAT_SOA & q1, const QUAT_SOA & q2, const float* t,
+	const QUAT_SOA_OUT & qOut,
+	const int num)
+{
+	// interpolates num pairs of quaternions using plain C++ code (reference kernel)
+
+	assert(q1.w && q1.x && q1.y && q1.z);
+	assert(q2.w && q2.x && q2.y && q2.z);
+	assert(qOut.w && qOut.x && qOut.y && qOut.z);
+	assert(t != nullptr);
+	assert(num >= 0);
+
+	for (int i = 0; i < num; i++)
+	{
+		const QUAT a(q1.w[i], q1.x[i], q1.y[i], q1.z[i]);
+		const QUAT b(q2.w[i], q2.x[i], q2.y[i], q2.z[i]);
+		QUAT qr;
+
+		QUAT_Slerp_Fast(a, b, t[i], qr);
+
+		qOut.w[i] = qr.w;
+		qOut.x[i] = qr.x;
+		qOut.y[i] = qr.y;
+		qOut.z[i] = qr.z;
+	}
+
+} // end QUAT_Slerp_Batch_Scalar
+
+///////////////////////////////////////////////////////////
+
+#if MATHLIB_SIMD_X86
+
+MATHLIB_TARGET_SSE41
+void QUAT_Slerp_Batch_SSE(const QUAT_SOA & q1, const QUAT_SOA & q2, const float* t,
+	const QUAT_SOA_OUT & qOut,
+	const int num)
+{
+	// interpolates num pairs of quaternions; processes 4 pairs per iteration;
+	// the tail (num % 4 pairs) is processed by the scalar kernel
+
+	assert(q1.w && q1.x && q1.y && q1.z);
+	assert(q2.w && q2.x && q2.y && q2.z);
+	assert(qOut.w && qOut.x && qOut.y && qOut.z);
+	assert(t != nullptr);
+	assert(num >= 0);
+
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 signMask = _mm_set1_ps(-0.0f);
+
+	int i = 0;
+
+	for (; i + 4 <= num; i += 4)
+	{
+		const __m128 aw = _mm_loadu_ps(q1.w + i);
+		const __m128 ax = _mm_loadu_ps(q1.x + i);
+		const __m128 ay = _mm_loadu_ps(q1.y + i);
+		const __m128 az = _mm_loadu_ps(q1.z + i);
+		const __m128 bw = _mm_loadu_ps(q2.w + i);
+		const __m128 bx = _mm_loadu_ps(q2.x + i);
+		const __m128 by = _mm_loadu_ps(q2.y + i);
+		const __m128 bz = _mm_loadu_ps(q2.z + i);
+		const __m128 vt = _mm_loadu_ps(t + i);
+
+		// dot product
+		__m128 x = _mm_mul_ps(aw, bw);
+		x = _mm_add_ps(x, _mm_mul_ps(ax, bx));
+		x = _mm_add_ps(x, _mm_mul_ps(ay, by));
+		x = _mm_add_ps(x, _mm_mul_ps(az, bz));
+
+		// use the shortest arc: flip the sign of t where the dot product is negative
+		const __m128 flip = _mm_and_ps(_mm_cmplt_ps(x, zero), signMask);
+		x = _mm_andnot_ps(signMask, x);
+
+		const __m128 xm1 = _mm_sub_ps(x, one);
+		const __m128 d = _mm_sub_ps(one, vt);
+		const __m128 sqrT = _mm_mul_ps(vt, vt);
+		const __m128 sqrD = _mm_mul_ps(d, d);
+
+		__m128 fT = one;
+		__m128 fD = one;
+
+		for (int k = 7; k >= 0; k--)
+		{
+			const __m128 u = _mm_set1_ps(QUAT_SLERP_U[k]);
+			const __m128 v = _mm_set1_ps(QUAT_SLERP_V[k]);
+
+			const __m128 bT = _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(u, sqrT), v), xm1);
+			const __m128 bD = _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(u, sqrD), v), xm1);
+
+			fT = _mm_add_ps(one, _mm_mul_ps(bT, fT));
+			fD = _mm_add_ps(one, _mm_mul_ps(bD, fD));
+		}
+
+		const __m128 k1 = _mm_mul_ps(fD, d);
+		const __m128 k2 = _mm_mul_ps(fT, _mm_xor_ps(vt, flip));
+
+		_mm_storeu_ps(qOut.w + i, _mm_add_ps(_mm_mul_ps(k1, aw), _mm_mul_ps(k2, bw)));
+		_mm_storeu_ps(qOut.x + i, _mm_add_ps(_mm_mul_ps(k1, ax), _mm_mul_ps(k2, bx)));
+		_mm_storeu_ps(qOut.y + i, _mm_add_ps(_mm_mul_ps(k1, ay), _mm_mul_ps(k2, by)));
+		_mm_storeu_ps(qOut.z + i, _mm_add_ps(_mm_mul_ps(k1, az), _mm_mul_ps(k2, bz)));
+	}
+
+	// process the rest of pairs
+	if (i < num)
+	{
+		const QUAT_SOA a    = { q1.w + i, q1.x + i, q1.y + i, q1.z + i };
+		const QUAT_SOA b    = { q2.w + i, q2.x + i, q2.y + i, q2.z + i };
+		const QUAT_SOA_OUT rest = { qOut.w + i, qOut.x + i, qOut.y + i, qOut.z + i };
+
+		QUAT_Slerp_Batch_Scalar(a, b, t + i, rest, num - i);
+	}
+
+} // end QUAT_Slerp_Batch_SSE
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_AVX2
+void QUAT_Slerp_Batch_AVX2(const QUAT_SOA & q1, const QUAT_SOA & q2, const float* t,
+	const QUAT_SOA_OUT & qOut,
+	const int num)
+{
+	// interpolates num pairs of quaternions; processes 8 pairs per iteration;
+	// the tail (num % 8 pairs) is processed by the SSE kernel
+	//
+	// NOTE: FMA isn't used here on purpose (see the note in Simd.h)
+
+	assert(q1.w && q1.x && q1.y && q1.z);
+	assert(q2.w && q2.x && q2.y && q2.z);
+	assert(qOut.w && qOut.x && qOut.y && qOut.z);
+	assert(t != nullptr);
+	assert(num >= 0);
+
+	const __m256 zero = _mm256_setzero_ps();
+	const __m256 one = _mm256_set1_ps(1.0f);
+	const __m256 signMask = _mm256_set1_ps(-0.0f);
+
+	int i = 0;
+
+	for (; i + 8 <= num; i += 8)
+	{
+		const __m256 aw = _mm256_loadu_ps(q1.w + i);
+		const __m256 ax = _mm256_loadu_ps(q1.x + i);
+		const __m256 ay = _mm256_loadu_ps(q1.y + i);
+		const __m256 az = _mm256_loadu_ps(q1.z + i);
+		const __m256 bw = _mm256_loadu_ps(q2.w + i);
+		const __m256 bx = _mm256_loadu_ps(q2.x + i);
+		const __m256 by = _mm256_loadu_ps(q2.y + i);
+		const __m256 bz = _mm256_loadu_ps(q2.z + i);
+		const __m256 vt = _mm256_loadu_ps(t + i);
+
+		// dot product
+		__m256 x = _mm256_mul_ps(aw, bw);
+		x = _mm256_add_ps(x, _mm256_mul_ps(ax, bx));
+		x = _mm256_add_ps(x, _mm256_mul_ps(ay, by));
+		x = _mm256_add_ps(x, _mm256_mul_ps(az, bz));
+
+		// use the shortest arc: flip the sign of t where the dot product is negative
+		const __m256 flip = _mm256_and_ps(_mm256_cmp_ps(x, zero, _CMP_LT_OQ), signMask);
+		x = _mm256_andnot_ps(signMask, x);
+
+		const __m256 xm1 = _mm256_sub_ps(x, one);
+		const __m256 d = _mm256_sub_ps(one, vt);
+		const __m256 sqrT = _mm256_mul_ps(vt, vt);
+		const __m256 sqrD = _mm256_mul_ps(d, d);
+
+		__m256 fT = one;
+		__m256 fD = one;
+
+		for (int k = 7; k >= 0; k--)
+		{
+			const __m256 u = _mm256_set1_ps(QUAT_SLERP_U[k]);
+			const __m256 v = _mm256_set1_ps(QUAT_SLERP_V[k]);
+
+			const __m256 bT = _mm256_mul_ps(_mm256_sub_ps(_mm256_mul_ps(u, sqrT), v), xm1);
+			const __m256 bD = _mm256_mul_ps(_mm256_sub_ps(_mm256_mul_ps(u, sqrD), v), xm1);
+
+			fT = _mm256_add_ps(one, _mm256_mul_ps(bT, fT));
+			fD = _mm256_add_ps(one, _mm256_mul_ps(bD, fD));
+		}
+
+		const __m256 k1 = _mm256_mul_ps(fD, d);
+		const __m256 k2 = _mm256_mul_ps(fT, _mm256_xor_ps(vt, flip));
+
+		_mm256_storeu_ps(qOut.w + i, _mm256_add_ps(_mm256_mul_ps(k1, aw), _mm256_mul_ps(k2, bw)));
+		_mm256_storeu_ps(qOut.x + i, _mm256_add_ps(_mm256_mul_ps(k1, ax), _mm256_mul_ps(k2, bx)));
+		_mm256_storeu_ps(qOut.y + i, _mm256_add_ps(_mm256_mul_ps(k1, ay), _mm256_mul_ps(k2, by)));
+		_mm256_storeu_ps(qOut.z + i, _mm256_add_ps(_mm256_mul_ps(k1, az), _mm256_mul_ps(k2, bz)));
+	}
+
+	// process the rest of pairs
+	if (i < num)
+	{
+		const QUAT_SOA a    = { q1.w + i, q1.x + i, q1.y + i, q1.z + i };
+		const QUAT_SOA b    = { q2.w + i, q2.x + i, q2.y + i, q2.z + i };
+		const QUAT_SOA_OUT rest = { qOut.w + i, qOut.x + i, qOut.y + i, qOut.z + i };
+
+		QUAT_Slerp_Batch_SSE(a, b, t + i, rest, num - i);
+	}
+
+} // end QUAT_Slerp_Batch_AVX2
+
+#else
+
+// there is no SIMD support for this platform so use the reference kernel
+
+void QUAT_Slerp_Batch_SSE(const QUAT_SOA & q1, const QUAT_SOA & q2, const float* t,
+	const QUAT_SOA_OUT & qOut,
+	const int num)
+{
+	QUAT_Slerp_Batch_Scalar(q1, q2, t, qOut, num);
+}
+
+void QUAT_Slerp_Batch_AVX2(const QUAT_SOA & q1, const QUAT_SOA & q2, const float* t,
+	const QUAT_SOA_OUT & qOut,
+	const int num)
+{
+	QUAT_Slerp_Batch_Scalar(q1, q2, t, qOut, num);
+}
+
+#endif // MATHLIB_SIMD_X86
+
+///////////////////////////////////////////////////////////
+
+void QUAT_Slerp_Batch(const QUAT_SOA & q1, const QUAT_SOA & q2, const float* t,
+	const QUAT_SOA_OUT & qOut,
+	const int num)
+{
+	// interpolates num pairs of quaternions using the best kernel for the current CPU
+
+	switch (SIMD_Get_Level())
+	{
+		case SIMD_LEVEL_AVX2:
+			QUAT_Slerp_Batch_AVX2(q1, q2, t, qOut, num);
+			break;
+
+		case SIMD_LEVEL_AVX:
+		case SIMD_LEVEL_SSE:
+			QUAT_Slerp_Batch_SSE(q1, q2, t, qOut, num);
+			break;
+
+		default:
+			QUAT_Slerp_Batch_Scalar(q1, q2, t, qOut, num);
+	}
+
+} // end QUAT_Slerp_Batch
+
+} // end namespace MathLib
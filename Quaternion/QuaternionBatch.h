@@ -0,0 +1,118 @@
+////////////////////////////////////////////////////////////////////////////////////////////
+// Filename:      QuaternionBatch.h
+// Description:   contains functional for batch rotation of points/vectors by
+//                quaternions; the data is stored in SoA form (separate streams
+//                of x[], y[], z[] components) so it can be processed by SIMD kernels
+//
+// Created:       17.10.26
+////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "Quaternion.h"
+
+
+namespace MathLib
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                 DATA STRUCTURES
+////////////////////////////////////////////////////////////////////////////////////////////
+
+// array of quaternions in SoA form: separate streams of w[], x[], y[], z[] components
+// (an input view)
+typedef struct QUAT_SOA_TYPE
+{
+	const float* w = nullptr;
+	const float* x = nullptr;
+	const float* y = nullptr;
+	const float* z = nullptr;
+} QUAT_SOA, *QUAT_SOA_PTR;
+
+// the same streams as an output view (for the results of the batch functions);
+// it converts to the input view
+typedef struct QUAT_SOA_OUT_TYPE
+{
+	float* w = nullptr;
+	float* x = nullptr;
+	float* y = nullptr;
+	float* z = nullptr;
+
+	operator QUAT_SOA() const
+	{
+		const QUAT_SOA soa = { w, x, y, z };
+		return soa;
+	}
+} QUAT_SOA_OUT, *QUAT_SOA_OUT_PTR;
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                         BATCH ROTATION OF 3D POINTS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+//
+// each function rotates num points (x[i], y[i], z[i]) by the unit quaternion q;
+// the results are bit-compatible with QUAT_Rotate_VECTOR3D for each kernel;
+//
+// output streams may be the same as the input streams (in-place rotation),
+// but they must not partially overlap
+//
+
+// chooses the best kernel for the current CPU (see SIMD_Get_Level)
+void QUAT_Rotate_VECTOR3D_Batch(const QUAT & q,
+	const float* xIn, const float* yIn, const float* zIn,
+	float* xOut, float* yOut, float* zOut,
+	const int num);
+
+// separate kernels (SSE/AVX2 kernels must be called only if the CPU supports them)
+void QUAT_Rotate_VECTOR3D_Batch_Scalar(const QUAT & q,
+	const float* xIn, const float* yIn, const float* zIn,
+	float* xOut, float* yOut, float* zOut,
+	const int num);
+
+void QUAT_Rotate_VECTOR3D_Batch_SSE(const QUAT & q,
+	const float* xIn, const float* yIn, const float* zIn,
+	float* xOut, float* yOut, float* zOut,
+	const int num);
+
+void QUAT_Rotate_VECTOR3D_Batch_AVX2(const QUAT & q,
+	const float* xIn, const float* yIn, const float* zIn,
+	float* xOut, float* yOut, float* zOut,
+	const int num);
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                        BATCH INTERPOLATION OF QUATERNIONS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+//
+// each function interpolates num pairs of unit quaternions: qOut[i] = slerp(q1[i], q2[i], t[i]);
+// (e.g. two keyframes of each bone track and the local time between them);
+// the polynomial approximation of QUAT_Slerp_Fast is used and the results are
+// bit-compatible with it for each kernel;
+//
+// qOut may be the same as q1 or q2
+//
+
+// chooses the best kernel for the current CPU (see SIMD_Get_Level)
+void QUAT_Slerp_Batch(const QUAT_SOA & q1, const QUAT_SOA & q2, const float* t,
+	const QUAT_SOA_OUT & qOut,
+	const int num);
+
+// separate kernels (SSE/AVX2 kernels must be called only if the CPU supports them)
+void QUAT_Slerp_Batch_Scalar(const QUAT_SOA & q1, const QUAT_SOA & q2, const float* t,
+	const QUAT_SOA_OUT & qOut,
+	const int num);
+
+void QUAT_Slerp_Batch_SSE(const QUAT_SOA & q1, const QUAT_SOA & q2, const float* t,
+	const QUAT_SOA_OUT & qOut,
+	const int num);
+
+void QUAT_Slerp_Batch_AVX2(const QUAT_SOA & q1, const QUAT_SOA & q2, const float* t,
+	const QUAT_SOA_OUT & qOut,
+	const int num);
+
+} // end namespace MathLib
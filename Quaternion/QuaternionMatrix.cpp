@@ -0,0 +1,690 @@
+////////////////////////////////////////////////////////////////////////////////////////////
+// Filename:      QuaternionMatrix.cpp
+// Description:   contains implementation of conversion between quaternions and
+//                rotation matrices (scalar, SSE and AVX2 kernels + runtime dispatching)
+//
+// Created:       17.10.26
+////////////////////////////////////////////////////////////////////////////////////////////
+#include "QuaternionMatrix.h"
+#include "../Utils/Simd.h"
+
+
+namespace MathLib
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                               HELPER FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+static void Rotation_3X3_To_QUAT(
+	const float m00, const float m01, const float m02,
+	const float m10, const float m11, const float m12,
+	const float m20, const float m21, const float m22,
+	QUAT & q)
+{
+	// this function computes a unit quaternion from the elements of a rotation matrix;
+	//
+	// the largest component of the quaternion is computed from the diagonal, and
+	// the others are computed from the sums/differences of the off-diagonal elements
+	// (the largest one is chosen so that t >= 1, so there is no loss of precision);
+	// the choice needs only two comparisons without computing all the four candidates
+
+	float t, s;
+
+	if (m22 < 0)
+	{
+		if (m00 > m11)
+		{
+			// x is the largest
+			t = 1.0f + m00 - m11 - m22;
+			s = 0.5f / sqrtf(t);
+			q.w = (m12 - m21) * s;
+			q.x = t * s;
+			q.y = (m01 + m10) * s;
+			q.z = (m02 + m20) * s;
+		}
+		else
+		{
+			// y is the largest
+			t = 1.0f - m00 + m11 - m22;
+			s = 0.5f / sqrtf(t);
+			q.w = (m20 - m02) * s;
+			q.x = (m01 + m10) * s;
+			q.y = t * s;
+			q.z = (m12 + m21) * s;
+		}
+	}
+	else
+	{
+		if (m00 < -m11)
+		{
+			// z is the largest
+			t = 1.0f - m00 - m11 + m22;
+			s = 0.5f / sqrtf(t);
+			q.w = (m01 - m10) * s;
+			q.x = (m02 + m20) * s;
+			q.y = (m12 + m21) * s;
+			q.z = t * s;
+		}
+		else
+		{
+			// w is the largest
+			t = 1.0f + m00 + m11 + m22;
+			s = 0.5f / sqrtf(t);
+			q.w = t * s;
+			q.x = (m12 - m21) * s;
+			q.y = (m20 - m02) * s;
+			q.z = (m01 - m10) * s;
+		}
+	}
+
+} // end Rotation_3X3_To_QUAT
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                              SINGLE CONVERSION
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void QUAT_To_MATRIX3X3(const QUAT & q, MATRIX3X3* pMat)
+{
+	// this function computes a rotation matrix of the unit quaternion q;
+	// (for row vectors so it is a transpose of the usual "column" form):
+	//
+	//  | 1-2(yy+zz)   2(xy+wz)     2(xz-wy)   |
+	//  | 2(xy-wz)     1-2(xx+zz)   2(yz+wx)   |
+	//  | 2(xz+wy)     2(yz-wx)     1-2(xx+yy) |
+
+	assert(pMat != nullptr);
+
+	// multiplication by 2 is exact so the products are exactly 2*(q.i * q.j)
+	const float x2 = q.x + q.x;
+	const float y2 = q.y + q.y;
+	const float z2 = q.z + q.z;
+
+	const float xx = q.x * x2;
+	const float yy = q.y * y2;
+	const float zz = q.z * z2;
+	const float xy = q.x * y2;
+	const float xz = q.x * z2;
+	const float yz = q.y * z2;
+	const float wx = q.w * x2;
+	const float wy = q.w * y2;
+	const float wz = q.w * z2;
+
+	pMat->M00 = 1.0f - (yy + zz);
+	pMat->M01 = xy + wz;
+	pMat->M02 = xz - wy;
+
+	pMat->M10 = xy - wz;
+	pMat->M11 = 1.0f - (xx + zz);
+	pMat->M12 = yz + wx;
+
+	pMat->M20 = xz + wy;
+	pMat->M21 = yz - wx;
+	pMat->M22 = 1.0f - (xx + yy);
+
+} // end QUAT_To_MATRIX3X3
+
+///////////////////////////////////////////////////////////
+
+void QUAT_To_MATRIX4X4(const QUAT & q, MATRIX4X4* pMat)
+{
+	// this function computes a rotation matrix of the unit quaternion q;
+	// the translation is zero
+
+	assert(pMat != nullptr);
+
+	MATRIX3X3 m;
+	QUAT_To_MATRIX3X3(q, &m);
+
+	Mat_Init_4X4(pMat,
+		m.M00, m.M01, m.M02, 0.0f,
+		m.M10, m.M11, m.M12, 0.0f,
+		m.M20, m.M21, m.M22, 0.0f,
+		0.0f,  0.0f,  0.0f,  1.0f);
+
+} // end QUAT_To_MATRIX4X4
+
+///////////////////////////////////////////////////////////
+
+void MATRIX3X3_To_QUAT(const MATRIX3X3* pMat, QUAT & q)
+{
+	// this function computes a unit quaternion of the rotation matrix pMat
+
+	assert(pMat != nullptr);
+
+	Rotation_3X3_To_QUAT(
+		pMat->M00, pMat->M01, pMat->M02,
+		pMat->M10, pMat->M11, pMat->M12,
+		pMat->M20, pMat->M21, pMat->M22,
+		q);
+
+} // end MATRIX3X3_To_QUAT
+
+///////////////////////////////////////////////////////////
+
+void MATRIX4X4_To_QUAT(const MATRIX4X4* pMat, QUAT & q)
+{
+	// this function computes a unit quaternion of the rotation part of pMat
+
+	assert(pMat != nullptr);
+
+	Rotation_3X3_To_QUAT(
+		pMat->M00, pMat->M01, pMat->M02,
+		pMat->M10, pMat->M11, pMat->M12,
+		pMat->M20, pMat->M21, pMat->M22,
+		q);
+
+} // end MATRIX4X4_To_QUAT
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                        BATCH CONVERSION: QUAT => MATRIX4X4
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void QUAT_To_MATRIX4X4_Batch_Scalar(const QUAT_SOA & q, MATRIX4X4* pMats, const int num)
+{
+	// converts num quaternions into matrices using plain C++ code (reference kernel)
+
+	assert(q.w && q.x && q.y && q.z);
+	assert(pMats != nullptr);
+	assert(num >= 0);
+
+	for (int i = 0; i < num; i++)
+	{
+		QUAT_To_MATRIX4X4(QUAT(q.w[i], q.x[i], q.y[i], q.z[i]), pMats + i);
+	}
+
+} // end QUAT_To_MATRIX4X4_Batch_Scalar
+
+///////////////////////////////////////////////////////////
+
+#if MATHLIB_SIMD_X86
+
+MATHLIB_TARGET_SSE41
+static inline void Store_Rotation_4X4_SSE(MATRIX4X4* pMats,
+	__m128 m00, __m128 m01, __m128 m02,
+	__m128 m10, __m128 m11, __m128 m12,
+	__m128 m20, __m128 m21, __m128 m22)
+{
+	// stores 4 rotation matrices which elements are in SoA form: each input register
+	// contains the same element of 4 matrices, so we transpose them into rows
+
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 row3 = _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f);
+	__m128 w0 = zero;
+	__m128 w1 = zero;
+	__m128 w2 = zero;
+
+	_MM_TRANSPOSE4_PS(m00, m01, m02, w0);
+	_MM_TRANSPOSE4_PS(m10, m11, m12, w1);
+	_MM_TRANSPOSE4_PS(m20, m21, m22, w2);
+
+	_mm_storeu_ps(pMats[0].M[0], m00);
+	_mm_storeu_ps(pMats[0].M[1], m10);
+	_mm_storeu_ps(pMats[0].M[2], m20);
+	_mm_storeu_ps(pMats[0].M[3], row3);
+
+	_mm_storeu_ps(pMats[1].M[0], m01);
+	_mm_storeu_ps(pMats[1].M[1], m11);
+	_mm_storeu_ps(pMats[1].M[2], m21);
+	_mm_storeu_ps(pMats[1].M[3], row3);
+
+	_mm_storeu_ps(pMats[2].M[0], m02);
+	_mm_storeu_ps(pMats[2].M[1], m12);
+	_mm_storeu_ps(pMats[2].M[2], m22);
+	_mm_storeu_ps(pMats[2].M[3], row3);
+
+	_mm_storeu_ps(pMats[3].M[0], w0);
+	_mm_storeu_ps(pMats[3].M[1], w1);
+	_mm_storeu_ps(pMats[3].M[2], w2);
+	_mm_storeu_ps(pMats[3].M[3], row3);
+
+} // end Store_Rotation_4X4_SSE
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_SSE41
+void QUAT_To_MATRIX4X4_Batch_SSE(const QUAT_SOA & q, MATRIX4X4* pMats, const int num)
+{
+	// converts num quaternions into matrices; processes 4 quaternions per iteration;
+	// the tail (num % 4 quaternions) is processed by the scalar kernel
+
+	assert(q.w && q.x && q.y && q.z);
+	assert(pMats != nullptr);
+	assert(num >= 0);
+
+	const __m128 one = _mm_set1_ps(1.0f);
+
+	int i = 0;
+
+	for (; i + 4 <= num; i += 4)
+	{
+		const __m128 qw = _mm_loadu_ps(q.w + i);
+		const __m128 qx = _mm_loadu_ps(q.x + i);
+		const __m128 qy = _mm_loadu_ps(q.y + i);
+		const __m128 qz = _mm_loadu_ps(q.z + i);
+
+		const __m128 x2 = _mm_add_ps(qx, qx);
+		const __m128 y2 = _mm_add_ps(qy, qy);
+		const __m128 z2 = _mm_add_ps(qz, qz);
+
+		const __m128 xx = _mm_mul_ps(qx, x2);
+		const __m128 yy = _mm_mul_ps(qy, y2);
+		const __m128 zz = _mm_mul_ps(qz, z2);
+		const __m128 xy = _mm_mul_ps(qx, y2);
+		const __m128 xz = _mm_mul_ps(qx, z2);
+		const __m128 yz = _mm_mul_ps(qy, z2);
+		const __m128 wx = _mm_mul_ps(qw, x2);
+		const __m128 wy = _mm_mul_ps(qw, y2);
+		const __m128 wz = _mm_mul_ps(qw, z2);
+
+		Store_Rotation_4X4_SSE(pMats + i,
+			_mm_sub_ps(one, _mm_add_ps(yy, zz)), _mm_add_ps(xy, wz), _mm_sub_ps(xz, wy),
+			_mm_sub_ps(xy, wz), _mm_sub_ps(one, _mm_add_ps(xx, zz)), _mm_add_ps(yz, wx),
+			_mm_add_ps(xz, wy), _mm_sub_ps(yz, wx), _mm_sub_ps(one, _mm_add_ps(xx, yy)));
+	}
+
+	// process the rest of quaternions
+	if (i < num)
+	{
+		const QUAT_SOA rest = { q.w + i, q.x + i, q.y + i, q.z + i };
+
+		QUAT_To_MATRIX4X4_Batch_Scalar(rest, pMats + i, num - i);
+	}
+
+} // end QUAT_To_MATRIX4X4_Batch_SSE
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_AVX2
+void QUAT_To_MATRIX4X4_Batch_AVX2(const QUAT_SOA & q, MATRIX4X4* pMats, const int num)
+{
+	// converts num quaternions into matrices; processes 8 quaternions per iteration;
+	// the tail (num % 8 quaternions) is processed by the SSE kernel
+	//
+	// NOTE: FMA isn't used here on purpose (see the note in Simd.h)
+
+	assert(q.w && q.x && q.y && q.z);
+	assert(pMats != nullptr);
+	assert(num >= 0);
+
+	const __m256 one = _mm256_set1_ps(1.0f);
+
+	int i = 0;
+
+	for (; i + 8 <= num; i += 8)
+	{
+		const __m256 qw = _mm256_loadu_ps(q.w + i);
+		const __m256 qx = _mm256_loadu_ps(q.x + i);
+		const __m256 qy = _mm256_loadu_ps(q.y + i);
+		const __m256 qz = _mm256_loadu_ps(q.z + i);
+
+		const __m256 x2 = _mm256_add_ps(qx, qx);
+		const __m256 y2 = _mm256_add_ps(qy, qy);
+		const __m256 z2 = _mm256_add_ps(qz, qz);
+
+		const __m256 xx = _mm256_mul_ps(qx, x2);
+		const __m256 yy = _mm256_mul_ps(qy, y2);
+		const __m256 zz = _mm256_mul_ps(qz, z2);
+		const __m256 xy = _mm256_mul_ps(qx, y2);
+		const __m256 xz = _mm256_mul_ps(qx, z2);
+		const __m256 yz = _mm256_mul_ps(qy, z2);
+		const __m256 wx = _mm256_mul_ps(qw, x2);
+		const __m256 wy = _mm256_mul_ps(qw, y2);
+		const __m256 wz = _mm256_mul_ps(qw, z2);
+
+		__m256 m[9];
+
+		m[0] = _mm256_sub_ps(one, _mm256_add_ps(yy, zz));
+		m[1] = _mm256_add_ps(xy, wz);
+		m[2] = _mm256_sub_ps(xz, wy);
+
+		m[3] = _mm256_sub_ps(xy, wz);
+		m[4] = _mm256_sub_ps(one, _mm256_add_ps(xx, zz));
+		m[5] = _mm256_add_ps(yz, wx);
+
+		m[6] = _mm256_add_ps(xz, wy);
+		m[7] = _mm256_sub_ps(yz, wx);
+		m[8] = _mm256_sub_ps(one, _mm256_add_ps(xx, yy));
+
+		// the lower and the upper halves are 2 groups of 4 matrices
+		__m128 lo[9];
+		__m128 hi[9];
+
+		for (int k = 0; k < 9; k++)
+		{
+			lo[k] = _mm256_castps256_ps128(m[k]);
+			hi[k] = _mm256_extractf128_ps(m[k], 1);
+		}
+
+		Store_Rotation_4X4_SSE(pMats + i,
+			lo[0], lo[1], lo[2], lo[3], lo[4], lo[5], lo[6], lo[7], lo[8]);
+
+		Store_Rotation_4X4_SSE(pMats + i + 4,
+			hi[0], hi[1], hi[2], hi[3], hi[4], hi[5], hi[6], hi[7], hi[8]);
+	}
+
+	// process the rest of quaternions
+	if (i < num)
+	{
+		const QUAT_SOA rest = { q.w + i, q.x + i, q.y + i, q.z + i };
+
+		QUAT_To_MATRIX4X4_Batch_SSE(rest, pMats + i, num - i);
+	}
+
+} // end QUAT_To_MATRIX4X4_Batch_AVX2
+
+#else
+
+// there is no SIMD support for this platform so use the reference kernel
+
+void QUAT_To_MATRIX4X4_Batch_SSE(const QUAT_SOA & q, MATRIX4X4* pMats, const int num)
+{
+	QUAT_To_MATRIX4X4_Batch_Scalar(q, pMats, num);
+}
+
+void QUAT_To_MATRIX4X4_Batch_AVX2(const QUAT_SOA & q, MATRIX4X4* pMats, const int num)
+{
+	QUAT_To_MATRIX4X4_Batch_Scalar(q, pMats, num);
+}
+
+#endif // MATHLIB_SIMD_X86
+
+///////////////////////////////////////////////////////////
+
+void QUAT_To_MATRIX4X4_Batch(const QUAT_SOA & q, MATRIX4X4* pMats, const int num)
+{
+	// converts num quaternions into matrices using the best kernel for the current CPU
+
+	switch (SIMD_Get_Level())
+	{
+		case SIMD_LEVEL_AVX2:
+			QUAT_To_MATRIX4X4_Batch_AVX2(q, pMats, num);
+			break;
+
+		case SIMD_LEVEL_AVX:
+		case SIMD_LEVEL_SSE:
+			QUAT_To_MATRIX4X4_Batch_SSE(q, pMats, num);
+			break;
+
+		default:
+			QUAT_To_MATRIX4X4_Batch_Scalar(q, pMats, num);
+	}
+
+} // end QUAT_To_MATRIX4X4_Batch
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                        BATCH CONVERSION: MATRIX4X4 => QUAT
+////////////////////////////////////////////////////////////////////////////////////////////
+
+//
+// NOTE: the SIMD kernels can't branch per element so they compute the signs of the
+//       diagonal elements and choose the numerators for each component by masks;
+//       the values are exactly the same as in the branches of Rotation_3X3_To_QUAT
+//       (negation is exact, and sqrt/div are correctly rounded, so no rsqrt here)
+//
+
+void MATRIX4X4_To_QUAT_Batch_Scalar(const MATRIX4X4* pMats, const QUAT_SOA_OUT & q, const int num)
+{
+	// converts num matrices into quaternions using plain C++ code (reference kernel)
+
+	assert(pMats != nullptr);
+	assert(q.w && q.x && q.y && q.z);
+	assert(num >= 0);
+
+	QUAT qr;
+
+	for (int i = 0; i < num; i++)
+	{
+		MATRIX4X4_To_QUAT(pMats + i, qr);
+
+		q.w[i] = qr.w;
+		q.x[i] = qr.x;
+		q.y[i] = qr.y;
+		q.z[i] = qr.z;
+	}
+
+} // end MATRIX4X4_To_QUAT_Batch_Scalar
+
+///////////////////////////////////////////////////////////
+
+#if MATHLIB_SIMD_X86
+
+MATHLIB_TARGET_SSE41
+static inline void Load_Rotation_4X4_SSE(const MATRIX4X4* pMats, __m128 m[9])
+{
+	// loads the 3x3 parts of 4 matrices and transposes them into SoA form:
+	// m[3*row + col] contains the element [row][col] of 4 matrices
+
+	for (int row = 0; row < 3; row++)
+	{
+		__m128 r0 = _mm_loadu_ps(pMats[0].M[row]);
+		__m128 r1 = _mm_loadu_ps(pMats[1].M[row]);
+		__m128 r2 = _mm_loadu_ps(pMats[2].M[row]);
+		__m128 r3 = _mm_loadu_ps(pMats[3].M[row]);
+
+		_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+		m[3 * row + 0] = r0;
+		m[3 * row + 1] = r1;
+		m[3 * row + 2] = r2;
+	}
+
+} // end Load_Rotation_4X4_SSE
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_SSE41
+void MATRIX4X4_To_QUAT_Batch_SSE(const MATRIX4X4* pMats, const QUAT_SOA_OUT & q, const int num)
+{
+	// converts num matrices into quaternions; processes 4 matrices per iteration;
+	// the tail (num % 4 matrices) is processed by the scalar kernel
+
+	assert(pMats != nullptr);
+	assert(q.w && q.x && q.y && q.z);
+	assert(num >= 0);
+
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 half = _mm_set1_ps(0.5f);
+	const __m128 signMask = _mm_set1_ps(-0.0f);
+
+	int i = 0;
+
+	for (; i + 4 <= num; i += 4)
+	{
+		__m128 m[9];
+		Load_Rotation_4X4_SSE(pMats + i, m);
+
+		const __m128 m00 = m[0], m01 = m[1], m02 = m[2];
+		const __m128 m10 = m[3], m11 = m[4], m12 = m[5];
+		const __m128 m20 = m[6], m21 = m[7], m22 = m[8];
+
+		// choose the largest component (the same comparisons as in the scalar code)
+		const __m128 c22 = _mm_cmplt_ps(m22, zero);
+		const __m128 c01 = _mm_cmpgt_ps(m00, m11);
+		const __m128 cm  = _mm_cmplt_ps(m00, _mm_xor_ps(m11, signMask));
+
+		const __m128 isX = _mm_and_ps(c22, c01);
+		const __m128 isY = _mm_andnot_ps(c01, c22);
+		const __m128 isZ = _mm_andnot_ps(c22, cm);
+		const __m128 isW = _mm_andnot_ps(c22, _mm_andnot_ps(cm, _mm_castsi128_ps(_mm_set1_epi32(-1))));
+
+		// t = 1 +- m00 +- m11 +- m22
+		const __m128 flip00 = _mm_and_ps(_mm_or_ps(isY, isZ), signMask);
+		const __m128 flip11 = _mm_and_ps(_mm_or_ps(isX, isZ), signMask);
+		const __m128 flip22 = _mm_and_ps(c22, signMask);
+
+		__m128 t = _mm_add_ps(one, _mm_xor_ps(m00, flip00));
+		t = _mm_add_ps(t, _mm_xor_ps(m11, flip11));
+		t = _mm_add_ps(t, _mm_xor_ps(m22, flip22));
+
+		const __m128 s = _mm_div_ps(half, _mm_sqrt_ps(t));
+
+		const __m128 a = _mm_sub_ps(m12, m21);
+		const __m128 b = _mm_sub_ps(m20, m02);
+		const __m128 c = _mm_sub_ps(m01, m10);
+		const __m128 d = _mm_add_ps(m01, m10);
+		const __m128 e = _mm_add_ps(m02, m20);
+		const __m128 f = _mm_add_ps(m12, m21);
+
+		// numerators of the components for each case:
+		//   x: (a, t, d, e);  y: (b, d, t, f);  z: (c, e, f, t);  w: (t, a, b, c)
+		__m128 nw = _mm_blendv_ps(_mm_blendv_ps(_mm_blendv_ps(c, b, isY), a, isX), t, isW);
+		__m128 nx = _mm_blendv_ps(_mm_blendv_ps(_mm_blendv_ps(e, d, isY), t, isX), a, isW);
+		__m128 ny = _mm_blendv_ps(_mm_blendv_ps(_mm_blendv_ps(f, t, isY), d, isX), b, isW);
+		__m128 nz = _mm_blendv_ps(_mm_blendv_ps(_mm_blendv_ps(t, f, isY), e, isX), c, isW);
+
+		_mm_storeu_ps(q.w + i, _mm_mul_ps(nw, s));
+		_mm_storeu_ps(q.x + i, _mm_mul_ps(nx, s));
+		_mm_storeu_ps(q.y + i, _mm_mul_ps(ny, s));
+		_mm_storeu_ps(q.z + i, _mm_mul_ps(nz, s));
+	}
+
+	// process the rest of matrices
+	if (i < num)
+	{
+		const QUAT_SOA_OUT rest = { q.w + i, q.x + i, q.y + i, q.z + i };
+
+		MATRIX4X4_To_QUAT_Batch_Scalar(pMats + i, rest, num - i);
+	}
+
+} // end MATRIX4X4_To_QUAT_Batch_SSE
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_AVX2
+void MATRIX4X4_To_QUAT_Batch_AVX2(const MATRIX4X4* pMats, const QUAT_SOA_OUT & q, const int num)
+{
+	// converts num matrices into quaternions; processes 8 matrices per iteration;
+	// the tail (num % 8 matrices) is processed by the SSE kernel
+
+	assert(pMats != nullptr);
+	assert(q.w && q.x && q.y && q.z);
+	assert(num >= 0);
+
+	const __m256 zero = _mm256_setzero_ps();
+	const __m256 one = _mm256_set1_ps(1.0f);
+	const __m256 half = _mm256_set1_ps(0.5f);
+	const __m256 signMask = _mm256_set1_ps(-0.0f);
+	const __m256 allOnes = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+	int i = 0;
+
+	for (; i + 8 <= num; i += 8)
+	{
+		__m128 lo[9];
+		__m128 hi[9];
+		__m256 m[9];
+
+		Load_Rotation_4X4_SSE(pMats + i, lo);
+		Load_Rotation_4X4_SSE(pMats + i + 4, hi);
+
+		for (int k = 0; k < 9; k++)
+		{
+			m[k] = _mm256_insertf128_ps(_mm256_castps128_ps256(lo[k]), hi[k], 1);
+		}
+
+		const __m256 m00 = m[0], m01 = m[1], m02 = m[2];
+		const __m256 m10 = m[3], m11 = m[4], m12 = m[5];
+		const __m256 m20 = m[6], m21 = m[7], m22 = m[8];
+
+		// choose the largest component (the same comparisons as in the scalar code)
+		const __m256 c22 = _mm256_cmp_ps(m22, zero, _CMP_LT_OQ);
+		const __m256 c01 = _mm256_cmp_ps(m00, m11, _CMP_GT_OQ);
+		const __m256 cm  = _mm256_cmp_ps(m00, _mm256_xor_ps(m11, signMask), _CMP_LT_OQ);
+
+		const __m256 isX = _mm256_and_ps(c22, c01);
+		const __m256 isY = _mm256_andnot_ps(c01, c22);
+		const __m256 isZ = _mm256_andnot_ps(c22, cm);
+		const __m256 isW = _mm256_andnot_ps(c22, _mm256_andnot_ps(cm, allOnes));
+
+		// t = 1 +- m00 +- m11 +- m22
+		const __m256 flip00 = _mm256_and_ps(_mm256_or_ps(isY, isZ), signMask);
+		const __m256 flip11 = _mm256_and_ps(_mm256_or_ps(isX, isZ), signMask);
+		const __m256 flip22 = _mm256_and_ps(c22, signMask);
+
+		__m256 t = _mm256_add_ps(one, _mm256_xor_ps(m00, flip00));
+		t = _mm256_add_ps(t, _mm256_xor_ps(m11, flip11));
+		t = _mm256_add_ps(t, _mm256_xor_ps(m22, flip22));
+
+		const __m256 s = _mm256_div_ps(half, _mm256_sqrt_ps(t));
+
+		const __m256 a = _mm256_sub_ps(m12, m21);
+		const __m256 b = _mm256_sub_ps(m20, m02);
+		const __m256 c = _mm256_sub_ps(m01, m10);
+		const __m256 d = _mm256_add_ps(m01, m10);
+		const __m256 e = _mm256_add_ps(m02, m20);
+		const __m256 f = _mm256_add_ps(m12, m21);
+
+		// numerators of the components for each case:
+		//   x: (a, t, d, e);  y: (b, d, t, f);  z: (c, e, f, t);  w: (t, a, b, c)
+		__m256 nw = _mm256_blendv_ps(_mm256_blendv_ps(_mm256_blendv_ps(c, b, isY), a, isX), t, isW);
+		__m256 nx = _mm256_blendv_ps(_mm256_blendv_ps(_mm256_blendv_ps(e, d, isY), t, isX), a, isW);
+		__m256 ny = _mm256_blendv_ps(_mm256_blendv_ps(_mm256_blendv_ps(f, t, isY), d, isX), b, isW);
+		__m256 nz = _mm256_blendv_ps(_mm256_blendv_ps(_mm256_blendv_ps(t, f, isY), e, isX), c, isW);
+
+		_mm256_storeu_ps(q.w + i, _mm256_mul_ps(nw, s));
+		_mm256_storeu_ps(q.x + i, _mm256_mul_ps(nx, s));
+		_mm256_storeu_ps(q.y + i, _mm256_mul_ps(ny, s));
+		_mm256_storeu_ps(q.z + i, _mm256_mul_ps(nz, s));
+	}
+
+	// process the rest of matrices
+	if (i < num)
+	{
+		const QUAT_SOA_OUT rest = { q.w + i, q.x + i, q.y + i, q.z + i };
+
+		MATRIX4X4_To_QUAT_Batch_SSE(pMats + i, rest, num - i);
+	}
+
+} // end MATRIX4X4_To_QUAT_Batch_AVX2
+
+#else
+
+// there is no SIMD support for this platform so use the reference kernel
+
+void MATRIX4X4_To_QUAT_Batch_SSE(const MATRIX4X4* pMats, const QUAT_SOA_OUT & q, const int num)
+{
+	MATRIX4X4_To_QUAT_Batch_Scalar(pMats, q, num);
+}
+
+void MATRIX4X4_To_QUAT_Batch_AVX2(const MATRIX4X4* pMats, const QUAT_SOA_OUT & q, const int num)
+{
+	MATRIX4X4_To_QUAT_Batch_Scalar(pMats, q, num);
+}
+
+#endif // MATHLIB_SIMD_X86
+
+///////////////////////////////////////////////////////////
+
+void MATRIX4X4_To_QUAT_Batch(const MATRIX4X4* pMats, const QUAT_SOA_OUT & q, const int num)
+{
+	// converts num matrices into quaternions using the best kernel for the current CPU
+
+	switch (SIMD_Get_Level())
+	{
+		case SIMD_LEVEL_AVX2:
+			MATRIX4X4_To_QUAT_Batch_AVX2(pMats, q, num);
+			break;
+
+		case SIMD_LEVEL_AVX:
+		case SIMD_LEVEL_SSE:
+			MATRIX4X4_To_QUAT_Batch_SSE(pMats, q, num);
+			break;
+
+		default:
+			MATRIX4X4_To_QUAT_Batch_Scalar(pMats, q, num);
+	}
+
+} // end MATRIX4X4_To_QUAT_Batch
+
+} // end namespace MathLib
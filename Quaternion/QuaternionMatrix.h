@@ -0,0 +1,62 @@
+////////////////////////////////////////////////////////////////////////////////////////////
+// Filename:      QuaternionMatrix.h
+// Description:   contains functional for conversion between quaternions and
+//                rotation matrices (MATRIX3X3 / MATRIX4X4), both for single
+//                quaternions and for arrays of them (e.g. joints of a skeleton)
+//
+// Created:       17.10.26
+////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "QuaternionBatch.h"
+#include "../Matrix/Matrix.h"
+
+
+namespace MathLib
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                            FUNCTIONS PROTOTYPES
+////////////////////////////////////////////////////////////////////////////////////////////
+
+//
+// NOTE: the matrices are used with row vectors (v' = v * M) as everywhere in the library,
+//       so the rotation by the matrix is the same as QUAT_Rotate_VECTOR3D(q, v, v')
+//
+
+// unit quaternion => rotation matrix (for 4x4 the translation is zero and M33 == 1)
+void QUAT_To_MATRIX3X3(const QUAT & q, MATRIX3X3* pMat);
+void QUAT_To_MATRIX4X4(const QUAT & q, MATRIX4X4* pMat);
+
+// rotation matrix => unit quaternion (for 4x4 only the upper 3x3 part is used);
+// the matrix must be orthonormal (it isn't checked)
+void MATRIX3X3_To_QUAT(const MATRIX3X3* pMat, QUAT & q);
+void MATRIX4X4_To_QUAT(const MATRIX4X4* pMat, QUAT & q);
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                        BATCH CONVERSION OF QUATERNIONS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+//
+// each function converts num quaternions (stored in SoA form) into num matrices
+// or vice versa; the results are bit-compatible with QUAT_To_MATRIX4X4 and
+// MATRIX4X4_To_QUAT for each kernel
+//
+
+// chooses the best kernel for the current CPU (see SIMD_Get_Level)
+void QUAT_To_MATRIX4X4_Batch(const QUAT_SOA & q, MATRIX4X4* pMats, const int num);
+void MATRIX4X4_To_QUAT_Batch(const MATRIX4X4* pMats, const QUAT_SOA_OUT & q, const int num);
+
+// separate kernels (SSE/AVX2 kernels must be called only if the CPU supports them)
+void QUAT_To_MATRIX4X4_Batch_Scalar(const QUAT_SOA & q, MATRIX4X4* pMats, const int num);
+void QUAT_To_MATRIX4X4_Batch_SSE   (const QUAT_SOA & q, MATRIX4X4* pMats, const int num);
+void QUAT_To_MATRIX4X4_Batch_AVX2  (const QUAT_SOA & q, MATRIX4X4* pMats, const int num);
+
+void MATRIX4X4_To_QUAT_Batch_Scalar(const MATRIX4X4* pMats, const QUAT_SOA_OUT & q, const int num);
+void MATRIX4X4_To_QUAT_Batch_SSE   (const MATRIX4X4* pMats, const QUAT_SOA_OUT & q, const int num);
+void MATRIX4X4_To_QUAT_Batch_AVX2  (const MATRIX4X4* pMats, const QUAT_SOA_OUT & q, const int num);
+
+} // end namespace MathLib
@@ -0,0 +1,1142 @@
+////////////////////////////////////////////////////////////////////////////////////////////
+// Filename:      QuaternionPacked.cpp
+// Description:   contains implementation of the "smallest three" packing of quaternions
+//                (scalar, SSE and AVX2 kernels + runtime dispatching)
+//
+// Created:       17.10.26
+////////////////////////////////////////////////////////////////////////////////////////////
+#include "QuaternionPacked.h"
+#include "../Utils/Simd.h"
+
+#include <cstring>
+
+
+namespace MathLib
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                          QUANTIZATION OF THE COMPONENTS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+// the range of the packed components: [-1/sqrt(2), 1/sqrt(2)]
+static constexpr float QUAT_PACK_RANGE = 0.707106781f;
+
+// parameters of the quantization of a packed format (the max quantized value is
+// even, so zero is the middle value and is restored exactly)
+typedef struct QUAT_QUANT_TYPE
+{
+	int   bits;     // bits per component
+	float maxQ;     // max quantized value (2^bits - 2)
+	float scale;    // component => quantized value
+	float step;     // quantized value => component
+} QUAT_QUANT;
+
+static constexpr QUAT_QUANT QUAT_QUANT_32 = { 10, 1022.0f,    1022.0f / (2.0f * QUAT_PACK_RANGE),    (2.0f * QUAT_PACK_RANGE) / 1022.0f };
+static constexpr QUAT_QUANT QUAT_QUANT_48 = { 15, 32766.0f,   32766.0f / (2.0f * QUAT_PACK_RANGE),   (2.0f * QUAT_PACK_RANGE) / 32766.0f };
+static constexpr QUAT_QUANT QUAT_QUANT_64 = { 20, 1048574.0f, 1048574.0f / (2.0f * QUAT_PACK_RANGE), (2.0f * QUAT_PACK_RANGE) / 1048574.0f };
+
+///////////////////////////////////////////////////////////
+
+//
+// NOTE: the SIMD kernels are the branchless forms of these two functions: the same
+//       float operations in the same order (max/min are written the same way as
+//       _mm_max_ps/_mm_min_ps), so all the kernels give the same bits
+//
+
+static uint64_t QUAT_Pack_Bits(const float w, const float x, const float y, const float z,
+	const QUAT_QUANT & qq)
+{
+	// this function packs the quaternion into (index << 3*bits) | (f0 << 2*bits) | (f1 << bits) | f2
+
+	const float c[4] = { w, x, y, z };
+
+	const float a0 = fabsf(w);
+	const float a1 = fabsf(x);
+	const float a2 = fabsf(y);
+	const float a3 = fabsf(z);
+
+	const float m01 = (a0 > a1) ? a0 : a1;
+	const float m23 = (a2 > a3) ? a2 : a3;
+	const float m   = (m01 > m23) ? m01 : m23;
+
+	// the first component with the largest modulus is dropped
+	const int index = (a0 == m) ? 0 : (a1 == m) ? 1 : (a2 == m) ? 2 : 3;
+
+	// the dropped component must be positive so negate the quaternion if it isn't
+	const bool negate = std::signbit(c[index]);
+
+	uint64_t res = (uint64_t)index;
+
+	for (int k = 0; k < 3; k++)
+	{
+		const float src = c[(k < index) ? k : k + 1];
+		const float v = negate ? -src : src;
+
+		float t = (v + QUAT_PACK_RANGE) * qq.scale + 0.5f;
+		t = (t > 0.0f) ? t : 0.0f;
+		t = (t < qq.maxQ) ? t : qq.maxQ;
+
+		res = (res << qq.bits) | (uint64_t)(int)t;
+	}
+
+	return res;
+
+} // end QUAT_Pack_Bits
+
+///////////////////////////////////////////////////////////
+
+static void QUAT_Unpack_Bits(const uint64_t bits, const QUAT_QUANT & qq,
+	float & w, float & x, float & y, float & z)
+{
+	// this function unpacks the quaternion packed by QUAT_Pack_Bits
+
+	const uint64_t mask = (1ull << qq.bits) - 1;
+	const int index = (int)(bits >> (3 * qq.bits)) & 3;
+
+	float v[3];
+
+	for (int k = 0; k < 3; k++)
+	{
+		const int f = (int)((bits >> ((2 - k) * qq.bits)) & mask);
+		v[k] = (float)f * qq.step - QUAT_PACK_RANGE;
+	}
+
+	// restore the dropped component from the unit length
+	float sum = v[0] * v[0] + v[1] * v[1];
+	sum = sum + v[2] * v[2];
+
+	float l = 1.0f - sum;
+	l = (l > 0.0f) ? l : 0.0f;
+
+	float c[4];
+
+	for (int k = 0; k < 4; k++)
+		c[k] = (k == index) ? sqrtf(l) : v[(k < index) ? k : k - 1];
+
+	w = c[0];
+	x = c[1];
+	y = c[2];
+	z = c[3];
+
+} // end QUAT_Unpack_Bits
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                          PACKING OF SINGLE QUATERNIONS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void QUAT_Pack(const QUAT & q, QUAT_PACKED32 & qp)
+{
+	qp.bits = (uint32_t)QUAT_Pack_Bits(q.w, q.x, q.y, q.z, QUAT_QUANT_32);
+}
+
+void QUAT_Pack(const QUAT & q, QUAT_PACKED48 & qp)
+{
+	const uint64_t bits = QUAT_Pack_Bits(q.w, q.x, q.y, q.z, QUAT_QUANT_48);
+
+	qp.M[0] = (uint16_t)bits;
+	qp.M[1] = (uint16_t)(bits >> 16);
+	qp.M[2] = (uint16_t)(bits >> 32);
+}
+
+void QUAT_Pack(const QUAT & q, QUAT_PACKED64 & qp)
+{
+	qp.bits = QUAT_Pack_Bits(q.w, q.x, q.y, q.z, QUAT_QUANT_64);
+}
+
+///////////////////////////////////////////////////////////
+
+void QUAT_Unpack(const QUAT_PACKED32 & qp, QUAT & q)
+{
+	QUAT_Unpack_Bits(qp.bits, QUAT_QUANT_32, q.w, q.x, q.y, q.z);
+}
+
+void QUAT_Unpack(const QUAT_PACKED48 & qp, QUAT & q)
+{
+	const uint64_t bits = (uint64_t)qp.M[0] | ((uint64_t)qp.M[1] << 16) | ((uint64_t)qp.M[2] << 32);
+
+	QUAT_Unpack_Bits(bits, QUAT_QUANT_48, q.w, q.x, q.y, q.z);
+}
+
+void QUAT_Unpack(const QUAT_PACKED64 & qp, QUAT & q)
+{
+	QUAT_Unpack_Bits(qp.bits, QUAT_QUANT_64, q.w, q.x, q.y, q.z);
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                             SCALAR (REFERENCE) KERNELS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void QUAT_Pack_Batch_Scalar(const QUAT_SOA & qIn, QUAT_PACKED32* out, const int num)
+{
+	// packs num quaternions into 32 bits using plain C++ code (reference kernel)
+
+	assert(qIn.w && qIn.x && qIn.y && qIn.z);
+	assert(out != nullptr);
+	assert(num >= 0);
+
+	for (int i = 0; i < num; i++)
+		QUAT_Pack(QUAT(qIn.w[i], qIn.x[i], qIn.y[i], qIn.z[i]), out[i]);
+
+} // end QUAT_Pack_Batch_Scalar (32 bits)
+
+void QUAT_Pack_Batch_Scalar(const QUAT_SOA & qIn, QUAT_PACKED48* out, const int num)
+{
+	// packs num quaternions into 48 bits using plain C++ code (reference kernel)
+
+	assert(qIn.w && qIn.x && qIn.y && qIn.z);
+	assert(out != nullptr);
+	assert(num >= 0);
+
+	for (int i = 0; i < num; i++)
+		QUAT_Pack(QUAT(qIn.w[i], qIn.x[i], qIn.y[i], qIn.z[i]), out[i]);
+
+} // end QUAT_Pack_Batch_Scalar (48 bits)
+
+void QUAT_Pack_Batch_Scalar(const QUAT_SOA & qIn, QUAT_PACKED64* out, const int num)
+{
+	// packs num quaternions into 64 bits using plain C++ code (reference kernel)
+
+	assert(qIn.w && qIn.x && qIn.y && qIn.z);
+	assert(out != nullptr);
+	assert(num >= 0);
+
+	for (int i = 0; i < num; i++)
+		QUAT_Pack(QUAT(qIn.w[i], qIn.x[i], qIn.y[i], qIn.z[i]), out[i]);
+
+} // end QUAT_Pack_Batch_Scalar (64 bits)
+
+///////////////////////////////////////////////////////////
+
+void QUAT_Unpack_Batch_Scalar(const QUAT_PACKED32* in, const QUAT_SOA_OUT & qOut, const int num)
+{
+	// unpacks num 32-bit quaternions using plain C++ code (reference kernel)
+
+	assert(in != nullptr);
+	assert(qOut.w && qOut.x && qOut.y && qOut.z);
+	assert(num >= 0);
+
+	for (int i = 0; i < num; i++)
+		QUAT_Unpack_Bits(in[i].bits, QUAT_QUANT_32, qOut.w[i], qOut.x[i], qOut.y[i], qOut.z[i]);
+
+} // end QUAT_Unpack_Batch_Scalar (32 bits)
+
+void QUAT_Unpack_Batch_Scalar(const QUAT_PACKED48* in, const QUAT_SOA_OUT & qOut, const int num)
+{
+	// unpacks num 48-bit quaternions using plain C++ code (reference kernel)
+
+	assert(in != nullptr);
+	assert(qOut.w && qOut.x && qOut.y && qOut.z);
+	assert(num >= 0);
+
+	for (int i = 0; i < num; i++)
+	{
+		QUAT q;
+
+		QUAT_Unpack(in[i], q);
+
+		qOut.w[i] = q.w;
+		qOut.x[i] = q.x;
+		qOut.y[i] = q.y;
+		qOut.z[i] = q.z;
+	}
+
+} // end QUAT_Unpack_Batch_Scalar (48 bits)
+
+void QUAT_Unpack_Batch_Scalar(const QUAT_PACKED64* in, const QUAT_SOA_OUT & qOut, const int num)
+{
+	// unpacks num 64-bit quaternions using plain C++ code (reference kernel)
+
+	assert(in != nullptr);
+	assert(qOut.w && qOut.x && qOut.y && qOut.z);
+	assert(num >= 0);
+
+	for (int i = 0; i < num; i++)
+		QUAT_Unpack_Bits(in[i].bits, QUAT_QUANT_64, qOut.w[i], qOut.x[i], qOut.y[i], qOut.z[i]);
+
+} // end QUAT_Unpack_Batch_Scalar (64 bits)
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                  SIMD KERNELS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+#if MATHLIB_SIMD_X86
+
+// helpers for the tails: the SoA streams shifted by i quaternions
+static inline QUAT_SOA QUAT_SOA_Offset(const QUAT_SOA & q, const int i)
+{
+	const QUAT_SOA res = { q.w + i, q.x + i, q.y + i, q.z + i };
+	return res;
+}
+
+static inline QUAT_SOA_OUT QUAT_SOA_Offset(const QUAT_SOA_OUT & q, const int i)
+{
+	const QUAT_SOA_OUT res = { q.w + i, q.x + i, q.y + i, q.z + i };
+	return res;
+}
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_SSE41
+static inline void QUAT_Quantize_SSE(const __m128 w, const __m128 x, const __m128 y, const __m128 z,
+	const QUAT_QUANT & qq,
+	__m128i & index, __m128i f[3])
+{
+	// branchless QUAT_Pack_Bits for 4 quaternions: the index and the quantized components
+
+	const __m128 signMask = _mm_set1_ps(-0.0f);
+	const __m128 zero     = _mm_setzero_ps();
+
+	const __m128 a0 = _mm_andnot_ps(signMask, w);
+	const __m128 a1 = _mm_andnot_ps(signMask, x);
+	const __m128 a2 = _mm_andnot_ps(signMask, y);
+	const __m128 a3 = _mm_andnot_ps(signMask, z);
+	const __m128 m  = _mm_max_ps(_mm_max_ps(a0, a1), _mm_max_ps(a2, a3));
+
+	// the first component with the largest modulus
+	index = _mm_set1_epi32(3);
+	index = _mm_blendv_epi8(index, _mm_set1_epi32(2), _mm_castps_si128(_mm_cmpeq_ps(a2, m)));
+	index = _mm_blendv_epi8(index, _mm_set1_epi32(1), _mm_castps_si128(_mm_cmpeq_ps(a1, m)));
+	index = _mm_blendv_epi8(index, _mm_setzero_si128(), _mm_castps_si128(_mm_cmpeq_ps(a0, m)));
+
+	const __m128 is0 = _mm_castsi128_ps(_mm_cmpeq_epi32(index, _mm_setzero_si128()));
+	const __m128 is1 = _mm_castsi128_ps(_mm_cmpeq_epi32(index, _mm_set1_epi32(1)));
+	const __m128 is2 = _mm_castsi128_ps(_mm_cmpeq_epi32(index, _mm_set1_epi32(2)));
+	const __m128 le1 = _mm_or_ps(is0, is1);
+	const __m128 le2 = _mm_or_ps(le1, is2);
+
+	// the sign of the dropped component
+	const __m128 dropped = _mm_blendv_ps(_mm_blendv_ps(_mm_blendv_ps(z, y, is2), x, is1), w, is0);
+	const __m128 sign = _mm_and_ps(dropped, signMask);
+
+	const __m128 src[3] = {
+		_mm_blendv_ps(w, x, is0),
+		_mm_blendv_ps(x, y, le1),
+		_mm_blendv_ps(y, z, le2)
+	};
+
+	const __m128 range = _mm_set1_ps(QUAT_PACK_RANGE);
+	const __m128 scale = _mm_set1_ps(qq.scale);
+	const __m128 maxQ  = _mm_set1_ps(qq.maxQ);
+	const __m128 half  = _mm_set1_ps(0.5f);
+
+	for (int k = 0; k < 3; k++)
+	{
+		const __m128 v = _mm_xor_ps(src[k], sign);
+
+		__m128 t = _mm_add_ps(_mm_mul_ps(_mm_add_ps(v, range), scale), half);
+		t = _mm_max_ps(t, zero);
+		t = _mm_min_ps(t, maxQ);
+
+		f[k] = _mm_cvttps_epi32(t);
+	}
+}
+
+MATHLIB_TARGET_SSE41
+static inline void QUAT_Dequantize_SSE(const __m128i index, const __m128i f[3],
+	const QUAT_QUANT & qq,
+	float* wOut, float* xOut, float* yOut, float* zOut)
+{
+	// branchless QUAT_Unpack_Bits for 4 quaternions (the fields are already separated)
+
+	const __m128 range = _mm_set1_ps(QUAT_PACK_RANGE);
+	const __m128 step  = _mm_set1_ps(qq.step);
+
+	const __m128 v0 = _mm_sub_ps(_mm_mul_ps(_mm_cvtepi32_ps(f[0]), step), range);
+	const __m128 v1 = _mm_sub_ps(_mm_mul_ps(_mm_cvtepi32_ps(f[1]), step), range);
+	const __m128 v2 = _mm_sub_ps(_mm_mul_ps(_mm_cvtepi32_ps(f[2]), step), range);
+
+	__m128 sum = _mm_add_ps(_mm_mul_ps(v0, v0), _mm_mul_ps(v1, v1));
+	sum = _mm_add_ps(sum, _mm_mul_ps(v2, v2));
+
+	const __m128 l = _mm_sqrt_ps(_mm_max_ps(_mm_sub_ps(_mm_set1_ps(1.0f), sum), _mm_setzero_ps()));
+
+	const __m128 is0 = _mm_castsi128_ps(_mm_cmpeq_epi32(index, _mm_setzero_si128()));
+	const __m128 is1 = _mm_castsi128_ps(_mm_cmpeq_epi32(index, _mm_set1_epi32(1)));
+	const __m128 is2 = _mm_castsi128_ps(_mm_cmpeq_epi32(index, _mm_set1_epi32(2)));
+	const __m128 is3 = _mm_castsi128_ps(_mm_cmpeq_epi32(index, _mm_set1_epi32(3)));
+	const __m128 le1 = _mm_or_ps(is0, is1);
+
+	_mm_storeu_ps(wOut, _mm_blendv_ps(v0, l, is0));
+	_mm_storeu_ps(xOut, _mm_blendv_ps(_mm_blendv_ps(v1, l, is1), v0, is0));
+	_mm_storeu_ps(yOut, _mm_blendv_ps(_mm_blendv_ps(v2, l, is2), v1, le1));
+	_mm_storeu_ps(zOut, _mm_blendv_ps(v2, l, is3));
+}
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_AVX2
+static inline void QUAT_Quantize_AVX2(const __m256 w, const __m256 x, const __m256 y, const __m256 z,
+	const QUAT_QUANT & qq,
+	__m256i & index, __m256i f[3])
+{
+	// branchless QUAT_Pack_Bits for 8 quaternions: the index and the quantized components
+
+	const __m256 signMask = _mm256_set1_ps(-0.0f);
+	const __m256 zero     = _mm256_setzero_ps();
+
+	const __m256 a0 = _mm256_andnot_ps(signMask, w);
+	const __m256 a1 = _mm256_andnot_ps(signMask, x);
+	const __m256 a2 = _mm256_andnot_ps(signMask, y);
+	const __m256 a3 = _mm256_andnot_ps(signMask, z);
+	const __m256 m  = _mm256_max_ps(_mm256_max_ps(a0, a1), _mm256_max_ps(a2, a3));
+
+	// the first component with the largest modulus
+	index = _mm256_set1_epi32(3);
+	index = _mm256_blendv_epi8(index, _mm256_set1_epi32(2), _mm256_castps_si256(_mm256_cmp_ps(a2, m, _CMP_EQ_OQ)));
+	index = _mm256_blendv_epi8(index, _mm256_set1_epi32(1), _mm256_castps_si256(_mm256_cmp_ps(a1, m, _CMP_EQ_OQ)));
+	index = _mm256_blendv_epi8(index, _mm256_setzero_si256(), _mm256_castps_si256(_mm256_cmp_ps(a0, m, _CMP_EQ_OQ)));
+
+	const __m256 is0 = _mm256_castsi256_ps(_mm256_cmpeq_epi32(index, _mm256_setzero_si256()));
+	const __m256 is1 = _mm256_castsi256_ps(_mm256_cmpeq_epi32(index, _mm256_set1_epi32(1)));
+	const __m256 is2 = _mm256_castsi256_ps(_mm256_cmpeq_epi32(index, _mm256_set1_epi32(2)));
+	const __m256 le1 = _mm256_or_ps(is0, is1);
+	const __m256 le2 = _mm256_or_ps(le1, is2);
+
+	// the sign of the dropped component
+	const __m256 dropped = _mm256_blendv_ps(_mm256_blendv_ps(_mm256_blendv_ps(z, y, is2), x, is1), w, is0);
+	const __m256 sign = _mm256_and_ps(dropped, signMask);
+
+	const __m256 src[3] = {
+		_mm256_blendv_ps(w, x, is0),
+		_mm256_blendv_ps(x, y, le1),
+		_mm256_blendv_ps(y, z, le2)
+	};
+
+	const __m256 range = _mm256_set1_ps(QUAT_PACK_RANGE);
+	const __m256 scale = _mm256_set1_ps(qq.scale);
+	const __m256 maxQ  = _mm256_set1_ps(qq.maxQ);
+	const __m256 half  = _mm256_set1_ps(0.5f);
+
+	for (int k = 0; k < 3; k++)
+	{
+		const __m256 v = _mm256_xor_ps(src[k], sign);
+
+		__m256 t = _mm256_add_ps(_mm256_mul_ps(_mm256_add_ps(v, range), scale), half);
+		t = _mm256_max_ps(t, zero);
+		t = _mm256_min_ps(t, maxQ);
+
+		f[k] = _mm256_cvttps_epi32(t);
+	}
+}
+
+MATHLIB_TARGET_AVX2
+static inline void QUAT_Dequantize_AVX2(const __m256i index, const __m256i f[3],
+	const QUAT_QUANT & qq,
+	float* wOut, float* xOut, float* yOut, float* zOut)
+{
+	// branchless QUAT_Unpack_Bits for 8 quaternions (the fields are already separated)
+
+	const __m256 range = _mm256_set1_ps(QUAT_PACK_RANGE);
+	const __m256 step  = _mm256_set1_ps(qq.step);
+
+	const __m256 v0 = _mm256_sub_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(f[0]), step), range);
+	const __m256 v1 = _mm256_sub_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(f[1]), step), range);
+	const __m256 v2 = _mm256_sub_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(f[2]), step), range);
+
+	__m256 sum = _mm256_add_ps(_mm256_mul_ps(v0, v0), _mm256_mul_ps(v1, v1));
+	sum = _mm256_add_ps(sum, _mm256_mul_ps(v2, v2));
+
+	const __m256 l = _mm256_sqrt_ps(_mm256_max_ps(_mm256_sub_ps(_mm256_set1_ps(1.0f), sum), _mm256_setzero_ps()));
+
+	const __m256 is0 = _mm256_castsi256_ps(_mm256_cmpeq_epi32(index, _mm256_setzero_si256()));
+	const __m256 is1 = _mm256_castsi256_ps(_mm256_cmpeq_epi32(index, _mm256_set1_epi32(1)));
+	const __m256 is2 = _mm256_castsi256_ps(_mm256_cmpeq_epi32(index, _mm256_set1_epi32(2)));
+	const __m256 is3 = _mm256_castsi256_ps(_mm256_cmpeq_epi32(index, _mm256_set1_epi32(3)));
+	const __m256 le1 = _mm256_or_ps(is0, is1);
+
+	_mm256_storeu_ps(wOut, _mm256_blendv_ps(v0, l, is0));
+	_mm256_storeu_ps(xOut, _mm256_blendv_ps(_mm256_blendv_ps(v1, l, is1), v0, is0));
+	_mm256_storeu_ps(yOut, _mm256_blendv_ps(_mm256_blendv_ps(v2, l, is2), v1, le1));
+	_mm256_storeu_ps(zOut, _mm256_blendv_ps(v2, l, is3));
+}
+
+///////////////////////////////////////////////////////////
+
+//
+// 48/64-bit formats: the fields are combined in 64-bit lanes; the 48-bit values
+// are the low 6 bytes of 64-bit values (x86 is little-endian)
+//
+
+MATHLIB_TARGET_SSE41
+static inline __m128i Combine2_U64_SSE(const __m128i index, const __m128i f[3], const int bits)
+{
+	// combines the fields of the 2 low 32-bit lanes into 2 64-bit values
+
+	__m128i res = _mm_slli_epi64(_mm_cvtepu32_epi64(index), 3 * bits);
+	res = _mm_or_si128(res, _mm_slli_epi64(_mm_cvtepu32_epi64(f[0]), 2 * bits));
+	res = _mm_or_si128(res, _mm_slli_epi64(_mm_cvtepu32_epi64(f[1]), bits));
+
+	return _mm_or_si128(res, _mm_cvtepu32_epi64(f[2]));
+}
+
+MATHLIB_TARGET_SSE41
+static inline void Combine4_U64_SSE(const __m128i index, const __m128i f[3], const int bits,
+	__m128i & lo, __m128i & hi)
+{
+	// combines the fields of 4 32-bit lanes into 4 64-bit values
+
+	const __m128i fHi[3] = { _mm_srli_si128(f[0], 8), _mm_srli_si128(f[1], 8), _mm_srli_si128(f[2], 8) };
+
+	lo = Combine2_U64_SSE(index, f, bits);
+	hi = Combine2_U64_SSE(_mm_srli_si128(index, 8), fHi, bits);
+}
+
+MATHLIB_TARGET_SSE41
+static inline __m128i Narrow4_U64_SSE(const __m128i lo, const __m128i hi)
+{
+	// takes the low 32 bits of 4 64-bit values
+	return _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(lo), _mm_castsi128_ps(hi), _MM_SHUFFLE(2, 0, 2, 0)));
+}
+
+MATHLIB_TARGET_SSE41
+static inline void Split4_U64_SSE(const __m128i lo, const __m128i hi, const int bits,
+	__m128i & index, __m128i f[3])
+{
+	// separates the fields of 4 64-bit values into 32-bit lanes
+
+	const __m128i mask = _mm_set1_epi64x((1ll << bits) - 1);
+
+	index = Narrow4_U64_SSE(_mm_srli_epi64(lo, 3 * bits), _mm_srli_epi64(hi, 3 * bits));
+
+	for (int k = 0; k < 3; k++)
+	{
+		const int shift = (2 - k) * bits;
+
+		f[k] = Narrow4_U64_SSE(_mm_and_si128(_mm_srli_epi64(lo, shift), mask),
+		                       _mm_and_si128(_mm_srli_epi64(hi, shift), mask));
+	}
+
+	index = _mm_and_si128(index, _mm_set1_epi32(3));
+}
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_AVX2
+static inline __m256i Combine4_U64_AVX2(const __m128i index, const __m128i f0, const __m128i f1, const __m128i f2,
+	const int bits)
+{
+	// combines the fields of 4 32-bit lanes into 4 64-bit values
+
+	__m256i res = _mm256_slli_epi64(_mm256_cvtepu32_epi64(index), 3 * bits);
+	res = _mm256_or_si256(res, _mm256_slli_epi64(_mm256_cvtepu32_epi64(f0), 2 * bits));
+	res = _mm256_or_si256(res, _mm256_slli_epi64(_mm256_cvtepu32_epi64(f1), bits));
+
+	return _mm256_or_si256(res, _mm256_cvtepu32_epi64(f2));
+}
+
+MATHLIB_TARGET_AVX2
+static inline void Combine8_U64_AVX2(const __m256i index, const __m256i f[3], const int bits,
+	__m256i & lo, __m256i & hi)
+{
+	// combines the fields of 8 32-bit lanes into 8 64-bit values
+
+	lo = Combine4_U64_AVX2(_mm256_castsi256_si128(index),
+		_mm256_castsi256_si128(f[0]), _mm256_castsi256_si128(f[1]), _mm256_castsi256_si128(f[2]), bits);
+
+	hi = Combine4_U64_AVX2(_mm256_extracti128_si256(index, 1),
+		_mm256_extracti128_si256(f[0], 1), _mm256_extracti128_si256(f[1], 1), _mm256_extracti128_si256(f[2], 1), bits);
+}
+
+MATHLIB_TARGET_AVX2
+static inline __m256i Narrow8_U64_AVX2(const __m256i lo, const __m256i hi)
+{
+	// takes the low 32 bits of 8 64-bit values (the shuffle works in 128-bit halves
+	// so the order of 64-bit parts is restored by the permutation)
+
+	const __m256 s = _mm256_shuffle_ps(_mm256_castsi256_ps(lo), _mm256_castsi256_ps(hi), _MM_SHUFFLE(2, 0, 2, 0));
+	return _mm256_permute4x64_epi64(_mm256_castps_si256(s), _MM_SHUFFLE(3, 1, 2, 0));
+}
+
+MATHLIB_TARGET_AVX2
+static inline void Split8_U64_AVX2(const __m256i lo, const __m256i hi, const int bits,
+	__m256i & index, __m256i f[3])
+{
+	// separates the fields of 8 64-bit values into 32-bit lanes
+
+	const __m256i mask = _mm256_set1_epi64x((1ll << bits) - 1);
+
+	index = Narrow8_U64_AVX2(_mm256_srli_epi64(lo, 3 * bits), _mm256_srli_epi64(hi, 3 * bits));
+
+	for (int k = 0; k < 3; k++)
+	{
+		const int shift = (2 - k) * bits;
+
+		f[k] = Narrow8_U64_AVX2(_mm256_and_si256(_mm256_srli_epi64(lo, shift), mask),
+		                        _mm256_and_si256(_mm256_srli_epi64(hi, shift), mask));
+	}
+
+	index = _mm256_and_si256(index, _mm256_set1_epi32(3));
+}
+
+///////////////////////////////////////////////////////////
+
+// stores/loads of 48-bit values (the low 6 bytes of 64-bit values)
+
+static inline void Store_U48(QUAT_PACKED48* out, const uint64_t* bits, const int num)
+{
+	for (int k = 0; k < num; k++)
+		memcpy(out[k].M, bits + k, sizeof(QUAT_PACKED48));
+}
+
+static inline void Load_U48(const QUAT_PACKED48* in, uint64_t* bits, const int num)
+{
+	for (int k = 0; k < num; k++)
+	{
+		bits[k] = 0;
+		memcpy(bits + k, in[k].M, sizeof(QUAT_PACKED48));
+	}
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                   SSE KERNELS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+//
+// each kernel processes 4 quaternions per iteration;
+// the tail (num % 4 quaternions) is processed by the scalar kernel
+//
+
+MATHLIB_TARGET_SSE41
+void QUAT_Pack_Batch_SSE(const QUAT_SOA & qIn, QUAT_PACKED32* out, const int num)
+{
+	assert(qIn.w && qIn.x && qIn.y && qIn.z);
+	assert(out != nullptr);
+	assert(num >= 0);
+
+	const int bits = QUAT_QUANT_32.bits;
+	int i = 0;
+
+	for (; i + 4 <= num; i += 4)
+	{
+		__m128i index, f[3];
+
+		QUAT_Quantize_SSE(_mm_loadu_ps(qIn.w + i), _mm_loadu_ps(qIn.x + i),
+			_mm_loadu_ps(qIn.y + i), _mm_loadu_ps(qIn.z + i), QUAT_QUANT_32, index, f);
+
+		__m128i res = _mm_slli_epi32(index, 3 * bits);
+		res = _mm_or_si128(res, _mm_slli_epi32(f[0], 2 * bits));
+		res = _mm_or_si128(res, _mm_slli_epi32(f[1], bits));
+		res = _mm_or_si128(res, f[2]);
+
+		_mm_storeu_si128((__m128i*)(out + i), res);
+	}
+
+	// process the rest of quaternions
+	QUAT_Pack_Batch_Scalar(QUAT_SOA_Offset(qIn, i), out + i, num - i);
+
+} // end QUAT_Pack_Batch_SSE (32 bits)
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_SSE41
+void QUAT_Pack_Batch_SSE(const QUAT_SOA & qIn, QUAT_PACKED48* out, const int num)
+{
+	assert(qIn.w && qIn.x && qIn.y && qIn.z);
+	assert(out != nullptr);
+	assert(num >= 0);
+
+	int i = 0;
+
+	for (; i + 4 <= num; i += 4)
+	{
+		__m128i index, f[3];
+		__m128i lo, hi;
+		alignas(16) uint64_t res[4];
+
+		QUAT_Quantize_SSE(_mm_loadu_ps(qIn.w + i), _mm_loadu_ps(qIn.x + i),
+			_mm_loadu_ps(qIn.y + i), _mm_loadu_ps(qIn.z + i), QUAT_QUANT_48, index, f);
+
+		Combine4_U64_SSE(index, f, QUAT_QUANT_48.bits, lo, hi);
+
+		_mm_store_si128((__m128i*)res, lo);
+		_mm_store_si128((__m128i*)(res + 2), hi);
+		Store_U48(out + i, res, 4);
+	}
+
+	// process the rest of quaternions
+	QUAT_Pack_Batch_Scalar(QUAT_SOA_Offset(qIn, i), out + i, num - i);
+
+} // end QUAT_Pack_Batch_SSE (48 bits)
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_SSE41
+void QUAT_Pack_Batch_SSE(const QUAT_SOA & qIn, QUAT_PACKED64* out, const int num)
+{
+	assert(qIn.w && qIn.x && qIn.y && qIn.z);
+	assert(out != nullptr);
+	assert(num >= 0);
+
+	int i = 0;
+
+	for (; i + 4 <= num; i += 4)
+	{
+		__m128i index, f[3];
+		__m128i lo, hi;
+
+		QUAT_Quantize_SSE(_mm_loadu_ps(qIn.w + i), _mm_loadu_ps(qIn.x + i),
+			_mm_loadu_ps(qIn.y + i), _mm_loadu_ps(qIn.z + i), QUAT_QUANT_64, index, f);
+
+		Combine4_U64_SSE(index, f, QUAT_QUANT_64.bits, lo, hi);
+
+		_mm_storeu_si128((__m128i*)(out + i), lo);
+		_mm_storeu_si128((__m128i*)(out + i + 2), hi);
+	}
+
+	// process the rest of quaternions
+	QUAT_Pack_Batch_Scalar(QUAT_SOA_Offset(qIn, i), out + i, num - i);
+
+} // end QUAT_Pack_Batch_SSE (64 bits)
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_SSE41
+void QUAT_Unpack_Batch_SSE(const QUAT_PACKED32* in, const QUAT_SOA_OUT & qOut, const int num)
+{
+	assert(in != nullptr);
+	assert(qOut.w && qOut.x && qOut.y && qOut.z);
+	assert(num >= 0);
+
+	const int bits = QUAT_QUANT_32.bits;
+	const __m128i mask = _mm_set1_epi32((1 << bits) - 1);
+	int i = 0;
+
+	for (; i + 4 <= num; i += 4)
+	{
+		const __m128i v = _mm_loadu_si128((const __m128i*)(in + i));
+
+		const __m128i index = _mm_srli_epi32(v, 3 * bits);
+		const __m128i f[3] = {
+			_mm_and_si128(_mm_srli_epi32(v, 2 * bits), mask),
+			_mm_and_si128(_mm_srli_epi32(v, bits), mask),
+			_mm_and_si128(v, mask)
+		};
+
+		QUAT_Dequantize_SSE(index, f, QUAT_QUANT_32, qOut.w + i, qOut.x + i, qOut.y + i, qOut.z + i);
+	}
+
+	// process the rest of quaternions
+	QUAT_Unpack_Batch_Scalar(in + i, QUAT_SOA_Offset(qOut, i), num - i);
+
+} // end QUAT_Unpack_Batch_SSE (32 bits)
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_SSE41
+void QUAT_Unpack_Batch_SSE(const QUAT_PACKED48* in, const QUAT_SOA_OUT & qOut, const int num)
+{
+	assert(in != nullptr);
+	assert(qOut.w && qOut.x && qOut.y && qOut.z);
+	assert(num >= 0);
+
+	int i = 0;
+
+	for (; i + 4 <= num; i += 4)
+	{
+		alignas(16) uint64_t bits[4];
+		__m128i index, f[3];
+
+		Load_U48(in + i, bits, 4);
+		Split4_U64_SSE(_mm_load_si128((const __m128i*)bits), _mm_load_si128((const __m128i*)(bits + 2)),
+			QUAT_QUANT_48.bits, index, f);
+
+		QUAT_Dequantize_SSE(index, f, QUAT_QUANT_48, qOut.w + i, qOut.x + i, qOut.y + i, qOut.z + i);
+	}
+
+	// process the rest of quaternions
+	QUAT_Unpack_Batch_Scalar(in + i, QUAT_SOA_Offset(qOut, i), num - i);
+
+} // end QUAT_Unpack_Batch_SSE (48 bits)
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_SSE41
+void QUAT_Unpack_Batch_SSE(const QUAT_PACKED64* in, const QUAT_SOA_OUT & qOut, const int num)
+{
+	assert(in != nullptr);
+	assert(qOut.w && qOut.x && qOut.y && qOut.z);
+	assert(num >= 0);
+
+	int i = 0;
+
+	for (; i + 4 <= num; i += 4)
+	{
+		__m128i index, f[3];
+
+		Split4_U64_SSE(_mm_loadu_si128((const __m128i*)(in + i)), _mm_loadu_si128((const __m128i*)(in + i + 2)),
+			QUAT_QUANT_64.bits, index, f);
+
+		QUAT_Dequantize_SSE(index, f, QUAT_QUANT_64, qOut.w + i, qOut.x + i, qOut.y + i, qOut.z + i);
+	}
+
+	// process the rest of quaternions
+	QUAT_Unpack_Batch_Scalar(in + i, QUAT_SOA_Offset(qOut, i), num - i);
+
+} // end QUAT_Unpack_Batch_SSE (64 bits)
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                   AVX2 KERNELS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+//
+// each kernel processes 8 quaternions per iteration;
+// the tail (num % 8 quaternions) is processed by the SSE kernel
+//
+
+MATHLIB_TARGET_AVX2
+void QUAT_Pack_Batch_AVX2(const QUAT_SOA & qIn, QUAT_PACKED32* out, const int num)
+{
+	assert(qIn.w && qIn.x && qIn.y && qIn.z);
+	assert(out != nullptr);
+	assert(num >= 0);
+
+	const int bits = QUAT_QUANT_32.bits;
+	int i = 0;
+
+	for (; i + 8 <= num; i += 8)
+	{
+		__m256i index, f[3];
+
+		QUAT_Quantize_AVX2(_mm256_loadu_ps(qIn.w + i), _mm256_loadu_ps(qIn.x + i),
+			_mm256_loadu_ps(qIn.y + i), _mm256_loadu_ps(qIn.z + i), QUAT_QUANT_32, index, f);
+
+		__m256i res = _mm256_slli_epi32(index, 3 * bits);
+		res = _mm256_or_si256(res, _mm256_slli_epi32(f[0], 2 * bits));
+		res = _mm256_or_si256(res, _mm256_slli_epi32(f[1], bits));
+		res = _mm256_or_si256(res, f[2]);
+
+		_mm256_storeu_si256((__m256i*)(out + i), res);
+	}
+
+	// process the rest of quaternions
+	QUAT_Pack_Batch_SSE(QUAT_SOA_Offset(qIn, i), out + i, num - i);
+
+} // end QUAT_Pack_Batch_AVX2 (32 bits)
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_AVX2
+void QUAT_Pack_Batch_AVX2(const QUAT_SOA & qIn, QUAT_PACKED48* out, const int num)
+{
+	assert(qIn.w && qIn.x && qIn.y && qIn.z);
+	assert(out != nullptr);
+	assert(num >= 0);
+
+	int i = 0;
+
+	for (; i + 8 <= num; i += 8)
+	{
+		__m256i index, f[3];
+		__m256i lo, hi;
+		alignas(32) uint64_t res[8];
+
+		QUAT_Quantize_AVX2(_mm256_loadu_ps(qIn.w + i), _mm256_loadu_ps(qIn.x + i),
+			_mm256_loadu_ps(qIn.y + i), _mm256_loadu_ps(qIn.z + i), QUAT_QUANT_48, index, f);
+
+		Combine8_U64_AVX2(index, f, QUAT_QUANT_48.bits, lo, hi);
+
+		_mm256_store_si256((__m256i*)res, lo);
+		_mm256_store_si256((__m256i*)(res + 4), hi);
+		Store_U48(out + i, res, 8);
+	}
+
+	// process the rest of quaternions
+	QUAT_Pack_Batch_SSE(QUAT_SOA_Offset(qIn, i), out + i, num - i);
+
+} // end QUAT_Pack_Batch_AVX2 (48 bits)
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_AVX2
+void QUAT_Pack_Batch_AVX2(const QUAT_SOA & qIn, QUAT_PACKED64* out, const int num)
+{
+	assert(qIn.w && qIn.x && qIn.y && qIn.z);
+	assert(out != nullptr);
+	assert(num >= 0);
+
+	int i = 0;
+
+	for (; i + 8 <= num; i += 8)
+	{
+		__m256i index, f[3];
+		__m256i lo, hi;
+
+		QUAT_Quantize_AVX2(_mm256_loadu_ps(qIn.w + i), _mm256_loadu_ps(qIn.x + i),
+			_mm256_loadu_ps(qIn.y + i), _mm256_loadu_ps(qIn.z + i), QUAT_QUANT_64, index, f);
+
+		Combine8_U64_AVX2(index, f, QUAT_QUANT_64.bits, lo, hi);
+
+		_mm256_storeu_si256((__m256i*)(out + i), lo);
+		_mm256_storeu_si256((__m256i*)(out + i + 4), hi);
+	}
+
+	// process the rest of quaternions
+	QUAT_Pack_Batch_SSE(QUAT_SOA_Offset(qIn, i), out + i, num - i);
+
+} // end QUAT_Pack_Batch_AVX2 (64 bits)
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_AVX2
+void QUAT_Unpack_Batch_AVX2(const QUAT_PACKED32* in, const QUAT_SOA_OUT & qOut, const int num)
+{
+	assert(in != nullptr);
+	assert(qOut.w && qOut.x && qOut.y && qOut.z);
+	assert(num >= 0);
+
+	const int bits = QUAT_QUANT_32.bits;
+	const __m256i mask = _mm256_set1_epi32((1 << bits) - 1);
+	int i = 0;
+
+	for (; i + 8 <= num; i += 8)
+	{
+		const __m256i v = _mm256_loadu_si256((const __m256i*)(in + i));
+
+		const __m256i index = _mm256_srli_epi32(v, 3 * bits);
+		const __m256i f[3] = {
+			_mm256_and_si256(_mm256_srli_epi32(v, 2 * bits), mask),
+			_mm256_and_si256(_mm256_srli_epi32(v, bits), mask),
+			_mm256_and_si256(v, mask)
+		};
+
+		QUAT_Dequantize_AVX2(index, f, QUAT_QUANT_32, qOut.w + i, qOut.x + i, qOut.y + i, qOut.z + i);
+	}
+
+	// process the rest of quaternions
+	QUAT_Unpack_Batch_SSE(in + i, QUAT_SOA_Offset(qOut, i), num - i);
+
+} // end QUAT_Unpack_Batch_AVX2 (32 bits)
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_AVX2
+void QUAT_Unpack_Batch_AVX2(const QUAT_PACKED48* in, const QUAT_SOA_OUT & qOut, const int num)
+{
+	assert(in != nullptr);
+	assert(qOut.w && qOut.x && qOut.y && qOut.z);
+	assert(num >= 0);
+
+	int i = 0;
+
+	for (; i + 8 <= num; i += 8)
+	{
+		alignas(32) uint64_t bits[8];
+		__m256i index, f[3];
+
+		Load_U48(in + i, bits, 8);
+		Split8_U64_AVX2(_mm256_load_si256((const __m256i*)bits), _mm256_load_si256((const __m256i*)(bits + 4)),
+			QUAT_QUANT_48.bits, index, f);
+
+		QUAT_Dequantize_AVX2(index, f, QUAT_QUANT_48, qOut.w + i, qOut.x + i, qOut.y + i, qOut.z + i);
+	}
+
+	// process the rest of quaternions
+	QUAT_Unpack_Batch_SSE(in + i, QUAT_SOA_Offset(qOut, i), num - i);
+
+} // end QUAT_Unpack_Batch_AVX2 (48 bits)
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_AVX2
+void QUAT_Unpack_Batch_AVX2(const QUAT_PACKED64* in, const QUAT_SOA_OUT & qOut, const int num)
+{
+	assert(in != nullptr);
+	assert(qOut.w && qOut.x && qOut.y && qOut.z);
+	assert(num >= 0);
+
+	int i = 0;
+
+	for (; i + 8 <= num; i += 8)
+	{
+		__m256i index, f[3];
+
+		Split8_U64_AVX2(_mm256_loadu_si256((const __m256i*)(in + i)), _mm256_loadu_si256((const __m256i*)(in + i + 4)),
+			QUAT_QUANT_64.bits, index, f);
+
+		QUAT_Dequantize_AVX2(index, f, QUAT_QUANT_64, qOut.w + i, qOut.x + i, qOut.y + i, qOut.z + i);
+	}
+
+	// process the rest of quaternions
+	QUAT_Unpack_Batch_SSE(in + i, QUAT_SOA_Offset(qOut, i), num - i);
+
+} // end QUAT_Unpack_Batch_AVX2 (64 bits)
+
+#else
+
+// there is no SIMD support for this platform so use the reference kernels
+
+void QUAT_Pack_Batch_SSE (const QUAT_SOA & qIn, QUAT_PACKED32* out, const int num) { QUAT_Pack_Batch_Scalar(qIn, out, num); }
+void QUAT_Pack_Batch_SSE (const QUAT_SOA & qIn, QUAT_PACKED48* out, const int num) { QUAT_Pack_Batch_Scalar(qIn, out, num); }
+void QUAT_Pack_Batch_SSE (const QUAT_SOA & qIn, QUAT_PACKED64* out, const int num) { QUAT_Pack_Batch_Scalar(qIn, out, num); }
+void QUAT_Pack_Batch_AVX2(const QUAT_SOA & qIn, QUAT_PACKED32* out, const int num) { QUAT_Pack_Batch_Scalar(qIn, out, num); }
+void QUAT_Pack_Batch_AVX2(const QUAT_SOA & qIn, QUAT_PACKED48* out, const int num) { QUAT_Pack_Batch_Scalar(qIn, out, num); }
+void QUAT_Pack_Batch_AVX2(const QUAT_SOA & qIn, QUAT_PACKED64* out, const int num) { QUAT_Pack_Batch_Scalar(qIn, out, num); }
+
+void QUAT_Unpack_Batch_SSE (const QUAT_PACKED32* in, const QUAT_SOA_OUT & qOut, const int num) { QUAT_Unpack_Batch_Scalar(in, qOut, num); }
+void QUAT_Unpack_Batch_SSE (const QUAT_PACKED48* in, const QUAT_SOA_OUT & qOut, const int num) { QUAT_Unpack_Batch_Scalar(in, qOut, num); }
+void QUAT_Unpack_Batch_SSE (const QUAT_PACKED64* in, const QUAT_SOA_OUT & qOut, const int num) { QUAT_Unpack_Batch_Scalar(in, qOut, num); }
+void QUAT_Unpack_Batch_AVX2(const QUAT_PACKED32* in, const QUAT_SOA_OUT & qOut, const int num) { QUAT_Unpack_Batch_Scalar(in, qOut, num); }
+void QUAT_Unpack_Batch_AVX2(const QUAT_PACKED48* in, const QUAT_SOA_OUT & qOut, const int num) { QUAT_Unpack_Batch_Scalar(in, qOut, num); }
+void QUAT_Unpack_Batch_AVX2(const QUAT_PACKED64* in, const QUAT_SOA_OUT & qOut, const int num) { QUAT_Unpack_Batch_Scalar(in, qOut, num); }
+
+#endif // MATHLIB_SIMD_X86
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                  DISPATCHING
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void QUAT_Pack_Batch(const QUAT_SOA & qIn, QUAT_PACKED32* out, const int num)
+{
+	// packs num quaternions into 32 bits using the best kernel for the current CPU
+
+	switch (SIMD_Get_Level())
+	{
+		case SIMD_LEVEL_AVX2:
+			QUAT_Pack_Batch_AVX2(qIn, out, num);
+			break;
+
+		case SIMD_LEVEL_AVX:
+		case SIMD_LEVEL_SSE:
+			QUAT_Pack_Batch_SSE(qIn, out, num);
+			break;
+
+		default:
+			QUAT_Pack_Batch_Scalar(qIn, out, num);
+	}
+
+} // end QUAT_Pack_Batch (32 bits)
+
+///////////////////////////////////////////////////////////
+
+void QUAT_Pack_Batch(const QUAT_SOA & qIn, QUAT_PACKED48* out, const int num)
+{
+	// packs num quaternions into 48 bits using the best kernel for the current CPU
+
+	switch (SIMD_Get_Level())
+	{
+		case SIMD_LEVEL_AVX2:
+			QUAT_Pack_Batch_AVX2(qIn, out, num);
+			break;
+
+		case SIMD_LEVEL_AVX:
+		case SIMD_LEVEL_SSE:
+			QUAT_Pack_Batch_SSE(qIn, out, num);
+			break;
+
+		default:
+			QUAT_Pack_Batch_Scalar(qIn, out, num);
+	}
+
+} // end QUAT_Pack_Batch (48 bits)
+
+///////////////////////////////////////////////////////////
+
+void QUAT_Pack_Batch(const QUAT_SOA & qIn, QUAT_PACKED64* out, const int num)
+{
+	// packs num quaternions into 64 bits using the best kernel for the current CPU
+
+	switch (SIMD_Get_Level())
+	{
+		case SIMD_LEVEL_AVX2:
+			QUAT_Pack_Batch_AVX2(qIn, out, num);
+			break;
+
+		case SIMD_LEVEL_AVX:
+		case SIMD_LEVEL_SSE:
+			QUAT_Pack_Batch_SSE(qIn, out, num);
+			break;
+
+		default:
+			QUAT_Pack_Batch_Scalar(qIn, out, num);
+	}
+
+} // end QUAT_Pack_Batch (64 bits)
+
+///////////////////////////////////////////////////////////
+
+void QUAT_Unpack_Batch(const QUAT_PACKED32* in, const QUAT_SOA_OUT & qOut, const int num)
+{
+	// unpacks num 32-bit quaternions using the best kernel for the current CPU
+
+	switch (SIMD_Get_Level())
+	{
+		case SIMD_LEVEL_AVX2:
+			QUAT_Unpack_Batch_AVX2(in, qOut, num);
+			break;
+
+		case SIMD_LEVEL_AVX:
+		case SIMD_LEVEL_SSE:
+			QUAT_Unpack_Batch_SSE(in, qOut, num);
+			break;
+
+		default:
+			QUAT_Unpack_Batch_Scalar(in, qOut, num);
+	}
+
+} // end QUAT_Unpack_Batch (32 bits)
+
+///////////////////////////////////////////////////////////
+
+void QUAT_Unpack_Batch(const QUAT_PACKED48* in, const QUAT_SOA_OUT & qOut, const int num)
+{
+	// unpacks num 48-bit quaternions using the best kernel for the current CPU
+
+	switch (SIMD_Get_Level())
+	{
+		case SIMD_LEVEL_AVX2:
+			QUAT_Unpack_Batch_AVX2(in, qOut, num);
+			break;
+
+		case SIMD_LEVEL_AVX:
+		case SIMD_LEVEL_SSE:
+			QUAT_Unpack_Batch_SSE(in, qOut, num);
+			break;
+
+		default:
+			QUAT_Unpack_Batch_Scalar(in, qOut, num);
+	}
+
+} // end QUAT_Unpack_Batch (48 bits)
+
+///////////////////////////////////////////////////////////
+
+void QUAT_Unpack_Batch(const QUAT_PACKED64* in, const QUAT_SOA_OUT & qOut, const int num)
+{
+	// unpacks num 64-bit quaternions using the best kernel for the current CPU
+
+	switch (SIMD_Get_Level())
+	{
+		case SIMD_LEVEL_AVX2:
+			QUAT_Unpack_Batch_AVX2(in, qOut, num);
+			break;
+
+		case SIMD_LEVEL_AVX:
+		case SIMD_LEVEL_SSE:
+			QUAT_Unpack_Batch_SSE(in, qOut, num);
+			break;
+
+		default:
+			QUAT_Unpack_Batch_Scalar(in, qOut, num);
+	}
+
+} // end QUAT_Unpack_Batch (64 bits)
+
+} // end namespace MathLib
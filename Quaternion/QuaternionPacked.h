@@ -0,0 +1,109 @@
+////////////////////////////////////////////////////////////////////////////////////////////
+// Filename:      QuaternionPacked.h
+// Description:   contains functional for compression of unit quaternions by the
+//                "smallest three" method: the largest (by modulus) component is dropped
+//                and restored from the unit length, the other three are in the range
+//                [-1/sqrt(2), 1/sqrt(2)] and quantized into integers; the sign of the
+//                quaternion is chosen so the dropped component is positive (q and -q
+//                are the same rotation)
+//
+//                format     layout (from the high bits)           max error of a component
+//                32 bits:   2 (index) + 3 * 10 bits               0.0021
+//                48 bits:   2 (index) + 3 * 15 bits (+1 unused)   0.00007
+//                64 bits:   2 (index) + 3 * 20 bits (+2 unused)   0.000003
+//
+//                (the errors are the ones of the restored quaternion relative to the
+//                source one with the same sign; the restored quaternion has the unit length)
+//
+// Created:       17.10.26
+////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <cstdint>
+
+#include "Quaternion.h"
+#include "QuaternionBatch.h"
+
+
+namespace MathLib
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                 DATA STRUCTURES
+////////////////////////////////////////////////////////////////////////////////////////////
+
+// packed quaternions: the index of the dropped component is in the highest bits,
+// then go the quantized components in the order w, x, y, z (without the dropped one);
+// the 48-bit value is stored by 16-bit parts from the lowest one
+typedef struct QUAT_PACKED32_TYPE { uint32_t bits; }   QUAT_PACKED32, *QUAT_PACKED32_PTR;
+typedef struct QUAT_PACKED48_TYPE { uint16_t M[3]; }   QUAT_PACKED48, *QUAT_PACKED48_PTR;
+typedef struct QUAT_PACKED64_TYPE { uint64_t bits; }   QUAT_PACKED64, *QUAT_PACKED64_PTR;
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                          PACKING OF SINGLE QUATERNIONS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+//
+// the source quaternion must have the unit length (and finite components);
+// of the components with equal moduli the first one is dropped
+//
+
+void QUAT_Pack(const QUAT & q, QUAT_PACKED32 & qp);
+void QUAT_Pack(const QUAT & q, QUAT_PACKED48 & qp);
+void QUAT_Pack(const QUAT & q, QUAT_PACKED64 & qp);
+
+void QUAT_Unpack(const QUAT_PACKED32 & qp, QUAT & q);
+void QUAT_Unpack(const QUAT_PACKED48 & qp, QUAT & q);
+void QUAT_Unpack(const QUAT_PACKED64 & qp, QUAT & q);
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                           PACKING OF QUATERNION STREAMS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+//
+// each function packs/unpacks num quaternions (the unpacked ones are in SoA form);
+// the functions without a suffix choose the best kernel for the current CPU
+// (see SIMD_Get_Level); all the kernels give exactly the same bits as QUAT_Pack
+// and QUAT_Unpack
+//
+
+void QUAT_Pack_Batch(const QUAT_SOA & qIn, QUAT_PACKED32* out, const int num);
+void QUAT_Pack_Batch(const QUAT_SOA & qIn, QUAT_PACKED48* out, const int num);
+void QUAT_Pack_Batch(const QUAT_SOA & qIn, QUAT_PACKED64* out, const int num);
+
+void QUAT_Unpack_Batch(const QUAT_PACKED32* in, const QUAT_SOA_OUT & qOut, const int num);
+void QUAT_Unpack_Batch(const QUAT_PACKED48* in, const QUAT_SOA_OUT & qOut, const int num);
+void QUAT_Unpack_Batch(const QUAT_PACKED64* in, const QUAT_SOA_OUT & qOut, const int num);
+
+// separate kernels (SSE/AVX2 kernels must be called only if the CPU supports them)
+void QUAT_Pack_Batch_Scalar(const QUAT_SOA & qIn, QUAT_PACKED32* out, const int num);
+void QUAT_Pack_Batch_SSE   (const QUAT_SOA & qIn, QUAT_PACKED32* out, const int num);
+void QUAT_Pack_Batch_AVX2  (const QUAT_SOA & qIn, QUAT_PACKED32* out, const int num);
+
+void QUAT_Pack_Batch_Scalar(const QUAT_SOA & qIn, QUAT_PACKED48* out, const int num);
+void QUAT_Pack_Batch_SSE   (const QUAT_SOA & qIn, QUAT_PACKED48* out, const int num);
+void QUAT_Pack_Batch_AVX2  (const QUAT_SOA & qIn, QUAT_PACKED48* out, const int num);
+
+void QUAT_Pack_Batch_Scalar(const QUAT_SOA & qIn, QUAT_PACKED64* out, const int num);
+void QUAT_Pack_Batch_SSE   (const QUAT_SOA & qIn, QUAT_PACKED64* out, const int num);
+void QUAT_Pack_Batch_AVX2  (const QUAT_SOA & qIn, QUAT_PACKED64* out, const int num);
+
+void QUAT_Unpack_Batch_Scalar(const QUAT_PACKED32* in, const QUAT_SOA_OUT & qOut, const int num);
+void QUAT_Unpack_Batch_SSE   (const QUAT_PACKED32* in, const QUAT_SOA_OUT & qOut, const int num);
+void QUAT_Unpack_Batch_AVX2  (const QUAT_PACKED32* in, const QUAT_SOA_OUT & qOut, const int num);
+
+void QUAT_Unpack_Batch_Scalar(const QUAT_PACKED48* in, const QUAT_SOA_OUT & qOut, const int num);
+void QUAT_Unpack_Batch_SSE   (const QUAT_PACKED48* in, const QUAT_SOA_OUT & qOut, const int num);
+void QUAT_Unpack_Batch_AVX2  (const QUAT_PACKED48* in, const QUAT_SOA_OUT & qOut, const int num);
+
+void QUAT_Unpack_Batch_Scalar(const QUAT_PACKED64* in, const QUAT_SOA_OUT & qOut, const int num);
+void QUAT_Unpack_Batch_SSE   (const QUAT_PACKED64* in, const QUAT_SOA_OUT & qOut, const int num);
+void QUAT_Unpack_Batch_AVX2  (const QUAT_PACKED64* in, const QUAT_SOA_OUT & qOut, const int num);
+
+} // end namespace MathLib
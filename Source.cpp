@@ -15,8 +15,11 @@ int main()
 
 	test.Test_Quaternions();
 	test.Test_Vectors_And_Points();
+	test.Test_Coordinate_Systems();
 	test.Test_Matrices();
 	test.Test_Figures();
+	test.Test_Utils();
+	test.Test_Fixed_Point();
 	
 
 
@@ -16,13 +16,6 @@
 //                                PUBLIC FUNCTIONS
 ////////////////////////////////////////////////////////////////////////////////////////////
 
-void Tests::Test_Coordinate_Systems()
-{
-
-} // end Test_Coordinate_System
-
-///////////////////////////////////////////////////////////
-
 void Tests::Test_Matrices()
 {
 	Log::Print("\n\n");
@@ -32,6 +25,13 @@ void Tests::Test_Matrices()
 	Test_Matrices_Print_Func();           // test print out of matrices different dimensions
 	Test_Matrices_Add_Func();             // test of addition 
 	Test_Matrices_Multiplication_Func();  // test of multiplication 
+	Test_Matrices_Batch_Transform();      // test of batch transformation of points
+	Test_Matrices_SIMD_Kernels();         // test of SIMD kernels for 4x4 matrices
+	Test_Matrices_Affine_4X3();           // test of affine 4x3 transformations
+	Test_Matrices_VecMat_Templates();     // test of the generic Vec/Mat core
+	Test_Matrices_VecMat_Expressions();   // test of the expression templates
+	Test_Matrices_Mixed_Precision();      // test of double and mixed precision functions
+	Test_Matrices_Packed_Half();          // test of packed fp16/bf16 storage
 
 } // end Test_Matrices
 
@@ -43,6 +43,11 @@ void Tests::Test_Figures()
 	Log::Print("-------------------- TEST: FIGURES --------------------\n");
 
 	Test_Parametric_Lines();
+	Test_Bounding_Volumes();
+	Test_BVH();
+	Test_Frustum();
+	Test_Triangles();
+	Test_Segments2D();
 
 } // end Test_Figures
 
@@ -267,6 +272,341 @@ void Tests::Test_Quaternions()
 	MathLib::QUAT_Mul(q2, q1, qprod);
 	assert((qprod.w == -60) && (qprod.x == 20) && (qprod.y == 14) && (qprod.z == 32));
 
+	/////////////////////////////////////////////
+
+	// TEST 17: rotation of a vector by a quaternion must be the same as q*v*q^-1
+
+	MathLib::VECTOR3D vr;
+	MathLib::VECTOR3D vrot(3, -4, 5);
+	MathLib::QUAT qvec, qtemp;
+
+	MathLib::QUAT_Rotate_VECTOR3D(qr, vrot, vr);
+
+	MathLib::QUAT_INIT_VECTOR3D(qvec, vrot);
+	MathLib::QUAT_Unit_Inverse(qr, qi);
+	MathLib::QUAT_Mul(qr, qvec, qtemp);
+	MathLib::QUAT_Mul(qtemp, qi, qprod);
+
+	assert(fabs(vr.x - qprod.x) < EPSILON_E4);
+	assert(fabs(vr.y - qprod.y) < EPSILON_E4);
+	assert(fabs(vr.z - qprod.z) < EPSILON_E4);
+
+	// rotation by 90 degrees around Z-axis: (1, 0, 0) => (0, 1, 0)
+	MathLib::VECTOR3D vz{ 0, 0, 1 };
+	MathLib::VECTOR3D_Theta_To_QUAT(q, vz, DEG_TO_RAD(90));
+	MathLib::VECTOR3D_INIT_XYZ(vrot, 1, 0, 0);
+	MathLib::QUAT_Rotate_VECTOR3D(q, vrot, vr);
+
+	assert((fabs(vr.x) < EPSILON_E5) && (fabs(vr.y - 1) < EPSILON_E5) && (fabs(vr.z) < EPSILON_E5));
+
+	/////////////////////////////////////////////
+
+	// TEST 18: batch rotation of points must be bit-compatible with QUAT_Rotate_VECTOR3D
+
+	const int num = 1003;
+	std::vector<float> x(num), y(num), z(num);
+	std::mt19937 gen(777);
+	std::uniform_real_distribution<float> dist(-100.0f, 100.0f);
+
+	for (int i = 0; i < num; i++)
+	{
+		x[i] = dist(gen);
+		y[i] = dist(gen);
+		z[i] = dist(gen);
+	}
+
+	const MathLib::SIMD_LEVEL cpuLevel = MathLib::SIMD_Get_Level();
+
+	for (int level = MathLib::SIMD_LEVEL_SCALAR; level <= cpuLevel; level++)
+	{
+		std::vector<float> xOut(num), yOut(num), zOut(num);
+
+		MathLib::SIMD_Set_Max_Level((MathLib::SIMD_LEVEL)level);
+		MathLib::QUAT_Rotate_VECTOR3D_Batch(qr, x.data(), y.data(), z.data(),
+			xOut.data(), yOut.data(), zOut.data(), num);
+
+		for (int i = 0; i < num; i++)
+		{
+			MathLib::VECTOR3D_INIT_XYZ(vrot, x[i], y[i], z[i]);
+			MathLib::QUAT_Rotate_VECTOR3D(qr, vrot, vr);
+
+			assert(memcmp(&vr.x, &xOut[i], sizeof(float)) == 0);
+			assert(memcmp(&vr.y, &yOut[i], sizeof(float)) == 0);
+			assert(memcmp(&vr.z, &zOut[i], sizeof(float)) == 0);
+		}
+	}
+
+	// restore the default SIMD level
+	MathLib::SIMD_Set_Max_Level(MathLib::SIMD_LEVEL_AVX2);
+
+	/////////////////////////////////////////////
+
+	// TEST 19: interpolation of quaternions (SLERP / NLERP)
+
+	MathLib::QUAT qa, qb, qSlerp, qFast, qNlerp;
+	MathLib::VECTOR3D axisA(1, 2, 3);
+	MathLib::VECTOR3D axisB(-2, 1, 0.5f);
+
+	MathLib::VECTOR3D_Normalize(axisA);
+	MathLib::VECTOR3D_Normalize(axisB);
+	MathLib::VECTOR3D_Theta_To_QUAT(qa, axisA, DEG_TO_RAD(30));
+	MathLib::VECTOR3D_Theta_To_QUAT(qb, axisB, DEG_TO_RAD(150));
+
+	// the endpoints must be the input quaternions
+	MathLib::QUAT_Slerp(qa, qb, 0.0f, qSlerp);
+	assert((fabs(qSlerp.w - qa.w) < EPSILON_E5) && (fabs(qSlerp.x - qa.x) < EPSILON_E5));
+	assert((fabs(qSlerp.y - qa.y) < EPSILON_E5) && (fabs(qSlerp.z - qa.z) < EPSILON_E5));
+
+	MathLib::QUAT_Slerp_Fast(qa, qb, 1.0f, qFast);
+	assert((fabs(qFast.w - qb.w) < EPSILON_E5) && (fabs(qFast.x - qb.x) < EPSILON_E5));
+	assert((fabs(qFast.y - qb.y) < EPSILON_E5) && (fabs(qFast.z - qb.z) < EPSILON_E5));
+
+	// the approximation must be close to the exact SLERP; NLERP must give a unit quaternion
+	for (float t = 0.0f; t <= 1.0f; t += 0.125f)
+	{
+		MathLib::QUAT_Slerp(qa, qb, t, qSlerp);
+		MathLib::QUAT_Slerp_Fast(qa, qb, t, qFast);
+		MathLib::QUAT_Nlerp(qa, qb, t, qNlerp);
+
+		assert(fabs(qSlerp.w - qFast.w) < EPSILON_E4);
+		assert(fabs(qSlerp.x - qFast.x) < EPSILON_E4);
+		assert(fabs(qSlerp.y - qFast.y) < EPSILON_E4);
+		assert(fabs(qSlerp.z - qFast.z) < EPSILON_E4);
+		assert(fabs(MathLib::QUAT_Norm(qNlerp) - 1.0f) < EPSILON_E5);
+	}
+
+	// the shortest arc: q and -q are the same rotation
+	MathLib::QUAT qbNeg(-qb.w, -qb.x, -qb.y, -qb.z);
+	MathLib::QUAT_Slerp(qa, qb, 0.5f, qSlerp);
+	MathLib::QUAT_Slerp(qa, qbNeg, 0.5f, qFast);
+	assert((fabs(qSlerp.w - qFast.w) < EPSILON_E5) && (fabs(qSlerp.x - qFast.x) < EPSILON_E5));
+	assert((fabs(qSlerp.y - qFast.y) < EPSILON_E5) && (fabs(qSlerp.z - qFast.z) < EPSILON_E5));
+
+	// batch interpolation must be bit-compatible with QUAT_Slerp_Fast
+	std::vector<float> aw(num), ax(num), ay(num), az(num);
+	std::vector<float> bw(num), bx(num), by(num), bz(num);
+	std::vector<float> tt(num);
+	std::uniform_real_distribution<float> distUnit(-1.0f, 1.0f);
+	std::uniform_real_distribution<float> distT(0.0f, 1.0f);
+
+	for (int i = 0; i < num; i++)
+	{
+		MathLib::QUAT ra(distUnit(gen), distUnit(gen), distUnit(gen), distUnit(gen));
+		MathLib::QUAT rb(distUnit(gen), distUnit(gen), distUnit(gen), distUnit(gen));
+
+		MathLib::QUAT_Normalize(ra);
+		MathLib::QUAT_Normalize(rb);
+
+		aw[i] = ra.w;  ax[i] = ra.x;  ay[i] = ra.y;  az[i] = ra.z;
+		bw[i] = rb.w;  bx[i] = rb.x;  by[i] = rb.y;  bz[i] = rb.z;
+		tt[i] = distT(gen);
+	}
+
+	const MathLib::QUAT_SOA soaA = { aw.data(), ax.data(), ay.data(), az.data() };
+	const MathLib::QUAT_SOA soaB = { bw.data(), bx.data(), by.data(), bz.data() };
+
+	for (int level = MathLib::SIMD_LEVEL_SCALAR; level <= cpuLevel; level++)
+	{
+		std::vector<float> rw(num), rx(num), ry(num), rz(num);
+		const MathLib::QUAT_SOA_OUT soaR = { rw.data(), rx.data(), ry.data(), rz.data() };
+
+		MathLib::SIMD_Set_Max_Level((MathLib::SIMD_LEVEL)level);
+		MathLib::QUAT_Slerp_Batch(soaA, soaB, tt.data(), soaR, num);
+
+		for (int i = 0; i < num; i++)
+		{
+			const MathLib::QUAT ra(aw[i], ax[i], ay[i], az[i]);
+			const MathLib::QUAT rb(bw[i], bx[i], by[i], bz[i]);
+
+			MathLib::QUAT_Slerp_Fast(ra, rb, tt[i], qFast);
+
+			assert(memcmp(&qFast.w, &rw[i], sizeof(float)) == 0);
+			assert(memcmp(&qFast.x, &rx[i], sizeof(float)) == 0);
+			assert(memcmp(&qFast.y, &ry[i], sizeof(float)) == 0);
+			assert(memcmp(&qFast.z, &rz[i], sizeof(float)) == 0);
+		}
+	}
+
+	MathLib::SIMD_Set_Max_Level(MathLib::SIMD_LEVEL_AVX2);
+
+	/////////////////////////////////////////////
+
+	// TEST 20: conversion between quaternions and rotation matrices
+
+	MathLib::MATRIX4X4 mrot;
+	MathLib::VECTOR3D vm;
+
+	MathLib::QUAT_To_MATRIX4X4(qa, &mrot);
+
+	// the rotation by the matrix must be the same as the rotation by the quaternion
+	MathLib::VECTOR3D_INIT_XYZ(vrot, 3, -4, 5);
+	MathLib::QUAT_Rotate_VECTOR3D(qa, vrot, vr);
+	MathLib::Mat_Mul_VECTOR3D_4X4(&vrot, &mrot, &vm);
+
+	assert(fabs(vr.x - vm.x) < EPSILON_E4);
+	assert(fabs(vr.y - vm.y) < EPSILON_E4);
+	assert(fabs(vr.z - vm.z) < EPSILON_E4);
+
+	// quaternion => matrix => quaternion (q and -q are the same rotation);
+	// the angles are close to 180 degrees as well so all the branches are used
+	for (int i = 0; i < num; i++)
+	{
+		const MathLib::QUAT qsrc(aw[i], ax[i], ay[i], az[i]);
+		MathLib::QUAT qdst;
+
+		MathLib::QUAT_To_MATRIX4X4(qsrc, &mrot);
+		MathLib::MATRIX4X4_To_QUAT(&mrot, qdst);
+
+		assert(fabs(fabs(MathLib::QUAT_Dot(qsrc, qdst)) - 1.0f) < EPSILON_E4);
+	}
+
+	// batch conversion must be bit-compatible with the single conversion
+	for (int level = MathLib::SIMD_LEVEL_SCALAR; level <= cpuLevel; level++)
+	{
+		std::vector<MathLib::MATRIX4X4> matsOut(num);
+		std::vector<float> rw(num), rx(num), ry(num), rz(num);
+		const MathLib::QUAT_SOA_OUT soaR = { rw.data(), rx.data(), ry.data(), rz.data() };
+
+		MathLib::SIMD_Set_Max_Level((MathLib::SIMD_LEVEL)level);
+		MathLib::QUAT_To_MATRIX4X4_Batch(soaA, matsOut.data(), num);
+		MathLib::MATRIX4X4_To_QUAT_Batch(matsOut.data(), soaR, num);
+
+		for (int i = 0; i < num; i++)
+		{
+			MathLib::QUAT qdst;
+
+			MathLib::QUAT_To_MATRIX4X4(MathLib::QUAT(aw[i], ax[i], ay[i], az[i]), &mrot);
+			MathLib::MATRIX4X4_To_QUAT(&mrot, qdst);
+
+			assert(memcmp(&mrot, &matsOut[i], sizeof(MathLib::MATRIX4X4)) == 0);
+			assert(memcmp(&qdst.w, &rw[i], sizeof(float)) == 0);
+			assert(memcmp(&qdst.x, &rx[i], sizeof(float)) == 0);
+			assert(memcmp(&qdst.y, &ry[i], sizeof(float)) == 0);
+			assert(memcmp(&qdst.z, &rz[i], sizeof(float)) == 0);
+		}
+	}
+
+	MathLib::SIMD_Set_Max_Level(MathLib::SIMD_LEVEL_AVX2);
+
+	/////////////////////////////////////////////
+
+	// TEST 21: "smallest three" packing of quaternions: the restored quaternion must be
+	//          unit and each its component must be within the error bound of the format
+	//          (q and -q are the same rotation); the batch kernels must give the same
+	//          bits as the packing/unpacking of single quaternions
+
+	// the random quaternions + the special cases (equal moduli, negative components, ...)
+	std::vector<MathLib::QUAT> quats;
+
+	for (int i = 0; i < num; i++)
+		quats.push_back(MathLib::QUAT(aw[i], ax[i], ay[i], az[i]));
+
+	quats.push_back(MathLib::QUAT(1, 0, 0, 0));
+	quats.push_back(MathLib::QUAT(0, 0, 0, -1));
+	quats.push_back(MathLib::QUAT(0.5f, -0.5f, 0.5f, -0.5f));
+	quats.push_back(MathLib::QUAT(-0.5f, 0.5f, -0.5f, 0.5f));
+	quats.push_back(MathLib::QUAT(0, 0.70710678f, -0.70710678f, 0));
+	quats.push_back(MathLib::QUAT(-0.70710678f, 0, 0, 0.70710678f));
+
+	const int numPacked = (int)quats.size();
+
+	std::vector<float> pw(numPacked), px(numPacked), py(numPacked), pz(numPacked);
+
+	for (int i = 0; i < numPacked; i++)
+	{
+		pw[i] = quats[i].w;  px[i] = quats[i].x;  py[i] = quats[i].y;  pz[i] = quats[i].z;
+	}
+
+	const MathLib::QUAT_SOA soaP = { pw.data(), px.data(), py.data(), pz.data() };
+
+	std::vector<MathLib::QUAT_PACKED32> packed32(numPacked), batch32(numPacked);
+	std::vector<MathLib::QUAT_PACKED48> packed48(numPacked), batch48(numPacked);
+	std::vector<MathLib::QUAT_PACKED64> packed64(numPacked), batch64(numPacked);
+	std::vector<MathLib::QUAT> unpacked32(numPacked), unpacked48(numPacked), unpacked64(numPacked);
+
+	// the max error of the components of the restored quaternion
+	auto Component_Error = [](const MathLib::QUAT & src, const MathLib::QUAT & res)
+	{
+		const float s = (MathLib::QUAT_Dot(src, res) < 0.0f) ? -1.0f : 1.0f;
+		float err = 0.0f;
+
+		for (int k = 0; k < 4; k++)
+			err = std::max(err, fabsf(src.M[k] - s * res.M[k]));
+
+		return err;
+	};
+
+	float maxErr[3] = { 0.0f, 0.0f, 0.0f };
+
+	for (int i = 0; i < numPacked; i++)
+	{
+		MathLib::QUAT_Pack(quats[i], packed32[i]);
+		MathLib::QUAT_Pack(quats[i], packed48[i]);
+		MathLib::QUAT_Pack(quats[i], packed64[i]);
+
+		MathLib::QUAT_Unpack(packed32[i], unpacked32[i]);
+		MathLib::QUAT_Unpack(packed48[i], unpacked48[i]);
+		MathLib::QUAT_Unpack(packed64[i], unpacked64[i]);
+
+		assert(fabsf(MathLib::QUAT_Norm(unpacked32[i]) - 1.0f) < EPSILON_E5);
+		assert(fabsf(MathLib::QUAT_Norm(unpacked48[i]) - 1.0f) < EPSILON_E5);
+		assert(fabsf(MathLib::QUAT_Norm(unpacked64[i]) - 1.0f) < EPSILON_E5);
+
+		maxErr[0] = std::max(maxErr[0], Component_Error(quats[i], unpacked32[i]));
+		maxErr[1] = std::max(maxErr[1], Component_Error(quats[i], unpacked48[i]));
+		maxErr[2] = std::max(maxErr[2], Component_Error(quats[i], unpacked64[i]));
+	}
+
+	assert(maxErr[0] < 0.0021f);
+	assert(maxErr[1] < 0.00007f);
+	assert(maxErr[2] < 0.000003f);
+
+	// the dropped component is restored as positive (the identity is packed exactly)
+	assert((packed32[num].bits >> 30) == 0);
+	assert(unpacked32[num].w == 1.0f);
+	assert((packed64[num + 1].bits >> 60) == 3);
+	assert(unpacked64[num + 1].z == 1.0f);
+
+	for (int level = MathLib::SIMD_LEVEL_SCALAR; level <= cpuLevel; level++)
+	{
+		std::vector<float> rw(numPacked), rx(numPacked), ry(numPacked), rz(numPacked);
+		const MathLib::QUAT_SOA_OUT soaR = { rw.data(), rx.data(), ry.data(), rz.data() };
+
+		MathLib::SIMD_Set_Max_Level((MathLib::SIMD_LEVEL)level);
+
+		MathLib::QUAT_Pack_Batch(soaP, batch32.data(), numPacked);
+		MathLib::QUAT_Pack_Batch(soaP, batch48.data(), numPacked);
+		MathLib::QUAT_Pack_Batch(soaP, batch64.data(), numPacked);
+
+		assert(memcmp(batch32.data(), packed32.data(), numPacked * sizeof(MathLib::QUAT_PACKED32)) == 0);
+		assert(memcmp(batch48.data(), packed48.data(), numPacked * sizeof(MathLib::QUAT_PACKED48)) == 0);
+		assert(memcmp(batch64.data(), packed64.data(), numPacked * sizeof(MathLib::QUAT_PACKED64)) == 0);
+
+		const std::vector<MathLib::QUAT>* unpacked[3] = { &unpacked32, &unpacked48, &unpacked64 };
+
+		for (int format = 0; format < 3; format++)
+		{
+			if (format == 0)
+				MathLib::QUAT_Unpack_Batch(batch32.data(), soaR, numPacked);
+			else if (format == 1)
+				MathLib::QUAT_Unpack_Batch(batch48.data(), soaR, numPacked);
+			else
+				MathLib::QUAT_Unpack_Batch(batch64.data(), soaR, numPacked);
+
+			for (int i = 0; i < numPacked; i++)
+			{
+				const MathLib::QUAT & ref = (*unpacked[format])[i];
+
+				assert(memcmp(&ref.w, &rw[i], sizeof(float)) == 0);
+				assert(memcmp(&ref.x, &rx[i], sizeof(float)) == 0);
+				assert(memcmp(&ref.y, &ry[i], sizeof(float)) == 0);
+				assert(memcmp(&ref.z, &rz[i], sizeof(float)) == 0);
+			}
+		}
+	}
+
+	MathLib::SIMD_Set_Max_Level(MathLib::SIMD_LEVEL_AVX2);
+
 	Log::Print(LOG_MACRO, "SUCCESS");
 
 } // end Test_Quaternions
@@ -481,6 +821,809 @@ void Tests::Test_Matrices_Multiplication_Func()
 
 ///////////////////////////////////////////////////////////
 
+void Tests::Test_Matrices_Batch_Transform()
+{
+	// this function tests batch transformation of 3D points by a 4x4 matrix;
+	// each kernel must give bit-compatible results with Mat_Mul_VECTOR3D_4X4
+
+	// rotation around Y-axis + scaling + translation
+	MathLib::MATRIX4X4 m;
+	MathLib::Mat_Init_4X4(&m,
+		 0.8f,  0.0f, -0.6f, 0.0f,
+		 0.0f,  2.0f,  0.0f, 0.0f,
+		 0.6f,  0.0f,  0.8f, 0.0f,
+		10.0f, -5.0f,  3.5f, 1.0f);
+
+	// use the number of points which isn't divisible by 8 to test the tail processing
+	const int num = 1003;
+	std::vector<float> x(num), y(num), z(num);
+	std::vector<float> xRef(num), yRef(num), zRef(num);
+
+	std::mt19937 gen(12345);
+	std::uniform_real_distribution<float> dist(-1000.0f, 1000.0f);
+
+	for (int i = 0; i < num; i++)
+	{
+		x[i] = dist(gen);
+		y[i] = dist(gen);
+		z[i] = dist(gen);
+
+		// compute the reference result
+		MathLib::VECTOR3D v(x[i], y[i], z[i]);
+		MathLib::VECTOR3D vt;
+		MathLib::Mat_Mul_VECTOR3D_4X4(&v, &m, &vt);
+
+		xRef[i] = vt.x;
+		yRef[i] = vt.y;
+		zRef[i] = vt.z;
+	}
+
+	// the kernels which are supported by this CPU
+	const MathLib::SIMD_LEVEL cpuLevel = MathLib::SIMD_Get_Level();
+
+	for (int level = MathLib::SIMD_LEVEL_SCALAR; level <= cpuLevel; level++)
+	{
+		std::vector<float> xOut(num), yOut(num), zOut(num);
+
+		MathLib::SIMD_Set_Max_Level((MathLib::SIMD_LEVEL)level);
+		MathLib::Mat_Mul_VECTOR3D_4X4_Batch(x.data(), y.data(), z.data(), &m,
+			xOut.data(), yOut.data(), zOut.data(), num);
+
+		// compare bit by bit
+		assert(memcmp(xOut.data(), xRef.data(), sizeof(float) * num) == 0);
+		assert(memcmp(yOut.data(), yRef.data(), sizeof(float) * num) == 0);
+		assert(memcmp(zOut.data(), zRef.data(), sizeof(float) * num) == 0);
+
+		// in-place transformation
+		std::vector<float> xIn(x), yIn(y), zIn(z);
+
+		MathLib::Mat_Mul_VECTOR3D_4X4_Batch(xIn.data(), yIn.data(), zIn.data(), &m,
+			xIn.data(), yIn.data(), zIn.data(), num);
+
+		assert(memcmp(xIn.data(), xRef.data(), sizeof(float) * num) == 0);
+		assert(memcmp(yIn.data(), yRef.data(), sizeof(float) * num) == 0);
+		assert(memcmp(zIn.data(), zRef.data(), sizeof(float) * num) == 0);
+	}
+
+	// restore the default SIMD level
+	MathLib::SIMD_Set_Max_Level(MathLib::SIMD_LEVEL_AVX2);
+
+	Log::Print(LOG_MACRO, std::string("batch transform: up to ") +
+		MathLib::SIMD_Level_Name(cpuLevel) + ": success");
+
+} // end Test_Matrices_Batch_Transform
+
+///////////////////////////////////////////////////////////
+
+void Tests::Test_Matrices_SIMD_Kernels()
+{
+	// this function tests SIMD kernels for 4x4 matrices against the scalar reference path
+
+	MathLib::MATRIX4X4A a, b;
+
+	// a general (projective) matrix
+	MathLib::Mat_Init_4X4(&a,
+		2.0f, 1.0f, 0.5f, 0.1f,
+		0.0f, 3.0f, 1.0f, 0.2f,
+		1.0f, 0.0f, 4.0f, 0.3f,
+		5.0f, 6.0f, 7.0f, 1.0f);
+
+	// an affine matrix (the last column is [0 0 0 1])
+	MathLib::Mat_Init_4X4(&b,
+		 0.0f, 2.0f, 0.0f, 0.0f,
+		-1.0f, 0.0f, 0.0f, 0.0f,
+		 0.0f, 0.0f, 0.5f, 0.0f,
+		 3.0f, 4.0f, 5.0f, 1.0f);
+
+	const MathLib::SIMD_LEVEL cpuLevel = MathLib::SIMD_Get_Level();
+
+	for (int level = MathLib::SIMD_LEVEL_SCALAR; level <= cpuLevel; level++)
+	{
+		MathLib::MATRIX4X4A ref, res;
+		MathLib::SIMD_Set_Max_Level((MathLib::SIMD_LEVEL)level);
+
+		// multiplication must be bit-compatible with Mat_Mul_4X4
+		MathLib::Mat_Mul_4X4(&a, &b, &ref);
+		MathLib::Mat_Mul_4X4_SIMD(&a, &b, &res);
+		assert(memcmp(&ref, &res, sizeof(MathLib::MATRIX4X4)) == 0);
+
+		// transpose
+		MathLib::MAT_TRANSPOSE_4X4(&a, &ref);
+		MathLib::Mat_Transpose_4X4_SIMD(&a, &res);
+		assert(memcmp(&ref, &res, sizeof(MathLib::MATRIX4X4)) == 0);
+
+		// general inverse: a * inverse(a) == I
+		assert(MathLib::Mat_Inverse_4X4_SIMD(&a, &res) == 1);
+		MathLib::Mat_Mul_4X4(&a, &res, &ref);
+
+		for (int i = 0; i < 16; i++)
+			assert(fabs(ref.M[i / 4][i % 4] - MathLib::IMAT_4X4.M[i / 4][i % 4]) < EPSILON_E4);
+
+		// affine inverse must match Mat_Inverse_4X4
+		MathLib::Mat_Inverse_4X4(&b, &ref);
+		assert(MathLib::Mat_Inverse_4X4_Affine_SIMD(&b, &res) == 1);
+
+		for (int i = 0; i < 16; i++)
+			assert(fabs(ref.M[i / 4][i % 4] - res.M[i / 4][i % 4]) < EPSILON_E5);
+
+		// singular matrix has no inverse
+		MathLib::MATRIX4X4 zero = {};
+		assert(MathLib::Mat_Inverse_4X4_SIMD(&zero, &res) == 0);
+		assert(MathLib::Mat_Inverse_4X4_Affine_SIMD(&zero, &res) == 0);
+	}
+
+	// restore the default SIMD level
+	MathLib::SIMD_Set_Max_Level(MathLib::SIMD_LEVEL_AVX2);
+
+	Log::Print(LOG_MACRO, "SIMD kernels for 4x4 matrices: success");
+
+} // end Test_Matrices_SIMD_Kernels
+
+///////////////////////////////////////////////////////////
+
+void Tests::Test_Matrices_Affine_4X3()
+{
+	// this function tests functional for affine transformations in 4x3 matrices;
+	// the results are compared with the same computations through 4x4 matrices
+
+	MathLib::MATRIX4X3 a, b, prod, inv;
+	MathLib::MATRIX4X4 a4, b4, prod4, inv4;
+
+	// rotation around Y-axis + translation (rigid transformation)
+	MathLib::Mat_Init_4X3(&a,
+		 0.8f, 0.0f, -0.6f,
+		 0.0f, 1.0f,  0.0f,
+		 0.6f, 0.0f,  0.8f,
+		 1.0f, 2.0f,  3.0f);
+
+	// non-uniform scaling + translation
+	MathLib::Mat_Init_4X3(&b,
+		 2.0f, 0.0f, 0.0f,
+		 0.0f, 3.0f, 0.0f,
+		 0.0f, 0.0f, 0.5f,
+		-4.0f, 5.0f, 6.0f);
+
+	MathLib::Mat_4X3_To_4X4(&a, &a4);
+	MathLib::Mat_4X3_To_4X4(&b, &b4);
+	assert((a4.M03 == 0) && (a4.M13 == 0) && (a4.M23 == 0) && (a4.M33 == 1));
+
+	// composition must be the same as for 4x4 matrices
+	MathLib::Mat_Mul_4X3(&a, &b, &prod);
+	MathLib::Mat_Mul_4X4(&a4, &b4, &prod4);
+
+	for (int r = 0; r < 4; r++)
+		for (int c = 0; c < 3; c++)
+			assert(prod.M[r][c] == prod4.M[r][c]);
+
+	// affine inverse must be the same as for 4x4 matrices
+	assert(MathLib::Mat_Inverse_4X3(&prod, &inv) == 1);
+	assert(MathLib::Mat_Inverse_4X4(&prod4, &inv4) == 1);
+
+	MathLib::MATRIX4X3 inv4x3;
+	MathLib::Mat_4X4_To_4X3(&inv4, &inv4x3);
+	assert(memcmp(&inv, &inv4x3, sizeof(MathLib::MATRIX4X3)) == 0);
+
+	// rigid inverse of a rigid transformation: a * inverse(a) == I
+	MathLib::Mat_Inverse_4X3_Rigid(&a, &inv);
+	MathLib::Mat_Mul_4X3(&a, &inv, &prod);
+
+	for (int r = 0; r < 4; r++)
+		for (int c = 0; c < 3; c++)
+			assert(fabs(prod.M[r][c] - MathLib::IMAT_4X3.M[r][c]) < EPSILON_E5);
+
+	// batch transformation of points must be bit-compatible with Mat_Mul_VECTOR3D_4X3
+	float x[5] = { 1, -2, 3, 0, 10 };
+	float y[5] = { 0, 5, -1, 0, 20 };
+	float z[5] = { 7, 1, 1, 0, 30 };
+	float xOut[5], yOut[5], zOut[5];
+
+	MathLib::Mat_Mul_VECTOR3D_4X3_Batch(x, y, z, &b, xOut, yOut, zOut, 5);
+
+	for (int i = 0; i < 5; i++)
+	{
+		MathLib::VECTOR3D v(x[i], y[i], z[i]);
+		MathLib::VECTOR3D vt;
+		MathLib::Mat_Mul_VECTOR3D_4X3(&v, &b, &vt);
+		assert((vt.x == xOut[i]) && (vt.y == yOut[i]) && (vt.z == zOut[i]));
+	}
+
+	// the normal of the plane x + y = 0 after scaling by (2, 3, 0.5):
+	// the plane becomes x/2 + y/3 = 0, so its normal is (1/2, 1/3, 0)
+	float nx[1] = { 1 }, ny[1] = { 1 }, nz[1] = { 0 };
+
+	assert(MathLib::Mat_Mul_Normal3D_4X3_Batch(nx, ny, nz, &b, nx, ny, nz, 1, 0) == 1);
+	assert(fabs(nx[0] - 0.5f) < EPSILON_E5);
+	assert(fabs(ny[0] - 1.0f / 3.0f) < EPSILON_E5);
+	assert(nz[0] == 0.0f);
+
+	Log::Print(LOG_MACRO, "affine 4x3 matrices: success");
+
+} // end Test_Matrices_Affine_4X3
+
+///////////////////////////////////////////////////////////
+
+void Tests::Test_Matrices_VecMat_Templates()
+{
+	// this function tests the generic Vec/Mat core: the functions must be computed at
+	// compile time, and the float versions must give exactly the same results as
+	// the legacy functions of PointVector3D.h and Matrix.h
+
+	// compile time computations (int)
+	constexpr MathLib::Vec3i a = { { 1, 2, 3 } };
+	constexpr MathLib::Vec3i b = { { 4, 5, 6 } };
+	constexpr MathLib::Mat3i m = { { { 2, 0, 1 }, { 1, 3, 0 }, { 0, 1, 4 } } };
+
+	static_assert(MathLib::Vec_Dot(a, b) == 32, "Vec_Dot");
+	static_assert(MathLib::Vec_Cross(a, b)[0] == -3 && MathLib::Vec_Cross(a, b)[1] == 6 && MathLib::Vec_Cross(a, b)[2] == -3, "Vec_Cross");
+	static_assert(MathLib::Vec_Sub(MathLib::Vec_Add(a, b), b)[2] == 3, "Vec_Add/Vec_Sub");
+	static_assert(MathLib::Mat_Det(m) == 25, "Mat_Det");
+	static_assert(MathLib::Mat_Mul(MathLib::Mat_Identity<3, int>(), m).M[2][2] == 4, "Mat_Mul");
+	static_assert(MathLib::Mat_Mul_Vec(a, m)[0] == 4 && MathLib::Mat_Mul_Vec(a, m)[2] == 13, "Mat_Mul_Vec");
+	static_assert(MathLib::Mat_Transpose(m).M[0][1] == 1, "Mat_Transpose");
+
+	assert(MathLib::Vec_Length(MathLib::Vec3i{ { 3, 4, 0 } }) == 5.0f);
+
+	// float versions vs the legacy functions
+	std::mt19937 gen(21);
+	std::uniform_real_distribution<float> dist(-10.0f, 10.0f);
+
+	for (int iter = 0; iter < 100; iter++)
+	{
+		const MathLib::VECTOR3D va(dist(gen), dist(gen), dist(gen));
+		const MathLib::VECTOR3D vb(dist(gen), dist(gen), dist(gen));
+		const MathLib::VECTOR4D v4(dist(gen), dist(gen), dist(gen), 1.0f);
+		const float k = dist(gen);
+
+		const MathLib::Vec3f fa = MathLib::To_Vec(va);
+		const MathLib::Vec3f fb = MathLib::To_Vec(vb);
+		MathLib::VECTOR3D ref;
+		MathLib::Vec3f res;
+
+		ref = MathLib::VECTOR3D_Add(va, vb);
+		res = MathLib::Vec_Add(fa, fb);
+		assert(memcmp(&ref, &res, sizeof(ref)) == 0);
+
+		ref = MathLib::VECTOR3D_Sub(va, vb);
+		res = MathLib::Vec_Sub(fa, fb);
+		assert(memcmp(&ref, &res, sizeof(ref)) == 0);
+
+		MathLib::VECTOR3D_Scale(k, va, ref);
+		res = MathLib::Vec_Scale(k, fa);
+		assert(memcmp(&ref, &res, sizeof(ref)) == 0);
+
+		ref = MathLib::VECTOR3D_Cross(va, vb);
+		res = MathLib::Vec_Cross(fa, fb);
+		assert(memcmp(&ref, &res, sizeof(ref)) == 0);
+
+		ref = va;
+		MathLib::VECTOR3D_Normalize(ref);
+		res = MathLib::Vec_Normalize(fa);
+		assert(memcmp(&ref, &res, sizeof(ref)) == 0);
+
+		assert(MathLib::VECTOR3D_Dot(va, vb) == MathLib::Vec_Dot(fa, fb));
+		assert(MathLib::VECTOR3D_Length(va) == MathLib::Vec_Length(fa));
+
+		const MathLib::VECTOR3D back = MathLib::To_VECTOR3D(fa);
+		assert((back.x == va.x) && (back.y == va.y) && (back.z == va.z));
+
+		// matrices
+		MathLib::MATRIX4X4 m4a, m4b, m4prod;
+		MathLib::MATRIX3X3 m3, m3inv;
+		MathLib::MATRIX2X2 m2, m2inv;
+
+		for (int r = 0; r < 4; r++)
+		{
+			for (int c = 0; c < 4; c++)
+			{
+				m4a.M[r][c] = dist(gen);
+				m4b.M[r][c] = dist(gen);
+
+				if ((r < 3) && (c < 3))
+					m3.M[r][c] = dist(gen);
+
+				if ((r < 2) && (c < 2))
+					m2.M[r][c] = dist(gen);
+			}
+		}
+
+		MathLib::Mat_Mul_4X4(&m4a, &m4b, &m4prod);
+		const MathLib::Mat4f prod = MathLib::Mat_Mul(MathLib::To_Mat(m4a.M), MathLib::To_Mat(m4b.M));
+		assert(memcmp(&m4prod, &prod, sizeof(m4prod)) == 0);
+
+		MathLib::VECTOR4D v4prod;
+		MathLib::Mat_Mul_VECTOR4D_4X4(&v4, &m4a, &v4prod);
+		const MathLib::Vec4f res4 = MathLib::Mat_Mul_Vec(MathLib::To_Vec(v4), MathLib::To_Mat(m4a.M));
+		assert(memcmp(&v4prod, &res4, sizeof(v4prod)) == 0);
+
+		MathLib::Mat3f inv3;
+		assert(MathLib::Mat_Inverse_3X3(&m3, &m3inv) == MathLib::Mat_Inverse(MathLib::To_Mat(m3.M), inv3));
+		assert(MathLib::Mat_Det_3X3(&m3) == MathLib::Mat_Det(MathLib::To_Mat(m3.M)));
+		assert(memcmp(&m3inv, &inv3, sizeof(m3inv)) == 0);
+
+		MathLib::Mat2f inv2;
+		assert(MathLib::Mat_Inverse_2X2(&m2, &m2inv) == MathLib::Mat_Inverse(MathLib::To_Mat(m2.M), inv2));
+		assert(memcmp(&m2inv, &inv2, sizeof(m2inv)) == 0);
+
+		MathLib::MATRIX4X4 m4back;
+		MathLib::To_Array(prod, m4back.M);
+		assert(memcmp(&m4back, &m4prod, sizeof(m4prod)) == 0);
+	}
+
+	// a matrix with a small determinant is singular for float (EPSILON_E5) but not for double
+	const MathLib::Mat2f small = { { { 1e-3f, 0.0f }, { 0.0f, 1e-3f } } };
+	const MathLib::Mat2d smallD = { { { 1e-3, 0.0 }, { 0.0, 1e-3 } } };
+	MathLib::Mat2f smallInv;
+	MathLib::Mat2d smallInvD;
+
+	assert(MathLib::Mat_Inverse(small, smallInv) == 0);
+	assert(smallInv.M[0][0] == 0.0f);
+	assert(MathLib::Mat_Inverse(smallD, smallInvD) == 1);
+	assert(fabs(smallInvD.M[0][0] - 1000.0) < 1e-9);
+
+	Log::Print(LOG_MACRO, "generic Vec/Mat templates: success");
+
+} // end Test_Matrices_VecMat_Templates
+
+///////////////////////////////////////////////////////////
+
+void Tests::Test_Matrices_VecMat_Expressions()
+{
+	// this function tests the expression templates: an expression must give exactly
+	// the same result as the chain of the legacy functions, for single values and
+	// for arrays (with single values used for each element)
+
+	std::mt19937 gen(22);
+	std::uniform_real_distribution<float> dist(-10.0f, 10.0f);
+
+	const int num = 1000;
+	std::vector<MathLib::VECTOR3D> a(num), b(num), c(num), r(num);
+	const MathLib::VECTOR3D center(dist(gen), dist(gen), dist(gen));
+	const float k = dist(gen);
+
+	for (int i = 0; i < num; i++)
+	{
+		a[i] = MathLib::VECTOR3D(dist(gen), dist(gen), dist(gen));
+		b[i] = MathLib::VECTOR3D(dist(gen), dist(gen), dist(gen));
+		c[i] = MathLib::VECTOR3D(dist(gen), dist(gen), dist(gen));
+	}
+
+	// single values: a + b*k - c
+	for (int i = 0; i < num; i++)
+	{
+		MathLib::VECTOR3D scaled;
+		MathLib::VECTOR3D_Scale(k, b[i], scaled);
+		const MathLib::VECTOR3D ref = MathLib::VECTOR3D_Sub(MathLib::VECTOR3D_Add(a[i], scaled), c[i]);
+
+		const MathLib::VECTOR3D res = a[i] + b[i]*k - c[i];
+		const MathLib::Vec3f resV = MathLib::To_Vec(a[i]) + k*MathLib::To_Vec(b[i]) - c[i];
+
+		assert(memcmp(&ref, &res, sizeof(ref)) == 0);
+		assert(memcmp(&ref, &resV, sizeof(ref)) == 0);
+	}
+
+	// arrays: (a + b*k - c) - center, and the same in place
+	MathLib::Expr_Array(r.data(), num) = MathLib::Expr_Array(a.data(), num) + MathLib::Expr_Array(b.data(), num)*k -
+		MathLib::Expr_Array(c.data(), num) - center;
+
+	std::vector<MathLib::VECTOR3D> inPlace = a;
+	MathLib::Expr_Array(inPlace.data(), num) += MathLib::Expr_Array(b.data(), num)*k - MathLib::Expr_Array(c.data(), num);
+	MathLib::Expr_Array(inPlace.data(), num) -= center;
+
+	for (int i = 0; i < num; i++)
+	{
+		MathLib::VECTOR3D scaled;
+		MathLib::VECTOR3D_Scale(k, b[i], scaled);
+		const MathLib::VECTOR3D ref = MathLib::VECTOR3D_Sub(MathLib::VECTOR3D_Sub(MathLib::VECTOR3D_Add(a[i], scaled), c[i]), center);
+		const MathLib::VECTOR3D refInPlace = MathLib::VECTOR3D_Sub(MathLib::VECTOR3D_Add(a[i], MathLib::VECTOR3D_Sub(scaled, c[i])), center);
+
+		assert(memcmp(&ref, &r[i], sizeof(ref)) == 0);
+		assert(memcmp(&refInPlace, &inPlace[i], sizeof(ref)) == 0);
+	}
+
+	// a value for each element and the negation
+	MathLib::Expr_Array(r.data(), num) = -center;
+	assert((r[num - 1].x == -center.x) && (r[num - 1].y == -center.y) && (r[num - 1].z == -center.z));
+
+	// matrices: v * (A*B + A) and arrays of vectors by a matrix
+	MathLib::MATRIX4X4 m4a, m4b, m4prod, m4sum;
+
+	for (int row = 0; row < 4; row++)
+	{
+		for (int col = 0; col < 4; col++)
+		{
+			m4a.M[row][col] = dist(gen);
+			m4b.M[row][col] = dist(gen);
+		}
+	}
+
+	const MathLib::Mat4f ma = MathLib::To_Mat(m4a.M);
+	const MathLib::Mat4f mb = MathLib::To_Mat(m4b.M);
+	const MathLib::VECTOR4D v4(dist(gen), dist(gen), dist(gen), 1.0f);
+
+	MathLib::Mat_Mul_4X4(&m4a, &m4b, &m4prod);
+	MathLib::Mat_Add_4X4(&m4prod, &m4a, &m4sum);
+
+	MathLib::VECTOR4D v4ref;
+	MathLib::Mat_Mul_VECTOR4D_4X4(&v4, &m4sum, &v4ref);
+
+	const MathLib::Mat4f sum = ma*mb + ma;
+	const MathLib::Vec4f v4res = MathLib::Expr_Eval(MathLib::To_Vec(v4) * (ma*mb + ma));
+
+	assert(memcmp(&m4sum, &sum, sizeof(m4sum)) == 0);
+	assert(memcmp(&v4ref, &v4res, sizeof(v4ref)) == 0);
+
+	std::vector<MathLib::Vec4f> pts(num), ptsRes(num);
+
+	for (int i = 0; i < num; i++)
+		pts[i] = MathLib::Vec4f{ { dist(gen), dist(gen), dist(gen), 1.0f } };
+
+	MathLib::Expr_Array(ptsRes.data(), num) = MathLib::Expr_Array(pts.data(), num) * ma;
+
+	for (int i = 0; i < num; i++)
+	{
+		MathLib::VECTOR4D p(pts[i][0], pts[i][1], pts[i][2], pts[i][3]);
+		MathLib::Mat_Mul_VECTOR4D_4X4(&p, &m4a, &v4ref);
+		assert(memcmp(&v4ref, &ptsRes[i], sizeof(v4ref)) == 0);
+	}
+
+	// int expressions
+	const MathLib::Vec3i vi = MathLib::Vec3i{ { 1, 2, 3 } } * 2 - MathLib::Vec3i{ { 1, 1, 1 } };
+	assert((vi[0] == 1) && (vi[1] == 3) && (vi[2] == 5));
+
+	Log::Print(LOG_MACRO, "Vec/Mat expression templates: success");
+
+} // end Test_Matrices_VecMat_Expressions
+
+///////////////////////////////////////////////////////////
+
+void Tests::Test_Matrices_Mixed_Precision()
+{
+	// this function tests double and mixed precision functions: the float versions of
+	// quaternions/planes must be the same as the legacy functions, the kernels must give
+	// the same results, and the rebased float transformation must be precise far from
+	// the origin (where the plain float transformation isn't)
+
+	std::mt19937 gen(23);
+	std::uniform_real_distribution<float> dist(-5.0f, 5.0f);
+
+	// quaternions and planes vs the legacy functions
+	for (int iter = 0; iter < 100; iter++)
+	{
+		MathLib::QUAT q1(dist(gen), dist(gen), dist(gen), dist(gen));
+		MathLib::QUAT q2(dist(gen), dist(gen), dist(gen), dist(gen));
+		const MathLib::VECTOR3D v(dist(gen), dist(gen), dist(gen));
+		const MathLib::PLANE3D plane(MathLib::VECTOR3D(dist(gen), dist(gen), dist(gen)), MathLib::VECTOR3D(dist(gen), dist(gen), dist(gen)));
+
+		MathLib::QUAT_Normalize(q1);
+
+		MathLib::QUAT qprod;
+		MathLib::VECTOR3D vr;
+		MathLib::MATRIX3X3 mr;
+
+		MathLib::QUAT_Mul(q1, q2, qprod);
+		MathLib::QUAT_Rotate_VECTOR3D(q1, v, vr);
+		MathLib::QUAT_To_MATRIX3X3(q1, &mr);
+
+		const MathLib::Quatf prod = MathLib::Quat_Mul(MathLib::To_Quat(q1), MathLib::To_Quat(q2));
+		const MathLib::Vec3f rotated = MathLib::Quat_Rotate(MathLib::To_Quat(q1), MathLib::To_Vec(v));
+		const MathLib::Mat3f rotation = MathLib::Quat_To_Mat3(MathLib::To_Quat(q1));
+
+		assert(memcmp(&qprod, &prod, sizeof(prod)) == 0);
+		assert(memcmp(&vr, &rotated, sizeof(rotated)) == 0);
+		assert(memcmp(&mr, &rotation, sizeof(rotation)) == 0);
+		assert(MathLib::Compute_Point_In_Plane3D(v, plane) == MathLib::Plane_Point_Location(MathLib::To_Plane(plane), MathLib::To_Vec(v)));
+
+		const MathLib::QUAT qback = MathLib::To_QUAT(MathLib::Quat_Cast<float>(MathLib::Quat_Cast<double>(prod)));
+		assert(memcmp(&qback, &qprod, sizeof(qprod)) == 0);
+	}
+
+	// an object and a camera far from the origin (the float step there is 1 m)
+	const MathLib::Quatd rotation = MathLib::Quat_Normalize(MathLib::Quatd{ 0.9, 0.1, -0.3, 0.2 });
+	const MathLib::Vec3d position = { { 1.0e7 + 0.3, -2.0e6 + 0.7, 5.0e6 + 0.1 } };
+	const MathLib::Vec3d camera = { { position[0] + 3.25, position[1] - 1.5, position[2] + 2.0 } };
+	const MathLib::Mat4d world = MathLib::Mat_World(rotation, 1.5, position);
+
+	// the inverse of the world matrix
+	MathLib::Mat4d worldInv;
+	assert(MathLib::Mat_Inverse_Affine(world, worldInv) == 1);
+
+	const MathLib::Mat4d ident = MathLib::Mat_Mul(world, worldInv);
+
+	for (int row = 0; row < 4; row++)
+		for (int col = 0; col < 4; col++)
+			assert(fabs(ident.M[row][col] - ((row == col) ? 1.0 : 0.0)) < 1e-9);
+
+	// the local geometry
+	const int num = 1003;
+	std::vector<float> x(num), y(num), z(num);
+
+	for (int i = 0; i < num; i++)
+	{
+		x[i] = dist(gen);
+		y[i] = dist(gen);
+		z[i] = dist(gen);
+	}
+
+	// each kernel gives the same double world points
+	std::vector<double> xRef(num), yRef(num), zRef(num);
+	MathLib::Mat_Mul_VECTOR3D_4X4D_Batch_Scalar(x.data(), y.data(), z.data(), world, xRef.data(), yRef.data(), zRef.data(), num);
+
+	const MathLib::SIMD_LEVEL cpuLevel = MathLib::SIMD_Get_Level();
+
+	for (int level = MathLib::SIMD_LEVEL_SCALAR; level <= cpuLevel; level++)
+	{
+		std::vector<double> xOut(num), yOut(num), zOut(num);
+
+		MathLib::SIMD_Set_Max_Level((MathLib::SIMD_LEVEL)level);
+		MathLib::Mat_Mul_VECTOR3D_4X4D_Batch(x.data(), y.data(), z.data(), world, xOut.data(), yOut.data(), zOut.data(), num);
+
+		assert(memcmp(xOut.data(), xRef.data(), num * sizeof(double)) == 0);
+		assert(memcmp(yOut.data(), yRef.data(), num * sizeof(double)) == 0);
+		assert(memcmp(zOut.data(), zRef.data(), num * sizeof(double)) == 0);
+	}
+
+	// restore the default SIMD level
+	MathLib::SIMD_Set_Max_Level(MathLib::SIMD_LEVEL_AVX2);
+
+	// the double world points relative to the camera (as the reference) vs:
+	//   - the rebased float transformation;
+	//   - the rebasing of the double world points;
+	//   - the plain float transformation (the float world matrix and camera)
+	std::vector<float> xRel(num), yRel(num), zRel(num);
+	std::vector<float> xRelP(num), yRelP(num), zRelP(num);
+	std::vector<float> xFlt(num), yFlt(num), zFlt(num);
+
+	MathLib::Mat_Mul_VECTOR3D_4X4D_Rebased_Batch(x.data(), y.data(), z.data(), world, camera,
+		xRel.data(), yRel.data(), zRel.data(), num);
+
+	MathLib::POINT3D_Rebase_Batch(xRef.data(), yRef.data(), zRef.data(), camera,
+		xRelP.data(), yRelP.data(), zRelP.data(), num);
+
+	MathLib::MATRIX4X4 worldF;
+	MathLib::To_Array(MathLib::Mat_Cast<float>(world), worldF.M);
+	MathLib::Mat_Mul_VECTOR3D_4X4_Batch(x.data(), y.data(), z.data(), &worldF, xFlt.data(), yFlt.data(), zFlt.data(), num);
+
+	double maxErrRebased = 0.0;
+	double maxErrPoints = 0.0;
+	double maxErrFloat = 0.0;
+
+	for (int i = 0; i < num; i++)
+	{
+		const double rx = xRef[i] - camera[0];
+		const double ry = yRef[i] - camera[1];
+		const double rz = zRef[i] - camera[2];
+
+		maxErrRebased = std::max(maxErrRebased, std::max(fabs(xRel[i] - rx), std::max(fabs(yRel[i] - ry), fabs(zRel[i] - rz))));
+		maxErrPoints  = std::max(maxErrPoints, std::max(fabs(xRelP[i] - rx), std::max(fabs(yRelP[i] - ry), fabs(zRelP[i] - rz))));
+
+		const float fx = xFlt[i] - (float)camera[0];
+		const float fy = yFlt[i] - (float)camera[1];
+		const float fz = zFlt[i] - (float)camera[2];
+
+		maxErrFloat = std::max(maxErrFloat, std::max(fabs(fx - rx), std::max(fabs(fy - ry), fabs(fz - rz))));
+	}
+
+	assert(maxErrRebased < 1e-5);
+	assert(maxErrPoints < 1e-6);
+	assert(maxErrFloat > 0.1);
+
+	Log::Print(LOG_MACRO, "mixed precision: success");
+
+} // end Test_Matrices_Mixed_Precision
+
+///////////////////////////////////////////////////////////
+
+void Tests::Test_Matrices_Packed_Half()
+{
+	// this function tests packed fp16/bf16 storage: the scalar conversions must round
+	// to nearest even, each batch kernel must give the same bits as the scalar
+	// conversions, and the transformation of packed vectors must be the same as
+	// packing of the result of Mat_Mul_VECTOR4D_4X4
+
+	// known values
+	assert(MathLib::Float_To_Half(1.0f) == 0x3c00);
+	assert(MathLib::Float_To_Half(-0.0f) == 0x8000);
+	assert(MathLib::Float_To_Half(65504.0f) == 0x7bff);
+	assert(MathLib::Float_To_Half(65519.0f) == 0x7bff);
+	assert(MathLib::Float_To_Half(65520.0f) == 0x7c00);
+	assert(MathLib::Float_To_Half(ldexpf(1.0f, -24)) == 0x0001);        // the least denormal
+	assert(MathLib::Float_To_Half(ldexpf(1.0f, -25)) == 0x0000);        // a tie: to even
+	assert(MathLib::Float_To_Half(1.0f + ldexpf(1.0f, -11)) == 0x3c00); // a tie: to even
+	assert(MathLib::Float_To_Half(1.0f + ldexpf(3.0f, -11)) == 0x3c02); // a tie: to even
+	assert(MathLib::Half_To_Float(0x0001) == ldexpf(1.0f, -24));
+	assert(MathLib::Half_To_Float(0xc000) == -2.0f);
+	assert(std::isinf(MathLib::Half_To_Float(0x7c00)));
+
+	assert(MathLib::Float_To_BF16(1.0f) == 0x3f80);
+	assert(MathLib::Float_To_BF16(1.0f + ldexpf(1.0f, -8)) == 0x3f80);  // a tie: to even
+	assert(MathLib::Float_To_BF16(FLT_MAX) == 0x7f80);                  // the infinity
+	assert(MathLib::BF16_To_Float(0xbf80) == -1.0f);
+
+	// all the packed values: unpacking by each kernel and the round trip
+	const int numAll = 65536;
+	std::vector<uint16_t> all(numAll), packed(numAll);
+	std::vector<float> unpackedRef(numAll), unpacked(numAll);
+
+	for (int i = 0; i < numAll; i++)
+		all[i] = (uint16_t)i;
+
+	const MathLib::SIMD_LEVEL cpuLevel = MathLib::SIMD_Get_Level();
+
+	for (int format = 0; format < 2; format++)
+	{
+		// format 0: fp16, format 1: bf16
+		const uint16_t quietBit = (format == 0) ? 0x200 : 0x40;
+
+		if (format == 0)
+			MathLib::Half_To_Float_Batch_Scalar(all.data(), unpackedRef.data(), numAll);
+		else
+			MathLib::BF16_To_Float_Batch_Scalar(all.data(), unpackedRef.data(), numAll);
+
+		for (int level = MathLib::SIMD_LEVEL_SCALAR; level <= cpuLevel; level++)
+		{
+			MathLib::SIMD_Set_Max_Level((MathLib::SIMD_LEVEL)level);
+
+			if (format == 0)
+			{
+				MathLib::Half_To_Float_Batch(all.data(), unpacked.data(), numAll);
+				MathLib::Float_To_Half_Batch(unpacked.data(), packed.data(), numAll);
+			}
+			else
+			{
+				MathLib::BF16_To_Float_Batch(all.data(), unpacked.data(), numAll);
+				MathLib::Float_To_BF16_Batch(unpacked.data(), packed.data(), numAll);
+			}
+
+			assert(memcmp(unpacked.data(), unpackedRef.data(), numAll * sizeof(float)) == 0);
+
+			for (int i = 0; i < numAll; i++)
+			{
+				const bool isNan = std::isnan(unpackedRef[i]);
+				assert(packed[i] == (isNan ? (all[i] | quietBit) : all[i]));
+			}
+		}
+	}
+
+	// packing of arbitrary floats (all the classes of values) by each kernel
+	std::mt19937 gen(24);
+	const int numRand = 100003;
+	std::vector<float> floats(numRand);
+	std::vector<uint16_t> halfRef(numRand), bf16Ref(numRand), packedH(numRand), packedB(numRand);
+
+	for (int i = 0; i < numRand; i++)
+	{
+		const uint32_t bits = (uint32_t)gen();
+		memcpy(&floats[i], &bits, sizeof(float));
+	}
+
+	// also the values near the limits of fp16 (denormals, overflow, ties)
+	for (int i = 0; i < 4096; i++)
+	{
+		floats[i] = ldexpf(1.0f + (float)i / 4096.0f, -26 + (i % 44));
+		floats[numRand - 1 - i] = -floats[i];
+	}
+
+	MathLib::Float_To_Half_Batch_Scalar(floats.data(), halfRef.data(), numRand);
+	MathLib::Float_To_BF16_Batch_Scalar(floats.data(), bf16Ref.data(), numRand);
+
+	for (int level = MathLib::SIMD_LEVEL_SCALAR; level <= cpuLevel; level++)
+	{
+		MathLib::SIMD_Set_Max_Level((MathLib::SIMD_LEVEL)level);
+		MathLib::Float_To_Half_Batch(floats.data(), packedH.data(), numRand);
+		MathLib::Float_To_BF16_Batch(floats.data(), packedB.data(), numRand);
+
+		assert(memcmp(packedH.data(), halfRef.data(), numRand * sizeof(uint16_t)) == 0);
+		assert(memcmp(packedB.data(), bf16Ref.data(), numRand * sizeof(uint16_t)) == 0);
+	}
+
+	// restore the default SIMD level
+	MathLib::SIMD_Set_Max_Level(MathLib::SIMD_LEVEL_AVX2);
+
+	// bounds of the relative error (the normal range of fp16)
+	std::uniform_real_distribution<float> dist(-1000.0f, 1000.0f);
+
+	for (int i = 0; i < 10000; i++)
+	{
+		const float f = dist(gen);
+
+		if (fabs(f) < ldexpf(1.0f, -14))
+			continue;
+
+		assert(fabs(MathLib::Half_To_Float(MathLib::Float_To_Half(f)) - f) <= fabs(f) * ldexpf(1.0f, -11));
+		assert(fabs(MathLib::BF16_To_Float(MathLib::Float_To_BF16(f)) - f) <= fabs(f) * ldexpf(1.0f, -8));
+	}
+
+	// packing of vectors and quaternions
+	const int num = 1003;
+	std::vector<MathLib::VECTOR3D> v3(num), v3back(num);
+	std::vector<MathLib::VECTOR4D> v4(num), v4back(num);
+	std::vector<MathLib::QUAT> q(num), qback(num);
+	std::vector<MathLib::VECTOR3D_F16> v3h(num);
+	std::vector<MathLib::VECTOR4D_F16> v4h(num), v4hRes(num), v4hRef(num);
+	std::vector<MathLib::VECTOR4D_BF16> v4b(num), v4bRes(num), v4bRef(num);
+	std::vector<MathLib::QUAT_BF16> qb(num);
+	std::uniform_real_distribution<float> distV(-10.0f, 10.0f);
+
+	for (int i = 0; i < num; i++)
+	{
+		v3[i] = MathLib::VECTOR3D(distV(gen), distV(gen), distV(gen));
+		v4[i] = MathLib::VECTOR4D(distV(gen), distV(gen), distV(gen), 1.0f);
+		q[i] = MathLib::QUAT(distV(gen), distV(gen), distV(gen), distV(gen));
+	}
+
+	MathLib::Pack_Batch(v3.data(), v3h.data(), num);
+	MathLib::Pack_Batch(v4.data(), v4h.data(), num);
+	MathLib::Pack_Batch(v4.data(), v4b.data(), num);
+	MathLib::Pack_Batch(q.data(), qb.data(), num);
+
+	MathLib::Unpack_Batch(v3h.data(), v3back.data(), num);
+	MathLib::Unpack_Batch(v4h.data(), v4back.data(), num);
+	MathLib::Unpack_Batch(qb.data(), qback.data(), num);
+
+	for (int i = 0; i < num; i++)
+	{
+		for (int k = 0; k < 3; k++)
+			assert(v3back[i].M[k] == MathLib::Half_To_Float(MathLib::Float_To_Half(v3[i].M[k])));
+
+		for (int k = 0; k < 4; k++)
+		{
+			assert(v4back[i].M[k] == MathLib::Half_To_Float(MathLib::Float_To_Half(v4[i].M[k])));
+			assert(qback[i].M[k] == MathLib::BF16_To_Float(MathLib::Float_To_BF16(q[i].M[k])));
+		}
+	}
+
+	// transformation of packed vectors: the reference is Mat_Mul_VECTOR4D_4X4
+	MathLib::MATRIX4X4 m;
+
+	for (int row = 0; row < 4; row++)
+		for (int col = 0; col < 4; col++)
+			m.M[row][col] = distV(gen) * 0.2f;
+
+	for (int i = 0; i < num; i++)
+	{
+		MathLib::VECTOR4D vh, vb, vhRes, vbRes;
+
+		for (int k = 0; k < 4; k++)
+		{
+			vh.M[k] = MathLib::Half_To_Float(v4h[i].M[k]);
+			vb.M[k] = MathLib::BF16_To_Float(v4b[i].M[k]);
+		}
+
+		MathLib::Mat_Mul_VECTOR4D_4X4(&vh, &m, &vhRes);
+		MathLib::Mat_Mul_VECTOR4D_4X4(&vb, &m, &vbRes);
+
+		for (int k = 0; k < 4; k++)
+		{
+			v4hRef[i].M[k] = MathLib::Float_To_Half(vhRes.M[k]);
+			v4bRef[i].M[k] = MathLib::Float_To_BF16(vbRes.M[k]);
+		}
+	}
+
+	for (int level = MathLib::SIMD_LEVEL_SCALAR; level <= cpuLevel; level++)
+	{
+		MathLib::SIMD_Set_Max_Level((MathLib::SIMD_LEVEL)level);
+
+		MathLib::Mat_Mul_VECTOR4D_4X4_F16_Batch(v4h.data(), &m, v4hRes.data(), num);
+		MathLib::Mat_Mul_VECTOR4D_4X4_BF16_Batch(v4b.data(), &m, v4bRes.data(), num);
+
+		assert(memcmp(v4hRes.data(), v4hRef.data(), num * sizeof(MathLib::VECTOR4D_F16)) == 0);
+		assert(memcmp(v4bRes.data(), v4bRef.data(), num * sizeof(MathLib::VECTOR4D_BF16)) == 0);
+
+		// in place
+		v4hRes = v4h;
+		MathLib::Mat_Mul_VECTOR4D_4X4_F16_Batch(v4hRes.data(), &m, v4hRes.data(), num);
+		assert(memcmp(v4hRes.data(), v4hRef.data(), num * sizeof(MathLib::VECTOR4D_F16)) == 0);
+	}
+
+	// restore the default SIMD level
+	MathLib::SIMD_Set_Max_Level(MathLib::SIMD_LEVEL_AVX2);
+
+	Log::Print(LOG_MACRO, "packed fp16/bf16 storage: success");
+
+} // end Test_Matrices_Packed_Half
+
+///////////////////////////////////////////////////////////
+
 void Tests::Test_Parametric_Lines()
 {
 	try
@@ -527,7 +1670,7 @@ void Tests::Test_Parametric_Lines_2D_Intersection()
 	}
 	else
 	{
-		throw new std::exception("2D param lines: CASE 1: no intersection: INCORRECT RESULT");
+		throw std::runtime_error("2D param lines: CASE 1: no intersection: INCORRECT RESULT");
 	}
 
 	/////////////////////////////////////////////////////////////
@@ -551,7 +1694,7 @@ void Tests::Test_Parametric_Lines_2D_Intersection()
 	}
 	else
 	{
-		throw new std::exception("2D param lines: CASE 2: segment intersection: INCORRECT RESULT");
+		throw std::runtime_error("2D param lines: CASE 2: segment intersection: INCORRECT RESULT");
 	}
 
 	/////////////////////////////////////////////////////////////
@@ -576,7 +1719,7 @@ void Tests::Test_Parametric_Lines_2D_Intersection()
 	}
 	else
 	{
-		throw new std::exception("2D param lines: lines intersection: INCORRECT RESULT");
+		throw std::runtime_error("2D param lines: lines intersection: INCORRECT RESULT");
 	}
 
 	/////////////////////////////////////////////////////////////
@@ -601,7 +1744,7 @@ void Tests::Test_Parametric_Lines_2D_Intersection()
 	}
 	else
 	{
-		throw new std::exception("2D param lines: lines coincide: INCORRECT RESULT");
+		throw std::runtime_error("2D param lines: lines coincide: INCORRECT RESULT");
 	}
 
 } // end Test_Parametric_Lines_2D_Intersection
@@ -622,6 +1765,7 @@ void Tests::Test_3D_Planes()
 
 	Test_3D_Point_Pos_Relative_To_3D_Plane();
 	Test_Intersection_Plane3D_PARAMLINE3D();
+	Test_Intersection_Plane3D_PARAMLINE3D_Batch();
 
 	
 } // end Test_3D_Planes
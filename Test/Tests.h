@@ -7,12 +7,40 @@
 #pragma once
 
 #include <cassert>
+#include <cfloat>
 #include <iomanip>
+#include <vector>
+#include <random>
 
 #include "../Log/Log.h"
 #include "../Matrix/Matrix.h"
+#include "../Matrix/MatrixBatch.h"
+#include "../Matrix/MatrixSimd.h"
+#include "../Matrix/MatrixAffine.h"
+#include "../Matrix/VecMat.h"
+#include "../Matrix/VecExpr.h"
+#include "../Matrix/MixedPrecision.h"
+#include "../Matrix/MatrixPacked.h"
+#include "../CoordinateSystem.h"
+#include "../CoordinateSystemBatch.h"
+#include "../CoordinateSystemScan.h"
+#include "../Utils/Atan2.h"
+#include "../Utils/Simd.h"
+#include "../Utils/SinCos.h"
+#include "../Utils/Utils.h"
+#include "../Figures/BoundingVolumes.h"
+#include "../Figures/BVH.h"
 #include "../Figures/Figures.h"
+#include "../Figures/FiguresBatch.h"
+#include "../Figures/Frustum.h"
+#include "../Figures/Segments2D.h"
+#include "../Figures/Triangles.h"
+#include "../FixedPoint/FixedPoint.h"
 #include "../Quaternion/Quaternion.h"
+#include "../Quaternion/QuaternionBatch.h"
+#include "../Quaternion/QuaternionMatrix.h"
+#include "../Quaternion/QuaternionPacked.h"
+#include "../VectorAndPoint/VectorPacked.h"
 
 
 class Tests
@@ -23,6 +51,8 @@ public:
 	void Test_Matrices();
 	void Test_Figures();
 	void Test_Quaternions();
+	void Test_Utils();
+	void Test_Fixed_Point();
 	
 
 
@@ -35,12 +65,34 @@ private:
 
 	void Test_2D_Vectors_Points_Init_And_Inline_Func();
 	void Test_2D_Vectors_Math_Operations();
+	void Test_3D_Vectors_Oct_Packing();
 
 	// MATRICEs functional testing
 	void Test_Matrix_Init();
 	void Test_Matrices_Print_Func();
 	void Test_Matrices_Add_Func();
 	void Test_Matrices_Multiplication_Func();
+	void Test_Matrices_Batch_Transform();
+	void Test_Matrices_SIMD_Kernels();
+	void Test_Matrices_Affine_4X3();
+	void Test_Matrices_VecMat_Templates();
+	void Test_Matrices_VecMat_Expressions();
+	void Test_Matrices_Mixed_Precision();
+	void Test_Matrices_Packed_Half();
+
+	// COORDINATE SYSTEMs functional testing
+	void Test_Coordinate_Systems_Single();
+	void Test_Coordinate_Systems_Batch();
+	void Test_Coordinate_Systems_Scan();
+
+	// UTILs functional testing
+	void Test_SinCos();
+	void Test_Atan2();
+	void Test_Trig_Tables();
+
+	// FIXED-POINT functional testing
+	void Test_Fixed_Point_Arithmetic();
+	void Test_Fixed_Point_Transform();
 
 	// PARAMETRIC LINES functional testing
 	void Test_Parametric_Lines();
@@ -51,8 +103,24 @@ private:
 	void Test_3D_Planes();
 	void Test_3D_Point_Pos_Relative_To_3D_Plane();
 	void Test_Intersection_Plane3D_PARAMLINE3D();
+	void Test_Intersection_Plane3D_PARAMLINE3D_Batch();
 	void Test_Distance_From_Point3D_To_Plane3D();
 
+	// BOUNDING VOLUMEs functional testing
+	void Test_Bounding_Volumes();
+
+	// BVH functional testing
+	void Test_BVH();
+
+	// FRUSTUM functional testing
+	void Test_Frustum();
+
+	// TRIANGLEs functional testing
+	void Test_Triangles();
+
+	// 2D SEGMENTs intersection testing
+	void Test_Segments2D();
+
 private:
 	MathLib::MATRIX2X2 iMat2x2_;  // identity 2x2 matrix
 	MathLib::MATRIX3X3 iMat3x3_;  // identity 3x3 matrix
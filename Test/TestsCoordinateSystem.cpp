@@ -0,0 +1,353 @@
+/////////////////////////////////////////////////////////////////////////////////////////////
+// Filename:      TestsCoordinateSystem.cpp
+// Description:   contains implementation of functional for testing conversion
+//                between coordinate systems (single, batch and streaming)
+//
+// Created:       17.10.26
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "Tests.h"
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                PUBLIC FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void Tests::Test_Coordinate_Systems()
+{
+	Log::Print("\n\n");
+	Log::Print("---------------- TEST: COORDINATE SYSTEMS ----------------");
+
+	Test_Coordinate_Systems_Single();
+	Test_Coordinate_Systems_Batch();
+	Test_Coordinate_Systems_Scan();
+
+} // end Test_Coordinate_Systems
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                PRIVATE FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void Tests::Test_Coordinate_Systems_Single()
+{
+	// this function tests conversion of a single point: the angles must be correct
+	// in all the quadrants and there must be no division by zero on the axes
+
+	const float eps = 1e-5f;
+
+	// 2D polar: the third quadrant (atan(y/x) would give PI/4 here)
+	MathLib::POINT2D p2;
+	MathLib::POLAR2D polar(0.0f, 0.0f);
+
+	p2.x = -1.0f;
+	p2.y = -1.0f;
+	MathLib::POINT2D_To_POLAR2D(&p2, &polar);
+
+	assert(fabs(polar.r - sqrtf(2.0f)) < eps);
+	assert(fabs(polar.theta + 0.75f * PI) < eps);
+
+	// the second quadrant and the negative X-axis
+	p2.x = -1.0f;
+	p2.y = 1.0f;
+	MathLib::POINT2D_To_POLAR2D(&p2, &polar);
+	assert(fabs(polar.theta - 0.75f * PI) < eps);
+
+	p2.x = -2.0f;
+	p2.y = 0.0f;
+	MathLib::POINT2D_To_POLAR2D(&p2, &polar);
+	assert(fabs(polar.r - 2.0f) < eps);
+	assert(fabs(polar.theta - PI) < eps);
+
+	// the Y-axis (x == 0)
+	float r = 0.0f, theta = 0.0f;
+
+	p2.x = 0.0f;
+	p2.y = -3.0f;
+	MathLib::POINT2D_To_PolarRTh(&p2, &r, &theta);
+	assert(fabs(r - 3.0f) < eps);
+	assert(fabs(theta + 0.5f * PI) < eps);
+
+	// round trip
+	MathLib::POINT2D p2Back;
+	p2.x = -3.5f;
+	p2.y = 1.25f;
+
+	MathLib::POINT2D_To_POLAR2D(&p2, &polar);
+	MathLib::POLAR2D_To_POINT2D(&polar, &p2Back);
+	assert(fabs(p2Back.x - p2.x) < eps);
+	assert(fabs(p2Back.y - p2.y) < eps);
+
+	// 3D cylindrical
+	MathLib::POINT3D p3(-2.0f, -2.0f, 5.0f);
+	MathLib::POINT3D p3Back;
+	MathLib::CYLINDRICAL3D cyl;
+
+	MathLib::POINT3D_To_CylindricalRThZ(&p3, &cyl.r, &cyl.theta, &cyl.z);
+	assert(fabs(cyl.theta + 0.75f * PI) < eps);
+	assert(cyl.z == 5.0f);
+
+	MathLib::CYLINDRICAL3D_To_POINT3D(&cyl, &p3Back);
+	assert(fabs(p3Back.x - p3.x) < eps);
+	assert(fabs(p3Back.y - p3.y) < eps);
+	assert(fabs(p3Back.z - p3.z) < eps);
+
+	// 3D spherical: a point under XY-plane (atan(r/z) would give a negative phi here)
+	MathLib::SPHERICAL3D sph;
+
+	p3 = MathLib::POINT3D(-1.0f, 0.0f, -1.0f);
+	MathLib::POINT3D_To_SPHERICAL3D(&p3, &sph);
+
+	assert(fabs(sph.p - sqrtf(2.0f)) < eps);
+	assert(fabs(sph.phi - 0.75f * PI) < eps);
+	assert(fabs(sph.theta - PI) < eps);
+
+	MathLib::SPHERICAL3D_To_POINT3D(&sph, &p3Back);
+	assert(fabs(p3Back.x - p3.x) < eps);
+	assert(fabs(p3Back.y - p3.y) < eps);
+	assert(fabs(p3Back.z - p3.z) < eps);
+
+	// the poles (r == 0 and z == 0 in the denominators of the old code)
+	p3 = MathLib::POINT3D(0.0f, 0.0f, -4.0f);
+	MathLib::POINT3D_To_SphericalRThPh(&p3, &sph.p, &sph.theta, &sph.phi);
+	assert(fabs(sph.p - 4.0f) < eps);
+	assert(fabs(sph.phi - PI) < eps);
+	assert(sph.theta == 0.0f);
+
+	p3 = MathLib::POINT3D(0.0f, 2.0f, 0.0f);
+	MathLib::POINT3D_To_SPHERICAL3D(&p3, &sph);
+	assert(fabs(sph.phi - 0.5f * PI) < eps);
+	assert(fabs(sph.theta - 0.5f * PI) < eps);
+
+	Log::Print(LOG_MACRO, "single conversion: success");
+
+} // end Test_Coordinate_Systems_Single
+
+///////////////////////////////////////////////////////////
+
+void Tests::Test_Coordinate_Systems_Batch()
+{
+	// this function tests the batch conversion: the results must be close to the single
+	// conversion, must be the same for any SIMD level and for in-place conversion
+
+	const int num = 1003;    // a few blocks and a tail
+	const float eps = 1e-5f;
+
+	std::vector<float> x(num), y(num), z(num);
+	std::mt19937 gen(5);
+	std::uniform_real_distribution<float> dist(-50.0f, 50.0f);
+
+	for (int i = 0; i < num; i++)
+	{
+		x[i] = dist(gen);
+		y[i] = dist(gen);
+		z[i] = dist(gen);
+	}
+
+	// the axes and the poles
+	x[0] = 0.0f;  y[0] = 0.0f;  z[0] = 0.0f;
+	x[1] = 0.0f;  y[1] = 0.0f;  z[1] = -7.0f;
+	x[2] = -3.0f; y[2] = 0.0f;  z[2] = 0.0f;
+	x[3] = 0.0f;  y[3] = -3.0f; z[3] = 1.0f;
+
+	// results of the scalar level are the reference for other levels
+	std::vector<float> refPolar[2], refCyl[3], refSph[3], refRect[3];
+	const MathLib::SIMD_LEVEL cpuLevel = MathLib::SIMD_Get_Level();
+
+	for (int level = MathLib::SIMD_LEVEL_SCALAR; level <= cpuLevel; level++)
+	{
+		std::vector<float> polar[2], cyl[3], sph[3], rect[3];
+
+		for (int k = 0; k < 3; k++)
+		{
+			cyl[k].resize(num);
+			sph[k].resize(num);
+			rect[k].resize(num);
+		}
+
+		polar[0].resize(num);
+		polar[1].resize(num);
+
+		MathLib::SIMD_Set_Max_Level((MathLib::SIMD_LEVEL)level);
+
+		// rectangular -> polar/cylindrical/spherical
+		MathLib::POINT2D_To_POLAR2D_Batch(x.data(), y.data(), polar[0].data(), polar[1].data(), num);
+		MathLib::POINT3D_To_CYLINDRICAL3D_Batch(x.data(), y.data(), z.data(), cyl[0].data(), cyl[1].data(), cyl[2].data(), num);
+		MathLib::POINT3D_To_SPHERICAL3D_Batch(x.data(), y.data(), z.data(), sph[0].data(), sph[1].data(), sph[2].data(), num);
+
+		// spherical -> rectangular
+		MathLib::SPHERICAL3D_To_POINT3D_Batch(sph[0].data(), sph[1].data(), sph[2].data(), rect[0].data(), rect[1].data(), rect[2].data(), num);
+
+		for (int i = 0; i < num; i++)
+		{
+			MathLib::POINT3D p(x[i], y[i], z[i]);
+			MathLib::SPHERICAL3D s;
+
+			MathLib::POINT3D_To_SPHERICAL3D(&p, &s);
+
+			assert(fabs(polar[0][i] - s.p * sinf(s.phi)) < eps * (1.0f + s.p));
+			assert(fabs(polar[1][i] - s.theta) < eps);
+			assert(cyl[0][i] == polar[0][i]);
+			assert(cyl[1][i] == polar[1][i]);
+			assert(cyl[2][i] == z[i]);
+
+			assert(fabs(sph[0][i] - s.p) < eps * (1.0f + s.p));
+			assert(fabs(sph[1][i] - s.theta) < eps);
+			assert(fabs(sph[2][i] - s.phi) < eps);
+
+			// round trip
+			assert(fabs(rect[0][i] - x[i]) < 1e-4f);
+			assert(fabs(rect[1][i] - y[i]) < 1e-4f);
+			assert(fabs(rect[2][i] - z[i]) < 1e-4f);
+		}
+
+		// polar/cylindrical -> rectangular
+		std::vector<float> px(num), py(num), cx(num), cy(num), cz(num);
+
+		MathLib::POLAR2D_To_POINT2D_Batch(polar[0].data(), polar[1].data(), px.data(), py.data(), num);
+		MathLib::CYLINDRICAL3D_To_POINT3D_Batch(cyl[0].data(), cyl[1].data(), cyl[2].data(), cx.data(), cy.data(), cz.data(), num);
+
+		assert(memcmp(px.data(), cx.data(), sizeof(float) * num) == 0);
+		assert(memcmp(py.data(), cy.data(), sizeof(float) * num) == 0);
+		assert(memcmp(cz.data(), z.data(), sizeof(float) * num) == 0);
+
+		for (int i = 0; i < num; i++)
+		{
+			assert(fabs(px[i] - x[i]) < 1e-4f);
+			assert(fabs(py[i] - y[i]) < 1e-4f);
+		}
+
+		// in-place conversion must give the same results
+		std::vector<float> inPlace[3] = { x, y, z };
+
+		MathLib::POINT3D_To_SPHERICAL3D_Batch(inPlace[0].data(), inPlace[1].data(), inPlace[2].data(),
+			inPlace[0].data(), inPlace[1].data(), inPlace[2].data(), num);
+
+		for (int k = 0; k < 3; k++)
+			assert(memcmp(inPlace[k].data(), sph[k].data(), sizeof(float) * num) == 0);
+
+		MathLib::SPHERICAL3D_To_POINT3D_Batch(inPlace[0].data(), inPlace[1].data(), inPlace[2].data(),
+			inPlace[0].data(), inPlace[1].data(), inPlace[2].data(), num);
+
+		for (int k = 0; k < 3; k++)
+			assert(memcmp(inPlace[k].data(), rect[k].data(), sizeof(float) * num) == 0);
+
+		// all the SIMD levels must give the same results
+		if (level == MathLib::SIMD_LEVEL_SCALAR)
+		{
+			for (int k = 0; k < 3; k++)
+			{
+				refCyl[k] = cyl[k];
+				refSph[k] = sph[k];
+				refRect[k] = rect[k];
+			}
+
+			refPolar[0] = polar[0];
+			refPolar[1] = polar[1];
+		}
+		else
+		{
+			for (int k = 0; k < 3; k++)
+			{
+				assert(memcmp(refCyl[k].data(), cyl[k].data(), sizeof(float) * num) == 0);
+				assert(memcmp(refSph[k].data(), sph[k].data(), sizeof(float) * num) == 0);
+				assert(memcmp(refRect[k].data(), rect[k].data(), sizeof(float) * num) == 0);
+			}
+
+			assert(memcmp(refPolar[0].data(), polar[0].data(), sizeof(float) * num) == 0);
+			assert(memcmp(refPolar[1].data(), polar[1].data(), sizeof(float) * num) == 0);
+		}
+	}
+
+	// restore the default SIMD level
+	MathLib::SIMD_Set_Max_Level(MathLib::SIMD_LEVEL_AVX2);
+
+	Log::Print(LOG_MACRO, "batch conversion: success");
+
+} // end Test_Coordinate_Systems_Batch
+
+///////////////////////////////////////////////////////////
+
+void Tests::Test_Coordinate_Systems_Scan()
+{
+	// this function tests streaming conversion of sweeps: chunks of any size
+	// (also crossing the end of a sweep) must give the same points as SPHERICAL3D_To_POINT3D
+
+	const int numRings = 16;
+	const int numColumns = 90;
+	const int numSweeps = 3;
+	const int num = numRings * numColumns * numSweeps;
+	const float thetaStart = -PI;
+	const float thetaStep = 2.0f * PI / numColumns;
+
+	// elevation angles from -15 to +15 degrees
+	float phi[numRings];
+
+	for (int ring = 0; ring < numRings; ring++)
+		phi[ring] = 0.5f * PI - DEG_TO_RAD(-15.0f + 2.0f * ring);
+
+	MathLib::SPHERICAL_SCAN scan;
+
+	assert(MathLib::Init_Spherical_Scan(&scan, phi, 0, thetaStart, thetaStep, numColumns) == 0);
+	assert(MathLib::Init_Spherical_Scan(&scan, phi, numRings, thetaStart, thetaStep, numColumns) == 1);
+
+	std::vector<float> ranges(num);
+	std::mt19937 gen(6);
+	std::uniform_real_distribution<float> dist(0.5f, 120.0f);
+
+	for (int i = 0; i < num; i++)
+		ranges[i] = dist(gen);
+
+	// convert by chunks of different sizes
+	std::vector<MathLib::POINT3D> points(num);
+	const int chunks[] = { 1, 7, 16, 33, 250, 1000 };
+	int start = 0;
+
+	for (int k = 0; start < num; k++)
+	{
+		const int size = chunks[k % 6];
+		const int count = (num - start < size) ? (num - start) : size;
+
+		MathLib::Spherical_Scan_To_POINT3D(&scan, ranges.data() + start, points.data() + start, count);
+		start += count;
+	}
+
+	// all the sweeps are converted so the stream is at the beginning of a sweep again
+	assert(scan.pos == 0);
+
+	for (int i = 0; i < num; i++)
+	{
+		const int ring = i % numRings;
+		const int column = (i / numRings) % numColumns;
+
+		MathLib::SPHERICAL3D sph;
+		MathLib::POINT3D expected;
+
+		sph.p = ranges[i];
+		sph.theta = thetaStart + (float)column * thetaStep;
+		sph.phi = phi[ring];
+		MathLib::SPHERICAL3D_To_POINT3D(&sph, &expected);
+
+		assert(fabs(points[i].x - expected.x) < 1e-5f * sph.p);
+		assert(fabs(points[i].y - expected.y) < 1e-5f * sph.p);
+		assert(fabs(points[i].z - expected.z) < 1e-5f * sph.p);
+	}
+
+	// reset in the middle of a sweep
+	MathLib::POINT3D first;
+
+	MathLib::Spherical_Scan_To_POINT3D(&scan, ranges.data(), points.data(), 5);
+	MathLib::Reset_Spherical_Scan(&scan);
+	MathLib::Spherical_Scan_To_POINT3D(&scan, ranges.data(), &first, 1);
+
+	assert(first.x == points[0].x);
+	assert(first.y == points[0].y);
+	assert(first.z == points[0].z);
+
+	Log::Print(LOG_MACRO, "streaming conversion of sweeps: success");
+
+} // end Test_Coordinate_Systems_Scan
@@ -0,0 +1,1119 @@
+/////////////////////////////////////////////////////////////////////////////////////////////
+// Filename:      TestsFigures.cpp
+// Description:   contains implementation of functional for testing batch
+//                functions for geometric figures
+//
+// Created:       17.10.26
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "Tests.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cstring>
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                PRIVATE FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void Tests::Test_Intersection_Plane3D_PARAMLINE3D_Batch()
+{
+	// this function tests batch intersection of lines with planes: the codes must be
+	// the same as of Intersect_Param_Line3D_Plane3D, and the results must be the same
+	// for any SIMD level
+
+	const int numLines = 1003;
+	const int numPlanes = 7;
+
+	std::vector<float> p0x(numLines), p0y(numLines), p0z(numLines);
+	std::vector<float> vx(numLines), vy(numLines), vz(numLines);
+	std::vector<float> nx(numPlanes), ny(numPlanes), nz(numPlanes), d(numPlanes);
+	std::vector<MathLib::PLANE3D> planes(numPlanes);
+
+	std::mt19937 gen(7);
+	std::uniform_real_distribution<float> dist(-10.0f, 10.0f);
+
+	MathLib::PLANE3D_SOA planesSoa;
+	planesSoa.nx = nx.data();
+	planesSoa.ny = ny.data();
+	planesSoa.nz = nz.data();
+	planesSoa.d = d.data();
+
+	for (int j = 0; j < numPlanes; j++)
+	{
+		const MathLib::POINT3D p(dist(gen), dist(gen), dist(gen));
+		const MathLib::VECTOR3D n(dist(gen), dist(gen), dist(gen));
+
+		MathLib::PLANE3D_Init(planes[j], p, n, 1);
+		MathLib::PLANE3D_To_SOA(planes[j], nx.data(), ny.data(), nz.data(), d.data(), j);
+	}
+
+	// the first plane is XY-plane (for the lines parallel to it)
+	MathLib::PLANE3D_Init(planes[0], MathLib::POINT3D(0, 0, 0), MathLib::VECTOR3D(0, 0, 1), 1);
+	MathLib::PLANE3D_To_SOA(planes[0], nx.data(), ny.data(), nz.data(), d.data(), 0);
+
+	for (int i = 0; i < numLines; i++)
+	{
+		p0x[i] = dist(gen);
+		p0y[i] = dist(gen);
+		p0z[i] = dist(gen);
+		vx[i] = dist(gen);
+		vy[i] = dist(gen);
+		vz[i] = dist(gen);
+	}
+
+	// a line lying on XY-plane and a line parallel to it
+	p0z[0] = 0.0f;  vz[0] = 0.0f;
+	p0z[1] = 3.0f;  vz[1] = 0.0f;
+
+	MathLib::PARAMLINE3D_SOA lines;
+	lines.p0x = p0x.data();
+	lines.p0y = p0y.data();
+	lines.p0z = p0z.data();
+	lines.vx = vx.data();
+	lines.vy = vy.data();
+	lines.vz = vz.data();
+
+	std::vector<float> refT(numLines * numPlanes);
+	std::vector<unsigned char> refCodes(numLines * numPlanes);
+
+	MathLib::Intersect_Param_Lines3D_Planes3D_Batch_Scalar(lines, numLines, planesSoa, numPlanes, refT.data(), refCodes.data());
+
+	assert(refCodes[0] == PARAM_LINE_INTERSECT_EVERYWHERE);
+	assert(refCodes[1] == PARAM_LINE_NO_INTERSECT);
+
+	// compare with the single function (except the lines which are close to the thresholds)
+	int numHits = 0;
+
+	for (int j = 0; j < numPlanes; j++)
+	{
+		for (int i = 0; i < numLines; i++)
+		{
+			MathLib::PARAMLINE3D line;
+			MathLib::POINT3D pt;
+			float t = 0.0f;
+
+			line.p0 = MathLib::POINT3D(p0x[i], p0y[i], p0z[i]);
+			line.v = MathLib::VECTOR3D(vx[i], vy[i], vz[i]);
+
+			const int code = MathLib::Intersect_Param_Line3D_Plane3D(line, planes[j], t, pt);
+			const int k = j * numLines + i;
+
+			const float dot = fabs(MathLib::VECTOR3D_Dot(line.v, planes[j].n));
+
+			if (fabs(dot - EPSILON_E5) < 1e-6f)
+				continue;
+
+			if ((code == PARAM_LINE_INTERSECT_IN_SEGMENT) || (code == PARAM_LINE_INTERSECT_OUT_SEGMENT))
+			{
+				assert(fabs(refT[k] - t) <= 1e-4f * (1.0f + fabs(t)));
+
+				if ((fabs(t) < 1e-4f) || (fabs(t - 1.0f) < 1e-4f))
+					continue;
+			}
+
+			assert(refCodes[k] == code);
+			numHits += (code == PARAM_LINE_INTERSECT_IN_SEGMENT);
+		}
+	}
+
+	assert(numHits > 0);
+
+	// all the SIMD levels must give the same results
+	const MathLib::SIMD_LEVEL cpuLevel = MathLib::SIMD_Get_Level();
+
+	for (int level = MathLib::SIMD_LEVEL_SCALAR; level <= cpuLevel; level++)
+	{
+		std::vector<float> t(numLines * numPlanes);
+		std::vector<unsigned char> codes(numLines * numPlanes);
+
+		MathLib::SIMD_Set_Max_Level((MathLib::SIMD_LEVEL)level);
+		MathLib::Intersect_Param_Lines3D_Planes3D_Batch(lines, numLines, planesSoa, numPlanes, t.data(), codes.data());
+
+		assert(memcmp(t.data(), refT.data(), sizeof(float) * t.size()) == 0);
+		assert(memcmp(codes.data(), refCodes.data(), codes.size()) == 0);
+	}
+
+	// restore the default SIMD level
+	MathLib::SIMD_Set_Max_Level(MathLib::SIMD_LEVEL_AVX2);
+
+	Log::Print(LOG_MACRO, "3D planes: test batch intersection:          \tSUCCESS");
+
+} // end Test_Intersection_Plane3D_PARAMLINE3D_Batch
+
+///////////////////////////////////////////////////////////
+
+void Tests::Test_Bounding_Volumes()
+{
+	// this function tests bounding boxes and spheres: building from points, merging,
+	// transformation and overlap tests; the batch functions must give the same results
+	// as the single functions for any SIMD level
+
+	const int num = 1003;    // a few blocks and a tail
+
+	std::vector<float> x(num), y(num), z(num);
+	std::vector<MathLib::POINT3D> points(num);
+	std::mt19937 gen(17);
+	std::uniform_real_distribution<float> dist(-50.0f, 50.0f);
+	std::uniform_real_distribution<float> distSize(0.0f, 10.0f);
+
+	for (int i = 0; i < num; i++)
+	{
+		x[i] = dist(gen);
+		y[i] = dist(gen) * 0.5f;
+		z[i] = dist(gen) + 20.0f;
+		points[i] = MathLib::POINT3D(x[i], y[i], z[i]);
+	}
+
+	//
+	// building from points
+	//
+	MathLib::AABB3D refBox;
+	MathLib::AABB3D_From_POINT3D_Array(refBox, points.data(), num);
+
+	for (int i = 0; i < num; i++)
+		assert(MathLib::AABB3D_Contains_Point(refBox, points[i]));
+
+	// the box of 0 points is empty: it doesn't change another box when merging
+	MathLib::AABB3D emptyBox;
+	MathLib::AABB3D merged;
+
+	MathLib::AABB3D_From_Points(emptyBox, x.data(), y.data(), z.data(), 0);
+	MathLib::AABB3D_Merge(emptyBox, refBox, merged);
+	assert(memcmp(&merged, &refBox, sizeof(MathLib::AABB3D)) == 0);
+	assert(!MathLib::AABB3D_Overlap(emptyBox, refBox));
+
+	MathLib::SPHERE3D refSphere;
+	MathLib::SPHERE3D_From_Points(refSphere, x.data(), y.data(), z.data(), num);
+
+	for (int i = 0; i < num; i++)
+	{
+		const MathLib::VECTOR3D v(refSphere.center, points[i]);
+		assert(MathLib::VECTOR3D_Length(v) <= refSphere.radius * (1.0f + 1e-6f));
+	}
+
+	//
+	// merging
+	//
+	MathLib::AABB3D a(MathLib::POINT3D(0, 0, 0), MathLib::POINT3D(1, 2, 3));
+	MathLib::AABB3D b(MathLib::POINT3D(-1, 1, 1), MathLib::POINT3D(0.5f, 4, 2));
+
+	MathLib::AABB3D_Merge(a, b, merged);
+	assert((merged.pMin.x == -1) && (merged.pMin.y == 0) && (merged.pMin.z == 0));
+	assert((merged.pMax.x == 1) && (merged.pMax.y == 4) && (merged.pMax.z == 3));
+
+	MathLib::SPHERE3D s1(MathLib::POINT3D(0, 0, 0), 1.0f);
+	MathLib::SPHERE3D s2(MathLib::POINT3D(4, 0, 0), 1.0f);
+	MathLib::SPHERE3D s3(MathLib::POINT3D(0.5f, 0, 0), 0.25f);
+	MathLib::SPHERE3D mergedSphere;
+
+	// the spheres are apart, so the result touches both of them
+	MathLib::SPHERE3D_Merge(s1, s2, mergedSphere);
+	assert(fabs(mergedSphere.center.x - 2.0f) < 1e-6f);
+	assert(fabs(mergedSphere.radius - 3.0f) < 1e-6f);
+
+	// one sphere is inside the other one
+	MathLib::SPHERE3D_Merge(s3, s1, mergedSphere);
+	assert((mergedSphere.center.x == 0.0f) && (mergedSphere.radius == 1.0f));
+
+	//
+	// transformation: the box must be the box of the 8 transformed corners
+	//
+	MathLib::MATRIX4X4 m =
+	{
+		 0.36f, 0.48f, -0.8f,  0,
+		-0.8f,  0.6f,   0.0f,  0,
+		 0.96f, 1.28f,  1.2f,  0,    // the rows are scaled differently
+		 5.0f, -3.0f,   2.0f,  1
+	};
+
+	MathLib::AABB3D transformed;
+	MathLib::AABB3D_Transform(a, m, transformed);
+
+	MathLib::AABB3D cornersBox;
+	MathLib::AABB3D_Init_Empty(cornersBox);
+
+	for (int i = 0; i < 8; i++)
+	{
+		const MathLib::VECTOR3D corner(
+			(i & 1) ? a.pMax.x : a.pMin.x,
+			(i & 2) ? a.pMax.y : a.pMin.y,
+			(i & 4) ? a.pMax.z : a.pMin.z);
+
+		MathLib::VECTOR3D c;
+		MathLib::Mat_Mul_VECTOR3D_4X4(&corner, &m, &c);
+
+		const MathLib::AABB3D cornerBox(c, c);
+		MathLib::AABB3D_Merge(cornersBox, cornerBox, cornersBox);
+	}
+
+	assert(fabs(transformed.pMin.x - cornersBox.pMin.x) < 1e-5f);
+	assert(fabs(transformed.pMin.y - cornersBox.pMin.y) < 1e-5f);
+	assert(fabs(transformed.pMin.z - cornersBox.pMin.z) < 1e-5f);
+	assert(fabs(transformed.pMax.x - cornersBox.pMax.x) < 1e-5f);
+	assert(fabs(transformed.pMax.y - cornersBox.pMax.y) < 1e-5f);
+	assert(fabs(transformed.pMax.z - cornersBox.pMax.z) < 1e-5f);
+
+	// the sphere is scaled by the longest row (2.0)
+	MathLib::SPHERE3D transformedSphere;
+	MathLib::SPHERE3D_Transform(s2, m, transformedSphere);
+	assert(fabs(transformedSphere.radius - 2.0f) < 1e-5f);
+	assert(fabs(transformedSphere.center.x - (5.0f + 4.0f * 0.36f)) < 1e-5f);
+
+	//
+	// overlap tests: known cases (touching volumes overlap)
+	//
+	const MathLib::AABB3D c(MathLib::POINT3D(1, 2, 3), MathLib::POINT3D(2, 3, 4));
+	const MathLib::AABB3D d(MathLib::POINT3D(1.5f, 3.5f, 0), MathLib::POINT3D(2, 4, 1));
+
+	assert(MathLib::AABB3D_Overlap(a, b));
+	assert(MathLib::AABB3D_Overlap(a, c));   // the corner (1, 2, 3) is shared
+	assert(!MathLib::AABB3D_Overlap(a, d));
+	assert(!MathLib::AABB3D_Overlap(c, d));
+
+	assert(!MathLib::SPHERE3D_Overlap(s1, s2));
+	assert(MathLib::SPHERE3D_Overlap(s1, s3));
+	assert(MathLib::SPHERE3D_Overlap(s1, MathLib::SPHERE3D(MathLib::POINT3D(0, 3, 0), 2.0f)));
+
+	assert(MathLib::AABB3D_SPHERE3D_Overlap(a, s1));
+	assert(MathLib::AABB3D_SPHERE3D_Overlap(a, MathLib::SPHERE3D(MathLib::POINT3D(2, 2, 3), 1.0f)));
+	assert(!MathLib::AABB3D_SPHERE3D_Overlap(a, MathLib::SPHERE3D(MathLib::POINT3D(2, 3, 4), 1.0f)));
+
+	//
+	// batch: boxes from the points to the points + (0..10, 0..10, 0..10) and spheres
+	// with the centers in the points; all the results must be the same for each SIMD level
+	//
+	std::vector<float> minX = x, minY = y, minZ = z;
+	std::vector<float> maxX(num), maxY(num), maxZ(num), radius(num);
+
+	for (int i = 0; i < num; i++)
+	{
+		maxX[i] = x[i] + distSize(gen);
+		maxY[i] = y[i] + distSize(gen);
+		maxZ[i] = z[i] + distSize(gen);
+		radius[i] = distSize(gen);
+	}
+
+	MathLib::AABB3D_SOA boxes;
+	boxes.minX = minX.data();  boxes.minY = minY.data();  boxes.minZ = minZ.data();
+	boxes.maxX = maxX.data();  boxes.maxY = maxY.data();  boxes.maxZ = maxZ.data();
+
+	MathLib::SPHERE3D_SOA spheres;
+	spheres.cx = x.data();  spheres.cy = y.data();  spheres.cz = z.data();  spheres.radius = radius.data();
+
+	const MathLib::AABB3D queryBox(MathLib::POINT3D(-20, -10, 0), MathLib::POINT3D(10, 15, 30));
+	const MathLib::SPHERE3D querySphere(MathLib::POINT3D(5, -5, 25), 20.0f);
+
+	// the second spheres for merging: each third one is inside the first sphere, each third
+	// one contains it (with the same center too), and the rest are apart or intersect
+	std::vector<float> x2(num), y2(num), z2(num), radius2(num);
+
+	for (int i = 0; i < num; i++)
+	{
+		switch (i % 3)
+		{
+			case 0:  x2[i] = x[i];  y2[i] = y[i];  z2[i] = z[i] + radius[i] * 0.25f;  radius2[i] = radius[i] * 0.5f;  break;
+			case 1:  x2[i] = x[i];  y2[i] = y[i];  z2[i] = z[i];  radius2[i] = radius[i] + 1.0f;  break;
+			default: x2[i] = x[i] + dist(gen) * 0.1f;  y2[i] = y[i] + dist(gen) * 0.1f;  z2[i] = z[i];  radius2[i] = distSize(gen);
+		}
+	}
+
+	MathLib::SPHERE3D_SOA spheres2;
+	spheres2.cx = x2.data();  spheres2.cy = y2.data();  spheres2.cz = z2.data();  spheres2.radius = radius2.data();
+
+	// the reference results of the single functions
+	std::vector<unsigned char> refBoxOverlap(num), refSphereOverlap(num), refBoxSphereOverlap(num);
+	std::vector<float> refTransformed[6];
+	std::vector<MathLib::SPHERE3D> refSphereTransformed(num), refSphereMerged(num);
+
+	for (int k = 0; k < 6; k++)
+		refTransformed[k].resize(num);
+
+	for (int i = 0; i < num; i++)
+	{
+		const MathLib::AABB3D box(MathLib::POINT3D(minX[i], minY[i], minZ[i]), MathLib::POINT3D(maxX[i], maxY[i], maxZ[i]));
+		const MathLib::SPHERE3D sphere(MathLib::POINT3D(x[i], y[i], z[i]), radius[i]);
+
+		refBoxOverlap[i] = (unsigned char)MathLib::AABB3D_Overlap(queryBox, box);
+		refSphereOverlap[i] = (unsigned char)MathLib::SPHERE3D_Overlap(querySphere, sphere);
+		refBoxSphereOverlap[i] = (unsigned char)MathLib::AABB3D_SPHERE3D_Overlap(box, querySphere);
+
+		MathLib::SPHERE3D_Transform(sphere, m, refSphereTransformed[i]);
+		MathLib::SPHERE3D_Merge(sphere, MathLib::SPHERE3D(MathLib::POINT3D(x2[i], y2[i], z2[i]), radius2[i]), refSphereMerged[i]);
+
+		MathLib::AABB3D_Transform(box, m, transformed);
+
+		refTransformed[0][i] = transformed.pMin.x;
+		refTransformed[1][i] = transformed.pMin.y;
+		refTransformed[2][i] = transformed.pMin.z;
+		refTransformed[3][i] = transformed.pMax.x;
+		refTransformed[4][i] = transformed.pMax.y;
+		refTransformed[5][i] = transformed.pMax.z;
+	}
+
+	const int numOverlaps = (int)std::count(refBoxOverlap.begin(), refBoxOverlap.end(), 1);
+	assert((numOverlaps > 0) && (numOverlaps < num));
+
+	const int numBoxSphereOverlaps = (int)std::count(refBoxSphereOverlap.begin(), refBoxSphereOverlap.end(), 1);
+	assert((numBoxSphereOverlaps > 0) && (numBoxSphereOverlaps < num));
+
+	const MathLib::SIMD_LEVEL cpuLevel = MathLib::SIMD_Get_Level();
+
+	for (int level = MathLib::SIMD_LEVEL_SCALAR; level <= cpuLevel; level++)
+	{
+		MathLib::SIMD_Set_Max_Level((MathLib::SIMD_LEVEL)level);
+
+		// the box and the sphere of the points (each count of the tail)
+		for (int n = num - 16; n <= num; n++)
+		{
+			MathLib::AABB3D box;
+			MathLib::AABB3D refBoxN;
+
+			MathLib::AABB3D_From_Points(box, x.data(), y.data(), z.data(), n);
+			MathLib::AABB3D_From_POINT3D_Array(refBoxN, points.data(), n);
+			assert(memcmp(&box, &refBoxN, sizeof(MathLib::AABB3D)) == 0);
+		}
+
+		MathLib::SPHERE3D sphere;
+		MathLib::SPHERE3D_From_Points(sphere, x.data(), y.data(), z.data(), num);
+		assert(memcmp(&sphere, &refSphere, sizeof(MathLib::SPHERE3D)) == 0);
+
+		// overlap
+		std::vector<unsigned char> boxOverlap(num), sphereOverlap(num), boxSphereOverlap(num);
+
+		MathLib::AABB3D_Overlap_Batch(queryBox, boxes, boxOverlap.data(), num);
+		MathLib::SPHERE3D_Overlap_Batch(querySphere, spheres, sphereOverlap.data(), num);
+		MathLib::AABB3D_SPHERE3D_Overlap_Batch(querySphere, boxes, boxSphereOverlap.data(), num);
+
+		assert(boxOverlap == refBoxOverlap);
+		assert(sphereOverlap == refSphereOverlap);
+		assert(boxSphereOverlap == refBoxSphereOverlap);
+
+		// the spheres: transformation in place and merging
+		std::vector<float> sphereOut[4] = { x, y, z, radius };
+
+		MathLib::SPHERE3D_SOA_OUT spheresOut;
+		spheresOut.cx = sphereOut[0].data();  spheresOut.cy = sphereOut[1].data();
+		spheresOut.cz = sphereOut[2].data();  spheresOut.radius = sphereOut[3].data();
+
+		MathLib::SPHERE3D_Transform_Batch(spheresOut, m, spheresOut, num);
+
+		for (int i = 0; i < num; i++)
+		{
+			const MathLib::SPHERE3D & ref = refSphereTransformed[i];
+
+			assert((sphereOut[0][i] == ref.center.x) && (sphereOut[1][i] == ref.center.y));
+			assert((sphereOut[2][i] == ref.center.z) && (sphereOut[3][i] == ref.radius));
+		}
+
+		MathLib::SPHERE3D_Merge_Batch(spheres, spheres2, spheresOut, num);
+
+		for (int i = 0; i < num; i++)
+		{
+			const MathLib::SPHERE3D & ref = refSphereMerged[i];
+
+			assert((sphereOut[0][i] == ref.center.x) && (sphereOut[1][i] == ref.center.y));
+			assert((sphereOut[2][i] == ref.center.z) && (sphereOut[3][i] == ref.radius));
+		}
+
+		// transformation (out of place and in place)
+		std::vector<float> out[6] = { minX, minY, minZ, maxX, maxY, maxZ };
+
+		MathLib::AABB3D_SOA_OUT boxesOut;
+		boxesOut.minX = out[0].data();  boxesOut.minY = out[1].data();  boxesOut.minZ = out[2].data();
+		boxesOut.maxX = out[3].data();  boxesOut.maxY = out[4].data();  boxesOut.maxZ = out[5].data();
+
+		MathLib::AABB3D_Transform_Batch(boxesOut, m, boxesOut, num);
+
+		for (int k = 0; k < 6; k++)
+			assert(out[k] == refTransformed[k]);
+
+		// merging: the merge of the transformed boxes with the original ones
+		std::vector<float> mergedArr[6];
+
+		for (int k = 0; k < 6; k++)
+			mergedArr[k].resize(num);
+
+		MathLib::AABB3D_SOA_OUT boxesMerged;
+		boxesMerged.minX = mergedArr[0].data();  boxesMerged.minY = mergedArr[1].data();  boxesMerged.minZ = mergedArr[2].data();
+		boxesMerged.maxX = mergedArr[3].data();  boxesMerged.maxY = mergedArr[4].data();  boxesMerged.maxZ = mergedArr[5].data();
+
+		MathLib::AABB3D_Merge_Batch(boxes, boxesOut, boxesMerged, num);
+
+		for (int i = 0; i < num; i++)
+		{
+			const MathLib::AABB3D box1(MathLib::POINT3D(minX[i], minY[i], minZ[i]), MathLib::POINT3D(maxX[i], maxY[i], maxZ[i]));
+			const MathLib::AABB3D box2(MathLib::POINT3D(out[0][i], out[1][i], out[2][i]), MathLib::POINT3D(out[3][i], out[4][i], out[5][i]));
+
+			MathLib::AABB3D_Merge(box1, box2, merged);
+
+			assert((mergedArr[0][i] == merged.pMin.x) && (mergedArr[1][i] == merged.pMin.y) && (mergedArr[2][i] == merged.pMin.z));
+			assert((mergedArr[3][i] == merged.pMax.x) && (mergedArr[4][i] == merged.pMax.y) && (mergedArr[5][i] == merged.pMax.z));
+		}
+	}
+
+	// restore the default SIMD level
+	MathLib::SIMD_Set_Max_Level(MathLib::SIMD_LEVEL_AVX2);
+
+	Log::Print(LOG_MACRO, "bounding volumes: success");
+
+} // end Test_Bounding_Volumes
+
+///////////////////////////////////////////////////////////
+
+static int Test_Sphere_Primitive(const MathLib::PARAMLINE3D & line, const int primIndex, const float tMax, float & t, const void* userData)
+{
+	// a primitive of the BVH test: a sphere in the box of the primitive;
+	// the line p0 + t*v hits the sphere if |p0 + t*v - c|^2 = r^2 has a root in [0, tMax]
+
+	const MathLib::SPHERE3D & sphere = ((const MathLib::SPHERE3D*)userData)[primIndex];
+	const MathLib::VECTOR3D oc(sphere.center, line.p0);
+
+	const float a = MathLib::VECTOR3D_Dot(line.v, line.v);
+	const float b = MathLib::VECTOR3D_Dot(oc, line.v);
+	const float c = MathLib::VECTOR3D_Dot(oc, oc) - sphere.radius * sphere.radius;
+	const float discr = b * b - a * c;
+
+	if (discr < 0.0f)
+		return 0;
+
+	// the first root, or the second one if p0 is inside the sphere
+	float root = (-b - sqrtf(discr)) / a;
+
+	if (root < 0.0f)
+		root = (c <= 0.0f) ? 0.0f : (-b + sqrtf(discr)) / a;
+
+	if ((root < 0.0f) || (root > tMax))
+		return 0;
+
+	t = root;
+	return 1;
+}
+
+///////////////////////////////////////////////////////////
+
+void Tests::Test_BVH()
+{
+	// this function tests BVH: the closest hits must be the same as of the brute force,
+	// the trees built by several threads must give the same results as the tree of one
+	// thread, and the batch queries must give the same results as the single ones
+
+	const int numBoxes = 5000;   // more than one subtree is built in parallel
+	const int numLines = 1003;   // a few packets and a tail
+
+	std::vector<MathLib::AABB3D> boxes(numBoxes);
+	std::vector<MathLib::SPHERE3D> spheres(numBoxes);
+	std::mt19937 gen(18);
+	std::uniform_real_distribution<float> dist(-50.0f, 50.0f);
+	std::uniform_real_distribution<float> distSize(0.1f, 3.0f);
+
+	for (int i = 0; i < numBoxes; i++)
+	{
+		const MathLib::POINT3D p(dist(gen), dist(gen), dist(gen));
+		const MathLib::POINT3D size(distSize(gen), distSize(gen), distSize(gen));
+
+		boxes[i] = MathLib::AABB3D(p, MathLib::POINT3D(p.x + size.x, p.y + size.y, p.z + size.z));
+		spheres[i] = MathLib::SPHERE3D(MathLib::POINT3D(p.x + size.x * 0.5f, p.y + size.y * 0.5f, p.z + size.z * 0.5f),
+			0.5f * std::min({ size.x, size.y, size.z }));
+	}
+
+	// an empty tree
+	MathLib::BVH bvh;
+	MathLib::BVH_HIT hit;
+	const MathLib::PARAMLINE3D line0(MathLib::POINT3D(0, 0, 0), MathLib::POINT3D(1, 1, 1));
+
+	assert(MathLib::BVH_Build(bvh, boxes.data(), 0, 1) == 0);
+	assert(MathLib::BVH_Intersect_Closest(bvh, line0, FLT_MAX, hit, nullptr, nullptr) == 0);
+	assert(hit.primIndex == -1);
+	assert(MathLib::BVH_Intersect_Any(bvh, line0, FLT_MAX, nullptr, nullptr) == 0);
+
+	// the tree must contain each primitive once and each node must contain its children
+	assert(MathLib::BVH_Build(bvh, boxes.data(), numBoxes, 1) == 1);
+
+	std::vector<int> sortedIndices = bvh.primIndices;
+	std::sort(sortedIndices.begin(), sortedIndices.end());
+
+	for (int i = 0; i < numBoxes; i++)
+		assert(sortedIndices[i] == i);
+
+	for (const MathLib::BVH_NODE & node : bvh.nodes)
+	{
+		const MathLib::AABB3D nodeBox(MathLib::POINT3D(node.minX, node.minY, node.minZ), MathLib::POINT3D(node.maxX, node.maxY, node.maxZ));
+
+		if (node.count > 0)
+		{
+			for (int i = node.leftOrFirst; i < node.leftOrFirst + node.count; i++)
+			{
+				assert(MathLib::AABB3D_Contains_Point(nodeBox, bvh.primBoxes[i].pMin));
+				assert(MathLib::AABB3D_Contains_Point(nodeBox, bvh.primBoxes[i].pMax));
+			}
+		}
+		else
+		{
+			for (int k = 0; k < 2; k++)
+			{
+				const MathLib::BVH_NODE & child = bvh.nodes[node.leftOrFirst + k];
+
+				assert(MathLib::AABB3D_Contains_Point(nodeBox, MathLib::POINT3D(child.minX, child.minY, child.minZ)));
+				assert(MathLib::AABB3D_Contains_Point(nodeBox, MathLib::POINT3D(child.maxX, child.maxY, child.maxZ)));
+			}
+		}
+	}
+
+	MathLib::BVH bvhThreads;
+	assert(MathLib::BVH_Build(bvhThreads, boxes.data(), numBoxes, 4) == 1);
+	assert(bvhThreads.nodes.size() == bvh.nodes.size());
+	assert(bvhThreads.primIndices == bvh.primIndices);
+	assert(memcmp(bvhThreads.nodes.data(), bvh.nodes.data(), bvh.nodes.size() * sizeof(MathLib::BVH_NODE)) == 0);
+
+	// the lines: the first half is coherent (from one point in the same octant, as camera
+	// rays), the second half is from random points to random points; all of them are
+	// tested as segments and as rays
+	std::vector<MathLib::PARAMLINE3D> lines(numLines);
+	std::vector<float> p0x(numLines), p0y(numLines), p0z(numLines), vx(numLines), vy(numLines), vz(numLines);
+	std::uniform_real_distribution<float> distTarget(1.0f, 50.0f);
+
+	for (int i = 0; i < numLines; i++)
+	{
+		if (i < numLines / 2)
+		{
+			MathLib::Init_Param_Line3D(MathLib::POINT3D(-60, -60, -60),
+				MathLib::POINT3D(distTarget(gen), distTarget(gen), distTarget(gen)), lines[i]);
+		}
+		else
+		{
+			MathLib::Init_Param_Line3D(MathLib::POINT3D(dist(gen), dist(gen), dist(gen)),
+				MathLib::POINT3D(dist(gen), dist(gen), dist(gen)), lines[i]);
+		}
+
+		p0x[i] = lines[i].p0.x;  p0y[i] = lines[i].p0.y;  p0z[i] = lines[i].p0.z;
+		vx[i] = lines[i].v.x;    vy[i] = lines[i].v.y;    vz[i] = lines[i].v.z;
+	}
+
+	MathLib::PARAMLINE3D_SOA linesSoa;
+	linesSoa.p0x = p0x.data();  linesSoa.p0y = p0y.data();  linesSoa.p0z = p0z.data();
+	linesSoa.vx = vx.data();    linesSoa.vy = vy.data();    linesSoa.vz = vz.data();
+
+	const float tMaxValues[2] = { 1.0f, FLT_MAX };
+
+	for (const float tMax : tMaxValues)
+	{
+		for (int useSpheres = 0; useSpheres < 2; useSpheres++)
+		{
+			const MathLib::BVH_PRIMITIVE_TEST test = useSpheres ? Test_Sphere_Primitive : nullptr;
+			const void* userData = useSpheres ? spheres.data() : nullptr;
+
+			std::vector<int> refPrim(numLines);
+			std::vector<float> refT(numLines);
+			std::vector<unsigned char> refAny(numLines);
+			int numHits = 0;
+
+			for (int i = 0; i < numLines; i++)
+			{
+				// the brute force: the least t (of the least index)
+				int bestPrim = -1;
+				float tBest = tMax;
+
+				for (int j = 0; j < numBoxes; j++)
+				{
+					float t = 0.0f;
+					int isHit = 0;
+
+					if (useSpheres)
+					{
+						isHit = Test_Sphere_Primitive(lines[i], j, tBest, t, spheres.data());
+					}
+					else
+					{
+						const MathLib::AABB3D & box = boxes[j];
+						const float tx0 = (box.pMin.x - lines[i].p0.x) * (1.0f / lines[i].v.x);
+						const float tx1 = (box.pMax.x - lines[i].p0.x) * (1.0f / lines[i].v.x);
+						const float ty0 = (box.pMin.y - lines[i].p0.y) * (1.0f / lines[i].v.y);
+						const float ty1 = (box.pMax.y - lines[i].p0.y) * (1.0f / lines[i].v.y);
+						const float tz0 = (box.pMin.z - lines[i].p0.z) * (1.0f / lines[i].v.z);
+						const float tz1 = (box.pMax.z - lines[i].p0.z) * (1.0f / lines[i].v.z);
+
+						t = std::max({ std::min(tx0, tx1), std::min(ty0, ty1), std::min(tz0, tz1), 0.0f });
+						isHit = (t <= std::min({ std::max(tx0, tx1), std::max(ty0, ty1), std::max(tz0, tz1), tBest }));
+					}
+
+					if (isHit && ((t < tBest) || (bestPrim < 0)))
+					{
+						tBest = t;
+						bestPrim = j;
+					}
+				}
+
+				assert(MathLib::BVH_Intersect_Closest(bvh, lines[i], tMax, hit, test, userData) == (bestPrim >= 0));
+				assert(hit.primIndex == bestPrim);
+				assert(fabs(hit.t - tBest) <= 1e-5f * (1.0f + tBest));
+
+				refPrim[i] = hit.primIndex;
+				refT[i] = hit.t;
+				refAny[i] = (unsigned char)MathLib::BVH_Intersect_Any(bvh, lines[i], tMax, test, userData);
+
+				assert(refAny[i] == (bestPrim >= 0));
+				numHits += refAny[i];
+
+				// the tree of several threads
+				MathLib::BVH_HIT hitThreads;
+
+				MathLib::BVH_Intersect_Closest(bvhThreads, lines[i], tMax, hitThreads, test, userData);
+				assert((hitThreads.primIndex == hit.primIndex) && (hitThreads.t == hit.t));
+			}
+
+			assert((numHits > 0) && (numHits < numLines));
+
+			// batch queries for each SIMD level
+			const MathLib::SIMD_LEVEL cpuLevel = MathLib::SIMD_Get_Level();
+
+			for (int level = MathLib::SIMD_LEVEL_SCALAR; level <= cpuLevel; level++)
+			{
+				std::vector<int> prim(numLines);
+				std::vector<float> t(numLines);
+				std::vector<unsigned char> any(numLines);
+
+				MathLib::SIMD_Set_Max_Level((MathLib::SIMD_LEVEL)level);
+
+				MathLib::BVH_Intersect_Closest_Batch(bvh, linesSoa, numLines, tMax, prim.data(), t.data(), test, userData);
+				MathLib::BVH_Intersect_Any_Batch(bvh, linesSoa, numLines, tMax, any.data(), test, userData);
+
+				assert(prim == refPrim);
+				assert(memcmp(t.data(), refT.data(), sizeof(float) * numLines) == 0);
+				assert(any == refAny);
+			}
+
+			// restore the default SIMD level
+			MathLib::SIMD_Set_Max_Level(MathLib::SIMD_LEVEL_AVX2);
+		}
+	}
+
+	Log::Print(LOG_MACRO, "BVH: success");
+
+} // end Test_BVH
+
+///////////////////////////////////////////////////////////
+
+void Tests::Test_Frustum()
+{
+	// this function tests extraction of a frustum from a view-projection matrix and
+	// culling of points, spheres and boxes (single and batch)
+
+	// a perspective projection (depth range [0, 1]: z_clip = z*f/(f-n) - n*f/(f-n), w_clip = z)
+	// with the camera at (1, 2, -10) looking along +Z
+	const float zn = 1.0f;
+	const float zf = 100.0f;
+	const float xScale = 1.0f / tanf(DEG_TO_RAD(30.0f));
+
+	MathLib::MATRIX4X4 proj =
+	{
+		xScale, 0,      0,                   0,
+		0,      xScale, 0,                   0,
+		0,      0,      zf / (zf - zn),      1,
+		0,      0,      -zn * zf / (zf - zn), 0
+	};
+
+	MathLib::MATRIX4X4 view =
+	{
+		1,  0,  0,  0,
+		0,  1,  0,  0,
+		0,  0,  1,  0,
+		-1, -2, 10, 1
+	};
+
+	MathLib::MATRIX4X4 viewProj;
+	MathLib::Mat_Mul_4X4(&view, &proj, &viewProj);
+
+	MathLib::FRUSTUM frustum;
+	MathLib::FRUSTUM_Init(frustum, viewProj, MathLib::FRUSTUM_DEPTH_ZERO_TO_ONE);
+
+	// the planes are unit and the near plane is z = -9 (the camera is at z = -10)
+	const MathLib::PLANE3D & nearPlane = frustum.planes[MathLib::FRUSTUM_PLANE_NEAR];
+
+	assert(fabs(MathLib::VECTOR3D_Length(nearPlane.n) - 1.0f) < 1e-5f);
+	assert(fabs(MathLib::Compute_Point_In_Plane3D(MathLib::POINT3D(5, -3, -9), nearPlane)) < 1e-4f);
+	assert(MathLib::Compute_Point_In_Plane3D(MathLib::POINT3D(1, 2, 0), nearPlane) > 0);
+
+	//
+	// points: compare with the clip coordinates
+	//
+	std::mt19937 gen(8);
+	std::uniform_real_distribution<float> dist(-120.0f, 120.0f);
+	std::uniform_real_distribution<float> distRadius(0.0f, 20.0f);
+
+	const int num = 1003;
+	std::vector<float> x(num), y(num), z(num), r(num), x2(num), y2(num), z2(num);
+
+	for (int i = 0; i < num; i++)
+	{
+		x[i] = dist(gen) * 0.5f;
+		y[i] = dist(gen) * 0.5f;
+		z[i] = dist(gen);
+		r[i] = distRadius(gen);
+
+		x2[i] = x[i] + distRadius(gen);
+		y2[i] = y[i] + distRadius(gen);
+		z2[i] = z[i] + distRadius(gen);
+	}
+
+	int numVisible = 0;
+
+	for (int i = 0; i < num; i++)
+	{
+		MathLib::VECTOR4D p(x[i], y[i], z[i], 1.0f);
+		MathLib::VECTOR4D clip;
+		MathLib::Mat_Mul_VECTOR4D_4X4(&p, &viewProj, &clip);
+
+		const float margin = std::min({ clip.w - fabsf(clip.x), clip.w - fabsf(clip.y), clip.z, clip.w - clip.z });
+
+		// skip the points which are too close to the planes
+		if (fabsf(margin) < 1e-3f)
+			continue;
+
+		const int visible = MathLib::FRUSTUM_Test_Point(frustum, MathLib::POINT3D(x[i], y[i], z[i]));
+
+		assert(visible == (margin > 0.0f));
+		numVisible += visible;
+	}
+
+	assert((numVisible > 0) && (numVisible < num));
+
+	//
+	// spheres and boxes: a few known cases
+	//
+	unsigned char cache = MathLib::FRUSTUM_PLANE_LEFT;
+
+	assert(MathLib::FRUSTUM_Classify_Sphere(frustum, MathLib::POINT3D(1, 2, 40), 1.0f, cache) == MathLib::FRUSTUM_INSIDE);
+	assert(MathLib::FRUSTUM_Classify_Sphere(frustum, MathLib::POINT3D(1, 2, -9), 1.0f, cache) == MathLib::FRUSTUM_INTERSECT);
+	assert(MathLib::FRUSTUM_Classify_Sphere(frustum, MathLib::POINT3D(1, 2, 150), 1.0f, cache) == MathLib::FRUSTUM_OUTSIDE);
+	assert(cache == MathLib::FRUSTUM_PLANE_FAR);
+
+	// the next test of the same sphere is rejected by the cached plane
+	assert(MathLib::FRUSTUM_Classify_Sphere(frustum, MathLib::POINT3D(1, 2, 150), 1.0f, cache) == MathLib::FRUSTUM_OUTSIDE);
+	assert(cache == MathLib::FRUSTUM_PLANE_FAR);
+
+	assert(MathLib::FRUSTUM_Classify_AABB(frustum, MathLib::POINT3D(0, 1, 30), MathLib::POINT3D(2, 3, 32), cache) == MathLib::FRUSTUM_INSIDE);
+	assert(MathLib::FRUSTUM_Classify_AABB(frustum, MathLib::POINT3D(0, 1, 85), MathLib::POINT3D(2, 3, 95), cache) == MathLib::FRUSTUM_INTERSECT);
+	assert(MathLib::FRUSTUM_Classify_AABB(frustum, MathLib::POINT3D(200, 1, 30), MathLib::POINT3D(210, 3, 32), cache) == MathLib::FRUSTUM_OUTSIDE);
+	assert(cache == MathLib::FRUSTUM_PLANE_RIGHT);
+
+	//
+	// batch: the results must be the same as of the single tests (also for the caches)
+	// for each SIMD level; the second pass uses the updated caches
+	//
+	std::vector<unsigned char> initCache(num);
+
+	for (int i = 0; i < num; i++)
+		initCache[i] = (unsigned char)(i % MathLib::FRUSTUM_NUM_PLANES);
+
+	std::vector<unsigned char> refVisible(num), refSpheres(num), refBoxes(num);
+	std::vector<unsigned char> refSpheresCache[2], refBoxesCache[2];
+
+	for (int pass = 0; pass < 2; pass++)
+	{
+		refSpheresCache[pass] = (pass == 0) ? initCache : refSpheresCache[0];
+		refBoxesCache[pass] = (pass == 0) ? initCache : refBoxesCache[0];
+
+		for (int i = 0; i < num; i++)
+		{
+			refVisible[i] = (unsigned char)MathLib::FRUSTUM_Test_Point(frustum, MathLib::POINT3D(x[i], y[i], z[i]));
+
+			refSpheres[i] = (unsigned char)MathLib::FRUSTUM_Classify_Sphere(frustum,
+				MathLib::POINT3D(x[i], y[i], z[i]), r[i], refSpheresCache[pass][i]);
+
+			refBoxes[i] = (unsigned char)MathLib::FRUSTUM_Classify_AABB(frustum,
+				MathLib::POINT3D(x[i], y[i], z[i]), MathLib::POINT3D(x2[i], y2[i], z2[i]), refBoxesCache[pass][i]);
+		}
+	}
+
+	const MathLib::SIMD_LEVEL cpuLevel = MathLib::SIMD_Get_Level();
+
+	for (int level = MathLib::SIMD_LEVEL_SCALAR; level <= cpuLevel; level++)
+	{
+		std::vector<unsigned char> visible(num), spheres(num), boxes(num);
+		std::vector<unsigned char> spheresCache = initCache;
+		std::vector<unsigned char> boxesCache = initCache;
+
+		MathLib::SIMD_Set_Max_Level((MathLib::SIMD_LEVEL)level);
+
+		for (int pass = 0; pass < 2; pass++)
+		{
+			MathLib::FRUSTUM_Test_Points_Batch(frustum, x.data(), y.data(), z.data(), visible.data(), num);
+
+			MathLib::FRUSTUM_Classify_Spheres_Batch(frustum, x.data(), y.data(), z.data(), r.data(),
+				spheres.data(), spheresCache.data(), num);
+
+			MathLib::FRUSTUM_Classify_AABBs_Batch(frustum, x.data(), y.data(), z.data(), x2.data(), y2.data(), z2.data(),
+				boxes.data(), boxesCache.data(), num);
+
+			assert(spheresCache == refSpheresCache[pass]);
+			assert(boxesCache == refBoxesCache[pass]);
+		}
+
+		assert(visible == refVisible);
+		assert(spheres == refSpheres);
+		assert(boxes == refBoxes);
+	}
+
+	// restore the default SIMD level
+	MathLib::SIMD_Set_Max_Level(MathLib::SIMD_LEVEL_AVX2);
+
+	Log::Print(LOG_MACRO, "frustum culling: success");
+
+} // end Test_Frustum
+
+///////////////////////////////////////////////////////////
+
+void Tests::Test_Triangles()
+{
+	// this function tests intersection of lines with triangles: known hits and misses,
+	// the same results of all the versions of the test, and the closest hit of a batch
+	// (each SIMD kernel and BVH with triangles must give the same hit as the brute force)
+
+	const MathLib::TRIANGLE3D tri(MathLib::POINT3D(0, 0, 0), MathLib::POINT3D(1, 0, 0), MathLib::POINT3D(0, 1, 0));
+	MathLib::TRIANGLE3D_PRECOMP pre;
+	MathLib::TRIANGLE3D_HIT hit;
+	MathLib::TRIANGLE3D_HIT hitPre;
+	MathLib::PARAMLINE3D line;
+
+	MathLib::TRIANGLE3D_Precompute(tri, pre);
+
+	// the segment through the triangle (from both sides)
+	MathLib::Init_Param_Line3D(MathLib::POINT3D(0.25f, 0.25f, -1.0f), MathLib::POINT3D(0.25f, 0.25f, 1.0f), line);
+
+	assert(MathLib::Intersect_Param_Line3D_Triangle3D(line, tri, 1.0f, hit) == 1);
+	assert((hit.t == 0.5f) && (hit.u == 0.25f) && (hit.v == 0.25f));
+
+	assert(MathLib::Intersect_Param_Line3D_Triangle3D_Precomp(line, pre, 1.0f, hitPre) == 1);
+	assert((hitPre.t == hit.t) && (hitPre.u == hit.u) && (hitPre.v == hit.v));
+
+	assert(MathLib::Intersect_Param_Line3D_Triangle3D(line, tri, 0.4f, hit) == 0);     // the segment is too short
+
+	MathLib::Init_Param_Line3D(MathLib::POINT3D(0.25f, 0.25f, 1.0f), MathLib::POINT3D(0.25f, 0.25f, -1.0f), line);
+	assert(MathLib::Intersect_Param_Line3D_Triangle3D(line, tri, 1.0f, hit) == 1);
+	assert((hit.t == 0.5f) && (hit.u == 0.25f) && (hit.v == 0.25f));
+
+	MathLib::Init_Param_Line3D(MathLib::POINT3D(0.25f, 0.25f, 1.0f), MathLib::POINT3D(0.25f, 0.25f, 2.0f), line);
+	assert(MathLib::Intersect_Param_Line3D_Triangle3D(line, tri, FLT_MAX, hit) == 0);  // the triangle is behind
+
+	// outside of the triangle (u + v > 1) and parallel to it
+	MathLib::Init_Param_Line3D(MathLib::POINT3D(0.75f, 0.75f, -1.0f), MathLib::POINT3D(0.75f, 0.75f, 1.0f), line);
+	assert(MathLib::Intersect_Param_Line3D_Triangle3D(line, tri, 1.0f, hit) == 0);
+
+	MathLib::Init_Param_Line3D(MathLib::POINT3D(-1.0f, 0.25f, 0.0f), MathLib::POINT3D(1.0f, 0.25f, 0.0f), line);
+	assert(MathLib::Intersect_Param_Line3D_Triangle3D(line, tri, 1.0f, hit) == 0);
+
+	// the box of the triangle
+	MathLib::AABB3D box;
+	MathLib::TRIANGLE3D_Compute_AABB3D(tri, box);
+	assert((box.pMin.x == 0) && (box.pMin.y == 0) && (box.pMin.z == 0));
+	assert((box.pMax.x == 1) && (box.pMax.y == 1) && (box.pMax.z == 0));
+
+	// random triangles (the number isn't a multiple of 8 to test the tails)
+	const int numTris = 1003;
+	const int numLines = 300;
+
+	std::vector<MathLib::TRIANGLE3D> tris(numTris);
+	std::vector<MathLib::TRIANGLE3D_PRECOMP> tripre(numTris);
+	std::vector<MathLib::AABB3D> boxes(numTris);
+	std::vector<float> soaData(9 * numTris);
+	std::mt19937 gen(19);
+	std::uniform_real_distribution<float> dist(-20.0f, 20.0f);
+	std::uniform_real_distribution<float> distEdge(-4.0f, 4.0f);
+
+	for (int i = 0; i < numTris; i++)
+	{
+		const MathLib::POINT3D p(dist(gen), dist(gen), dist(gen));
+
+		tris[i] = MathLib::TRIANGLE3D(p,
+			MathLib::POINT3D(p.x + distEdge(gen), p.y + distEdge(gen), p.z + distEdge(gen)),
+			MathLib::POINT3D(p.x + distEdge(gen), p.y + distEdge(gen), p.z + distEdge(gen)));
+
+		MathLib::TRIANGLE3D_Precompute(tris[i], tripre[i]);
+		MathLib::TRIANGLE3D_Compute_AABB3D(tris[i], boxes[i]);
+	}
+
+	// a triangle which duplicates the previous one: the hit of the least index must win
+	tris[numTris - 1] = tris[numTris - 2];
+	tripre[numTris - 1] = tripre[numTris - 2];
+	boxes[numTris - 1] = boxes[numTris - 2];
+
+	MathLib::TRIANGLE3D_SOA_OUT soa;
+	soa.p0x = soaData.data();                soa.p0y = soaData.data() + numTris;      soa.p0z = soaData.data() + 2 * numTris;
+	soa.e1x = soaData.data() + 3 * numTris;  soa.e1y = soaData.data() + 4 * numTris;  soa.e1z = soaData.data() + 5 * numTris;
+	soa.e2x = soaData.data() + 6 * numTris;  soa.e2y = soaData.data() + 7 * numTris;  soa.e2z = soaData.data() + 8 * numTris;
+
+	MathLib::TRIANGLE3D_To_SOA(tris.data(), numTris, soa);
+
+	MathLib::BVH bvh;
+	assert(MathLib::BVH_Build(bvh, boxes.data(), numTris, 1) == 1);
+
+	const MathLib::SIMD_LEVEL cpuLevel = MathLib::SIMD_Get_Level();
+	const float tMaxValues[2] = { 1.0f, FLT_MAX };
+	int numHits = 0;
+
+	for (int i = 0; i < numLines; i++)
+	{
+		if (i == 0)
+		{
+			// the line through the duplicated triangles
+			const MathLib::TRIANGLE3D & t = tris[numTris - 1];
+			const MathLib::POINT3D c((t.p0.x + t.p1.x + t.p2.x) / 3, (t.p0.y + t.p1.y + t.p2.y) / 3, (t.p0.z + t.p1.z + t.p2.z) / 3);
+
+			MathLib::Init_Param_Line3D(MathLib::POINT3D(c.x + 30.0f, c.y + 30.0f, c.z + 30.0f), c, line);
+		}
+		else
+		{
+			MathLib::Init_Param_Line3D(MathLib::POINT3D(dist(gen), dist(gen), dist(gen)),
+				MathLib::POINT3D(dist(gen), dist(gen), dist(gen)), line);
+		}
+
+		for (const float tMax : tMaxValues)
+		{
+			// the brute force
+			MathLib::TRIANGLE3D_HIT ref;
+
+			for (int j = 0; j < numTris; j++)
+			{
+				if (MathLib::Intersect_Param_Line3D_Triangle3D(line, tris[j], tMax, hit) &&
+					((ref.triIndex < 0) || (hit.t < ref.t)))
+				{
+					ref = hit;
+					ref.triIndex = j;
+				}
+			}
+
+			numHits += (ref.triIndex >= 0);
+
+			for (int level = MathLib::SIMD_LEVEL_SCALAR; level <= cpuLevel; level++)
+			{
+				MathLib::SIMD_Set_Max_Level((MathLib::SIMD_LEVEL)level);
+
+				assert(MathLib::Intersect_Param_Line3D_Triangles3D(line, soa, numTris, tMax, hit) == (ref.triIndex >= 0));
+				assert(hit.triIndex == ref.triIndex);
+
+				if (ref.triIndex >= 0)
+					assert((hit.t == ref.t) && (hit.u == ref.u) && (hit.v == ref.v));
+			}
+
+			// restore the default SIMD level
+			MathLib::SIMD_Set_Max_Level(MathLib::SIMD_LEVEL_AVX2);
+
+			// BVH of the triangles
+			MathLib::BVH_HIT bvhHit;
+
+			assert(MathLib::BVH_Intersect_Closest(bvh, line, tMax, bvhHit, MathLib::BVH_Test_Triangle3D, tripre.data()) == (ref.triIndex >= 0));
+			assert(bvhHit.primIndex == ref.triIndex);
+
+			if (ref.triIndex >= 0)
+				assert(bvhHit.t == ref.t);
+		}
+
+		if (i == 0)
+			assert(hit.triIndex == numTris - 2);
+	}
+
+	assert((numHits > 0) && (numHits < 2 * numLines));
+
+	// an empty batch
+	assert(MathLib::Intersect_Param_Line3D_Triangles3D(line, soa, 0, FLT_MAX, hit) == 0);
+	assert(hit.triIndex == -1);
+
+	Log::Print(LOG_MACRO, "triangles: success");
+
+} // end Test_Triangles
+
+///////////////////////////////////////////////////////////
+
+void Tests::Test_Segments2D()
+{
+	// this function tests finding all the intersections of 2D segments: a known case,
+	// and random sets where the sweep and the grid (with different cell sizes and
+	// numbers of threads) must give exactly the same hits as the brute force
+
+	std::vector<MathLib::SEGMENT2D_HIT> hits;
+	std::vector<MathLib::SEGMENT2D_HIT> refHits;
+	std::vector<MathLib::PARAMLINE2D> lines(4);
+
+	// a cross, a parallel segment and a segment far away
+	MathLib::Init_Param_Line2D(MathLib::POINT2D(0, 0),  MathLib::POINT2D(2, 0), lines[0]);
+	MathLib::Init_Param_Line2D(MathLib::POINT2D(1, -1), MathLib::POINT2D(1, 3), lines[1]);
+	MathLib::Init_Param_Line2D(MathLib::POINT2D(0, 1),  MathLib::POINT2D(2, 1), lines[2]);
+	MathLib::Init_Param_Line2D(MathLib::POINT2D(5, 5),  MathLib::POINT2D(6, 6), lines[3]);
+
+	assert(MathLib::Intersect_Segments2D_Brute_Force(lines.data(), 4, hits) == 2);
+	assert((hits[0].i == 0) && (hits[0].j == 1) && (hits[0].t1 == 0.5f) && (hits[0].t2 == 0.25f));
+	assert((hits[1].i == 1) && (hits[1].j == 2) && (hits[1].t1 == 0.5f) && (hits[1].t2 == 0.5f));
+
+	assert(MathLib::Intersect_Segments2D_Sweep(lines.data(), 4, refHits) == 2);
+	assert(memcmp(hits.data(), refHits.data(), sizeof(MathLib::SEGMENT2D_HIT) * 2) == 0);
+
+	assert(MathLib::Intersect_Segments2D_Grid(lines.data(), 4, 0.0f, 1, refHits) == 2);
+	assert(memcmp(hits.data(), refHits.data(), sizeof(MathLib::SEGMENT2D_HIT) * 2) == 0);
+
+	// no pairs
+	assert(MathLib::Intersect_Segments2D_Brute_Force(lines.data(), 0, hits) == 0);
+	assert(MathLib::Intersect_Segments2D_Sweep(lines.data(), 1, hits) == 0);
+	assert(MathLib::Intersect_Segments2D_Grid(lines.data(), 1, 0.0f, 0, hits) == 0);
+
+	// random sets: short segments (as roads of a map) and long ones
+	const int numLines = 2000;
+	std::mt19937 gen(20);
+	std::uniform_real_distribution<float> dist(-500.0f, 500.0f);
+
+	lines.resize(numLines);
+
+	for (const float length : { 20.0f, 300.0f })
+	{
+		std::uniform_real_distribution<float> distLength(-length, length);
+
+		for (int i = 0; i < numLines; i++)
+		{
+			const MathLib::POINT2D p(dist(gen), dist(gen));
+			MathLib::Init_Param_Line2D(p, MathLib::POINT2D(p.x + distLength(gen), p.y + distLength(gen)), lines[i]);
+		}
+
+		// a vertical and a horizontal segment, and a point
+		MathLib::Init_Param_Line2D(MathLib::POINT2D(0, -100), MathLib::POINT2D(0, 100), lines[0]);
+		MathLib::Init_Param_Line2D(MathLib::POINT2D(-100, 0), MathLib::POINT2D(100, 0), lines[1]);
+		MathLib::Init_Param_Line2D(MathLib::POINT2D(7, 7), MathLib::POINT2D(7, 7), lines[2]);
+
+		const int numRef = MathLib::Intersect_Segments2D_Brute_Force(lines.data(), numLines, refHits);
+		assert(numRef > 0);
+
+		// the hits are intersections of the pairs
+		for (const MathLib::SEGMENT2D_HIT & hit : refHits)
+		{
+			float t1 = 0.0f;
+			float t2 = 0.0f;
+
+			assert(hit.i < hit.j);
+			assert(MathLib::Intersect_Param_Lines2D(&lines[hit.i], &lines[hit.j], &t1, &t2) == PARAM_LINE_INTERSECT_IN_SEGMENT);
+
+			const MathLib::PARAMLINE2D & a = lines[hit.i];
+			const MathLib::PARAMLINE2D & b = lines[hit.j];
+
+			assert(fabs((a.p0.x + a.v.x * hit.t1) - (b.p0.x + b.v.x * hit.t2)) <= 1e-2f);
+			assert(fabs((a.p0.y + a.v.y * hit.t1) - (b.p0.y + b.v.y * hit.t2)) <= 1e-2f);
+		}
+
+		assert(MathLib::Intersect_Segments2D_Sweep(lines.data(), numLines, hits) == numRef);
+		assert(memcmp(hits.data(), refHits.data(), sizeof(MathLib::SEGMENT2D_HIT) * numRef) == 0);
+
+		// the automatic cell size, tiny cells (their number is limited) and one cell
+		for (const float cellSize : { 0.0f, 0.001f, 5000.0f })
+		{
+			for (const int numThreads : { 1, 4, 0 })
+			{
+				assert(MathLib::Intersect_Segments2D_Grid(lines.data(), numLines, cellSize, numThreads, hits) == numRef);
+				assert(memcmp(hits.data(), refHits.data(), sizeof(MathLib::SEGMENT2D_HIT) * numRef) == 0);
+			}
+		}
+	}
+
+	Log::Print(LOG_MACRO, "2D segments intersection: success");
+
+} // end Test_Segments2D
@@ -0,0 +1,168 @@
+/////////////////////////////////////////////////////////////////////////////////////////////
+// Filename:      TestsFixedPoint.cpp
+// Description:   contains implementation of functional for testing a work with
+//                fixed-point numbers, vectors and matrices
+//
+// Created:       17.10.26
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "Tests.h"
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                PUBLIC FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void Tests::Test_Fixed_Point()
+{
+	Log::Print("\n\n");
+	Log::Print("-------------------- TEST: FIXED-POINT -------------------");
+
+	Test_Fixed_Point_Arithmetic();
+	Test_Fixed_Point_Transform();
+
+} // end Test_Fixed_Point
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                PRIVATE FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void Tests::Test_Fixed_Point_Arithmetic()
+{
+	// this function tests conversion, multiplication and division of fixed-point numbers,
+	// and operations with fixed-point vectors
+
+	// the macroses
+	assert(FIXP16_WP(INT_TO_FIXP16(7) + FIXP16_ROUND_UP) == 7);
+	assert(FIXP16_DP(INT_TO_FIXP16(7) + FIXP16_ROUND_UP) == FIXP16_ROUND_UP);
+	assert(FLOAT_TO_FIXP16(1.5f) == 3 * (FIXP16_MAG / 2));
+	assert(FIXP16_TO_FLOAT(INT_TO_FIXP16(3) + FIXP16_ROUND_UP) == 3.5f);
+
+	// conversion with rounding (also for negative numbers)
+	assert(MathLib::Float_To_FIXP16(-1.5f) == -3 * (FIXP16_MAG / 2));
+	assert(MathLib::Float_To_FIXP16(-2.0f / FIXP16_MAG) == -2);
+	assert(MathLib::FIXP16_To_Float(MathLib::Float_To_FIXP16(-123.25f)) == -123.25f);
+
+	// multiplication/division: the product of big numbers doesn't fit into 32 bits
+	const FIXP16 a = MathLib::Float_To_FIXP16(300.5f);
+	const FIXP16 b = MathLib::Float_To_FIXP16(-20.25f);
+
+	assert(MathLib::FIXP16_Mul(a, b) == MathLib::Float_To_FIXP16(300.5f * -20.25f));
+	assert(MathLib::FIXP16_Div(MathLib::FIXP16_Mul(a, b), b) == a);
+	assert(MathLib::FIXP16_Div(INT_TO_FIXP16(1), INT_TO_FIXP16(3)) == FIXP16_MAG / 3);
+
+	// vectors
+	MathLib::FIXP16_VECTOR3D va, vb, vc;
+
+	MathLib::FIXP16_VECTOR3D_INIT_XYZ(va, INT_TO_FIXP16(1), INT_TO_FIXP16(0), INT_TO_FIXP16(0));
+	MathLib::FIXP16_VECTOR3D_INIT_XYZ(vb, INT_TO_FIXP16(0), INT_TO_FIXP16(2), INT_TO_FIXP16(0));
+	MathLib::FIXP16_VECTOR3D_Cross(va, vb, vc);
+
+	assert((vc.x == 0) && (vc.y == 0) && (vc.z == INT_TO_FIXP16(2)));
+	assert(MathLib::FIXP16_VECTOR3D_Dot(va, vb) == 0);
+
+	MathLib::FIXP16_VECTOR3D_Add(va, vb, vc);
+	MathLib::FIXP16_VECTOR3D_Scale(MathLib::Float_To_FIXP16(0.5f), vc);
+	assert((vc.x == FIXP16_ROUND_UP) && (vc.y == INT_TO_FIXP16(1)) && (vc.z == 0));
+	assert(MathLib::FIXP16_VECTOR3D_Dot(vc, vc) == MathLib::Float_To_FIXP16(1.25f));
+
+	MathLib::FIXP16_VECTOR2D v2a, v2b;
+	MathLib::FIXP16_VECTOR2D_INIT_XY(v2a, INT_TO_FIXP16(3), INT_TO_FIXP16(-4));
+	MathLib::FIXP16_VECTOR2D_INIT_XY(v2b, INT_TO_FIXP16(3), INT_TO_FIXP16(-4));
+	assert(MathLib::FIXP16_VECTOR2D_Dot(v2a, v2b) == INT_TO_FIXP16(25));
+
+	Log::Print(LOG_MACRO, "fixed-point arithmetic: success");
+
+} // end Test_Fixed_Point_Arithmetic
+
+///////////////////////////////////////////////////////////
+
+void Tests::Test_Fixed_Point_Transform()
+{
+	// this function tests transformation of fixed-point points by fixed-point matrices:
+	// the result must be close to the float one, and the batch kernels
+	// must be bit-compatible with FIXP16_Mat_Mul_VECTOR3D_4X4
+
+	MathLib::MATRIX4X4 m;
+	MathLib::FIXP16_MATRIX4X4 mfp, mfpProd;
+
+	MathLib::Mat_Init_4X4(&m,
+		 0.8f, 0.0f, -0.6f, 0.0f,
+		 0.0f, 1.0f,  0.0f, 0.0f,
+		 0.6f, 0.0f,  0.8f, 0.0f,
+		10.0f, -20.0f, 30.0f, 1.0f);
+
+	MathLib::Mat_4X4_To_FIXP16(&m, &mfp);
+
+	// multiplication by the identity matrix
+	MathLib::MATRIX4X4 identity = MathLib::IMAT_4X4;
+	MathLib::FIXP16_MATRIX4X4 identityFp;
+	MathLib::Mat_4X4_To_FIXP16(&identity, &identityFp);
+	MathLib::FIXP16_Mat_Mul_4X4(&mfp, &identityFp, &mfpProd);
+
+	assert(memcmp(&mfp, &mfpProd, sizeof(mfp)) == 0);
+
+	const int num = 1003;
+	std::vector<FIXP16> x(num), y(num), z(num);
+	std::mt19937 gen(5);
+	std::uniform_real_distribution<float> dist(-1000.0f, 1000.0f);
+
+	for (int i = 0; i < num; i++)
+	{
+		x[i] = MathLib::Float_To_FIXP16(dist(gen));
+		y[i] = MathLib::Float_To_FIXP16(dist(gen));
+		z[i] = MathLib::Float_To_FIXP16(dist(gen));
+	}
+
+	// the result must be close to the float one
+	for (int i = 0; i < num; i++)
+	{
+		MathLib::FIXP16_VECTOR3D vfp;
+		MathLib::VECTOR3D v, vr, vfpr;
+
+		MathLib::FIXP16_VECTOR3D_INIT_XYZ(vfp, x[i], y[i], z[i]);
+		MathLib::FIXP16_To_VECTOR3D(vfp, v);
+
+		MathLib::Mat_Mul_VECTOR3D_4X4(&v, &m, &vr);
+		MathLib::FIXP16_Mat_Mul_VECTOR3D_4X4(&vfp, &mfp, &vfp);
+		MathLib::FIXP16_To_VECTOR3D(vfp, vfpr);
+
+		assert(fabs(vr.x - vfpr.x) < 0.01f);
+		assert(fabs(vr.y - vfpr.y) < 0.01f);
+		assert(fabs(vr.z - vfpr.z) < 0.01f);
+	}
+
+	// batch kernels
+	const MathLib::SIMD_LEVEL cpuLevel = MathLib::SIMD_Get_Level();
+
+	for (int level = MathLib::SIMD_LEVEL_SCALAR; level <= cpuLevel; level++)
+	{
+		std::vector<FIXP16> xOut(num), yOut(num), zOut(num);
+
+		MathLib::SIMD_Set_Max_Level((MathLib::SIMD_LEVEL)level);
+		MathLib::FIXP16_Mat_Mul_VECTOR3D_4X4_Batch(x.data(), y.data(), z.data(), &mfp,
+			xOut.data(), yOut.data(), zOut.data(), num);
+
+		for (int i = 0; i < num; i++)
+		{
+			MathLib::FIXP16_VECTOR3D v;
+
+			MathLib::FIXP16_VECTOR3D_INIT_XYZ(v, x[i], y[i], z[i]);
+			MathLib::FIXP16_Mat_Mul_VECTOR3D_4X4(&v, &mfp, &v);
+
+			assert((v.x == xOut[i]) && (v.y == yOut[i]) && (v.z == zOut[i]));
+		}
+	}
+
+	// restore the default SIMD level
+	MathLib::SIMD_Set_Max_Level(MathLib::SIMD_LEVEL_AVX2);
+
+	Log::Print(LOG_MACRO, std::string("fixed-point transformation: up to ") +
+		MathLib::SIMD_Level_Name(cpuLevel) + ": success");
+
+} // end Test_Fixed_Point_Transform
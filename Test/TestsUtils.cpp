@@ -0,0 +1,258 @@
+/////////////////////////////////////////////////////////////////////////////////////////////
+// Filename:      TestsUtils.cpp
+// Description:   contains implementation of functional for testing common utils
+//                (trigonometric functions, etc.)
+//
+// Created:       17.10.26
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "Tests.h"
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                PUBLIC FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void Tests::Test_Utils()
+{
+	Log::Print("\n\n");
+	Log::Print("-------------------- TEST: UTILS -------------------------");
+
+	Test_SinCos();
+	Test_Atan2();
+	Test_Trig_Tables();
+
+} // end Test_Utils
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                PRIVATE FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void Tests::Test_SinCos()
+{
+	// this function tests computing of sine and cosine together by polynomials:
+	// accuracy of each precision and bit-compatibility of the array kernels
+
+	// the maximal allowed absolute error for each precision (and the additional
+	// error of the reduction for the angles near SINCOS_MAX_ARG)
+	const float maxError[3] = { 5e-4f, 3e-6f, 5e-7f };
+	const float maxReductionError = 2e-6f;
+
+	const int num = 1003;
+	std::vector<float> theta(num);
+	std::mt19937 gen(3);
+	std::uniform_real_distribution<float> dist(-100.0f, 100.0f);
+
+	for (int i = 0; i < num; i++)
+		theta[i] = dist(gen);
+
+	// the exact multiples of PI/2 and zeros must be handled as well
+	theta[0] = 0.0f;
+	theta[1] = -0.0f;
+	theta[2] = PI_DIV_2;
+	theta[3] = -PI;
+	theta[4] = 3 * PI_DIV_2;
+
+	// the angles near the limit of the reduction
+	theta[5] = 0.99f * MathLib::SINCOS_MAX_ARG;
+	theta[6] = -0.99f * MathLib::SINCOS_MAX_ARG;
+
+	const MathLib::SIMD_LEVEL cpuLevel = MathLib::SIMD_Get_Level();
+
+	for (int p = MathLib::SINCOS_PRECISION_LOW; p <= MathLib::SINCOS_PRECISION_HIGH; p++)
+	{
+		const MathLib::SINCOS_PRECISION precision = (MathLib::SINCOS_PRECISION)p;
+
+		// accuracy
+		for (int i = 0; i < num; i++)
+		{
+			float s, c;
+			MathLib::Fast_SinCos(theta[i], s, c, precision);
+
+			const float error = maxError[p] + ((fabsf(theta[i]) > 100.0f) ? maxReductionError : 0.0f);
+
+			assert(fabs(s - sin((double)theta[i])) < error);
+			assert(fabs(c - cos((double)theta[i])) < error);
+		}
+
+		// array kernels must be bit-compatible with Fast_SinCos
+		for (int level = MathLib::SIMD_LEVEL_SCALAR; level <= cpuLevel; level++)
+		{
+			std::vector<float> s(num), c(num);
+
+			MathLib::SIMD_Set_Max_Level((MathLib::SIMD_LEVEL)level);
+			MathLib::SinCos_Array(theta.data(), s.data(), c.data(), num, precision);
+
+			for (int i = 0; i < num; i++)
+			{
+				float sinT, cosT;
+				MathLib::Fast_SinCos(theta[i], sinT, cosT, precision);
+
+				assert(memcmp(&sinT, &s[i], sizeof(float)) == 0);
+				assert(memcmp(&cosT, &c[i], sizeof(float)) == 0);
+			}
+		}
+	}
+
+	// restore the default SIMD level
+	MathLib::SIMD_Set_Max_Level(MathLib::SIMD_LEVEL_AVX2);
+
+	Log::Print(LOG_MACRO, "sin/cos polynomials: success");
+
+} // end Test_SinCos
+
+///////////////////////////////////////////////////////////
+
+void Tests::Test_Atan2()
+{
+	// this function tests computing of atan2 by the polynomial: accuracy in all
+	// the octants, special values, and bit-compatibility of the array kernels
+
+	const int num = 1003;
+	std::vector<float> x(num), y(num);
+	std::mt19937 gen(4);
+	std::uniform_real_distribution<float> dist(-100.0f, 100.0f);
+
+	for (int i = 0; i < num; i++)
+	{
+		x[i] = dist(gen);
+		y[i] = dist(gen);
+	}
+
+	// the axes, the diagonals and zeros (atan2f handles the signs of zeros)
+	const float special[][2] =
+	{
+		{ 0.0f, 1.0f }, { 0.0f, -1.0f }, { 1.0f, 0.0f }, { -1.0f, 0.0f },
+		{ 1.0f, 1.0f }, { -1.0f, 1.0f }, { 1.0f, -1.0f }, { -1.0f, -1.0f },
+		{ 0.0f, 0.0f }, { -0.0f, 0.0f }, { 0.0f, -0.0f }, { -0.0f, -0.0f },
+	};
+
+	const int numSpecial = (int)(sizeof(special) / sizeof(special[0]));
+
+	for (int i = 0; i < numSpecial; i++)
+	{
+		y[i] = special[i][0];
+		x[i] = special[i][1];
+
+		const float angle = MathLib::Fast_Atan2(y[i], x[i]);
+		const float expected = atan2f(y[i], x[i]);
+
+		assert(fabs(angle - expected) < 5e-7f);
+		assert(std::signbit(angle) == std::signbit(expected));
+	}
+
+	// accuracy
+	for (int i = 0; i < num; i++)
+	{
+		const float angle = MathLib::Fast_Atan2(y[i], x[i]);
+		assert(fabs(angle - atan2((double)y[i], (double)x[i])) < 5e-7);
+	}
+
+	// array kernels must be bit-compatible with Fast_Atan2
+	const MathLib::SIMD_LEVEL cpuLevel = MathLib::SIMD_Get_Level();
+
+	for (int level = MathLib::SIMD_LEVEL_SCALAR; level <= cpuLevel; level++)
+	{
+		std::vector<float> angle(num);
+
+		MathLib::SIMD_Set_Max_Level((MathLib::SIMD_LEVEL)level);
+		MathLib::Atan2_Array(y.data(), x.data(), angle.data(), num);
+
+		for (int i = 0; i < num; i++)
+		{
+			const float expected = MathLib::Fast_Atan2(y[i], x[i]);
+			assert(memcmp(&expected, &angle[i], sizeof(float)) == 0);
+		}
+	}
+
+	// restore the default SIMD level
+	MathLib::SIMD_Set_Max_Level(MathLib::SIMD_LEVEL_AVX2);
+
+	Log::Print(LOG_MACRO, "atan2 polynomial: success");
+
+} // end Test_Atan2
+
+///////////////////////////////////////////////////////////
+
+template <int NUM_ENTRIES>
+static void Test_Trig_Look_Table(const std::vector<float> & theta, const float maxError)
+{
+	// checks the accuracy of the lookup table with NUM_ENTRIES entries
+
+	for (const float angle : theta)
+	{
+		assert(fabs(MathLib::Fast_Sin_LUT<NUM_ENTRIES>(angle) - sin((double)angle)) < maxError);
+		assert(fabs(MathLib::Fast_Cos_LUT<NUM_ENTRIES>(angle) - cos((double)angle)) < maxError);
+	}
+}
+
+///////////////////////////////////////////////////////////
+
+template <int NUM_ENTRIES>
+static void Test_Trig_Look_Table_Large(const std::vector<float> & theta)
+{
+	// checks the lookup table with NUM_ENTRIES entries for angles which give the index
+	// beyond the int range: the result must be the table value for the float index
+	// theta * NUM_ENTRIES / (2*PI) (which has no fractional part here)
+
+	const float entriesPerRadian = (float)(NUM_ENTRIES / (2.0 * MathLib::TRIG_TABLE_PI));
+
+	for (const float angle : theta)
+	{
+		const double index = fmod((double)(angle * entriesPerRadian), (double)NUM_ENTRIES);
+		const double refAngle = 2.0 * MathLib::TRIG_TABLE_PI * index / NUM_ENTRIES;
+
+		assert(fabs(MathLib::Fast_Sin_LUT<NUM_ENTRIES>(angle) - sin(refAngle)) < EPSILON_E6);
+		assert(fabs(MathLib::Fast_Cos_LUT<NUM_ENTRIES>(angle) - cos(refAngle)) < EPSILON_E6);
+	}
+}
+
+///////////////////////////////////////////////////////////
+
+void Tests::Test_Trig_Tables()
+{
+	// this function tests the lookup tables of sine/cosine which are generated at compile time
+
+	// the tables must be ready at compile time
+	static_assert(MathLib::TRIG_LOOK<360>.table[0] == 0.0f, "sin(0) must be 0");
+	static_assert(MathLib::TRIG_LOOK<360>.table[90] == 1.0f, "sin(90) must be 1");
+	static_assert(MathLib::TRIG_LOOK<1024>.table[256] == 1.0f, "sin(PI/2) must be 1");
+
+	// the legacy tables (angles in degrees)
+	assert(fabs(MathLib::sin_look[30] - 0.5f) < EPSILON_E6);
+	assert(fabs(MathLib::cos_look[60] - 0.5f) < EPSILON_E6);
+	assert(MathLib::cos_look[0] == 1.0f);
+	assert(MathLib::cos_look[360] == 1.0f);
+
+	assert(fabs(MathLib::Fast_Sin(30.0f) - 0.5f) < EPSILON_E5);
+	assert(fabs(MathLib::Fast_Cos(-60.0f) - 0.5f) < EPSILON_E5);
+	assert(fabs(MathLib::Fast_Sin(450.0f) - 1.0f) < EPSILON_E5);
+
+	// the tables of different resolutions (angles in radians within a couple of turns
+	// since theta * NUM_ENTRIES / (2*PI) loses the fractional bits for large angles)
+	const int num = 1000;
+	std::vector<float> theta(num);
+	std::mt19937 gen(4);
+	std::uniform_real_distribution<float> dist(-2 * PI2, 2 * PI2);
+
+	for (int i = 0; i < num; i++)
+		theta[i] = dist(gen);
+
+	Test_Trig_Look_Table<360>(theta, 5e-5f);
+	Test_Trig_Look_Table<1024>(theta, 6e-6f);
+	Test_Trig_Look_Table<4096>(theta, 1e-6f);
+
+	// large angles (the index doesn't fit into int)
+	const std::vector<float> largeTheta = { 1e7f, -1e7f, 3.3e7f, -1.234e9f, 1e20f, -3e34f };
+
+	Test_Trig_Look_Table_Large<360>(largeTheta);
+	Test_Trig_Look_Table_Large<4096>(largeTheta);
+
+	Log::Print(LOG_MACRO, "compile-time trig tables: success");
+
+} // end Test_Trig_Tables
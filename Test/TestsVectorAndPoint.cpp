@@ -62,6 +62,11 @@ void Tests::Test_2D_Vectors_Points()
 
 void Tests::Test_3D_Vectors_Points()
 {
+	// this function tests functional for work with 3D vectors and points
+
+	Log::Print("-------------------- TEST: 3D VECTORS --------------------\n");
+
+	Test_3D_Vectors_Oct_Packing();
 
 } // end Test_3D_Vectors_Points
 
@@ -229,3 +234,126 @@ void Tests::Test_2D_Vectors_Math_Operations()
 	return;
 
 } // end Test_2D_Vectors_Points_Math_Operations
+
+///////////////////////////////////////////////////////////
+
+void Tests::Test_3D_Vectors_Oct_Packing()
+{
+	// this function tests the octahedral packing of unit vectors: the angle between
+	// the source and the restored vectors must be within the error bound of the format,
+	// the restored vectors must be unit, and the batch kernels must give the same bits
+	// as the packing/unpacking of single vectors
+
+	std::mt19937 gen(25);
+	std::normal_distribution<float> dist(0.0f, 1.0f);
+
+	// the random directions + the axes and the diagonals (the edges of the octahedron)
+	std::vector<MathLib::VECTOR3D> vecs;
+
+	for (int i = -1; i <= 1; i++)
+		for (int j = -1; j <= 1; j++)
+			for (int k = -1; k <= 1; k++)
+				if (i || j || k)
+					vecs.push_back(MathLib::VECTOR3D((float)i, (float)j, (float)k));
+
+	while (vecs.size() < 10003)
+		vecs.push_back(MathLib::VECTOR3D(dist(gen), dist(gen), dist(gen)));
+
+	const int num = (int)vecs.size();
+
+	std::vector<float> xIn(num), yIn(num), zIn(num);
+
+	for (int i = 0; i < num; i++)
+	{
+		MathLib::VECTOR3D_Normalize(vecs[i]);
+
+		xIn[i] = vecs[i].x;
+		yIn[i] = vecs[i].y;
+		zIn[i] = vecs[i].z;
+	}
+
+	std::vector<MathLib::VECTOR3D_OCT16> packed16(num), batch16(num);
+	std::vector<MathLib::VECTOR3D_OCT32> packed32(num), batch32(num);
+	std::vector<MathLib::VECTOR3D> unpacked16(num), unpacked32(num);
+
+	// the angle between the vectors (computed in double to be precise for small angles)
+	auto Angle = [](const MathLib::VECTOR3D & a, const MathLib::VECTOR3D & b)
+	{
+		const double cx = (double)a.y * b.z - (double)a.z * b.y;
+		const double cy = (double)a.z * b.x - (double)a.x * b.z;
+		const double cz = (double)a.x * b.y - (double)a.y * b.x;
+		const double dot = (double)a.x * b.x + (double)a.y * b.y + (double)a.z * b.z;
+
+		return atan2(sqrt(cx * cx + cy * cy + cz * cz), dot);
+	};
+
+	double maxAngle16 = 0.0;
+	double maxAngle32 = 0.0;
+
+	for (int i = 0; i < num; i++)
+	{
+		MathLib::VECTOR3D_Pack_Oct(vecs[i], packed16[i]);
+		MathLib::VECTOR3D_Pack_Oct(vecs[i], packed32[i]);
+
+		MathLib::VECTOR3D_Unpack_Oct(packed16[i], unpacked16[i]);
+		MathLib::VECTOR3D_Unpack_Oct(packed32[i], unpacked32[i]);
+
+		assert(fabsf(MathLib::VECTOR3D_Length(unpacked16[i]) - 1.0f) < EPSILON_E5);
+		assert(fabsf(MathLib::VECTOR3D_Length(unpacked32[i]) - 1.0f) < EPSILON_E5);
+
+		maxAngle16 = std::max(maxAngle16, Angle(vecs[i], unpacked16[i]));
+		maxAngle32 = std::max(maxAngle32, Angle(vecs[i], unpacked32[i]));
+	}
+
+	assert(maxAngle16 < 0.017);
+	assert(maxAngle32 < 0.00007);
+
+	// the axes are packed exactly
+	for (int i = 0; i < 26; i++)
+	{
+		if (fabsf(vecs[i].x) + fabsf(vecs[i].y) + fabsf(vecs[i].z) == 1.0f)
+		{
+			assert(memcmp(&vecs[i], &unpacked16[i], sizeof(MathLib::VECTOR3D)) == 0);
+			assert(memcmp(&vecs[i], &unpacked32[i], sizeof(MathLib::VECTOR3D)) == 0);
+		}
+	}
+
+	const MathLib::SIMD_LEVEL cpuLevel = MathLib::SIMD_Get_Level();
+
+	for (int level = MathLib::SIMD_LEVEL_SCALAR; level <= cpuLevel; level++)
+	{
+		std::vector<float> xOut(num), yOut(num), zOut(num);
+
+		MathLib::SIMD_Set_Max_Level((MathLib::SIMD_LEVEL)level);
+
+		MathLib::VECTOR3D_Pack_Oct_Batch(xIn.data(), yIn.data(), zIn.data(), batch16.data(), num);
+		MathLib::VECTOR3D_Pack_Oct_Batch(xIn.data(), yIn.data(), zIn.data(), batch32.data(), num);
+
+		assert(memcmp(batch16.data(), packed16.data(), num * sizeof(MathLib::VECTOR3D_OCT16)) == 0);
+		assert(memcmp(batch32.data(), packed32.data(), num * sizeof(MathLib::VECTOR3D_OCT32)) == 0);
+
+		for (int format = 0; format < 2; format++)
+		{
+			const std::vector<MathLib::VECTOR3D> & ref = (format == 0) ? unpacked16 : unpacked32;
+
+			if (format == 0)
+				MathLib::VECTOR3D_Unpack_Oct_Batch(batch16.data(), xOut.data(), yOut.data(), zOut.data(), num);
+			else
+				MathLib::VECTOR3D_Unpack_Oct_Batch(batch32.data(), xOut.data(), yOut.data(), zOut.data(), num);
+
+			for (int i = 0; i < num; i++)
+			{
+				assert(memcmp(&ref[i].x, &xOut[i], sizeof(float)) == 0);
+				assert(memcmp(&ref[i].y, &yOut[i], sizeof(float)) == 0);
+				assert(memcmp(&ref[i].z, &zOut[i], sizeof(float)) == 0);
+			}
+		}
+	}
+
+	// restore the default SIMD level
+	MathLib::SIMD_Set_Max_Level(MathLib::SIMD_LEVEL_AVX2);
+
+	Log::Print(LOG_MACRO, std::string("octahedral packing of 3D vectors: up to ") +
+		MathLib::SIMD_Level_Name(cpuLevel) + ": success");
+
+} // end Test_3D_Vectors_Oct_Packing
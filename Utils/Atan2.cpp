@@ -0,0 +1,266 @@
+////////////////////////////////////////////////////////////////////////////////////////////
+// Filename:      Atan2.cpp
+// Description:   contains implementation of computing atan2(y, x) by a polynomial
+//                (scalar, SSE and AVX2 kernels + runtime dispatching)
+//
+// Created:       17.10.26
+////////////////////////////////////////////////////////////////////////////////////////////
+#include "Atan2.h"
+#include "Simd.h"
+
+#include <cassert>
+
+
+namespace MathLib
+{
+
+//
+// NOTE: all the kernels use the same order of operations as Fast_Atan2:
+//
+//   1. mn = min(|x|, |y|), mx = max(|x|, |y|), so the angle atan(mn/mx) is in [0, PI/4];
+//   2. if mn/mx > tan(PI/8) then t = (mn - mx) / (mn + mx) and the angle is PI/4 + atan(t),
+//      in another case t = mn/mx; anyway t is in [-tan(PI/8), tan(PI/8)];
+//   3. atan(t) by the polynomial;
+//   4. restore the octant: PI/2 - r if |y| > |x|;  PI - r if x < 0 (the sign bit);
+//      and the sign of y
+//
+// there is only one division and no branches so the SIMD kernels just use masks
+//
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                              SINGLE COMPUTATION
+////////////////////////////////////////////////////////////////////////////////////////////
+
+float Fast_Atan2(const float y, const float x)
+{
+	// this function computes atan2(y, x) (in radians, in [-PI, PI])
+
+	const float ax = fabsf(x);
+	const float ay = fabsf(y);
+
+	const float mn = (ax < ay) ? ax : ay;
+	const float mx = (ax > ay) ? ax : ay;
+
+	// reduce the argument into [-tan(PI/8), tan(PI/8)]
+	const bool big = (mn > (ATAN2_TAN_PI_DIV_8 * mx));
+	const float n = big ? (mn - mx) : mn;
+	const float d = big ? (mn + mx) : mx;
+	const float t = (d > 0.0f) ? (n / d) : 0.0f;
+
+	// compute the polynomial using Horner's scheme
+	const float z = t * t;
+	float p = ATAN2_COEFFS[3];
+
+	p = (p * z) + ATAN2_COEFFS[2];
+	p = (p * z) + ATAN2_COEFFS[1];
+	p = (p * z) + ATAN2_COEFFS[0];
+
+	float r = t + ((t * z) * p);
+
+	// restore the octant and the sign
+	r = big ? (r + ATAN2_PI_DIV_4) : r;
+	r = (ay > ax) ? (ATAN2_PI_DIV_2 - r) : r;
+	r = std::signbit(x) ? (ATAN2_PI - r) : r;
+
+	return std::signbit(y) ? -r : r;
+
+} // end Fast_Atan2
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                ARRAY COMPUTATION
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void Atan2_Array_Scalar(const float* y, const float* x, float* angle, const int num)
+{
+	// computes atan2 of num pairs using plain C++ code (reference kernel)
+
+	assert(y && x);
+	assert(angle != nullptr);
+	assert(num >= 0);
+
+	for (int i = 0; i < num; i++)
+	{
+		angle[i] = Fast_Atan2(y[i], x[i]);
+	}
+
+} // end Atan2_Array_Scalar
+
+///////////////////////////////////////////////////////////
+
+#if MATHLIB_SIMD_X86
+
+MATHLIB_TARGET_SSE41
+void Atan2_Array_SSE(const float* y, const float* x, float* angle, const int num)
+{
+	// computes atan2 of num pairs; processes 4 pairs per iteration;
+	// the tail (num % 4 pairs) is processed by the scalar kernel
+
+	assert(y && x);
+	assert(angle != nullptr);
+	assert(num >= 0);
+
+	const __m128 signMask = _mm_set1_ps(-0.0f);
+	const __m128 tanPiDiv8 = _mm_set1_ps(ATAN2_TAN_PI_DIV_8);
+	const __m128 a0 = _mm_set1_ps(ATAN2_COEFFS[0]);
+	const __m128 a1 = _mm_set1_ps(ATAN2_COEFFS[1]);
+	const __m128 a2 = _mm_set1_ps(ATAN2_COEFFS[2]);
+	const __m128 a3 = _mm_set1_ps(ATAN2_COEFFS[3]);
+	const __m128 pi = _mm_set1_ps(ATAN2_PI);
+	const __m128 piDiv2 = _mm_set1_ps(ATAN2_PI_DIV_2);
+	const __m128 piDiv4 = _mm_set1_ps(ATAN2_PI_DIV_4);
+	const __m128 zero = _mm_setzero_ps();
+
+	int i = 0;
+
+	for (; i + 4 <= num; i += 4)
+	{
+		const __m128 vx = _mm_loadu_ps(x + i);
+		const __m128 vy = _mm_loadu_ps(y + i);
+
+		const __m128 ax = _mm_andnot_ps(signMask, vx);
+		const __m128 ay = _mm_andnot_ps(signMask, vy);
+
+		const __m128 mn = _mm_min_ps(ax, ay);
+		const __m128 mx = _mm_max_ps(ax, ay);
+
+		// reduce the argument into [-tan(PI/8), tan(PI/8)]
+		const __m128 big = _mm_cmpgt_ps(mn, _mm_mul_ps(tanPiDiv8, mx));
+		const __m128 n = _mm_blendv_ps(mn, _mm_sub_ps(mn, mx), big);
+		const __m128 d = _mm_blendv_ps(mx, _mm_add_ps(mn, mx), big);
+		const __m128 t = _mm_and_ps(_mm_div_ps(n, d), _mm_cmpgt_ps(d, zero));
+
+		// compute the polynomial using Horner's scheme
+		const __m128 z = _mm_mul_ps(t, t);
+		__m128 p = a3;
+
+		p = _mm_add_ps(_mm_mul_ps(p, z), a2);
+		p = _mm_add_ps(_mm_mul_ps(p, z), a1);
+		p = _mm_add_ps(_mm_mul_ps(p, z), a0);
+
+		__m128 r = _mm_add_ps(t, _mm_mul_ps(_mm_mul_ps(t, z), p));
+
+		// restore the octant and the sign (blendv uses the sign bit of x as the mask)
+		r = _mm_blendv_ps(r, _mm_add_ps(r, piDiv4), big);
+		r = _mm_blendv_ps(r, _mm_sub_ps(piDiv2, r), _mm_cmpgt_ps(ay, ax));
+		r = _mm_blendv_ps(r, _mm_sub_ps(pi, r), vx);
+		r = _mm_xor_ps(r, _mm_and_ps(vy, signMask));
+
+		_mm_storeu_ps(angle + i, r);
+	}
+
+	// process the rest of pairs
+	Atan2_Array_Scalar(y + i, x + i, angle + i, num - i);
+
+} // end Atan2_Array_SSE
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_AVX2
+void Atan2_Array_AVX2(const float* y, const float* x, float* angle, const int num)
+{
+	// computes atan2 of num pairs; processes 8 pairs per iteration;
+	// the tail (num % 8 pairs) is processed by the SSE kernel
+	//
+	// NOTE: FMA isn't used here on purpose (see the note in Simd.h)
+
+	assert(y && x);
+	assert(angle != nullptr);
+	assert(num >= 0);
+
+	const __m256 signMask = _mm256_set1_ps(-0.0f);
+	const __m256 tanPiDiv8 = _mm256_set1_ps(ATAN2_TAN_PI_DIV_8);
+	const __m256 a0 = _mm256_set1_ps(ATAN2_COEFFS[0]);
+	const __m256 a1 = _mm256_set1_ps(ATAN2_COEFFS[1]);
+	const __m256 a2 = _mm256_set1_ps(ATAN2_COEFFS[2]);
+	const __m256 a3 = _mm256_set1_ps(ATAN2_COEFFS[3]);
+	const __m256 pi = _mm256_set1_ps(ATAN2_PI);
+	const __m256 piDiv2 = _mm256_set1_ps(ATAN2_PI_DIV_2);
+	const __m256 piDiv4 = _mm256_set1_ps(ATAN2_PI_DIV_4);
+	const __m256 zero = _mm256_setzero_ps();
+
+	int i = 0;
+
+	for (; i + 8 <= num; i += 8)
+	{
+		const __m256 vx = _mm256_loadu_ps(x + i);
+		const __m256 vy = _mm256_loadu_ps(y + i);
+
+		const __m256 ax = _mm256_andnot_ps(signMask, vx);
+		const __m256 ay = _mm256_andnot_ps(signMask, vy);
+
+		const __m256 mn = _mm256_min_ps(ax, ay);
+		const __m256 mx = _mm256_max_ps(ax, ay);
+
+		// reduce the argument into [-tan(PI/8), tan(PI/8)]
+		const __m256 big = _mm256_cmp_ps(mn, _mm256_mul_ps(tanPiDiv8, mx), _CMP_GT_OQ);
+		const __m256 n = _mm256_blendv_ps(mn, _mm256_sub_ps(mn, mx), big);
+		const __m256 d = _mm256_blendv_ps(mx, _mm256_add_ps(mn, mx), big);
+		const __m256 t = _mm256_and_ps(_mm256_div_ps(n, d), _mm256_cmp_ps(d, zero, _CMP_GT_OQ));
+
+		// compute the polynomial using Horner's scheme
+		const __m256 z = _mm256_mul_ps(t, t);
+		__m256 p = a3;
+
+		p = _mm256_add_ps(_mm256_mul_ps(p, z), a2);
+		p = _mm256_add_ps(_mm256_mul_ps(p, z), a1);
+		p = _mm256_add_ps(_mm256_mul_ps(p, z), a0);
+
+		__m256 r = _mm256_add_ps(t, _mm256_mul_ps(_mm256_mul_ps(t, z), p));
+
+		// restore the octant and the sign (blendv uses the sign bit of x as the mask)
+		r = _mm256_blendv_ps(r, _mm256_add_ps(r, piDiv4), big);
+		r = _mm256_blendv_ps(r, _mm256_sub_ps(piDiv2, r), _mm256_cmp_ps(ay, ax, _CMP_GT_OQ));
+		r = _mm256_blendv_ps(r, _mm256_sub_ps(pi, r), vx);
+		r = _mm256_xor_ps(r, _mm256_and_ps(vy, signMask));
+
+		_mm256_storeu_ps(angle + i, r);
+	}
+
+	// process the rest of pairs
+	Atan2_Array_SSE(y + i, x + i, angle + i, num - i);
+
+} // end Atan2_Array_AVX2
+
+#else
+
+// there is no SIMD support for this platform so use the reference kernel
+
+void Atan2_Array_SSE(const float* y, const float* x, float* angle, const int num)
+{
+	Atan2_Array_Scalar(y, x, angle, num);
+}
+
+void Atan2_Array_AVX2(const float* y, const float* x, float* angle, const int num)
+{
+	Atan2_Array_Scalar(y, x, angle, num);
+}
+
+#endif // MATHLIB_SIMD_X86
+
+///////////////////////////////////////////////////////////
+
+void Atan2_Array(const float* y, const float* x, float* angle, const int num)
+{
+	// computes atan2 of num pairs using the best kernel for the current CPU
+
+	switch (SIMD_Get_Level())
+	{
+		case SIMD_LEVEL_AVX2:
+			Atan2_Array_AVX2(y, x, angle, num);
+			break;
+
+		case SIMD_LEVEL_AVX:
+		case SIMD_LEVEL_SSE:
+			Atan2_Array_SSE(y, x, angle, num);
+			break;
+
+		default:
+			Atan2_Array_Scalar(y, x, angle, num);
+	}
+
+} // end Atan2_Array
+
+} // end namespace MathLib
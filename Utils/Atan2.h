@@ -0,0 +1,67 @@
+////////////////////////////////////////////////////////////////////////////////////////////
+// Filename:      Atan2.h
+// Description:   contains functional for computing the four-quadrant arctangent
+//                atan2(y, x) using a polynomial approximation; also there are
+//                array versions (scalar, SSE and AVX2 kernels)
+//
+// Created:       17.10.26
+////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <cmath>
+
+#include "../MathConstant.h"
+
+
+namespace MathLib
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                   CONSTANTS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+// coefficients of the polynomial for atan(t) on [-tan(PI/8), tan(PI/8)]
+// (taken from the Cephes library (atanf)):
+//
+//   atan(t) = t + t*z * (A[0] + z*A[1] + z^2*A[2] + z^3*A[3])      (z = t^2)
+constexpr float ATAN2_COEFFS[4] =
+{
+	-3.33329491539e-1f, 1.99777106478e-1f, -1.38776856032e-1f, 8.05374449538e-2f
+};
+
+constexpr float ATAN2_TAN_PI_DIV_8 = 0.414213562373095f;
+constexpr float ATAN2_PI           = 3.14159265358979f;
+constexpr float ATAN2_PI_DIV_2     = 1.57079632679490f;
+constexpr float ATAN2_PI_DIV_4     = 0.78539816339745f;
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                            FUNCTIONS PROTOTYPES
+////////////////////////////////////////////////////////////////////////////////////////////
+
+// computes atan2(y, x) in [-PI, PI]; the maximal error is about 2e-7 rad;
+// atan2(0, 0) == 0 and the signs of zeros are handled as in atan2f;
+// the arguments must be finite
+float Fast_Atan2(const float y, const float x);
+
+///////////////////////////////////////////////////////////////
+
+//
+// each function computes angle[i] = atan2(y[i], x[i]) for num pairs;
+// the results are bit-compatible with Fast_Atan2 for each kernel;
+//
+// the output stream may be the same as one of the input streams (in-place computation),
+// but the streams must not partially overlap
+//
+
+// chooses the best kernel for the current CPU (see SIMD_Get_Level)
+void Atan2_Array(const float* y, const float* x, float* angle, const int num);
+
+// separate kernels (SSE/AVX2 kernels must be called only if the CPU supports them)
+void Atan2_Array_Scalar(const float* y, const float* x, float* angle, const int num);
+void Atan2_Array_SSE   (const float* y, const float* x, float* angle, const int num);
+void Atan2_Array_AVX2  (const float* y, const float* x, float* angle, const int num);
+
+} // end namespace MathLib
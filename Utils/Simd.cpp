@@ -0,0 +1,170 @@
+////////////////////////////////////////////////////////////////////////////////////////////
+// Filename:      Simd.cpp
+// Description:   contains implementation of runtime detection of the CPU features
+//                and selection of the SIMD level for kernels dispatching
+//
+// Created:       17.10.26
+////////////////////////////////////////////////////////////////////////////////////////////
+#include "Simd.h"
+
+#if MATHLIB_SIMD_X86
+	#if defined(_MSC_VER)
+		#include <intrin.h>
+	#else
+		#include <cpuid.h>
+	#endif
+#endif
+
+
+namespace MathLib
+{
+
+// the maximal SIMD level which is allowed by the user (see SIMD_Set_Max_Level)
+static SIMD_LEVEL s_maxLevel = SIMD_LEVEL_AVX2;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                 HELPERS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+#if MATHLIB_SIMD_X86
+
+static void Cpuid(int regs[4], const int leaf, const int subleaf)
+{
+	// executes the CPUID instruction and stores EAX, EBX, ECX, EDX into regs
+
+#if defined(_MSC_VER)
+	__cpuidex(regs, leaf, subleaf);
+#else
+	unsigned int a = 0, b = 0, c = 0, d = 0;
+	__cpuid_count(leaf, subleaf, a, b, c, d);
+	regs[0] = (int)a; regs[1] = (int)b; regs[2] = (int)c; regs[3] = (int)d;
+#endif
+
+} // end Cpuid
+
+///////////////////////////////////////////////////////////
+
+static unsigned long long Xgetbv0()
+{
+	// returns XCR0 register which tells us what registers are saved by the OS
+
+#if defined(_MSC_VER)
+	return _xgetbv(0);
+#else
+	unsigned int eax = 0, edx = 0;
+	__asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+	return ((unsigned long long)edx << 32) | eax;
+#endif
+
+} // end Xgetbv0
+
+#endif // MATHLIB_SIMD_X86
+
+///////////////////////////////////////////////////////////
+
+static CPU_FEATURES Detect_CPU_Features()
+{
+	// this function asks the CPU about its features
+
+	CPU_FEATURES features;
+
+#if MATHLIB_SIMD_X86
+	int regs[4] = { 0 };
+
+	Cpuid(regs, 0, 0);
+	const int maxLeaf = regs[0];
+
+	Cpuid(regs, 1, 0);
+	const int ecx1 = regs[2];
+	const int edx1 = regs[3];
+
+	features.sse2  = (edx1 & (1 << 26)) != 0;
+	features.sse41 = (ecx1 & (1 << 19)) != 0;
+
+	// AVX can be used only if the OS saves XMM and YMM registers during context switches
+	const bool osxsave = (ecx1 & (1 << 27)) != 0;
+	const bool osYmm   = osxsave && ((Xgetbv0() & 0x6) == 0x6);
+
+	features.avx  = osYmm && ((ecx1 & (1 << 28)) != 0);
+	features.fma  = features.avx && ((ecx1 & (1 << 12)) != 0);
+	features.f16c = features.avx && ((ecx1 & (1 << 29)) != 0);
+
+	if (maxLeaf >= 7)
+	{
+		Cpuid(regs, 7, 0);
+		features.avx2 = features.avx && ((regs[1] & (1 << 5)) != 0);
+	}
+#endif
+
+	return features;
+
+} // end Detect_CPU_Features
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                             PUBLIC FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+const CPU_FEATURES & CPU_Get_Features()
+{
+	// returns features of the CPU; the detection is executed only once
+
+	static const CPU_FEATURES features = Detect_CPU_Features();
+	return features;
+
+} // end CPU_Get_Features
+
+///////////////////////////////////////////////////////////
+
+SIMD_LEVEL SIMD_Get_Level()
+{
+	// returns the highest SIMD level which is supported by the CPU
+	// and is allowed by the user at the same time
+
+	static const SIMD_LEVEL cpuLevel = []()
+	{
+		const CPU_FEATURES & f = CPU_Get_Features();
+
+		if (f.avx2 && f.fma)    return SIMD_LEVEL_AVX2;
+		if (f.avx)              return SIMD_LEVEL_AVX;
+		if (f.sse2 && f.sse41)  return SIMD_LEVEL_SSE;
+		return SIMD_LEVEL_SCALAR;
+	}();
+
+	return (cpuLevel < s_maxLevel) ? cpuLevel : s_maxLevel;
+
+} // end SIMD_Get_Level
+
+///////////////////////////////////////////////////////////
+
+void SIMD_Set_Max_Level(const SIMD_LEVEL level)
+{
+	// limits the SIMD level used by dispatchers; it is useful for testing
+	// or benchmarking of different kernels on the same machine
+
+	s_maxLevel = level;
+
+} // end SIMD_Set_Max_Level
+
+///////////////////////////////////////////////////////////
+
+const char* SIMD_Level_Name(const SIMD_LEVEL level)
+{
+	// returns a printable name of the SIMD level
+
+	switch (level)
+	{
+		case SIMD_LEVEL_SCALAR: return "scalar";
+		case SIMD_LEVEL_SSE:    return "SSE";
+		case SIMD_LEVEL_AVX:    return "AVX";
+		case SIMD_LEVEL_AVX2:   return "AVX2";
+	}
+
+	return "unknown";
+
+} // end SIMD_Level_Name
+
+} // end namespace MathLib
@@ -0,0 +1,90 @@
+////////////////////////////////////////////////////////////////////////////////////////////
+// Filename:      Simd.h
+// Description:   contains common stuff for SIMD kernels of the math library:
+//                intrinsics headers, target attributes for the kernels, and
+//                runtime detection of the CPU features (for kernels dispatching)
+//
+// Created:       17.10.26
+////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+
+//////////////////////////////////
+//          INCLUDES
+//////////////////////////////////
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+	#define MATHLIB_SIMD_X86 1
+	#include <immintrin.h>
+#else
+	#define MATHLIB_SIMD_X86 0
+#endif
+
+
+//////////////////////////////////
+//      TARGET ATTRIBUTES
+//////////////////////////////////
+
+// MSVC allows any intrinsics in any function so there we don't need attributes at all;
+// GCC/Clang needs to know that a function may use instructions above the baseline;
+//
+// NOTE: MATHLIB_TARGET_AVX2 doesn't enable FMA on purpose: a compiler is allowed
+//       to contract a separate mul+add into a single FMA instruction, and then
+//       the result will differ from the scalar reference path in the last bit
+#if defined(_MSC_VER) && !defined(__clang__)
+	#define MATHLIB_TARGET_SSE41
+	#define MATHLIB_TARGET_AVX
+	#define MATHLIB_TARGET_AVX2
+	#define MATHLIB_TARGET_AVX2_FMA
+	#define MATHLIB_TARGET_AVX2_F16C
+#else
+	#define MATHLIB_TARGET_SSE41     __attribute__((target("sse4.1")))
+	#define MATHLIB_TARGET_AVX       __attribute__((target("avx")))
+	#define MATHLIB_TARGET_AVX2      __attribute__((target("avx2")))
+	#define MATHLIB_TARGET_AVX2_FMA  __attribute__((target("avx2,fma")))
+	#define MATHLIB_TARGET_AVX2_F16C __attribute__((target("avx2,f16c")))
+#endif
+
+
+namespace MathLib
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                 DATA STRUCTURES
+////////////////////////////////////////////////////////////////////////////////////////////
+
+// levels of SIMD support which are used for choosing a kernel at runtime;
+// (each next level includes all the previous ones)
+enum SIMD_LEVEL
+{
+	SIMD_LEVEL_SCALAR = 0,   // plain C++ code (reference path)
+	SIMD_LEVEL_SSE    = 1,   // SSE2 (baseline for x64) + SSE4.1
+	SIMD_LEVEL_AVX    = 2,   // AVX (256-bit float operations)
+	SIMD_LEVEL_AVX2   = 3,   // AVX2 (256-bit integer operations) + FMA
+};
+
+
+// features of the CPU which are important for the math library
+typedef struct CPU_FEATURES_TYPE
+{
+	bool sse2  = false;
+	bool sse41 = false;
+	bool avx   = false;      // also checks that OS saves YMM registers
+	bool avx2  = false;
+	bool fma   = false;
+	bool f16c  = false;
+} CPU_FEATURES, *CPU_FEATURES_PTR;
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                            FUNCTIONS PROTOTYPES
+////////////////////////////////////////////////////////////////////////////////////////////
+
+const CPU_FEATURES & CPU_Get_Features();      // features are detected only once
+
+SIMD_LEVEL SIMD_Get_Level();                  // level which is used by dispatchers
+void SIMD_Set_Max_Level(const SIMD_LEVEL level);  // limit the level (for tests and benchmarks)
+const char* SIMD_Level_Name(const SIMD_LEVEL level);
+
+} // end namespace MathLib
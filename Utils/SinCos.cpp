@@ -0,0 +1,295 @@
+////////////////////////////////////////////////////////////////////////////////////////////
+// Filename:      SinCos.cpp
+// Description:   contains implementation of computing sine and cosine together
+//                (scalar, SSE and AVX2 kernels + runtime dispatching)
+//
+// Created:       17.10.26
+////////////////////////////////////////////////////////////////////////////////////////////
+#include "SinCos.h"
+#include "Simd.h"
+
+#include <cassert>
+#include <climits>
+
+
+namespace MathLib
+{
+
+//
+// NOTE: all the kernels use the same order of operations as Fast_SinCos:
+//
+//   1. k = round(theta * 2/PI);  r = theta - k*PI/2   (r is in [-PI/4, PI/4])
+//   2. sin(r) and cos(r) by the polynomials
+//   3. the quadrant (k & 3) defines which of them is sin(theta)/cos(theta) and the signs:
+//
+//        quadrant:     0         1          2          3
+//        sin:        sin(r)    cos(r)    -sin(r)    -cos(r)
+//        cos:        cos(r)   -sin(r)    -cos(r)     sin(r)
+//
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                              SINGLE COMPUTATION
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void Fast_SinCos(const float theta, float & s, float & c, const SINCOS_PRECISION precision)
+{
+	// this function computes sine and cosine of the angle theta (in radians) together
+
+	assert((precision >= SINCOS_PRECISION_LOW) && (precision <= SINCOS_PRECISION_HIGH));
+	assert(fabsf(theta) < SINCOS_MAX_ARG);
+
+	const SINCOS_COEFFS & cf = SINCOS_COEFFS_TABLE[precision];
+
+	// reduce the angle into [-PI/4, PI/4]
+	const float k = ((theta * SINCOS_2_DIV_PI) + SINCOS_ROUND_MAGIC) - SINCOS_ROUND_MAGIC;
+
+	// (int)k is undefined out of the int range, so such k (and NaN) are
+	// mapped to 0x80000000 as _mm_cvttps_epi32 does in the SIMD kernels
+	const int quadrant = (fabsf(k) < 2147483648.0f) ? (int)k : INT_MIN;
+
+	float r = theta - (k * SINCOS_PI_DIV_2_A);
+	r = r - (k * SINCOS_PI_DIV_2_B);
+	r = r - (k * SINCOS_PI_DIV_2_C);
+
+	// compute the polynomials using Horner's scheme
+	const float z = r * r;
+	float ps = cf.S[cf.num - 1];
+	float pc = cf.C[cf.num - 1];
+
+	for (int i = cf.num - 2; i >= 0; i--)
+	{
+		ps = (ps * z) + cf.S[i];
+		pc = (pc * z) + cf.C[i];
+	}
+
+	const float sinR = r + ((r * z) * ps);
+	const float cosR = (1.0f - (0.5f * z)) + ((z * z) * pc);
+
+	// choose the functions and the signs by the quadrant
+	const float a = (quadrant & 1) ? cosR : sinR;
+	const float b = (quadrant & 1) ? sinR : cosR;
+
+	s = (quadrant & 2) ? -a : a;
+	c = ((quadrant + 1) & 2) ? -b : b;
+
+} // end Fast_SinCos
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                ARRAY COMPUTATION
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void SinCos_Array_Scalar(const float* theta, float* s, float* c, const int num,
+	const SINCOS_PRECISION precision)
+{
+	// computes sine and cosine of num angles using plain C++ code (reference kernel)
+
+	assert(theta != nullptr);
+	assert(s && c);
+	assert(num >= 0);
+
+	for (int i = 0; i < num; i++)
+	{
+		float sinT, cosT;
+
+		Fast_SinCos(theta[i], sinT, cosT, precision);
+
+		s[i] = sinT;
+		c[i] = cosT;
+	}
+
+} // end SinCos_Array_Scalar
+
+///////////////////////////////////////////////////////////
+
+#if MATHLIB_SIMD_X86
+
+MATHLIB_TARGET_SSE41
+void SinCos_Array_SSE(const float* theta, float* s, float* c, const int num,
+	const SINCOS_PRECISION precision)
+{
+	// computes sine and cosine of num angles; processes 4 angles per iteration;
+	// the tail (num % 4 angles) is processed by the scalar kernel
+
+	assert(theta != nullptr);
+	assert(s && c);
+	assert(num >= 0);
+	assert((precision >= SINCOS_PRECISION_LOW) && (precision <= SINCOS_PRECISION_HIGH));
+
+	const SINCOS_COEFFS & cf = SINCOS_COEFFS_TABLE[precision];
+
+	const __m128 twoDivPi = _mm_set1_ps(SINCOS_2_DIV_PI);
+	const __m128 magic = _mm_set1_ps(SINCOS_ROUND_MAGIC);
+	const __m128 pio2A = _mm_set1_ps(SINCOS_PI_DIV_2_A);
+	const __m128 pio2B = _mm_set1_ps(SINCOS_PI_DIV_2_B);
+	const __m128 pio2C = _mm_set1_ps(SINCOS_PI_DIV_2_C);
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 half = _mm_set1_ps(0.5f);
+	const __m128i intOne = _mm_set1_epi32(1);
+	const __m128i intTwo = _mm_set1_epi32(2);
+
+	int i = 0;
+
+	for (; i + 4 <= num; i += 4)
+	{
+		const __m128 x = _mm_loadu_ps(theta + i);
+
+		// reduce the angle into [-PI/4, PI/4]
+		const __m128 k = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(x, twoDivPi), magic), magic);
+		const __m128i quadrant = _mm_cvttps_epi32(k);
+
+		__m128 r = _mm_sub_ps(x, _mm_mul_ps(k, pio2A));
+		r = _mm_sub_ps(r, _mm_mul_ps(k, pio2B));
+		r = _mm_sub_ps(r, _mm_mul_ps(k, pio2C));
+
+		// compute the polynomials using Horner's scheme
+		const __m128 z = _mm_mul_ps(r, r);
+		__m128 ps = _mm_set1_ps(cf.S[cf.num - 1]);
+		__m128 pc = _mm_set1_ps(cf.C[cf.num - 1]);
+
+		for (int j = cf.num - 2; j >= 0; j--)
+		{
+			ps = _mm_add_ps(_mm_mul_ps(ps, z), _mm_set1_ps(cf.S[j]));
+			pc = _mm_add_ps(_mm_mul_ps(pc, z), _mm_set1_ps(cf.C[j]));
+		}
+
+		const __m128 sinR = _mm_add_ps(r, _mm_mul_ps(_mm_mul_ps(r, z), ps));
+		const __m128 cosR = _mm_add_ps(_mm_sub_ps(one, _mm_mul_ps(half, z)), _mm_mul_ps(_mm_mul_ps(z, z), pc));
+
+		// choose the functions and the signs by the quadrant
+		const __m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(quadrant, intOne), intOne));
+		const __m128 a = _mm_blendv_ps(sinR, cosR, swap);
+		const __m128 b = _mm_blendv_ps(cosR, sinR, swap);
+
+		// bit 1 of the quadrant => the sign bit
+		const __m128 signS = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(quadrant, intTwo), 30));
+		const __m128 signC = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(quadrant, intOne), intTwo), 30));
+
+		_mm_storeu_ps(s + i, _mm_xor_ps(a, signS));
+		_mm_storeu_ps(c + i, _mm_xor_ps(b, signC));
+	}
+
+	// process the rest of angles
+	SinCos_Array_Scalar(theta + i, s + i, c + i, num - i, precision);
+
+} // end SinCos_Array_SSE
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_AVX2
+void SinCos_Array_AVX2(const float* theta, float* s, float* c, const int num,
+	const SINCOS_PRECISION precision)
+{
+	// computes sine and cosine of num angles; processes 8 angles per iteration;
+	// the tail (num % 8 angles) is processed by the SSE kernel
+	//
+	// NOTE: FMA isn't used here on purpose (see the note in Simd.h)
+
+	assert(theta != nullptr);
+	assert(s && c);
+	assert(num >= 0);
+	assert((precision >= SINCOS_PRECISION_LOW) && (precision <= SINCOS_PRECISION_HIGH));
+
+	const SINCOS_COEFFS & cf = SINCOS_COEFFS_TABLE[precision];
+
+	const __m256 twoDivPi = _mm256_set1_ps(SINCOS_2_DIV_PI);
+	const __m256 magic = _mm256_set1_ps(SINCOS_ROUND_MAGIC);
+	const __m256 pio2A = _mm256_set1_ps(SINCOS_PI_DIV_2_A);
+	const __m256 pio2B = _mm256_set1_ps(SINCOS_PI_DIV_2_B);
+	const __m256 pio2C = _mm256_set1_ps(SINCOS_PI_DIV_2_C);
+	const __m256 one = _mm256_set1_ps(1.0f);
+	const __m256 half = _mm256_set1_ps(0.5f);
+	const __m256i intOne = _mm256_set1_epi32(1);
+	const __m256i intTwo = _mm256_set1_epi32(2);
+
+	int i = 0;
+
+	for (; i + 8 <= num; i += 8)
+	{
+		const __m256 x = _mm256_loadu_ps(theta + i);
+
+		// reduce the angle into [-PI/4, PI/4]
+		const __m256 k = _mm256_sub_ps(_mm256_add_ps(_mm256_mul_ps(x, twoDivPi), magic), magic);
+		const __m256i quadrant = _mm256_cvttps_epi32(k);
+
+		__m256 r = _mm256_sub_ps(x, _mm256_mul_ps(k, pio2A));
+		r = _mm256_sub_ps(r, _mm256_mul_ps(k, pio2B));
+		r = _mm256_sub_ps(r, _mm256_mul_ps(k, pio2C));
+
+		// compute the polynomials using Horner's scheme
+		const __m256 z = _mm256_mul_ps(r, r);
+		__m256 ps = _mm256_set1_ps(cf.S[cf.num - 1]);
+		__m256 pc = _mm256_set1_ps(cf.C[cf.num - 1]);
+
+		for (int j = cf.num - 2; j >= 0; j--)
+		{
+			ps = _mm256_add_ps(_mm256_mul_ps(ps, z), _mm256_set1_ps(cf.S[j]));
+			pc = _mm256_add_ps(_mm256_mul_ps(pc, z), _mm256_set1_ps(cf.C[j]));
+		}
+
+		const __m256 sinR = _mm256_add_ps(r, _mm256_mul_ps(_mm256_mul_ps(r, z), ps));
+		const __m256 cosR = _mm256_add_ps(_mm256_sub_ps(one, _mm256_mul_ps(half, z)), _mm256_mul_ps(_mm256_mul_ps(z, z), pc));
+
+		// choose the functions and the signs by the quadrant
+		const __m256 swap = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(quadrant, intOne), intOne));
+		const __m256 a = _mm256_blendv_ps(sinR, cosR, swap);
+		const __m256 b = _mm256_blendv_ps(cosR, sinR, swap);
+
+		// bit 1 of the quadrant => the sign bit
+		const __m256 signS = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(quadrant, intTwo), 30));
+		const __m256 signC = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(_mm256_add_epi32(quadrant, intOne), intTwo), 30));
+
+		_mm256_storeu_ps(s + i, _mm256_xor_ps(a, signS));
+		_mm256_storeu_ps(c + i, _mm256_xor_ps(b, signC));
+	}
+
+	// process the rest of angles
+	SinCos_Array_SSE(theta + i, s + i, c + i, num - i, precision);
+
+} // end SinCos_Array_AVX2
+
+#else
+
+// there is no SIMD support for this platform so use the reference kernel
+
+void SinCos_Array_SSE(const float* theta, float* s, float* c, const int num,
+	const SINCOS_PRECISION precision)
+{
+	SinCos_Array_Scalar(theta, s, c, num, precision);
+}
+
+void SinCos_Array_AVX2(const float* theta, float* s, float* c, const int num,
+	const SINCOS_PRECISION precision)
+{
+	SinCos_Array_Scalar(theta, s, c, num, precision);
+}
+
+#endif // MATHLIB_SIMD_X86
+
+///////////////////////////////////////////////////////////
+
+void SinCos_Array(const float* theta, float* s, float* c, const int num,
+	const SINCOS_PRECISION precision)
+{
+	// computes sine and cosine of num angles using the best kernel for the current CPU
+
+	switch (SIMD_Get_Level())
+	{
+		case SIMD_LEVEL_AVX2:
+			SinCos_Array_AVX2(theta, s, c, num, precision);
+			break;
+
+		case SIMD_LEVEL_AVX:
+		case SIMD_LEVEL_SSE:
+			SinCos_Array_SSE(theta, s, c, num, precision);
+			break;
+
+		default:
+			SinCos_Array_Scalar(theta, s, c, num, precision);
+	}
+
+} // end SinCos_Array
+
+} // end namespace MathLib
@@ -0,0 +1,119 @@
+////////////////////////////////////////////////////////////////////////////////////////////
+// Filename:      SinCos.h
+// Description:   contains functional for computing sine and cosine of an angle (in radians)
+//                together using minimax polynomials with configurable precision;
+//                also there are array versions (scalar, SSE and AVX2 kernels)
+//
+// Created:       17.10.26
+////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <cmath>
+
+#include "../MathConstant.h"
+
+
+namespace MathLib
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                 DATA STRUCTURES
+////////////////////////////////////////////////////////////////////////////////////////////
+
+// precision of the polynomials (the maximal absolute error is measured
+// on [-PI/4, PI/4], the rounding errors of float aren't included)
+enum SINCOS_PRECISION
+{
+	SINCOS_PRECISION_LOW    = 0,   // sin: degree 3, cos: degree 4   (error ~3e-4)
+	SINCOS_PRECISION_MEDIUM = 1,   // sin: degree 5, cos: degree 6   (error ~1e-6)
+	SINCOS_PRECISION_HIGH   = 2,   // sin: degree 7, cos: degree 8   (error is about 1 ulp)
+};
+
+
+// coefficients of the polynomials after the reduction of an angle into [-PI/4, PI/4]:
+//
+//   sin(r) = r + r^3 * (S[0] + z*S[1] + z^2*S[2] ...)            (z = r^2)
+//   cos(r) = 1 - z/2 + z^2 * (C[0] + z*C[1] + z^2*C[2] ...)
+typedef struct SINCOS_COEFFS_TYPE
+{
+	int   num;      // the number of used coefficients (1..3)
+	float S[3];
+	float C[3];
+} SINCOS_COEFFS, *SINCOS_COEFFS_PTR;
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                   CONSTANTS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+// LOW and MEDIUM coefficients are minimax ones (computed by Lawson's algorithm);
+// HIGH coefficients are taken from the Cephes library (sinf/cosf)
+constexpr SINCOS_COEFFS SINCOS_COEFFS_TABLE[3] =
+{
+	{ 1, { -1.622591260e-1f },
+	     {  4.090844324e-2f } },
+
+	{ 2, { -1.666283380e-1f,  8.152992280e-3f },
+	     {  4.166127862e-2f, -1.365245009e-3f } },
+
+	{ 3, { -1.6666654611e-1f, 8.3321608736e-3f, -1.9515295891e-4f },
+	     {  4.166664568298827e-2f, -1.388731625493765e-3f, 2.443315711809948e-5f } },
+};
+
+// PI/2 split into 3 parts for exact reduction of an angle (Cody-Waite);
+// the first part has only 8 significant bits so k*SINCOS_PI_DIV_2_A is exact
+// for |k| < 2^16, and the reduction is accurate for |theta| up to ~1e5
+constexpr float SINCOS_PI_DIV_2_A = 1.5703125f;
+constexpr float SINCOS_PI_DIV_2_B = 4.837512969970703125e-4f;
+constexpr float SINCOS_PI_DIV_2_C = 7.54978995489188216e-8f;
+constexpr float SINCOS_2_DIV_PI   = 0.636619772367581343f;
+
+// (x + 1.5*2^23) - 1.5*2^23 rounds x to the nearest integer (ties to even) for |x| < 2^22;
+// it is cheaper than rintf() call and gives the same result in the SIMD kernels
+constexpr float SINCOS_ROUND_MAGIC = 12582912.0f;
+
+// the maximal magnitude of an angle for Fast_SinCos and SinCos_Array (see the reduction above;
+// near the limit it adds up to ~2e-6 of the absolute error); greater angles (or NaN)
+// give meaningless results, but they never trap
+constexpr float SINCOS_MAX_ARG = 1e5f;
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                            FUNCTIONS PROTOTYPES
+////////////////////////////////////////////////////////////////////////////////////////////
+
+// computes sine and cosine of the angle theta (in radians) together;
+// theta must be in (-SINCOS_MAX_ARG, SINCOS_MAX_ARG)
+void Fast_SinCos(const float theta, float & s, float & c,
+	const SINCOS_PRECISION precision = SINCOS_PRECISION_HIGH);
+
+///////////////////////////////////////////////////////////////
+
+//
+// each function computes s[i] = sin(theta[i]) and c[i] = cos(theta[i]) for num angles;
+// the results are bit-compatible with Fast_SinCos for each kernel;
+// each angle must be in (-SINCOS_MAX_ARG, SINCOS_MAX_ARG);
+//
+// any output stream may be the same as the input stream (in-place computation),
+// but the streams must not partially overlap
+//
+
+// chooses the best kernel for the current CPU (see SIMD_Get_Level)
+void SinCos_Array(const float* theta, float* s, float* c, const int num,
+	const SINCOS_PRECISION precision = SINCOS_PRECISION_HIGH);
+
+// separate kernels (SSE/AVX2 kernels must be called only if the CPU supports them)
+void SinCos_Array_Scalar(const float* theta, float* s, float* c, const int num,
+	const SINCOS_PRECISION precision);
+
+void SinCos_Array_SSE(const float* theta, float* s, float* c, const int num,
+	const SINCOS_PRECISION precision);
+
+void SinCos_Array_AVX2(const float* theta, float* s, float* c, const int num,
+	const SINCOS_PRECISION precision);
+
+} // end namespace MathLib
@@ -0,0 +1,178 @@
+////////////////////////////////////////////////////////////////////////////////////////////
+// Filename:      TrigTables.h
+// Description:   contains lookup tables of sine/cosine which are generated at compile
+//                time; the resolution of a table (the number of entries per full turn)
+//                is a template parameter so it is possible to trade cache footprint
+//                against accuracy
+//
+// Created:       17.10.26
+////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <cmath>
+
+
+namespace MathLib
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                          COMPILE-TIME SINE COMPUTATION
+////////////////////////////////////////////////////////////////////////////////////////////
+
+constexpr double TRIG_TABLE_PI = 3.14159265358979323846;
+
+constexpr double Constexpr_Sin(double x)
+{
+	// this function computes sin(x) for x in [0, 2*PI) at compile time:
+	// the angle is reduced into [-PI/2, PI/2] using symmetry of sine,
+	// and then the Taylor series is summed until its terms become negligible
+
+	if (x > TRIG_TABLE_PI)
+		x -= 2.0 * TRIG_TABLE_PI;                  // => [-PI, PI]
+
+	if (x > TRIG_TABLE_PI / 2)
+		x = TRIG_TABLE_PI - x;                     // sin(x) == sin(PI - x)
+	else if (x < -TRIG_TABLE_PI / 2)
+		x = -TRIG_TABLE_PI - x;                    // sin(x) == sin(-PI - x)
+
+	const double x2 = x * x;
+	double term = x;
+	double sum = x;
+
+	for (int n = 1; (term > 1e-18) || (term < -1e-18); n++)
+	{
+		term *= -x2 / ((2 * n) * (2 * n + 1));
+		sum += term;
+	}
+
+	return sum;
+
+} // end Constexpr_Sin
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                 DATA STRUCTURES
+////////////////////////////////////////////////////////////////////////////////////////////
+
+// a table of sine for NUM_ENTRIES angles of a full turn: table[i] = sin(2*PI * i / NUM_ENTRIES);
+// cosine is taken from the same table with the offset of a quarter of a turn
+// (cos(x) == sin(x + PI/2)), so there are 5/4 of a turn + 1 entry for the interpolation
+template <int NUM_ENTRIES>
+struct TRIG_LOOK_TABLE
+{
+	static_assert(NUM_ENTRIES >= 4, "the table must have at least 4 entries");
+	static_assert(NUM_ENTRIES % 4 == 0, "the number of entries must be divisible by 4");
+
+	static constexpr int COS_OFFSET = NUM_ENTRIES / 4;
+	static constexpr int SIZE = NUM_ENTRIES + COS_OFFSET + 1;
+
+	float table[SIZE];
+};
+
+///////////////////////////////////////////////////////////////
+
+template <int NUM_ENTRIES>
+constexpr TRIG_LOOK_TABLE<NUM_ENTRIES> Build_Trig_Look_Table()
+{
+	// this function generates a lookup table at compile time
+
+	TRIG_LOOK_TABLE<NUM_ENTRIES> t{};
+
+	for (int i = 0; i < NUM_ENTRIES; i++)
+	{
+		t.table[i] = (float)Constexpr_Sin(2.0 * TRIG_TABLE_PI * i / NUM_ENTRIES);
+	}
+
+	// the rest entries repeat the beginning of the table
+	for (int i = NUM_ENTRIES; i < TRIG_LOOK_TABLE<NUM_ENTRIES>::SIZE; i++)
+	{
+		t.table[i] = t.table[i - NUM_ENTRIES];
+	}
+
+	return t;
+
+} // end Build_Trig_Look_Table
+
+///////////////////////////////////////////////////////////////
+
+// one table per resolution for the whole program
+template <int NUM_ENTRIES>
+inline constexpr TRIG_LOOK_TABLE<NUM_ENTRIES> TRIG_LOOK = Build_Trig_Look_Table<NUM_ENTRIES>();
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                               INLINE OPERATIONS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+//
+// sin/cos of an angle (in radians) using the table with NUM_ENTRIES entries and
+// linear interpolation; the maximal error is about (2*PI / NUM_ENTRIES)^2 / 8:
+//
+//   360 entries:  ~4e-5 (1.8 KB);   1024 entries: ~5e-6 (5 KB);   4096 entries: ~3e-7 (20 KB)
+//
+// if NUM_ENTRIES is a power of 2 the index is wrapped by masking, in another case by %;
+//
+// NOTE: theta * NUM_ENTRIES / (2*PI) is computed in float so for large angles the error
+//       of the fractional part becomes bigger than the error of the interpolation
+//       (e.g. ~7e-6 with 4096 entries for |theta| ~ 100); beyond 2^24 entries (|theta| ~ 4e4
+//       with 4096 entries) there is no fractional part at all, and such an angle is
+//       reduced into one turn before it is converted into the index (so any finite
+//       theta is valid, but the result is the table value of the nearest float index)
+//
+
+template <int NUM_ENTRIES>
+inline float Trig_Look_Interpolate(const float theta, const int offset)
+{
+	// this function looks up the table for the angle theta (in radians);
+	// offset == 0 for sine and COS_OFFSET for cosine
+
+	constexpr float ENTRIES_PER_RADIAN = (float)(NUM_ENTRIES / (2.0 * TRIG_TABLE_PI));
+
+	float t = theta * ENTRIES_PER_RADIAN;
+
+	// (int)t is undefined if t doesn't fit into int; such a t is an integer number
+	// so fmodf() gives its exact remainder
+	if (fabsf(t) >= 16777216.0f)    // 2^24
+		t = fmodf(t, (float)NUM_ENTRIES);
+
+	// floor() without a call: truncation and correction for negative values
+	int i = (int)t;
+	i -= (t < (float)i);
+
+	const float frac = t - (float)i;
+
+	if constexpr ((NUM_ENTRIES & (NUM_ENTRIES - 1)) == 0)
+	{
+		i &= (NUM_ENTRIES - 1);
+	}
+	else
+	{
+		i %= NUM_ENTRIES;
+		i += (i < 0) ? NUM_ENTRIES : 0;
+	}
+
+	const float* table = TRIG_LOOK<NUM_ENTRIES>.table + offset;
+
+	return table[i] + frac * (table[i + 1] - table[i]);
+
+} // end Trig_Look_Interpolate
+
+///////////////////////////////////////////////////////////////
+
+template <int NUM_ENTRIES>
+inline float Fast_Sin_LUT(const float theta)
+{
+	return Trig_Look_Interpolate<NUM_ENTRIES>(theta, 0);
+}
+
+template <int NUM_ENTRIES>
+inline float Fast_Cos_LUT(const float theta)
+{
+	return Trig_Look_Interpolate<NUM_ENTRIES>(theta, TRIG_LOOK_TABLE<NUM_ENTRIES>::COS_OFFSET);
+}
+
+} // end namespace MathLib
@@ -9,14 +9,16 @@
 #include <cmath>
 
 #include "../MathConstant.h"
+#include "TrigTables.h"
 
 
 namespace MathLib
 {
 
-// lookup tables for calculating trigonometric functions
-_declspec(selectany) float cos_look[361]{ 0.0f };
-_declspec(selectany) float sin_look[361]{ 0.0f };
+// lookup tables for calculating trigonometric functions (one entry per degree, 0..360);
+// they are generated at compile time (see TrigTables.h)
+constexpr const float* sin_look = TRIG_LOOK<360>.table;
+constexpr const float* cos_look = TRIG_LOOK<360>.table + TRIG_LOOK_TABLE<360>::COS_OFFSET;
 
 // definition of minimum or maximum of two values
 #define MIN(a, b) (((a) < (b)) ? (a) : (b))
@@ -36,7 +38,8 @@ _declspec(selectany) float sin_look[361]{ 0.0f };
 //    FUNCTIONS PROTOTYPES
 //////////////////////////////////
 
-// trigonometric functions
+// trigonometric functions (angles in degrees; see also Fast_Sin_LUT/Fast_Cos_LUT
+// in TrigTables.h and Fast_SinCos in SinCos.h for angles in radians)
 float Fast_Sin(float theta);
 float Fast_Cos(float theta);
 
@@ -205,7 +205,7 @@ void VECTOR2D_Print(const VECTOR2D & vec, const char* name)
 	vectorData += name;
 	vectorData += " = [";
 
-	for (UINT i = 0; i < 2; i++)
+	for (unsigned int i = 0; i < 2; i++)
 	{
 		vectorData += std::to_string(vec.M[i]);
 		vectorData += ", ";
@@ -245,7 +245,7 @@ void VECTOR3D_Print(const VECTOR3D & vec, const char* name)
 	vectorData += name;
 	vectorData += " = [";
 
-	for (UINT i = 0; i < 3; i++)
+	for (unsigned int i = 0; i < 3; i++)
 	{
 		vectorData += std::to_string(vec.M[i]);
 		vectorData += ", ";
@@ -250,7 +250,7 @@ void VECTOR4D_Print(const VECTOR4D & vec, const char* name)
 	vectorData += name;
 	vectorData += " = [";
 
-	for (UINT i = 0; i < 4; i++)
+	for (unsigned int i = 0; i < 4; i++)
 	{
 		vectorData += std::to_string(vec.M[i]);
 		vectorData += ", ";
@@ -0,0 +1,699 @@
+////////////////////////////////////////////////////////////////////////////////////////////
+// Filename:      VectorPacked.cpp
+// Description:   contains implementation of the octahedral packing of unit 3D vectors
+//                (scalar, SSE and AVX2 kernels + runtime dispatching)
+//
+// Created:       17.10.26
+////////////////////////////////////////////////////////////////////////////////////////////
+#include "VectorPacked.h"
+#include "../Utils/Simd.h"
+
+
+namespace MathLib
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                              OCTAHEDRAL ENCODING
+////////////////////////////////////////////////////////////////////////////////////////////
+
+// the max quantized values of the formats
+static constexpr float OCT16_MAX = 127.0f;
+static constexpr float OCT32_MAX = 32767.0f;
+
+///////////////////////////////////////////////////////////
+
+//
+// NOTE: the SIMD kernels are the branchless forms of these two functions: the same
+//       float operations in the same order (max/min are written the same way as
+//       _mm_max_ps/_mm_min_ps, the sign is copied as a bit), so all the kernels
+//       give the same bits
+//
+
+static inline int Oct_Quantize(const float v, const float maxS)
+{
+	// rounds v * maxS half away from zero and clamps it into [-maxS, maxS]
+
+	float t = v * maxS + copysignf(0.5f, v);
+	t = (t > -maxS) ? t : -maxS;
+	t = (t < maxS) ? t : maxS;
+
+	return (int)t;
+}
+
+static void Oct_Encode(const float x, const float y, const float z, const float maxS,
+	int & qx, int & qy)
+{
+	// this function projects the vector onto the octahedron and quantizes the result
+
+	const float l1 = (fabsf(x) + fabsf(y)) + fabsf(z);
+
+	float ox = x / l1;
+	float oy = y / l1;
+
+	// fold the lower half of the octahedron over the upper one
+	if (z < 0.0f)
+	{
+		const float fx = (1.0f - fabsf(oy)) * copysignf(1.0f, ox);
+		const float fy = (1.0f - fabsf(ox)) * copysignf(1.0f, oy);
+
+		ox = fx;
+		oy = fy;
+	}
+
+	qx = Oct_Quantize(ox, maxS);
+	qy = Oct_Quantize(oy, maxS);
+
+} // end Oct_Encode
+
+///////////////////////////////////////////////////////////
+
+static void Oct_Decode(const int qx, const int qy, const float maxS,
+	float & x, float & y, float & z)
+{
+	// this function restores the point of the octahedron and normalizes it
+
+	const float invMax = 1.0f / maxS;
+
+	float ox = (float)qx * invMax;
+	float oy = (float)qy * invMax;
+	const float oz = (1.0f - fabsf(ox)) - fabsf(oy);
+
+	// unfold the lower half of the octahedron
+	if (oz < 0.0f)
+	{
+		const float fx = (1.0f - fabsf(oy)) * copysignf(1.0f, ox);
+		const float fy = (1.0f - fabsf(ox)) * copysignf(1.0f, oy);
+
+		ox = fx;
+		oy = fy;
+	}
+
+	const float len = sqrtf((ox * ox + oy * oy) + oz * oz);
+
+	x = ox / len;
+	y = oy / len;
+	z = oz / len;
+
+} // end Oct_Decode
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                             PACKING OF SINGLE VECTORS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void VECTOR3D_Pack_Oct(const VECTOR3D & v, VECTOR3D_OCT16 & vp)
+{
+	int qx, qy;
+
+	Oct_Encode(v.x, v.y, v.z, OCT16_MAX, qx, qy);
+
+	vp.M[0] = (int8_t)qx;
+	vp.M[1] = (int8_t)qy;
+}
+
+void VECTOR3D_Pack_Oct(const VECTOR3D & v, VECTOR3D_OCT32 & vp)
+{
+	int qx, qy;
+
+	Oct_Encode(v.x, v.y, v.z, OCT32_MAX, qx, qy);
+
+	vp.M[0] = (int16_t)qx;
+	vp.M[1] = (int16_t)qy;
+}
+
+///////////////////////////////////////////////////////////
+
+void VECTOR3D_Unpack_Oct(const VECTOR3D_OCT16 & vp, VECTOR3D & v)
+{
+	Oct_Decode(vp.M[0], vp.M[1], OCT16_MAX, v.x, v.y, v.z);
+}
+
+void VECTOR3D_Unpack_Oct(const VECTOR3D_OCT32 & vp, VECTOR3D & v)
+{
+	Oct_Decode(vp.M[0], vp.M[1], OCT32_MAX, v.x, v.y, v.z);
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                             SCALAR (REFERENCE) KERNELS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void VECTOR3D_Pack_Oct_Batch_Scalar(const float* xIn, const float* yIn, const float* zIn, VECTOR3D_OCT16* out, const int num)
+{
+	// packs num vectors into 16 bits using plain C++ code (reference kernel)
+
+	assert(xIn && yIn && zIn);
+	assert(out != nullptr);
+	assert(num >= 0);
+
+	for (int i = 0; i < num; i++)
+		VECTOR3D_Pack_Oct(VECTOR3D(xIn[i], yIn[i], zIn[i]), out[i]);
+
+} // end VECTOR3D_Pack_Oct_Batch_Scalar (16 bits)
+
+void VECTOR3D_Pack_Oct_Batch_Scalar(const float* xIn, const float* yIn, const float* zIn, VECTOR3D_OCT32* out, const int num)
+{
+	// packs num vectors into 32 bits using plain C++ code (reference kernel)
+
+	assert(xIn && yIn && zIn);
+	assert(out != nullptr);
+	assert(num >= 0);
+
+	for (int i = 0; i < num; i++)
+		VECTOR3D_Pack_Oct(VECTOR3D(xIn[i], yIn[i], zIn[i]), out[i]);
+
+} // end VECTOR3D_Pack_Oct_Batch_Scalar (32 bits)
+
+///////////////////////////////////////////////////////////
+
+void VECTOR3D_Unpack_Oct_Batch_Scalar(const VECTOR3D_OCT16* in, float* xOut, float* yOut, float* zOut, const int num)
+{
+	// unpacks num 16-bit vectors using plain C++ code (reference kernel)
+
+	assert(in != nullptr);
+	assert(xOut && yOut && zOut);
+	assert(num >= 0);
+
+	for (int i = 0; i < num; i++)
+		Oct_Decode(in[i].M[0], in[i].M[1], OCT16_MAX, xOut[i], yOut[i], zOut[i]);
+
+} // end VECTOR3D_Unpack_Oct_Batch_Scalar (16 bits)
+
+void VECTOR3D_Unpack_Oct_Batch_Scalar(const VECTOR3D_OCT32* in, float* xOut, float* yOut, float* zOut, const int num)
+{
+	// unpacks num 32-bit vectors using plain C++ code (reference kernel)
+
+	assert(in != nullptr);
+	assert(xOut && yOut && zOut);
+	assert(num >= 0);
+
+	for (int i = 0; i < num; i++)
+		Oct_Decode(in[i].M[0], in[i].M[1], OCT32_MAX, xOut[i], yOut[i], zOut[i]);
+
+} // end VECTOR3D_Unpack_Oct_Batch_Scalar (32 bits)
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                  SIMD KERNELS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+#if MATHLIB_SIMD_X86
+
+MATHLIB_TARGET_SSE41
+static inline void Oct_Encode_SSE(const __m128 x, const __m128 y, const __m128 z, const float maxS,
+	__m128i & qx, __m128i & qy)
+{
+	// branchless Oct_Encode for 4 vectors
+
+	const __m128 signMask = _mm_set1_ps(-0.0f);
+	const __m128 one      = _mm_set1_ps(1.0f);
+	const __m128 half     = _mm_set1_ps(0.5f);
+	const __m128 vMax     = _mm_set1_ps(maxS);
+	const __m128 vMin     = _mm_set1_ps(-maxS);
+
+	const __m128 l1 = _mm_add_ps(_mm_add_ps(_mm_andnot_ps(signMask, x), _mm_andnot_ps(signMask, y)), _mm_andnot_ps(signMask, z));
+
+	const __m128 px = _mm_div_ps(x, l1);
+	const __m128 py = _mm_div_ps(y, l1);
+
+	// fold the lower half of the octahedron over the upper one
+	const __m128 fx = _mm_mul_ps(_mm_sub_ps(one, _mm_andnot_ps(signMask, py)), _mm_or_ps(_mm_and_ps(px, signMask), one));
+	const __m128 fy = _mm_mul_ps(_mm_sub_ps(one, _mm_andnot_ps(signMask, px)), _mm_or_ps(_mm_and_ps(py, signMask), one));
+
+	const __m128 lower = _mm_cmplt_ps(z, _mm_setzero_ps());
+	const __m128 o[2] = { _mm_blendv_ps(px, fx, lower), _mm_blendv_ps(py, fy, lower) };
+
+	__m128i q[2];
+
+	for (int k = 0; k < 2; k++)
+	{
+		__m128 t = _mm_add_ps(_mm_mul_ps(o[k], vMax), _mm_or_ps(_mm_and_ps(o[k], signMask), half));
+		t = _mm_max_ps(t, vMin);
+		t = _mm_min_ps(t, vMax);
+
+		q[k] = _mm_cvttps_epi32(t);
+	}
+
+	qx = q[0];
+	qy = q[1];
+}
+
+MATHLIB_TARGET_SSE41
+static inline void Oct_Decode_SSE(const __m128i qx, const __m128i qy, const float maxS,
+	float* xOut, float* yOut, float* zOut)
+{
+	// branchless Oct_Decode for 4 vectors
+
+	const __m128 signMask = _mm_set1_ps(-0.0f);
+	const __m128 one      = _mm_set1_ps(1.0f);
+	const __m128 invMax   = _mm_set1_ps(1.0f / maxS);
+
+	const __m128 ox = _mm_mul_ps(_mm_cvtepi32_ps(qx), invMax);
+	const __m128 oy = _mm_mul_ps(_mm_cvtepi32_ps(qy), invMax);
+	const __m128 oz = _mm_sub_ps(_mm_sub_ps(one, _mm_andnot_ps(signMask, ox)), _mm_andnot_ps(signMask, oy));
+
+	// unfold the lower half of the octahedron
+	const __m128 fx = _mm_mul_ps(_mm_sub_ps(one, _mm_andnot_ps(signMask, oy)), _mm_or_ps(_mm_and_ps(ox, signMask), one));
+	const __m128 fy = _mm_mul_ps(_mm_sub_ps(one, _mm_andnot_ps(signMask, ox)), _mm_or_ps(_mm_and_ps(oy, signMask), one));
+
+	const __m128 lower = _mm_cmplt_ps(oz, _mm_setzero_ps());
+	const __m128 x = _mm_blendv_ps(ox, fx, lower);
+	const __m128 y = _mm_blendv_ps(oy, fy, lower);
+
+	const __m128 len = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(oz, oz)));
+
+	_mm_storeu_ps(xOut, _mm_div_ps(x, len));
+	_mm_storeu_ps(yOut, _mm_div_ps(y, len));
+	_mm_storeu_ps(zOut, _mm_div_ps(oz, len));
+}
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_AVX2
+static inline void Oct_Encode_AVX2(const __m256 x, const __m256 y, const __m256 z, const float maxS,
+	__m256i & qx, __m256i & qy)
+{
+	// branchless Oct_Encode for 8 vectors
+
+	const __m256 signMask = _mm256_set1_ps(-0.0f);
+	const __m256 one      = _mm256_set1_ps(1.0f);
+	const __m256 half     = _mm256_set1_ps(0.5f);
+	const __m256 vMax     = _mm256_set1_ps(maxS);
+	const __m256 vMin     = _mm256_set1_ps(-maxS);
+
+	const __m256 l1 = _mm256_add_ps(_mm256_add_ps(_mm256_andnot_ps(signMask, x), _mm256_andnot_ps(signMask, y)), _mm256_andnot_ps(signMask, z));
+
+	const __m256 px = _mm256_div_ps(x, l1);
+	const __m256 py = _mm256_div_ps(y, l1);
+
+	// fold the lower half of the octahedron over the upper one
+	const __m256 fx = _mm256_mul_ps(_mm256_sub_ps(one, _mm256_andnot_ps(signMask, py)), _mm256_or_ps(_mm256_and_ps(px, signMask), one));
+	const __m256 fy = _mm256_mul_ps(_mm256_sub_ps(one, _mm256_andnot_ps(signMask, px)), _mm256_or_ps(_mm256_and_ps(py, signMask), one));
+
+	const __m256 lower = _mm256_cmp_ps(z, _mm256_setzero_ps(), _CMP_LT_OQ);
+	const __m256 o[2] = { _mm256_blendv_ps(px, fx, lower), _mm256_blendv_ps(py, fy, lower) };
+
+	__m256i q[2];
+
+	for (int k = 0; k < 2; k++)
+	{
+		__m256 t = _mm256_add_ps(_mm256_mul_ps(o[k], vMax), _mm256_or_ps(_mm256_and_ps(o[k], signMask), half));
+		t = _mm256_max_ps(t, vMin);
+		t = _mm256_min_ps(t, vMax);
+
+		q[k] = _mm256_cvttps_epi32(t);
+	}
+
+	qx = q[0];
+	qy = q[1];
+}
+
+MATHLIB_TARGET_AVX2
+static inline void Oct_Decode_AVX2(const __m256i qx, const __m256i qy, const float maxS,
+	float* xOut, float* yOut, float* zOut)
+{
+	// branchless Oct_Decode for 8 vectors
+
+	const __m256 signMask = _mm256_set1_ps(-0.0f);
+	const __m256 one      = _mm256_set1_ps(1.0f);
+	const __m256 invMax   = _mm256_set1_ps(1.0f / maxS);
+
+	const __m256 ox = _mm256_mul_ps(_mm256_cvtepi32_ps(qx), invMax);
+	const __m256 oy = _mm256_mul_ps(_mm256_cvtepi32_ps(qy), invMax);
+	const __m256 oz = _mm256_sub_ps(_mm256_sub_ps(one, _mm256_andnot_ps(signMask, ox)), _mm256_andnot_ps(signMask, oy));
+
+	// unfold the lower half of the octahedron
+	const __m256 fx = _mm256_mul_ps(_mm256_sub_ps(one, _mm256_andnot_ps(signMask, oy)), _mm256_or_ps(_mm256_and_ps(ox, signMask), one));
+	const __m256 fy = _mm256_mul_ps(_mm256_sub_ps(one, _mm256_andnot_ps(signMask, ox)), _mm256_or_ps(_mm256_and_ps(oy, signMask), one));
+
+	const __m256 lower = _mm256_cmp_ps(oz, _mm256_setzero_ps(), _CMP_LT_OQ);
+	const __m256 x = _mm256_blendv_ps(ox, fx, lower);
+	const __m256 y = _mm256_blendv_ps(oy, fy, lower);
+
+	const __m256 len = _mm256_sqrt_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y)), _mm256_mul_ps(oz, oz)));
+
+	_mm256_storeu_ps(xOut, _mm256_div_ps(x, len));
+	_mm256_storeu_ps(yOut, _mm256_div_ps(y, len));
+	_mm256_storeu_ps(zOut, _mm256_div_ps(oz, len));
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                   SSE KERNELS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+//
+// each kernel processes 4 vectors per iteration; the packed vectors are in 32-bit
+// lanes (x in the low part, y in the high part); the tail (num % 4 vectors)
+// is processed by the scalar kernel
+//
+
+MATHLIB_TARGET_SSE41
+void VECTOR3D_Pack_Oct_Batch_SSE(const float* xIn, const float* yIn, const float* zIn, VECTOR3D_OCT16* out, const int num)
+{
+	assert(xIn && yIn && zIn);
+	assert(out != nullptr);
+	assert(num >= 0);
+
+	const __m128i mask = _mm_set1_epi32(0xff);
+	int i = 0;
+
+	for (; i + 4 <= num; i += 4)
+	{
+		__m128i qx, qy;
+
+		Oct_Encode_SSE(_mm_loadu_ps(xIn + i), _mm_loadu_ps(yIn + i), _mm_loadu_ps(zIn + i), OCT16_MAX, qx, qy);
+
+		const __m128i res = _mm_or_si128(_mm_and_si128(qx, mask), _mm_slli_epi32(_mm_and_si128(qy, mask), 8));
+
+		_mm_storel_epi64((__m128i*)(out + i), _mm_packus_epi32(res, res));
+	}
+
+	// process the rest of vectors
+	VECTOR3D_Pack_Oct_Batch_Scalar(xIn + i, yIn + i, zIn + i, out + i, num - i);
+
+} // end VECTOR3D_Pack_Oct_Batch_SSE (16 bits)
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_SSE41
+void VECTOR3D_Pack_Oct_Batch_SSE(const float* xIn, const float* yIn, const float* zIn, VECTOR3D_OCT32* out, const int num)
+{
+	assert(xIn && yIn && zIn);
+	assert(out != nullptr);
+	assert(num >= 0);
+
+	const __m128i mask = _mm_set1_epi32(0xffff);
+	int i = 0;
+
+	for (; i + 4 <= num; i += 4)
+	{
+		__m128i qx, qy;
+
+		Oct_Encode_SSE(_mm_loadu_ps(xIn + i), _mm_loadu_ps(yIn + i), _mm_loadu_ps(zIn + i), OCT32_MAX, qx, qy);
+
+		_mm_storeu_si128((__m128i*)(out + i), _mm_or_si128(_mm_and_si128(qx, mask), _mm_slli_epi32(qy, 16)));
+	}
+
+	// process the rest of vectors
+	VECTOR3D_Pack_Oct_Batch_Scalar(xIn + i, yIn + i, zIn + i, out + i, num - i);
+
+} // end VECTOR3D_Pack_Oct_Batch_SSE (32 bits)
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_SSE41
+void VECTOR3D_Unpack_Oct_Batch_SSE(const VECTOR3D_OCT16* in, float* xOut, float* yOut, float* zOut, const int num)
+{
+	assert(in != nullptr);
+	assert(xOut && yOut && zOut);
+	assert(num >= 0);
+
+	int i = 0;
+
+	for (; i + 4 <= num; i += 4)
+	{
+		const __m128i v = _mm_cvtepu16_epi32(_mm_loadl_epi64((const __m128i*)(in + i)));
+
+		// sign extension of the bytes
+		const __m128i qx = _mm_srai_epi32(_mm_slli_epi32(v, 24), 24);
+		const __m128i qy = _mm_srai_epi32(_mm_slli_epi32(v, 16), 24);
+
+		Oct_Decode_SSE(qx, qy, OCT16_MAX, xOut + i, yOut + i, zOut + i);
+	}
+
+	// process the rest of vectors
+	VECTOR3D_Unpack_Oct_Batch_Scalar(in + i, xOut + i, yOut + i, zOut + i, num - i);
+
+} // end VECTOR3D_Unpack_Oct_Batch_SSE (16 bits)
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_SSE41
+void VECTOR3D_Unpack_Oct_Batch_SSE(const VECTOR3D_OCT32* in, float* xOut, float* yOut, float* zOut, const int num)
+{
+	assert(in != nullptr);
+	assert(xOut && yOut && zOut);
+	assert(num >= 0);
+
+	int i = 0;
+
+	for (; i + 4 <= num; i += 4)
+	{
+		const __m128i v = _mm_loadu_si128((const __m128i*)(in + i));
+
+		// sign extension of the 16-bit parts
+		const __m128i qx = _mm_srai_epi32(_mm_slli_epi32(v, 16), 16);
+		const __m128i qy = _mm_srai_epi32(v, 16);
+
+		Oct_Decode_SSE(qx, qy, OCT32_MAX, xOut + i, yOut + i, zOut + i);
+	}
+
+	// process the rest of vectors
+	VECTOR3D_Unpack_Oct_Batch_Scalar(in + i, xOut + i, yOut + i, zOut + i, num - i);
+
+} // end VECTOR3D_Unpack_Oct_Batch_SSE (32 bits)
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                   AVX2 KERNELS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+//
+// each kernel processes 8 vectors per iteration;
+// the tail (num % 8 vectors) is processed by the SSE kernel
+//
+
+MATHLIB_TARGET_AVX2
+void VECTOR3D_Pack_Oct_Batch_AVX2(const float* xIn, const float* yIn, const float* zIn, VECTOR3D_OCT16* out, const int num)
+{
+	assert(xIn && yIn && zIn);
+	assert(out != nullptr);
+	assert(num >= 0);
+
+	const __m256i mask = _mm256_set1_epi32(0xff);
+	int i = 0;
+
+	for (; i + 8 <= num; i += 8)
+	{
+		__m256i qx, qy;
+
+		Oct_Encode_AVX2(_mm256_loadu_ps(xIn + i), _mm256_loadu_ps(yIn + i), _mm256_loadu_ps(zIn + i), OCT16_MAX, qx, qy);
+
+		const __m256i res = _mm256_or_si256(_mm256_and_si256(qx, mask), _mm256_slli_epi32(_mm256_and_si256(qy, mask), 8));
+
+		// the pack works in 128-bit halves so the result is gathered by the permutation
+		const __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(res, res), 0x08);
+
+		_mm_storeu_si128((__m128i*)(out + i), _mm256_castsi256_si128(packed));
+	}
+
+	// process the rest of vectors
+	VECTOR3D_Pack_Oct_Batch_SSE(xIn + i, yIn + i, zIn + i, out + i, num - i);
+
+} // end VECTOR3D_Pack_Oct_Batch_AVX2 (16 bits)
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_AVX2
+void VECTOR3D_Pack_Oct_Batch_AVX2(const float* xIn, const float* yIn, const float* zIn, VECTOR3D_OCT32* out, const int num)
+{
+	assert(xIn && yIn && zIn);
+	assert(out != nullptr);
+	assert(num >= 0);
+
+	const __m256i mask = _mm256_set1_epi32(0xffff);
+	int i = 0;
+
+	for (; i + 8 <= num; i += 8)
+	{
+		__m256i qx, qy;
+
+		Oct_Encode_AVX2(_mm256_loadu_ps(xIn + i), _mm256_loadu_ps(yIn + i), _mm256_loadu_ps(zIn + i), OCT32_MAX, qx, qy);
+
+		_mm256_storeu_si256((__m256i*)(out + i), _mm256_or_si256(_mm256_and_si256(qx, mask), _mm256_slli_epi32(qy, 16)));
+	}
+
+	// process the rest of vectors
+	VECTOR3D_Pack_Oct_Batch_SSE(xIn + i, yIn + i, zIn + i, out + i, num - i);
+
+} // end VECTOR3D_Pack_Oct_Batch_AVX2 (32 bits)
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_AVX2
+void VECTOR3D_Unpack_Oct_Batch_AVX2(const VECTOR3D_OCT16* in, float* xOut, float* yOut, float* zOut, const int num)
+{
+	assert(in != nullptr);
+	assert(xOut && yOut && zOut);
+	assert(num >= 0);
+
+	int i = 0;
+
+	for (; i + 8 <= num; i += 8)
+	{
+		const __m256i v = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(in + i)));
+
+		// sign extension of the bytes
+		const __m256i qx = _mm256_srai_epi32(_mm256_slli_epi32(v, 24), 24);
+		const __m256i qy = _mm256_srai_epi32(_mm256_slli_epi32(v, 16), 24);
+
+		Oct_Decode_AVX2(qx, qy, OCT16_MAX, xOut + i, yOut + i, zOut + i);
+	}
+
+	// process the rest of vectors
+	VECTOR3D_Unpack_Oct_Batch_SSE(in + i, xOut + i, yOut + i, zOut + i, num - i);
+
+} // end VECTOR3D_Unpack_Oct_Batch_AVX2 (16 bits)
+
+///////////////////////////////////////////////////////////
+
+MATHLIB_TARGET_AVX2
+void VECTOR3D_Unpack_Oct_Batch_AVX2(const VECTOR3D_OCT32* in, float* xOut, float* yOut, float* zOut, const int num)
+{
+	assert(in != nullptr);
+	assert(xOut && yOut && zOut);
+	assert(num >= 0);
+
+	int i = 0;
+
+	for (; i + 8 <= num; i += 8)
+	{
+		const __m256i v = _mm256_loadu_si256((const __m256i*)(in + i));
+
+		// sign extension of the 16-bit parts
+		const __m256i qx = _mm256_srai_epi32(_mm256_slli_epi32(v, 16), 16);
+		const __m256i qy = _mm256_srai_epi32(v, 16);
+
+		Oct_Decode_AVX2(qx, qy, OCT32_MAX, xOut + i, yOut + i, zOut + i);
+	}
+
+	// process the rest of vectors
+	VECTOR3D_Unpack_Oct_Batch_SSE(in + i, xOut + i, yOut + i, zOut + i, num - i);
+
+} // end VECTOR3D_Unpack_Oct_Batch_AVX2 (32 bits)
+
+#else
+
+// there is no SIMD support for this platform so use the reference kernels
+
+void VECTOR3D_Pack_Oct_Batch_SSE (const float* xIn, const float* yIn, const float* zIn, VECTOR3D_OCT16* out, const int num) { VECTOR3D_Pack_Oct_Batch_Scalar(xIn, yIn, zIn, out, num); }
+void VECTOR3D_Pack_Oct_Batch_SSE (const float* xIn, const float* yIn, const float* zIn, VECTOR3D_OCT32* out, const int num) { VECTOR3D_Pack_Oct_Batch_Scalar(xIn, yIn, zIn, out, num); }
+void VECTOR3D_Pack_Oct_Batch_AVX2(const float* xIn, const float* yIn, const float* zIn, VECTOR3D_OCT16* out, const int num) { VECTOR3D_Pack_Oct_Batch_Scalar(xIn, yIn, zIn, out, num); }
+void VECTOR3D_Pack_Oct_Batch_AVX2(const float* xIn, const float* yIn, const float* zIn, VECTOR3D_OCT32* out, const int num) { VECTOR3D_Pack_Oct_Batch_Scalar(xIn, yIn, zIn, out, num); }
+
+void VECTOR3D_Unpack_Oct_Batch_SSE (const VECTOR3D_OCT16* in, float* xOut, float* yOut, float* zOut, const int num) { VECTOR3D_Unpack_Oct_Batch_Scalar(in, xOut, yOut, zOut, num); }
+void VECTOR3D_Unpack_Oct_Batch_SSE (const VECTOR3D_OCT32* in, float* xOut, float* yOut, float* zOut, const int num) { VECTOR3D_Unpack_Oct_Batch_Scalar(in, xOut, yOut, zOut, num); }
+void VECTOR3D_Unpack_Oct_Batch_AVX2(const VECTOR3D_OCT16* in, float* xOut, float* yOut, float* zOut, const int num) { VECTOR3D_Unpack_Oct_Batch_Scalar(in, xOut, yOut, zOut, num); }
+void VECTOR3D_Unpack_Oct_Batch_AVX2(const VECTOR3D_OCT32* in, float* xOut, float* yOut, float* zOut, const int num) { VECTOR3D_Unpack_Oct_Batch_Scalar(in, xOut, yOut, zOut, num); }
+
+#endif // MATHLIB_SIMD_X86
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                  DISPATCHING
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void VECTOR3D_Pack_Oct_Batch(const float* xIn, const float* yIn, const float* zIn, VECTOR3D_OCT16* out, const int num)
+{
+	// packs num vectors into 16 bits using the best kernel for the current CPU
+
+	switch (SIMD_Get_Level())
+	{
+		case SIMD_LEVEL_AVX2:
+			VECTOR3D_Pack_Oct_Batch_AVX2(xIn, yIn, zIn, out, num);
+			break;
+
+		case SIMD_LEVEL_AVX:
+		case SIMD_LEVEL_SSE:
+			VECTOR3D_Pack_Oct_Batch_SSE(xIn, yIn, zIn, out, num);
+			break;
+
+		default:
+			VECTOR3D_Pack_Oct_Batch_Scalar(xIn, yIn, zIn, out, num);
+	}
+
+} // end VECTOR3D_Pack_Oct_Batch (16 bits)
+
+///////////////////////////////////////////////////////////
+
+void VECTOR3D_Pack_Oct_Batch(const float* xIn, const float* yIn, const float* zIn, VECTOR3D_OCT32* out, const int num)
+{
+	// packs num vectors into 32 bits using the best kernel for the current CPU
+
+	switch (SIMD_Get_Level())
+	{
+		case SIMD_LEVEL_AVX2:
+			VECTOR3D_Pack_Oct_Batch_AVX2(xIn, yIn, zIn, out, num);
+			break;
+
+		case SIMD_LEVEL_AVX:
+		case SIMD_LEVEL_SSE:
+			VECTOR3D_Pack_Oct_Batch_SSE(xIn, yIn, zIn, out, num);
+			break;
+
+		default:
+			VECTOR3D_Pack_Oct_Batch_Scalar(xIn, yIn, zIn, out, num);
+	}
+
+} // end VECTOR3D_Pack_Oct_Batch (32 bits)
+
+///////////////////////////////////////////////////////////
+
+void VECTOR3D_Unpack_Oct_Batch(const VECTOR3D_OCT16* in, float* xOut, float* yOut, float* zOut, const int num)
+{
+	// unpacks num 16-bit vectors using the best kernel for the current CPU
+
+	switch (SIMD_Get_Level())
+	{
+		case SIMD_LEVEL_AVX2:
+			VECTOR3D_Unpack_Oct_Batch_AVX2(in, xOut, yOut, zOut, num);
+			break;
+
+		case SIMD_LEVEL_AVX:
+		case SIMD_LEVEL_SSE:
+			VECTOR3D_Unpack_Oct_Batch_SSE(in, xOut, yOut, zOut, num);
+			break;
+
+		default:
+			VECTOR3D_Unpack_Oct_Batch_Scalar(in, xOut, yOut, zOut, num);
+	}
+
+} // end VECTOR3D_Unpack_Oct_Batch (16 bits)
+
+///////////////////////////////////////////////////////////
+
+void VECTOR3D_Unpack_Oct_Batch(const VECTOR3D_OCT32* in, float* xOut, float* yOut, float* zOut, const int num)
+{
+	// unpacks num 32-bit vectors using the best kernel for the current CPU
+
+	switch (SIMD_Get_Level())
+	{
+		case SIMD_LEVEL_AVX2:
+			VECTOR3D_Unpack_Oct_Batch_AVX2(in, xOut, yOut, zOut, num);
+			break;
+
+		case SIMD_LEVEL_AVX:
+		case SIMD_LEVEL_SSE:
+			VECTOR3D_Unpack_Oct_Batch_SSE(in, xOut, yOut, zOut, num);
+			break;
+
+		default:
+			VECTOR3D_Unpack_Oct_Batch_Scalar(in, xOut, yOut, zOut, num);
+	}
+
+} // end VECTOR3D_Unpack_Oct_Batch (32 bits)
+
+} // end namespace MathLib
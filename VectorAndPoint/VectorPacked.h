@@ -0,0 +1,88 @@
+////////////////////////////////////////////////////////////////////////////////////////////
+// Filename:      VectorPacked.h
+// Description:   contains functional for compression of unit 3D vectors (normals,
+//                tangents, directions) by the octahedral encoding: the unit sphere is
+//                projected onto the octahedron |x| + |y| + |z| = 1, its lower half is
+//                folded over the upper one and the (x, y) of the result are stored
+//                as two signed normalized integers
+//
+//                format     layout                 max angular error
+//                16 bits:   2 * int8  (x, y)       0.017 rad (1 degree)
+//                32 bits:   2 * int16 (x, y)       0.00007 rad (0.004 degrees)
+//
+// Created:       17.10.26
+////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <cstdint>
+
+#include "PointVector3D.h"
+
+
+namespace MathLib
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                                 DATA STRUCTURES
+////////////////////////////////////////////////////////////////////////////////////////////
+
+// octahedral-encoded unit vectors (M[0] is x, M[1] is y of the folded octahedron)
+typedef struct VECTOR3D_OCT16_TYPE { int8_t  M[2]; } VECTOR3D_OCT16, *VECTOR3D_OCT16_PTR;
+typedef struct VECTOR3D_OCT32_TYPE { int16_t M[2]; } VECTOR3D_OCT32, *VECTOR3D_OCT32_PTR;
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                             PACKING OF SINGLE VECTORS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+//
+// the source vector must be non-zero (it doesn't need to be unit, only the direction
+// is packed); the unpacked vector is normalized
+//
+
+void VECTOR3D_Pack_Oct(const VECTOR3D & v, VECTOR3D_OCT16 & vp);
+void VECTOR3D_Pack_Oct(const VECTOR3D & v, VECTOR3D_OCT32 & vp);
+
+void VECTOR3D_Unpack_Oct(const VECTOR3D_OCT16 & vp, VECTOR3D & v);
+void VECTOR3D_Unpack_Oct(const VECTOR3D_OCT32 & vp, VECTOR3D & v);
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//                              PACKING OF VECTOR STREAMS
+////////////////////////////////////////////////////////////////////////////////////////////
+
+//
+// each function packs/unpacks num vectors (the unpacked ones are in SoA form:
+// separate streams of x[], y[], z[]); the functions without a suffix choose the best
+// kernel for the current CPU (see SIMD_Get_Level); all the kernels give exactly
+// the same bits as VECTOR3D_Pack_Oct and VECTOR3D_Unpack_Oct
+//
+
+void VECTOR3D_Pack_Oct_Batch(const float* xIn, const float* yIn, const float* zIn, VECTOR3D_OCT16* out, const int num);
+void VECTOR3D_Pack_Oct_Batch(const float* xIn, const float* yIn, const float* zIn, VECTOR3D_OCT32* out, const int num);
+
+void VECTOR3D_Unpack_Oct_Batch(const VECTOR3D_OCT16* in, float* xOut, float* yOut, float* zOut, const int num);
+void VECTOR3D_Unpack_Oct_Batch(const VECTOR3D_OCT32* in, float* xOut, float* yOut, float* zOut, const int num);
+
+// separate kernels (SSE/AVX2 kernels must be called only if the CPU supports them)
+void VECTOR3D_Pack_Oct_Batch_Scalar(const float* xIn, const float* yIn, const float* zIn, VECTOR3D_OCT16* out, const int num);
+void VECTOR3D_Pack_Oct_Batch_SSE   (const float* xIn, const float* yIn, const float* zIn, VECTOR3D_OCT16* out, const int num);
+void VECTOR3D_Pack_Oct_Batch_AVX2  (const float* xIn, const float* yIn, const float* zIn, VECTOR3D_OCT16* out, const int num);
+
+void VECTOR3D_Pack_Oct_Batch_Scalar(const float* xIn, const float* yIn, const float* zIn, VECTOR3D_OCT32* out, const int num);
+void VECTOR3D_Pack_Oct_Batch_SSE   (const float* xIn, const float* yIn, const float* zIn, VECTOR3D_OCT32* out, const int num);
+void VECTOR3D_Pack_Oct_Batch_AVX2  (const float* xIn, const float* yIn, const float* zIn, VECTOR3D_OCT32* out, const int num);
+
+void VECTOR3D_Unpack_Oct_Batch_Scalar(const VECTOR3D_OCT16* in, float* xOut, float* yOut, float* zOut, const int num);
+void VECTOR3D_Unpack_Oct_Batch_SSE   (const VECTOR3D_OCT16* in, float* xOut, float* yOut, float* zOut, const int num);
+void VECTOR3D_Unpack_Oct_Batch_AVX2  (const VECTOR3D_OCT16* in, float* xOut, float* yOut, float* zOut, const int num);
+
+void VECTOR3D_Unpack_Oct_Batch_Scalar(const VECTOR3D_OCT32* in, float* xOut, float* yOut, float* zOut, const int num);
+void VECTOR3D_Unpack_Oct_Batch_SSE   (const VECTOR3D_OCT32* in, float* xOut, float* yOut, float* zOut, const int num);
+void VECTOR3D_Unpack_Oct_Batch_AVX2  (const VECTOR3D_OCT32* in, float* xOut, float* yOut, float* zOut, const int num);
+
+} // end namespace MathLib